@@ -506,6 +506,22 @@ enum aome_enc_control_id {
    * Experiment: ANS
    */
   AV1E_SET_ANS_WINDOW_SIZE_LOG2,
+
+  /*!\brief Codec control function to enable row based multi-threading.
+   *
+   * Superblock rows within a tile are encoded in parallel in a wavefront.
+   * The output does not depend on the number of threads, but the adaptive
+   * mode search state is kept per superblock row, so it differs slightly
+   * from the output with this control disabled.
+   *
+   *            0 = disable row based multi-threading
+   *            1 = enable row based multi-threading
+   *
+   * By default, the value is 0.
+   *
+   * Supported in codecs: AV1
+   */
+  AV1E_SET_ROW_MT,
 };
 
 /*!\brief aom 1-D scaling mode
@@ -713,6 +729,9 @@ AOM_CTRL_USE_TYPE(AV1E_GET_LEVEL, int *)
 
 AOM_CTRL_USE_TYPE(AV1E_SET_ANS_WINDOW_SIZE_LOG2, unsigned int)
 #define AOM_CTRL_AV1E_SET_ANS_WINDOW_SIZE_LOG2
+
+AOM_CTRL_USE_TYPE(AV1E_SET_ROW_MT, unsigned int)
+#define AOM_CTRL_AV1E_SET_ROW_MT
 /*!\endcond */
 /*! @} - end defgroup aom_encoder */
 #ifdef __cplusplus
@@ -129,6 +129,13 @@ enum aom_dec_control_id {
   AV1_SET_DECODE_TILE_ROW,
   AV1_SET_DECODE_TILE_COL,
 
+  /** control function to enable row-based multi-threaded decoding. Valid
+   * values are integers. When nonzero and more than one thread is configured,
+   * frames with a single tile column are decoded with superblock rows spread
+   * over the decoder threads. The default value is 0.
+   */
+  AV1D_SET_ROW_MT,
+
   AOM_DECODER_CTRL_ID_MAX,
 };
 
@@ -184,6 +191,8 @@ AOM_CTRL_USE_TYPE(AV1_SET_DECODE_TILE_ROW, int)
 #define AOM_CTRL_AV1_SET_DECODE_TILE_ROW
 AOM_CTRL_USE_TYPE(AV1_SET_DECODE_TILE_COL, int)
 #define AOM_CTRL_AV1_SET_DECODE_TILE_COL
+AOM_CTRL_USE_TYPE(AV1D_SET_ROW_MT, int)
+#define AOM_CTRL_AV1D_SET_ROW_MT
 /*!\endcond */
 /*! @} - end defgroup aom_decoder */
 
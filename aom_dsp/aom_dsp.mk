@@ -66,6 +66,7 @@ endif
 
 # intra predictions
 DSP_SRCS-yes += intrapred.c
+DSP_SRCS-yes += intrapred_common.h
 
 ifeq ($(CONFIG_DAALA_EC),yes)
 DSP_SRCS-yes += entcode.c
@@ -77,6 +78,11 @@ DSP_SRCS-$(HAVE_SSE2) += x86/intrapred_sse2.asm
 DSP_SRCS-$(HAVE_SSSE3) += x86/intrapred_ssse3.asm
 DSP_SRCS-$(HAVE_SSSE3) += x86/aom_subpixel_8t_ssse3.asm
 
+ifeq ($(CONFIG_ALT_INTRA),yes)
+DSP_SRCS-$(HAVE_SSSE3) += x86/alt_intrapred_ssse3.c
+DSP_SRCS-$(HAVE_AVX2) += x86/alt_intrapred_avx2.c
+endif  # CONFIG_ALT_INTRA
+
 ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 DSP_SRCS-$(HAVE_SSE)  += x86/highbd_intrapred_sse2.asm
 DSP_SRCS-$(HAVE_SSE2) += x86/highbd_intrapred_sse2.asm
@@ -65,8 +65,9 @@ specialize qw/aom_h_predictor_2x2/;
 
 if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
   add_proto qw/void aom_paeth_predictor_2x2/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-  
+  specialize qw/aom_paeth_predictor_2x2 ssse3/;
   add_proto qw/void aom_smooth_predictor_2x2/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
+  specialize qw/aom_smooth_predictor_2x2 ssse3/;
 } else {
   add_proto qw/void aom_tm_predictor_2x2/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
   specialize qw/aom_tm_predictor_2x2/;
@@ -152,8 +153,9 @@ specialize qw/aom_ve_predictor_4x4/;
 
 if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
   add_proto qw/void aom_paeth_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-  
+  specialize qw/aom_paeth_predictor_4x4 ssse3/;
   add_proto qw/void aom_smooth_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
+  specialize qw/aom_smooth_predictor_4x4 ssse3/;
 } else {
   add_proto qw/void aom_tm_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
   specialize qw/aom_tm_predictor_4x4 neon dspr2 msa sse2/;
@@ -206,8 +208,9 @@ specialize qw/aom_v_predictor_8x8 neon msa sse2/;
 
 if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
   add_proto qw/void aom_paeth_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-  
+  specialize qw/aom_paeth_predictor_8x8 ssse3/;
   add_proto qw/void aom_smooth_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
+  specialize qw/aom_smooth_predictor_8x8 ssse3/;
 } else {
   add_proto qw/void aom_tm_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
   specialize qw/aom_tm_predictor_8x8 neon dspr2 msa sse2/;
@@ -260,8 +263,9 @@ specialize qw/aom_v_predictor_16x16 neon msa sse2/;
 
 if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
   add_proto qw/void aom_paeth_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-  
+  specialize qw/aom_paeth_predictor_16x16 ssse3 avx2/;
   add_proto qw/void aom_smooth_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
+  specialize qw/aom_smooth_predictor_16x16 ssse3 avx2/;
 } else {
   add_proto qw/void aom_tm_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
   specialize qw/aom_tm_predictor_16x16 neon msa sse2/;
@@ -314,8 +318,9 @@ specialize qw/aom_v_predictor_32x32 neon msa sse2/;
 
 if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
   add_proto qw/void aom_paeth_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-  
+  specialize qw/aom_paeth_predictor_32x32 ssse3 avx2/;
   add_proto qw/void aom_smooth_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
+  specialize qw/aom_smooth_predictor_32x32 ssse3 avx2/;
 } else {
   add_proto qw/void aom_tm_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
   specialize qw/aom_tm_predictor_32x32 neon msa sse2/;
@@ -369,8 +374,9 @@ if ((aom_config("CONFIG_TX64X64") eq "yes")) {
 
   if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
     add_proto qw/void aom_paeth_predictor_64x64/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-    specialize qw/aom_paeth_predictor_64x64/;
+    specialize qw/aom_paeth_predictor_64x64 ssse3 avx2/;
     add_proto qw/void aom_smooth_predictor_64x64/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
+    specialize qw/aom_smooth_predictor_64x64 ssse3 avx2/;
   } else {
     add_proto qw/void aom_tm_predictor_64x64/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
     specialize qw/aom_tm_predictor_64x64/;
@@ -439,8 +445,9 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
 
 if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
   add_proto qw/void aom_highbd_paeth_predictor_2x2/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
-  
+  specialize qw/aom_highbd_paeth_predictor_2x2 ssse3/;
   add_proto qw/void aom_highbd_smooth_predictor_2x2/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
+  specialize qw/aom_highbd_smooth_predictor_2x2 ssse3/;
 } else {
   add_proto qw/void aom_highbd_tm_predictor_2x2/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
   specialize qw/aom_highbd_tm_predictor_2x2/;
@@ -481,8 +488,9 @@ if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
 
   if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
     add_proto qw/void aom_highbd_paeth_predictor_4x4/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
-    
+    specialize qw/aom_highbd_paeth_predictor_4x4 ssse3/;
     add_proto qw/void aom_highbd_smooth_predictor_4x4/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
+    specialize qw/aom_highbd_smooth_predictor_4x4 ssse3/;
   } else {
     add_proto qw/void aom_highbd_tm_predictor_4x4/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
     specialize qw/aom_highbd_tm_predictor_4x4 sse2/;
@@ -535,8 +543,9 @@ if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
 
   if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
     add_proto qw/void aom_highbd_paeth_predictor_8x8/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
-    
+    specialize qw/aom_highbd_paeth_predictor_8x8 ssse3/;
     add_proto qw/void aom_highbd_smooth_predictor_8x8/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
+    specialize qw/aom_highbd_smooth_predictor_8x8 ssse3/;
   } else {
     add_proto qw/void aom_highbd_tm_predictor_8x8/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
     specialize qw/aom_highbd_tm_predictor_8x8 sse2/;
@@ -589,8 +598,9 @@ if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
 
   if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
     add_proto qw/void aom_highbd_paeth_predictor_16x16/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
-    
+    specialize qw/aom_highbd_paeth_predictor_16x16 ssse3 avx2/;
     add_proto qw/void aom_highbd_smooth_predictor_16x16/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
+    specialize qw/aom_highbd_smooth_predictor_16x16 ssse3 avx2/;
   } else {
     add_proto qw/void aom_highbd_tm_predictor_16x16/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
     specialize qw/aom_highbd_tm_predictor_16x16 sse2/;
@@ -643,8 +653,9 @@ if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
 
   if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
     add_proto qw/void aom_highbd_paeth_predictor_32x32/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
-    
+    specialize qw/aom_highbd_paeth_predictor_32x32 ssse3 avx2/;
     add_proto qw/void aom_highbd_smooth_predictor_32x32/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
+    specialize qw/aom_highbd_smooth_predictor_32x32 ssse3 avx2/;
   } else {
     add_proto qw/void aom_highbd_tm_predictor_32x32/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
     specialize qw/aom_highbd_tm_predictor_32x32 sse2/;
@@ -698,7 +709,9 @@ if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
 
     if ((aom_config("CONFIG_ALT_INTRA") eq "yes")) {
       add_proto qw/void aom_highbd_paeth_predictor_64x64/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
+      specialize qw/aom_highbd_paeth_predictor_64x64 ssse3 avx2/;
       add_proto qw/void aom_highbd_smooth_predictor_64x64/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
+      specialize qw/aom_highbd_smooth_predictor_64x64 ssse3 avx2/;
     } else {
       add_proto qw/void aom_highbd_tm_predictor_64x64/, "uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int bd";
       specialize qw/aom_highbd_tm_predictor_64x64/;
@@ -860,9 +873,9 @@ if (aom_config("CONFIG_CLPF") eq "yes") {
     # structs as arguments, which makes the v256 type of the intrinsics
     # hard to support, so optimizations for this target are disabled.
     if ($opts{config} !~ /libs-x86-win32-vs.*/) {
-      specialize qw/aom_clpf_block_hbd sse2 ssse3 sse4_1 neon/;
-      specialize qw/aom_clpf_detect_hbd sse2 ssse3 sse4_1 neon/;
-      specialize qw/aom_clpf_detect_multi_hbd sse2 ssse3 sse4_1 neon/;
+      specialize qw/aom_clpf_block_hbd sse2 ssse3 sse4_1 avx2 neon/;
+      specialize qw/aom_clpf_detect_hbd sse2 ssse3 sse4_1 avx2 neon/;
+      specialize qw/aom_clpf_detect_multi_hbd sse2 ssse3 sse4_1 avx2 neon/;
     }
   }
   add_proto qw/void aom_clpf_block/, "const uint8_t *src, uint8_t *dst, int sstride, int dstride, int x0, int y0, int sizex, int sizey, unsigned int strength, BOUNDARY_TYPE bt, unsigned int bd";
@@ -872,9 +885,9 @@ if (aom_config("CONFIG_CLPF") eq "yes") {
   # structs as arguments, which makes the v256 type of the intrinsics
   # hard to support, so optimizations for this target are disabled.
   if ($opts{config} !~ /libs-x86-win32-vs.*/) {
-    specialize qw/aom_clpf_block sse2 ssse3 sse4_1 neon/;
-    specialize qw/aom_clpf_detect sse2 ssse3 sse4_1 neon/;
-    specialize qw/aom_clpf_detect_multi sse2 ssse3 sse4_1 neon/;
+    specialize qw/aom_clpf_block sse2 ssse3 sse4_1 avx2 neon/;
+    specialize qw/aom_clpf_detect sse2 ssse3 sse4_1 avx2 neon/;
+    specialize qw/aom_clpf_detect_multi sse2 ssse3 sse4_1 avx2 neon/;
   }
 }
 
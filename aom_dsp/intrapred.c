@@ -16,6 +16,7 @@
 #include "./aom_dsp_rtcd.h"
 
 #include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/intrapred_common.h"
 #include "aom_mem/aom_mem.h"
 
 #define DST(x, y) dst[(x) + (y)*stride]
@@ -260,47 +261,6 @@ static INLINE void paeth_predictor(uint8_t *dst, ptrdiff_t stride, int bs,
   }
 }
 
-// Weights are quadratic from 'bs' to '1', scaled by 2^12.
-// TODO(urvang): All weights can be at the same scale: going from '1' to '1/bs'
-// instead (still scaled by 2^12 or more).
-// Rationale: Given that max block dimension is 64 (=2^6), and max pixel value
-// is below 2^12 (for both normal and highbitdepth), power of (31 - 6 - 12 - 1)
-// = 12 is chosen so that all weighted sums in smooth_predictor() remain within
-// 2^31 (unsigned integer) range.
-static const int sm_weight_log2_scale = 12;
-
-#if CONFIG_TX64X64
-static const uint32_t sm_weight_arrays[6][64] = {
-#else
-static const uint32_t sm_weight_arrays[5][32] = {
-#endif  // CONFIG_TX64X64
-  // bs = 2
-  { 8192, 4096 },
-  // bs = 4
-  { 16384, 9557, 5461, 4096 },
-  // bs = 8
-  { 32768, 25161, 18725, 13458, 9362, 6437, 4681, 4096 },
-  // bs = 16
-  { 65536, 57617, 50244, 43418, 37137, 31403, 26214, 21572, 17476, 13926, 10923,
-    8465, 6554, 5188, 4369, 4096 },
-  // bs = 32
-  { 131072, 123012, 115217, 107685, 100418, 93415, 86677, 80202,
-    73992,  68046,  62365,  56948,  51795,  46906, 42281, 37921,
-    33825,  29993,  26426,  23123,  20084,  17309, 14798, 12552,
-    10570,  8853,   7399,   6210,   5285,   4625,  4228,  4096 },
-#if CONFIG_TX64X64
-  // bs = 64
-  { 262144, 254017, 246020, 238153, 230416, 222809, 215333, 207986,
-    200769, 193682, 186726, 179899, 173202, 166636, 160199, 153893,
-    147716, 141670, 135753, 129967, 124310, 118784, 113388, 108121,
-    102985, 97979,  93103,  88357,  83740,  79254,  74898,  70672,
-    66576,  62610,  58774,  55068,  51493,  48047,  44731,  41545,
-    38489,  35564,  32768,  30102,  27567,  25161,  22886,  20740,
-    18725,  16839,  15084,  13458,  11963,  10598,  9362,   8257,
-    7282,   6437,   5721,   5136,   4681,   4356,   4161,   4096 },
-#endif  // CONFIG_TX64X64
-};
-
 #define divide_round(value, bits) (((value) + (1 << ((bits)-1))) >> (bits))
 
 static INLINE void smooth_predictor(uint8_t *dst, ptrdiff_t stride, int bs,
@@ -1178,6 +1138,7 @@ static INLINE void highbd_dc_predictor(uint16_t *dst, ptrdiff_t stride, int bs,
   intra_pred_sized(type, 16) \
   intra_pred_sized(type, 32) \
   intra_pred_sized(type, 64) \
+  intra_pred_highbd_sized(type, 2) \
   intra_pred_highbd_sized(type, 4) \
   intra_pred_highbd_sized(type, 8) \
   intra_pred_highbd_sized(type, 16) \
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "./aom_dsp_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/intrapred_common.h"
+#include "aom_ports/bitops.h"
+
+// AVX2 versions of the kernels in alt_intrapred_ssse3.c for blocks that are
+// at least 16 pixels wide; they work on sixteen 16-bit pixels at a time.
+
+static INLINE int get_pixel(const void *p, int i, int hbd) {
+  return hbd ? ((const uint16_t *)p)[i] : ((const uint8_t *)p)[i];
+}
+
+static INLINE __m256i load_pixels(const void *p, int i, int hbd) {
+  if (hbd)
+    return _mm256_loadu_si256((const __m256i *)((const uint16_t *)p + i));
+  return _mm256_cvtepu8_epi16(
+      _mm_loadu_si128((const __m128i *)((const uint8_t *)p + i)));
+}
+
+static INLINE void store_pixels(void *p, ptrdiff_t i, __m256i v, int hbd) {
+  if (hbd) {
+    _mm256_storeu_si256((__m256i *)((uint16_t *)p + i), v);
+  } else {
+    const __m128i lo = _mm256_castsi256_si128(v);
+    const __m128i hi = _mm256_extracti128_si256(v, 1);
+    _mm_storeu_si128((__m128i *)((uint8_t *)p + i), _mm_packus_epi16(lo, hi));
+  }
+}
+
+static INLINE __m256i paeth_16(__m256i left, __m256i top, __m256i top_left) {
+  const __m256i base = _mm256_sub_epi16(_mm256_add_epi16(top, left), top_left);
+  const __m256i p_left = _mm256_abs_epi16(_mm256_sub_epi16(base, left));
+  const __m256i p_top = _mm256_abs_epi16(_mm256_sub_epi16(base, top));
+  const __m256i p_top_left = _mm256_abs_epi16(_mm256_sub_epi16(base, top_left));
+  const __m256i not_left =
+      _mm256_or_si256(_mm256_cmpgt_epi16(p_left, p_top),
+                      _mm256_cmpgt_epi16(p_left, p_top_left));
+  const __m256i not_top = _mm256_cmpgt_epi16(p_top, p_top_left);
+  return _mm256_blendv_epi8(left, _mm256_blendv_epi8(top, top_left, not_top),
+                            not_left);
+}
+
+static INLINE void paeth_predictor(void *dst, ptrdiff_t stride, int bs,
+                                   const void *above, const void *left,
+                                   int hbd) {
+  const __m256i top_left = _mm256_set1_epi16(get_pixel(above, -1, hbd));
+  int r, c;
+
+  for (c = 0; c < bs; c += 16) {
+    const __m256i top = load_pixels(above, c, hbd);
+    for (r = 0; r < bs; ++r) {
+      const __m256i l = _mm256_set1_epi16(get_pixel(left, r, hbd));
+      store_pixels(dst, r * stride + c, paeth_16(l, top, top_left), hbd);
+    }
+  }
+}
+
+static INLINE void load_weights(const uint32_t *w, __m256i *hi, __m256i *lo) {
+  const __m256i w0 = _mm256_loadu_si256((const __m256i *)w);
+  const __m256i w1 = _mm256_loadu_si256((const __m256i *)(w + 8));
+  const __m256i mask = _mm256_set1_epi32(0xff);
+  // packs works within 128-bit lanes; restore the column order afterwards.
+  *hi = _mm256_permute4x64_epi64(
+      _mm256_packs_epi32(_mm256_srli_epi32(w0, 8), _mm256_srli_epi32(w1, 8)),
+      0xd8);
+  *lo = _mm256_permute4x64_epi64(
+      _mm256_packs_epi32(_mm256_and_si256(w0, mask),
+                         _mm256_and_si256(w1, mask)),
+      0xd8);
+}
+
+static INLINE __m256i madd_weights(__m256i a, __m256i w_hi, __m256i w_lo) {
+  return _mm256_add_epi32(_mm256_slli_epi32(_mm256_madd_epi16(a, w_hi), 8),
+                          _mm256_madd_epi16(a, w_lo));
+}
+
+static INLINE void smooth_predictor(void *dst, ptrdiff_t stride, int bs,
+                                    const void *above, const void *left,
+                                    int hbd) {
+  const int below = get_pixel(left, bs - 1, hbd);
+  const int right = get_pixel(above, bs - 1, hbd);
+  const int log2_bs = get_msb(bs);
+  const uint32_t *const sm_weights = sm_weight_arrays[log2_bs - 1];
+  const int log2_scale = 1 + log2_bs + sm_weight_log2_scale;
+  const __m256i offset =
+      _mm256_set1_epi32((int)sm_weights[0] * (below + right) +
+                        (1 << (log2_scale - 1)));
+  const __m256i below_v = _mm256_set1_epi16(below);
+  int r, c;
+
+  for (c = 0; c < bs; c += 16) {
+    const __m256i d_top = _mm256_sub_epi16(load_pixels(above, c, hbd), below_v);
+    __m256i wc_hi, wc_lo;
+    load_weights(sm_weights + c, &wc_hi, &wc_lo);
+    for (r = 0; r < bs; ++r) {
+      const __m256i d_left =
+          _mm256_set1_epi16(get_pixel(left, r, hbd) - right);
+      const __m256i wr_hi = _mm256_set1_epi16(sm_weights[r] >> 8);
+      const __m256i wr_lo = _mm256_set1_epi16(sm_weights[r] & 0xff);
+      // The in-lane unpacks and packs below cancel out, keeping the order.
+      const __m256i a0 = _mm256_unpacklo_epi16(d_top, d_left);
+      const __m256i a1 = _mm256_unpackhi_epi16(d_top, d_left);
+      __m256i s0 = madd_weights(a0, _mm256_unpacklo_epi16(wr_hi, wc_hi),
+                                _mm256_unpacklo_epi16(wr_lo, wc_lo));
+      __m256i s1 = madd_weights(a1, _mm256_unpackhi_epi16(wr_hi, wc_hi),
+                                _mm256_unpackhi_epi16(wr_lo, wc_lo));
+      s0 = _mm256_srai_epi32(_mm256_add_epi32(s0, offset), log2_scale);
+      s1 = _mm256_srai_epi32(_mm256_add_epi32(s1, offset), log2_scale);
+      store_pixels(dst, r * stride + c, _mm256_packs_epi32(s0, s1), hbd);
+    }
+  }
+}
+
+#define intra_pred_sized(type, size)                                        \
+  void aom_##type##_predictor_##size##x##size##_avx2(                       \
+      uint8_t *dst, ptrdiff_t stride, const uint8_t *above,                 \
+      const uint8_t *left) {                                                \
+    type##_predictor(dst, stride, size, above, left, 0);                    \
+  }
+
+#if CONFIG_AOM_HIGHBITDEPTH
+#define intra_pred_highbd_sized(type, size)                                 \
+  void aom_highbd_##type##_predictor_##size##x##size##_avx2(                \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,               \
+      const uint16_t *left, int bd) {                                       \
+    (void)bd;                                                               \
+    type##_predictor(dst, stride, size, above, left, 1);                    \
+  }
+#else
+#define intra_pred_highbd_sized(type, size)
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+#if CONFIG_TX64X64
+#define intra_pred_above_8x8(type)  \
+  intra_pred_sized(type, 16)        \
+  intra_pred_sized(type, 32)        \
+  intra_pred_sized(type, 64)        \
+  intra_pred_highbd_sized(type, 16) \
+  intra_pred_highbd_sized(type, 32) \
+  intra_pred_highbd_sized(type, 64)
+#else
+#define intra_pred_above_8x8(type)  \
+  intra_pred_sized(type, 16)        \
+  intra_pred_sized(type, 32)        \
+  intra_pred_highbd_sized(type, 16) \
+  intra_pred_highbd_sized(type, 32)
+#endif  // CONFIG_TX64X64
+
+/* clang-format off */
+intra_pred_above_8x8(paeth)
+intra_pred_above_8x8(smooth)
+/* clang-format on */
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <tmmintrin.h>
+
+#include "./aom_dsp_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/intrapred_common.h"
+#include "aom_ports/bitops.h"
+
+// The predictors work on eight 16-bit pixels at a time, so the low and high
+// bitdepth versions share the kernels below; 'hbd' selects the pixel size of
+// dst, above and left and is a compile-time constant at every call site.
+
+static INLINE int get_pixel(const void *p, int i, int hbd) {
+  return hbd ? ((const uint16_t *)p)[i] : ((const uint8_t *)p)[i];
+}
+
+// Loads w (2, 4 or 8) pixels starting at p[i] as 16-bit values.
+static INLINE __m128i load_pixels(const void *p, int i, int w, int hbd) {
+  if (hbd) {
+    const uint16_t *const p16 = (const uint16_t *)p + i;
+    if (w == 8) return _mm_loadu_si128((const __m128i *)p16);
+    if (w == 4) return _mm_loadl_epi64((const __m128i *)p16);
+    return _mm_cvtsi32_si128(*(const int *)p16);
+  } else {
+    const uint8_t *const p8 = (const uint8_t *)p + i;
+    __m128i v;
+    if (w == 8)
+      v = _mm_loadl_epi64((const __m128i *)p8);
+    else if (w == 4)
+      v = _mm_cvtsi32_si128(*(const int *)p8);
+    else
+      v = _mm_cvtsi32_si128(*(const uint16_t *)p8);
+    return _mm_unpacklo_epi8(v, _mm_setzero_si128());
+  }
+}
+
+// Stores the first w (2, 4 or 8) 16-bit values of v to p[i].
+static INLINE void store_pixels(void *p, ptrdiff_t i, __m128i v, int w,
+                                int hbd) {
+  if (hbd) {
+    uint16_t *const p16 = (uint16_t *)p + i;
+    if (w == 8)
+      _mm_storeu_si128((__m128i *)p16, v);
+    else if (w == 4)
+      _mm_storel_epi64((__m128i *)p16, v);
+    else
+      *(int *)p16 = _mm_cvtsi128_si32(v);
+  } else {
+    uint8_t *const p8 = (uint8_t *)p + i;
+    v = _mm_packus_epi16(v, v);
+    if (w == 8)
+      _mm_storel_epi64((__m128i *)p8, v);
+    else if (w == 4)
+      *(int *)p8 = _mm_cvtsi128_si32(v);
+    else
+      *(uint16_t *)p8 = (uint16_t)_mm_cvtsi128_si32(v);
+  }
+}
+
+// Returns (mask & a) | (~mask & b).
+static INLINE __m128i select_epi16(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Paeth prediction of eight pixels, see paeth_predictor_single().
+static INLINE __m128i paeth_8(__m128i left, __m128i top, __m128i top_left) {
+  const __m128i base = _mm_sub_epi16(_mm_add_epi16(top, left), top_left);
+  const __m128i p_left = _mm_abs_epi16(_mm_sub_epi16(base, left));
+  const __m128i p_top = _mm_abs_epi16(_mm_sub_epi16(base, top));
+  const __m128i p_top_left = _mm_abs_epi16(_mm_sub_epi16(base, top_left));
+  const __m128i not_left = _mm_or_si128(_mm_cmpgt_epi16(p_left, p_top),
+                                        _mm_cmpgt_epi16(p_left, p_top_left));
+  const __m128i not_top = _mm_cmpgt_epi16(p_top, p_top_left);
+  return select_epi16(not_left, select_epi16(not_top, top_left, top), left);
+}
+
+static INLINE void paeth_predictor(void *dst, ptrdiff_t stride, int bs,
+                                   const void *above, const void *left,
+                                   int hbd) {
+  const __m128i top_left = _mm_set1_epi16(get_pixel(above, -1, hbd));
+  const int w = AOMMIN(bs, 8);
+  int r, c;
+
+  for (c = 0; c < bs; c += w) {
+    const __m128i top = load_pixels(above, c, w, hbd);
+    for (r = 0; r < bs; ++r) {
+      const __m128i l = _mm_set1_epi16(get_pixel(left, r, hbd));
+      store_pixels(dst, r * stride + c, paeth_8(l, top, top_left), w, hbd);
+    }
+  }
+}
+
+// Splits eight 32-bit weights into their high and low bytes, as 16-bit
+// values, so that they can be used as _mm_madd_epi16() operands.
+static INLINE void load_weights(const uint32_t *w, __m128i *hi, __m128i *lo) {
+  const __m128i w0 = _mm_loadu_si128((const __m128i *)w);
+  const __m128i w1 = _mm_loadu_si128((const __m128i *)(w + 4));
+  const __m128i mask = _mm_set1_epi32(0xff);
+  *hi = _mm_packs_epi32(_mm_srli_epi32(w0, 8), _mm_srli_epi32(w1, 8));
+  *lo = _mm_packs_epi32(_mm_and_si128(w0, mask), _mm_and_si128(w1, mask));
+}
+
+// Returns the exact 32-bit sums a.x * w.x + a.y * w.y of the 16-bit pairs in
+// a, with the weights given as high and low bytes.
+static INLINE __m128i madd_weights(__m128i a, __m128i w_hi, __m128i w_lo) {
+  return _mm_add_epi32(_mm_slli_epi32(_mm_madd_epi16(a, w_hi), 8),
+                       _mm_madd_epi16(a, w_lo));
+}
+
+// Computes smooth_predictor() with the weighted sum regrouped as
+//   w[r] * (above[c] - below) + w[c] * (left[r] - right) +
+//   scale * (below + right),
+// which leaves the rounding unchanged. The weights need up to 19 bits, so
+// they are split into bytes to keep the madd products exact.
+static INLINE void smooth_predictor(void *dst, ptrdiff_t stride, int bs,
+                                    const void *above, const void *left,
+                                    int hbd) {
+  const int below = get_pixel(left, bs - 1, hbd);
+  const int right = get_pixel(above, bs - 1, hbd);
+  const int log2_bs = get_msb(bs);
+  const uint32_t *const sm_weights = sm_weight_arrays[log2_bs - 1];
+  const int log2_scale = 1 + log2_bs + sm_weight_log2_scale;
+  const __m128i offset =
+      _mm_set1_epi32((int)sm_weights[0] * (below + right) +
+                     (1 << (log2_scale - 1)));
+  const __m128i below_v = _mm_set1_epi16(below);
+  const int w = AOMMIN(bs, 8);
+  int r, c;
+
+  for (c = 0; c < bs; c += w) {
+    const __m128i d_top =
+        _mm_sub_epi16(load_pixels(above, c, w, hbd), below_v);
+    __m128i wc_hi, wc_lo;
+    load_weights(sm_weights + c, &wc_hi, &wc_lo);
+    for (r = 0; r < bs; ++r) {
+      const __m128i d_left = _mm_set1_epi16(get_pixel(left, r, hbd) - right);
+      const __m128i wr_hi = _mm_set1_epi16(sm_weights[r] >> 8);
+      const __m128i wr_lo = _mm_set1_epi16(sm_weights[r] & 0xff);
+      const __m128i a0 = _mm_unpacklo_epi16(d_top, d_left);
+      const __m128i a1 = _mm_unpackhi_epi16(d_top, d_left);
+      __m128i s0 = madd_weights(a0, _mm_unpacklo_epi16(wr_hi, wc_hi),
+                                _mm_unpacklo_epi16(wr_lo, wc_lo));
+      __m128i s1 = madd_weights(a1, _mm_unpackhi_epi16(wr_hi, wc_hi),
+                                _mm_unpackhi_epi16(wr_lo, wc_lo));
+      s0 = _mm_srai_epi32(_mm_add_epi32(s0, offset), log2_scale);
+      s1 = _mm_srai_epi32(_mm_add_epi32(s1, offset), log2_scale);
+      store_pixels(dst, r * stride + c, _mm_packs_epi32(s0, s1), w, hbd);
+    }
+  }
+}
+
+#define intra_pred_sized(type, size)                                        \
+  void aom_##type##_predictor_##size##x##size##_ssse3(                      \
+      uint8_t *dst, ptrdiff_t stride, const uint8_t *above,                 \
+      const uint8_t *left) {                                                \
+    type##_predictor(dst, stride, size, above, left, 0);                    \
+  }
+
+#if CONFIG_AOM_HIGHBITDEPTH
+#define intra_pred_highbd_sized(type, size)                                 \
+  void aom_highbd_##type##_predictor_##size##x##size##_ssse3(               \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,               \
+      const uint16_t *left, int bd) {                                       \
+    (void)bd;                                                               \
+    type##_predictor(dst, stride, size, above, left, 1);                    \
+  }
+#else
+#define intra_pred_highbd_sized(type, size)
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+#if CONFIG_TX64X64
+#define intra_pred_allsizes(type)          \
+  intra_pred_sized(type, 2)                \
+  intra_pred_sized(type, 4)                \
+  intra_pred_sized(type, 8)                \
+  intra_pred_sized(type, 16)               \
+  intra_pred_sized(type, 32)               \
+  intra_pred_sized(type, 64)               \
+  intra_pred_highbd_sized(type, 2)         \
+  intra_pred_highbd_sized(type, 4)         \
+  intra_pred_highbd_sized(type, 8)         \
+  intra_pred_highbd_sized(type, 16)        \
+  intra_pred_highbd_sized(type, 32)        \
+  intra_pred_highbd_sized(type, 64)
+#else
+#define intra_pred_allsizes(type)          \
+  intra_pred_sized(type, 2)                \
+  intra_pred_sized(type, 4)                \
+  intra_pred_sized(type, 8)                \
+  intra_pred_sized(type, 16)               \
+  intra_pred_sized(type, 32)               \
+  intra_pred_highbd_sized(type, 2)         \
+  intra_pred_highbd_sized(type, 4)         \
+  intra_pred_highbd_sized(type, 8)         \
+  intra_pred_highbd_sized(type, 16)        \
+  intra_pred_highbd_sized(type, 32)
+#endif  // CONFIG_TX64X64
+
+/* clang-format off */
+intra_pred_allsizes(paeth)
+intra_pred_allsizes(smooth)
+/* clang-format on */
@@ -77,6 +77,15 @@ AV1_COMMON_SRCS-yes += common/convolve.c
 AV1_COMMON_SRCS-yes += common/convolve.h
 AV1_COMMON_SRCS-$(CONFIG_LOOP_RESTORATION) += common/restoration.h
 AV1_COMMON_SRCS-$(CONFIG_LOOP_RESTORATION) += common/restoration.c
+ifeq ($(CONFIG_LOOP_RESTORATION),yes)
+AV1_COMMON_SRCS-$(HAVE_SSE2) += common/x86/wiener_convolve_sse2.c
+AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/selfguided_sse4.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/selfguided_avx2.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/wiener_convolve_avx2.c
+ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
+AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/highbd_wiener_convolve_sse4.c
+endif
+endif
 ifeq (yes,$(filter $(CONFIG_GLOBAL_MOTION) $(CONFIG_WARPED_MOTION),yes))
 AV1_COMMON_SRCS-yes += common/warped_motion.h
 AV1_COMMON_SRCS-yes += common/warped_motion.c
@@ -89,6 +98,7 @@ AV1_COMMON_SRCS-yes += common/clpf_simd_kernel.h
 AV1_COMMON_SRCS-$(HAVE_SSE2) += common/clpf_sse2.c
 AV1_COMMON_SRCS-$(HAVE_SSSE3) += common/clpf_ssse3.c
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/clpf_sse4.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/clpf_avx2.c
 AV1_COMMON_SRCS-$(HAVE_NEON) += common/clpf_neon.c
 endif
 ifeq ($(CONFIG_DERING),yes)
@@ -96,6 +106,7 @@ AV1_COMMON_SRCS-yes += common/od_dering.c
 AV1_COMMON_SRCS-yes += common/od_dering.h
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/od_dering_sse4.c
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/od_dering_sse4.h
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/od_dering_avx2.c
 AV1_COMMON_SRCS-yes += common/dering.c
 AV1_COMMON_SRCS-yes += common/dering.h
 endif
@@ -135,18 +146,29 @@ AV1_COMMON_SRCS-$(HAVE_MSA) += common/mips/msa/av1_idct4x4_msa.c
 AV1_COMMON_SRCS-$(HAVE_MSA) += common/mips/msa/av1_idct8x8_msa.c
 AV1_COMMON_SRCS-$(HAVE_MSA) += common/mips/msa/av1_idct16x16_msa.c
 
+AV1_COMMON_SRCS-$(HAVE_SSE2) += common/x86/hybrid_txfm32_common.h
+AV1_COMMON_SRCS-$(HAVE_SSE2) += common/x86/hybrid_txfm32_sse2.h
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/hybrid_txfm32_avx2.h
 AV1_COMMON_SRCS-$(HAVE_SSE2) += common/x86/idct_intrin_sse2.c
 AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/hybrid_inv_txfm_avx2.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/av1_txfm1d_avx2.h
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/av1_inv_txfm1d_avx2.c
 
 ifeq ($(CONFIG_AV1_ENCODER),yes)
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/av1_txfm1d_sse4.h
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/av1_fwd_txfm1d_sse4.c
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/av1_fwd_txfm2d_sse4.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/av1_fwd_txfm1d_avx2.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/av1_fwd_txfm2d_avx2.c
 endif
 ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/highbd_txfm_utility_sse4.h
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/highbd_inv_txfm_sse4.c
 AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/highbd_inv_txfm_avx2.c
+AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/hybrid_txfm32_sse4.h
+AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/highbd_hybrid_inv_txfm_impl.h
+AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/highbd_hybrid_inv_txfm_sse4.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/highbd_hybrid_inv_txfm_avx2.c
 endif
 
 ifneq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
@@ -158,8 +180,20 @@ ifeq ($(CONFIG_FILTER_INTRA),yes)
 AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/filterintra_sse4.c
 endif
 
+ifeq ($(CONFIG_EXT_INTRA),yes)
+AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/dr_prediction_impl.h
+AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/dr_prediction_sse4.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/dr_prediction_avx2.c
+endif
+
 ifneq ($(findstring yes,$(CONFIG_GLOBAL_MOTION) $(CONFIG_WARPED_MOTION)),)
+AV1_COMMON_SRCS-$(HAVE_SSE2) += common/x86/warp_plane_common.h
 AV1_COMMON_SRCS-$(HAVE_SSE2) += common/x86/warp_plane_sse2.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/warp_plane_avx2.c
+ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
+AV1_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/highbd_warp_plane_sse4.c
+AV1_COMMON_SRCS-$(HAVE_AVX2) += common/x86/highbd_warp_plane_avx2.c
+endif
 endif
 
 $(eval $(call rtcd_h_template,av1_rtcd,av1/common/av1_rtcd_defs.pl))
@@ -50,6 +50,10 @@ AV1_CX_SRCS-$(CONFIG_GLOBAL_MOTION) += encoder/global_motion.c
 AV1_CX_SRCS-$(CONFIG_GLOBAL_MOTION) += encoder/global_motion.h
 AV1_CX_SRCS-$(CONFIG_GLOBAL_MOTION) += encoder/ransac.c
 AV1_CX_SRCS-$(CONFIG_GLOBAL_MOTION) += encoder/ransac.h
+ifeq ($(CONFIG_GLOBAL_MOTION),yes)
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/corner_match_sse4.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/corner_match_avx2.c
+endif
 AV1_CX_SRCS-yes += encoder/block.h
 AV1_CX_SRCS-yes += encoder/bitstream.h
 AV1_CX_SRCS-yes += encoder/encodemb.h
@@ -110,6 +114,7 @@ AV1_CX_SRCS-yes += encoder/clpf_rdo_simd.h
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/clpf_rdo_sse2.c
 AV1_CX_SRCS-$(HAVE_SSSE3) += encoder/clpf_rdo_ssse3.c
 AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/clpf_rdo_sse4.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/clpf_rdo_avx2.c
 AV1_CX_SRCS-$(HAVE_NEON) += encoder/clpf_rdo_neon.c
 endif
 ifeq ($(CONFIG_PVQ),yes)
@@ -123,7 +128,6 @@ AV1_CX_SRCS-yes += encoder/laplace_encoder.c
 endif
 
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/av1_quantize_sse2.c
-AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/temporal_filter_apply_sse2.asm
 ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/highbd_block_error_intrin_sse2.c
 endif
@@ -135,12 +139,25 @@ ifeq ($(ARCH_X86_64),yes)
 AV1_CX_SRCS-$(HAVE_SSSE3) += encoder/x86/av1_quantize_ssse3_x86_64.asm
 endif
 
+AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/hybrid_fwd_txfm32_impl.h
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/dct_intrin_sse2.c
 AV1_CX_SRCS-$(HAVE_SSSE3) += encoder/x86/dct_ssse3.c
 AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/hybrid_fwd_txfm_avx2.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/av1_quantize_avx2.c
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/temporal_filter_x86.h
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/temporal_filter_avx2.c
 ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/av1_highbd_quantize_sse4.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/av1_highbd_quantize_avx2.c
 AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/highbd_fwd_txfm_sse4.c
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/highbd_hybrid_fwd_txfm_sse4.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/highbd_hybrid_fwd_txfm_avx2.c
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/highbd_temporal_filter_sse4.c
+endif
+
+ifeq ($(CONFIG_NEW_QUANT),yes)
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/av1_quantize_nuq_sse4.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/av1_quantize_nuq_avx2.c
 endif
 
 ifeq ($(CONFIG_EXT_INTER),yes)
@@ -149,6 +166,14 @@ AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/wedge_utils_sse2.c
 endif
 
 AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/error_intrin_avx2.c
+ifeq ($(CONFIG_PALETTE),yes)
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/palette_avx2.c
+endif
+
+ifeq ($(CONFIG_LOOP_RESTORATION),yes)
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/pickrst_sse4.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/pickrst_avx2.c
+endif
 
 ifneq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 AV1_CX_SRCS-$(HAVE_NEON) += encoder/arm/neon/dct_neon.c
@@ -161,6 +186,5 @@ AV1_CX_SRCS-$(HAVE_MSA) += encoder/mips/msa/fdct4x4_msa.c
 AV1_CX_SRCS-$(HAVE_MSA) += encoder/mips/msa/fdct8x8_msa.c
 AV1_CX_SRCS-$(HAVE_MSA) += encoder/mips/msa/fdct16x16_msa.c
 AV1_CX_SRCS-$(HAVE_MSA) += encoder/mips/msa/fdct_msa.h
-AV1_CX_SRCS-$(HAVE_MSA) += encoder/mips/msa/temporal_filter_msa.c
 
 AV1_CX_SRCS-yes := $(filter-out $(AV1_CX_SRCS_REMOVE-yes),$(AV1_CX_SRCS-yes))
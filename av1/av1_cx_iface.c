@@ -63,6 +63,7 @@ struct av1_extracfg {
   unsigned int disable_tempmv;
 #endif
   unsigned int frame_parallel_decoding_mode;
+  unsigned int row_mt;
   AQ_MODE aq_mode;
   unsigned int frame_periodic_boost;
   aom_bit_depth_t bit_depth;
@@ -122,6 +123,7 @@ static struct av1_extracfg default_extra_cfg = {
   0,  // disable temporal mv prediction
 #endif
   1,                            // frame_parallel_decoding_mode
+  0,                            // row_mt
   NO_AQ,                        // aq_mode
   0,                            // frame_periodic_delta_q
   AOM_BITS_8,                   // Bit depth
@@ -331,6 +333,7 @@ static aom_codec_err_t validate_config(aom_codec_alg_priv_t *ctx,
   }
   RANGE_CHECK(extra_cfg, color_space, AOM_CS_UNKNOWN, AOM_CS_SRGB);
   RANGE_CHECK(extra_cfg, color_range, 0, 1);
+  RANGE_CHECK_HI(extra_cfg, row_mt, 1);
 #if CONFIG_ANS && ANS_MAX_SYMBOLS
   RANGE_CHECK(extra_cfg, ans_window_size_log2, 8, 23);
 #endif
@@ -530,6 +533,7 @@ static aom_codec_err_t set_encoder_config(
 #endif  // CONFIG_LOOPFILTERING_ACROSS_TILES
   oxcf->error_resilient_mode = cfg->g_error_resilient;
   oxcf->frame_parallel_decoding_mode = extra_cfg->frame_parallel_decoding_mode;
+  oxcf->row_mt = extra_cfg->row_mt;
 
   oxcf->aq_mode = extra_cfg->aq_mode;
 
@@ -818,6 +822,13 @@ static aom_codec_err_t ctrl_set_frame_parallel_decoding_mode(
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static aom_codec_err_t ctrl_set_row_mt(aom_codec_alg_priv_t *ctx,
+                                       va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.row_mt = CAST(AV1E_SET_ROW_MT, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
 static aom_codec_err_t ctrl_set_aq_mode(aom_codec_alg_priv_t *ctx,
                                         va_list args) {
   struct av1_extracfg extra_cfg = ctx->extra_cfg;
@@ -1434,6 +1445,7 @@ static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AV1E_SET_DISABLE_TEMPMV, ctrl_set_disable_tempmv },
 #endif
   { AV1E_SET_FRAME_PARALLEL_DECODING, ctrl_set_frame_parallel_decoding_mode },
+  { AV1E_SET_ROW_MT, ctrl_set_row_mt },
   { AV1E_SET_AQ_MODE, ctrl_set_aq_mode },
   { AV1E_SET_FRAME_PERIODIC_BOOST, ctrl_set_frame_periodic_boost },
   { AV1E_SET_TUNE_CONTENT, ctrl_set_tune_content },
@@ -22,6 +22,7 @@ struct mv;
 union int_mv;
 struct yv12_buffer_config;
 typedef int16_t od_dering_in;
+struct dering_list;
 EOF
 }
 forward_decls qw/av1_common_forward_decls/;
@@ -123,16 +124,16 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
       specialize qw/av1_iht32x16_512_add sse2/;
 
     add_proto qw/void av1_iht4x16_64_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
-      specialize qw/av1_iht4x16_64_add/;
+      specialize qw/av1_iht4x16_64_add sse2/;
 
     add_proto qw/void av1_iht16x4_64_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
-      specialize qw/av1_iht16x4_64_add/;
+      specialize qw/av1_iht16x4_64_add sse2/;
 
     add_proto qw/void av1_iht8x32_256_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
-      specialize qw/av1_iht8x32_256_add/;
+      specialize qw/av1_iht8x32_256_add sse2/;
 
     add_proto qw/void av1_iht32x8_256_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
-      specialize qw/av1_iht32x8_256_add/;
+      specialize qw/av1_iht32x8_256_add sse2/;
 
     add_proto qw/void av1_iht8x8_64_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
       specialize qw/av1_iht8x8_64_add sse2/;
@@ -142,6 +143,9 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
 
     add_proto qw/void av1_iht32x32_1024_add/, "const tran_low_t *input, uint8_t *output, int pitch, int tx_type";
       specialize qw/av1_iht32x32_1024_add/;
+    if (aom_config("CONFIG_EXT_TX") eq "yes") {
+      specialize qw/av1_iht32x32_1024_add sse2 avx2/;
+    }
   }
 } else {
   # Force C versions if CONFIG_EMULATE_HARDWARE is 1
@@ -211,16 +215,16 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
       specialize qw/av1_iht32x16_512_add sse2/;
 
     add_proto qw/void av1_iht4x16_64_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
-      specialize qw/av1_iht4x16_64_add/;
+      specialize qw/av1_iht4x16_64_add sse2/;
 
     add_proto qw/void av1_iht16x4_64_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
-      specialize qw/av1_iht16x4_64_add/;
+      specialize qw/av1_iht16x4_64_add sse2/;
 
     add_proto qw/void av1_iht8x32_256_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
-      specialize qw/av1_iht8x32_256_add/;
+      specialize qw/av1_iht8x32_256_add sse2/;
 
     add_proto qw/void av1_iht32x8_256_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
-      specialize qw/av1_iht32x8_256_add/;
+      specialize qw/av1_iht32x8_256_add sse2/;
 
     add_proto qw/void av1_iht8x8_64_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
       specialize qw/av1_iht8x8_64_add sse2 neon dspr2/;
@@ -230,6 +234,9 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
 
     add_proto qw/void av1_iht32x32_1024_add/, "const tran_low_t *input, uint8_t *output, int pitch, int tx_type";
       specialize qw/av1_iht32x32_1024_add/;
+    if (aom_config("CONFIG_EXT_TX") eq "yes") {
+      specialize qw/av1_iht32x32_1024_add sse2 avx2/;
+    }
 
     if (aom_config("CONFIG_EXT_TX") ne "yes") {
       specialize qw/av1_iht4x4_16_add msa/;
@@ -244,28 +251,28 @@ specialize qw/av1_iht32x32_1024_add/;
 
 if (aom_config("CONFIG_TX64X64") eq "yes") {
   add_proto qw/void av1_iht64x64_4096_add/, "const tran_low_t *input, uint8_t *output, int pitch, int tx_type";
-  specialize qw/av1_iht64x64_4096_add/;
+  specialize qw/av1_iht64x64_4096_add avx2/;
 }
 
 if (aom_config("CONFIG_NEW_QUANT") eq "yes") {
   add_proto qw/void quantize_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-  specialize qw/quantize_nuq/;
+  specialize qw/quantize_nuq sse4_1 avx2/;
 
   add_proto qw/void quantize_fp_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-  specialize qw/quantize_fp_nuq/;
+  specialize qw/quantize_fp_nuq sse4_1 avx2/;
 
   add_proto qw/void quantize_32x32_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-  specialize qw/quantize_32x32_nuq/;
+  specialize qw/quantize_32x32_nuq sse4_1 avx2/;
 
   add_proto qw/void quantize_32x32_fp_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-  specialize qw/quantize_32x32_fp_nuq/;
+  specialize qw/quantize_32x32_fp_nuq sse4_1 avx2/;
 
   if (aom_config("CONFIG_TX64X64") eq "yes") {
     add_proto qw/void quantize_64x64_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-    specialize qw/quantize_64x64_nuq/;
+    specialize qw/quantize_64x64_nuq sse4_1 avx2/;
 
     add_proto qw/void quantize_64x64_fp_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-    specialize qw/quantize_64x64_fp_nuq/;
+    specialize qw/quantize_64x64_fp_nuq sse4_1 avx2/;
   }
 }
 
@@ -316,6 +323,25 @@ if (aom_config("CONFIG_FILTER_INTRA") eq "yes") {
   }
 }
 
+# Directional intra predictors
+if (aom_config("CONFIG_EXT_INTRA") eq "yes") {
+  add_proto qw/void av1_dr_prediction_z1/, "uint8_t *dst, ptrdiff_t stride, int bs, const uint8_t *above, const uint8_t *left, int dx, int dy";
+  specialize qw/av1_dr_prediction_z1 sse4_1 avx2/;
+  add_proto qw/void av1_dr_prediction_z2/, "uint8_t *dst, ptrdiff_t stride, int bs, const uint8_t *above, const uint8_t *left, int dx, int dy";
+  specialize qw/av1_dr_prediction_z2 sse4_1 avx2/;
+  add_proto qw/void av1_dr_prediction_z3/, "uint8_t *dst, ptrdiff_t stride, int bs, const uint8_t *above, const uint8_t *left, int dx, int dy";
+  specialize qw/av1_dr_prediction_z3 sse4_1 avx2/;
+  # High bitdepth functions
+  if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
+    add_proto qw/void av1_highbd_dr_prediction_z1/, "uint16_t *dst, ptrdiff_t stride, int bs, const uint16_t *above, const uint16_t *left, int dx, int dy, int bd";
+    specialize qw/av1_highbd_dr_prediction_z1 sse4_1 avx2/;
+    add_proto qw/void av1_highbd_dr_prediction_z2/, "uint16_t *dst, ptrdiff_t stride, int bs, const uint16_t *above, const uint16_t *left, int dx, int dy, int bd";
+    specialize qw/av1_highbd_dr_prediction_z2 sse4_1 avx2/;
+    add_proto qw/void av1_highbd_dr_prediction_z3/, "uint16_t *dst, ptrdiff_t stride, int bs, const uint16_t *above, const uint16_t *left, int dx, int dy, int bd";
+    specialize qw/av1_highbd_dr_prediction_z3 sse4_1 avx2/;
+  }
+}
+
 # High bitdepth functions
 if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
   #
@@ -388,6 +414,30 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
 
   add_proto qw/void av1_highbd_iht16x16_256_add/, "const tran_low_t *input, uint8_t *output, int pitch, int tx_type, int bd";
   specialize qw/av1_highbd_iht16x16_256_add/;
+
+  if (aom_config("CONFIG_EXT_TX") eq "yes") {
+    add_proto qw/void av1_highbd_iht32x32_1024_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type, int bd";
+    specialize qw/av1_highbd_iht32x32_1024_add/;
+  }
+
+  if (aom_config("CONFIG_EMULATE_HARDWARE") ne "yes") {
+    specialize qw/av1_highbd_iht4x4_16_add sse4_1/;
+    specialize qw/av1_highbd_iht4x8_32_add sse4_1/;
+    specialize qw/av1_highbd_iht8x4_32_add sse4_1/;
+    specialize qw/av1_highbd_iht4x16_64_add sse4_1/;
+    specialize qw/av1_highbd_iht16x4_64_add sse4_1/;
+    specialize qw/av1_highbd_iht8x8_64_add sse4_1 avx2/;
+    specialize qw/av1_highbd_iht8x16_128_add sse4_1 avx2/;
+    specialize qw/av1_highbd_iht16x8_128_add sse4_1 avx2/;
+    specialize qw/av1_highbd_iht8x32_256_add sse4_1 avx2/;
+    specialize qw/av1_highbd_iht32x8_256_add sse4_1 avx2/;
+    specialize qw/av1_highbd_iht16x16_256_add sse4_1 avx2/;
+    specialize qw/av1_highbd_iht16x32_512_add sse4_1 avx2/;
+    specialize qw/av1_highbd_iht32x16_512_add sse4_1 avx2/;
+    if (aom_config("CONFIG_EXT_TX") eq "yes") {
+      specialize qw/av1_highbd_iht32x32_1024_add sse4_1 avx2/;
+    }
+  }
 }
 
 #
@@ -453,7 +503,7 @@ if (aom_config("CONFIG_AOM_QM") eq "yes") {
 
     if (aom_config("CONFIG_TX64X64") eq "yes") {
       add_proto qw/void av1_quantize_fp_64x64/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
-      specialize qw/av1_quantize_fp_64x64/;
+      specialize qw/av1_quantize_fp_64x64 avx2/;
     }
 
     add_proto qw/void av1_fdct8x8_quant/, "const int16_t *input, int stride, tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
@@ -473,7 +523,7 @@ if (aom_config("CONFIG_AOM_QM") eq "yes") {
 
     if (aom_config("CONFIG_TX64X64") eq "yes") {
       add_proto qw/void av1_quantize_fp_64x64/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
-      specialize qw/av1_quantize_fp_64x64/;
+      specialize qw/av1_quantize_fp_64x64 avx2/;
     }
 
     add_proto qw/void av1_fdct8x8_quant/, "const int16_t *input, int stride, tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
@@ -501,7 +551,7 @@ specialize qw/av1_fht32x32 avx2/;
 
 if (aom_config("CONFIG_TX64X64") eq "yes") {
   add_proto qw/void av1_fht64x64/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_fht64x64/;
+  specialize qw/av1_fht64x64 avx2/;
 }
 
 add_proto qw/void av1_fht4x8/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
@@ -523,16 +573,16 @@ add_proto qw/void av1_fht32x16/, "const int16_t *input, tran_low_t *output, int
 specialize qw/av1_fht32x16 sse2/;
 
 add_proto qw/void av1_fht4x16/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-specialize qw/av1_fht4x16/;
+specialize qw/av1_fht4x16 sse2/;
 
 add_proto qw/void av1_fht16x4/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-specialize qw/av1_fht16x4/;
+specialize qw/av1_fht16x4 sse2/;
 
 add_proto qw/void av1_fht8x32/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-specialize qw/av1_fht8x32/;
+specialize qw/av1_fht8x32 sse2 avx2/;
 
 add_proto qw/void av1_fht32x8/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-specialize qw/av1_fht32x8/;
+specialize qw/av1_fht32x8 sse2 avx2/;
 
 if (aom_config("CONFIG_AOM_HIGHBITDEPTH") ne "yes") {
   if (aom_config("CONFIG_EXT_TX") ne "yes") {
@@ -556,7 +606,7 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
   add_proto qw/void av1_fwd_txfm2d_32x32/, "const int16_t *input, int32_t *output, int stride, int tx_type, int bd";
   specialize qw/av1_fwd_txfm2d_32x32 sse4_1/;
   add_proto qw/void av1_fwd_txfm2d_64x64/, "const int16_t *input, int32_t *output, int stride, int tx_type, int bd";
-  specialize qw/av1_fwd_txfm2d_64x64 sse4_1/;
+  specialize qw/av1_fwd_txfm2d_64x64 sse4_1 avx2/;
 
   #inv txfm
   add_proto qw/void av1_inv_txfm2d_add_4x4/, "const int32_t *input, uint16_t *output, int stride, int tx_type, int bd";
@@ -568,7 +618,7 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
   add_proto qw/void av1_inv_txfm2d_add_32x32/, "const int32_t *input, uint16_t *output, int stride, int tx_type, int bd";
   specialize qw/av1_inv_txfm2d_add_32x32 avx2/;
   add_proto qw/void av1_inv_txfm2d_add_64x64/, "const int32_t *input, uint16_t *output, int stride, int tx_type, int bd";
-  specialize qw/av1_inv_txfm2d_add_64x64/;
+  specialize qw/av1_inv_txfm2d_add_64x64 avx2/;
 }
 
 #
@@ -586,7 +636,7 @@ add_proto qw/int av1_full_range_search/, "const struct macroblock *x, const stru
 specialize qw/av1_full_range_search/;
 
 add_proto qw/void av1_temporal_filter_apply/, "uint8_t *frame1, unsigned int stride, uint8_t *frame2, unsigned int block_width, unsigned int block_height, int strength, int filter_weight, unsigned int *accumulator, uint16_t *count";
-specialize qw/av1_temporal_filter_apply sse2 msa/;
+specialize qw/av1_temporal_filter_apply avx2/;
 
 if (aom_config("CONFIG_AOM_QM") eq "yes") {
   add_proto qw/void av1_quantize_b/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, const qm_val_t * qm_ptr, const qm_val_t * iqm_ptr, int log_scale";
@@ -601,23 +651,23 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
   # ENCODEMB INVOKE
   if (aom_config("CONFIG_NEW_QUANT") eq "yes") {
     add_proto qw/void highbd_quantize_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-    specialize qw/highbd_quantize_nuq/;
+    specialize qw/highbd_quantize_nuq sse4_1 avx2/;
 
     add_proto qw/void highbd_quantize_fp_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-    specialize qw/highbd_quantize_fp_nuq/;
+    specialize qw/highbd_quantize_fp_nuq sse4_1 avx2/;
 
     add_proto qw/void highbd_quantize_32x32_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-    specialize qw/highbd_quantize_32x32_nuq/;
+    specialize qw/highbd_quantize_32x32_nuq sse4_1 avx2/;
 
     add_proto qw/void highbd_quantize_32x32_fp_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-    specialize qw/highbd_quantize_32x32_fp_nuq/;
+    specialize qw/highbd_quantize_32x32_fp_nuq sse4_1 avx2/;
 
     if (aom_config("CONFIG_TX64X64") eq "yes") {
       add_proto qw/void highbd_quantize_64x64_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-      specialize qw/highbd_quantize_64x64_nuq/;
+      specialize qw/highbd_quantize_64x64_nuq sse4_1 avx2/;
 
       add_proto qw/void highbd_quantize_64x64_fp_nuq/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *quant_ptr, const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr, const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan, const uint8_t *band";
-      specialize qw/highbd_quantize_64x64_fp_nuq/;
+      specialize qw/highbd_quantize_64x64_fp_nuq sse4_1 avx2/;
     }
   }
 
@@ -640,7 +690,7 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
     specialize qw/av1_highbd_quantize_b/;
   } else {
     add_proto qw/void av1_highbd_quantize_fp/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, int log_scale";
-    specialize qw/av1_highbd_quantize_fp sse4_1/;
+    specialize qw/av1_highbd_quantize_fp sse4_1 avx2/;
 
     add_proto qw/void av1_highbd_quantize_b/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, int log_scale";
     specialize qw/av1_highbd_quantize_b/;
@@ -651,43 +701,43 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
   specialize qw/av1_highbd_fht4x4 sse4_1/;
 
   add_proto qw/void av1_highbd_fht4x8/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht4x8/;
+  specialize qw/av1_highbd_fht4x8 sse4_1/;
 
   add_proto qw/void av1_highbd_fht8x4/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht8x4/;
+  specialize qw/av1_highbd_fht8x4 sse4_1/;
 
   add_proto qw/void av1_highbd_fht8x16/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht8x16/;
+  specialize qw/av1_highbd_fht8x16 sse4_1 avx2/;
 
   add_proto qw/void av1_highbd_fht16x8/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht16x8/;
+  specialize qw/av1_highbd_fht16x8 sse4_1 avx2/;
 
   add_proto qw/void av1_highbd_fht16x32/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht16x32/;
+  specialize qw/av1_highbd_fht16x32 sse4_1 avx2/;
 
   add_proto qw/void av1_highbd_fht32x16/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht32x16/;
+  specialize qw/av1_highbd_fht32x16 sse4_1 avx2/;
 
   add_proto qw/void av1_highbd_fht4x16/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht4x16/;
+  specialize qw/av1_highbd_fht4x16 sse4_1/;
 
   add_proto qw/void av1_highbd_fht16x4/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht16x4/;
+  specialize qw/av1_highbd_fht16x4 sse4_1/;
 
   add_proto qw/void av1_highbd_fht8x32/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht8x32/;
+  specialize qw/av1_highbd_fht8x32 sse4_1 avx2/;
 
   add_proto qw/void av1_highbd_fht32x8/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht32x8/;
+  specialize qw/av1_highbd_fht32x8 sse4_1 avx2/;
 
   add_proto qw/void av1_highbd_fht8x8/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht8x8/;
+  specialize qw/av1_highbd_fht8x8 sse4_1 avx2/;
 
   add_proto qw/void av1_highbd_fht16x16/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht16x16/;
+  specialize qw/av1_highbd_fht16x16 sse4_1 avx2/;
 
   add_proto qw/void av1_highbd_fht32x32/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/av1_highbd_fht32x32/;
+  specialize qw/av1_highbd_fht32x32 sse4_1 avx2/;
 
   if (aom_config("CONFIG_TX64X64") eq "yes") {
     add_proto qw/void av1_highbd_fht64x64/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
@@ -695,10 +745,10 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
   }
 
   add_proto qw/void av1_highbd_fwht4x4/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/av1_highbd_fwht4x4/;
+  specialize qw/av1_highbd_fwht4x4 sse4_1/;
 
   add_proto qw/void av1_highbd_temporal_filter_apply/, "uint8_t *frame1, unsigned int stride, uint8_t *frame2, unsigned int block_width, unsigned int block_height, int strength, int filter_weight, unsigned int *accumulator, uint16_t *count";
-  specialize qw/av1_highbd_temporal_filter_apply/;
+  specialize qw/av1_highbd_temporal_filter_apply sse4_1 avx2/;
 
 }
 # End av1_high encoder functions
@@ -712,6 +762,26 @@ if (aom_config("CONFIG_EXT_INTER") eq "yes") {
   specialize qw/av1_wedge_compute_delta_squares sse2/;
 }
 
+if (aom_config("CONFIG_PALETTE") eq "yes") {
+  add_proto qw/void av1_calc_indices/, "const float *data, const float *centroids, uint8_t *indices, int n, int k, int dim";
+  specialize qw/av1_calc_indices avx2/;
+}
+
+if (aom_config("CONFIG_LOOP_RESTORATION") eq "yes") {
+  add_proto qw/int64_t av1_wiener_corr/, "const uint8_t *a, int a_stride, const uint8_t *b, int b_stride, int width, int height";
+  specialize qw/av1_wiener_corr sse4_1 avx2/;
+
+  if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
+    add_proto qw/int64_t av1_highbd_wiener_corr/, "const uint8_t *a, int a_stride, const uint8_t *b, int b_stride, int width, int height";
+    specialize qw/av1_highbd_wiener_corr sse4_1 avx2/;
+  }
+}
+
+if (aom_config("CONFIG_GLOBAL_MOTION") eq "yes") {
+  add_proto qw/double av1_compute_cross_correlation/, "unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2";
+  specialize qw/av1_compute_cross_correlation sse4_1 avx2/;
+}
+
 }
 # end encoder functions
 
@@ -754,16 +824,44 @@ if (aom_config("CONFIG_DERING") eq "yes") {
   specialize qw/od_dir_find8 sse4_1/;
 
   add_proto qw/int od_filter_dering_direction_4x4/, "int16_t *y, int ystride, const int16_t *in, int threshold, int dir";
-  specialize qw/od_filter_dering_direction_4x4 sse4_1/;
+  specialize qw/od_filter_dering_direction_4x4 sse4_1 avx2/;
 
   add_proto qw/int od_filter_dering_direction_8x8/, "int16_t *y, int ystride, const int16_t *in, int threshold, int dir";
-  specialize qw/od_filter_dering_direction_8x8 sse4_1/;
+  specialize qw/od_filter_dering_direction_8x8 sse4_1 avx2/;
 
   add_proto qw/void od_filter_dering_orthogonal_4x4/, "int16_t *y, int ystride, const int16_t *in, int threshold, int dir";
-  specialize qw/od_filter_dering_orthogonal_4x4 sse4_1/;
+  specialize qw/od_filter_dering_orthogonal_4x4 sse4_1 avx2/;
 
   add_proto qw/void od_filter_dering_orthogonal_8x8/, "int16_t *y, int ystride, const int16_t *in, int threshold, int dir";
-  specialize qw/od_filter_dering_orthogonal_8x8 sse4_1/;
+  specialize qw/od_filter_dering_orthogonal_8x8 sse4_1 avx2/;
+
+  # Superblock-level variants that run a whole dering_list in one call.
+  add_proto qw/void od_dir_find8_list/, "const od_dering_in *in, const struct dering_list *dlist, int dering_count, int *dirs, int32_t *vars, int coeff_shift";
+  specialize qw/od_dir_find8_list sse4_1 avx2/;
+
+  add_proto qw/void od_filter_dering_direction_list/, "int16_t *y, const int16_t *in, const struct dering_list *dlist, int dering_count, int bsize, const int *thresholds, const int *dirs, int *filter2_thresh";
+  specialize qw/od_filter_dering_direction_list sse4_1 avx2/;
+
+  add_proto qw/void od_filter_dering_orthogonal_list/, "int16_t *y, const int16_t *in, const struct dering_list *dlist, int dering_count, int bsize, const int *thresholds, const int *dirs";
+  specialize qw/od_filter_dering_orthogonal_list sse4_1 avx2/;
+}
+
+# Loop restoration functions
+
+if (aom_config("CONFIG_LOOP_RESTORATION") eq "yes") {
+  add_proto qw/void av1_box_sum/, "int32_t *src, int width, int height, int src_stride, int r, int sqr, int32_t *dst, int dst_stride";
+  specialize qw/av1_box_sum sse4_1 avx2/;
+
+  add_proto qw/void av1_selfguided_restoration/, "int32_t *dgd, int width, int height, int stride, int bit_depth, int r, int eps, int32_t *tmpbuf";
+  specialize qw/av1_selfguided_restoration sse4_1 avx2/;
+
+  add_proto qw/void av1_wiener_convolve_add_src/, "const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst, ptrdiff_t dst_stride, const int16_t *filter_x, const int16_t *filter_y, int w, int h";
+  specialize qw/av1_wiener_convolve_add_src sse2 avx2/;
+
+  if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
+    add_proto qw/void av1_highbd_wiener_convolve_add_src/, "const uint16_t *src, ptrdiff_t src_stride, uint16_t *dst, ptrdiff_t dst_stride, const int16_t *filter_x, const int16_t *filter_y, int w, int h, int bd";
+    specialize qw/av1_highbd_wiener_convolve_add_src sse4_1 avx2/;
+  }
 }
 
 # WARPED_MOTION / GLOBAL_MOTION functions
@@ -771,7 +869,12 @@ if (aom_config("CONFIG_DERING") eq "yes") {
 if ((aom_config("CONFIG_WARPED_MOTION") eq "yes") ||
     (aom_config("CONFIG_GLOBAL_MOTION") eq "yes")) {
   add_proto qw/void av1_warp_affine/, "int32_t *mat, uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int ref_frm, int32_t alpha, int32_t beta, int32_t gamma, int32_t delta";
-  specialize qw/av1_warp_affine sse2/;
+  specialize qw/av1_warp_affine sse2 avx2/;
+
+  if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
+    add_proto qw/void av1_highbd_warp_affine/, "int32_t *mat, uint16_t *ref, int width, int height, int stride, uint16_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int bd, int ref_frm, int32_t alpha, int32_t beta, int32_t gamma, int32_t delta";
+    specialize qw/av1_highbd_warp_affine sse4_1 avx2/;
+  }
 }
 
 1;
@@ -90,15 +90,61 @@ void aom_clpf_block_hbd_c(const uint16_t *src, uint16_t *dst, int sstride,
 }
 #endif
 
-// Return number of filtered blocks
-void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
-                    const YV12_BUFFER_CONFIG *org, AV1_COMMON *cm,
-                    int enable_fb_flag, unsigned int strength,
-                    unsigned int fb_size_log2, int plane,
-                    int (*decision)(int, int, const YV12_BUFFER_CONFIG *,
-                                    const YV12_BUFFER_CONFIG *,
-                                    const AV1_COMMON *cm, int, int, int,
-                                    unsigned int, unsigned int, int8_t *)) {
+void av1_clpf_cache_init(ClpfCache *c, const YV12_BUFFER_CONFIG *frame,
+                         AV1_COMMON *cm, unsigned int fb_size_log2,
+                         int plane) {
+  const int subx = plane != AOM_PLANE_Y && frame->subsampling_x;
+  const int suby = plane != AOM_PLANE_Y && frame->subsampling_y;
+  const int bs = (subx || suby) ? 4 : 8;
+  const int width =
+      plane != AOM_PLANE_Y ? frame->uv_crop_width : frame->y_crop_width;
+  const int num_fb_hor = (width + (1 << fb_size_log2) - 1) >> fb_size_log2;
+  const int cache_size = num_fb_hor << (2 * fb_size_log2);
+#if CONFIG_AOM_HIGHBITDEPTH
+  const int cache_bytes = cache_size << !!cm->use_highbitdepth;
+#else
+  const int cache_bytes = cache_size;
+#endif
+
+  c->cache_blocks = cache_size / (bs * bs);
+  c->cache_idx = 0;
+  if (cache_bytes > c->alloc_bytes) {
+    aom_free(c->cache);
+    c->alloc_bytes = 0;
+    CHECK_MEM_ERROR(cm, c->cache, aom_malloc(cache_bytes));
+    c->alloc_bytes = cache_bytes;
+  }
+  if (c->cache_blocks > c->alloc_blocks) {
+    aom_free(c->cache_ptr);
+    aom_free(c->cache_dst);
+    c->cache_dst = NULL;
+    c->alloc_blocks = 0;
+    CHECK_MEM_ERROR(cm, c->cache_ptr,
+                    aom_malloc(c->cache_blocks * sizeof(*c->cache_ptr)));
+    CHECK_MEM_ERROR(cm, c->cache_dst,
+                    aom_malloc(c->cache_blocks * sizeof(*c->cache_dst)));
+    c->alloc_blocks = c->cache_blocks;
+  }
+  memset(c->cache_ptr, 0, c->cache_blocks * sizeof(*c->cache_ptr));
+}
+
+void av1_clpf_cache_free(ClpfCache *c) {
+  aom_free(c->cache);
+  aom_free(c->cache_ptr);
+  aom_free(c->cache_dst);
+  memset(c, 0, sizeof(*c));
+}
+
+void av1_clpf_rows(const YV12_BUFFER_CONFIG *frame,
+                   const YV12_BUFFER_CONFIG *src,
+                   const YV12_BUFFER_CONFIG *org, AV1_COMMON *cm,
+                   int enable_fb_flag, unsigned int strength,
+                   unsigned int fb_size_log2, int plane,
+                   int (*decision)(int, int, const YV12_BUFFER_CONFIG *,
+                                   const YV12_BUFFER_CONFIG *,
+                                   const AV1_COMMON *cm, int, int, int,
+                                   unsigned int, unsigned int, int8_t *),
+                   ClpfCache *clpf_cache, int fb_row_start, int fb_row_end) {
   /* Constrained low-pass filter (CLPF) */
   int c, k, l, m, n;
   const int subx = plane != AOM_PLANE_Y && frame->subsampling_x;
@@ -109,17 +155,22 @@ void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
   int height =
       plane != AOM_PLANE_Y ? frame->uv_crop_height : frame->y_crop_height;
   int xpos, ypos;
-  const int sstride = plane != AOM_PLANE_Y ? frame->uv_stride : frame->y_stride;
-  int dstride = bs;
+  // Unfiltered pixels are read from the copy when there is one.
+  const YV12_BUFFER_CONFIG *const rec = src ? src : frame;
+  const int sstride = plane != AOM_PLANE_Y ? rec->uv_stride : rec->y_stride;
+  const int fstride = plane != AOM_PLANE_Y ? frame->uv_stride : frame->y_stride;
+  const int dstride = src ? fstride : bs;
   const int num_fb_hor = (width + (1 << fb_size_log2) - 1) >> fb_size_log2;
-  const int num_fb_ver = (height + (1 << fb_size_log2) - 1) >> fb_size_log2;
-  uint8_t *cache = NULL;
-  uint8_t **cache_ptr = NULL;
-  uint8_t **cache_dst = NULL;
-  int cache_idx = 0;
-  const int cache_size = num_fb_hor << (2 * fb_size_log2);
-  const int cache_blocks = cache_size / (bs * bs);
+  uint8_t *const cache = src ? NULL : clpf_cache->cache;
+  uint8_t **const cache_ptr = src ? NULL : clpf_cache->cache_ptr;
+  uint8_t **const cache_dst = src ? NULL : clpf_cache->cache_dst;
+  int cache_idx = src ? 0 : clpf_cache->cache_idx;
+  const int cache_blocks = src ? 0 : clpf_cache->cache_blocks;
   uint8_t *src_buffer =
+      plane != AOM_PLANE_Y
+          ? (plane == AOM_PLANE_U ? rec->u_buffer : rec->v_buffer)
+          : rec->y_buffer;
+  uint8_t *const frame_buffer =
       plane != AOM_PLANE_Y
           ? (plane == AOM_PLANE_U ? frame->u_buffer : frame->v_buffer)
           : frame->y_buffer;
@@ -128,18 +179,13 @@ void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
 // Make buffer space for in-place filtering
 #if CONFIG_AOM_HIGHBITDEPTH
   strength <<= (cm->bit_depth - 8);
-  CHECK_MEM_ERROR(cm, cache, aom_malloc(cache_size << !!cm->use_highbitdepth));
   dst_buffer = cm->use_highbitdepth ? CONVERT_TO_BYTEPTR(cache) : cache;
 #else
-  CHECK_MEM_ERROR(cm, cache, aom_malloc(cache_size));
   dst_buffer = cache;
 #endif
-  CHECK_MEM_ERROR(cm, cache_ptr, aom_malloc(cache_blocks * sizeof(*cache_ptr)));
-  CHECK_MEM_ERROR(cm, cache_dst, aom_malloc(cache_blocks * sizeof(*cache_dst)));
-  memset(cache_ptr, 0, cache_blocks * sizeof(*cache_dst));
 
-  // Iterate over all filter blocks
-  for (k = 0; k < num_fb_ver; k++) {
+  // Iterate over the filter blocks of the rows
+  for (k = fb_row_start; k < fb_row_end; k++) {
     for (l = 0; l < num_fb_hor; l++) {
       int h, w;
       int allskip = !(enable_fb_flag && fb_size_log2 == MAX_FB_SIZE_LOG2);
@@ -166,7 +212,7 @@ void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
       if (!allskip &&  // Do not filter the block if all is skip encoded
           (!enable_fb_flag ||
            // Only called if fb_flag enabled (luma only)
-           decision(k, l, frame, org, cm, bs, w / bs, h / bs, strength,
+           decision(k, l, rec, org, cm, bs, w / bs, h / bs, strength,
                     fb_size_log2,
                     cm->clpf_blocks + yoff / MIN_FB_SIZE * cm->clpf_stride +
                         xoff / MIN_FB_SIZE))) {
@@ -188,71 +234,76 @@ void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
                       .mbmi.boundary_info;
 
               // Temporary buffering needed for in-place filtering
-              if (cache_ptr[cache_idx]) {
+              if (!src && cache_ptr[cache_idx]) {
 // Copy filtered block back into the frame
 #if CONFIG_AOM_HIGHBITDEPTH
                 if (cm->use_highbitdepth) {
                   uint16_t *const d = CONVERT_TO_SHORTPTR(cache_dst[cache_idx]);
                   if (sizex == 8) {
                     for (c = 0; c < sizey; c++) {
-                      *(uint64_t *)(d + c * sstride) =
+                      *(uint64_t *)(d + c * fstride) =
                           *(uint64_t *)(cache_ptr[cache_idx] + c * bs * 2);
-                      *(uint64_t *)(d + c * sstride + 4) =
+                      *(uint64_t *)(d + c * fstride + 4) =
                           *(uint64_t *)(cache_ptr[cache_idx] + c * bs * 2 + 8);
                     }
                   } else if (sizex == 4) {
                     for (c = 0; c < sizey; c++)
-                      *(uint64_t *)(d + c * sstride) =
+                      *(uint64_t *)(d + c * fstride) =
                           *(uint64_t *)(cache_ptr[cache_idx] + c * bs * 2);
                   } else {
                     for (c = 0; c < sizey; c++)
-                      memcpy(d + c * sstride, cache_ptr[cache_idx] + c * bs * 2,
+                      memcpy(d + c * fstride, cache_ptr[cache_idx] + c * bs * 2,
                              sizex);
                   }
                 } else {
                   if (sizex == 8)
                     for (c = 0; c < sizey; c++)
-                      *(uint64_t *)(cache_dst[cache_idx] + c * sstride) =
+                      *(uint64_t *)(cache_dst[cache_idx] + c * fstride) =
                           *(uint64_t *)(cache_ptr[cache_idx] + c * bs);
                   else if (sizex == 4)
                     for (c = 0; c < sizey; c++)
-                      *(uint32_t *)(cache_dst[cache_idx] + c * sstride) =
+                      *(uint32_t *)(cache_dst[cache_idx] + c * fstride) =
                           *(uint32_t *)(cache_ptr[cache_idx] + c * bs);
                   else
                     for (c = 0; c < sizey; c++)
-                      memcpy(cache_dst[cache_idx] + c * sstride,
+                      memcpy(cache_dst[cache_idx] + c * fstride,
                              cache_ptr[cache_idx] + c * bs, sizex);
                 }
 #else
                 if (sizex == 8)
                   for (c = 0; c < sizey; c++)
-                    *(uint64_t *)(cache_dst[cache_idx] + c * sstride) =
+                    *(uint64_t *)(cache_dst[cache_idx] + c * fstride) =
                         *(uint64_t *)(cache_ptr[cache_idx] + c * bs);
                 else if (sizex == 4)
                   for (c = 0; c < sizey; c++)
-                    *(uint32_t *)(cache_dst[cache_idx] + c * sstride) =
+                    *(uint32_t *)(cache_dst[cache_idx] + c * fstride) =
                         *(uint32_t *)(cache_ptr[cache_idx] + c * bs);
                 else
                   for (c = 0; c < sizey; c++)
-                    memcpy(cache_dst[cache_idx] + c * sstride,
+                    memcpy(cache_dst[cache_idx] + c * fstride,
                            cache_ptr[cache_idx] + c * bs, sizex);
 #endif
               }
-#if CONFIG_AOM_HIGHBITDEPTH
-              if (cm->use_highbitdepth) {
-                cache_ptr[cache_idx] = cache + cache_idx * bs * bs * 2;
-                dst_buffer =
-                    CONVERT_TO_BYTEPTR(cache_ptr[cache_idx]) - ypos * bs - xpos;
+              if (src) {
+                // Filter straight into the frame
+                dst_buffer = frame_buffer;
               } else {
+#if CONFIG_AOM_HIGHBITDEPTH
+                if (cm->use_highbitdepth) {
+                  cache_ptr[cache_idx] = cache + cache_idx * bs * bs * 2;
+                  dst_buffer = CONVERT_TO_BYTEPTR(cache_ptr[cache_idx]) -
+                               ypos * bs - xpos;
+                } else {
+                  cache_ptr[cache_idx] = cache + cache_idx * bs * bs;
+                  dst_buffer = cache_ptr[cache_idx] - ypos * bs - xpos;
+                }
+#else
                 cache_ptr[cache_idx] = cache + cache_idx * bs * bs;
                 dst_buffer = cache_ptr[cache_idx] - ypos * bs - xpos;
-              }
-#else
-              cache_ptr[cache_idx] = cache + cache_idx * bs * bs;
-              dst_buffer = cache_ptr[cache_idx] - ypos * bs - xpos;
 #endif
-              cache_dst[cache_idx] = src_buffer + ypos * sstride + xpos;
-              if (++cache_idx >= cache_blocks) cache_idx = 0;
+                cache_dst[cache_idx] = frame_buffer + ypos * fstride + xpos;
+                if (++cache_idx >= cache_blocks) cache_idx = 0;
+              }
 
 // Apply the filter
 #if CONFIG_AOM_HIGHBITDEPTH
@@ -278,6 +329,23 @@ void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
     }
   }
 
+  if (!src) clpf_cache->cache_idx = cache_idx;
+}
+
+void av1_clpf_cache_flush(ClpfCache *clpf_cache,
+                          const YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                          int plane) {
+  int c;
+  int cache_idx;
+  const int subx = plane != AOM_PLANE_Y && frame->subsampling_x;
+  const int suby = plane != AOM_PLANE_Y && frame->subsampling_y;
+  const int bs = (subx || suby) ? 4 : 8;
+  const int sstride = plane != AOM_PLANE_Y ? frame->uv_stride : frame->y_stride;
+  uint8_t **const cache_ptr = clpf_cache->cache_ptr;
+  uint8_t **const cache_dst = clpf_cache->cache_dst;
+  const int cache_blocks = clpf_cache->cache_blocks;
+  (void)cm;
+
   // Copy remaining blocks into the frame
   for (cache_idx = 0; cache_idx < cache_blocks && cache_ptr[cache_idx];
        cache_idx++) {
@@ -310,8 +378,26 @@ void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
             *(uint64_t *)(cache_ptr[cache_idx] + c * bs);
 #endif
   }
+}
+
+// Return number of filtered blocks
+void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
+                    const YV12_BUFFER_CONFIG *org, AV1_COMMON *cm,
+                    int enable_fb_flag, unsigned int strength,
+                    unsigned int fb_size_log2, int plane,
+                    int (*decision)(int, int, const YV12_BUFFER_CONFIG *,
+                                    const YV12_BUFFER_CONFIG *,
+                                    const AV1_COMMON *cm, int, int, int,
+                                    unsigned int, unsigned int, int8_t *)) {
+  const int height = plane != AOM_PLANE_Y ? frame->uv_crop_height
+                                          : frame->y_crop_height;
+  const int num_fb_ver = (height + (1 << fb_size_log2) - 1) >> fb_size_log2;
+  ClpfCache clpf_cache;
 
-  aom_free(cache);
-  aom_free(cache_ptr);
-  aom_free(cache_dst);
+  memset(&clpf_cache, 0, sizeof(clpf_cache));
+  av1_clpf_cache_init(&clpf_cache, frame, cm, fb_size_log2, plane);
+  av1_clpf_rows(frame, NULL, org, cm, enable_fb_flag, strength, fb_size_log2,
+                plane, decision, &clpf_cache, 0, num_fb_ver);
+  av1_clpf_cache_flush(&clpf_cache, frame, cm, plane);
+  av1_clpf_cache_free(&clpf_cache);
 }
@@ -18,6 +18,27 @@
 #define MAX_FB_SIZE (1 << MAX_FB_SIZE_LOG2)
 #define MIN_FB_SIZE (1 << MIN_FB_SIZE_LOG2)
 
+// State carried between calls to av1_clpf_rows() while filtering a plane in
+// bands of filter block rows.  Filtered blocks are held back in the cache
+// until they no longer serve as filter input.
+typedef struct {
+  uint8_t *cache;
+  uint8_t **cache_ptr;
+  uint8_t **cache_dst;
+  int cache_idx;
+  int cache_blocks;
+  int alloc_bytes;
+  int alloc_blocks;
+} ClpfCache;
+
+// Decides whether filter block (k, l) of the luma plane is filtered, given
+// the unfiltered frame, and records the decision in the last argument.
+typedef int (*ClpfDecisionFunc)(int k, int l, const YV12_BUFFER_CONFIG *rec,
+                                const YV12_BUFFER_CONFIG *org,
+                                const AV1_COMMON *cm, int block_size, int w,
+                                int h, unsigned int strength,
+                                unsigned int fb_size_log2, int8_t *res);
+
 int av1_clpf_sample(int X, int A, int B, int C, int D, int E, int F, int G,
                     int H, int b, unsigned int bd);
 void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
@@ -29,4 +50,34 @@ void av1_clpf_frame(const YV12_BUFFER_CONFIG *frame,
                                     const AV1_COMMON *cm, int, int, int,
                                     unsigned int, unsigned int, int8_t *));
 
+// Prepares the cache for filtering 'plane' of 'frame', reusing the existing
+// allocation when it is large enough.
+void av1_clpf_cache_init(ClpfCache *clpf_cache, const YV12_BUFFER_CONFIG *frame,
+                         AV1_COMMON *cm, unsigned int fb_size_log2, int plane);
+void av1_clpf_cache_free(ClpfCache *clpf_cache);
+
+// Filters the filter block rows [fb_row_start, fb_row_end) of 'plane'.  Bands
+// must be filtered in order.  Blocks of the last filter block row may still be
+// held in the cache and are written back by the next call or by
+// av1_clpf_cache_flush().
+// If 'src' is not NULL, it holds a copy of the unfiltered frame, the rows read
+// by the band included, and the band is filtered from it straight into
+// 'frame', without 'clpf_cache'.  Such bands can be filtered in any order and
+// concurrently.
+void av1_clpf_rows(const YV12_BUFFER_CONFIG *frame,
+                   const YV12_BUFFER_CONFIG *src,
+                   const YV12_BUFFER_CONFIG *org, AV1_COMMON *cm,
+                   int enable_fb_flag, unsigned int strength,
+                   unsigned int fb_size_log2, int plane,
+                   int (*decision)(int, int, const YV12_BUFFER_CONFIG *,
+                                   const YV12_BUFFER_CONFIG *,
+                                   const AV1_COMMON *cm, int, int, int,
+                                   unsigned int, unsigned int, int8_t *),
+                   ClpfCache *clpf_cache, int fb_row_start, int fb_row_end);
+
+// Writes the blocks still held in the cache back into the frame.
+void av1_clpf_cache_flush(ClpfCache *clpf_cache,
+                          const YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                          int plane);
+
 #endif
@@ -112,6 +112,88 @@ static void clpf_block8_noclip(const uint8_t *src, uint8_t *dst, int sstride,
   }
 }
 
+#ifdef CLPF_USE_V256
+// Process blocks of width 8, four lines at a time, 8 bit.  Clipping along
+// the upper and lower edges is handled by reading the upper or lower line
+// twice, like in clpf_block_hbd().
+static void clpf_block8_v256(const uint8_t *src, uint8_t *dst, int sstride,
+                             int dstride, int x0, int y0, int sizey,
+                             BOUNDARY_TYPE bt, unsigned int strength) {
+  const int right = !(bt & TILE_RIGHT_BOUNDARY);
+  const int left = !(bt & TILE_LEFT_BOUNDARY);
+  const int ymin = -!(bt & TILE_ABOVE_BOUNDARY) * 2;
+  const int ymax = sizey + !(bt & TILE_BOTTOM_BOUNDARY) * 2 - 1;
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  c_shuff[]) = { 0x0504030201000000LL, 0x0d0c0b0a09080808LL,
+                                 0x0504030201000000LL, 0x0d0c0b0a09080808LL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  d_shuff[]) = { 0x0605040302010000LL, 0x0e0d0c0b0a090808LL,
+                                 0x0605040302010000LL, 0x0e0d0c0b0a090808LL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  e_shuff[]) = { 0x0707060504030201LL, 0x0f0f0e0d0c0b0a09LL,
+                                 0x0707060504030201LL, 0x0f0f0e0d0c0b0a09LL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  f_shuff[]) = { 0x0707070605040302LL, 0x0f0f0f0e0d0c0b0aLL,
+                                 0x0707070605040302LL, 0x0f0f0f0e0d0c0b0aLL };
+  int y;
+
+  dst += x0 + y0 * dstride;
+  src += x0 + y0 * sstride;
+
+  for (y = 0; y < sizey; y += 4) {
+    const uint8_t *const s = src + y * sstride;
+    const v64 l0 = v64_load_aligned(src + AOMMAX(ymin, y - 2) * sstride);
+    const v64 l1 = v64_load_aligned(src + AOMMAX(ymin, y - 1) * sstride);
+    const v64 l2 = v64_load_aligned(s);
+    const v64 l3 = v64_load_aligned(s + sstride);
+    const v64 l4 = v64_load_aligned(s + 2 * sstride);
+    const v64 l5 = v64_load_aligned(s + 3 * sstride);
+    const v64 l6 = v64_load_aligned(src + AOMMIN(ymax, y + 4) * sstride);
+    const v64 l7 = v64_load_aligned(src + AOMMIN(ymax, y + 5) * sstride);
+    v256 o = v256_from_v64(l2, l3, l4, l5);
+    const v256 a = v256_from_v64(l0, l1, l2, l3);
+    const v256 b = v256_from_v64(l1, l2, l3, l4);
+    const v256 g = v256_from_v64(l3, l4, l5, l6);
+    const v256 h = v256_from_v64(l4, l5, l6, l7);
+    v256 c, d, e, f;
+
+    if (left) {
+      c = v256_from_v64(v64_load_unaligned(s - 2),
+                        v64_load_unaligned(s - 2 + sstride),
+                        v64_load_unaligned(s - 2 + 2 * sstride),
+                        v64_load_unaligned(s - 2 + 3 * sstride));
+      d = v256_from_v64(v64_load_unaligned(s - 1),
+                        v64_load_unaligned(s - 1 + sstride),
+                        v64_load_unaligned(s - 1 + 2 * sstride),
+                        v64_load_unaligned(s - 1 + 3 * sstride));
+    } else {  // Left clipping
+      c = v256_pshuffle_8(o, v256_load_aligned(c_shuff));
+      d = v256_pshuffle_8(o, v256_load_aligned(d_shuff));
+    }
+    if (right) {
+      e = v256_from_v64(v64_load_unaligned(s + 1),
+                        v64_load_unaligned(s + 1 + sstride),
+                        v64_load_unaligned(s + 1 + 2 * sstride),
+                        v64_load_unaligned(s + 1 + 3 * sstride));
+      f = v256_from_v64(v64_load_unaligned(s + 2),
+                        v64_load_unaligned(s + 2 + sstride),
+                        v64_load_unaligned(s + 2 + 2 * sstride),
+                        v64_load_unaligned(s + 2 + 3 * sstride));
+    } else {  // Right clipping
+      e = v256_pshuffle_8(o, v256_load_aligned(e_shuff));
+      f = v256_pshuffle_8(o, v256_load_aligned(f_shuff));
+    }
+
+    o = calc_delta256(o, a, b, c, d, e, f, g, h, strength);
+    v64_store_aligned(dst, v128_high_v64(v256_high_v128(o)));
+    v64_store_aligned(dst + dstride, v128_low_v64(v256_high_v128(o)));
+    v64_store_aligned(dst + 2 * dstride, v128_high_v64(v256_low_v128(o)));
+    v64_store_aligned(dst + 3 * dstride, v128_low_v64(v256_low_v128(o)));
+    dst += 4 * dstride;
+  }
+}
+#endif  // CLPF_USE_V256
+
 // Process blocks of width 4, four lines at a time, 8 bit.
 static void clpf_block4(const uint8_t *src, uint8_t *dst, int sstride,
                         int dstride, int x0, int y0, int sizey,
@@ -251,6 +333,10 @@ void SIMD_FUNC(aom_clpf_block)(const uint8_t *src, uint8_t *dst, int sstride,
     // * block heights not a multiple of 4 if the block width is 4
     aom_clpf_block_c(src, dst, sstride, dstride, x0, y0, sizex, sizey, strength,
                      bt, bd);
+#ifdef CLPF_USE_V256
+  } else if (sizex == 8 && !(sizey & 3)) {
+    clpf_block8_v256(src, dst, sstride, dstride, x0, y0, sizey, bt, strength);
+#endif
   } else {
     if (bt)
       (sizex == 4 ? clpf_block4 : clpf_block8)(src, dst, sstride, dstride, x0,
@@ -495,6 +581,114 @@ SIMD_INLINE void clpf_block_hbd_noclip(const uint16_t *src, uint16_t *dst,
   }
 }
 
+#ifdef CLPF_USE_V256
+// Same as constrain_hbd(), on 16 pixels at a time.
+SIMD_INLINE v256 constrain_hbd256(v256 a, v256 b, unsigned int strength,
+                                  unsigned int bd) {
+  const v256 diff = v256_sub_16(v256_max_s16(a, b), v256_min_s16(a, b));
+  const v256 sign = v256_cmpeq_16(v256_min_s16(a, b), a);  // -(a <= b)
+  const v256 zero = v256_zero();
+  const v256 s = v256_max_s16(
+      zero, v256_sub_16(v256_dup_16(strength),
+                        v256_shr_u16(diff, bd - 3 - get_msb(strength))));
+  return v256_sub_16(
+      v256_xor(sign,
+               v256_max_s16(
+                   zero, v256_sub_16(
+                             diff, v256_max_s16(zero, v256_sub_16(diff, s))))),
+      sign);
+}
+
+// Same as calc_delta_hbd(), on 16 pixels at a time.
+SIMD_INLINE v256 calc_delta_hbd256(v256 x, v256 a, v256 b, v256 c, v256 d,
+                                   v256 e, v256 f, v256 g, v256 h,
+                                   unsigned int s, unsigned int bd) {
+  const v256 bdeg = v256_add_16(
+      v256_add_16(constrain_hbd256(b, x, s, bd), constrain_hbd256(d, x, s, bd)),
+      v256_add_16(constrain_hbd256(e, x, s, bd),
+                  constrain_hbd256(g, x, s, bd)));
+  const v256 delta = v256_add_16(
+      v256_add_16(v256_add_16(constrain_hbd256(a, x, s, bd),
+                              constrain_hbd256(c, x, s, bd)),
+                  v256_add_16(constrain_hbd256(f, x, s, bd),
+                              constrain_hbd256(h, x, s, bd))),
+      v256_add_16(v256_add_16(bdeg, bdeg), bdeg));
+  return v256_add_16(
+      x,
+      v256_shr_s16(
+          v256_add_16(v256_dup_16(8),
+                      v256_add_16(delta, v256_cmplt_s16(delta, v256_zero()))),
+          4));
+}
+
+// Process blocks of width 8, two lines at a time.
+SIMD_INLINE void clpf_block_hbd_v256(const uint16_t *src, uint16_t *dst,
+                                     int sstride, int dstride, int x0, int y0,
+                                     int sizey, unsigned int strength,
+                                     BOUNDARY_TYPE bt, unsigned int bd) {
+  const int right = !(bt & TILE_RIGHT_BOUNDARY);
+  const int left = !(bt & TILE_LEFT_BOUNDARY);
+  const int ymin = -!(bt & TILE_ABOVE_BOUNDARY) * 2;
+  const int ymax = sizey + !(bt & TILE_BOTTOM_BOUNDARY) * 2 - 1;
+
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  c_shuff[]) = { 0x0302010001000100LL, 0x0b0a090807060504LL,
+                                 0x0302010001000100LL, 0x0b0a090807060504LL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  d_shuff[]) = { 0x0504030201000100LL, 0x0d0c0b0a09080706LL,
+                                 0x0504030201000100LL, 0x0d0c0b0a09080706LL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  e_shuff[]) = { 0x0908070605040302LL, 0x0f0e0f0e0d0c0b0aLL,
+                                 0x0908070605040302LL, 0x0f0e0f0e0d0c0b0aLL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  f_shuff[]) = { 0x0b0a090807060504LL, 0x0f0e0f0e0f0e0d0cLL,
+                                 0x0b0a090807060504LL, 0x0f0e0f0e0f0e0d0cLL };
+  int y;
+
+  dst += x0 + y0 * dstride;
+  src += x0 + y0 * sstride;
+
+  for (y = 0; y < sizey; y += 2) {
+    const uint16_t *const s = src + y * sstride;
+    const v128 l0 = v128_load_aligned(src + AOMMAX(ymin, y - 2) * sstride);
+    const v128 l1 = v128_load_aligned(src + AOMMAX(ymin, y - 1) * sstride);
+    const v128 l2 = v128_load_aligned(s);
+    const v128 l3 = v128_load_aligned(s + sstride);
+    const v128 l4 = v128_load_aligned(src + AOMMIN(ymax, y + 2) * sstride);
+    const v128 l5 = v128_load_aligned(src + AOMMIN(ymax, y + 3) * sstride);
+    const v256 o = v256_from_v128(l2, l3);
+    const v256 a = v256_from_v128(l0, l1);
+    const v256 b = v256_from_v128(l1, l2);
+    const v256 g = v256_from_v128(l3, l4);
+    const v256 h = v256_from_v128(l4, l5);
+    v256 c, d, e, f, r;
+
+    if (left) {
+      c = v256_from_v128(v128_load_unaligned(s - 2),
+                         v128_load_unaligned(s - 2 + sstride));
+      d = v256_from_v128(v128_load_unaligned(s - 1),
+                         v128_load_unaligned(s - 1 + sstride));
+    } else {  // Left clipping
+      c = v256_pshuffle_8(o, v256_load_aligned(c_shuff));
+      d = v256_pshuffle_8(o, v256_load_aligned(d_shuff));
+    }
+    if (right) {
+      e = v256_from_v128(v128_load_unaligned(s + 1),
+                         v128_load_unaligned(s + 1 + sstride));
+      f = v256_from_v128(v128_load_unaligned(s + 2),
+                         v128_load_unaligned(s + 2 + sstride));
+    } else {  // Right clipping
+      e = v256_pshuffle_8(o, v256_load_aligned(e_shuff));
+      f = v256_pshuffle_8(o, v256_load_aligned(f_shuff));
+    }
+    r = calc_delta_hbd256(o, a, b, c, d, e, f, g, h, strength, bd);
+    v128_store_aligned(dst, v256_high_v128(r));
+    v128_store_aligned(dst + dstride, v256_low_v128(r));
+    dst += 2 * dstride;
+  }
+}
+#endif  // CLPF_USE_V256
+
 void SIMD_FUNC(aom_clpf_block_hbd)(const uint16_t *src, uint16_t *dst,
                                    int sstride, int dstride, int x0, int y0,
                                    int sizex, int sizey, unsigned int strength,
@@ -505,6 +699,11 @@ void SIMD_FUNC(aom_clpf_block_hbd)(const uint16_t *src, uint16_t *dst,
     // * block heights not a multiple of 2 if the block width is 4
     aom_clpf_block_hbd_c(src, dst, sstride, dstride, x0, y0, sizex, sizey,
                          strength, bt, bd);
+#ifdef CLPF_USE_V256
+  } else if (sizex == 8 && !(sizey & 1)) {
+    clpf_block_hbd_v256(src, dst, sstride, dstride, x0, y0, sizey, strength,
+                        bt, bd);
+#endif
   } else {
     if (bt)
       (sizex == 4 ? clpf_block_hbd4 : clpf_block_hbd)(
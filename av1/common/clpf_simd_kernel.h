@@ -45,4 +45,34 @@ SIMD_INLINE v128 calc_delta(v128 x, v128 a, v128 b, v128 c, v128 d, v128 e,
              4));
 }
 
+
+#ifdef CLPF_USE_V256
+// Same as constrain(), on 32 pixels at a time.
+SIMD_INLINE v256 constrain256(v256 a, v256 b, unsigned int strength) {
+  const v256 diff = v256_sub_8(v256_max_u8(a, b), v256_min_u8(a, b));
+  const v256 sign = v256_cmpeq_8(v256_min_u8(a, b), a);  // -(a <= b)
+  const v256 s = v256_ssub_u8(v256_dup_8(strength),
+                              v256_shr_u8(diff, 5 - get_msb(strength)));
+  return v256_sub_8(v256_xor(sign, v256_ssub_u8(diff, v256_ssub_u8(diff, s))),
+                    sign);
+}
+
+// Same as calc_delta(), on 32 pixels at a time.
+SIMD_INLINE v256 calc_delta256(v256 x, v256 a, v256 b, v256 c, v256 d, v256 e,
+                               v256 f, v256 g, v256 h, unsigned int s) {
+  const v256 bdeg =
+      v256_add_8(v256_add_8(constrain256(b, x, s), constrain256(d, x, s)),
+                 v256_add_8(constrain256(e, x, s), constrain256(g, x, s)));
+  const v256 delta = v256_add_8(
+      v256_add_8(v256_add_8(constrain256(a, x, s), constrain256(c, x, s)),
+                 v256_add_8(constrain256(f, x, s), constrain256(h, x, s))),
+      v256_add_8(v256_add_8(bdeg, bdeg), bdeg));
+  return v256_add_8(
+      x, v256_shr_s8(
+             v256_add_8(v256_dup_8(8),
+                        v256_add_8(delta, v256_cmplt_s8(delta, v256_zero()))),
+             4));
+}
+#endif  // CLPF_USE_V256
+
 #endif
@@ -9,11 +9,13 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <assert.h>
 #include <string.h>
 #include <math.h>
 
 #include "./aom_scale_rtcd.h"
 #include "aom/aom_integer.h"
+#include "aom_mem/aom_mem.h"
 #include "av1/common/dering.h"
 #include "av1/common/onyxc_int.h"
 #include "av1/common/reconinter.h"
@@ -146,243 +148,250 @@ static void copy_sb8_16(AV1_COMMON *cm, int16_t *dst, int dstride,
   }
 }
 
-void av1_dering_frame(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
-                      MACROBLOCKD *xd, int global_level) {
+static int dering_num_planes(const struct macroblockd_plane *planes) {
+  if (planes[1].subsampling_x == planes[1].subsampling_y &&
+      planes[2].subsampling_x == planes[2].subsampling_y)
+    return 3;
+  return 1;
+}
+
+int av1_dering_row_state_alloc(DeringRowState *state, const AV1_COMMON *cm) {
+  int pli;
+  memset(state, 0, sizeof(*state));
+  state->nhsb = (cm->mi_cols + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE;
+  state->nvsb = (cm->mi_rows + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE;
+  state->stride = (cm->mi_cols << OD_DERING_SIZE_LOG2) + 2 * OD_FILT_HBORDER;
+  for (pli = 0; pli < 3; pli++) {
+    state->linebuf[pli] =
+        aom_malloc(sizeof(*state->linebuf[pli]) * state->nvsb * 2 *
+                   OD_FILT_VBORDER * state->stride);
+    if (!state->linebuf[pli]) return 0;
+  }
+  return 1;
+}
+
+void av1_dering_row_state_free(DeringRowState *state) {
+  int pli;
+  for (pli = 0; pli < 3; pli++) aom_free(state->linebuf[pli]);
+  memset(state, 0, sizeof(*state));
+}
+
+void av1_dering_save_lines(AV1_COMMON *cm,
+                           const struct macroblockd_plane planes[MAX_MB_PLANE],
+                           DeringRowState *state, int sbr) {
+  const int nplanes = dering_num_planes(planes);
+  int pli;
+  assert(sbr > 0 && sbr < state->nvsb);
+  for (pli = 0; pli < nplanes; pli++) {
+    const int bsize = OD_DERING_SIZE_LOG2 - planes[pli].subsampling_x;
+    copy_sb8_16(cm, state->linebuf[pli] + sbr * 2 * OD_FILT_VBORDER *
+                                              state->stride,
+                state->stride, planes[pli].dst.buf,
+                (MAX_MIB_SIZE << bsize) * sbr - OD_FILT_VBORDER, 0,
+                planes[pli].dst.stride, 2 * OD_FILT_VBORDER,
+                cm->mi_cols << bsize);
+  }
+}
+
+void av1_dering_sb_row(AV1_COMMON *cm,
+                       const struct macroblockd_plane planes[MAX_MB_PLANE],
+                       int global_level, const DeringRowState *state,
+                       int sbr) {
   int r, c;
-  int sbr, sbc;
+  int sbc;
   int nhsb, nvsb;
   int16_t src[OD_DERING_INBUF_SIZE];
-  int16_t *linebuf[3];
   int16_t colbuf[3][OD_BSIZE_MAX + 2 * OD_FILT_VBORDER][OD_FILT_HBORDER];
   dering_list dlist[MAX_MIB_SIZE * MAX_MIB_SIZE];
-  unsigned char *row_dering, *prev_row_dering, *curr_row_dering;
   int dering_count;
   int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS] = { { 0 } };
-  int stride;
+  const int stride = state->stride;
+  // The lines above the superblock row and the lines below it, as they were
+  // before deringing.
+  const int16_t *above[3];
+  const int16_t *below[3];
   int bsize[3];
   int dec[3];
   int pli;
   int dering_left;
   int coeff_shift = AOMMAX(cm->bit_depth - 8, 0);
-  int nplanes;
-  if (xd->plane[1].subsampling_x == xd->plane[1].subsampling_y &&
-      xd->plane[2].subsampling_x == xd->plane[2].subsampling_y)
-    nplanes = 3;
-  else
-    nplanes = 1;
-  nvsb = (cm->mi_rows + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE;
-  nhsb = (cm->mi_cols + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE;
-  av1_setup_dst_planes(xd->plane, frame, 0, 0);
-  row_dering = aom_malloc(sizeof(*row_dering) * nhsb * 2);
-  memset(row_dering, 1, sizeof(*row_dering) * (nhsb + 2) * 2);
-  prev_row_dering = row_dering + 1;
-  curr_row_dering = prev_row_dering + nhsb + 2;
+  const int nplanes = dering_num_planes(planes);
+  nvsb = state->nvsb;
+  nhsb = state->nhsb;
+  assert(nhsb == (cm->mi_cols + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE);
+  assert(nvsb == (cm->mi_rows + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE);
   for (pli = 0; pli < nplanes; pli++) {
-    dec[pli] = xd->plane[pli].subsampling_x;
+    dec[pli] = planes[pli].subsampling_x;
     bsize[pli] = OD_DERING_SIZE_LOG2 - dec[pli];
+    above[pli] = state->linebuf[pli] + sbr * 2 * OD_FILT_VBORDER * stride;
+    below[pli] = sbr + 1 < nvsb
+                     ? state->linebuf[pli] +
+                           ((sbr + 1) * 2 + 1) * OD_FILT_VBORDER * stride
+                     : NULL;
   }
-  stride = (cm->mi_cols << bsize[0]) + 2 * OD_FILT_HBORDER;
   for (pli = 0; pli < nplanes; pli++) {
-    linebuf[pli] = aom_malloc(sizeof(*linebuf) * OD_FILT_VBORDER * stride);
-  }
-  for (sbr = 0; sbr < nvsb; sbr++) {
-    for (pli = 0; pli < nplanes; pli++) {
-      for (r = 0; r < (MAX_MIB_SIZE << bsize[pli]) + 2 * OD_FILT_VBORDER; r++) {
-        for (c = 0; c < OD_FILT_HBORDER; c++) {
-          colbuf[pli][r][c] = OD_DERING_VERY_LARGE;
-        }
+    for (r = 0; r < (MAX_MIB_SIZE << bsize[pli]) + 2 * OD_FILT_VBORDER; r++) {
+      for (c = 0; c < OD_FILT_HBORDER; c++) {
+        colbuf[pli][r][c] = OD_DERING_VERY_LARGE;
       }
     }
-    dering_left = 1;
-    for (sbc = 0; sbc < nhsb; sbc++) {
-      int level;
-      int nhb, nvb;
-      int cstart = 0;
-      if (!dering_left) cstart = -OD_FILT_HBORDER;
-      nhb = AOMMIN(MAX_MIB_SIZE, cm->mi_cols - MAX_MIB_SIZE * sbc);
-      nvb = AOMMIN(MAX_MIB_SIZE, cm->mi_rows - MAX_MIB_SIZE * sbr);
-      level = compute_level_from_index(
-          global_level, cm->mi_grid_visible[MAX_MIB_SIZE * sbr * cm->mi_stride +
-                                            MAX_MIB_SIZE * sbc]
-                            ->mbmi.dering_gain);
-      curr_row_dering[sbc] = 0;
-      if (level == 0 ||
-          (dering_count = sb_compute_dering_list(
-               cm, sbr * MAX_MIB_SIZE, sbc * MAX_MIB_SIZE, dlist)) == 0) {
-        dering_left = 0;
-        continue;
-      }
-      curr_row_dering[sbc] = 1;
-      for (pli = 0; pli < nplanes; pli++) {
-        int16_t dst[OD_BSIZE_MAX * OD_BSIZE_MAX];
-        int threshold;
-        int coffset;
-        int rend, cend;
-        if (sbc == nhsb - 1)
-          cend = (nhb << bsize[pli]);
-        else
-          cend = (nhb << bsize[pli]) + OD_FILT_HBORDER;
-        if (sbr == nvsb - 1)
-          rend = (nvb << bsize[pli]);
-        else
-          rend = (nvb << bsize[pli]) + OD_FILT_VBORDER;
-        coffset = sbc * MAX_MIB_SIZE << bsize[pli];
-        if (sbc == nhsb - 1) {
-          /* On the last superblock column, fill in the right border with
-             OD_DERING_VERY_LARGE to avoid filtering with the outside. */
-          for (r = 0; r < rend + OD_FILT_VBORDER; r++) {
-            for (c = cend; c < (nhb << bsize[pli]) + OD_FILT_HBORDER; ++c) {
-              src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
-                  OD_DERING_VERY_LARGE;
-            }
-          }
-        }
-        if (sbr == nvsb - 1) {
-          /* On the last superblock row, fill in the bottom border with
-             OD_DERING_VERY_LARGE to avoid filtering with the outside. */
-          for (r = rend; r < rend + OD_FILT_VBORDER; r++) {
-            for (c = 0; c < (nhb << bsize[pli]) + 2 * OD_FILT_HBORDER; c++) {
-              src[(r + OD_FILT_VBORDER) * OD_FILT_BSTRIDE + c] =
-                  OD_DERING_VERY_LARGE;
-            }
-          }
-        }
-        /* Copy in the pixels we need from the current superblock for
-           deringing.*/
-        copy_sb8_16(
-            cm,
-            &src[OD_FILT_VBORDER * OD_FILT_BSTRIDE + OD_FILT_HBORDER + cstart],
-            OD_FILT_BSTRIDE, xd->plane[pli].dst.buf,
-            (MAX_MIB_SIZE << bsize[pli]) * sbr, coffset + cstart,
-            xd->plane[pli].dst.stride, rend, cend - cstart);
-        if (!prev_row_dering[sbc]) {
-          copy_sb8_16(cm, &src[OD_FILT_HBORDER], OD_FILT_BSTRIDE,
-                      xd->plane[pli].dst.buf,
-                      (MAX_MIB_SIZE << bsize[pli]) * sbr - OD_FILT_VBORDER,
-                      coffset, xd->plane[pli].dst.stride, OD_FILT_VBORDER,
-                      nhb << bsize[pli]);
-        } else if (sbr > 0) {
-          for (r = 0; r < OD_FILT_VBORDER; r++) {
-            for (c = 0; c < nhb << bsize[pli]; c++) {
-              src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
-                  linebuf[pli][r * stride + coffset + c];
-            }
-          }
-        } else {
-          for (r = 0; r < OD_FILT_VBORDER; r++) {
-            for (c = 0; c < nhb << bsize[pli]; c++) {
-              src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
-                  OD_DERING_VERY_LARGE;
-            }
+  }
+  dering_left = 1;
+  for (sbc = 0; sbc < nhsb; sbc++) {
+    int level;
+    int nhb, nvb;
+    int cstart = 0;
+    if (!dering_left) cstart = -OD_FILT_HBORDER;
+    nhb = AOMMIN(MAX_MIB_SIZE, cm->mi_cols - MAX_MIB_SIZE * sbc);
+    nvb = AOMMIN(MAX_MIB_SIZE, cm->mi_rows - MAX_MIB_SIZE * sbr);
+    level = compute_level_from_index(
+        global_level, cm->mi_grid_visible[MAX_MIB_SIZE * sbr * cm->mi_stride +
+                                          MAX_MIB_SIZE * sbc]
+                          ->mbmi.dering_gain);
+    if (level == 0 ||
+        (dering_count = sb_compute_dering_list(cm, sbr * MAX_MIB_SIZE,
+                                               sbc * MAX_MIB_SIZE, dlist)) ==
+            0) {
+      dering_left = 0;
+      continue;
+    }
+    for (pli = 0; pli < nplanes; pli++) {
+      int16_t dst[OD_BSIZE_MAX * OD_BSIZE_MAX];
+      int threshold;
+      int coffset;
+      int rend, cend;
+      int cabove_start, cabove_end;
+      // Lines below the superblock that are read from the row below.
+      const int rbelow = sbr == nvsb - 1 ? 0 : OD_FILT_VBORDER;
+      if (sbc == nhsb - 1)
+        cend = (nhb << bsize[pli]);
+      else
+        cend = (nhb << bsize[pli]) + OD_FILT_HBORDER;
+      rend = (nvb << bsize[pli]);
+      coffset = sbc * MAX_MIB_SIZE << bsize[pli];
+      if (sbc == nhsb - 1) {
+        /* On the last superblock column, fill in the right border with
+           OD_DERING_VERY_LARGE to avoid filtering with the outside. */
+        for (r = 0; r < rend + rbelow + OD_FILT_VBORDER; r++) {
+          for (c = cend; c < (nhb << bsize[pli]) + OD_FILT_HBORDER; ++c) {
+            src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
+                OD_DERING_VERY_LARGE;
           }
         }
-        if (!prev_row_dering[sbc - 1]) {
-          copy_sb8_16(cm, src, OD_FILT_BSTRIDE, xd->plane[pli].dst.buf,
-                      (MAX_MIB_SIZE << bsize[pli]) * sbr - OD_FILT_VBORDER,
-                      coffset - OD_FILT_HBORDER, xd->plane[pli].dst.stride,
-                      OD_FILT_VBORDER, OD_FILT_HBORDER);
-        } else if (sbr > 0 && sbc > 0) {
-          for (r = 0; r < OD_FILT_VBORDER; r++) {
-            for (c = -OD_FILT_HBORDER; c < 0; c++) {
-              src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
-                  linebuf[pli][r * stride + coffset + c];
-            }
-          }
-        } else {
-          for (r = 0; r < OD_FILT_VBORDER; r++) {
-            for (c = -OD_FILT_HBORDER; c < 0; c++) {
-              src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
-                  OD_DERING_VERY_LARGE;
-            }
+      }
+      /* Copy in the pixels we need from the current superblock for
+         deringing.*/
+      copy_sb8_16(
+          cm,
+          &src[OD_FILT_VBORDER * OD_FILT_BSTRIDE + OD_FILT_HBORDER + cstart],
+          OD_FILT_BSTRIDE, planes[pli].dst.buf,
+          (MAX_MIB_SIZE << bsize[pli]) * sbr, coffset + cstart,
+          planes[pli].dst.stride, rend, cend - cstart);
+      if (sbr == nvsb - 1) {
+        /* On the last superblock row, fill in the bottom border with
+           OD_DERING_VERY_LARGE to avoid filtering with the outside. */
+        for (r = rend; r < rend + OD_FILT_VBORDER; r++) {
+          for (c = 0; c < (nhb << bsize[pli]) + 2 * OD_FILT_HBORDER; c++) {
+            src[(r + OD_FILT_VBORDER) * OD_FILT_BSTRIDE + c] =
+                OD_DERING_VERY_LARGE;
           }
         }
-        if (!prev_row_dering[sbc + 1]) {
-          copy_sb8_16(cm, &src[OD_FILT_HBORDER + (nhb << bsize[pli])],
-                      OD_FILT_BSTRIDE, xd->plane[pli].dst.buf,
-                      (MAX_MIB_SIZE << bsize[pli]) * sbr - OD_FILT_VBORDER,
-                      coffset + (nhb << bsize[pli]), xd->plane[pli].dst.stride,
-                      OD_FILT_VBORDER, OD_FILT_HBORDER);
-        } else if (sbr > 0 && sbc < nhsb - 1) {
-          for (r = 0; r < OD_FILT_VBORDER; r++) {
-            for (c = nhb << bsize[pli];
-                 c < (nhb << bsize[pli]) + OD_FILT_HBORDER; c++) {
-              src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
-                  linebuf[pli][r * stride + coffset + c];
-            }
-          }
-        } else {
-          for (r = 0; r < OD_FILT_VBORDER; r++) {
-            for (c = nhb << bsize[pli];
-                 c < (nhb << bsize[pli]) + OD_FILT_HBORDER; c++) {
-              src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
-                  OD_DERING_VERY_LARGE;
-            }
+      } else {
+        /* Copy in the lines below from the superblock row below. */
+        for (r = 0; r < OD_FILT_VBORDER; r++) {
+          for (c = cstart; c < cend; c++) {
+            src[(rend + OD_FILT_VBORDER + r) * OD_FILT_BSTRIDE + c +
+                OD_FILT_HBORDER] = below[pli][r * stride + coffset + c];
           }
         }
-        if (dering_left) {
-          /* If we deringed the superblock on the left then we need to copy in
-             saved pixels. */
-          for (r = 0; r < rend + OD_FILT_VBORDER; r++) {
-            for (c = 0; c < OD_FILT_HBORDER; c++) {
-              src[r * OD_FILT_BSTRIDE + c] = colbuf[pli][r][c];
-            }
-          }
+      }
+      /* Copy in the lines above from the superblock row above, including the
+         corners when there are superblocks on the left and on the right. */
+      cabove_start = sbr > 0 && sbc > 0 ? -OD_FILT_HBORDER : 0;
+      cabove_end = (nhb << bsize[pli]) +
+                   (sbr > 0 && sbc < nhsb - 1 ? OD_FILT_HBORDER : 0);
+      for (r = 0; r < OD_FILT_VBORDER; r++) {
+        for (c = -OD_FILT_HBORDER; c < (nhb << bsize[pli]) + OD_FILT_HBORDER;
+             c++) {
+          src[r * OD_FILT_BSTRIDE + c + OD_FILT_HBORDER] =
+              sbr > 0 && c >= cabove_start && c < cabove_end
+                  ? above[pli][r * stride + coffset + c]
+                  : OD_DERING_VERY_LARGE;
         }
-        for (r = 0; r < rend + OD_FILT_VBORDER; r++) {
+      }
+      if (dering_left) {
+        /* If we deringed the superblock on the left then we need to copy in
+           saved pixels. */
+        for (r = 0; r < rend + rbelow + OD_FILT_VBORDER; r++) {
           for (c = 0; c < OD_FILT_HBORDER; c++) {
-            /* Saving pixels in case we need to dering the superblock on the
-               right. */
-            colbuf[pli][r][c] =
-                src[r * OD_FILT_BSTRIDE + c + (nhb << bsize[pli])];
+            src[r * OD_FILT_BSTRIDE + c] = colbuf[pli][r][c];
           }
         }
-        copy_sb8_16(cm, &linebuf[pli][coffset], stride, xd->plane[pli].dst.buf,
-                    (MAX_MIB_SIZE << bsize[pli]) * (sbr + 1) - OD_FILT_VBORDER,
-                    coffset, xd->plane[pli].dst.stride, OD_FILT_VBORDER,
-                    (nhb << bsize[pli]));
+      }
+      for (r = 0; r < rend + rbelow + OD_FILT_VBORDER; r++) {
+        for (c = 0; c < OD_FILT_HBORDER; c++) {
+          /* Saving pixels in case we need to dering the superblock on the
+             right. */
+          colbuf[pli][r][c] =
+              src[r * OD_FILT_BSTRIDE + c + (nhb << bsize[pli])];
+        }
+      }
 
-        /* FIXME: This is a temporary hack that uses more conservative
-           deringing for chroma. */
-        if (pli)
-          threshold = (level * 5 + 4) >> 3 << coeff_shift;
-        else
-          threshold = level << coeff_shift;
-        if (threshold == 0) continue;
-        od_dering(
-            dst, &src[OD_FILT_VBORDER * OD_FILT_BSTRIDE + OD_FILT_HBORDER],
-            dec[pli], dir, pli, dlist, dering_count, threshold, coeff_shift);
+      /* FIXME: This is a temporary hack that uses more conservative
+         deringing for chroma. */
+      if (pli)
+        threshold = (level * 5 + 4) >> 3 << coeff_shift;
+      else
+        threshold = level << coeff_shift;
+      if (threshold == 0) continue;
+      od_dering(dst, &src[OD_FILT_VBORDER * OD_FILT_BSTRIDE + OD_FILT_HBORDER],
+                dec[pli], dir, pli, dlist, dering_count, threshold,
+                coeff_shift);
 #if CONFIG_AOM_HIGHBITDEPTH
-        if (cm->use_highbitdepth) {
-          copy_dering_16bit_to_16bit(
-              (int16_t *)&CONVERT_TO_SHORTPTR(
-                  xd->plane[pli]
-                      .dst.buf)[xd->plane[pli].dst.stride *
-                                    (MAX_MIB_SIZE * sbr << bsize[pli]) +
-                                (sbc * MAX_MIB_SIZE << bsize[pli])],
-              xd->plane[pli].dst.stride, dst, dlist, dering_count,
-              3 - dec[pli]);
-        } else {
+      if (cm->use_highbitdepth) {
+        copy_dering_16bit_to_16bit(
+            (int16_t *)&CONVERT_TO_SHORTPTR(
+                planes[pli]
+                    .dst.buf)[planes[pli].dst.stride *
+                                  (MAX_MIB_SIZE * sbr << bsize[pli]) +
+                              (sbc * MAX_MIB_SIZE << bsize[pli])],
+            planes[pli].dst.stride, dst, dlist, dering_count, 3 - dec[pli]);
+      } else {
 #endif
-          copy_dering_16bit_to_8bit(
-              &xd->plane[pli].dst.buf[xd->plane[pli].dst.stride *
-                                          (MAX_MIB_SIZE * sbr << bsize[pli]) +
-                                      (sbc * MAX_MIB_SIZE << bsize[pli])],
-              xd->plane[pli].dst.stride, dst, dlist, dering_count, bsize[pli]);
+        copy_dering_16bit_to_8bit(
+            &planes[pli].dst.buf[planes[pli].dst.stride *
+                                        (MAX_MIB_SIZE * sbr << bsize[pli]) +
+                                    (sbc * MAX_MIB_SIZE << bsize[pli])],
+            planes[pli].dst.stride, dst, dlist, dering_count, bsize[pli]);
 #if CONFIG_AOM_HIGHBITDEPTH
-        }
-#endif
       }
-      dering_left = 1;
-    }
-    {
-      unsigned char *tmp;
-      tmp = prev_row_dering;
-      prev_row_dering = curr_row_dering;
-      curr_row_dering = tmp;
+#endif
     }
+    dering_left = 1;
   }
-  aom_free(row_dering);
-  for (pli = 0; pli < nplanes; pli++) {
-    aom_free(linebuf[pli]);
+}
+
+void av1_dering_rows(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                     struct macroblockd_plane planes[MAX_MB_PLANE],
+                     int global_level, DeringRowState *state, int sbr_start,
+                     int sbr_end) {
+  int sbr;
+  av1_setup_dst_planes(planes, frame, 0, 0);
+  for (sbr = sbr_start; sbr < sbr_end; sbr++) {
+    if (sbr + 1 < state->nvsb) av1_dering_save_lines(cm, planes, state, sbr + 1);
+    av1_dering_sb_row(cm, planes, global_level, state, sbr);
+  }
+}
+
+void av1_dering_frame(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                      MACROBLOCKD *xd, int global_level) {
+  const int nvsb = (cm->mi_rows + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE;
+  DeringRowState state;
+  if (!av1_dering_row_state_alloc(&state, cm)) {
+    av1_dering_row_state_free(&state);
+    aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                       "Failed to allocate dering line buffers");
   }
+  av1_dering_rows(frame, cm, xd->plane, global_level, &state, 0, nvsb);
+  av1_dering_row_state_free(&state);
 }
@@ -28,6 +28,17 @@ extern "C" {
 #define DERING_REFINEMENT_BITS 2
 #define DERING_REFINEMENT_LEVELS 4
 
+// The lines around the top edge of each superblock row, OD_FILT_VBORDER above
+// and below it, as they were before deringing. Superblock rows read the lines
+// of the rows next to them from here, so that they can be deringed in any
+// order once the lines have been saved.
+typedef struct {
+  int16_t *linebuf[3];
+  int stride;
+  int nhsb;
+  int nvsb;
+} DeringRowState;
+
 int compute_level_from_index(int global_level, int gi);
 int sb_all_skip(const AV1_COMMON *const cm, int mi_row, int mi_col);
 int sb_compute_dering_list(const AV1_COMMON *const cm, int mi_row, int mi_col,
@@ -35,6 +46,29 @@ int sb_compute_dering_list(const AV1_COMMON *const cm, int mi_row, int mi_col,
 void av1_dering_frame(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                       MACROBLOCKD *xd, int global_level);
 
+// Allocates the row state for frames of the size of cm. Returns 0 on failure,
+// in which case av1_dering_row_state_free() must still be called.
+int av1_dering_row_state_alloc(DeringRowState *state, const AV1_COMMON *cm);
+void av1_dering_row_state_free(DeringRowState *state);
+// Saves the lines around the top edge of superblock row sbr. Must be called
+// once the lines are final and before either of the rows next to the edge is
+// deringed. 'planes' must be set up for the frame with av1_setup_dst_planes().
+void av1_dering_save_lines(AV1_COMMON *cm,
+                           const struct macroblockd_plane planes[MAX_MB_PLANE],
+                           DeringRowState *state, int sbr);
+// Derings superblock row sbr, once the lines at both of its edges are saved.
+// Different rows can be deringed concurrently.
+void av1_dering_sb_row(AV1_COMMON *cm,
+                       const struct macroblockd_plane planes[MAX_MB_PLANE],
+                       int global_level, const DeringRowState *state, int sbr);
+// Derings the superblock rows [sbr_start, sbr_end) of the frame. Successive
+// calls must cover consecutive rows from the top of the frame, and each call
+// needs the first lines of row sbr_end to be final already.
+void av1_dering_rows(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                     struct macroblockd_plane planes[MAX_MB_PLANE],
+                     int global_level, DeringRowState *state, int sbr_start,
+                     int sbr_end);
+
 int av1_dering_search(YV12_BUFFER_CONFIG *frame, const YV12_BUFFER_CONFIG *ref,
                       AV1_COMMON *cm, MACROBLOCKD *xd);
 
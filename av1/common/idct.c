@@ -1475,7 +1475,7 @@ void av1_inv_txfm_add_32x32(const tran_low_t *input, uint8_t *dest, int stride,
     case H_ADST:
     case V_FLIPADST:
     case H_FLIPADST:
-      av1_iht32x32_1024_add_c(input, dest, stride, tx_type);
+      av1_iht32x32_1024_add(input, dest, stride, tx_type);
       break;
     case IDTX: inv_idtx_add_c(input, dest, stride, 32, tx_type); break;
 #endif  // CONFIG_EXT_TX
@@ -2562,8 +2562,7 @@ void av1_highbd_inv_txfm_add_4x4(const tran_low_t *input, uint8_t *dest,
     case H_ADST:
     case V_FLIPADST:
     case H_FLIPADST:
-      // Use C version since DST only exists in C code
-      av1_highbd_iht4x4_16_add_c(input, dest, stride, tx_type, bd);
+      av1_highbd_iht4x4_16_add(input, dest, stride, tx_type, bd);
       break;
     case IDTX:
       highbd_inv_idtx_add_c(input, dest, stride, 4, tx_type, bd);
@@ -2576,69 +2575,69 @@ void av1_highbd_inv_txfm_add_4x4(const tran_low_t *input, uint8_t *dest,
 void av1_highbd_inv_txfm_add_4x8(const tran_low_t *input, uint8_t *dest,
                                  int stride, int eob, int bd, TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht4x8_32_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht4x8_32_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_8x4(const tran_low_t *input, uint8_t *dest,
                                  int stride, int eob, int bd, TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht8x4_32_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht8x4_32_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_4x16(const tran_low_t *input, uint8_t *dest,
                                   int stride, int eob, int bd,
                                   TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht4x16_64_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht4x16_64_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_16x4(const tran_low_t *input, uint8_t *dest,
                                   int stride, int eob, int bd,
                                   TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht16x4_64_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht16x4_64_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_8x16(const tran_low_t *input, uint8_t *dest,
                                   int stride, int eob, int bd,
                                   TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht8x16_128_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht8x16_128_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_16x8(const tran_low_t *input, uint8_t *dest,
                                   int stride, int eob, int bd,
                                   TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht16x8_128_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht16x8_128_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_8x32(const tran_low_t *input, uint8_t *dest,
                                   int stride, int eob, int bd,
                                   TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht8x32_256_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht8x32_256_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_32x8(const tran_low_t *input, uint8_t *dest,
                                   int stride, int eob, int bd,
                                   TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht32x8_256_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht32x8_256_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_16x32(const tran_low_t *input, uint8_t *dest,
                                    int stride, int eob, int bd,
                                    TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht16x32_512_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht16x32_512_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_32x16(const tran_low_t *input, uint8_t *dest,
                                    int stride, int eob, int bd,
                                    TX_TYPE tx_type) {
   (void)eob;
-  av1_highbd_iht32x16_512_add_c(input, dest, stride, tx_type, bd);
+  av1_highbd_iht32x16_512_add(input, dest, stride, tx_type, bd);
 }
 
 void av1_highbd_inv_txfm_add_8x8(const tran_low_t *input, uint8_t *dest,
@@ -2667,8 +2666,7 @@ void av1_highbd_inv_txfm_add_8x8(const tran_low_t *input, uint8_t *dest,
     case H_ADST:
     case V_FLIPADST:
     case H_FLIPADST:
-      // Use C version since DST only exists in C code
-      av1_highbd_iht8x8_64_add_c(input, dest, stride, tx_type, bd);
+      av1_highbd_iht8x8_64_add(input, dest, stride, tx_type, bd);
       break;
     case IDTX:
       highbd_inv_idtx_add_c(input, dest, stride, 8, tx_type, bd);
@@ -2705,8 +2703,7 @@ void av1_highbd_inv_txfm_add_16x16(const tran_low_t *input, uint8_t *dest,
     case H_ADST:
     case V_FLIPADST:
     case H_FLIPADST:
-      // Use C version since DST only exists in C code
-      av1_highbd_iht16x16_256_add_c(input, dest, stride, tx_type, bd);
+      av1_highbd_iht16x16_256_add(input, dest, stride, tx_type, bd);
       break;
     case IDTX:
       highbd_inv_idtx_add_c(input, dest, stride, 16, tx_type, bd);
@@ -2740,7 +2737,7 @@ void av1_highbd_inv_txfm_add_32x32(const tran_low_t *input, uint8_t *dest,
     case H_ADST:
     case V_FLIPADST:
     case H_FLIPADST:
-      av1_highbd_iht32x32_1024_add_c(input, dest, stride, tx_type, bd);
+      av1_highbd_iht32x32_1024_add(input, dest, stride, tx_type, bd);
       break;
     case IDTX:
       highbd_inv_idtx_add_c(input, dest, stride, 32, tx_type, bd);
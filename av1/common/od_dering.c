@@ -292,61 +292,97 @@ void copy_dering_16bit_to_16bit(int16_t *dst, int dstride, int16_t *src,
   }
 }
 
+/* Direction search over every block of a superblock. dirs[] and vars[] are
+   indexed like dlist[]. */
+void od_dir_find8_list_c(const int16_t *in, const dering_list *dlist,
+                         int dering_count, int *dirs, int32_t *vars,
+                         int coeff_shift) {
+  int bi;
+  for (bi = 0; bi < dering_count; bi++) {
+    dirs[bi] = od_dir_find8_c(
+        &in[8 * dlist[bi].by * OD_FILT_BSTRIDE + 8 * dlist[bi].bx],
+        OD_FILT_BSTRIDE, &vars[bi], coeff_shift);
+  }
+}
+
+/* Directional filter over every block of a superblock. Block bi is read from
+   its position in in[] and written packed to y[bi << 2 * bsize]. */
+void od_filter_dering_direction_list_c(int16_t *y, const int16_t *in,
+                                       const dering_list *dlist,
+                                       int dering_count, int bsize,
+                                       const int *thresholds, const int *dirs,
+                                       int *filter2_thresh) {
+  int bi;
+  for (bi = 0; bi < dering_count; bi++) {
+    int16_t *const yb = &y[bi << 2 * bsize];
+    const int16_t *const inb = &in[(dlist[bi].by * OD_FILT_BSTRIDE << bsize) +
+                                   (dlist[bi].bx << bsize)];
+    filter2_thresh[bi] =
+        bsize == 3 ? od_filter_dering_direction_8x8_c(yb, 1 << bsize, inb,
+                                                      thresholds[bi], dirs[bi])
+                   : od_filter_dering_direction_4x4_c(yb, 1 << bsize, inb,
+                                                      thresholds[bi], dirs[bi]);
+  }
+}
+
+/* Orthogonal filter over every block of a superblock, skipping the blocks
+   whose threshold is 0. */
+void od_filter_dering_orthogonal_list_c(int16_t *y, const int16_t *in,
+                                        const dering_list *dlist,
+                                        int dering_count, int bsize,
+                                        const int *thresholds,
+                                        const int *dirs) {
+  int bi;
+  for (bi = 0; bi < dering_count; bi++) {
+    int16_t *const yb = &y[bi << 2 * bsize];
+    const int16_t *const inb = &in[(dlist[bi].by * OD_FILT_BSTRIDE << bsize) +
+                                   (dlist[bi].bx << bsize)];
+    if (thresholds[bi] == 0) continue;
+    if (bsize == 3)
+      od_filter_dering_orthogonal_8x8_c(yb, 1 << bsize, inb, thresholds[bi],
+                                        dirs[bi]);
+    else
+      od_filter_dering_orthogonal_4x4_c(yb, 1 << bsize, inb, thresholds[bi],
+                                        dirs[bi]);
+  }
+}
+
 void od_dering(int16_t *y, int16_t *in, int xdec,
                int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS], int pli,
                dering_list *dlist, int dering_count, int threshold,
                int coeff_shift) {
   int bi;
-  int bx;
-  int by;
   int bsize;
-  int filter2_thresh[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
-  od_filter_dering_direction_func filter_dering_direction[OD_DERINGSIZES] = {
-    od_filter_dering_direction_4x4, od_filter_dering_direction_8x8
-  };
-  od_filter_dering_orthogonal_func filter_dering_orthogonal[OD_DERINGSIZES] = {
-    od_filter_dering_orthogonal_4x4, od_filter_dering_orthogonal_8x8
-  };
+  /* Per-block state, indexed like dlist[]. */
+  int dirs[OD_DERING_NBLOCKS * OD_DERING_NBLOCKS];
+  int thresh[OD_DERING_NBLOCKS * OD_DERING_NBLOCKS];
+  int filter2_thresh[OD_DERING_NBLOCKS * OD_DERING_NBLOCKS];
   bsize = OD_DERING_SIZE_LOG2 - xdec;
   if (pli == 0) {
+    int32_t var[OD_DERING_NBLOCKS * OD_DERING_NBLOCKS];
+    od_dir_find8_list(in, dlist, dering_count, dirs, var, coeff_shift);
     for (bi = 0; bi < dering_count; bi++) {
-      int32_t var;
-      by = dlist[bi].by;
-      bx = dlist[bi].bx;
-      dir[by][bx] = od_dir_find8(&in[8 * by * OD_FILT_BSTRIDE + 8 * bx],
-                                 OD_FILT_BSTRIDE, &var, coeff_shift);
-      /* Deringing orthogonal to the direction uses a tighter threshold
-         because we want to be conservative. We've presumably already
-         achieved some deringing, so the amount of change is expected
-         to be low. Also, since we might be filtering across an edge, we
-         want to make sure not to blur it. That being said, we might want
-         to be a little bit more aggressive on pure horizontal/vertical
-         since the ringing there tends to be directional, so it doesn't
-         get removed by the directional filtering. */
-      filter2_thresh[by][bx] = (filter_dering_direction[bsize - OD_LOG_BSIZE0])(
-          &y[bi << 2 * bsize], 1 << bsize,
-          &in[(by * OD_FILT_BSTRIDE << bsize) + (bx << bsize)],
-          od_adjust_thresh(threshold, var), dir[by][bx]);
+      dir[dlist[bi].by][dlist[bi].bx] = dirs[bi];
+      thresh[bi] = od_adjust_thresh(threshold, var[bi]);
     }
   } else {
     for (bi = 0; bi < dering_count; bi++) {
-      by = dlist[bi].by;
-      bx = dlist[bi].bx;
-      filter2_thresh[by][bx] = (filter_dering_direction[bsize - OD_LOG_BSIZE0])(
-          &y[bi << 2 * bsize], 1 << bsize,
-          &in[(by * OD_FILT_BSTRIDE << bsize) + (bx << bsize)], threshold,
-          dir[by][bx]);
+      dirs[bi] = dir[dlist[bi].by][dlist[bi].bx];
+      thresh[bi] = threshold;
     }
   }
+  /* Deringing orthogonal to the direction uses a tighter threshold
+     because we want to be conservative. We've presumably already
+     achieved some deringing, so the amount of change is expected
+     to be low. Also, since we might be filtering across an edge, we
+     want to make sure not to blur it. That being said, we might want
+     to be a little bit more aggressive on pure horizontal/vertical
+     since the ringing there tends to be directional, so it doesn't
+     get removed by the directional filtering. */
+  od_filter_dering_direction_list(y, in, dlist, dering_count, bsize, thresh,
+                                  dirs, filter2_thresh);
   copy_dering_16bit_to_16bit(in, OD_FILT_BSTRIDE, y, dlist, dering_count,
                              bsize);
-  for (bi = 0; bi < dering_count; bi++) {
-    by = dlist[bi].by;
-    bx = dlist[bi].bx;
-    if (filter2_thresh[by][bx] == 0) continue;
-    (filter_dering_orthogonal[bsize - OD_LOG_BSIZE0])(
-        &y[bi << 2 * bsize], 1 << bsize,
-        &in[(by * OD_FILT_BSTRIDE << bsize) + (bx << bsize)],
-        filter2_thresh[by][bx], dir[by][bx]);
-  }
+  od_filter_dering_orthogonal_list(y, in, dlist, dering_count, bsize,
+                                   filter2_thresh, dirs);
 }
@@ -33,17 +33,11 @@
 
 extern const int OD_DIRECTION_OFFSETS_TABLE[8][3];
 
-typedef struct {
+typedef struct dering_list {
   unsigned char by;
   unsigned char bx;
 } dering_list;
 
-typedef int (*od_filter_dering_direction_func)(int16_t *y, int ystride,
-                                               const int16_t *in, int threshold,
-                                               int dir);
-typedef void (*od_filter_dering_orthogonal_func)(int16_t *y, int ystride,
-                                                 const int16_t *in,
-                                                 int threshold, int dir);
 void copy_dering_16bit_to_16bit(int16_t *dst, int dstride, int16_t *src,
                                 dering_list *dlist, int dering_count,
                                 int bsize);
@@ -62,4 +56,17 @@ void od_filter_dering_orthogonal_4x4_c(int16_t *y, int ystride,
 void od_filter_dering_orthogonal_8x8_c(int16_t *y, int ystride,
                                        const int16_t *in, int threshold,
                                        int dir);
+void od_dir_find8_list_c(const int16_t *in, const dering_list *dlist,
+                         int dering_count, int *dirs, int32_t *vars,
+                         int coeff_shift);
+void od_filter_dering_direction_list_c(int16_t *y, const int16_t *in,
+                                       const dering_list *dlist,
+                                       int dering_count, int bsize,
+                                       const int *thresholds, const int *dirs,
+                                       int *filter2_thresh);
+void od_filter_dering_orthogonal_list_c(int16_t *y, const int16_t *in,
+                                        const dering_list *dlist,
+                                        int dering_count, int bsize,
+                                        const int *thresholds,
+                                        const int *dirs);
 #endif
@@ -627,83 +627,200 @@ static int intra_subpel_interp(int base, int shift, const uint8_t *ref,
 
   return val;
 }
-#endif  // CONFIG_INTRA_INTERP
 
-// Directional prediction, zone 1: 0 < angle < 90
+// Directional prediction, zone 1: 0 < angle < 90, with a non-linear
+// interpolation filter. The linear filter is av1_dr_prediction_z1().
 static void dr_prediction_z1(uint8_t *dst, ptrdiff_t stride, int bs,
                              const uint8_t *above, const uint8_t *left,
-#if CONFIG_INTRA_INTERP
-                             INTRA_FILTER filter_type,
-#endif  // CONFIG_INTRA_INTERP
-                             int dx, int dy) {
-  int r, c, x, base, shift, val;
+                             INTRA_FILTER filter_type, int dx, int dy) {
+  const int pad_size = SUBPEL_TAPS >> 1;
+  int r, c, x, base, shift, val, len;
+  DECLARE_ALIGNED(16, uint8_t, buf[SUBPEL_SHIFTS][MAX_SB_SIZE]);
+  DECLARE_ALIGNED(16, uint8_t, src[MAX_SB_SIZE + SUBPEL_TAPS]);
+  uint8_t flags[SUBPEL_SHIFTS];
 
   (void)left;
   (void)dy;
   assert(dy == 1);
   assert(dx > 0);
+  assert(filter_type != INTRA_FILTER_LINEAR);
+
+  memset(flags, 0, SUBPEL_SHIFTS * sizeof(flags[0]));
+  memset(src, above[0], pad_size * sizeof(above[0]));
+  memcpy(src + pad_size, above, 2 * bs * sizeof(above[0]));
+  memset(src + pad_size + 2 * bs, above[2 * bs - 1],
+         pad_size * sizeof(above[0]));
+  flags[0] = 1;
+  x = dx;
+  for (r = 0; r < bs; ++r, dst += stride, x += dx) {
+    base = x >> 8;
+    shift = x & 0xFF;
+    shift = ROUND_POWER_OF_TWO(shift, 8 - SUBPEL_BITS);
+    if (shift == SUBPEL_SHIFTS) {
+      base += 1;
+      shift = 0;
+    }
+    len = AOMMIN(bs, 2 * bs - 1 - base);
+    if (len <= 0) {
+      int i;
+      for (i = r; i < bs; ++i) {
+        memset(dst, above[2 * bs - 1], bs * sizeof(dst[0]));
+        dst += stride;
+      }
+      return;
+    }
 
-#if CONFIG_INTRA_INTERP
-  if (filter_type != INTRA_FILTER_LINEAR) {
-    const int pad_size = SUBPEL_TAPS >> 1;
-    int len;
-    DECLARE_ALIGNED(16, uint8_t, buf[SUBPEL_SHIFTS][MAX_SB_SIZE]);
-    DECLARE_ALIGNED(16, uint8_t, src[MAX_SB_SIZE + SUBPEL_TAPS]);
-    uint8_t flags[SUBPEL_SHIFTS];
-
-    memset(flags, 0, SUBPEL_SHIFTS * sizeof(flags[0]));
-    memset(src, above[0], pad_size * sizeof(above[0]));
-    memcpy(src + pad_size, above, 2 * bs * sizeof(above[0]));
-    memset(src + pad_size + 2 * bs, above[2 * bs - 1],
-           pad_size * sizeof(above[0]));
-    flags[0] = 1;
-    x = dx;
-    for (r = 0; r < bs; ++r, dst += stride, x += dx) {
+    if (len <= (bs >> 1) && !flags[shift]) {
       base = x >> 8;
       shift = x & 0xFF;
-      shift = ROUND_POWER_OF_TWO(shift, 8 - SUBPEL_BITS);
-      if (shift == SUBPEL_SHIFTS) {
-        base += 1;
-        shift = 0;
+      for (c = 0; c < len; ++c) {
+        val = intra_subpel_interp(base, shift, above, 0, 2 * bs - 1,
+                                  filter_type);
+        dst[c] = clip_pixel(val);
+        ++base;
       }
-      len = AOMMIN(bs, 2 * bs - 1 - base);
-      if (len <= 0) {
-        int i;
-        for (i = r; i < bs; ++i) {
-          memset(dst, above[2 * bs - 1], bs * sizeof(dst[0]));
-          dst += stride;
+    } else {
+      if (!flags[shift]) {
+        const int16_t *filter = av1_intra_filter_kernels[filter_type][shift];
+        aom_convolve8_horiz(src + pad_size, 2 * bs, buf[shift], 2 * bs,
+                            filter, 16, NULL, 16, 2 * bs,
+                            2 * bs < 16 ? 2 : 1);
+        flags[shift] = 1;
+      }
+      memcpy(dst, shift == 0 ? src + pad_size + base : &buf[shift][base],
+             len * sizeof(dst[0]));
+    }
+
+    if (len < bs)
+      memset(dst + len, above[2 * bs - 1], (bs - len) * sizeof(dst[0]));
+  }
+}
+
+// Directional prediction, zone 2: 90 < angle < 180, with a non-linear
+// interpolation filter. The linear filter is av1_dr_prediction_z2().
+static void dr_prediction_z2(uint8_t *dst, ptrdiff_t stride, int bs,
+                             const uint8_t *above, const uint8_t *left,
+                             INTRA_FILTER filter_type, int dx, int dy) {
+  int r, c, x, y, shift1, shift2, val, base1, base2;
+
+  assert(dx > 0);
+  assert(dy > 0);
+  assert(filter_type != INTRA_FILTER_LINEAR);
+
+  x = -dx;
+  for (r = 0; r < bs; ++r, x -= dx, dst += stride) {
+    base1 = x >> 8;
+    y = (r << 8) - dy;
+    for (c = 0; c < bs; ++c, ++base1, y -= dy) {
+      if (base1 >= -1) {
+        shift1 = x & 0xFF;
+        val =
+            intra_subpel_interp(base1, shift1, above, -1, bs - 1, filter_type);
+      } else {
+        base2 = y >> 8;
+        if (base2 >= 0) {
+          shift2 = y & 0xFF;
+          val =
+              intra_subpel_interp(base2, shift2, left, 0, bs - 1, filter_type);
+        } else {
+          val = left[0];
         }
-        return;
       }
+      dst[c] = clip_pixel(val);
+    }
+  }
+}
 
-      if (len <= (bs >> 1) && !flags[shift]) {
-        base = x >> 8;
-        shift = x & 0xFF;
-        for (c = 0; c < len; ++c) {
-          val = intra_subpel_interp(base, shift, above, 0, 2 * bs - 1,
-                                    filter_type);
-          dst[c] = clip_pixel(val);
-          ++base;
+// Directional prediction, zone 3: 180 < angle < 270, with a non-linear
+// interpolation filter. The linear filter is av1_dr_prediction_z3().
+static void dr_prediction_z3(uint8_t *dst, ptrdiff_t stride, int bs,
+                             const uint8_t *above, const uint8_t *left,
+                             INTRA_FILTER filter_type, int dx, int dy) {
+  const int pad_size = SUBPEL_TAPS >> 1;
+  int r, c, y, base, shift, val, len, i;
+  DECLARE_ALIGNED(16, uint8_t, buf[MAX_SB_SIZE][4 * SUBPEL_SHIFTS]);
+  DECLARE_ALIGNED(16, uint8_t, src[(MAX_SB_SIZE + SUBPEL_TAPS) * 4]);
+  uint8_t flags[SUBPEL_SHIFTS];
+
+  (void)above;
+  (void)dx;
+  assert(dx == 1);
+  assert(dy > 0);
+  assert(filter_type != INTRA_FILTER_LINEAR);
+
+  memset(flags, 0, SUBPEL_SHIFTS * sizeof(flags[0]));
+  for (i = 0; i < pad_size; ++i) src[4 * i] = left[0];
+  for (i = 0; i < 2 * bs; ++i) src[4 * (i + pad_size)] = left[i];
+  for (i = 0; i < pad_size; ++i)
+    src[4 * (i + 2 * bs + pad_size)] = left[2 * bs - 1];
+  flags[0] = 1;
+  y = dy;
+  for (c = 0; c < bs; ++c, y += dy) {
+    base = y >> 8;
+    shift = y & 0xFF;
+    shift = ROUND_POWER_OF_TWO(shift, 8 - SUBPEL_BITS);
+    if (shift == SUBPEL_SHIFTS) {
+      base += 1;
+      shift = 0;
+    }
+    len = AOMMIN(bs, 2 * bs - 1 - base);
+
+    if (len <= 0) {
+      for (r = 0; r < bs; ++r) {
+        dst[r * stride + c] = left[2 * bs - 1];
+      }
+      continue;
+    }
+
+    if (len <= (bs >> 1) && !flags[shift]) {
+      base = y >> 8;
+      shift = y & 0xFF;
+      for (r = 0; r < len; ++r) {
+        val = intra_subpel_interp(base, shift, left, 0, 2 * bs - 1,
+                                  filter_type);
+        dst[r * stride + c] = clip_pixel(val);
+        ++base;
+      }
+    } else {
+      if (!flags[shift]) {
+        const int16_t *filter = av1_intra_filter_kernels[filter_type][shift];
+        aom_convolve8_vert(src + 4 * pad_size, 4, buf[0] + 4 * shift,
+                           4 * SUBPEL_SHIFTS, NULL, 16, filter, 16,
+                           2 * bs < 16 ? 4 : 4, 2 * bs);
+        flags[shift] = 1;
+      }
+
+      if (shift == 0) {
+        for (r = 0; r < len; ++r) {
+          dst[r * stride + c] = left[r + base];
         }
       } else {
-        if (!flags[shift]) {
-          const int16_t *filter = av1_intra_filter_kernels[filter_type][shift];
-          aom_convolve8_horiz(src + pad_size, 2 * bs, buf[shift], 2 * bs,
-                              filter, 16, NULL, 16, 2 * bs,
-                              2 * bs < 16 ? 2 : 1);
-          flags[shift] = 1;
+        for (r = 0; r < len; ++r) {
+          dst[r * stride + c] = buf[r + base][4 * shift];
         }
-        memcpy(dst, shift == 0 ? src + pad_size + base : &buf[shift][base],
-               len * sizeof(dst[0]));
       }
+    }
 
-      if (len < bs)
-        memset(dst + len, above[2 * bs - 1], (bs - len) * sizeof(dst[0]));
+    if (len < bs) {
+      for (r = len; r < bs; ++r) {
+        dst[r * stride + c] = left[2 * bs - 1];
+      }
     }
-    return;
   }
+}
 #endif  // CONFIG_INTRA_INTERP
 
+// Directional prediction, zone 1: 0 < angle < 90
+void av1_dr_prediction_z1_c(uint8_t *dst, ptrdiff_t stride, int bs,
+                            const uint8_t *above, const uint8_t *left, int dx,
+                            int dy) {
+  int r, c, x, base, shift, val;
+
+  (void)left;
+  (void)dy;
+  assert(dy == 1);
+  assert(dx > 0);
+
   x = dx;
   for (r = 0; r < bs; ++r, dst += stride, x += dx) {
     base = x >> 8;
@@ -731,12 +848,9 @@ static void dr_prediction_z1(uint8_t *dst, ptrdiff_t stride, int bs,
 }
 
 // Directional prediction, zone 2: 90 < angle < 180
-static void dr_prediction_z2(uint8_t *dst, ptrdiff_t stride, int bs,
-                             const uint8_t *above, const uint8_t *left,
-#if CONFIG_INTRA_INTERP
-                             INTRA_FILTER filter_type,
-#endif  // CONFIG_INTRA_INTERP
-                             int dx, int dy) {
+void av1_dr_prediction_z2_c(uint8_t *dst, ptrdiff_t stride, int bs,
+                            const uint8_t *above, const uint8_t *left, int dx,
+                            int dy) {
   int r, c, x, y, shift1, shift2, val, base1, base2;
 
   assert(dx > 0);
@@ -749,24 +863,14 @@ static void dr_prediction_z2(uint8_t *dst, ptrdiff_t stride, int bs,
     for (c = 0; c < bs; ++c, ++base1, y -= dy) {
       if (base1 >= -1) {
         shift1 = x & 0xFF;
-#if CONFIG_INTRA_INTERP
-        val =
-            intra_subpel_interp(base1, shift1, above, -1, bs - 1, filter_type);
-#else
         val = above[base1] * (256 - shift1) + above[base1 + 1] * shift1;
         val = ROUND_POWER_OF_TWO(val, 8);
-#endif  // CONFIG_INTRA_INTERP
       } else {
         base2 = y >> 8;
         if (base2 >= 0) {
           shift2 = y & 0xFF;
-#if CONFIG_INTRA_INTERP
-          val =
-              intra_subpel_interp(base2, shift2, left, 0, bs - 1, filter_type);
-#else
           val = left[base2] * (256 - shift2) + left[base2 + 1] * shift2;
           val = ROUND_POWER_OF_TWO(val, 8);
-#endif  // CONFIG_INTRA_INTERP
         } else {
           val = left[0];
         }
@@ -777,12 +881,9 @@ static void dr_prediction_z2(uint8_t *dst, ptrdiff_t stride, int bs,
 }
 
 // Directional prediction, zone 3: 180 < angle < 270
-static void dr_prediction_z3(uint8_t *dst, ptrdiff_t stride, int bs,
-                             const uint8_t *above, const uint8_t *left,
-#if CONFIG_INTRA_INTERP
-                             INTRA_FILTER filter_type,
-#endif  // CONFIG_INTRA_INTERP
-                             int dx, int dy) {
+void av1_dr_prediction_z3_c(uint8_t *dst, ptrdiff_t stride, int bs,
+                            const uint8_t *above, const uint8_t *left, int dx,
+                            int dy) {
   int r, c, y, base, shift, val;
 
   (void)above;
@@ -791,77 +892,6 @@ static void dr_prediction_z3(uint8_t *dst, ptrdiff_t stride, int bs,
   assert(dx == 1);
   assert(dy > 0);
 
-#if CONFIG_INTRA_INTERP
-  if (filter_type != INTRA_FILTER_LINEAR) {
-    const int pad_size = SUBPEL_TAPS >> 1;
-    int len, i;
-    DECLARE_ALIGNED(16, uint8_t, buf[MAX_SB_SIZE][4 * SUBPEL_SHIFTS]);
-    DECLARE_ALIGNED(16, uint8_t, src[(MAX_SB_SIZE + SUBPEL_TAPS) * 4]);
-    uint8_t flags[SUBPEL_SHIFTS];
-
-    memset(flags, 0, SUBPEL_SHIFTS * sizeof(flags[0]));
-    for (i = 0; i < pad_size; ++i) src[4 * i] = left[0];
-    for (i = 0; i < 2 * bs; ++i) src[4 * (i + pad_size)] = left[i];
-    for (i = 0; i < pad_size; ++i)
-      src[4 * (i + 2 * bs + pad_size)] = left[2 * bs - 1];
-    flags[0] = 1;
-    y = dy;
-    for (c = 0; c < bs; ++c, y += dy) {
-      base = y >> 8;
-      shift = y & 0xFF;
-      shift = ROUND_POWER_OF_TWO(shift, 8 - SUBPEL_BITS);
-      if (shift == SUBPEL_SHIFTS) {
-        base += 1;
-        shift = 0;
-      }
-      len = AOMMIN(bs, 2 * bs - 1 - base);
-
-      if (len <= 0) {
-        for (r = 0; r < bs; ++r) {
-          dst[r * stride + c] = left[2 * bs - 1];
-        }
-        continue;
-      }
-
-      if (len <= (bs >> 1) && !flags[shift]) {
-        base = y >> 8;
-        shift = y & 0xFF;
-        for (r = 0; r < len; ++r) {
-          val = intra_subpel_interp(base, shift, left, 0, 2 * bs - 1,
-                                    filter_type);
-          dst[r * stride + c] = clip_pixel(val);
-          ++base;
-        }
-      } else {
-        if (!flags[shift]) {
-          const int16_t *filter = av1_intra_filter_kernels[filter_type][shift];
-          aom_convolve8_vert(src + 4 * pad_size, 4, buf[0] + 4 * shift,
-                             4 * SUBPEL_SHIFTS, NULL, 16, filter, 16,
-                             2 * bs < 16 ? 4 : 4, 2 * bs);
-          flags[shift] = 1;
-        }
-
-        if (shift == 0) {
-          for (r = 0; r < len; ++r) {
-            dst[r * stride + c] = left[r + base];
-          }
-        } else {
-          for (r = 0; r < len; ++r) {
-            dst[r * stride + c] = buf[r + base][4 * shift];
-          }
-        }
-      }
-
-      if (len < bs) {
-        for (r = len; r < bs; ++r) {
-          dst[r * stride + c] = left[2 * bs - 1];
-        }
-      }
-    }
-    return;
-  }
-#endif  // CONFIG_INTRA_INTERP
-
   y = dy;
   for (c = 0; c < bs; ++c, y += dy) {
     base = y >> 8;
@@ -921,24 +951,27 @@ static void dr_predictor(uint8_t *dst, ptrdiff_t stride, TX_SIZE tx_size,
   const int bs = tx_size_wide[tx_size];
   assert(angle > 0 && angle < 270);
 
-  if (angle > 0 && angle < 90) {
-    dr_prediction_z1(dst, stride, bs, above, left,
 #if CONFIG_INTRA_INTERP
-                     filter_type,
+  if (filter_type != INTRA_FILTER_LINEAR) {
+    if (angle > 0 && angle < 90) {
+      dr_prediction_z1(dst, stride, bs, above, left, filter_type, dx, dy);
+      return;
+    } else if (angle > 90 && angle < 180) {
+      dr_prediction_z2(dst, stride, bs, above, left, filter_type, dx, dy);
+      return;
+    } else if (angle > 180 && angle < 270) {
+      dr_prediction_z3(dst, stride, bs, above, left, filter_type, dx, dy);
+      return;
+    }
+  }
 #endif  // CONFIG_INTRA_INTERP
-                     dx, dy);
+
+  if (angle > 0 && angle < 90) {
+    av1_dr_prediction_z1(dst, stride, bs, above, left, dx, dy);
   } else if (angle > 90 && angle < 180) {
-    dr_prediction_z2(dst, stride, bs, above, left,
-#if CONFIG_INTRA_INTERP
-                     filter_type,
-#endif  // CONFIG_INTRA_INTERP
-                     dx, dy);
+    av1_dr_prediction_z2(dst, stride, bs, above, left, dx, dy);
   } else if (angle > 180 && angle < 270) {
-    dr_prediction_z3(dst, stride, bs, above, left,
-#if CONFIG_INTRA_INTERP
-                     filter_type,
-#endif  // CONFIG_INTRA_INTERP
-                     dx, dy);
+    av1_dr_prediction_z3(dst, stride, bs, above, left, dx, dy);
   } else if (angle == 90) {
     pred[V_PRED][tx_size](dst, stride, above, left);
   } else if (angle == 180) {
@@ -976,15 +1009,13 @@ static int highbd_intra_subpel_interp(int base, int shift, const uint16_t *ref,
 
   return val;
 }
-#endif  // CONFIG_INTRA_INTERP
 
-// Directional prediction, zone 1: 0 < angle < 90
+// Directional prediction, zone 1: 0 < angle < 90, with a non-linear
+// interpolation filter.
 static void highbd_dr_prediction_z1(uint16_t *dst, ptrdiff_t stride, int bs,
                                     const uint16_t *above, const uint16_t *left,
-#if CONFIG_INTRA_INTERP
-                                    INTRA_FILTER filter_type,
-#endif  // CONFIG_INTRA_INTERP
-                                    int dx, int dy, int bd) {
+                                    INTRA_FILTER filter_type, int dx, int dy,
+                                    int bd) {
   int r, c, x, base, shift, val;
 
   (void)left;
@@ -1008,13 +1039,8 @@ static void highbd_dr_prediction_z1(uint16_t *dst, ptrdiff_t stride, int bs,
 
     for (c = 0; c < bs; ++c, ++base) {
       if (base < 2 * bs - 1) {
-#if CONFIG_INTRA_INTERP
         val = highbd_intra_subpel_interp(base, shift, above, 0, 2 * bs - 1,
                                          filter_type);
-#else
-        val = above[base] * (256 - shift) + above[base + 1] * shift;
-        val = ROUND_POWER_OF_TWO(val, 8);
-#endif  // CONFIG_INTRA_INTERP
         dst[c] = clip_pixel_highbd(val, bd);
       } else {
         dst[c] = above[2 * bs - 1];
@@ -1023,13 +1049,12 @@ static void highbd_dr_prediction_z1(uint16_t *dst, ptrdiff_t stride, int bs,
   }
 }
 
-// Directional prediction, zone 2: 90 < angle < 180
+// Directional prediction, zone 2: 90 < angle < 180, with a non-linear
+// interpolation filter.
 static void highbd_dr_prediction_z2(uint16_t *dst, ptrdiff_t stride, int bs,
                                     const uint16_t *above, const uint16_t *left,
-#if CONFIG_INTRA_INTERP
-                                    INTRA_FILTER filter_type,
-#endif  // CONFIG_INTRA_INTERP
-                                    int dx, int dy, int bd) {
+                                    INTRA_FILTER filter_type, int dx, int dy,
+                                    int bd) {
   int r, c, x, y, shift, val, base;
 
   assert(dx > 0);
@@ -1042,26 +1067,16 @@ static void highbd_dr_prediction_z2(uint16_t *dst, ptrdiff_t stride, int bs,
       base = x >> 8;
       if (base >= -1) {
         shift = x & 0xFF;
-#if CONFIG_INTRA_INTERP
         val = highbd_intra_subpel_interp(base, shift, above, -1, bs - 1,
                                          filter_type);
-#else
-        val = above[base] * (256 - shift) + above[base + 1] * shift;
-        val = ROUND_POWER_OF_TWO(val, 8);
-#endif  // CONFIG_INTRA_INTERP
       } else {
         x = c + 1;
         y = (r << 8) - x * dy;
         base = y >> 8;
         if (base >= 0) {
           shift = y & 0xFF;
-#if CONFIG_INTRA_INTERP
           val = highbd_intra_subpel_interp(base, shift, left, 0, bs - 1,
                                            filter_type);
-#else
-          val = left[base] * (256 - shift) + left[base + 1] * shift;
-          val = ROUND_POWER_OF_TWO(val, 8);
-#endif  // CONFIG_INTRA_INTERP
         } else {
           val = left[0];
         }
@@ -1072,13 +1087,12 @@ static void highbd_dr_prediction_z2(uint16_t *dst, ptrdiff_t stride, int bs,
   }
 }
 
-// Directional prediction, zone 3: 180 < angle < 270
+// Directional prediction, zone 3: 180 < angle < 270, with a non-linear
+// interpolation filter.
 static void highbd_dr_prediction_z3(uint16_t *dst, ptrdiff_t stride, int bs,
                                     const uint16_t *above, const uint16_t *left,
-#if CONFIG_INTRA_INTERP
-                                    INTRA_FILTER filter_type,
-#endif  // CONFIG_INTRA_INTERP
-                                    int dx, int dy, int bd) {
+                                    INTRA_FILTER filter_type, int dx, int dy,
+                                    int bd) {
   int r, c, y, base, shift, val;
 
   (void)above;
@@ -1093,13 +1107,111 @@ static void highbd_dr_prediction_z3(uint16_t *dst, ptrdiff_t stride, int bs,
 
     for (r = 0; r < bs; ++r, ++base) {
       if (base < 2 * bs - 1) {
-#if CONFIG_INTRA_INTERP
         val = highbd_intra_subpel_interp(base, shift, left, 0, 2 * bs - 1,
                                          filter_type);
-#else
+        dst[r * stride + c] = clip_pixel_highbd(val, bd);
+      } else {
+        for (; r < bs; ++r) dst[r * stride + c] = left[2 * bs - 1];
+        break;
+      }
+    }
+  }
+}
+#endif  // CONFIG_INTRA_INTERP
+
+// Directional prediction, zone 1: 0 < angle < 90
+void av1_highbd_dr_prediction_z1_c(uint16_t *dst, ptrdiff_t stride, int bs,
+                                   const uint16_t *above, const uint16_t *left,
+                                   int dx, int dy, int bd) {
+  int r, c, x, base, shift, val;
+
+  (void)left;
+  (void)dy;
+  assert(dy == 1);
+  assert(dx > 0);
+
+  x = dx;
+  for (r = 0; r < bs; ++r, dst += stride, x += dx) {
+    base = x >> 8;
+    shift = x & 0xFF;
+
+    if (base >= 2 * bs - 1) {
+      int i;
+      for (i = r; i < bs; ++i) {
+        aom_memset16(dst, above[2 * bs - 1], bs);
+        dst += stride;
+      }
+      return;
+    }
+
+    for (c = 0; c < bs; ++c, ++base) {
+      if (base < 2 * bs - 1) {
+        val = above[base] * (256 - shift) + above[base + 1] * shift;
+        val = ROUND_POWER_OF_TWO(val, 8);
+        dst[c] = clip_pixel_highbd(val, bd);
+      } else {
+        dst[c] = above[2 * bs - 1];
+      }
+    }
+  }
+}
+
+// Directional prediction, zone 2: 90 < angle < 180
+void av1_highbd_dr_prediction_z2_c(uint16_t *dst, ptrdiff_t stride, int bs,
+                                   const uint16_t *above, const uint16_t *left,
+                                   int dx, int dy, int bd) {
+  int r, c, x, y, shift, val, base;
+
+  assert(dx > 0);
+  assert(dy > 0);
+
+  for (r = 0; r < bs; ++r) {
+    for (c = 0; c < bs; ++c) {
+      y = r + 1;
+      x = (c << 8) - y * dx;
+      base = x >> 8;
+      if (base >= -1) {
+        shift = x & 0xFF;
+        val = above[base] * (256 - shift) + above[base + 1] * shift;
+        val = ROUND_POWER_OF_TWO(val, 8);
+      } else {
+        x = c + 1;
+        y = (r << 8) - x * dy;
+        base = y >> 8;
+        if (base >= 0) {
+          shift = y & 0xFF;
+          val = left[base] * (256 - shift) + left[base + 1] * shift;
+          val = ROUND_POWER_OF_TWO(val, 8);
+        } else {
+          val = left[0];
+        }
+      }
+      dst[c] = clip_pixel_highbd(val, bd);
+    }
+    dst += stride;
+  }
+}
+
+// Directional prediction, zone 3: 180 < angle < 270
+void av1_highbd_dr_prediction_z3_c(uint16_t *dst, ptrdiff_t stride, int bs,
+                                   const uint16_t *above, const uint16_t *left,
+                                   int dx, int dy, int bd) {
+  int r, c, y, base, shift, val;
+
+  (void)above;
+  (void)dx;
+  assert(dx == 1);
+  assert(dy > 0);
+
+  y = dy;
+  for (c = 0; c < bs; ++c, y += dy) {
+    base = y >> 8;
+    shift = y & 0xFF;
+
+    for (r = 0; r < bs; ++r, ++base) {
+      if (base < 2 * bs - 1) {
         val = left[base] * (256 - shift) + left[base + 1] * shift;
         val = ROUND_POWER_OF_TWO(val, 8);
-#endif  // CONFIG_INTRA_INTERP
         dst[r * stride + c] = clip_pixel_highbd(val, bd);
       } else {
         for (; r < bs; ++r) dst[r * stride + c] = left[2 * bs - 1];
@@ -1143,24 +1255,30 @@ static void highbd_dr_predictor(uint16_t *dst, ptrdiff_t stride, int bs,
   const int dy = get_dy(angle);
   assert(angle > 0 && angle < 270);
 
-  if (angle > 0 && angle < 90) {
-    highbd_dr_prediction_z1(dst, stride, bs, above, left,
 #if CONFIG_INTRA_INTERP
-                            filter,
+  if (filter != INTRA_FILTER_LINEAR) {
+    if (angle > 0 && angle < 90) {
+      highbd_dr_prediction_z1(dst, stride, bs, above, left, filter, dx, dy,
+                              bd);
+      return;
+    } else if (angle > 90 && angle < 180) {
+      highbd_dr_prediction_z2(dst, stride, bs, above, left, filter, dx, dy,
+                              bd);
+      return;
+    } else if (angle > 180 && angle < 270) {
+      highbd_dr_prediction_z3(dst, stride, bs, above, left, filter, dx, dy,
+                              bd);
+      return;
+    }
+  }
 #endif  // CONFIG_INTRA_INTERP
-                            dx, dy, bd);
+
+  if (angle > 0 && angle < 90) {
+    av1_highbd_dr_prediction_z1(dst, stride, bs, above, left, dx, dy, bd);
   } else if (angle > 90 && angle < 180) {
-    highbd_dr_prediction_z2(dst, stride, bs, above, left,
-#if CONFIG_INTRA_INTERP
-                            filter,
-#endif  // CONFIG_INTRA_INTERP
-                            dx, dy, bd);
+    av1_highbd_dr_prediction_z2(dst, stride, bs, above, left, dx, dy, bd);
   } else if (angle > 180 && angle < 270) {
-    highbd_dr_prediction_z3(dst, stride, bs, above, left,
-#if CONFIG_INTRA_INTERP
-                            filter,
-#endif  // CONFIG_INTRA_INTERP
-                            dx, dy, bd);
+    av1_highbd_dr_prediction_z3(dst, stride, bs, above, left, dx, dy, bd);
   } else if (angle == 90) {
     highbd_v_predictor(dst, stride, bs, above, left, bd);
   } else if (angle == 180) {
@@ -15,6 +15,7 @@
 #include "./aom_config.h"
 #include "./aom_dsp_rtcd.h"
 #include "./aom_scale_rtcd.h"
+#include "./av1_rtcd.h"
 #include "av1/common/onyxc_int.h"
 #include "av1/common/restoration.h"
 #include "aom_dsp/aom_dsp_common.h"
@@ -107,24 +108,36 @@ static void loop_restoration_init(RestorationInternal *rst, int kf) {
   rst->keyframe = kf;
 }
 
-void extend_frame(uint8_t *data, int width, int height, int stride) {
+// Extends the rows [row_start, row_end) of the plane into the left and right
+// borders, and the first or last row into the top or bottom border when the
+// range includes it.
+static void extend_frame_rows(uint8_t *data, int width, int height, int stride,
+                              int row_start, int row_end) {
   uint8_t *data_p;
   int i;
-  for (i = 0; i < height; ++i) {
+  for (i = row_start; i < row_end; ++i) {
     data_p = data + i * stride;
     memset(data_p - WIENER_HALFWIN, data_p[0], WIENER_HALFWIN);
     memset(data_p + width, data_p[width - 1], WIENER_HALFWIN);
   }
   data_p = data - WIENER_HALFWIN;
-  for (i = -WIENER_HALFWIN; i < 0; ++i) {
-    memcpy(data_p + i * stride, data_p, width + 2 * WIENER_HALFWIN);
+  if (row_start == 0) {
+    for (i = -WIENER_HALFWIN; i < 0; ++i) {
+      memcpy(data_p + i * stride, data_p, width + 2 * WIENER_HALFWIN);
+    }
   }
-  for (i = height; i < height + WIENER_HALFWIN; ++i) {
-    memcpy(data_p + i * stride, data_p + (height - 1) * stride,
-           width + 2 * WIENER_HALFWIN);
+  if (row_end == height) {
+    for (i = height; i < height + WIENER_HALFWIN; ++i) {
+      memcpy(data_p + i * stride, data_p + (height - 1) * stride,
+             width + 2 * WIENER_HALFWIN);
+    }
   }
 }
 
+void extend_frame(uint8_t *data, int width, int height, int stride) {
+  extend_frame_rows(data, width, height, stride, 0, height);
+}
+
 static void loop_copy_tile(uint8_t *data, int tile_idx, int subtile_idx,
                            int subtile_bits, int width, int height, int stride,
                            RestorationInternal *rst, uint8_t *dst,
@@ -141,13 +154,54 @@ static void loop_copy_tile(uint8_t *data, int tile_idx, int subtile_idx,
            h_end - h_start);
 }
 
+static void wiener_filter_rows(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter, ptrdiff_t tap_stride,
+                               int w, int h) {
+  int i, j, k;
+  for (i = 0; i < h; ++i) {
+    for (j = 0; j < w; ++j) {
+      const uint8_t *const src_p = src + i * src_stride + j;
+      int sum = 0;
+      for (k = 0; k < WIENER_WIN; ++k)
+        sum += src_p[(k - WIENER_HALFWIN) * tap_stride] * filter[k];
+      dst[i * dst_stride + j] =
+          clip_pixel(ROUND_POWER_OF_TWO(sum, WIENER_FILT_PREC_BITS) + *src_p);
+    }
+  }
+}
+
+void av1_wiener_convolve_add_src_c(const uint8_t *src, ptrdiff_t src_stride,
+                                   uint8_t *dst, ptrdiff_t dst_stride,
+                                   const int16_t *filter_x,
+                                   const int16_t *filter_y, int w, int h) {
+  uint8_t temp[(WIENER_STRIPE_HEIGHT + WIENER_WIN - 1) * WIENER_STRIPE_WIDTH];
+  int i, j;
+  for (j = 0; j < w; j += WIENER_STRIPE_WIDTH) {
+    const int sw = AOMMIN(WIENER_STRIPE_WIDTH, w - j);
+    // The rows above the first stripe only need the horizontal pass.
+    wiener_filter_rows(src - WIENER_HALFWIN * src_stride + j, src_stride, temp,
+                       sw, filter_x, 1, sw, WIENER_WIN - 1);
+    for (i = 0; i < h; i += WIENER_STRIPE_HEIGHT) {
+      const int sh = AOMMIN(WIENER_STRIPE_HEIGHT, h - i);
+      wiener_filter_rows(src + (i + WIENER_HALFWIN) * src_stride + j,
+                         src_stride, temp + (WIENER_WIN - 1) * sw, sw,
+                         filter_x, 1, sw, sh);
+      wiener_filter_rows(temp + WIENER_HALFWIN * sw, sw,
+                         dst + i * dst_stride + j, dst_stride, filter_y, sw,
+                         sw, sh);
+      // Carry the last rows of the stripe over to the next one.
+      memmove(temp, temp + sh * sw, (WIENER_WIN - 1) * sw * sizeof(*temp));
+    }
+  }
+}
+
 static void loop_wiener_filter_tile(uint8_t *data, int tile_idx, int width,
                                     int height, int stride,
                                     RestorationInternal *rst, uint8_t *dst,
                                     int dst_stride) {
   const int tile_width = rst->tile_width;
   const int tile_height = rst->tile_height;
-  int i, j;
   int h_start, h_end, v_start, v_end;
   if (rst->rsi->restoration_type[tile_idx] == RESTORE_NONE) {
     loop_copy_tile(data, tile_idx, 0, 0, width, height, stride, rst, dst,
@@ -157,18 +211,11 @@ static void loop_wiener_filter_tile(uint8_t *data, int tile_idx, int width,
   av1_get_rest_tile_limits(tile_idx, 0, 0, rst->nhtiles, rst->nvtiles,
                            tile_width, tile_height, width, height, 0, 0,
                            &h_start, &h_end, &v_start, &v_end);
-  // Convolve the whole tile (done in blocks here to match the requirements
-  // of the vectorized convolve functions, but the result is equivalent)
-  for (i = v_start; i < v_end; i += MAX_SB_SIZE)
-    for (j = h_start; j < h_end; j += MAX_SB_SIZE) {
-      int w = AOMMIN(MAX_SB_SIZE, (h_end - j + 15) & ~15);
-      int h = AOMMIN(MAX_SB_SIZE, (v_end - i + 15) & ~15);
-      const uint8_t *data_p = data + i * stride + j;
-      uint8_t *dst_p = dst + i * dst_stride + j;
-      aom_convolve8_add_src(data_p, stride, dst_p, dst_stride,
-                            rst->rsi->wiener_info[tile_idx].hfilter, 16,
-                            rst->rsi->wiener_info[tile_idx].vfilter, 16, w, h);
-    }
+  av1_wiener_convolve_add_src(data + v_start * stride + h_start, stride,
+                              dst + v_start * dst_stride + h_start, dst_stride,
+                              rst->rsi->wiener_info[tile_idx].hfilter,
+                              rst->rsi->wiener_info[tile_idx].vfilter,
+                              h_end - h_start, v_end - v_start);
 }
 
 static void loop_wiener_filter(uint8_t *data, int width, int height, int stride,
@@ -486,7 +533,7 @@ static void boxsumr(int32_t *src, int width, int height, int src_stride, int r,
   aom_free(tmp);
 }
 
-static void boxsum(int32_t *src, int width, int height, int src_stride, int r,
+void av1_box_sum_c(int32_t *src, int width, int height, int src_stride, int r,
                    int sqr, int32_t *dst, int dst_stride) {
   if (r == 1)
     boxsum1(src, width, height, src_stride, sqr, dst, dst_stride);
@@ -498,7 +545,7 @@ static void boxsum(int32_t *src, int width, int height, int src_stride, int r,
     boxsumr(src, width, height, src_stride, r, sqr, dst, dst_stride);
 }
 
-static void boxnum(int width, int height, int r, int8_t *num, int num_stride) {
+void av1_box_num(int width, int height, int r, int8_t *num, int num_stride) {
   int i, j;
   for (i = 0; i <= r; ++i) {
     for (j = 0; j <= r; ++j) {
@@ -535,50 +582,11 @@ void decode_xq(int *xqd, int *xq) {
   xq[1] = (1 << SGRPROJ_PRJ_BITS) - xq[0] - xqd[1];
 }
 
-#define APPROXIMATE_SGR 1
-void av1_selfguided_restoration(int32_t *dgd, int width, int height, int stride,
-                                int bit_depth, int r, int eps,
-                                int32_t *tmpbuf) {
-  int32_t *A = tmpbuf;
-  int32_t *B = A + RESTORATION_TILEPELS_MAX;
-  int8_t num[RESTORATION_TILEPELS_MAX];
-  int i, j;
-  eps <<= 2 * (bit_depth - 8);
-
-  // Don't filter tiles with dimensions < 5 on any axis
-  if ((width < 5) || (height < 5)) return;
-
-  boxsum(dgd, width, height, stride, r, 0, B, width);
-  boxsum(dgd, width, height, stride, r, 1, A, width);
-  boxnum(width, height, r, num, width);
-  // The following loop is optimized assuming r <= 2. If we allow
-  // r > 2, then the loop will need modifying.
-  assert(r <= 3);
-  for (i = 0; i < height; ++i) {
-    for (j = 0; j < width; ++j) {
-      const int k = i * width + j;
-      const int n = num[k];
-      // Assuming that we only allow up to 12-bit depth and r <= 2,
-      // we calculate p = n^2 * Var(n-pixel block of original image)
-      // (where n = 2 * r + 1 <= 5).
-      //
-      // There is an inequality which gives a bound on the variance:
-      // https://en.wikipedia.org/wiki/Popoviciu's_inequality_on_variances
-      // In this case, since each pixel is in the range [0, 2^12),
-      // the variance is at most 1/4 * (2^12)^2 = 2^22.
-      // Then p <= 25^2 * 2^22 < 2^32, and also q <= p + 25^2 * 68 < 2^32.
-      //
-      // The point of all this is to guarantee that q < 2^32, so that
-      // platforms with a 64-bit by 32-bit divide unit (eg, x86)
-      // can do the division by q more efficiently.
-      const uint32_t p = (uint32_t)((uint64_t)A[k] * n - (uint64_t)B[k] * B[k]);
-      const uint32_t q = (uint32_t)(p + n * n * eps);
-      assert((uint64_t)A[k] * n - (uint64_t)B[k] * B[k] < (25 * 25U << 22));
-      A[k] = (int32_t)(((uint64_t)p << SGRPROJ_SGR_BITS) + (q >> 1)) / q;
-      B[k] = ((SGRPROJ_SGR - A[k]) * B[k] + (n >> 1)) / n;
-    }
-  }
 #if APPROXIMATE_SGR
+void av1_selfguided_filter_edges(int32_t *dgd, int width, int height,
+                                 int stride, const int32_t *A,
+                                 const int32_t *B) {
+  int i, j;
   i = 0;
   j = 0;
   {
@@ -687,6 +695,53 @@ void av1_selfguided_restoration(int32_t *dgd, int width, int height, int stride,
         (((a * dgd[l] + b) << SGRPROJ_RST_BITS) + (1 << nb) / 2) >> nb;
     dgd[l] = ROUND_POWER_OF_TWO(v, SGRPROJ_SGR_BITS);
   }
+}
+#endif  // APPROXIMATE_SGR
+
+void av1_selfguided_restoration_c(int32_t *dgd, int width, int height,
+                                  int stride, int bit_depth, int r, int eps,
+                                  int32_t *tmpbuf) {
+  int32_t *A = tmpbuf;
+  int32_t *B = A + RESTORATION_TILEPELS_MAX;
+  int8_t num[RESTORATION_TILEPELS_MAX];
+  int i, j;
+  eps <<= 2 * (bit_depth - 8);
+
+  // Don't filter tiles with dimensions < 5 on any axis
+  if ((width < 5) || (height < 5)) return;
+
+  av1_box_sum_c(dgd, width, height, stride, r, 0, B, width);
+  av1_box_sum_c(dgd, width, height, stride, r, 1, A, width);
+  av1_box_num(width, height, r, num, width);
+  // The following loop is optimized assuming r <= 2. If we allow
+  // r > 2, then the loop will need modifying.
+  assert(r <= 3);
+  for (i = 0; i < height; ++i) {
+    for (j = 0; j < width; ++j) {
+      const int k = i * width + j;
+      const int n = num[k];
+      // Assuming that we only allow up to 12-bit depth and r <= 2,
+      // we calculate p = n^2 * Var(n-pixel block of original image)
+      // (where n = 2 * r + 1 <= 5).
+      //
+      // There is an inequality which gives a bound on the variance:
+      // https://en.wikipedia.org/wiki/Popoviciu's_inequality_on_variances
+      // In this case, since each pixel is in the range [0, 2^12),
+      // the variance is at most 1/4 * (2^12)^2 = 2^22.
+      // Then p <= 25^2 * 2^22 < 2^32, and also q <= p + 25^2 * 68 < 2^32.
+      //
+      // The point of all this is to guarantee that q < 2^32, so that
+      // platforms with a 64-bit by 32-bit divide unit (eg, x86)
+      // can do the division by q more efficiently.
+      const uint32_t p = (uint32_t)((uint64_t)A[k] * n - (uint64_t)B[k] * B[k]);
+      const uint32_t q = (uint32_t)(p + n * n * eps);
+      assert((uint64_t)A[k] * n - (uint64_t)B[k] * B[k] < (25 * 25U << 22));
+      A[k] = (int32_t)(((uint64_t)p << SGRPROJ_SGR_BITS) + (q >> 1)) / q;
+      B[k] = ((SGRPROJ_SGR - A[k]) * B[k] + (n >> 1)) / n;
+    }
+  }
+#if APPROXIMATE_SGR
+  av1_selfguided_filter_edges(dgd, width, height, stride, A, B);
   for (i = 1; i < height - 1; ++i) {
     for (j = 1; j < width - 1; ++j) {
       const int k = i * width + j;
@@ -708,9 +763,9 @@ void av1_selfguided_restoration(int32_t *dgd, int width, int height, int stride,
     }
   }
 #else
-  if (r > 1) boxnum(width, height, r = 1, num, width);
-  boxsum(A, width, height, width, r, 0, A, width);
-  boxsum(B, width, height, width, r, 0, B, width);
+  if (r > 1) av1_box_num(width, height, r = 1, num, width);
+  av1_box_sum_c(A, width, height, width, r, 0, A, width);
+  av1_box_sum_c(B, width, height, width, r, 0, B, width);
   for (i = 0; i < height; ++i) {
     for (j = 0; j < width; ++j) {
       const int k = i * width + j;
@@ -976,26 +1031,35 @@ static void loop_switchable_filter(uint8_t *data, int width, int height,
 }
 
 #if CONFIG_AOM_HIGHBITDEPTH
-void extend_frame_highbd(uint16_t *data, int width, int height, int stride) {
+static void extend_frame_rows_highbd(uint16_t *data, int width, int height,
+                                     int stride, int row_start, int row_end) {
   uint16_t *data_p;
   int i, j;
-  for (i = 0; i < height; ++i) {
+  for (i = row_start; i < row_end; ++i) {
     data_p = data + i * stride;
     for (j = -WIENER_HALFWIN; j < 0; ++j) data_p[j] = data_p[0];
     for (j = width; j < width + WIENER_HALFWIN; ++j)
       data_p[j] = data_p[width - 1];
   }
   data_p = data - WIENER_HALFWIN;
-  for (i = -WIENER_HALFWIN; i < 0; ++i) {
-    memcpy(data_p + i * stride, data_p,
-           (width + 2 * WIENER_HALFWIN) * sizeof(uint16_t));
+  if (row_start == 0) {
+    for (i = -WIENER_HALFWIN; i < 0; ++i) {
+      memcpy(data_p + i * stride, data_p,
+             (width + 2 * WIENER_HALFWIN) * sizeof(uint16_t));
+    }
   }
-  for (i = height; i < height + WIENER_HALFWIN; ++i) {
-    memcpy(data_p + i * stride, data_p + (height - 1) * stride,
-           (width + 2 * WIENER_HALFWIN) * sizeof(uint16_t));
+  if (row_end == height) {
+    for (i = height; i < height + WIENER_HALFWIN; ++i) {
+      memcpy(data_p + i * stride, data_p + (height - 1) * stride,
+             (width + 2 * WIENER_HALFWIN) * sizeof(uint16_t));
+    }
   }
 }
 
+void extend_frame_highbd(uint16_t *data, int width, int height, int stride) {
+  extend_frame_rows_highbd(data, width, height, stride, 0, height);
+}
+
 static void loop_copy_tile_highbd(uint16_t *data, int tile_idx, int subtile_idx,
                                   int subtile_bits, int width, int height,
                                   int stride, RestorationInternal *rst,
@@ -1012,6 +1076,51 @@ static void loop_copy_tile_highbd(uint16_t *data, int tile_idx, int subtile_idx,
            (h_end - h_start) * sizeof(*dst));
 }
 
+static void highbd_wiener_filter_rows(const uint16_t *src,
+                                      ptrdiff_t src_stride, uint16_t *dst,
+                                      ptrdiff_t dst_stride,
+                                      const int16_t *filter,
+                                      ptrdiff_t tap_stride, int w, int h,
+                                      int bd) {
+  int i, j, k;
+  for (i = 0; i < h; ++i) {
+    for (j = 0; j < w; ++j) {
+      const uint16_t *const src_p = src + i * src_stride + j;
+      int sum = 0;
+      for (k = 0; k < WIENER_WIN; ++k)
+        sum += src_p[(k - WIENER_HALFWIN) * tap_stride] * filter[k];
+      dst[i * dst_stride + j] = clip_pixel_highbd(
+          ROUND_POWER_OF_TWO(sum, WIENER_FILT_PREC_BITS) + *src_p, bd);
+    }
+  }
+}
+
+void av1_highbd_wiener_convolve_add_src_c(const uint16_t *src,
+                                          ptrdiff_t src_stride, uint16_t *dst,
+                                          ptrdiff_t dst_stride,
+                                          const int16_t *filter_x,
+                                          const int16_t *filter_y, int w,
+                                          int h, int bd) {
+  uint16_t temp[(WIENER_STRIPE_HEIGHT + WIENER_WIN - 1) * WIENER_STRIPE_WIDTH];
+  int i, j;
+  for (j = 0; j < w; j += WIENER_STRIPE_WIDTH) {
+    const int sw = AOMMIN(WIENER_STRIPE_WIDTH, w - j);
+    highbd_wiener_filter_rows(src - WIENER_HALFWIN * src_stride + j,
+                              src_stride, temp, sw, filter_x, 1, sw,
+                              WIENER_WIN - 1, bd);
+    for (i = 0; i < h; i += WIENER_STRIPE_HEIGHT) {
+      const int sh = AOMMIN(WIENER_STRIPE_HEIGHT, h - i);
+      highbd_wiener_filter_rows(src + (i + WIENER_HALFWIN) * src_stride + j,
+                                src_stride, temp + (WIENER_WIN - 1) * sw, sw,
+                                filter_x, 1, sw, sh, bd);
+      highbd_wiener_filter_rows(temp + WIENER_HALFWIN * sw, sw,
+                                dst + i * dst_stride + j, dst_stride, filter_y,
+                                sw, sw, sh, bd);
+      memmove(temp, temp + sh * sw, (WIENER_WIN - 1) * sw * sizeof(*temp));
+    }
+  }
+}
+
 static void loop_wiener_filter_tile_highbd(uint16_t *data, int tile_idx,
                                            int width, int height, int stride,
                                            RestorationInternal *rst,
@@ -1020,7 +1129,6 @@ static void loop_wiener_filter_tile_highbd(uint16_t *data, int tile_idx,
   const int tile_width = rst->tile_width;
   const int tile_height = rst->tile_height;
   int h_start, h_end, v_start, v_end;
-  int i, j;
 
   if (rst->rsi->restoration_type[tile_idx] == RESTORE_NONE) {
     loop_copy_tile_highbd(data, tile_idx, 0, 0, width, height, stride, rst, dst,
@@ -1030,19 +1138,12 @@ static void loop_wiener_filter_tile_highbd(uint16_t *data, int tile_idx,
   av1_get_rest_tile_limits(tile_idx, 0, 0, rst->nhtiles, rst->nvtiles,
                            tile_width, tile_height, width, height, 0, 0,
                            &h_start, &h_end, &v_start, &v_end);
-  // Convolve the whole tile (done in blocks here to match the requirements
-  // of the vectorized convolve functions, but the result is equivalent)
-  for (i = v_start; i < v_end; i += MAX_SB_SIZE)
-    for (j = h_start; j < h_end; j += MAX_SB_SIZE) {
-      int w = AOMMIN(MAX_SB_SIZE, (h_end - j + 15) & ~15);
-      int h = AOMMIN(MAX_SB_SIZE, (v_end - i + 15) & ~15);
-      const uint16_t *data_p = data + i * stride + j;
-      uint16_t *dst_p = dst + i * dst_stride + j;
-      aom_highbd_convolve8_add_src(
-          CONVERT_TO_BYTEPTR(data_p), stride, CONVERT_TO_BYTEPTR(dst_p),
-          dst_stride, rst->rsi->wiener_info[tile_idx].hfilter, 16,
-          rst->rsi->wiener_info[tile_idx].vfilter, 16, w, h, bit_depth);
-    }
+  av1_highbd_wiener_convolve_add_src(
+      data + v_start * stride + h_start, stride,
+      dst + v_start * dst_stride + h_start, dst_stride,
+      rst->rsi->wiener_info[tile_idx].hfilter,
+      rst->rsi->wiener_info[tile_idx].vfilter, h_end - h_start,
+      v_end - v_start, bit_depth);
 }
 
 static void loop_wiener_filter_highbd(uint8_t *data8, int width, int height,
@@ -1420,3 +1521,104 @@ void av1_loop_restoration_frame(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
   loop_restoration_rows(frame, cm, start_mi_row, end_mi_row, components_pattern,
                         rsi, dst);
 }
+
+// Sets up 'rst' for the restoration tiles of 'plane'.
+static void loop_restoration_plane_init(RestorationInternal *rst,
+                                        AV1_COMMON *cm, RestorationInfo *rsi,
+                                        int plane) {
+  const int ss_x = plane != AOM_PLANE_Y ? cm->subsampling_x : 0;
+  const int ss_y = plane != AOM_PLANE_Y ? cm->subsampling_y : 0;
+  loop_restoration_init(rst, cm->frame_type == KEY_FRAME);
+  rst->ntiles = av1_get_rest_ntiles(
+      ROUND_POWER_OF_TWO(cm->width, ss_x), ROUND_POWER_OF_TWO(cm->height, ss_y),
+      &rst->tile_width, &rst->tile_height, &rst->nhtiles, &rst->nvtiles);
+  rst->rsi = &rsi[plane];
+}
+
+void av1_loop_restoration_extend_rows(YV12_BUFFER_CONFIG *frame,
+                                      AV1_COMMON *cm, RestorationInfo *rsi,
+                                      int plane, int row_start, int row_end) {
+  const RestorationType frame_type = rsi[plane].frame_restoration_type;
+  const int width =
+      plane != AOM_PLANE_Y ? frame->uv_crop_width : frame->y_crop_width;
+  const int height =
+      plane != AOM_PLANE_Y ? frame->uv_crop_height : frame->y_crop_height;
+  const int stride = plane != AOM_PLANE_Y ? frame->uv_stride : frame->y_stride;
+  uint8_t *const data =
+      plane != AOM_PLANE_Y
+          ? (plane == AOM_PLANE_U ? frame->u_buffer : frame->v_buffer)
+          : frame->y_buffer;
+
+  // Only the Wiener filter reads outside the restoration tile.
+  if (frame_type != RESTORE_WIENER && frame_type != RESTORE_SWITCHABLE) return;
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (cm->use_highbitdepth)
+    extend_frame_rows_highbd(CONVERT_TO_SHORTPTR(data), width, height, stride,
+                             row_start, row_end);
+  else
+#else
+  (void)cm;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+    extend_frame_rows(data, width, height, stride, row_start, row_end);
+}
+
+void av1_loop_restoration_tile(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                               RestorationInfo *rsi, int plane, int tile_idx,
+                               int32_t *tmpbuf, YV12_BUFFER_CONFIG *dst) {
+  const int width =
+      plane != AOM_PLANE_Y ? frame->uv_crop_width : frame->y_crop_width;
+  const int height =
+      plane != AOM_PLANE_Y ? frame->uv_crop_height : frame->y_crop_height;
+  const int stride = plane != AOM_PLANE_Y ? frame->uv_stride : frame->y_stride;
+  const int dst_stride = plane != AOM_PLANE_Y ? dst->uv_stride : dst->y_stride;
+  uint8_t *const data =
+      plane != AOM_PLANE_Y
+          ? (plane == AOM_PLANE_U ? frame->u_buffer : frame->v_buffer)
+          : frame->y_buffer;
+  uint8_t *const dst_data =
+      plane != AOM_PLANE_Y
+          ? (plane == AOM_PLANE_U ? dst->u_buffer : dst->v_buffer)
+          : dst->y_buffer;
+  const RestorationType frame_type = rsi[plane].frame_restoration_type;
+  RestorationInternal rst;
+  RestorationType type;
+
+  assert(frame_type != RESTORE_NONE);
+  loop_restoration_plane_init(&rst, cm, rsi, plane);
+  rst.tmpbuf = tmpbuf;
+  assert(tile_idx < rst.ntiles);
+  type = frame_type == RESTORE_SWITCHABLE ? rst.rsi->restoration_type[tile_idx]
+                                          : frame_type;
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (cm->use_highbitdepth) {
+    uint16_t *const data16 = CONVERT_TO_SHORTPTR(data);
+    uint16_t *const dst16 = CONVERT_TO_SHORTPTR(dst_data);
+    if (type == RESTORE_NONE)
+      loop_copy_tile_highbd(data16, tile_idx, 0, 0, width, height, stride, &rst,
+                            dst16, dst_stride);
+    else if (type == RESTORE_WIENER)
+      loop_wiener_filter_tile_highbd(data16, tile_idx, width, height, stride,
+                                     &rst, cm->bit_depth, dst16, dst_stride);
+    else if (type == RESTORE_SGRPROJ)
+      loop_sgrproj_filter_tile_highbd(data16, tile_idx, width, height, stride,
+                                      &rst, cm->bit_depth, dst16, dst_stride);
+    else if (type == RESTORE_DOMAINTXFMRF)
+      loop_domaintxfmrf_filter_tile_highbd(data16, tile_idx, width, height,
+                                           stride, &rst, cm->bit_depth, dst16,
+                                           dst_stride);
+    return;
+  }
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  if (type == RESTORE_NONE)
+    loop_copy_tile(data, tile_idx, 0, 0, width, height, stride, &rst, dst_data,
+                   dst_stride);
+  else if (type == RESTORE_WIENER)
+    loop_wiener_filter_tile(data, tile_idx, width, height, stride, &rst,
+                            dst_data, dst_stride);
+  else if (type == RESTORE_SGRPROJ)
+    loop_sgrproj_filter_tile(data, tile_idx, width, height, stride, &rst,
+                             dst_data, dst_stride);
+  else if (type == RESTORE_DOMAINTXFMRF)
+    loop_domaintxfmrf_filter_tile(data, tile_idx, width, height, stride, &rst,
+                                  dst_data, dst_stride);
+}
@@ -73,16 +73,29 @@ extern "C" {
 
 #define SGRPROJ_BITS (SGRPROJ_PRJ_BITS * 2 + SGRPROJ_PARAMS_BITS)
 
+// Whether the self-guided filter combines the box filter coefficients of the
+// neighbouring pixels with fixed weights rather than with a second box sum.
+#define APPROXIMATE_SGR 1
+
 #define WIENER_HALFWIN 3
 #define WIENER_HALFWIN1 (WIENER_HALFWIN + 1)
 #define WIENER_WIN (2 * WIENER_HALFWIN + 1)
 #define WIENER_WIN2 ((WIENER_WIN) * (WIENER_WIN))
 #define WIENER_TMPBUF_SIZE (0)
+// Number of rows below a restoration tile that the filters may read.
+#define RESTORATION_BAND_LOOKAHEAD WIENER_HALFWIN
 #define WIENER_EXTBUF_SIZE (0)
 
 #define WIENER_FILT_PREC_BITS 7
 #define WIENER_FILT_STEP (1 << WIENER_FILT_PREC_BITS)
 
+// The Wiener filter is applied in stripes of up to WIENER_STRIPE_HEIGHT rows
+// and WIENER_STRIPE_WIDTH columns. The horizontally filtered rows of a stripe
+// are kept in one buffer and the last WIENER_WIN - 1 of them are carried over
+// to the next stripe, so every source row is filtered once.
+#define WIENER_STRIPE_HEIGHT 64
+#define WIENER_STRIPE_WIDTH (RESTORATION_TILESIZE_BIG * 3 / 2)
+
 // Central values for the taps
 #define WIENER_FILT_TAP0_MIDV (3)
 #define WIENER_FILT_TAP1_MIDV (-7)
@@ -225,8 +238,18 @@ int av1_alloc_restoration_struct(struct AV1Common *cm,
 void av1_free_restoration_struct(RestorationInfo *rst_info);
 
 void extend_frame(uint8_t *data, int width, int height, int stride);
-void av1_selfguided_restoration(int32_t *dgd, int width, int height, int stride,
-                                int bit_depth, int r, int eps, int32_t *tmpbuf);
+// Writes to each entry of 'num' the number of pixels in the (2r + 1)x(2r + 1)
+// box around it that are inside the width x height block, which is what
+// av1_box_sum() adds up.
+void av1_box_num(int width, int height, int r, int8_t *num, int num_stride);
+#if APPROXIMATE_SGR
+// Applies the self-guided filter with coefficients A and B to the pixels on
+// the edges of the width x height block, which have fewer neighbours than the
+// pixels inside it.
+void av1_selfguided_filter_edges(int32_t *dgd, int width, int height,
+                                 int stride, const int32_t *A,
+                                 const int32_t *B);
+#endif  // APPROXIMATE_SGR
 void av1_domaintxfmrf_restoration(uint8_t *dgd, int width, int height,
                                   int stride, int param, uint8_t *dst,
                                   int dst_stride, int32_t *tmpbuf);
@@ -241,6 +264,19 @@ void decode_xq(int *xqd, int *xq);
 void av1_loop_restoration_frame(YV12_BUFFER_CONFIG *frame, struct AV1Common *cm,
                                 RestorationInfo *rsi, int components_pattern,
                                 int partial_frame, YV12_BUFFER_CONFIG *dst);
+// Extends the rows [row_start, row_end) of 'plane' into the frame border for
+// the filters that read past the edge of the frame.
+void av1_loop_restoration_extend_rows(YV12_BUFFER_CONFIG *frame,
+                                      struct AV1Common *cm,
+                                      RestorationInfo *rsi, int plane,
+                                      int row_start, int row_end);
+// Restores the restoration tile 'tile_idx' of 'plane' into the same pixels of
+// 'dst', using 'tmpbuf' (RESTORATION_TMPBUF_SIZE bytes) as scratch. Tiles only
+// read the frame, so they can be restored in parallel once the rows around
+// them have been extended.
+void av1_loop_restoration_tile(YV12_BUFFER_CONFIG *frame, struct AV1Common *cm,
+                               RestorationInfo *rsi, int plane, int tile_idx,
+                               int32_t *tmpbuf, YV12_BUFFER_CONFIG *dst);
 void av1_loop_restoration_precal();
 #ifdef __cplusplus
 }  // extern "C"
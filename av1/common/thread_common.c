@@ -141,146 +141,155 @@ static INLINE void loop_filter_block_plane_hor(
   }
 }
 #endif
-// Row-based multi-threaded loopfilter hook
+// Row-based multi-threaded loopfilter
 #if CONFIG_PARALLEL_DEBLOCKING
-static int loop_filter_ver_row_worker(AV1LfSync *const lf_sync,
-                                      LFWorkerData *const lf_data) {
+// Filter the vertical edges of the superblock row at mi_row.
+static void loop_filter_ver_sb_row(LFWorkerData *const lf_data, int mi_row) {
+  AV1_COMMON *const cm = lf_data->cm;
   const int num_planes = lf_data->y_only ? 1 : MAX_MB_PLANE;
-  int mi_row, mi_col;
+  MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
+  int mi_col;
 #if !CONFIG_EXT_PARTITION_TYPES
   enum lf_path path = get_loop_filter_path(lf_data->y_only, lf_data->planes);
 #endif
-  for (mi_row = lf_data->start; mi_row < lf_data->stop;
-       mi_row += lf_sync->num_workers * lf_data->cm->mib_size) {
-    MODE_INFO **const mi =
-        lf_data->cm->mi_grid_visible + mi_row * lf_data->cm->mi_stride;
 
-    for (mi_col = 0; mi_col < lf_data->cm->mi_cols;
-         mi_col += lf_data->cm->mib_size) {
-      LOOP_FILTER_MASK lfm;
-      int plane;
+  for (mi_col = 0; mi_col < cm->mi_cols; mi_col += cm->mib_size) {
+    LOOP_FILTER_MASK lfm;
+    int plane;
 
-      av1_setup_dst_planes(lf_data->planes, lf_data->frame_buffer, mi_row,
-                           mi_col);
-      av1_setup_mask(lf_data->cm, mi_row, mi_col, mi + mi_col,
-                     lf_data->cm->mi_stride, &lfm);
+    av1_setup_dst_planes(lf_data->planes, lf_data->frame_buffer, mi_row,
+                         mi_col);
+    av1_setup_mask(cm, mi_row, mi_col, mi + mi_col, cm->mi_stride, &lfm);
 
 #if CONFIG_EXT_PARTITION_TYPES
-      for (plane = 0; plane < num_planes; ++plane)
-        av1_filter_block_plane_non420_ver(lf_data->cm, &lf_data->planes[plane],
-                                          mi + mi_col, mi_row, mi_col);
+    for (plane = 0; plane < num_planes; ++plane)
+      av1_filter_block_plane_non420_ver(cm, &lf_data->planes[plane],
+                                        mi + mi_col, mi_row, mi_col);
 #else
 
-      for (plane = 0; plane < num_planes; ++plane)
-        loop_filter_block_plane_ver(lf_data->cm, lf_data->planes, plane,
-                                    mi + mi_col, mi_row, mi_col, path, &lfm);
+    for (plane = 0; plane < num_planes; ++plane)
+      loop_filter_block_plane_ver(cm, lf_data->planes, plane, mi + mi_col,
+                                  mi_row, mi_col, path, &lfm);
 #endif
-    }
   }
-  return 1;
 }
 
-static int loop_filter_hor_row_worker(AV1LfSync *const lf_sync,
-                                      LFWorkerData *const lf_data) {
+// Filter the horizontal edges of the superblock row at mi_row, once the row
+// above has been filtered far enough.
+static void loop_filter_hor_sb_row(AV1LfSync *const lf_sync,
+                                   LFWorkerData *const lf_data, int mi_row) {
+  AV1_COMMON *const cm = lf_data->cm;
   const int num_planes = lf_data->y_only ? 1 : MAX_MB_PLANE;
-  const int sb_cols =
-      mi_cols_aligned_to_sb(lf_data->cm) >> lf_data->cm->mib_size_log2;
-  int mi_row, mi_col;
+  const int sb_cols = mi_cols_aligned_to_sb(cm) >> cm->mib_size_log2;
+  MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
+  int mi_col;
 #if !CONFIG_EXT_PARTITION_TYPES
   enum lf_path path = get_loop_filter_path(lf_data->y_only, lf_data->planes);
 #endif
 
-  for (mi_row = lf_data->start; mi_row < lf_data->stop;
-       mi_row += lf_sync->num_workers * lf_data->cm->mib_size) {
-    MODE_INFO **const mi =
-        lf_data->cm->mi_grid_visible + mi_row * lf_data->cm->mi_stride;
-
-    for (mi_col = 0; mi_col < lf_data->cm->mi_cols;
-         mi_col += lf_data->cm->mib_size) {
-      const int r = mi_row >> lf_data->cm->mib_size_log2;
-      const int c = mi_col >> lf_data->cm->mib_size_log2;
-      LOOP_FILTER_MASK lfm;
-      int plane;
-
-      // TODO(wenhao.zhang@intel.com): For better parallelization, reorder
-      // the outer loop to column-based and remove the synchronizations here.
-      sync_read(lf_sync, r, c);
-
-      av1_setup_dst_planes(lf_data->planes, lf_data->frame_buffer, mi_row,
-                           mi_col);
-      av1_setup_mask(lf_data->cm, mi_row, mi_col, mi + mi_col,
-                     lf_data->cm->mi_stride, &lfm);
+  for (mi_col = 0; mi_col < cm->mi_cols; mi_col += cm->mib_size) {
+    const int r = mi_row >> cm->mib_size_log2;
+    const int c = mi_col >> cm->mib_size_log2;
+    LOOP_FILTER_MASK lfm;
+    int plane;
+
+    // TODO(wenhao.zhang@intel.com): For better parallelization, reorder
+    // the outer loop to column-based and remove the synchronizations here.
+    sync_read(lf_sync, r, c);
+
+    av1_setup_dst_planes(lf_data->planes, lf_data->frame_buffer, mi_row,
+                         mi_col);
+    av1_setup_mask(cm, mi_row, mi_col, mi + mi_col, cm->mi_stride, &lfm);
 #if CONFIG_EXT_PARTITION_TYPES
-      for (plane = 0; plane < num_planes; ++plane)
-        av1_filter_block_plane_non420_hor(lf_data->cm, &lf_data->planes[plane],
-                                          mi + mi_col, mi_row, mi_col);
+    for (plane = 0; plane < num_planes; ++plane)
+      av1_filter_block_plane_non420_hor(cm, &lf_data->planes[plane],
+                                        mi + mi_col, mi_row, mi_col);
 #else
-      for (plane = 0; plane < num_planes; ++plane)
-        loop_filter_block_plane_hor(lf_data->cm, lf_data->planes, plane,
-                                    mi + mi_col, mi_row, mi_col, path, &lfm);
+    for (plane = 0; plane < num_planes; ++plane)
+      loop_filter_block_plane_hor(cm, lf_data->planes, plane, mi + mi_col,
+                                  mi_row, mi_col, path, &lfm);
 #endif
-      sync_write(lf_sync, r, c, sb_cols);
-    }
+    sync_write(lf_sync, r, c, sb_cols);
   }
+}
+
+static int loop_filter_ver_row_worker(AV1LfSync *const lf_sync,
+                                      LFWorkerData *const lf_data) {
+  int mi_row;
+  for (mi_row = lf_data->start; mi_row < lf_data->stop;
+       mi_row += lf_sync->num_workers * lf_data->cm->mib_size)
+    loop_filter_ver_sb_row(lf_data, mi_row);
+  return 1;
+}
+
+static int loop_filter_hor_row_worker(AV1LfSync *const lf_sync,
+                                      LFWorkerData *const lf_data) {
+  int mi_row;
+  for (mi_row = lf_data->start; mi_row < lf_data->stop;
+       mi_row += lf_sync->num_workers * lf_data->cm->mib_size)
+    loop_filter_hor_sb_row(lf_sync, lf_data, mi_row);
   return 1;
 }
 #else  //  CONFIG_PARALLEL_DEBLOCKING
-static int loop_filter_row_worker(AV1LfSync *const lf_sync,
-                                  LFWorkerData *const lf_data) {
+// Filter the superblock row at mi_row, following the row above it.
+static void loop_filter_sb_row(AV1LfSync *const lf_sync,
+                               LFWorkerData *const lf_data, int mi_row) {
+  AV1_COMMON *const cm = lf_data->cm;
   const int num_planes = lf_data->y_only ? 1 : MAX_MB_PLANE;
-  const int sb_cols =
-      mi_cols_aligned_to_sb(lf_data->cm) >> lf_data->cm->mib_size_log2;
-  int mi_row, mi_col;
+  const int sb_cols = mi_cols_aligned_to_sb(cm) >> cm->mib_size_log2;
+  MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
+  int mi_col;
 #if !CONFIG_EXT_PARTITION_TYPES
   enum lf_path path = get_loop_filter_path(lf_data->y_only, lf_data->planes);
 #endif  // !CONFIG_EXT_PARTITION_TYPES
 
-#if CONFIG_EXT_PARTITION
-  printf(
-      "STOPPING: This code has not been modified to work with the "
-      "extended coding unit size experiment");
-  exit(EXIT_FAILURE);
-#endif  // CONFIG_EXT_PARTITION
-
-  for (mi_row = lf_data->start; mi_row < lf_data->stop;
-       mi_row += lf_sync->num_workers * lf_data->cm->mib_size) {
-    MODE_INFO **const mi =
-        lf_data->cm->mi_grid_visible + mi_row * lf_data->cm->mi_stride;
-
-    for (mi_col = 0; mi_col < lf_data->cm->mi_cols;
-         mi_col += lf_data->cm->mib_size) {
-      const int r = mi_row >> lf_data->cm->mib_size_log2;
-      const int c = mi_col >> lf_data->cm->mib_size_log2;
+  for (mi_col = 0; mi_col < cm->mi_cols; mi_col += cm->mib_size) {
+    const int r = mi_row >> cm->mib_size_log2;
+    const int c = mi_col >> cm->mib_size_log2;
 #if !CONFIG_EXT_PARTITION_TYPES
-      LOOP_FILTER_MASK lfm;
+    LOOP_FILTER_MASK lfm;
 #endif
-      int plane;
+    int plane;
 
-      sync_read(lf_sync, r, c);
+    sync_read(lf_sync, r, c);
 
-      av1_setup_dst_planes(lf_data->planes, lf_data->frame_buffer, mi_row,
-                           mi_col);
+    av1_setup_dst_planes(lf_data->planes, lf_data->frame_buffer, mi_row,
+                         mi_col);
 #if CONFIG_EXT_PARTITION_TYPES
-      for (plane = 0; plane < num_planes; ++plane) {
-        av1_filter_block_plane_non420_ver(lf_data->cm, &lf_data->planes[plane],
-                                          mi + mi_col, mi_row, mi_col);
-        av1_filter_block_plane_non420_hor(lf_data->cm, &lf_data->planes[plane],
-                                          mi + mi_col, mi_row, mi_col);
-      }
+    for (plane = 0; plane < num_planes; ++plane) {
+      av1_filter_block_plane_non420_ver(cm, &lf_data->planes[plane],
+                                        mi + mi_col, mi_row, mi_col);
+      av1_filter_block_plane_non420_hor(cm, &lf_data->planes[plane],
+                                        mi + mi_col, mi_row, mi_col);
+    }
 #else
-      av1_setup_mask(lf_data->cm, mi_row, mi_col, mi + mi_col,
-                     lf_data->cm->mi_stride, &lfm);
-
-      for (plane = 0; plane < num_planes; ++plane) {
-        loop_filter_block_plane_ver(lf_data->cm, lf_data->planes, plane,
-                                    mi + mi_col, mi_row, mi_col, path, &lfm);
-        loop_filter_block_plane_hor(lf_data->cm, lf_data->planes, plane,
-                                    mi + mi_col, mi_row, mi_col, path, &lfm);
-      }
-#endif  // CONFIG_EXT_PARTITION_TYPES
-      sync_write(lf_sync, r, c, sb_cols);
+    av1_setup_mask(cm, mi_row, mi_col, mi + mi_col, cm->mi_stride, &lfm);
+
+    for (plane = 0; plane < num_planes; ++plane) {
+      loop_filter_block_plane_ver(cm, lf_data->planes, plane, mi + mi_col,
+                                  mi_row, mi_col, path, &lfm);
+      loop_filter_block_plane_hor(cm, lf_data->planes, plane, mi + mi_col,
+                                  mi_row, mi_col, path, &lfm);
     }
+#endif  // CONFIG_EXT_PARTITION_TYPES
+    sync_write(lf_sync, r, c, sb_cols);
   }
+}
+
+static int loop_filter_row_worker(AV1LfSync *const lf_sync,
+                                  LFWorkerData *const lf_data) {
+  int mi_row;
+
+#if CONFIG_EXT_PARTITION
+  printf(
+      "STOPPING: This code has not been modified to work with the "
+      "extended coding unit size experiment");
+  exit(EXIT_FAILURE);
+#endif  // CONFIG_EXT_PARTITION
+
+  for (mi_row = lf_data->start; mi_row < lf_data->stop;
+       mi_row += lf_sync->num_workers * lf_data->cm->mib_size)
+    loop_filter_sb_row(lf_sync, lf_data, mi_row);
   return 1;
 }
 #endif  //  CONFIG_PARALLEL_DEBLOCKING
@@ -288,15 +297,11 @@ static int loop_filter_row_worker(AV1LfSync *const lf_sync,
 static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                                 struct macroblockd_plane planes[MAX_MB_PLANE],
                                 int start, int stop, int y_only,
-                                AVxWorker *workers, int nworkers,
+                                AVxWorker *workers, int num_workers,
                                 AV1LfSync *lf_sync) {
   const AVxWorkerInterface *const winterface = aom_get_worker_interface();
   // Number of superblock rows and cols
   const int sb_rows = mi_rows_aligned_to_sb(cm) >> cm->mib_size_log2;
-  // Decoder may allocate more threads than number of tiles based on user's
-  // input.
-  const int tile_cols = cm->tile_cols;
-  const int num_workers = AOMMIN(nworkers, tile_cols);
   int i;
 
 #if CONFIG_EXT_PARTITION
@@ -312,15 +317,7 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
     av1_loop_filter_alloc(lf_sync, cm, sb_rows, cm->width, num_workers);
   }
 
-// Set up loopfilter thread data.
-// The decoder is capping num_workers because it has been observed that using
-// more threads on the loopfilter than there are cores will hurt performance
-// on Android. This is because the system will only schedule the tile decode
-// workers on cores equal to the number of tile columns. Then if the decoder
-// tries to use more threads for the loopfilter, it will hurt performance
-// because of contention. If the multithreading code changes in the future
-// then the number of workers used by the loopfilter should be revisited.
-
+  // Set up loopfilter thread data.
 #if CONFIG_PARALLEL_DEBLOCKING
   // Initialize cur_sb_col to -1 for all SB rows.
   memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * sb_rows);
@@ -515,6 +512,1101 @@ void av1_loop_filter_dealloc(AV1LfSync *lf_sync) {
   }
 }
 
+// Allocate memory for row-based multi-threading synchronization
+void av1_row_mt_sync_mem_alloc(AV1RowMTSync *row_mt_sync, AV1_COMMON *cm,
+                               int rows) {
+  row_mt_sync->rows = rows;
+#if CONFIG_MULTITHREAD
+  {
+    int i;
+
+    CHECK_MEM_ERROR(cm, row_mt_sync->mutex_,
+                    aom_malloc(sizeof(*row_mt_sync->mutex_) * rows));
+    if (row_mt_sync->mutex_) {
+      for (i = 0; i < rows; ++i) {
+        pthread_mutex_init(&row_mt_sync->mutex_[i], NULL);
+      }
+    }
+
+    CHECK_MEM_ERROR(cm, row_mt_sync->cond_,
+                    aom_malloc(sizeof(*row_mt_sync->cond_) * rows));
+    if (row_mt_sync->cond_) {
+      for (i = 0; i < rows; ++i) {
+        pthread_cond_init(&row_mt_sync->cond_[i], NULL);
+      }
+    }
+  }
+#endif  // CONFIG_MULTITHREAD
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->cur_sb_col,
+                  aom_malloc(sizeof(*row_mt_sync->cur_sb_col) * rows));
+
+  // Set up nsync.
+  row_mt_sync->sync_range = get_sync_range(cm->width);
+}
+
+// Deallocate row-based multi-threading synchronization related mutex and data
+void av1_row_mt_sync_mem_dealloc(AV1RowMTSync *row_mt_sync) {
+  if (row_mt_sync != NULL) {
+#if CONFIG_MULTITHREAD
+    int i;
+
+    if (row_mt_sync->mutex_ != NULL) {
+      for (i = 0; i < row_mt_sync->rows; ++i) {
+        pthread_mutex_destroy(&row_mt_sync->mutex_[i]);
+      }
+      aom_free(row_mt_sync->mutex_);
+    }
+    if (row_mt_sync->cond_ != NULL) {
+      for (i = 0; i < row_mt_sync->rows; ++i) {
+        pthread_cond_destroy(&row_mt_sync->cond_[i]);
+      }
+      aom_free(row_mt_sync->cond_);
+    }
+#endif  // CONFIG_MULTITHREAD
+    aom_free(row_mt_sync->cur_sb_col);
+    av1_zero(*row_mt_sync);
+  }
+}
+
+void av1_row_mt_sync_reset(AV1RowMTSync *row_mt_sync) {
+  memset(row_mt_sync->cur_sb_col, -1,
+         sizeof(*row_mt_sync->cur_sb_col) * row_mt_sync->rows);
+}
+
+void av1_row_mt_sync_read(AV1RowMTSync *const row_mt_sync, int r, int c) {
+#if CONFIG_MULTITHREAD
+  const int nsync = row_mt_sync->sync_range;
+
+  if (r && !(c & (nsync - 1))) {
+    pthread_mutex_t *const mutex = &row_mt_sync->mutex_[r - 1];
+    mutex_lock(mutex);
+
+    while (c > row_mt_sync->cur_sb_col[r - 1] - nsync) {
+      pthread_cond_wait(&row_mt_sync->cond_[r - 1], mutex);
+    }
+    pthread_mutex_unlock(mutex);
+  }
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void av1_row_mt_sync_wait(AV1RowMTSync *const row_mt_sync, int r, int c) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *const mutex = &row_mt_sync->mutex_[r];
+  mutex_lock(mutex);
+
+  while (row_mt_sync->cur_sb_col[r] < c) {
+    pthread_cond_wait(&row_mt_sync->cond_[r], mutex);
+  }
+  pthread_mutex_unlock(mutex);
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void av1_row_mt_sync_write(AV1RowMTSync *const row_mt_sync, int r, int c,
+                           const int sb_cols) {
+#if CONFIG_MULTITHREAD
+  const int nsync = row_mt_sync->sync_range;
+  int cur;
+  // Only signal when there are enough completed SB for the waiters to run.
+  int sig = 1;
+
+  if (c < sb_cols - 1) {
+    cur = c;
+    if (c % nsync) sig = 0;
+  } else {
+    cur = sb_cols + nsync;
+  }
+
+  if (sig) {
+    mutex_lock(&row_mt_sync->mutex_[r]);
+
+    row_mt_sync->cur_sb_col[r] = cur;
+
+    // A row may be waited on by both the row below and the row's producer.
+    pthread_cond_broadcast(&row_mt_sync->cond_[r]);
+    pthread_mutex_unlock(&row_mt_sync->mutex_[r]);
+  }
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+  (void)sb_cols;
+#endif  // CONFIG_MULTITHREAD
+}
+
+#if CONFIG_MULTITHREAD
+#define POST_FILTER_LOCK(pf) mutex_lock((pf)->mutex_)
+#define POST_FILTER_UNLOCK(pf) pthread_mutex_unlock((pf)->mutex_)
+#else
+#define POST_FILTER_LOCK(pf) (void)(pf)
+#define POST_FILTER_UNLOCK(pf) (void)(pf)
+#endif  // CONFIG_MULTITHREAD
+
+// Rows of the stage's input that are final.
+static INLINE int post_filter_input(const AV1PostFilterSync *pf, int stage) {
+  return stage == POST_FILTER_LF ? pf->recon_rows
+                                 : pf->output_rows[stage - 1];
+}
+
+// Loopfilter the superblock rows whose pixels are no longer needed for intra
+// prediction of the row below, or make them available to the other threads.
+static int post_filter_lf(AV1PostFilterSync *pf, int in) {
+  AV1_COMMON *const cm = pf->cm;
+  const int sb_rows_px = cm->mib_size << MI_SIZE_LOG2;
+
+  if (!pf->lf_enabled)
+    return in == pf->end_rows ? in : AOMMAX(0, in - sb_rows_px);
+
+  if (pf->lf_mt) {
+    const int num_passes = CONFIG_PARALLEL_DEBLOCKING ? 2 : 1;
+#if CONFIG_VAR_TX || CONFIG_PARALLEL_DEBLOCKING
+    const int ready = in == pf->end_rows ? cm->mi_rows : 0;
+#else
+    const int ready = in == pf->end_rows
+                          ? cm->mi_rows
+                          : AOMMAX(0, (in >> MI_SIZE_LOG2) - cm->mib_size);
+#endif  // CONFIG_VAR_TX || CONFIG_PARALLEL_DEBLOCKING
+    int done, pass;
+    POST_FILTER_LOCK(pf);
+    pf->lf_issued = (ready + cm->mib_size - 1) >> cm->mib_size_log2;
+    done = pf->lf_done;
+    pass = pf->lf_pass;
+    POST_FILTER_UNLOCK(pf);
+    if (pass == num_passes) return pf->end_rows;
+    if (num_passes > 1) return 0;
+    // The next superblock row filters the bottom lines of this one.
+    return AOMMAX(0, (done - 1) * sb_rows_px);
+  }
+
+#if CONFIG_VAR_TX || CONFIG_PARALLEL_DEBLOCKING
+  // The whole frame is filtered at once.
+  if (in < pf->end_rows) return 0;
+  av1_loop_filter_rows(pf->frame, cm, pf->lf_planes, 0, cm->mi_rows, 0);
+  pf->lf_mi_row = cm->mi_rows;
+  return pf->end_rows;
+#else
+  {
+    const int ready = in == pf->end_rows
+                          ? cm->mi_rows
+                          : AOMMAX(0, (in >> MI_SIZE_LOG2) - cm->mib_size);
+    if (ready > pf->lf_mi_row) {
+      av1_loop_filter_rows(pf->frame, cm, pf->lf_planes, pf->lf_mi_row, ready,
+                           0);
+      pf->lf_mi_row = ready;
+    }
+    // The next superblock row filters the bottom lines of this one.
+    if (pf->lf_mi_row == cm->mi_rows) return pf->end_rows;
+    return AOMMAX(0, (pf->lf_mi_row - cm->mib_size) << MI_SIZE_LOG2);
+  }
+#endif  // CONFIG_VAR_TX || CONFIG_PARALLEL_DEBLOCKING
+}
+
+// Loopfilter the available superblock rows for as long as there is free
+// thread data. Called and returns with the mutex held.
+static int post_filter_lf_rows_locked(AV1PostFilterSync *pf) {
+  int ran = 0;
+  while (pf->lf_next_row < pf->lf_issued && pf->lf_num_free_data > 0) {
+    const int sb_row = pf->lf_next_row++;
+    const int pass = pf->lf_pass;
+    LFWorkerData *const lf_data = pf->lf_free_data[--pf->lf_num_free_data];
+    POST_FILTER_UNLOCK(pf);
+    av1_loop_filter_data_reset(lf_data, pf->frame, pf->cm, pf->lf_planes);
+#if CONFIG_PARALLEL_DEBLOCKING
+    if (pass == 0)
+      loop_filter_ver_sb_row(lf_data, sb_row << pf->cm->mib_size_log2);
+    else
+      loop_filter_hor_sb_row(&pf->lf_sync, lf_data,
+                             sb_row << pf->cm->mib_size_log2);
+#else
+    (void)pass;
+    loop_filter_sb_row(&pf->lf_sync, lf_data, sb_row << pf->cm->mib_size_log2);
+#endif  // CONFIG_PARALLEL_DEBLOCKING
+    POST_FILTER_LOCK(pf);
+    pf->lf_free_data[pf->lf_num_free_data++] = lf_data;
+    pf->lf_row_done[sb_row] = 1;
+    while (pf->lf_done < pf->sb_rows && pf->lf_row_done[pf->lf_done]) {
+      ++pf->lf_done;
+      pf->pending[POST_FILTER_LF] = 1;
+    }
+    if (pf->lf_done == pf->sb_rows) {
+      // Start the next pass from the top, unless this was the last one.
+      ++pf->lf_pass;
+      if (pf->lf_pass < (CONFIG_PARALLEL_DEBLOCKING ? 2 : 1)) {
+        pf->lf_next_row = 0;
+        pf->lf_done = 0;
+        memset(pf->lf_row_done, 0, sizeof(*pf->lf_row_done) * pf->sb_rows);
+#if CONFIG_MULTITHREAD
+        // The rows of the new pass are all ready; share them.
+        pthread_cond_broadcast(pf->cond_);
+#endif  // CONFIG_MULTITHREAD
+      }
+    }
+    ran = 1;
+  }
+  return ran;
+}
+
+// Allocate the row synchronization and one set of thread data per thread
+// that can run the pipeline.
+static void lf_alloc(AV1PostFilterSync *pf, AV1_COMMON *cm, int max_threads) {
+  AV1LfSync *const lf_sync = &pf->lf_sync;
+  int i;
+
+  if (!lf_sync->sync_range || pf->sb_rows != lf_sync->rows ||
+      max_threads > lf_sync->num_workers) {
+    av1_loop_filter_dealloc(lf_sync);
+    aom_free(pf->lf_free_data);
+    pf->lf_free_data = NULL;
+    av1_loop_filter_alloc(lf_sync, cm, pf->sb_rows, cm->width, max_threads);
+    CHECK_MEM_ERROR(cm, pf->lf_free_data,
+                    aom_malloc(sizeof(*pf->lf_free_data) * max_threads));
+  }
+  for (i = 0; i < lf_sync->num_workers; ++i)
+    pf->lf_free_data[i] = &lf_sync->lfdata[i];
+  pf->lf_num_free_data = lf_sync->num_workers;
+  // Initialize cur_sb_col to -1 for all SB rows.
+  memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * pf->sb_rows);
+
+  if (pf->sb_rows > pf->lf_alloc_rows) {
+    aom_free(pf->lf_row_done);
+    pf->lf_alloc_rows = 0;
+    CHECK_MEM_ERROR(cm, pf->lf_row_done,
+                    aom_malloc(sizeof(*pf->lf_row_done) * pf->sb_rows));
+    pf->lf_alloc_rows = pf->sb_rows;
+  }
+  memset(pf->lf_row_done, 0, sizeof(*pf->lf_row_done) * pf->sb_rows);
+}
+
+#if CONFIG_LOOP_RESTORATION || CONFIG_CLPF
+// Copy rows [row_start, row_end) of 'plane' over their full aligned width.
+static void post_filter_copy_rows(const AV1_COMMON *cm,
+                                  const YV12_BUFFER_CONFIG *src,
+                                  YV12_BUFFER_CONFIG *dst, int plane,
+                                  int row_start, int row_end) {
+  const int width = plane != AOM_PLANE_Y ? src->uv_width : src->y_width;
+  const int src_stride = plane != AOM_PLANE_Y ? src->uv_stride : src->y_stride;
+  const int dst_stride = plane != AOM_PLANE_Y ? dst->uv_stride : dst->y_stride;
+  const uint8_t *src_buf =
+      plane != AOM_PLANE_Y
+          ? (plane == AOM_PLANE_U ? src->u_buffer : src->v_buffer)
+          : src->y_buffer;
+  uint8_t *dst_buf = plane != AOM_PLANE_Y
+                         ? (plane == AOM_PLANE_U ? dst->u_buffer : dst->v_buffer)
+                         : dst->y_buffer;
+  int r;
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (cm->use_highbitdepth) {
+    const uint16_t *src16 = CONVERT_TO_SHORTPTR(src_buf);
+    uint16_t *dst16 = CONVERT_TO_SHORTPTR(dst_buf);
+    for (r = row_start; r < row_end; ++r)
+      memcpy(dst16 + r * dst_stride, src16 + r * src_stride,
+             width * sizeof(*dst16));
+    return;
+  }
+#else
+  (void)cm;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  for (r = row_start; r < row_end; ++r)
+    memcpy(dst_buf + r * dst_stride, src_buf + r * src_stride, width);
+}
+
+#endif  // CONFIG_LOOP_RESTORATION || CONFIG_CLPF
+
+#if CONFIG_LOOP_RESTORATION
+// Clear the part of the restoration output between the cropped and the
+// aligned size of the plane, which the filters do not always write but which
+// is copied back into the frame.
+static void lr_clear_margins(const AV1_COMMON *cm, YV12_BUFFER_CONFIG *buf,
+                             int plane) {
+  const int crop_width =
+      plane != AOM_PLANE_Y ? buf->uv_crop_width : buf->y_crop_width;
+  const int crop_height =
+      plane != AOM_PLANE_Y ? buf->uv_crop_height : buf->y_crop_height;
+  const int width = plane != AOM_PLANE_Y ? buf->uv_width : buf->y_width;
+  const int height = plane != AOM_PLANE_Y ? buf->uv_height : buf->y_height;
+  const int stride = plane != AOM_PLANE_Y ? buf->uv_stride : buf->y_stride;
+#if CONFIG_AOM_HIGHBITDEPTH
+  const int shift = cm->use_highbitdepth;
+#else
+  const int shift = 0;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  uint8_t *data = plane != AOM_PLANE_Y
+                      ? (plane == AOM_PLANE_U ? buf->u_buffer : buf->v_buffer)
+                      : buf->y_buffer;
+  int r;
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (cm->use_highbitdepth) data = (uint8_t *)CONVERT_TO_SHORTPTR(data);
+#else
+  (void)cm;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  for (r = 0; r < crop_height; ++r)
+    memset(data + ((r * stride + crop_width) << shift), 0,
+           (width - crop_width) << shift);
+  for (r = crop_height; r < height; ++r)
+    memset(data + ((r * stride) << shift), 0, width << shift);
+}
+
+// Write back the restored bands that no tile still reads, and make the tiles
+// of the bands whose input is final available for restoration. A band is
+// written back into the frame once the bands on both sides of it have been
+// restored from the unrestored pixels.
+static int post_filter_lr(AV1PostFilterSync *pf, int in) {
+  AV1_COMMON *const cm = pf->cm;
+  int out = in;
+  int plane;
+
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    const int ss_y = plane != AOM_PLANE_Y ? cm->subsampling_y : 0;
+    const int height = ROUND_POWER_OF_TWO(cm->height, ss_y);
+    const int aligned_height =
+        plane != AOM_PLANE_Y ? pf->frame->uv_height : pf->frame->y_height;
+    const int nbands = pf->lr_bands[plane];
+    const int band_height = pf->lr_band_height[plane];
+    int done, band;
+
+    if (cm->rst_info[plane].frame_restoration_type == RESTORE_NONE) continue;
+
+    POST_FILTER_LOCK(pf);
+    done = pf->lr_done[plane];
+    POST_FILTER_UNLOCK(pf);
+    while (pf->lr_copied[plane] < done - 1 ||
+           (done == nbands && pf->lr_copied[plane] < nbands)) {
+      band = pf->lr_copied[plane];
+      post_filter_copy_rows(cm, &pf->lr_dst, pf->frame, plane,
+                            band * band_height,
+                            band == nbands - 1 ? aligned_height
+                                               : (band + 1) * band_height);
+      ++pf->lr_copied[plane];
+    }
+
+    for (band = pf->lr_issued[plane]; band < nbands; ++band) {
+      const int v_end = band < nbands - 1 ? (band + 1) * band_height : height;
+      const int last = v_end + RESTORATION_BAND_LOOKAHEAD >= height;
+      if (in < (last ? pf->end_rows
+                     : (v_end + RESTORATION_BAND_LOOKAHEAD) << ss_y))
+        break;
+    }
+    if (band > pf->lr_issued[plane]) {
+      // The tiles read the rows next to the band as well, so those are
+      // extended before any of its tiles are restored. Rows below the last
+      // band made available are not read by any tile being restored.
+      const int v_end = band < nbands ? band * band_height : height;
+      const int row_end = AOMMIN(height, v_end + WIENER_HALFWIN);
+      av1_loop_restoration_extend_rows(pf->frame, cm, cm->rst_info, plane,
+                                       pf->lr_extended_rows[plane], row_end);
+      pf->lr_extended_rows[plane] = row_end;
+      POST_FILTER_LOCK(pf);
+      pf->lr_issued[plane] = band;
+      POST_FILTER_UNLOCK(pf);
+    }
+
+    if (pf->lr_copied[plane] < nbands)
+      out = AOMMIN(out, (pf->lr_copied[plane] * band_height) << ss_y);
+  }
+  return out;
+}
+
+// Restore the available restoration tiles for as long as there is a free
+// scratch buffer. Called and returns with the mutex held.
+static int post_filter_lr_tiles_locked(AV1PostFilterSync *pf) {
+  int ran = 0;
+  while (pf->lr_num_free_tmpbufs > 0) {
+    int32_t *tmpbuf;
+    int plane, tile, band;
+    for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      if (pf->lr_next_tile[plane] <
+          pf->lr_issued[plane] * pf->lr_band_tiles[plane])
+        break;
+    }
+    if (plane == MAX_MB_PLANE) break;
+    tile = pf->lr_next_tile[plane]++;
+    tmpbuf = pf->lr_free_tmpbuf[--pf->lr_num_free_tmpbufs];
+    POST_FILTER_UNLOCK(pf);
+    av1_loop_restoration_tile(pf->frame, pf->cm, pf->cm->rst_info, plane, tile,
+                              tmpbuf, &pf->lr_dst);
+    POST_FILTER_LOCK(pf);
+    pf->lr_free_tmpbuf[pf->lr_num_free_tmpbufs++] = tmpbuf;
+    band = tile / pf->lr_band_tiles[plane];
+    if (++pf->lr_tiles_done[plane][band] == pf->lr_band_tiles[plane]) {
+      while (pf->lr_done[plane] < pf->lr_bands[plane] &&
+             pf->lr_tiles_done[plane][pf->lr_done[plane]] ==
+                 pf->lr_band_tiles[plane]) {
+        ++pf->lr_done[plane];
+        pf->pending[POST_FILTER_LR] = 1;
+      }
+    }
+    ran = 1;
+  }
+  return ran;
+}
+
+// Allocate the per-band tile counters and one restoration scratch buffer per
+// thread that can run the pipeline.
+static void lr_alloc(AV1PostFilterSync *pf, AV1_COMMON *cm, int max_threads) {
+  int nbands = 0;
+  int plane;
+
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) nbands += pf->lr_bands[plane];
+  if (nbands > pf->lr_alloc_bands) {
+    aom_free(pf->lr_tiles_done_buf);
+    pf->lr_alloc_bands = 0;
+    CHECK_MEM_ERROR(cm, pf->lr_tiles_done_buf,
+                    aom_malloc(sizeof(*pf->lr_tiles_done_buf) * nbands));
+    pf->lr_alloc_bands = nbands;
+  }
+  memset(pf->lr_tiles_done_buf, 0, sizeof(*pf->lr_tiles_done_buf) * nbands);
+  nbands = 0;
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    pf->lr_tiles_done[plane] = pf->lr_tiles_done_buf + nbands;
+    nbands += pf->lr_bands[plane];
+  }
+
+  if (max_threads > pf->lr_num_tmpbufs || pf->lr_free_tmpbuf == NULL) {
+    int32_t **tmpbuf;
+    int i;
+    CHECK_MEM_ERROR(cm, tmpbuf,
+                    aom_realloc(pf->lr_tmpbuf, sizeof(*tmpbuf) * max_threads));
+    pf->lr_tmpbuf = tmpbuf;
+    aom_free(pf->lr_free_tmpbuf);
+    CHECK_MEM_ERROR(cm, pf->lr_free_tmpbuf,
+                    aom_malloc(sizeof(*pf->lr_free_tmpbuf) * max_threads));
+    for (i = pf->lr_num_tmpbufs; i < max_threads; ++i) {
+      CHECK_MEM_ERROR(cm, pf->lr_tmpbuf[i],
+                      (int32_t *)aom_malloc(RESTORATION_TMPBUF_SIZE));
+      ++pf->lr_num_tmpbufs;
+    }
+  }
+  memcpy(pf->lr_free_tmpbuf, pf->lr_tmpbuf,
+         sizeof(*pf->lr_free_tmpbuf) * pf->lr_num_tmpbufs);
+  pf->lr_num_free_tmpbufs = pf->lr_num_tmpbufs;
+}
+#endif  // CONFIG_LOOP_RESTORATION
+
+#if CONFIG_DERING
+// Make the superblock rows whose input, including the lines below the
+// superblocks that the filter reads, is final available for deringing. The
+// lines around the bottom edge of a row are saved first, as neither the row
+// nor the one below it may be deringed before then.
+static int post_filter_dering(AV1PostFilterSync *pf, int in) {
+  AV1_COMMON *const cm = pf->cm;
+  const int nvsb = pf->dering_sb_rows;
+  const int sb_rows_px = MAX_MIB_SIZE << MI_SIZE_LOG2;
+  // Lines below a superblock row boundary that are saved with it.
+  const int margin = 16;
+  int sb_row = pf->dering_issued;
+  int done;
+
+  if (!pf->dering_enabled) return in;
+  while (sb_row < nvsb &&
+         in >= (sb_row == nvsb - 1 ? pf->end_rows
+                                   : (sb_row + 1) * sb_rows_px + margin)) {
+    if (sb_row + 1 < nvsb)
+      av1_dering_save_lines(cm, pf->dering_planes, &pf->dering_state,
+                            sb_row + 1);
+    ++sb_row;
+  }
+  POST_FILTER_LOCK(pf);
+  pf->dering_issued = sb_row;
+  done = pf->dering_done;
+  POST_FILTER_UNLOCK(pf);
+  return done == nvsb ? pf->end_rows : done * sb_rows_px;
+}
+
+// Dering the available superblock rows. Called and returns with the mutex
+// held.
+static int post_filter_dering_rows_locked(AV1PostFilterSync *pf) {
+  int ran = 0;
+  while (pf->dering_next_row < pf->dering_issued) {
+    const int sb_row = pf->dering_next_row++;
+    POST_FILTER_UNLOCK(pf);
+    av1_dering_sb_row(pf->cm, pf->dering_planes, pf->dering_level,
+                      &pf->dering_state, sb_row);
+    POST_FILTER_LOCK(pf);
+    pf->dering_row_done[sb_row] = 1;
+    while (pf->dering_done < pf->dering_sb_rows &&
+           pf->dering_row_done[pf->dering_done]) {
+      ++pf->dering_done;
+      pf->pending[POST_FILTER_DERING] = 1;
+    }
+    ran = 1;
+  }
+  return ran;
+}
+
+// Prepare the stage for deringing 'frame' at 'global_level'.
+static void dering_init(AV1PostFilterSync *pf, AV1_COMMON *cm,
+                        YV12_BUFFER_CONFIG *frame,
+                        struct macroblockd_plane planes[MAX_MB_PLANE],
+                        int global_level) {
+  pf->dering_level = global_level;
+  pf->dering_sb_rows = (cm->mi_rows + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE;
+  pf->dering_issued = 0;
+  pf->dering_next_row = 0;
+  pf->dering_done = 0;
+  if (pf->dering_state.nhsb !=
+          (cm->mi_cols + MAX_MIB_SIZE - 1) / MAX_MIB_SIZE ||
+      pf->dering_state.nvsb != pf->dering_sb_rows) {
+    av1_dering_row_state_free(&pf->dering_state);
+    if (!av1_dering_row_state_alloc(&pf->dering_state, cm)) {
+      av1_dering_row_state_free(&pf->dering_state);
+      aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                         "Failed to allocate dering line buffers");
+    }
+  }
+  if (pf->dering_sb_rows > pf->dering_alloc_rows) {
+    aom_free(pf->dering_row_done);
+    pf->dering_alloc_rows = 0;
+    CHECK_MEM_ERROR(
+        cm, pf->dering_row_done,
+        aom_malloc(sizeof(*pf->dering_row_done) * pf->dering_sb_rows));
+    pf->dering_alloc_rows = pf->dering_sb_rows;
+  }
+  memset(pf->dering_row_done, 0,
+         sizeof(*pf->dering_row_done) * pf->dering_sb_rows);
+  memcpy(pf->dering_planes, planes, sizeof(pf->dering_planes));
+  av1_setup_dst_planes(pf->dering_planes, frame, 0, 0);
+}
+#endif  // CONFIG_DERING
+
+#if CONFIG_CLPF
+static int clpf_signaled_bit(UNUSED int k, UNUSED int l,
+                             UNUSED const YV12_BUFFER_CONFIG *rec,
+                             UNUSED const YV12_BUFFER_CONFIG *org,
+                             UNUSED const AV1_COMMON *cm,
+                             UNUSED int block_size, UNUSED int w, UNUSED int h,
+                             UNUSED unsigned int strength,
+                             UNUSED unsigned int fb_size_log2, int8_t *bit) {
+  return *bit;
+}
+
+static INLINE int clpf_fb_size_log2(const AV1_COMMON *cm, int plane) {
+  return plane == AOM_PLANE_Y ? 4 + cm->clpf_size : 4;
+}
+
+// Copy the rows of the input that are final, and make the rows of filter
+// blocks whose pixels, and the lines below them that the filter reads, are
+// copied available for filtering.
+static int post_filter_clpf(AV1PostFilterSync *pf, int in) {
+  AV1_COMMON *const cm = pf->cm;
+  int out = in;
+  int plane;
+
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    const int ss_y = plane != AOM_PLANE_Y ? cm->subsampling_y : 0;
+    const int fb_size_log2 = pf->clpf_fb_size_log2[plane];
+    const int height = plane != AOM_PLANE_Y ? pf->frame->uv_crop_height
+                                            : pf->frame->y_crop_height;
+    const int aligned_height =
+        plane != AOM_PLANE_Y ? pf->frame->uv_height : pf->frame->y_height;
+    const int rows = in == pf->end_rows ? aligned_height : in >> ss_y;
+    const int nfb = pf->clpf_fb_rows[plane];
+    int fb_row = pf->clpf_issued[plane];
+    int done;
+
+    if (!pf->clpf_strength[plane]) continue;
+    if (rows > pf->clpf_copied[plane]) {
+      post_filter_copy_rows(cm, pf->frame, &pf->clpf_src, plane,
+                            pf->clpf_copied[plane], rows);
+      pf->clpf_copied[plane] = rows;
+    }
+    while (fb_row < nfb &&
+           rows >= AOMMIN(height, ((fb_row + 1) << fb_size_log2) + 2))
+      ++fb_row;
+    POST_FILTER_LOCK(pf);
+    pf->clpf_issued[plane] = fb_row;
+    done = pf->clpf_done[plane];
+    POST_FILTER_UNLOCK(pf);
+    if (done < nfb) out = AOMMIN(out, (done << fb_size_log2) << ss_y);
+  }
+  return out;
+}
+
+// Filter the available filter block rows. Called and returns with the mutex
+// held.
+static int post_filter_clpf_rows_locked(AV1PostFilterSync *pf) {
+  int ran = 0;
+  for (;;) {
+    int plane, fb_row;
+    for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      if (pf->clpf_next_row[plane] < pf->clpf_issued[plane]) break;
+    }
+    if (plane == MAX_MB_PLANE) break;
+    fb_row = pf->clpf_next_row[plane]++;
+    POST_FILTER_UNLOCK(pf);
+    av1_clpf_rows(pf->frame, &pf->clpf_src, pf->clpf_org, pf->cm,
+                  pf->clpf_enable_fb_flag[plane], pf->clpf_strength[plane],
+                  pf->clpf_fb_size_log2[plane], plane,
+                  pf->clpf_decision[plane], NULL, fb_row, fb_row + 1);
+    POST_FILTER_LOCK(pf);
+    pf->clpf_row_done[plane][fb_row] = 1;
+    while (pf->clpf_done[plane] < pf->clpf_fb_rows[plane] &&
+           pf->clpf_row_done[plane][pf->clpf_done[plane]]) {
+      ++pf->clpf_done[plane];
+      pf->pending[POST_FILTER_CLPF] = 1;
+    }
+    ran = 1;
+  }
+  return ran;
+}
+
+// Prepare the stage for filtering 'plane' of pf->frame, or for leaving it
+// alone if 'strength' is 0.
+static void clpf_init_plane(AV1PostFilterSync *pf, int plane,
+                            unsigned int strength, unsigned int fb_size_log2,
+                            int enable_fb_flag, ClpfDecisionFunc decision) {
+  const int height = plane != AOM_PLANE_Y ? pf->frame->uv_crop_height
+                                          : pf->frame->y_crop_height;
+  pf->clpf_strength[plane] = strength;
+  pf->clpf_fb_size_log2[plane] = fb_size_log2;
+  pf->clpf_enable_fb_flag[plane] = enable_fb_flag;
+  pf->clpf_decision[plane] = decision;
+  pf->clpf_fb_rows[plane] = strength
+                                ? (height + (1 << fb_size_log2) - 1) >>
+                                      fb_size_log2
+                                : 0;
+  pf->clpf_copied[plane] = 0;
+  pf->clpf_issued[plane] = 0;
+  pf->clpf_next_row[plane] = 0;
+  pf->clpf_done[plane] = 0;
+}
+
+// Allocate the copy the rows are filtered from and the flags of the rows of
+// the planes set up with clpf_init_plane().
+static void clpf_alloc(AV1PostFilterSync *pf, AV1_COMMON *cm) {
+  int nrows = 0;
+  int plane;
+
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane)
+    nrows += pf->clpf_fb_rows[plane];
+  if (!nrows) return;
+  if (nrows > pf->clpf_alloc_rows) {
+    aom_free(pf->clpf_row_done_buf);
+    pf->clpf_alloc_rows = 0;
+    CHECK_MEM_ERROR(cm, pf->clpf_row_done_buf,
+                    aom_malloc(sizeof(*pf->clpf_row_done_buf) * nrows));
+    pf->clpf_alloc_rows = nrows;
+  }
+  memset(pf->clpf_row_done_buf, 0, sizeof(*pf->clpf_row_done_buf) * nrows);
+  nrows = 0;
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    pf->clpf_row_done[plane] = pf->clpf_row_done_buf + nrows;
+    nrows += pf->clpf_fb_rows[plane];
+  }
+
+  if (aom_realloc_frame_buffer(&pf->clpf_src, cm->width, cm->height,
+                               cm->subsampling_x, cm->subsampling_y,
+#if CONFIG_AOM_HIGHBITDEPTH
+                               cm->use_highbitdepth,
+#endif
+                               AOM_BORDER_IN_PIXELS, cm->byte_alignment, NULL,
+                               NULL, NULL) < 0)
+    aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                       "Failed to allocate clpf src buffer");
+}
+#endif  // CONFIG_CLPF
+
+// Whether the stage has work left that does not depend on new input.
+static int post_filter_stage(AV1PostFilterSync *pf, int stage, int in) {
+  switch (stage) {
+    case POST_FILTER_LF: return post_filter_lf(pf, in);
+#if CONFIG_LOOP_RESTORATION
+    case POST_FILTER_LR: return post_filter_lr(pf, in);
+#endif  // CONFIG_LOOP_RESTORATION
+#if CONFIG_DERING
+    case POST_FILTER_DERING: return post_filter_dering(pf, in);
+#endif  // CONFIG_DERING
+#if CONFIG_CLPF
+    case POST_FILTER_CLPF: return post_filter_clpf(pf, in);
+#endif  // CONFIG_CLPF
+    default: return in;
+  }
+}
+
+// Run every stage that is idle and has new input. Called and returns with the
+// mutex held. A stage rechecks its input before it is released, so rows
+// published by other threads while it runs are never missed.
+static void post_filter_run_locked(AV1PostFilterSync *pf) {
+  int advanced;
+  do {
+    int stage;
+    advanced = 0;
+    for (stage = 0; stage < POST_FILTER_STAGES; ++stage) {
+      if (pf->busy[stage]) continue;
+      pf->busy[stage] = 1;
+      while (post_filter_input(pf, stage) > pf->input_rows[stage] ||
+             pf->pending[stage]) {
+        const int in = post_filter_input(pf, stage);
+        int out;
+        pf->input_rows[stage] = in;
+        pf->pending[stage] = 0;
+        POST_FILTER_UNLOCK(pf);
+        out = post_filter_stage(pf, stage, in);
+        POST_FILTER_LOCK(pf);
+        pf->output_rows[stage] = out;
+        advanced = 1;
+      }
+      pf->busy[stage] = 0;
+    }
+#if CONFIG_MULTITHREAD
+    // Wake the waiting workers up before running the rows the stages have
+    // just issued, so that they share them.
+    if (advanced) pthread_cond_broadcast(pf->cond_);
+#endif  // CONFIG_MULTITHREAD
+    advanced |= post_filter_lf_rows_locked(pf);
+#if CONFIG_LOOP_RESTORATION
+    advanced |= post_filter_lr_tiles_locked(pf);
+#endif  // CONFIG_LOOP_RESTORATION
+#if CONFIG_DERING
+    advanced |= post_filter_dering_rows_locked(pf);
+#endif  // CONFIG_DERING
+#if CONFIG_CLPF
+    advanced |= post_filter_clpf_rows_locked(pf);
+#endif  // CONFIG_CLPF
+#if CONFIG_MULTITHREAD
+    if (advanced) pthread_cond_broadcast(pf->cond_);
+#endif  // CONFIG_MULTITHREAD
+  } while (advanced);
+}
+
+static void post_filter_alloc_sync(AV1PostFilterSync *pf, AV1_COMMON *cm) {
+#if CONFIG_MULTITHREAD
+  if (pf->mutex_ == NULL) {
+    CHECK_MEM_ERROR(cm, pf->mutex_, aom_malloc(sizeof(*pf->mutex_)));
+    pthread_mutex_init(pf->mutex_, NULL);
+  }
+  if (pf->cond_ == NULL) {
+    CHECK_MEM_ERROR(cm, pf->cond_, aom_malloc(sizeof(*pf->cond_)));
+    pthread_cond_init(pf->cond_, NULL);
+  }
+#else
+  (void)pf;
+  (void)cm;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void av1_post_filter_init(AV1PostFilterSync *pf, YV12_BUFFER_CONFIG *frame,
+                          AV1_COMMON *cm,
+                          struct macroblockd_plane planes[MAX_MB_PLANE],
+                          int row_cols, int max_threads) {
+  const int sb_rows = (cm->mi_rows + cm->mib_size - 1) >> cm->mib_size_log2;
+  int i;
+
+  post_filter_alloc_sync(pf, cm);
+
+  if (sb_rows > pf->alloc_sb_rows) {
+    aom_free(pf->sb_row_cols_done);
+    pf->alloc_sb_rows = 0;
+    CHECK_MEM_ERROR(
+        cm, pf->sb_row_cols_done,
+        aom_malloc(sizeof(*pf->sb_row_cols_done) * sb_rows));
+    pf->alloc_sb_rows = sb_rows;
+  }
+  memset(pf->sb_row_cols_done, 0, sizeof(*pf->sb_row_cols_done) * sb_rows);
+
+  pf->cm = cm;
+  pf->frame = frame;
+  pf->row_cols = row_cols;
+  pf->sb_rows = sb_rows;
+  pf->recon_sb_rows = 0;
+  pf->recon_rows = 0;
+  pf->end_rows = cm->mi_rows << MI_SIZE_LOG2;
+  for (i = 0; i < POST_FILTER_STAGES; ++i) {
+    pf->input_rows[i] = 0;
+    pf->output_rows[i] = 0;
+    pf->busy[i] = 0;
+    pf->pending[i] = 0;
+  }
+
+  pf->lf_enabled = cm->lf.filter_level && !cm->skip_loop_filter;
+  pf->lf_mi_row = 0;
+  memcpy(pf->lf_planes, planes, sizeof(pf->lf_planes));
+  // The row-based multi-threaded loopfilter does not support the extended
+  // coding unit size.
+  pf->lf_mt = pf->lf_enabled && max_threads > 1 && !CONFIG_EXT_PARTITION;
+  pf->lf_issued = 0;
+  pf->lf_next_row = 0;
+  pf->lf_done = 0;
+  pf->lf_pass = 0;
+  if (pf->lf_mt) lf_alloc(pf, cm, max_threads);
+
+#if CONFIG_LOOP_RESTORATION
+  {
+    int restored = 0;
+    for (i = 0; i < MAX_MB_PLANE; ++i) {
+      const int ss_x = i != AOM_PLANE_Y ? cm->subsampling_x : 0;
+      const int ss_y = i != AOM_PLANE_Y ? cm->subsampling_y : 0;
+      pf->lr_bands[i] = 0;
+      pf->lr_band_tiles[i] = 0;
+      pf->lr_issued[i] = 0;
+      pf->lr_next_tile[i] = 0;
+      pf->lr_done[i] = 0;
+      pf->lr_copied[i] = 0;
+      pf->lr_extended_rows[i] = 0;
+      if (cm->rst_info[i].frame_restoration_type == RESTORE_NONE) continue;
+      av1_get_rest_ntiles(ROUND_POWER_OF_TWO(cm->width, ss_x),
+                          ROUND_POWER_OF_TWO(cm->height, ss_y), NULL,
+                          &pf->lr_band_height[i], &pf->lr_band_tiles[i],
+                          &pf->lr_bands[i]);
+      restored = 1;
+    }
+    if (restored) {
+      lr_alloc(pf, cm, AOMMAX(1, max_threads));
+      if (aom_realloc_frame_buffer(
+              &pf->lr_dst, cm->width, cm->height, cm->subsampling_x,
+              cm->subsampling_y,
+#if CONFIG_AOM_HIGHBITDEPTH
+              cm->use_highbitdepth,
+#endif
+              AOM_BORDER_IN_PIXELS, cm->byte_alignment, NULL, NULL, NULL) < 0)
+        aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                           "Failed to allocate restoration dst buffer");
+      for (i = 0; i < MAX_MB_PLANE; ++i) {
+        if (cm->rst_info[i].frame_restoration_type != RESTORE_NONE)
+          lr_clear_margins(cm, &pf->lr_dst, i);
+      }
+    }
+  }
+#endif  // CONFIG_LOOP_RESTORATION
+
+#if CONFIG_DERING
+  pf->dering_enabled = cm->dering_level && !cm->skip_loop_filter;
+  pf->dering_issued = 0;
+  pf->dering_next_row = 0;
+  if (pf->dering_enabled)
+    dering_init(pf, cm, frame, planes, cm->dering_level);
+#endif  // CONFIG_DERING
+
+#if CONFIG_CLPF
+  {
+    const int strength[MAX_MB_PLANE] = { cm->clpf_strength_y,
+                                         cm->clpf_strength_u,
+                                         cm->clpf_strength_v };
+    pf->clpf_org = NULL;
+    for (i = 0; i < MAX_MB_PLANE; ++i) {
+      const int enable_fb_flag =
+          i == AOM_PLANE_Y && cm->clpf_size != CLPF_NOSIZE;
+      const int plane_strength = cm->skip_loop_filter ? 0 : strength[i];
+      clpf_init_plane(pf, i, plane_strength + (plane_strength == 3),
+                      clpf_fb_size_log2(cm, i), enable_fb_flag,
+                      enable_fb_flag ? clpf_signaled_bit : NULL);
+    }
+    clpf_alloc(pf, cm);
+  }
+#endif  // CONFIG_CLPF
+}
+
+int av1_post_filter_sb_row_done(AV1PostFilterSync *pf, int sb_row) {
+  int advanced = 0;
+  POST_FILTER_LOCK(pf);
+  if (++pf->sb_row_cols_done[sb_row] == pf->row_cols) {
+    while (pf->recon_sb_rows < pf->sb_rows &&
+           pf->sb_row_cols_done[pf->recon_sb_rows] >= pf->row_cols) {
+      ++pf->recon_sb_rows;
+      advanced = 1;
+    }
+    pf->recon_rows =
+        pf->recon_sb_rows == pf->sb_rows
+            ? pf->end_rows
+            : pf->recon_sb_rows << (pf->cm->mib_size_log2 + MI_SIZE_LOG2);
+    // The rows the last superblock row makes available are left to
+    // av1_post_filter_finish(), which shares them across all the workers.
+    if (pf->recon_sb_rows == pf->sb_rows) advanced = 0;
+  }
+  POST_FILTER_UNLOCK(pf);
+  return advanced;
+}
+
+int av1_post_filter_run(AV1PostFilterSync *pf, void *unused) {
+  (void)unused;
+  POST_FILTER_LOCK(pf);
+  post_filter_run_locked(pf);
+  POST_FILTER_UNLOCK(pf);
+  return 1;
+}
+
+// Run the pipeline until every stage has filtered the whole frame. Can be used
+// as an AVxWorkerHook.
+static int post_filter_run_to_end(AV1PostFilterSync *pf, void *unused) {
+  (void)unused;
+  POST_FILTER_LOCK(pf);
+  for (;;) {
+    int done = 1;
+    int stage;
+    post_filter_run_locked(pf);
+    for (stage = 0; stage < POST_FILTER_STAGES; ++stage)
+      done &= !pf->busy[stage] && pf->output_rows[stage] == pf->end_rows;
+    if (done) break;
+#if CONFIG_MULTITHREAD
+    pthread_cond_wait(pf->cond_, pf->mutex_);
+#endif  // CONFIG_MULTITHREAD
+  }
+  POST_FILTER_UNLOCK(pf);
+  return 1;
+}
+
+void av1_post_filter_finish(AV1PostFilterSync *pf, AVxWorker *workers,
+                            int num_workers) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  int i;
+
+  POST_FILTER_LOCK(pf);
+  pf->recon_sb_rows = pf->sb_rows;
+  pf->recon_rows = pf->end_rows;
+  POST_FILTER_UNLOCK(pf);
+
+  for (i = 0; i < num_workers; ++i) {
+    AVxWorker *const worker = &workers[i];
+    worker->hook = (AVxWorkerHook)post_filter_run_to_end;
+    worker->data1 = pf;
+    worker->data2 = NULL;
+    winterface->launch(worker);
+  }
+  post_filter_run_to_end(pf, NULL);
+  for (i = 0; i < num_workers; ++i) winterface->sync(&workers[i]);
+}
+
+int av1_post_filter_rows_done(AV1PostFilterSync *pf) {
+  int rows;
+  POST_FILTER_LOCK(pf);
+  rows = pf->output_rows[POST_FILTER_STAGES - 1];
+  POST_FILTER_UNLOCK(pf);
+  return rows;
+}
+
+#if CONFIG_DERING || CONFIG_CLPF
+// Run 'hook' in every worker, the last one in this thread, and wait for them.
+static void post_filter_run_workers(AV1PostFilterSync *pf, AVxWorkerHook hook,
+                                    AVxWorker *workers, int num_workers) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  int i;
+
+  for (i = 0; i < num_workers; ++i) {
+    AVxWorker *const worker = &workers[i];
+    worker->hook = hook;
+    worker->data1 = pf;
+    worker->data2 = NULL;
+    if (i == num_workers - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+  for (i = 0; i < num_workers; ++i) winterface->sync(&workers[i]);
+}
+#endif  // CONFIG_DERING || CONFIG_CLPF
+
+#if CONFIG_DERING
+static int dering_rows_worker(AV1PostFilterSync *pf, void *unused) {
+  (void)unused;
+  POST_FILTER_LOCK(pf);
+  post_filter_dering_rows_locked(pf);
+  POST_FILTER_UNLOCK(pf);
+  return 1;
+}
+
+void av1_dering_frame_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                         struct macroblockd_plane planes[MAX_MB_PLANE],
+                         int global_level, AVxWorker *workers,
+                         int num_workers, AV1PostFilterSync *pf) {
+  int sb_row;
+
+  post_filter_alloc_sync(pf, cm);
+  pf->cm = cm;
+  pf->frame = frame;
+  dering_init(pf, cm, frame, planes, global_level);
+  // With the lines around every row edge saved up front, the rows can be
+  // deringed in any order.
+  for (sb_row = 1; sb_row < pf->dering_sb_rows; ++sb_row)
+    av1_dering_save_lines(cm, pf->dering_planes, &pf->dering_state, sb_row);
+  pf->dering_issued = pf->dering_sb_rows;
+  post_filter_run_workers(pf, (AVxWorkerHook)dering_rows_worker, workers,
+                          num_workers);
+}
+#endif  // CONFIG_DERING
+
+#if CONFIG_CLPF
+static int clpf_rows_worker(AV1PostFilterSync *pf, void *unused) {
+  (void)unused;
+  POST_FILTER_LOCK(pf);
+  post_filter_clpf_rows_locked(pf);
+  POST_FILTER_UNLOCK(pf);
+  return 1;
+}
+
+void av1_clpf_frame_mt(YV12_BUFFER_CONFIG *frame,
+                       const YV12_BUFFER_CONFIG *org, AV1_COMMON *cm,
+                       int enable_fb_flag, unsigned int strength,
+                       unsigned int fb_size_log2, int plane,
+                       ClpfDecisionFunc decision, AVxWorker *workers,
+                       int num_workers, AV1PostFilterSync *pf) {
+  int i;
+
+  post_filter_alloc_sync(pf, cm);
+  pf->cm = cm;
+  pf->frame = frame;
+  pf->clpf_org = org;
+  for (i = 0; i < MAX_MB_PLANE; ++i) {
+    if (i == plane)
+      clpf_init_plane(pf, i, strength, fb_size_log2, enable_fb_flag, decision);
+    else
+      clpf_init_plane(pf, i, 0, 0, 0, NULL);
+  }
+  clpf_alloc(pf, cm);
+  pf->clpf_copied[plane] =
+      plane != AOM_PLANE_Y ? frame->uv_height : frame->y_height;
+  post_filter_copy_rows(cm, frame, &pf->clpf_src, plane, 0,
+                        pf->clpf_copied[plane]);
+  pf->clpf_issued[plane] = pf->clpf_fb_rows[plane];
+  post_filter_run_workers(pf, (AVxWorkerHook)clpf_rows_worker, workers,
+                          num_workers);
+}
+#endif  // CONFIG_CLPF
+
+void av1_post_filter_dealloc(AV1PostFilterSync *pf) {
+  if (pf != NULL) {
+#if CONFIG_LOOP_RESTORATION
+    int i;
+#endif  // CONFIG_LOOP_RESTORATION
+#if CONFIG_MULTITHREAD
+    if (pf->mutex_ != NULL) {
+      pthread_mutex_destroy(pf->mutex_);
+      aom_free(pf->mutex_);
+    }
+    if (pf->cond_ != NULL) {
+      pthread_cond_destroy(pf->cond_);
+      aom_free(pf->cond_);
+    }
+#endif  // CONFIG_MULTITHREAD
+    aom_free(pf->sb_row_cols_done);
+    av1_loop_filter_dealloc(&pf->lf_sync);
+    aom_free(pf->lf_free_data);
+    aom_free(pf->lf_row_done);
+#if CONFIG_LOOP_RESTORATION
+    for (i = 0; i < pf->lr_num_tmpbufs; ++i) aom_free(pf->lr_tmpbuf[i]);
+    aom_free(pf->lr_tmpbuf);
+    aom_free(pf->lr_free_tmpbuf);
+    aom_free(pf->lr_tiles_done_buf);
+    aom_free_frame_buffer(&pf->lr_dst);
+#endif  // CONFIG_LOOP_RESTORATION
+#if CONFIG_DERING
+    av1_dering_row_state_free(&pf->dering_state);
+    aom_free(pf->dering_row_done);
+#endif  // CONFIG_DERING
+#if CONFIG_CLPF
+    aom_free(pf->clpf_row_done_buf);
+    aom_free_frame_buffer(&pf->clpf_src);
+#endif  // CONFIG_CLPF
+    av1_zero(*pf);
+  }
+}
+
 // Accumulate frame counts. FRAME_COUNTS consist solely of 'unsigned int'
 // members, so we treat it as an array, and sum over the whole length.
 void av1_accumulate_frame_counts(FRAME_COUNTS *acc_counts,
@@ -13,6 +13,12 @@
 #define AV1_COMMON_LOOPFILTER_THREAD_H_
 #include "./aom_config.h"
 #include "av1/common/av1_loopfilter.h"
+#if CONFIG_CLPF
+#include "av1/common/clpf.h"
+#endif
+#if CONFIG_DERING
+#include "av1/common/dering.h"
+#endif
 #include "aom_util/aom_thread.h"
 
 #ifdef __cplusplus
@@ -40,6 +46,144 @@ typedef struct AV1LfSyncData {
   int num_workers;
 } AV1LfSync;
 
+// Superblock row synchronization for row-based multi-threading. Each row
+// publishes the index of its last completed superblock column.
+typedef struct AV1RowMTSyncData {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *mutex_;
+  pthread_cond_t *cond_;
+#endif
+  int *cur_sb_col;
+  // Number of superblocks a row is published in, chosen by frame width.
+  int sync_range;
+  int rows;
+} AV1RowMTSync;
+
+// Stages of the in-loop post-filter pipeline, in the order they are applied.
+typedef enum {
+  POST_FILTER_LF,
+  POST_FILTER_LR,
+  POST_FILTER_DERING,
+  POST_FILTER_CLPF,
+  POST_FILTER_STAGES
+} POST_FILTER_STAGE;
+
+// Row-lagged pipeline of the in-loop filters. Each stage runs on a band of
+// rows as soon as the stage before it has finalised the rows the band reads,
+// so that the filters of the top of the frame run while the bottom is still
+// being decoded. Progress is counted in luma pixel rows.
+typedef struct AV1PostFilterSyncData {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *mutex_;
+  pthread_cond_t *cond_;
+#endif
+  struct AV1Common *cm;
+  YV12_BUFFER_CONFIG *frame;
+  // Number of tiles that reconstruct each superblock row, and how many of
+  // them have done so for each row.
+  int row_cols;
+  int *sb_row_cols_done;
+  int sb_rows;
+  int alloc_sb_rows;
+  int recon_sb_rows;
+  int recon_rows;
+  int end_rows;
+  // Rows each stage has filtered up to, and the rows of its output that no
+  // later filtering of the stage can change.
+  int input_rows[POST_FILTER_STAGES];
+  int output_rows[POST_FILTER_STAGES];
+  // Set while a thread runs the stage; each stage runs in one thread at a
+  // time.
+  int busy[POST_FILTER_STAGES];
+  // Set when jobs of the stage finish, for the stage to collect their output.
+  int pending[POST_FILTER_STAGES];
+
+  int lf_enabled;
+  int lf_mi_row;
+  struct macroblockd_plane lf_planes[MAX_MB_PLANE];
+  // With more than one thread, the stage makes superblock rows available and
+  // any thread running the pipeline filters them, each row following the one
+  // above it as in av1_loop_filter_frame_mt(). With CONFIG_VAR_TX or
+  // CONFIG_PARALLEL_DEBLOCKING, the rows only become available once the
+  // whole frame is reconstructed, and with CONFIG_PARALLEL_DEBLOCKING the
+  // vertical edges of every row are filtered before the horizontal ones.
+  int lf_mt;
+  // Rows available, next row to filter and rows filtered from the top, in
+  // the current pass.
+  int lf_issued;
+  int lf_next_row;
+  int lf_done;
+  int lf_pass;
+  unsigned char *lf_row_done;
+  int lf_alloc_rows;
+  AV1LfSync lf_sync;
+  // Thread data of lf_sync that no thread is using.
+  LFWorkerData **lf_free_data;
+  int lf_num_free_data;
+#if CONFIG_LOOP_RESTORATION
+  // Restoration is done in bands of one restoration tile row. The stage makes
+  // the tiles of a band available once its input is final, and any thread
+  // running the pipeline restores them, each with its own scratch buffer.
+  int lr_bands[MAX_MB_PLANE];
+  int lr_band_tiles[MAX_MB_PLANE];
+  int lr_band_height[MAX_MB_PLANE];
+  // Bands whose tiles are available, next tile to restore, bands restored in
+  // full, bands written back into the frame and rows extended into the border.
+  int lr_issued[MAX_MB_PLANE];
+  int lr_next_tile[MAX_MB_PLANE];
+  int lr_done[MAX_MB_PLANE];
+  int lr_copied[MAX_MB_PLANE];
+  int lr_extended_rows[MAX_MB_PLANE];
+  // Restored tiles of each band.
+  int *lr_tiles_done[MAX_MB_PLANE];
+  int *lr_tiles_done_buf;
+  int lr_alloc_bands;
+  int32_t **lr_tmpbuf;
+  int32_t **lr_free_tmpbuf;
+  int lr_num_tmpbufs;
+  int lr_num_free_tmpbufs;
+  YV12_BUFFER_CONFIG lr_dst;
+#endif
+#if CONFIG_DERING
+  // The stage saves the lines around the top edge of each superblock row and
+  // makes the row available once its input is final, and any thread running
+  // the pipeline derings it.
+  int dering_enabled;
+  int dering_level;
+  int dering_sb_rows;
+  // Rows available, next row to dering and rows deringed from the top.
+  int dering_issued;
+  int dering_next_row;
+  int dering_done;
+  unsigned char *dering_row_done;
+  int dering_alloc_rows;
+  DeringRowState dering_state;
+  struct macroblockd_plane dering_planes[MAX_MB_PLANE];
+#endif
+#if CONFIG_CLPF
+  // The stage copies the rows of its input that are final and makes each
+  // filter block row available once the rows it reads are copied. Any thread
+  // running the pipeline filters the rows from the copy into the frame, so
+  // that the rows of every plane are filtered in any order.
+  int clpf_strength[MAX_MB_PLANE];
+  int clpf_fb_size_log2[MAX_MB_PLANE];
+  int clpf_enable_fb_flag[MAX_MB_PLANE];
+  ClpfDecisionFunc clpf_decision[MAX_MB_PLANE];
+  const YV12_BUFFER_CONFIG *clpf_org;
+  int clpf_fb_rows[MAX_MB_PLANE];
+  // Rows copied, filter block rows available, next row to filter and rows
+  // filtered from the top.
+  int clpf_copied[MAX_MB_PLANE];
+  int clpf_issued[MAX_MB_PLANE];
+  int clpf_next_row[MAX_MB_PLANE];
+  int clpf_done[MAX_MB_PLANE];
+  unsigned char *clpf_row_done[MAX_MB_PLANE];
+  unsigned char *clpf_row_done_buf;
+  int clpf_alloc_rows;
+  YV12_BUFFER_CONFIG clpf_src;
+#endif
+} AV1PostFilterSync;
+
 // Allocate memory for loopfilter row synchronization.
 void av1_loop_filter_alloc(AV1LfSync *lf_sync, struct AV1Common *cm, int rows,
                            int width, int num_workers);
@@ -54,6 +198,76 @@ void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, struct AV1Common *cm,
                               int partial_frame, AVxWorker *workers,
                               int num_workers, AV1LfSync *lf_sync);
 
+#if CONFIG_DERING
+// Multi-threaded av1_dering_frame() that uses the tile threads. 'pf' holds the
+// line buffers and the row synchronization between calls.
+void av1_dering_frame_mt(YV12_BUFFER_CONFIG *frame, struct AV1Common *cm,
+                         struct macroblockd_plane planes[MAX_MB_PLANE],
+                         int global_level, AVxWorker *workers,
+                         int num_workers, AV1PostFilterSync *pf);
+#endif
+
+#if CONFIG_CLPF
+// Multi-threaded av1_clpf_frame() that uses the tile threads. 'pf' holds the
+// copy of the plane the rows are filtered from between calls.
+void av1_clpf_frame_mt(YV12_BUFFER_CONFIG *frame,
+                       const YV12_BUFFER_CONFIG *org, struct AV1Common *cm,
+                       int enable_fb_flag, unsigned int strength,
+                       unsigned int fb_size_log2, int plane,
+                       ClpfDecisionFunc decision, AVxWorker *workers,
+                       int num_workers, AV1PostFilterSync *pf);
+#endif
+
+// Allocate memory for row-based multi-threading synchronization.
+void av1_row_mt_sync_mem_alloc(AV1RowMTSync *row_mt_sync, struct AV1Common *cm,
+                               int rows);
+
+// Deallocate row-based multi-threading synchronization related mutex and data.
+void av1_row_mt_sync_mem_dealloc(AV1RowMTSync *row_mt_sync);
+
+// Mark every row as not started.
+void av1_row_mt_sync_reset(AV1RowMTSync *row_mt_sync);
+
+// Wait until the row above has progressed far enough past column c for the
+// above-right superblock of (r, c) to be available.
+void av1_row_mt_sync_read(AV1RowMTSync *const row_mt_sync, int r, int c);
+
+// Wait until row r itself has completed column c.
+void av1_row_mt_sync_wait(AV1RowMTSync *const row_mt_sync, int r, int c);
+
+// Publish that column c of row r is complete.
+void av1_row_mt_sync_write(AV1RowMTSync *const row_mt_sync, int r, int c,
+                           const int sb_cols);
+
+// Prepare the post-filter pipeline for a new frame whose superblock rows are
+// each reconstructed by 'row_cols' tiles, and which is run by up to
+// 'max_threads' threads at a time.
+void av1_post_filter_init(AV1PostFilterSync *pf, YV12_BUFFER_CONFIG *frame,
+                          struct AV1Common *cm,
+                          struct macroblockd_plane planes[MAX_MB_PLANE],
+                          int row_cols, int max_threads);
+
+// Record that one tile has reconstructed superblock row sb_row. Returns 1 when
+// this makes new rows available to the pipeline, except at the end of the
+// frame, whose rows av1_post_filter_finish() filters.
+int av1_post_filter_sb_row_done(AV1PostFilterSync *pf, int sb_row);
+
+// Run the stages that are not already running in another thread for as long
+// as they have input. Can be used as an AVxWorkerHook.
+int av1_post_filter_run(AV1PostFilterSync *pf, void *unused);
+
+// Run the pipeline to the bottom of the frame once every superblock row is
+// reconstructed, waiting for stages running in other threads. The idle
+// 'workers' help with the work that can be shared between threads.
+void av1_post_filter_finish(AV1PostFilterSync *pf, AVxWorker *workers,
+                            int num_workers);
+
+// Number of luma pixel rows at the top of the frame that every stage has
+// filtered, and that no later filtering changes.
+int av1_post_filter_rows_done(AV1PostFilterSync *pf);
+
+void av1_post_filter_dealloc(AV1PostFilterSync *pf);
+
 void av1_accumulate_frame_counts(struct FRAME_COUNTS *acc_counts,
                                  struct FRAME_COUNTS *counts);
 
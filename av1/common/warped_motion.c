@@ -677,6 +677,94 @@ static void highbd_warp_plane_old(WarpedMotionParams *wm, uint8_t *ref8,
   }
 }
 
+// High bitdepth version of av1_warp_affine_c() below. Unlike that function,
+// this one clamps the reference columns explicitly and keeps the output of
+// the horizontal filter at full precision.
+void av1_highbd_warp_affine_c(int32_t *mat, uint16_t *ref, int width,
+                              int height, int stride, uint16_t *pred, int p_col,
+                              int p_row, int p_width, int p_height,
+                              int p_stride, int subsampling_x,
+                              int subsampling_y, int bd, int ref_frm,
+                              int32_t alpha, int32_t beta, int32_t gamma,
+                              int32_t delta) {
+  int32_t tmp[15 * 8];
+  int i, j, k, l, m;
+
+  for (i = p_row; i < p_row + p_height; i += 8) {
+    for (j = p_col; j < p_col + p_width; j += 8) {
+      int32_t x4, y4, ix4, sx4, iy4, sy4;
+      if (subsampling_x)
+        x4 = ROUND_POWER_OF_TWO_SIGNED(
+            mat[2] * 2 * (j + 4) + mat[3] * 2 * (i + 4) + mat[0] +
+                (mat[2] + mat[3] - (1 << WARPEDMODEL_PREC_BITS)) / 2,
+            1);
+      else
+        x4 = mat[2] * (j + 4) + mat[3] * (i + 4) + mat[0];
+
+      if (subsampling_y)
+        y4 = ROUND_POWER_OF_TWO_SIGNED(
+            mat[4] * 2 * (j + 4) + mat[5] * 2 * (i + 4) + mat[1] +
+                (mat[4] + mat[5] - (1 << WARPEDMODEL_PREC_BITS)) / 2,
+            1);
+      else
+        y4 = mat[4] * (j + 4) + mat[5] * (i + 4) + mat[1];
+
+      ix4 = x4 >> WARPEDMODEL_PREC_BITS;
+      sx4 = x4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
+      iy4 = y4 >> WARPEDMODEL_PREC_BITS;
+      sy4 = y4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
+
+      // Horizontal filter
+      for (k = -7; k < 8; ++k) {
+        int iy = iy4 + k;
+        if (iy < 0)
+          iy = 0;
+        else if (iy > height - 1)
+          iy = height - 1;
+
+        for (l = -4; l < 4; ++l) {
+          int ix = ix4 + l;
+          int sx = ROUND_POWER_OF_TWO_SIGNED(sx4 + alpha * l + beta * k,
+                                             WARPEDDIFF_PREC_BITS);
+          const int16_t *coeffs = warped_filter[sx + WARPEDPIXEL_PREC_SHIFTS];
+          int32_t sum = 0;
+          for (m = 0; m < 8; ++m) {
+            if (ix + m - 3 < 0)
+              sum += ref[iy * stride] * coeffs[m];
+            else if (ix + m - 3 > width - 1)
+              sum += ref[iy * stride + width - 1] * coeffs[m];
+            else
+              sum += ref[iy * stride + ix + m - 3] * coeffs[m];
+          }
+          tmp[(k + 7) * 8 + (l + 4)] = sum;
+        }
+      }
+
+      // Vertical filter
+      for (k = -4; k < AOMMIN(4, p_row + p_height - i - 4); ++k) {
+        for (l = -4; l < AOMMIN(4, p_col + p_width - j - 4); ++l) {
+          uint16_t *p =
+              &pred[(i - p_row + k + 4) * p_stride + (j - p_col + l + 4)];
+          int sy = ROUND_POWER_OF_TWO_SIGNED(sy4 + gamma * l + delta * k,
+                                             WARPEDDIFF_PREC_BITS);
+          const int16_t *coeffs = warped_filter[sy + WARPEDPIXEL_PREC_SHIFTS];
+          int32_t sum = 0;
+          for (m = 0; m < 8; ++m) {
+            sum += tmp[(k + m + 4) * 8 + (l + 4)] * coeffs[m];
+          }
+          sum = clip_pixel_highbd(
+              ROUND_POWER_OF_TWO_SIGNED(sum, 2 * WARPEDPIXEL_FILTER_BITS),
+              bd);
+          if (ref_frm)
+            *p = ROUND_POWER_OF_TWO_SIGNED(*p + sum, 1);
+          else
+            *p = sum;
+        }
+      }
+    }
+  }
+}
+
 // Note: For an explanation of the warp algorithm, see the comment
 // above warp_plane()
 static void highbd_warp_plane(WarpedMotionParams *wm, uint8_t *ref8, int width,
@@ -690,17 +778,15 @@ static void highbd_warp_plane(WarpedMotionParams *wm, uint8_t *ref8, int width,
     wm->wmmat[4] = -wm->wmmat[3];
   }
   if (wm->wmtype == ROTZOOM || wm->wmtype == AFFINE) {
-    int32_t tmp[15 * 8];
-    int i, j, k, l, m;
     int32_t *mat = wm->wmmat;
     int32_t alpha, beta, gamma, delta;
 
     if (mat[2] == 0) {
       // assert(0 &&
       //   "Warped motion model is incompatible with new warp filter");
-      warp_plane_old(wm, ref, width, height, stride, pred, p_col, p_row,
-                     p_width, p_height, p_stride, subsampling_x, subsampling_y,
-                     x_scale, y_scale, ref_frm);
+      highbd_warp_plane_old(wm, ref8, width, height, stride, pred8, p_col,
+                            p_row, p_width, p_height, p_stride, subsampling_x,
+                            subsampling_y, x_scale, y_scale, bd, ref_frm);
       return;
     }
 
@@ -709,8 +795,6 @@ static void highbd_warp_plane(WarpedMotionParams *wm, uint8_t *ref8, int width,
     gamma = ((int64_t)mat[4] << WARPEDMODEL_PREC_BITS) / mat[2];
     delta = mat[5] - (((int64_t)mat[3] * mat[4] + (mat[2] / 2)) / mat[2]) -
             (1 << WARPEDMODEL_PREC_BITS);
-    uint16_t *ref = CONVERT_TO_SHORTPTR(ref8);
-    uint16_t *pred = CONVERT_TO_SHORTPTR(pred8);
 
     if ((4 * abs(alpha) + 7 * abs(beta) > (1 << WARPEDMODEL_PREC_BITS)) ||
         (4 * abs(gamma) + 4 * abs(delta) > (1 << WARPEDMODEL_PREC_BITS))) {
@@ -722,79 +806,11 @@ static void highbd_warp_plane(WarpedMotionParams *wm, uint8_t *ref8, int width,
       return;
     }
 
-    for (i = p_row; i < p_row + p_height; i += 8) {
-      for (j = p_col; j < p_col + p_width; j += 8) {
-        int32_t x4, y4, ix4, sx4, iy4, sy4;
-        if (subsampling_x)
-          x4 = ROUND_POWER_OF_TWO_SIGNED(
-              mat[2] * 2 * (j + 4) + mat[3] * 2 * (i + 4) + mat[0] +
-                  (mat[2] + mat[3] - (1 << WARPEDMODEL_PREC_BITS)) / 2,
-              1);
-        else
-          x4 = mat[2] * (j + 4) + mat[3] * (i + 4) + mat[0];
-
-        if (subsampling_y)
-          y4 = ROUND_POWER_OF_TWO_SIGNED(
-              mat[4] * 2 * (j + 4) + mat[5] * 2 * (i + 4) + mat[1] +
-                  (mat[4] + mat[5] - (1 << WARPEDMODEL_PREC_BITS)) / 2,
-              1);
-        else
-          y4 = mat[4] * (j + 4) + mat[5] * (i + 4) + mat[1];
-
-        ix4 = x4 >> WARPEDMODEL_PREC_BITS;
-        sx4 = x4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
-        iy4 = y4 >> WARPEDMODEL_PREC_BITS;
-        sy4 = y4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
-
-        // Horizontal filter
-        for (k = -7; k < 8; ++k) {
-          int iy = iy4 + k;
-          if (iy < 0)
-            iy = 0;
-          else if (iy > height - 1)
-            iy = height - 1;
-
-          for (l = -4; l < 4; ++l) {
-            int ix = ix4 + l;
-            int sx = ROUND_POWER_OF_TWO_SIGNED(sx4 + alpha * l + beta * k,
-                                               WARPEDDIFF_PREC_BITS);
-            const int16_t *coeffs = warped_filter[sx + WARPEDPIXEL_PREC_SHIFTS];
-            int32_t sum = 0;
-            for (m = 0; m < 8; ++m) {
-              if (ix + m - 3 < 0)
-                sum += ref[iy * stride] * coeffs[m];
-              else if (ix + m - 3 > width - 1)
-                sum += ref[iy * stride + width - 1] * coeffs[m];
-              else
-                sum += ref[iy * stride + ix + m - 3] * coeffs[m];
-            }
-            tmp[(k + 7) * 8 + (l + 4)] = sum;
-          }
-        }
-
-        // Vertical filter
-        for (k = -4; k < AOMMIN(4, p_row + p_height - i - 4); ++k) {
-          for (l = -4; l < AOMMIN(4, p_col + p_width - j - 4); ++l) {
-            uint16_t *p =
-                &pred[(i - p_row + k + 4) * p_stride + (j - p_col + l + 4)];
-            int sy = ROUND_POWER_OF_TWO_SIGNED(sy4 + gamma * l + delta * k,
-                                               WARPEDDIFF_PREC_BITS);
-            const int16_t *coeffs = warped_filter[sy + WARPEDPIXEL_PREC_SHIFTS];
-            int32_t sum = 0;
-            for (m = 0; m < 8; ++m) {
-              sum += tmp[(k + m + 4) * 8 + (l + 4)] * coeffs[m];
-            }
-            sum = clip_pixel_highbd(
-                ROUND_POWER_OF_TWO_SIGNED(sum, 2 * WARPEDPIXEL_FILTER_BITS),
-                bd);
-            if (ref_frm)
-              *p = ROUND_POWER_OF_TWO_SIGNED(*p + sum, 1);
-            else
-              *p = sum;
-          }
-        }
-      }
-    }
+    av1_highbd_warp_affine(mat, CONVERT_TO_SHORTPTR(ref8), width, height,
+                           stride, CONVERT_TO_SHORTPTR(pred8), p_col, p_row,
+                           p_width, p_height, p_stride, subsampling_x,
+                           subsampling_y, bd, ref_frm, alpha, beta, gamma,
+                           delta);
   } else {
     highbd_warp_plane_old(wm, ref8, width, height, stride, pred8, p_col, p_row,
                           p_width, p_height, p_stride, subsampling_x,
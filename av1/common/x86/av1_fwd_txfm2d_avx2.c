@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "./av1_rtcd.h"
+#include "av1/common/enums.h"
+#include "av1/common/av1_txfm.h"
+#include "av1/common/x86/av1_txfm1d_avx2.h"
+
+static INLINE void load_buffer_int16_avx2(const int16_t *input, int stride,
+                                          __m256i *output, int txfm_size) {
+  const int col_num = txfm_size / 8;
+  int r, c;
+  for (r = 0; r < txfm_size; r++) {
+    for (c = 0; c < col_num; c++) {
+      output[r * col_num + c] = _mm256_cvtepi16_epi32(
+          _mm_loadu_si128((const __m128i *)(input + r * stride + c * 8)));
+    }
+  }
+}
+
+void av1_fwd_txfm2d_64x64_avx2(const int16_t *input, int32_t *output,
+                               int stride, int tx_type, int bd) {
+  DECLARE_ALIGNED(32, int32_t, txfm_buf[2][4096]);
+  const TXFM_2D_FLIP_CFG cfg = av1_get_fwd_txfm_64x64_cfg(tx_type);
+  const int txfm_size = cfg.cfg->txfm_size;
+  const int8_t *shift = cfg.cfg->shift;
+  const int txfm2d_size_256 = txfm_size * txfm_size / 8;
+  __m256i *buf = (__m256i *)txfm_buf[0];
+  __m256i *tmp = (__m256i *)txfm_buf[1];
+  int i;
+  (void)bd;
+
+  // Only DCT_DCT is defined at this size, so there is nothing to flip.
+  load_buffer_int16_avx2(input, stride, buf, txfm_size);
+  round_shift_array_32_avx2(buf, buf, txfm2d_size_256, -shift[0]);
+  av1_fdct64_new_avx2(buf, tmp, cfg.cfg->cos_bit_col,
+                      cfg.cfg->stage_range_col);
+  round_shift_array_32_avx2(tmp, tmp, txfm2d_size_256, -shift[1]);
+  transpose_32_avx2(txfm_size, tmp, buf);
+  av1_fdct64_new_avx2(buf, tmp, cfg.cfg->cos_bit_row,
+                      cfg.cfg->stage_range_row);
+  round_shift_array_32_avx2(tmp, tmp, txfm2d_size_256, -shift[2]);
+  transpose_32_avx2(txfm_size, tmp, buf);
+
+  for (i = 0; i < txfm2d_size_256; i++)
+    _mm256_storeu_si256((__m256i *)output + i, buf[i]);
+}
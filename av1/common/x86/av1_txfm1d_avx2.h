@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_COMMON_X86_AV1_TXFM1D_AVX2_H_
+#define AV1_COMMON_X86_AV1_TXFM1D_AVX2_H_
+
+#include <immintrin.h>
+
+#include "av1/common/av1_txfm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The 1D transforms work like their sse4_1 counterparts: the input is a
+// txfm_size x txfm_size block of 32-bit values, each row held in
+// txfm_size / 8 vectors, and every column of it is transformed.
+void av1_fdct64_new_avx2(const __m256i *input, __m256i *output,
+                         const int8_t *cos_bit, const int8_t *stage_range);
+void av1_idct64_new_avx2(const __m256i *input, __m256i *output,
+                         const int8_t *cos_bit, const int8_t *stage_range);
+
+static INLINE void transpose_32_8x8_avx2(int stride, const __m256i *input,
+                                         __m256i *output) {
+  const __m256i t0 =
+      _mm256_unpacklo_epi32(input[0 * stride], input[1 * stride]);
+  const __m256i t1 =
+      _mm256_unpackhi_epi32(input[0 * stride], input[1 * stride]);
+  const __m256i t2 =
+      _mm256_unpacklo_epi32(input[2 * stride], input[3 * stride]);
+  const __m256i t3 =
+      _mm256_unpackhi_epi32(input[2 * stride], input[3 * stride]);
+  const __m256i t4 =
+      _mm256_unpacklo_epi32(input[4 * stride], input[5 * stride]);
+  const __m256i t5 =
+      _mm256_unpackhi_epi32(input[4 * stride], input[5 * stride]);
+  const __m256i t6 =
+      _mm256_unpacklo_epi32(input[6 * stride], input[7 * stride]);
+  const __m256i t7 =
+      _mm256_unpackhi_epi32(input[6 * stride], input[7 * stride]);
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+  output[0 * stride] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  output[1 * stride] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  output[2 * stride] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  output[3 * stride] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  output[4 * stride] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  output[5 * stride] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  output[6 * stride] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  output[7 * stride] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// Same as transpose_32(), with a grid of 8x8 blocks.
+static INLINE void transpose_32_avx2(int txfm_size, const __m256i *input,
+                                     __m256i *output) {
+  const int num_per_256 = 8;
+  const int row_size = txfm_size;
+  const int col_size = txfm_size / num_per_256;
+  int r, c;
+
+  for (r = 0; r < row_size; r += 8) {
+    for (c = 0; c < col_size; c++) {
+      transpose_32_8x8_avx2(col_size, &input[r * col_size + c],
+                            &output[c * 8 * col_size + r / 8]);
+    }
+  }
+}
+
+static INLINE __m256i round_shift_32_avx2(__m256i vec, int bit) {
+  const __m256i round = _mm256_set1_epi32(1 << (bit - 1));
+  return _mm256_srai_epi32(_mm256_add_epi32(vec, round), bit);
+}
+
+static INLINE void round_shift_array_32_avx2(__m256i *input, __m256i *output,
+                                             const int size, const int bit) {
+  int i;
+  if (bit > 0) {
+    for (i = 0; i < size; i++) output[i] = round_shift_32_avx2(input[i], bit);
+  } else {
+    for (i = 0; i < size; i++) output[i] = _mm256_slli_epi32(input[i], -bit);
+  }
+}
+
+// half_btf() on eight lanes: round_shift(w0 * in0 + w1 * in1, bit), with the
+// products wrapping at 32 bits like the C version.
+static INLINE __m256i half_btf_32_avx2(int32_t w0, __m256i in0, int32_t w1,
+                                       __m256i in1, int bit) {
+  const __m256i x = _mm256_mullo_epi32(in0, _mm256_set1_epi32(w0));
+  const __m256i y = _mm256_mullo_epi32(in1, _mm256_set1_epi32(w1));
+  return round_shift_32_avx2(_mm256_add_epi32(x, y), bit);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // AV1_COMMON_X86_AV1_TXFM1D_AVX2_H_
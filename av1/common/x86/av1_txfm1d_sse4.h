@@ -88,6 +88,14 @@ static INLINE __m128i round_shift_32_sse4_1(__m128i vec, int bit) {
   return _mm_srai_epi32(tmp, bit);
 }
 
+// half_btf() on four lanes: round_shift(w0 * in0 + w1 * in1, bit).
+static INLINE __m128i half_btf_32_sse4_1(int32_t w0, __m128i in0, int32_t w1,
+                                         __m128i in1, int bit) {
+  const __m128i x = _mm_mullo_epi32(in0, _mm_set1_epi32(w0));
+  const __m128i y = _mm_mullo_epi32(in1, _mm_set1_epi32(w1));
+  return round_shift_32_sse4_1(_mm_add_epi32(x, y), bit);
+}
+
 static INLINE void round_shift_array_32_sse4_1(__m128i *input, __m128i *output,
                                                const int size, const int bit) {
   if (bit > 0) {
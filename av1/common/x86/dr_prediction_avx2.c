@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+
+#define DR_LANES 16
+
+typedef __m256i dr_vec;
+
+static INLINE dr_vec dr_load(const uint16_t *p) {
+  return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static INLINE dr_vec dr_set1(int v) { return _mm256_set1_epi16(v); }
+
+// Returns a + (((b - a) * shift + 128) >> 8), with shift given as shift << 7.
+static INLINE dr_vec dr_interp(dr_vec a, dr_vec b, dr_vec shift) {
+  return _mm256_add_epi16(a,
+                          _mm256_mulhrs_epi16(_mm256_sub_epi16(b, a), shift));
+}
+
+// Returns (mask & a) | (~mask & b).
+static INLINE dr_vec dr_blend(dr_vec mask, dr_vec a, dr_vec b) {
+  return _mm256_blendv_epi8(b, a, mask);
+}
+
+// Returns a mask of the lanes i < n.
+static INLINE dr_vec dr_lanes_below(int n) {
+  return _mm256_cmpgt_epi16(
+      _mm256_set1_epi16(n),
+      _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+// Stores the 16 values of v to p[i]; the AVX2 functions only handle blocks
+// that are at least 16 pixels wide.
+static INLINE void dr_store_pixels(void *p, ptrdiff_t i, dr_vec v, int w,
+                                   int hbd) {
+  (void)w;
+  assert(w == DR_LANES);
+  if (hbd) {
+    _mm256_storeu_si256((__m256i *)((uint16_t *)p + i), v);
+  } else {
+    const __m128i lo = _mm256_castsi256_si128(v);
+    const __m128i hi = _mm256_extracti128_si256(v, 1);
+    _mm_storeu_si128((__m128i *)((uint8_t *)p + i), _mm_packus_epi16(lo, hi));
+  }
+}
+
+#include "av1/common/x86/dr_prediction_impl.h"
+
+void av1_dr_prediction_z1_avx2(uint8_t *dst, ptrdiff_t stride, int bs,
+                               const uint8_t *above, const uint8_t *left,
+                               int dx, int dy) {
+  if (bs < DR_LANES) {
+    av1_dr_prediction_z1_sse4_1(dst, stride, bs, above, left, dx, dy);
+    return;
+  }
+  dr_prediction_z1(dst, stride, bs, above, dx, 0);
+}
+
+void av1_dr_prediction_z2_avx2(uint8_t *dst, ptrdiff_t stride, int bs,
+                               const uint8_t *above, const uint8_t *left,
+                               int dx, int dy) {
+  if (bs < DR_LANES) {
+    av1_dr_prediction_z2_sse4_1(dst, stride, bs, above, left, dx, dy);
+    return;
+  }
+  dr_prediction_z2(dst, stride, bs, above, left, dx, dy, 0);
+}
+
+void av1_dr_prediction_z3_avx2(uint8_t *dst, ptrdiff_t stride, int bs,
+                               const uint8_t *above, const uint8_t *left,
+                               int dx, int dy) {
+  if (bs < DR_LANES) {
+    av1_dr_prediction_z3_sse4_1(dst, stride, bs, above, left, dx, dy);
+    return;
+  }
+  dr_prediction_z3(dst, stride, bs, left, dy, 0);
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+void av1_highbd_dr_prediction_z1_avx2(uint16_t *dst, ptrdiff_t stride, int bs,
+                                      const uint16_t *above,
+                                      const uint16_t *left, int dx, int dy,
+                                      int bd) {
+  if (bs < DR_LANES) {
+    av1_highbd_dr_prediction_z1_sse4_1(dst, stride, bs, above, left, dx, dy,
+                                       bd);
+    return;
+  }
+  dr_prediction_z1(dst, stride, bs, above, dx, 1);
+}
+
+void av1_highbd_dr_prediction_z2_avx2(uint16_t *dst, ptrdiff_t stride, int bs,
+                                      const uint16_t *above,
+                                      const uint16_t *left, int dx, int dy,
+                                      int bd) {
+  if (bs < DR_LANES) {
+    av1_highbd_dr_prediction_z2_sse4_1(dst, stride, bs, above, left, dx, dy,
+                                       bd);
+    return;
+  }
+  dr_prediction_z2(dst, stride, bs, above, left, dx, dy, 1);
+}
+
+void av1_highbd_dr_prediction_z3_avx2(uint16_t *dst, ptrdiff_t stride, int bs,
+                                      const uint16_t *above,
+                                      const uint16_t *left, int dx, int dy,
+                                      int bd) {
+  if (bs < DR_LANES) {
+    av1_highbd_dr_prediction_z3_sse4_1(dst, stride, bs, above, left, dx, dy,
+                                       bd);
+    return;
+  }
+  dr_prediction_z3(dst, stride, bs, left, dy, 1);
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_COMMON_X86_DR_PREDICTION_IMPL_H_
+#define AV1_COMMON_X86_DR_PREDICTION_IMPL_H_
+
+// Directional intra prediction shared by the SSE4.1 and AVX2 versions. The
+// including file defines dr_vec, holding DR_LANES 16-bit values, and the
+// dr_*() vector helpers used below.
+//
+// All pixels are widened to 16 bits, so the low and high bitdepth versions
+// share the code; 'hbd' selects the pixel size of dst, above and left. The
+// interpolation
+//   (a * (256 - shift) + b * shift + 128) >> 8
+// is computed as a + (((b - a) * shift + 128) >> 8), which is exact, and its
+// result lies between a and b, so no clamping is needed.
+
+#include <emmintrin.h>
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/mem.h"
+#include "av1/common/enums.h"
+
+// Size of the widened edge buffers.
+#define DR_REF_SIZE (3 * MAX_TX_SIZE + 2 * DR_LANES)
+
+static INLINE int dr_get_pixel(const void *p, int i, int hbd) {
+  return hbd ? ((const uint16_t *)p)[i] : ((const uint8_t *)p)[i];
+}
+
+static INLINE void dr_set_pixel(void *p, ptrdiff_t i, int v, int hbd) {
+  if (hbd)
+    ((uint16_t *)p)[i] = v;
+  else
+    ((uint8_t *)p)[i] = v;
+}
+
+// Stores eight 16-bit pixels to p[i].
+static INLINE void dr_store8(void *p, ptrdiff_t i, __m128i v, int hbd) {
+  if (hbd)
+    _mm_storeu_si128((__m128i *)((uint16_t *)p + i), v);
+  else
+    _mm_storel_epi64((__m128i *)((uint8_t *)p + i), _mm_packus_epi16(v, v));
+}
+
+// Sets out[i] = ref[start + i] for i < n and replicates the last of those
+// pixels up to out[len - 1].
+static INLINE void dr_extend_ref(uint16_t *out, const void *ref, int start,
+                                 int n, int len, int hbd) {
+  int i;
+  for (i = 0; i < n; ++i) out[i] = dr_get_pixel(ref, start + i, hbd);
+  for (; i < len; ++i) out[i] = out[n - 1];
+}
+
+static INLINE void dr_transpose8x8(const __m128i *in, __m128i *out) {
+  const __m128i a0 = _mm_unpacklo_epi16(in[0], in[1]);
+  const __m128i a1 = _mm_unpacklo_epi16(in[2], in[3]);
+  const __m128i a2 = _mm_unpacklo_epi16(in[4], in[5]);
+  const __m128i a3 = _mm_unpacklo_epi16(in[6], in[7]);
+  const __m128i a4 = _mm_unpackhi_epi16(in[0], in[1]);
+  const __m128i a5 = _mm_unpackhi_epi16(in[2], in[3]);
+  const __m128i a6 = _mm_unpackhi_epi16(in[4], in[5]);
+  const __m128i a7 = _mm_unpackhi_epi16(in[6], in[7]);
+  const __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+  const __m128i b1 = _mm_unpacklo_epi32(a2, a3);
+  const __m128i b2 = _mm_unpackhi_epi32(a0, a1);
+  const __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+  const __m128i b4 = _mm_unpacklo_epi32(a4, a5);
+  const __m128i b5 = _mm_unpacklo_epi32(a6, a7);
+  const __m128i b6 = _mm_unpackhi_epi32(a4, a5);
+  const __m128i b7 = _mm_unpackhi_epi32(a6, a7);
+  out[0] = _mm_unpacklo_epi64(b0, b1);
+  out[1] = _mm_unpackhi_epi64(b0, b1);
+  out[2] = _mm_unpacklo_epi64(b2, b3);
+  out[3] = _mm_unpackhi_epi64(b2, b3);
+  out[4] = _mm_unpacklo_epi64(b4, b5);
+  out[5] = _mm_unpackhi_epi64(b4, b5);
+  out[6] = _mm_unpacklo_epi64(b6, b7);
+  out[7] = _mm_unpackhi_epi64(b6, b7);
+}
+
+// Writes the transpose of the rows x cols block src to dst.
+static INLINE void dr_transpose(void *dst, ptrdiff_t stride,
+                                const uint16_t *src, ptrdiff_t src_stride,
+                                int rows, int cols, int hbd) {
+  int r, c, i;
+
+  if ((rows & 7) || (cols & 7)) {
+    for (r = 0; r < rows; ++r)
+      for (c = 0; c < cols; ++c)
+        dr_set_pixel(dst, c * stride + r, src[r * src_stride + c], hbd);
+    return;
+  }
+
+  for (r = 0; r < rows; r += 8) {
+    for (c = 0; c < cols; c += 8) {
+      __m128i in[8], out[8];
+      for (i = 0; i < 8; ++i)
+        in[i] = _mm_loadu_si128((const __m128i *)(src + (r + i) * src_stride +
+                                                  c));
+      dr_transpose8x8(in, out);
+      for (i = 0; i < 8; ++i) dr_store8(dst, (c + i) * stride + r, out[i], hbd);
+    }
+  }
+}
+
+// Zone 1 prediction from a widened edge that is replicated past its last
+// pixel, ref[2 * bs - 1].
+static INLINE void dr_z1_block(void *dst, ptrdiff_t stride, int bs,
+                               const uint16_t *ref, int dx, int hbd) {
+  const int w = AOMMIN(bs, DR_LANES);
+  const dr_vec last = dr_set1(ref[2 * bs - 1]);
+  int r, c, x;
+
+  for (r = 0, x = dx; r < bs; ++r, x += dx) {
+    const int base = x >> 8;
+    dr_vec shift;
+
+    if (base >= 2 * bs - 1) {
+      for (; r < bs; ++r)
+        for (c = 0; c < bs; c += w)
+          dr_store_pixels(dst, r * stride + c, last, w, hbd);
+      return;
+    }
+
+    shift = dr_set1((x & 0xFF) << 7);
+    for (c = 0; c < bs; c += w) {
+      const dr_vec a = dr_load(ref + base + c);
+      const dr_vec b = dr_load(ref + base + c + 1);
+      dr_store_pixels(dst, r * stride + c, dr_interp(a, b, shift), w, hbd);
+    }
+  }
+}
+
+static INLINE void dr_prediction_z1(void *dst, ptrdiff_t stride, int bs,
+                                    const void *above, int dx, int hbd) {
+  DECLARE_ALIGNED(16, uint16_t, ref[DR_REF_SIZE]);
+
+  dr_extend_ref(ref, above, 0, 2 * bs, 3 * bs + DR_LANES, hbd);
+  dr_z1_block(dst, stride, bs, ref, dx, hbd);
+}
+
+// Zone 3 is zone 1 along the left edge, with rows and columns swapped.
+static INLINE void dr_prediction_z3(void *dst, ptrdiff_t stride, int bs,
+                                    const void *left, int dy, int hbd) {
+  DECLARE_ALIGNED(16, uint16_t, ref[DR_REF_SIZE]);
+  DECLARE_ALIGNED(16, uint16_t, pred[MAX_TX_SQUARE]);
+
+  dr_extend_ref(ref, left, 0, 2 * bs, 3 * bs + DR_LANES, hbd);
+  dr_z1_block(pred, bs, bs, ref, dy, 1);
+  dr_transpose(dst, stride, pred, bs, bs, bs, hbd);
+}
+
+// Zone 2 takes the pixels of row r at and after column c0(r) from the above
+// edge, and the others from the left edge. Along a column, the left edge
+// position and the interpolation shift behave like zone 3, so the columns
+// that need it are predicted transposed first.
+static INLINE void dr_prediction_z2(void *dst, ptrdiff_t stride, int bs,
+                                    const void *above, const void *left,
+                                    int dx, int dy, int hbd) {
+  DECLARE_ALIGNED(16, uint16_t, above_buf[DR_REF_SIZE]);
+  DECLARE_ALIGNED(16, uint16_t, left_buf[DR_REF_SIZE]);
+  DECLARE_ALIGNED(16, uint16_t, pred[MAX_TX_SQUARE]);
+  DECLARE_ALIGNED(16, uint16_t, left_pred[MAX_TX_SQUARE + DR_LANES]);
+  // above_ref[-DR_LANES..-1] and left_ref[-MAX_TX_SIZE..-1] are readable;
+  // pixels left of left[0] all equal left[0].
+  uint16_t *const above_ref = above_buf + DR_LANES;
+  uint16_t *const left_ref = left_buf + MAX_TX_SIZE;
+  const int w = AOMMIN(bs, DR_LANES);
+  // c0(r) = -1 - ((-(r + 1) * dx) >> 8) grows with r.
+  const int left_cols =
+      AOMMIN(bs, AOMMAX(0, -1 - ((-bs * dx) >> 8) + w - 1) / w * w);
+  int r, c;
+
+  dr_extend_ref(above_buf, above, -1, 1, DR_LANES, hbd);
+  dr_extend_ref(above_ref - 1, above, -1, bs + 1, bs + 1 + DR_LANES, hbd);
+  dr_extend_ref(left_buf, left, 0, 1, MAX_TX_SIZE, hbd);
+  dr_extend_ref(left_ref, left, 0, bs, bs + DR_LANES, hbd);
+
+  for (c = 0; c < left_cols; ++c) {
+    const int y = -(c + 1) * dy;
+    const int base = AOMMAX(y >> 8, -bs);
+    const dr_vec shift = dr_set1((y & 0xFF) << 7);
+    for (r = 0; r < bs; r += w) {
+      const dr_vec a = dr_load(left_ref + base + r);
+      const dr_vec b = dr_load(left_ref + base + r + 1);
+      dr_store_pixels(pred, c * bs + r, dr_interp(a, b, shift), w, 1);
+    }
+  }
+  if (left_cols) dr_transpose(left_pred, bs, pred, bs, left_cols, bs, 1);
+
+  for (r = 0; r < bs; ++r) {
+    const int x = -(r + 1) * dx;
+    const int base = x >> 8;
+    const int c0 = -1 - base;
+    const dr_vec shift = dr_set1((x & 0xFF) << 7);
+    for (c = 0; c < bs; c += w) {
+      dr_vec v;
+      if (c + w <= c0) {
+        v = dr_load(left_pred + r * bs + c);
+      } else {
+        const dr_vec a = dr_load(above_ref + base + c);
+        const dr_vec b = dr_load(above_ref + base + c + 1);
+        v = dr_interp(a, b, shift);
+        if (c < c0)
+          v = dr_blend(dr_lanes_below(c0 - c), dr_load(left_pred + r * bs + c),
+                       v);
+      }
+      dr_store_pixels(dst, r * stride + c, v, w, hbd);
+    }
+  }
+}
+
+#endif  // AV1_COMMON_X86_DR_PREDICTION_IMPL_H_
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h> /* SSE4.1 */
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+
+#define DR_LANES 8
+
+typedef __m128i dr_vec;
+
+static INLINE dr_vec dr_load(const uint16_t *p) {
+  return _mm_loadu_si128((const __m128i *)p);
+}
+
+static INLINE dr_vec dr_set1(int v) { return _mm_set1_epi16(v); }
+
+// Returns a + (((b - a) * shift + 128) >> 8), with shift given as shift << 7.
+static INLINE dr_vec dr_interp(dr_vec a, dr_vec b, dr_vec shift) {
+  return _mm_add_epi16(a, _mm_mulhrs_epi16(_mm_sub_epi16(b, a), shift));
+}
+
+// Returns (mask & a) | (~mask & b).
+static INLINE dr_vec dr_blend(dr_vec mask, dr_vec a, dr_vec b) {
+  return _mm_blendv_epi8(b, a, mask);
+}
+
+// Returns a mask of the lanes i < n.
+static INLINE dr_vec dr_lanes_below(int n) {
+  return _mm_cmpgt_epi16(_mm_set1_epi16(n),
+                         _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+// Stores the first w (2, 4 or 8) 16-bit values of v to p[i].
+static INLINE void dr_store_pixels(void *p, ptrdiff_t i, dr_vec v, int w,
+                                   int hbd) {
+  if (hbd) {
+    uint16_t *const p16 = (uint16_t *)p + i;
+    if (w == 8)
+      _mm_storeu_si128((__m128i *)p16, v);
+    else if (w == 4)
+      _mm_storel_epi64((__m128i *)p16, v);
+    else
+      *(int *)p16 = _mm_cvtsi128_si32(v);
+  } else {
+    uint8_t *const p8 = (uint8_t *)p + i;
+    v = _mm_packus_epi16(v, v);
+    if (w == 8)
+      _mm_storel_epi64((__m128i *)p8, v);
+    else if (w == 4)
+      *(int *)p8 = _mm_cvtsi128_si32(v);
+    else
+      *(uint16_t *)p8 = (uint16_t)_mm_cvtsi128_si32(v);
+  }
+}
+
+#include "av1/common/x86/dr_prediction_impl.h"
+
+// Below these sizes the edge setup costs more than the C loops.
+#define DR_MIN_BS_Z13 4
+#define DR_MIN_BS_Z2 8
+
+void av1_dr_prediction_z1_sse4_1(uint8_t *dst, ptrdiff_t stride, int bs,
+                                 const uint8_t *above, const uint8_t *left,
+                                 int dx, int dy) {
+  if (bs < DR_MIN_BS_Z13) {
+    av1_dr_prediction_z1_c(dst, stride, bs, above, left, dx, dy);
+    return;
+  }
+  dr_prediction_z1(dst, stride, bs, above, dx, 0);
+}
+
+void av1_dr_prediction_z2_sse4_1(uint8_t *dst, ptrdiff_t stride, int bs,
+                                 const uint8_t *above, const uint8_t *left,
+                                 int dx, int dy) {
+  if (bs < DR_MIN_BS_Z2) {
+    av1_dr_prediction_z2_c(dst, stride, bs, above, left, dx, dy);
+    return;
+  }
+  dr_prediction_z2(dst, stride, bs, above, left, dx, dy, 0);
+}
+
+void av1_dr_prediction_z3_sse4_1(uint8_t *dst, ptrdiff_t stride, int bs,
+                                 const uint8_t *above, const uint8_t *left,
+                                 int dx, int dy) {
+  if (bs < DR_MIN_BS_Z13) {
+    av1_dr_prediction_z3_c(dst, stride, bs, above, left, dx, dy);
+    return;
+  }
+  dr_prediction_z3(dst, stride, bs, left, dy, 0);
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+void av1_highbd_dr_prediction_z1_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                        int bs, const uint16_t *above,
+                                        const uint16_t *left, int dx, int dy,
+                                        int bd) {
+  if (bs < DR_MIN_BS_Z13) {
+    av1_highbd_dr_prediction_z1_c(dst, stride, bs, above, left, dx, dy, bd);
+    return;
+  }
+  dr_prediction_z1(dst, stride, bs, above, dx, 1);
+}
+
+void av1_highbd_dr_prediction_z2_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                        int bs, const uint16_t *above,
+                                        const uint16_t *left, int dx, int dy,
+                                        int bd) {
+  if (bs < DR_MIN_BS_Z2) {
+    av1_highbd_dr_prediction_z2_c(dst, stride, bs, above, left, dx, dy, bd);
+    return;
+  }
+  dr_prediction_z2(dst, stride, bs, above, left, dx, dy, 1);
+}
+
+void av1_highbd_dr_prediction_z3_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                        int bs, const uint16_t *above,
+                                        const uint16_t *left, int dx, int dy,
+                                        int bd) {
+  if (bs < DR_MIN_BS_Z13) {
+    av1_highbd_dr_prediction_z3_c(dst, stride, bs, above, left, dx, dy, bd);
+    return;
+  }
+  dr_prediction_z3(dst, stride, bs, left, dy, 1);
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "./av1_rtcd.h"
+#include "av1/common/x86/hybrid_txfm32_avx2.h"
+
+static INLINE void hbd_load_transpose(const tran_low_t *in, int stride,
+                                      hbd_vec *out) {
+  __m256i r[8];
+  int i;
+  for (i = 0; i < 8; ++i)
+    r[i] = _mm256_loadu_si256((const __m256i *)(in + i * stride));
+  hbd_transpose(r, out);
+}
+
+static INLINE void hbd_round_shift_add(uint16_t *dst, hbd_vec a, int shift,
+                                       int bd) {
+  const __m256i rounding = _mm256_set1_epi32(1 << (shift - 1));
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  const __m256i d = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i *)dst));
+  a = _mm256_sra_epi32(_mm256_add_epi32(a, rounding),
+                       _mm_cvtsi32_si128(shift));
+  a = _mm256_add_epi32(d, a);
+  // packus works within 128-bit lanes: gather qwords 0 and 2.
+  a = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, a), 0x08);
+  _mm_storeu_si128((__m128i *)dst,
+                   _mm_min_epu16(_mm256_castsi256_si128(a), max));
+}
+
+#include "av1/common/x86/highbd_hybrid_inv_txfm_impl.h"
+
+void av1_highbd_iht8x8_64_add_avx2(const tran_low_t *input, uint8_t *dest8,
+                                   int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 8, 8,
+                 0, 5);
+}
+
+void av1_highbd_iht8x16_128_add_avx2(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 8, 16,
+                 1, 6);
+}
+
+void av1_highbd_iht16x8_128_add_avx2(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 16, 8,
+                 1, 6);
+}
+
+void av1_highbd_iht8x32_256_add_avx2(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 8, 32,
+                 0, 6);
+}
+
+void av1_highbd_iht32x8_256_add_avx2(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 32, 8,
+                 0, 6);
+}
+
+void av1_highbd_iht16x16_256_add_avx2(const tran_low_t *input, uint8_t *dest8,
+                                      int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 16,
+                 16, 0, 6);
+}
+
+void av1_highbd_iht16x32_512_add_avx2(const tran_low_t *input, uint8_t *dest8,
+                                      int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 16,
+                 32, 1, 6);
+}
+
+void av1_highbd_iht32x16_512_add_avx2(const tran_low_t *input, uint8_t *dest8,
+                                      int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 32,
+                 16, 1, 6);
+}
+
+#if CONFIG_EXT_TX
+void av1_highbd_iht32x32_1024_add_avx2(const tran_low_t *input,
+                                       uint8_t *dest8, int stride, int tx_type,
+                                       int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 32,
+                 32, 0, 6);
+}
+#endif  // CONFIG_EXT_TX
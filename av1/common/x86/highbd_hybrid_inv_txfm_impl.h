@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+// High bitdepth hybrid inverse transforms (av1_highbd_iht*_add), written once
+// over an abstract vector of 32-bit lanes and included by each ISA-specific
+// file. The 1-D kernels follow aom_highbd_idct*_c, aom_highbd_iadst*_c and the
+// highbd_iidtx*_c/highbd_ihalfright32_c helpers in av1/common/idct.c step for
+// step: every product is formed and rounded in 64 bits and every sum wraps in
+// 32 bits, so the output is bit-exact with the C code for all inputs.
+//
+// Before including this file, include one of the hybrid_txfm32_*.h headers
+// (see hybrid_txfm32_common.h) and define the static INLINE functions:
+//   void hbd_load_transpose(const tran_low_t *in, int stride, hbd_vec *out)
+//                  loads a HBD_LANES x HBD_LANES block, out[k] = column k
+//   void hbd_round_shift_add(uint16_t *dst, hbd_vec a, int shift, int bd)
+//                  dst = clip(dst + ROUND_POWER_OF_TWO(a, shift)), one row
+
+#include "./aom_config.h"
+#include "aom_dsp/txfm_common.h"
+#include "aom_ports/bitops.h"
+#include "av1/common/enums.h"
+
+static void hbd_idct4(hbd_vec *x) {
+  const hbd_vec s0 = hbd_mul_round(hbd_add(x[0], x[2]), (int)cospi_16_64);
+  const hbd_vec s1 = hbd_mul_round(hbd_sub(x[0], x[2]), (int)cospi_16_64);
+  const hbd_vec s2 =
+      hbd_madd_round(x[1], (int)cospi_24_64, x[3], -(int)cospi_8_64);
+  const hbd_vec s3 =
+      hbd_madd_round(x[1], (int)cospi_8_64, x[3], (int)cospi_24_64);
+  x[0] = hbd_add(s0, s3);
+  x[1] = hbd_add(s1, s2);
+  x[2] = hbd_sub(s1, s2);
+  x[3] = hbd_sub(s0, s3);
+}
+
+static void hbd_idct8(hbd_vec *x) {
+  hbd_vec e[4], s4, s5, s6, s7, t4, t5, t6, t7;
+  int i;
+
+  // even half
+  for (i = 0; i < 4; ++i) e[i] = x[2 * i];
+  hbd_idct4(e);
+
+  // odd half
+  s4 = hbd_madd_round(x[1], (int)cospi_28_64, x[7], -(int)cospi_4_64);
+  s7 = hbd_madd_round(x[1], (int)cospi_4_64, x[7], (int)cospi_28_64);
+  s5 = hbd_madd_round(x[5], (int)cospi_12_64, x[3], -(int)cospi_20_64);
+  s6 = hbd_madd_round(x[5], (int)cospi_20_64, x[3], (int)cospi_12_64);
+
+  t4 = hbd_add(s4, s5);
+  t5 = hbd_sub(s4, s5);
+  t6 = hbd_sub(s7, s6);
+  t7 = hbd_add(s6, s7);
+
+  s5 = hbd_mul_round(hbd_sub(t6, t5), (int)cospi_16_64);
+  s6 = hbd_mul_round(hbd_add(t5, t6), (int)cospi_16_64);
+
+  x[0] = hbd_add(e[0], t7);
+  x[1] = hbd_add(e[1], s6);
+  x[2] = hbd_add(e[2], s5);
+  x[3] = hbd_add(e[3], t4);
+  x[4] = hbd_sub(e[3], t4);
+  x[5] = hbd_sub(e[2], s5);
+  x[6] = hbd_sub(e[1], s6);
+  x[7] = hbd_sub(e[0], t7);
+}
+
+static void hbd_idct16(hbd_vec *x) {
+  hbd_vec e[8], s[16], t[16];
+  int i;
+
+  // even half
+  for (i = 0; i < 8; ++i) e[i] = x[2 * i];
+  hbd_idct8(e);
+
+  // odd half, stage 2
+  s[8] = hbd_madd_round(x[1], (int)cospi_30_64, x[15], -(int)cospi_2_64);
+  s[15] = hbd_madd_round(x[1], (int)cospi_2_64, x[15], (int)cospi_30_64);
+  s[9] = hbd_madd_round(x[9], (int)cospi_14_64, x[7], -(int)cospi_18_64);
+  s[14] = hbd_madd_round(x[9], (int)cospi_18_64, x[7], (int)cospi_14_64);
+  s[10] = hbd_madd_round(x[5], (int)cospi_22_64, x[11], -(int)cospi_10_64);
+  s[13] = hbd_madd_round(x[5], (int)cospi_10_64, x[11], (int)cospi_22_64);
+  s[11] = hbd_madd_round(x[13], (int)cospi_6_64, x[3], -(int)cospi_26_64);
+  s[12] = hbd_madd_round(x[13], (int)cospi_26_64, x[3], (int)cospi_6_64);
+
+  // stage 3
+  t[8] = hbd_add(s[8], s[9]);
+  t[9] = hbd_sub(s[8], s[9]);
+  t[10] = hbd_sub(s[11], s[10]);
+  t[11] = hbd_add(s[10], s[11]);
+  t[12] = hbd_add(s[12], s[13]);
+  t[13] = hbd_sub(s[12], s[13]);
+  t[14] = hbd_sub(s[15], s[14]);
+  t[15] = hbd_add(s[14], s[15]);
+
+  // stage 4
+  s[8] = t[8];
+  s[9] = hbd_madd_round(t[9], -(int)cospi_8_64, t[14], (int)cospi_24_64);
+  s[14] = hbd_madd_round(t[9], (int)cospi_24_64, t[14], (int)cospi_8_64);
+  s[10] = hbd_madd_round(t[10], -(int)cospi_24_64, t[13], -(int)cospi_8_64);
+  s[13] = hbd_madd_round(t[10], -(int)cospi_8_64, t[13], (int)cospi_24_64);
+  s[11] = t[11];
+  s[12] = t[12];
+  s[15] = t[15];
+
+  // stage 5
+  t[8] = hbd_add(s[8], s[11]);
+  t[9] = hbd_add(s[9], s[10]);
+  t[10] = hbd_sub(s[9], s[10]);
+  t[11] = hbd_sub(s[8], s[11]);
+  t[12] = hbd_sub(s[15], s[12]);
+  t[13] = hbd_sub(s[14], s[13]);
+  t[14] = hbd_add(s[13], s[14]);
+  t[15] = hbd_add(s[12], s[15]);
+
+  // stage 6
+  s[8] = t[8];
+  s[9] = t[9];
+  s[10] = hbd_mul_round(hbd_sub(t[13], t[10]), (int)cospi_16_64);
+  s[13] = hbd_mul_round(hbd_add(t[10], t[13]), (int)cospi_16_64);
+  s[11] = hbd_mul_round(hbd_sub(t[12], t[11]), (int)cospi_16_64);
+  s[12] = hbd_mul_round(hbd_add(t[11], t[12]), (int)cospi_16_64);
+  s[14] = t[14];
+  s[15] = t[15];
+
+  // stage 7
+  for (i = 0; i < 8; ++i) {
+    x[i] = hbd_add(e[i], s[15 - i]);
+    x[15 - i] = hbd_sub(e[i], s[15 - i]);
+  }
+}
+
+static void hbd_idct32(hbd_vec *x) {
+  hbd_vec e[16], s[32], t[32];
+  int i;
+
+  // even half
+  for (i = 0; i < 16; ++i) e[i] = x[2 * i];
+  hbd_idct16(e);
+
+  // odd half, stage 1
+  s[16] = hbd_madd_round(x[1], (int)cospi_31_64, x[31], -(int)cospi_1_64);
+  s[31] = hbd_madd_round(x[1], (int)cospi_1_64, x[31], (int)cospi_31_64);
+  s[17] = hbd_madd_round(x[17], (int)cospi_15_64, x[15], -(int)cospi_17_64);
+  s[30] = hbd_madd_round(x[17], (int)cospi_17_64, x[15], (int)cospi_15_64);
+  s[18] = hbd_madd_round(x[9], (int)cospi_23_64, x[23], -(int)cospi_9_64);
+  s[29] = hbd_madd_round(x[9], (int)cospi_9_64, x[23], (int)cospi_23_64);
+  s[19] = hbd_madd_round(x[25], (int)cospi_7_64, x[7], -(int)cospi_25_64);
+  s[28] = hbd_madd_round(x[25], (int)cospi_25_64, x[7], (int)cospi_7_64);
+  s[20] = hbd_madd_round(x[5], (int)cospi_27_64, x[27], -(int)cospi_5_64);
+  s[27] = hbd_madd_round(x[5], (int)cospi_5_64, x[27], (int)cospi_27_64);
+  s[21] = hbd_madd_round(x[21], (int)cospi_11_64, x[11], -(int)cospi_21_64);
+  s[26] = hbd_madd_round(x[21], (int)cospi_21_64, x[11], (int)cospi_11_64);
+  s[22] = hbd_madd_round(x[13], (int)cospi_19_64, x[19], -(int)cospi_13_64);
+  s[25] = hbd_madd_round(x[13], (int)cospi_13_64, x[19], (int)cospi_19_64);
+  s[23] = hbd_madd_round(x[29], (int)cospi_3_64, x[3], -(int)cospi_29_64);
+  s[24] = hbd_madd_round(x[29], (int)cospi_29_64, x[3], (int)cospi_3_64);
+
+  // stage 2
+  for (i = 16; i < 32; i += 4) {
+    t[i] = hbd_add(s[i], s[i + 1]);
+    t[i + 1] = hbd_sub(s[i], s[i + 1]);
+    t[i + 2] = hbd_sub(s[i + 3], s[i + 2]);
+    t[i + 3] = hbd_add(s[i + 2], s[i + 3]);
+  }
+
+  // stage 3
+  s[16] = t[16];
+  s[17] = hbd_madd_round(t[17], -(int)cospi_4_64, t[30], (int)cospi_28_64);
+  s[30] = hbd_madd_round(t[17], (int)cospi_28_64, t[30], (int)cospi_4_64);
+  s[18] = hbd_madd_round(t[18], -(int)cospi_28_64, t[29], -(int)cospi_4_64);
+  s[29] = hbd_madd_round(t[18], -(int)cospi_4_64, t[29], (int)cospi_28_64);
+  s[19] = t[19];
+  s[20] = t[20];
+  s[21] = hbd_madd_round(t[21], -(int)cospi_20_64, t[26], (int)cospi_12_64);
+  s[26] = hbd_madd_round(t[21], (int)cospi_12_64, t[26], (int)cospi_20_64);
+  s[22] = hbd_madd_round(t[22], -(int)cospi_12_64, t[25], -(int)cospi_20_64);
+  s[25] = hbd_madd_round(t[22], -(int)cospi_20_64, t[25], (int)cospi_12_64);
+  s[23] = t[23];
+  s[24] = t[24];
+  s[27] = t[27];
+  s[28] = t[28];
+  s[31] = t[31];
+
+  // stage 4
+  for (i = 16; i < 32; i += 8) {
+    t[i] = hbd_add(s[i], s[i + 3]);
+    t[i + 1] = hbd_add(s[i + 1], s[i + 2]);
+    t[i + 2] = hbd_sub(s[i + 1], s[i + 2]);
+    t[i + 3] = hbd_sub(s[i], s[i + 3]);
+    t[i + 4] = hbd_sub(s[i + 7], s[i + 4]);
+    t[i + 5] = hbd_sub(s[i + 6], s[i + 5]);
+    t[i + 6] = hbd_add(s[i + 5], s[i + 6]);
+    t[i + 7] = hbd_add(s[i + 4], s[i + 7]);
+  }
+
+  // stage 5
+  s[16] = t[16];
+  s[17] = t[17];
+  s[18] = hbd_madd_round(t[18], -(int)cospi_8_64, t[29], (int)cospi_24_64);
+  s[29] = hbd_madd_round(t[18], (int)cospi_24_64, t[29], (int)cospi_8_64);
+  s[19] = hbd_madd_round(t[19], -(int)cospi_8_64, t[28], (int)cospi_24_64);
+  s[28] = hbd_madd_round(t[19], (int)cospi_24_64, t[28], (int)cospi_8_64);
+  s[20] = hbd_madd_round(t[20], -(int)cospi_24_64, t[27], -(int)cospi_8_64);
+  s[27] = hbd_madd_round(t[20], -(int)cospi_8_64, t[27], (int)cospi_24_64);
+  s[21] = hbd_madd_round(t[21], -(int)cospi_24_64, t[26], -(int)cospi_8_64);
+  s[26] = hbd_madd_round(t[21], -(int)cospi_8_64, t[26], (int)cospi_24_64);
+  s[22] = t[22];
+  s[23] = t[23];
+  s[24] = t[24];
+  s[25] = t[25];
+  s[30] = t[30];
+  s[31] = t[31];
+
+  // stage 6
+  for (i = 0; i < 4; ++i) {
+    t[16 + i] = hbd_add(s[16 + i], s[23 - i]);
+    t[23 - i] = hbd_sub(s[16 + i], s[23 - i]);
+    t[24 + i] = hbd_sub(s[31 - i], s[24 + i]);
+    t[31 - i] = hbd_add(s[24 + i], s[31 - i]);
+  }
+
+  // stage 7
+  for (i = 20; i < 24; ++i) {
+    s[i] = hbd_mul_round(hbd_sub(t[47 - i], t[i]), (int)cospi_16_64);
+    s[47 - i] = hbd_mul_round(hbd_add(t[i], t[47 - i]), (int)cospi_16_64);
+  }
+  for (i = 16; i < 20; ++i) {
+    s[i] = t[i];
+    s[47 - i] = t[47 - i];
+  }
+
+  // final stage
+  for (i = 0; i < 16; ++i) {
+    x[i] = hbd_add(e[i], s[31 - i]);
+    x[31 - i] = hbd_sub(e[i], s[31 - i]);
+  }
+}
+
+static void hbd_iadst4(hbd_vec *x) {
+  const hbd_vec64 s0 = hbd_add64(
+      hbd_madd64(x[0], (int)sinpi_1_9, x[2], (int)sinpi_4_9),
+      hbd_mul64(x[3], (int)sinpi_2_9));
+  const hbd_vec64 s1 = hbd_add64(
+      hbd_madd64(x[0], (int)sinpi_2_9, x[2], -(int)sinpi_1_9),
+      hbd_mul64(x[3], -(int)sinpi_4_9));
+  const hbd_vec64 s3 = hbd_mul64(x[1], (int)sinpi_3_9);
+  const hbd_vec s7 = hbd_add(hbd_sub(x[0], x[2]), x[3]);
+
+  x[0] = hbd_round64(hbd_add64(s0, s3));
+  x[1] = hbd_round64(hbd_add64(s1, s3));
+  x[2] = hbd_mul_round(s7, (int)sinpi_3_9);
+  x[3] = hbd_round64(hbd_sub64(hbd_add64(s0, s1), s3));
+}
+
+static void hbd_iadst8(hbd_vec *x) {
+  hbd_vec64 s0, s1, s2, s3, s4, s5, s6, s7;
+  hbd_vec x0, x1, x2, x3, x4, x5, x6, x7;
+
+  // stage 1
+  s0 = hbd_madd64(x[7], (int)cospi_2_64, x[0], (int)cospi_30_64);
+  s1 = hbd_madd64(x[7], (int)cospi_30_64, x[0], -(int)cospi_2_64);
+  s2 = hbd_madd64(x[5], (int)cospi_10_64, x[2], (int)cospi_22_64);
+  s3 = hbd_madd64(x[5], (int)cospi_22_64, x[2], -(int)cospi_10_64);
+  s4 = hbd_madd64(x[3], (int)cospi_18_64, x[4], (int)cospi_14_64);
+  s5 = hbd_madd64(x[3], (int)cospi_14_64, x[4], -(int)cospi_18_64);
+  s6 = hbd_madd64(x[1], (int)cospi_26_64, x[6], (int)cospi_6_64);
+  s7 = hbd_madd64(x[1], (int)cospi_6_64, x[6], -(int)cospi_26_64);
+
+  x0 = hbd_round64(hbd_add64(s0, s4));
+  x1 = hbd_round64(hbd_add64(s1, s5));
+  x2 = hbd_round64(hbd_add64(s2, s6));
+  x3 = hbd_round64(hbd_add64(s3, s7));
+  x4 = hbd_round64(hbd_sub64(s0, s4));
+  x5 = hbd_round64(hbd_sub64(s1, s5));
+  x6 = hbd_round64(hbd_sub64(s2, s6));
+  x7 = hbd_round64(hbd_sub64(s3, s7));
+
+  // stage 2
+  s4 = hbd_madd64(x4, (int)cospi_8_64, x5, (int)cospi_24_64);
+  s5 = hbd_madd64(x4, (int)cospi_24_64, x5, -(int)cospi_8_64);
+  s6 = hbd_madd64(x6, -(int)cospi_24_64, x7, (int)cospi_8_64);
+  s7 = hbd_madd64(x6, (int)cospi_8_64, x7, (int)cospi_24_64);
+
+  x[0] = hbd_add(x0, x2);
+  x[7] = hbd_neg(hbd_add(x1, x3));
+  x2 = hbd_sub(x0, x2);
+  x3 = hbd_sub(x1, x3);
+  x4 = hbd_round64(hbd_add64(s4, s6));
+  x5 = hbd_round64(hbd_add64(s5, s7));
+  x6 = hbd_round64(hbd_sub64(s4, s6));
+  x7 = hbd_round64(hbd_sub64(s5, s7));
+
+  // stage 3
+  x[1] = hbd_neg(x4);
+  x[2] = hbd_mul_round(hbd_add(x6, x7), (int)cospi_16_64);
+  x[3] = hbd_neg(hbd_mul_round(hbd_add(x2, x3), (int)cospi_16_64));
+  x[4] = hbd_mul_round(hbd_sub(x2, x3), (int)cospi_16_64);
+  x[5] = hbd_neg(hbd_mul_round(hbd_sub(x6, x7), (int)cospi_16_64));
+  x[6] = x5;
+}
+
+static void hbd_iadst16(hbd_vec *x) {
+  hbd_vec64 s[16];
+  hbd_vec y[16], z[16];
+  int i;
+
+  // stage 1
+  s[0] = hbd_madd64(x[15], (int)cospi_1_64, x[0], (int)cospi_31_64);
+  s[1] = hbd_madd64(x[15], (int)cospi_31_64, x[0], -(int)cospi_1_64);
+  s[2] = hbd_madd64(x[13], (int)cospi_5_64, x[2], (int)cospi_27_64);
+  s[3] = hbd_madd64(x[13], (int)cospi_27_64, x[2], -(int)cospi_5_64);
+  s[4] = hbd_madd64(x[11], (int)cospi_9_64, x[4], (int)cospi_23_64);
+  s[5] = hbd_madd64(x[11], (int)cospi_23_64, x[4], -(int)cospi_9_64);
+  s[6] = hbd_madd64(x[9], (int)cospi_13_64, x[6], (int)cospi_19_64);
+  s[7] = hbd_madd64(x[9], (int)cospi_19_64, x[6], -(int)cospi_13_64);
+  s[8] = hbd_madd64(x[7], (int)cospi_17_64, x[8], (int)cospi_15_64);
+  s[9] = hbd_madd64(x[7], (int)cospi_15_64, x[8], -(int)cospi_17_64);
+  s[10] = hbd_madd64(x[5], (int)cospi_21_64, x[10], (int)cospi_11_64);
+  s[11] = hbd_madd64(x[5], (int)cospi_11_64, x[10], -(int)cospi_21_64);
+  s[12] = hbd_madd64(x[3], (int)cospi_25_64, x[12], (int)cospi_7_64);
+  s[13] = hbd_madd64(x[3], (int)cospi_7_64, x[12], -(int)cospi_25_64);
+  s[14] = hbd_madd64(x[1], (int)cospi_29_64, x[14], (int)cospi_3_64);
+  s[15] = hbd_madd64(x[1], (int)cospi_3_64, x[14], -(int)cospi_29_64);
+
+  for (i = 0; i < 8; ++i) {
+    y[i] = hbd_round64(hbd_add64(s[i], s[i + 8]));
+    y[i + 8] = hbd_round64(hbd_sub64(s[i], s[i + 8]));
+  }
+
+  // stage 2
+  s[8] = hbd_madd64(y[8], (int)cospi_4_64, y[9], (int)cospi_28_64);
+  s[9] = hbd_madd64(y[8], (int)cospi_28_64, y[9], -(int)cospi_4_64);
+  s[10] = hbd_madd64(y[10], (int)cospi_20_64, y[11], (int)cospi_12_64);
+  s[11] = hbd_madd64(y[10], (int)cospi_12_64, y[11], -(int)cospi_20_64);
+  s[12] = hbd_madd64(y[12], -(int)cospi_28_64, y[13], (int)cospi_4_64);
+  s[13] = hbd_madd64(y[12], (int)cospi_4_64, y[13], (int)cospi_28_64);
+  s[14] = hbd_madd64(y[14], -(int)cospi_12_64, y[15], (int)cospi_20_64);
+  s[15] = hbd_madd64(y[14], (int)cospi_20_64, y[15], (int)cospi_12_64);
+
+  for (i = 0; i < 4; ++i) {
+    z[i] = hbd_add(y[i], y[i + 4]);
+    z[i + 4] = hbd_sub(y[i], y[i + 4]);
+    z[i + 8] = hbd_round64(hbd_add64(s[i + 8], s[i + 12]));
+    z[i + 12] = hbd_round64(hbd_sub64(s[i + 8], s[i + 12]));
+  }
+
+  // stage 3
+  s[4] = hbd_madd64(z[4], (int)cospi_8_64, z[5], (int)cospi_24_64);
+  s[5] = hbd_madd64(z[4], (int)cospi_24_64, z[5], -(int)cospi_8_64);
+  s[6] = hbd_madd64(z[6], -(int)cospi_24_64, z[7], (int)cospi_8_64);
+  s[7] = hbd_madd64(z[6], (int)cospi_8_64, z[7], (int)cospi_24_64);
+  s[12] = hbd_madd64(z[12], (int)cospi_8_64, z[13], (int)cospi_24_64);
+  s[13] = hbd_madd64(z[12], (int)cospi_24_64, z[13], -(int)cospi_8_64);
+  s[14] = hbd_madd64(z[14], -(int)cospi_24_64, z[15], (int)cospi_8_64);
+  s[15] = hbd_madd64(z[14], (int)cospi_8_64, z[15], (int)cospi_24_64);
+
+  for (i = 0; i < 16; i += 8) {
+    y[i] = hbd_add(z[i], z[i + 2]);
+    y[i + 1] = hbd_add(z[i + 1], z[i + 3]);
+    y[i + 2] = hbd_sub(z[i], z[i + 2]);
+    y[i + 3] = hbd_sub(z[i + 1], z[i + 3]);
+    y[i + 4] = hbd_round64(hbd_add64(s[i + 4], s[i + 6]));
+    y[i + 5] = hbd_round64(hbd_add64(s[i + 5], s[i + 7]));
+    y[i + 6] = hbd_round64(hbd_sub64(s[i + 4], s[i + 6]));
+    y[i + 7] = hbd_round64(hbd_sub64(s[i + 5], s[i + 7]));
+  }
+
+  // stage 4
+  x[0] = y[0];
+  x[1] = hbd_neg(y[8]);
+  x[2] = y[12];
+  x[3] = hbd_neg(y[4]);
+  x[4] = hbd_mul_round(hbd_add(y[6], y[7]), (int)cospi_16_64);
+  x[5] = hbd_mul_round(hbd_add(y[14], y[15]), -(int)cospi_16_64);
+  x[6] = hbd_mul_round(hbd_add(y[10], y[11]), (int)cospi_16_64);
+  x[7] = hbd_mul_round(hbd_add(y[2], y[3]), -(int)cospi_16_64);
+  x[8] = hbd_mul_round(hbd_sub(y[2], y[3]), (int)cospi_16_64);
+  x[9] = hbd_mul_round(hbd_sub(y[11], y[10]), (int)cospi_16_64);
+  x[10] = hbd_mul_round(hbd_sub(y[14], y[15]), (int)cospi_16_64);
+  x[11] = hbd_mul_round(hbd_sub(y[7], y[6]), (int)cospi_16_64);
+  x[12] = y[5];
+  x[13] = hbd_neg(y[13]);
+  x[14] = y[9];
+  x[15] = hbd_neg(y[1]);
+}
+
+static void hbd_ihalfright32(hbd_vec *x) {
+  hbd_vec half[16];
+  int i;
+  for (i = 0; i < 16; ++i) {
+    half[i] = hbd_mul_round(x[i], (int)Sqrt2);
+    x[i] = hbd_add(x[16 + i], x[16 + i]);
+    x[i] = hbd_add(x[i], x[i]);
+  }
+  hbd_idct16(half);
+  for (i = 0; i < 16; ++i) x[16 + i] = half[i];
+}
+
+static void hbd_iidtx4(hbd_vec *x) {
+  int i;
+  for (i = 0; i < 4; ++i) x[i] = hbd_mul_round(x[i], (int)Sqrt2);
+}
+
+static void hbd_iidtx8(hbd_vec *x) {
+  int i;
+  for (i = 0; i < 8; ++i) x[i] = hbd_add(x[i], x[i]);
+}
+
+static void hbd_iidtx16(hbd_vec *x) {
+  int i;
+  for (i = 0; i < 16; ++i) x[i] = hbd_mul_round(x[i], 2 * (int)Sqrt2);
+}
+
+static void hbd_iidtx32(hbd_vec *x) {
+  int i;
+  for (i = 0; i < 32; ++i) {
+    x[i] = hbd_add(x[i], x[i]);
+    x[i] = hbd_add(x[i], x[i]);
+  }
+}
+
+typedef void (*hbd_inv_txfm1d)(hbd_vec *x);
+
+// Indexed by [log2(size) - 2][TX_TYPE_1D]. The 32-point ADST is the half
+// right transform, as in av1_highbd_iht32x32_1024_add_c().
+static const hbd_inv_txfm1d hbd_inv_txfm1d_tab[4][TX_TYPES_1D] = {
+  { hbd_idct4, hbd_iadst4, hbd_iadst4, hbd_iidtx4 },
+  { hbd_idct8, hbd_iadst8, hbd_iadst8, hbd_iidtx8 },
+  { hbd_idct16, hbd_iadst16, hbd_iadst16, hbd_iidtx16 },
+  { hbd_idct32, hbd_ihalfright32, hbd_ihalfright32, hbd_iidtx32 },
+};
+
+// Inverse transform of a txw x txh block of coefficients, added to dest.
+// rect_scale applies the extra 1/sqrt(2) normalization of the 2:1 shapes after
+// the row transforms; shift is the final rounding of the C versions.
+static INLINE void highbd_iht_add(const tran_low_t *input, uint16_t *dest,
+                                  int stride, int tx_type, int bd, int txw,
+                                  int txh, int rect_scale, int shift) {
+  const TX_TYPE_1D vtx = hbd_vtx_tab[tx_type];
+  const TX_TYPE_1D htx = hbd_htx_tab[tx_type];
+  const hbd_inv_txfm1d row_txfm = hbd_inv_txfm1d_tab[get_msb(txw) - 2][htx];
+  const hbd_inv_txfm1d col_txfm = hbd_inv_txfm1d_tab[get_msb(txh) - 2][vtx];
+  const int col_groups = txw / HBD_LANES;
+  // Row transform output, transposed: column group c holds txh vectors at
+  // buf[c * txh], one per row.
+  hbd_vec buf[32 * 32 / HBD_LANES];
+  hbd_vec row[32];
+  int r, c, k;
+
+  // Rows, HBD_LANES at a time, one row per lane.
+  for (r = 0; r < txh; r += HBD_LANES) {
+    for (c = 0; c < col_groups; ++c) {
+      hbd_load_transpose(input + r * txw + c * HBD_LANES, txw,
+                         row + c * HBD_LANES);
+    }
+    row_txfm(row);
+    if (rect_scale) {
+      for (k = 0; k < txw; ++k) row[k] = hbd_mul_round(row[k], (int)Sqrt2);
+    }
+    for (c = 0; c < col_groups; ++c)
+      hbd_transpose(row + c * HBD_LANES, buf + c * txh + r);
+  }
+
+  // Flipping the columns' output up-down flips the addends in dest;
+  // reversing the column groups and their lanes flips them left-right.
+  if (vtx == FLIPADST_1D) {
+    dest += (txh - 1) * stride;
+    stride = -stride;
+  }
+
+  // Columns, HBD_LANES at a time, one column per lane.
+  for (c = 0; c < col_groups; ++c) {
+    hbd_vec *const col = buf + c * txh;
+    col_txfm(col);
+    if (htx == FLIPADST_1D) {
+      uint16_t *const d = dest + (col_groups - 1 - c) * HBD_LANES;
+      for (r = 0; r < txh; ++r)
+        hbd_round_shift_add(d + r * stride, hbd_reverse(col[r]), shift, bd);
+    } else {
+      uint16_t *const d = dest + c * HBD_LANES;
+      for (r = 0; r < txh; ++r)
+        hbd_round_shift_add(d + r * stride, col[r], shift, bd);
+    }
+  }
+}
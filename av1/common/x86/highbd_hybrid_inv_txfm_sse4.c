@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "./av1_rtcd.h"
+#include "av1/common/x86/hybrid_txfm32_sse4.h"
+
+static INLINE void hbd_load_transpose(const tran_low_t *in, int stride,
+                                      hbd_vec *out) {
+  const __m128i r0 = _mm_loadu_si128((const __m128i *)(in + 0 * stride));
+  const __m128i r1 = _mm_loadu_si128((const __m128i *)(in + 1 * stride));
+  const __m128i r2 = _mm_loadu_si128((const __m128i *)(in + 2 * stride));
+  const __m128i r3 = _mm_loadu_si128((const __m128i *)(in + 3 * stride));
+  TRANSPOSE_4X4(r0, r1, r2, r3, out[0], out[1], out[2], out[3]);
+}
+
+static INLINE void hbd_round_shift_add(uint16_t *dst, hbd_vec a, int shift,
+                                       int bd) {
+  const __m128i rounding = _mm_set1_epi32(1 << (shift - 1));
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  const __m128i d = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)dst));
+  a = _mm_sra_epi32(_mm_add_epi32(a, rounding), _mm_cvtsi32_si128(shift));
+  a = _mm_packus_epi32(_mm_add_epi32(d, a), a);
+  _mm_storel_epi64((__m128i *)dst, _mm_min_epu16(a, max));
+}
+
+#include "av1/common/x86/highbd_hybrid_inv_txfm_impl.h"
+
+void av1_highbd_iht4x4_16_add_sse4_1(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 4, 4,
+                 0, 4);
+}
+
+void av1_highbd_iht4x8_32_add_sse4_1(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 4, 8,
+                 1, 5);
+}
+
+void av1_highbd_iht8x4_32_add_sse4_1(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 8, 4,
+                 1, 5);
+}
+
+void av1_highbd_iht4x16_64_add_sse4_1(const tran_low_t *input, uint8_t *dest8,
+                                      int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 4, 16,
+                 0, 5);
+}
+
+void av1_highbd_iht16x4_64_add_sse4_1(const tran_low_t *input, uint8_t *dest8,
+                                      int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 16, 4,
+                 0, 5);
+}
+
+void av1_highbd_iht8x8_64_add_sse4_1(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 8, 8,
+                 0, 5);
+}
+
+void av1_highbd_iht8x16_128_add_sse4_1(const tran_low_t *input,
+                                       uint8_t *dest8, int stride, int tx_type,
+                                       int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 8, 16,
+                 1, 6);
+}
+
+void av1_highbd_iht16x8_128_add_sse4_1(const tran_low_t *input,
+                                       uint8_t *dest8, int stride, int tx_type,
+                                       int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 16, 8,
+                 1, 6);
+}
+
+void av1_highbd_iht8x32_256_add_sse4_1(const tran_low_t *input,
+                                       uint8_t *dest8, int stride, int tx_type,
+                                       int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 8, 32,
+                 0, 6);
+}
+
+void av1_highbd_iht32x8_256_add_sse4_1(const tran_low_t *input,
+                                       uint8_t *dest8, int stride, int tx_type,
+                                       int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 32, 8,
+                 0, 6);
+}
+
+void av1_highbd_iht16x16_256_add_sse4_1(const tran_low_t *input,
+                                        uint8_t *dest8, int stride,
+                                        int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 16,
+                 16, 0, 6);
+}
+
+void av1_highbd_iht16x32_512_add_sse4_1(const tran_low_t *input,
+                                        uint8_t *dest8, int stride,
+                                        int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 16,
+                 32, 1, 6);
+}
+
+void av1_highbd_iht32x16_512_add_sse4_1(const tran_low_t *input,
+                                        uint8_t *dest8, int stride,
+                                        int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 32,
+                 16, 1, 6);
+}
+
+#if CONFIG_EXT_TX
+void av1_highbd_iht32x32_1024_add_sse4_1(const tran_low_t *input,
+                                         uint8_t *dest8, int stride,
+                                         int tx_type, int bd) {
+  highbd_iht_add(input, CONVERT_TO_SHORTPTR(dest8), stride, tx_type, bd, 32,
+                 32, 0, 6);
+}
+#endif  // CONFIG_EXT_TX
@@ -14,6 +14,7 @@
 #include "./av1_rtcd.h"
 #include "./aom_config.h"
 #include "av1/common/av1_inv_txfm2d_cfg.h"
+#include "av1/common/x86/av1_txfm1d_avx2.h"
 
 // Note:
 //  Total 32x4 registers to represent 32x32 block coefficients.
@@ -555,3 +556,52 @@ void av1_inv_txfm2d_add_32x32_avx2(const int32_t *coeff, uint16_t *output,
     default: assert(0);
   }
 }
+
+// Adds the 64x64 residual in, held as 64 rows of 8 vectors, to the output and
+// clamps the result to the pixel range.
+static void write_buffer_64x64(const __m256i *in, uint16_t *output, int stride,
+                               int bd) {
+  const __m256i max = _mm256_set1_epi16((1 << bd) - 1);
+  int r, c;
+
+  for (r = 0; r < 64; ++r) {
+    for (c = 0; c < 64; c += 16) {
+      const __m256i pred = _mm256_loadu_si256((const __m256i *)(output + c));
+      const __m256i lo = _mm256_add_epi32(
+          in[c / 8], _mm256_cvtepu16_epi32(_mm256_castsi256_si128(pred)));
+      const __m256i hi = _mm256_add_epi32(
+          in[c / 8 + 1],
+          _mm256_cvtepu16_epi32(_mm256_extracti128_si256(pred, 1)));
+      __m256i res = _mm256_packus_epi32(lo, hi);
+      res = _mm256_min_epu16(_mm256_permute4x64_epi64(res, 0xd8), max);
+      _mm256_storeu_si256((__m256i *)(output + c), res);
+    }
+    in += 8;
+    output += stride;
+  }
+}
+
+void av1_inv_txfm2d_add_64x64_avx2(const int32_t *coeff, uint16_t *output,
+                                   int stride, int tx_type, int bd) {
+  DECLARE_ALIGNED(32, int32_t, txfm_buf[2][4096]);
+  __m256i *in = (__m256i *)txfm_buf[0];
+  __m256i *out = (__m256i *)txfm_buf[1];
+  const TXFM_2D_CFG *cfg = NULL;
+  int i;
+
+  switch (tx_type) {
+    case DCT_DCT:
+      cfg = &inv_txfm_2d_cfg_dct_dct_64;
+      for (i = 0; i < 512; ++i)
+        in[i] = _mm256_loadu_si256((const __m256i *)coeff + i);
+      transpose_32_avx2(64, in, out);
+      av1_idct64_new_avx2(out, in, cfg->cos_bit_row, cfg->stage_range_row);
+      round_shift_array_32_avx2(in, in, 512, -cfg->shift[0]);
+      transpose_32_avx2(64, in, out);
+      av1_idct64_new_avx2(out, in, cfg->cos_bit_col, cfg->stage_range_col);
+      round_shift_array_32_avx2(in, in, 512, -cfg->shift[1]);
+      write_buffer_64x64(in, output, stride, bd);
+      break;
+    default: assert(0);
+  }
+}
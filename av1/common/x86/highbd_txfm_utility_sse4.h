@@ -89,4 +89,23 @@ static INLINE __m128i half_btf_sse4_1(__m128i w0, __m128i n0, __m128i w1,
   return x;
 }
 
+// Multiplies each 32-bit lane of a by c with a full 64-bit product: the even
+// lanes' products land in *even, the odd lanes' in *odd.
+static INLINE void mul_epi32_64(__m128i a, __m128i c, __m128i *even,
+                                __m128i *odd) {
+  *even = _mm_mul_epi32(a, c);
+  *odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), c);
+}
+
+// Packs ROUND_POWER_OF_TWO(x, bit) of the 64-bit even/odd products from
+// mul_epi32_64() back into 32-bit lanes.
+// Note:
+//  rounding = 1 << (bit - 1), as 64-bit lanes
+static INLINE __m128i round_shift_epi64_pair(__m128i even, __m128i odd,
+                                             __m128i rounding, int bit) {
+  even = _mm_srli_epi64(_mm_add_epi64(even, rounding), bit);
+  odd = _mm_slli_epi64(_mm_add_epi64(odd, rounding), 32 - bit);
+  return _mm_blend_epi16(even, odd, 0xCC);
+}
+
 #endif  // _HIGHBD_TXFM_UTILITY_SSE4_H
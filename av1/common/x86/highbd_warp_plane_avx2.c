@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "./av1_rtcd.h"
+#include "av1/common/warped_motion.h"
+#include "av1/common/x86/warp_plane_common.h"
+
+static INLINE __m256i pair_m128i(__m128i lo, __m128i hi) {
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+// Returns the filters for the positions sx0 (first 128-bit lane) and sx1
+// (second lane).
+static INLINE __m256i highbd_warp_filter2(int32_t sx0, int32_t sx1) {
+  return pair_m128i(highbd_warp_filter(sx0), highbd_warp_filter(sx1));
+}
+
+// Filters one row of two blocks at once, with the source pixels and filter
+// positions of block b in lane b. Returns pixels 0 ... 7 of the result for
+// block b in out[b], as 32-bit values.
+static INLINE void highbd_warp_horiz2(__m256i lo, __m256i hi, int32_t sx0,
+                                      int32_t sx1, int32_t alpha,
+                                      __m256i *out) {
+  // Filter even-index pixels
+  const __m256i tmp_0 = highbd_warp_filter2(sx0, sx1);
+  const __m256i tmp_2 = highbd_warp_filter2(sx0 + 2 * alpha, sx1 + 2 * alpha);
+  const __m256i tmp_4 = highbd_warp_filter2(sx0 + 4 * alpha, sx1 + 4 * alpha);
+  const __m256i tmp_6 = highbd_warp_filter2(sx0 + 6 * alpha, sx1 + 6 * alpha);
+
+  const __m256i tmp_8 = _mm256_unpacklo_epi32(tmp_0, tmp_2);
+  const __m256i tmp_10 = _mm256_unpacklo_epi32(tmp_4, tmp_6);
+  const __m256i tmp_12 = _mm256_unpackhi_epi32(tmp_0, tmp_2);
+  const __m256i tmp_14 = _mm256_unpackhi_epi32(tmp_4, tmp_6);
+
+  const __m256i coeff_0 = _mm256_unpacklo_epi64(tmp_8, tmp_10);
+  const __m256i coeff_2 = _mm256_unpackhi_epi64(tmp_8, tmp_10);
+  const __m256i coeff_4 = _mm256_unpacklo_epi64(tmp_12, tmp_14);
+  const __m256i coeff_6 = _mm256_unpackhi_epi64(tmp_12, tmp_14);
+
+  const __m256i res_0 = _mm256_madd_epi16(lo, coeff_0);
+  const __m256i res_2 =
+      _mm256_madd_epi16(_mm256_alignr_epi8(hi, lo, 4), coeff_2);
+  const __m256i res_4 =
+      _mm256_madd_epi16(_mm256_alignr_epi8(hi, lo, 8), coeff_4);
+  const __m256i res_6 =
+      _mm256_madd_epi16(_mm256_alignr_epi8(hi, lo, 12), coeff_6);
+
+  const __m256i res_even = _mm256_add_epi32(_mm256_add_epi32(res_0, res_4),
+                                            _mm256_add_epi32(res_2, res_6));
+
+  // Filter odd-index pixels
+  const __m256i tmp_1 = highbd_warp_filter2(sx0 + alpha, sx1 + alpha);
+  const __m256i tmp_3 = highbd_warp_filter2(sx0 + 3 * alpha, sx1 + 3 * alpha);
+  const __m256i tmp_5 = highbd_warp_filter2(sx0 + 5 * alpha, sx1 + 5 * alpha);
+  const __m256i tmp_7 = highbd_warp_filter2(sx0 + 7 * alpha, sx1 + 7 * alpha);
+
+  const __m256i tmp_9 = _mm256_unpacklo_epi32(tmp_1, tmp_3);
+  const __m256i tmp_11 = _mm256_unpacklo_epi32(tmp_5, tmp_7);
+  const __m256i tmp_13 = _mm256_unpackhi_epi32(tmp_1, tmp_3);
+  const __m256i tmp_15 = _mm256_unpackhi_epi32(tmp_5, tmp_7);
+
+  const __m256i coeff_1 = _mm256_unpacklo_epi64(tmp_9, tmp_11);
+  const __m256i coeff_3 = _mm256_unpackhi_epi64(tmp_9, tmp_11);
+  const __m256i coeff_5 = _mm256_unpacklo_epi64(tmp_13, tmp_15);
+  const __m256i coeff_7 = _mm256_unpackhi_epi64(tmp_13, tmp_15);
+
+  const __m256i res_1 =
+      _mm256_madd_epi16(_mm256_alignr_epi8(hi, lo, 2), coeff_1);
+  const __m256i res_3 =
+      _mm256_madd_epi16(_mm256_alignr_epi8(hi, lo, 6), coeff_3);
+  const __m256i res_5 =
+      _mm256_madd_epi16(_mm256_alignr_epi8(hi, lo, 10), coeff_5);
+  const __m256i res_7 =
+      _mm256_madd_epi16(_mm256_alignr_epi8(hi, lo, 14), coeff_7);
+
+  const __m256i res_odd = _mm256_add_epi32(_mm256_add_epi32(res_1, res_5),
+                                           _mm256_add_epi32(res_3, res_7));
+
+  // Pixels 0 ... 3 of each block, then pixels 4 ... 7 of each block.
+  const __m256i res_lo = _mm256_unpacklo_epi32(res_even, res_odd);
+  const __m256i res_hi = _mm256_unpackhi_epi32(res_even, res_odd);
+  out[0] = _mm256_permute2x128_si256(res_lo, res_hi, 0x20);
+  out[1] = _mm256_permute2x128_si256(res_lo, res_hi, 0x31);
+}
+
+// Vertical filter for one row of a block, returning pixels 0 ... 7.
+static INLINE __m128i highbd_warp_vert(const __m256i *tmp, int32_t sy,
+                                       int32_t gamma, __m256i max_val) {
+  const __m256i round_const =
+      _mm256_set1_epi32((1 << (2 * WARPEDPIXEL_FILTER_BITS)) >> 1);
+  __m128i coeffs[8];
+  __m256i sum = _mm256_setzero_si256();
+  int m;
+
+  highbd_warp_vert_coeffs(sy, gamma, coeffs);
+  for (m = 0; m < 8; ++m) {
+    const __m256i c = _mm256_cvtepi16_epi32(coeffs[m]);
+    sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(tmp[m], c));
+  }
+
+  // Round and clamp to the pixel range. Negative sums end up as 0.
+  sum = _mm256_srai_epi32(_mm256_add_epi32(sum, round_const),
+                          2 * WARPEDPIXEL_FILTER_BITS);
+  sum = _mm256_min_epu16(_mm256_packus_epi32(sum, sum), max_val);
+  return _mm256_castsi256_si128(_mm256_permute4x64_epi64(sum, 0x08));
+}
+
+void av1_highbd_warp_affine_avx2(int32_t *mat, uint16_t *ref, int width,
+                                 int height, int stride, uint16_t *pred,
+                                 int p_col, int p_row, int p_width,
+                                 int p_height, int p_stride, int subsampling_x,
+                                 int subsampling_y, int bd, int ref_frm,
+                                 int32_t alpha, int32_t beta, int32_t gamma,
+                                 int32_t delta) {
+  // Horizontal filter output of the two blocks, one row of 32-bit values per
+  // vector.
+  __m256i tmp[2][15];
+  const __m256i max_val = _mm256_set1_epi16((1 << bd) - 1);
+  int i, j, k;
+
+  for (i = 0; i < p_height; i += 8) {
+    // Filter the blocks at columns j and j + 8 together. If only one is
+    // left, it is filtered twice and stored once.
+    for (j = 0; j < p_width; j += 16) {
+      const int num_blocks = p_width - j > 8 ? 2 : 1;
+      const int j1 = j + 8 * (num_blocks - 1);
+      const WarpBlockPos pos0 = warp_block_pos(
+          mat, p_col + j + 4, p_row + i + 4, subsampling_x, subsampling_y);
+      const WarpBlockPos pos1 = warp_block_pos(
+          mat, p_col + j1 + 4, p_row + i + 4, subsampling_x, subsampling_y);
+      int b;
+
+      // Horizontal filter
+      for (k = -7; k < AOMMIN(8, p_height - i); ++k) {
+        const int iy0 = clamp(pos0.iy4 + k, 0, height - 1);
+        const int iy1 = clamp(pos1.iy4 + k, 0, height - 1);
+        __m128i lo0, hi0, lo1, hi1;
+        __m256i out[2];
+
+        highbd_warp_load_row(ref + iy0 * stride, pos0.ix4 - 7, width, &lo0,
+                             &hi0);
+        highbd_warp_load_row(ref + iy1 * stride, pos1.ix4 - 7, width, &lo1,
+                             &hi1);
+        highbd_warp_horiz2(pair_m128i(lo0, lo1), pair_m128i(hi0, hi1),
+                           pos0.sx4 + alpha * (-4) + beta * k,
+                           pos1.sx4 + alpha * (-4) + beta * k, alpha, out);
+        tmp[0][k + 7] = out[0];
+        tmp[1][k + 7] = out[1];
+      }
+
+      // Vertical filter
+      for (b = 0; b < num_blocks; ++b) {
+        const WarpBlockPos *const pos = b ? &pos1 : &pos0;
+        const int jb = j + 8 * b;
+        const int w = AOMMIN(8, p_width - jb);
+        for (k = -4; k < AOMMIN(4, p_height - i - 4); ++k) {
+          const __m128i res =
+              highbd_warp_vert(tmp[b] + k + 4,
+                               pos->sy4 + gamma * (-4) + delta * k, gamma,
+                               max_val);
+          highbd_warp_store(&pred[(i + k + 4) * p_stride + jb], res, w,
+                            ref_frm);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>
+
+#include "./av1_rtcd.h"
+#include "av1/common/warped_motion.h"
+#include "av1/common/x86/warp_plane_common.h"
+
+// Filters the pixels lo, hi (pixels 0 ... 15 of a row of the source) for the
+// eight positions starting at sx, and returns pixels 0 ... 3 of the result in
+// out[0] and 4 ... 7 in out[1], as 32-bit values.
+static INLINE void highbd_warp_horiz(__m128i lo, __m128i hi, int32_t sx,
+                                     int32_t alpha, __m128i *out) {
+  // Filter even-index pixels
+  const __m128i tmp_0 = highbd_warp_filter(sx + 0 * alpha);
+  const __m128i tmp_2 = highbd_warp_filter(sx + 2 * alpha);
+  const __m128i tmp_4 = highbd_warp_filter(sx + 4 * alpha);
+  const __m128i tmp_6 = highbd_warp_filter(sx + 6 * alpha);
+
+  // coeffs 0 1 0 1 2 3 2 3 for pixels 0, 2
+  const __m128i tmp_8 = _mm_unpacklo_epi32(tmp_0, tmp_2);
+  // coeffs 0 1 0 1 2 3 2 3 for pixels 4, 6
+  const __m128i tmp_10 = _mm_unpacklo_epi32(tmp_4, tmp_6);
+  // coeffs 4 5 4 5 6 7 6 7 for pixels 0, 2
+  const __m128i tmp_12 = _mm_unpackhi_epi32(tmp_0, tmp_2);
+  // coeffs 4 5 4 5 6 7 6 7 for pixels 4, 6
+  const __m128i tmp_14 = _mm_unpackhi_epi32(tmp_4, tmp_6);
+
+  const __m128i coeff_0 = _mm_unpacklo_epi64(tmp_8, tmp_10);
+  const __m128i coeff_2 = _mm_unpackhi_epi64(tmp_8, tmp_10);
+  const __m128i coeff_4 = _mm_unpacklo_epi64(tmp_12, tmp_14);
+  const __m128i coeff_6 = _mm_unpackhi_epi64(tmp_12, tmp_14);
+
+  const __m128i res_0 = _mm_madd_epi16(lo, coeff_0);
+  const __m128i res_2 = _mm_madd_epi16(_mm_alignr_epi8(hi, lo, 4), coeff_2);
+  const __m128i res_4 = _mm_madd_epi16(_mm_alignr_epi8(hi, lo, 8), coeff_4);
+  const __m128i res_6 = _mm_madd_epi16(_mm_alignr_epi8(hi, lo, 12), coeff_6);
+
+  const __m128i res_even = _mm_add_epi32(_mm_add_epi32(res_0, res_4),
+                                         _mm_add_epi32(res_2, res_6));
+
+  // Filter odd-index pixels
+  const __m128i tmp_1 = highbd_warp_filter(sx + 1 * alpha);
+  const __m128i tmp_3 = highbd_warp_filter(sx + 3 * alpha);
+  const __m128i tmp_5 = highbd_warp_filter(sx + 5 * alpha);
+  const __m128i tmp_7 = highbd_warp_filter(sx + 7 * alpha);
+
+  const __m128i tmp_9 = _mm_unpacklo_epi32(tmp_1, tmp_3);
+  const __m128i tmp_11 = _mm_unpacklo_epi32(tmp_5, tmp_7);
+  const __m128i tmp_13 = _mm_unpackhi_epi32(tmp_1, tmp_3);
+  const __m128i tmp_15 = _mm_unpackhi_epi32(tmp_5, tmp_7);
+
+  const __m128i coeff_1 = _mm_unpacklo_epi64(tmp_9, tmp_11);
+  const __m128i coeff_3 = _mm_unpackhi_epi64(tmp_9, tmp_11);
+  const __m128i coeff_5 = _mm_unpacklo_epi64(tmp_13, tmp_15);
+  const __m128i coeff_7 = _mm_unpackhi_epi64(tmp_13, tmp_15);
+
+  const __m128i res_1 = _mm_madd_epi16(_mm_alignr_epi8(hi, lo, 2), coeff_1);
+  const __m128i res_3 = _mm_madd_epi16(_mm_alignr_epi8(hi, lo, 6), coeff_3);
+  const __m128i res_5 = _mm_madd_epi16(_mm_alignr_epi8(hi, lo, 10), coeff_5);
+  const __m128i res_7 = _mm_madd_epi16(_mm_alignr_epi8(hi, lo, 14), coeff_7);
+
+  const __m128i res_odd = _mm_add_epi32(_mm_add_epi32(res_1, res_5),
+                                        _mm_add_epi32(res_3, res_7));
+
+  // Rearrange pixels back into the order 0 ... 7
+  out[0] = _mm_unpacklo_epi32(res_even, res_odd);
+  out[1] = _mm_unpackhi_epi32(res_even, res_odd);
+}
+
+void av1_highbd_warp_affine_sse4_1(int32_t *mat, uint16_t *ref, int width,
+                                   int height, int stride, uint16_t *pred,
+                                   int p_col, int p_row, int p_width,
+                                   int p_height, int p_stride,
+                                   int subsampling_x, int subsampling_y,
+                                   int bd, int ref_frm, int32_t alpha,
+                                   int32_t beta, int32_t gamma,
+                                   int32_t delta) {
+  // The output of the horizontal filter does not fit in 16 bits, so each row
+  // is kept as two vectors of four 32-bit values.
+  __m128i tmp[15][2];
+  const __m128i round_const =
+      _mm_set1_epi32((1 << (2 * WARPEDPIXEL_FILTER_BITS)) >> 1);
+  const __m128i max_val = _mm_set1_epi16((1 << bd) - 1);
+  int i, j, k, m;
+
+  for (i = 0; i < p_height; i += 8) {
+    for (j = 0; j < p_width; j += 8) {
+      const WarpBlockPos pos = warp_block_pos(mat, p_col + j + 4,
+                                              p_row + i + 4, subsampling_x,
+                                              subsampling_y);
+      const int w = AOMMIN(8, p_width - j);
+
+      // Horizontal filter
+      for (k = -7; k < AOMMIN(8, p_height - i); ++k) {
+        const int iy = clamp(pos.iy4 + k, 0, height - 1);
+        __m128i lo, hi;
+        highbd_warp_load_row(ref + iy * stride, pos.ix4 - 7, width, &lo, &hi);
+        highbd_warp_horiz(lo, hi, pos.sx4 + alpha * (-4) + beta * k, alpha,
+                          tmp[k + 7]);
+      }
+
+      // Vertical filter
+      for (k = -4; k < AOMMIN(4, p_height - i - 4); ++k) {
+        const int32_t sy = pos.sy4 + gamma * (-4) + delta * k;
+        __m128i coeffs[8];
+        __m128i sum_lo = _mm_setzero_si128();
+        __m128i sum_hi = _mm_setzero_si128();
+        __m128i res;
+
+        highbd_warp_vert_coeffs(sy, gamma, coeffs);
+        for (m = 0; m < 8; ++m) {
+          const __m128i *src = tmp[k + m + 4];
+          const __m128i c_lo = _mm_cvtepi16_epi32(coeffs[m]);
+          const __m128i c_hi = _mm_cvtepi16_epi32(_mm_srli_si128(coeffs[m], 8));
+          sum_lo = _mm_add_epi32(sum_lo, _mm_mullo_epi32(src[0], c_lo));
+          sum_hi = _mm_add_epi32(sum_hi, _mm_mullo_epi32(src[1], c_hi));
+        }
+
+        // Round and clamp to the pixel range. Negative sums end up as 0.
+        sum_lo = _mm_srai_epi32(_mm_add_epi32(sum_lo, round_const),
+                                2 * WARPEDPIXEL_FILTER_BITS);
+        sum_hi = _mm_srai_epi32(_mm_add_epi32(sum_hi, round_const),
+                                2 * WARPEDPIXEL_FILTER_BITS);
+        res = _mm_min_epu16(_mm_packus_epi32(sum_lo, sum_hi), max_val);
+
+        highbd_warp_store(&pred[(i + k + 4) * p_stride + j], res, w, ref_frm);
+      }
+    }
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>  // sse4.1
+#include <string.h>
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/mem.h"
+#include "av1/common/restoration.h"
+
+// The Wiener filters are symmetric, so the taps are applied to the sums of
+// the mirrored pixels: (f0, f1) to (p0 + p6, p1 + p5) and (f2, f3) to
+// (p2 + p4, p3), two taps per _mm_madd_epi16. The sums of two 12-bit pixels
+// still fit in 16 bits.
+static void highbd_wiener_filter_rows(const uint16_t *src,
+                                      ptrdiff_t src_stride, uint16_t *dst,
+                                      ptrdiff_t dst_stride, int w, int h,
+                                      ptrdiff_t tap_stride,
+                                      const int16_t *filter, int bd) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i round = _mm_set1_epi32(1 << (WIENER_FILT_PREC_BITS - 1));
+  const __m128i max_val = _mm_set1_epi16((1 << bd) - 1);
+  const __m128i c01 = _mm_set1_epi32(
+      (int)((uint16_t)filter[0] | ((uint32_t)(uint16_t)filter[1] << 16)));
+  const __m128i c23 = _mm_set1_epi32(
+      (int)((uint16_t)filter[2] | ((uint32_t)(uint16_t)filter[3] << 16)));
+  __m128i p[WIENER_WIN];
+  int i, j, k;
+
+  for (i = 0; i < h; ++i) {
+    const uint16_t *const src_p =
+        src + i * src_stride - WIENER_HALFWIN * tap_stride;
+    uint16_t *const dst_p = dst + i * dst_stride;
+    for (j = 0; j + 8 <= w; j += 8) {
+      __m128i s06, s15, s24, lo, hi;
+      for (k = 0; k < WIENER_WIN; ++k)
+        p[k] = _mm_loadu_si128((const __m128i *)(src_p + k * tap_stride + j));
+      s06 = _mm_add_epi16(p[0], p[6]);
+      s15 = _mm_add_epi16(p[1], p[5]);
+      s24 = _mm_add_epi16(p[2], p[4]);
+      lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(s06, s15), c01),
+                         _mm_madd_epi16(_mm_unpacklo_epi16(s24, p[3]), c23));
+      hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(s06, s15), c01),
+                         _mm_madd_epi16(_mm_unpackhi_epi16(s24, p[3]), c23));
+      lo = _mm_srai_epi32(_mm_add_epi32(lo, round), WIENER_FILT_PREC_BITS);
+      hi = _mm_srai_epi32(_mm_add_epi32(hi, round), WIENER_FILT_PREC_BITS);
+      lo = _mm_add_epi32(lo, _mm_unpacklo_epi16(p[3], zero));
+      hi = _mm_add_epi32(hi, _mm_unpackhi_epi16(p[3], zero));
+      _mm_storeu_si128((__m128i *)(dst_p + j),
+                       _mm_min_epu16(_mm_packus_epi32(lo, hi), max_val));
+    }
+    for (; j < w; ++j) {
+      int sum = 0;
+      for (k = 0; k < WIENER_WIN; ++k)
+        sum += src_p[k * tap_stride + j] * filter[k];
+      dst_p[j] = clip_pixel_highbd(
+          ROUND_POWER_OF_TWO(sum, WIENER_FILT_PREC_BITS) +
+              src_p[WIENER_HALFWIN * tap_stride + j],
+          bd);
+    }
+  }
+}
+
+void av1_highbd_wiener_convolve_add_src_sse4_1(
+    const uint16_t *src, ptrdiff_t src_stride, uint16_t *dst,
+    ptrdiff_t dst_stride, const int16_t *filter_x, const int16_t *filter_y,
+    int w, int h, int bd) {
+  DECLARE_ALIGNED(16, uint16_t, temp[(WIENER_STRIPE_HEIGHT + WIENER_WIN - 1) *
+                                     WIENER_STRIPE_WIDTH]);
+  int i, j;
+  for (j = 0; j < w; j += WIENER_STRIPE_WIDTH) {
+    const int sw = AOMMIN(WIENER_STRIPE_WIDTH, w - j);
+    highbd_wiener_filter_rows(src - WIENER_HALFWIN * src_stride + j,
+                              src_stride, temp, sw, sw, WIENER_WIN - 1, 1,
+                              filter_x, bd);
+    for (i = 0; i < h; i += WIENER_STRIPE_HEIGHT) {
+      const int sh = AOMMIN(WIENER_STRIPE_HEIGHT, h - i);
+      highbd_wiener_filter_rows(src + (i + WIENER_HALFWIN) * src_stride + j,
+                                src_stride, temp + (WIENER_WIN - 1) * sw, sw,
+                                sw, sh, 1, filter_x, bd);
+      highbd_wiener_filter_rows(temp + WIENER_HALFWIN * sw, sw,
+                                dst + i * dst_stride + j, dst_stride, sw, sh,
+                                sw, filter_y, bd);
+      memmove(temp, temp + sh * sw, (WIENER_WIN - 1) * sw * sizeof(*temp));
+    }
+  }
+}
@@ -15,6 +15,8 @@
 #include "./av1_rtcd.h"
 
 #include "aom_dsp/x86/txfm_common_avx2.h"
+#include "av1/common/av1_inv_txfm2d_cfg.h"
+#include "av1/common/x86/av1_txfm1d_avx2.h"
 
 static INLINE void load_coeff(const tran_low_t *coeff, __m256i *in) {
 #if CONFIG_AOM_HIGHBITDEPTH
@@ -501,3 +503,339 @@ void av1_iht16x16_256_add_avx2(const tran_low_t *input, uint8_t *dest,
   }
   write_buffer_16x16(in, stride, dest);
 }
+
+#if CONFIG_EXT_TX
+// The 32-element transforms below work across in[0..31], one element per
+// register, like idct16_avx2(). They do not transpose their input.
+static void idct32_avx2(__m256i *in) {
+  const __m256i cospi_p31_m01 = pair256_set_epi16(cospi_31_64, -cospi_1_64);
+  const __m256i cospi_p01_p31 = pair256_set_epi16(cospi_1_64, cospi_31_64);
+  const __m256i cospi_p15_m17 = pair256_set_epi16(cospi_15_64, -cospi_17_64);
+  const __m256i cospi_p17_p15 = pair256_set_epi16(cospi_17_64, cospi_15_64);
+  const __m256i cospi_p23_m09 = pair256_set_epi16(cospi_23_64, -cospi_9_64);
+  const __m256i cospi_p09_p23 = pair256_set_epi16(cospi_9_64, cospi_23_64);
+  const __m256i cospi_p07_m25 = pair256_set_epi16(cospi_7_64, -cospi_25_64);
+  const __m256i cospi_p25_p07 = pair256_set_epi16(cospi_25_64, cospi_7_64);
+  const __m256i cospi_p27_m05 = pair256_set_epi16(cospi_27_64, -cospi_5_64);
+  const __m256i cospi_p05_p27 = pair256_set_epi16(cospi_5_64, cospi_27_64);
+  const __m256i cospi_p11_m21 = pair256_set_epi16(cospi_11_64, -cospi_21_64);
+  const __m256i cospi_p21_p11 = pair256_set_epi16(cospi_21_64, cospi_11_64);
+  const __m256i cospi_p19_m13 = pair256_set_epi16(cospi_19_64, -cospi_13_64);
+  const __m256i cospi_p13_p19 = pair256_set_epi16(cospi_13_64, cospi_19_64);
+  const __m256i cospi_p03_m29 = pair256_set_epi16(cospi_3_64, -cospi_29_64);
+  const __m256i cospi_p29_p03 = pair256_set_epi16(cospi_29_64, cospi_3_64);
+  const __m256i cospi_m04_p28 = pair256_set_epi16(-cospi_4_64, cospi_28_64);
+  const __m256i cospi_p28_p04 = pair256_set_epi16(cospi_28_64, cospi_4_64);
+  const __m256i cospi_m28_m04 = pair256_set_epi16(-cospi_28_64, -cospi_4_64);
+  const __m256i cospi_m20_p12 = pair256_set_epi16(-cospi_20_64, cospi_12_64);
+  const __m256i cospi_p12_p20 = pair256_set_epi16(cospi_12_64, cospi_20_64);
+  const __m256i cospi_m12_m20 = pair256_set_epi16(-cospi_12_64, -cospi_20_64);
+  const __m256i cospi_m08_p24 = pair256_set_epi16(-cospi_8_64, cospi_24_64);
+  const __m256i cospi_p24_p08 = pair256_set_epi16(cospi_24_64, cospi_8_64);
+  const __m256i cospi_m24_m08 = pair256_set_epi16(-cospi_24_64, -cospi_8_64);
+  const __m256i cospi_m16_p16 = pair256_set_epi16(-cospi_16_64, cospi_16_64);
+  const __m256i cospi_p16_p16 = _mm256_set1_epi16((int16_t)cospi_16_64);
+  __m256i even[16], s[32], t[32];
+  int i;
+
+  // The even half is a 16-point idct of the even inputs
+  for (i = 0; i < 16; ++i) even[i] = in[2 * i];
+  idct16_avx2(even);
+
+  // stage 1, (16-31)
+  unpack_butter_fly(&in[1], &in[31], &cospi_p31_m01, &cospi_p01_p31, &s[16],
+                    &s[31]);
+  unpack_butter_fly(&in[17], &in[15], &cospi_p15_m17, &cospi_p17_p15, &s[17],
+                    &s[30]);
+  unpack_butter_fly(&in[9], &in[23], &cospi_p23_m09, &cospi_p09_p23, &s[18],
+                    &s[29]);
+  unpack_butter_fly(&in[25], &in[7], &cospi_p07_m25, &cospi_p25_p07, &s[19],
+                    &s[28]);
+  unpack_butter_fly(&in[5], &in[27], &cospi_p27_m05, &cospi_p05_p27, &s[20],
+                    &s[27]);
+  unpack_butter_fly(&in[21], &in[11], &cospi_p11_m21, &cospi_p21_p11, &s[21],
+                    &s[26]);
+  unpack_butter_fly(&in[13], &in[19], &cospi_p19_m13, &cospi_p13_p19, &s[22],
+                    &s[25]);
+  unpack_butter_fly(&in[29], &in[3], &cospi_p03_m29, &cospi_p29_p03, &s[23],
+                    &s[24]);
+
+  // stage 2, (16-31)
+  for (i = 16; i < 32; i += 4) {
+    t[i + 0] = _mm256_add_epi16(s[i + 0], s[i + 1]);
+    t[i + 1] = _mm256_sub_epi16(s[i + 0], s[i + 1]);
+    t[i + 2] = _mm256_sub_epi16(s[i + 3], s[i + 2]);
+    t[i + 3] = _mm256_add_epi16(s[i + 2], s[i + 3]);
+  }
+
+  // stage 3, (16-31)
+  s[16] = t[16];
+  s[19] = t[19];
+  s[20] = t[20];
+  s[23] = t[23];
+  s[24] = t[24];
+  s[27] = t[27];
+  s[28] = t[28];
+  s[31] = t[31];
+  unpack_butter_fly(&t[17], &t[30], &cospi_m04_p28, &cospi_p28_p04, &s[17],
+                    &s[30]);
+  unpack_butter_fly(&t[18], &t[29], &cospi_m28_m04, &cospi_m04_p28, &s[18],
+                    &s[29]);
+  unpack_butter_fly(&t[21], &t[26], &cospi_m20_p12, &cospi_p12_p20, &s[21],
+                    &s[26]);
+  unpack_butter_fly(&t[22], &t[25], &cospi_m12_m20, &cospi_m20_p12, &s[22],
+                    &s[25]);
+
+  // stage 4, (16-31)
+  for (i = 16; i < 32; i += 8) {
+    t[i + 0] = _mm256_add_epi16(s[i + 0], s[i + 3]);
+    t[i + 1] = _mm256_add_epi16(s[i + 1], s[i + 2]);
+    t[i + 2] = _mm256_sub_epi16(s[i + 1], s[i + 2]);
+    t[i + 3] = _mm256_sub_epi16(s[i + 0], s[i + 3]);
+    t[i + 4] = _mm256_sub_epi16(s[i + 7], s[i + 4]);
+    t[i + 5] = _mm256_sub_epi16(s[i + 6], s[i + 5]);
+    t[i + 6] = _mm256_add_epi16(s[i + 5], s[i + 6]);
+    t[i + 7] = _mm256_add_epi16(s[i + 4], s[i + 7]);
+  }
+
+  // stage 5, (16-31)
+  s[16] = t[16];
+  s[17] = t[17];
+  s[22] = t[22];
+  s[23] = t[23];
+  s[24] = t[24];
+  s[25] = t[25];
+  s[30] = t[30];
+  s[31] = t[31];
+  unpack_butter_fly(&t[18], &t[29], &cospi_m08_p24, &cospi_p24_p08, &s[18],
+                    &s[29]);
+  unpack_butter_fly(&t[19], &t[28], &cospi_m08_p24, &cospi_p24_p08, &s[19],
+                    &s[28]);
+  unpack_butter_fly(&t[20], &t[27], &cospi_m24_m08, &cospi_m08_p24, &s[20],
+                    &s[27]);
+  unpack_butter_fly(&t[21], &t[26], &cospi_m24_m08, &cospi_m08_p24, &s[21],
+                    &s[26]);
+
+  // stage 6, (16-31)
+  for (i = 0; i < 4; ++i) {
+    t[16 + i] = _mm256_add_epi16(s[16 + i], s[23 - i]);
+    t[23 - i] = _mm256_sub_epi16(s[16 + i], s[23 - i]);
+    t[24 + i] = _mm256_sub_epi16(s[31 - i], s[24 + i]);
+    t[31 - i] = _mm256_add_epi16(s[24 + i], s[31 - i]);
+  }
+
+  // stage 7, (16-31)
+  for (i = 16; i < 20; ++i) {
+    s[i] = t[i];
+    s[i + 12] = t[i + 12];
+  }
+  for (i = 20; i < 24; ++i) {
+    unpack_butter_fly(&t[i], &t[47 - i], &cospi_m16_p16, &cospi_p16_p16, &s[i],
+                      &s[47 - i]);
+  }
+
+  // final stage
+  for (i = 0; i < 16; ++i) {
+    in[i] = _mm256_add_epi16(even[i], s[31 - i]);
+    in[31 - i] = _mm256_sub_epi16(even[i], s[31 - i]);
+  }
+}
+
+static void ihalfright32_avx2(__m256i *in) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i sqrt2 = _mm256_set1_epi16((int16_t)Sqrt2);
+  __m256i tmp[16], u0, u1;
+  int i;
+
+  for (i = 0; i < 16; ++i) {
+    // ROUND_POWER_OF_TWO(in * Sqrt2, DCT_CONST_BITS)
+    u0 = _mm256_madd_epi16(_mm256_unpacklo_epi16(in[i], zero), sqrt2);
+    u1 = _mm256_madd_epi16(_mm256_unpackhi_epi16(in[i], zero), sqrt2);
+    group_rounding(&u0, 1);
+    group_rounding(&u1, 1);
+    tmp[i] = _mm256_packs_epi32(u0, u1);
+    in[i] = _mm256_slli_epi16(in[i + 16], 2);
+  }
+  idct16_avx2(tmp);
+  for (i = 0; i < 16; ++i) in[i + 16] = tmp[i];
+}
+
+static void iidtx32_avx2(__m256i *in) {
+  int i;
+  for (i = 0; i < 32; ++i) in[i] = _mm256_slli_epi16(in[i], 2);
+}
+
+void av1_iht32x32_1024_add_avx2(const tran_low_t *input, uint8_t *dest,
+                                int stride, int tx_type) {
+  void (*row_txfm)(__m256i *in);
+  void (*col_txfm)(__m256i *in);
+  // in[] holds four 16x16 blocks, in[0..31] are the top two and in[32..63]
+  // the bottom two.
+  __m256i in[64], col[32];
+  int lr_flip = 0;
+  int i, j;
+
+  switch (tx_type) {
+    case DCT_DCT:
+      row_txfm = idct32_avx2;
+      col_txfm = idct32_avx2;
+      break;
+    case ADST_DCT:
+    case FLIPADST_DCT:
+      row_txfm = idct32_avx2;
+      col_txfm = ihalfright32_avx2;
+      break;
+    case DCT_ADST:
+    case DCT_FLIPADST:
+      row_txfm = ihalfright32_avx2;
+      col_txfm = idct32_avx2;
+      break;
+    case ADST_ADST:
+    case FLIPADST_FLIPADST:
+    case ADST_FLIPADST:
+    case FLIPADST_ADST:
+      row_txfm = ihalfright32_avx2;
+      col_txfm = ihalfright32_avx2;
+      break;
+    case IDTX:
+      row_txfm = iidtx32_avx2;
+      col_txfm = iidtx32_avx2;
+      break;
+    case V_DCT:
+      row_txfm = iidtx32_avx2;
+      col_txfm = idct32_avx2;
+      break;
+    case H_DCT:
+      row_txfm = idct32_avx2;
+      col_txfm = iidtx32_avx2;
+      break;
+    case V_ADST:
+    case V_FLIPADST:
+      row_txfm = iidtx32_avx2;
+      col_txfm = ihalfright32_avx2;
+      break;
+    case H_ADST:
+    case H_FLIPADST:
+      row_txfm = ihalfright32_avx2;
+      col_txfm = iidtx32_avx2;
+      break;
+    default: assert(0); return;
+  }
+
+  for (i = 0; i < 32; ++i) {
+    load_coeff(input + i * 32, &in[(i >> 4) * 32 + (i & 15)]);
+    load_coeff(input + i * 32 + 16, &in[(i >> 4) * 32 + 16 + (i & 15)]);
+  }
+
+  // Row transform, 16 rows at a time
+  for (i = 0; i < 64; i += 32) {
+    mm256_transpose_16x16(in + i);
+    mm256_transpose_16x16(in + i + 16);
+    row_txfm(in + i);
+    mm256_transpose_16x16(in + i);
+    mm256_transpose_16x16(in + i + 16);
+  }
+
+  switch (tx_type) {
+    case FLIPADST_DCT:
+    case FLIPADST_ADST:
+    case V_FLIPADST: flip_col(&dest, &stride, 32); break;
+    case DCT_FLIPADST:
+    case ADST_FLIPADST:
+    case H_FLIPADST: lr_flip = 1; break;
+    case FLIPADST_FLIPADST:
+      lr_flip = 1;
+      flip_col(&dest, &stride, 32);
+      break;
+    default: break;
+  }
+
+  // Column transform, 16 columns at a time
+  for (j = 0; j < 2; ++j) {
+    uint8_t *const d = dest + 16 * (lr_flip ? 1 - j : j);
+    for (i = 0; i < 16; ++i) {
+      col[i] = in[16 * j + i];
+      col[i + 16] = in[32 + 16 * j + i];
+    }
+    col_txfm(col);
+    if (lr_flip) flip_row(col, 32);
+    write_buffer_16x16(col, stride, d);
+    write_buffer_16x16(col + 16, stride, d + 16 * stride);
+  }
+}
+#endif  // CONFIG_EXT_TX
+
+#if CONFIG_TX64X64
+// tran_low_t is 16 bits without CONFIG_AOM_HIGHBITDEPTH, and the C code
+// truncates the output of each 1D transform to it.
+static INLINE __m256i wrap_tran_low_avx2(__m256i x) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  return x;
+#else
+  return _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+static INLINE __m256i load_coeff_32(const tran_low_t *coeff) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  return _mm256_loadu_si256((const __m256i *)coeff);
+#else
+  return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)coeff));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+// Uses the same 1D transforms as av1_inv_txfm2d_add_64x64_avx2(), with the
+// rounding of av1_iht64x64_4096_add_c() in between. Only DCT_DCT has a SIMD
+// path.
+void av1_iht64x64_4096_add_avx2(const tran_low_t *input, uint8_t *dest,
+                                int stride, int tx_type) {
+  DECLARE_ALIGNED(32, int32_t, txfm_buf[2][4096]);
+  __m256i *buf = (__m256i *)txfm_buf[0];
+  __m256i *tmp = (__m256i *)txfm_buf[1];
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i rounding = _mm256_set1_epi32(1 << 4);
+  int i, j;
+
+  if (tx_type != DCT_DCT) {
+    av1_iht64x64_4096_add_c(input, dest, stride, tx_type);
+    return;
+  }
+
+  for (i = 0; i < 512; ++i) tmp[i] = load_coeff_32(input + i * 8);
+
+  // Rows
+  transpose_32_avx2(64, tmp, buf);
+  av1_idct64_new_avx2(buf, tmp, inv_cos_bit_row_dct_dct_64,
+                      inv_stage_range_row_dct_dct_64);
+  for (i = 0; i < 512; ++i) {
+    tmp[i] =
+        _mm256_srai_epi32(_mm256_add_epi32(wrap_tran_low_avx2(tmp[i]), one), 1);
+  }
+
+  // Columns
+  transpose_32_avx2(64, tmp, buf);
+  av1_idct64_new_avx2(buf, tmp, inv_cos_bit_col_dct_dct_64,
+                      inv_stage_range_col_dct_dct_64);
+
+  // Sum with the destination, 16 pixels at a time
+  for (i = 0; i < 64; ++i) {
+    for (j = 0; j < 8; j += 2) {
+      const __m256i r0 = _mm256_srai_epi32(
+          _mm256_add_epi32(wrap_tran_low_avx2(tmp[i * 8 + j]), rounding), 5);
+      const __m256i r1 = _mm256_srai_epi32(
+          _mm256_add_epi32(wrap_tran_low_avx2(tmp[i * 8 + j + 1]), rounding),
+          5);
+      const __m256i res =
+          _mm256_permute4x64_epi64(_mm256_packs_epi32(r0, r1), 0xd8);
+      uint8_t *const d = dest + i * stride + j * 8;
+      const __m256i pred =
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)d));
+      const __m256i sum = _mm256_add_epi16(pred, res);
+      const __m256i out =
+          _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+      _mm_storeu_si128((__m128i *)d, _mm256_castsi256_si128(out));
+    }
+  }
+  _mm256_zeroupper();
+}
+#endif  // CONFIG_TX64X64
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_COMMON_X86_HYBRID_TXFM32_AVX2_H_
+#define AV1_COMMON_X86_HYBRID_TXFM32_AVX2_H_
+
+#include <immintrin.h>  // avx2
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/txfm_common.h"
+
+// Eight lanes per vector, so only shapes at least 8 wide and 8 tall can be
+// handled with these; the 4-point shapes use the 128-bit versions.
+#define HBD_LANES 8
+
+typedef __m256i hbd_vec;
+
+typedef struct {
+  __m256i even, odd;
+} hbd_vec64;
+
+static INLINE hbd_vec hbd_add(hbd_vec a, hbd_vec b) {
+  return _mm256_add_epi32(a, b);
+}
+
+static INLINE hbd_vec hbd_sub(hbd_vec a, hbd_vec b) {
+  return _mm256_sub_epi32(a, b);
+}
+
+static INLINE hbd_vec hbd_sll(hbd_vec a, int n) {
+  return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n));
+}
+
+static INLINE hbd_vec hbd_sra(hbd_vec a, int n) {
+  return _mm256_sra_epi32(a, _mm_cvtsi32_si128(n));
+}
+
+static INLINE hbd_vec hbd_set1(int v) { return _mm256_set1_epi32(v); }
+
+static INLINE hbd_vec hbd_set_lane0(int v) {
+  return _mm256_setr_epi32(v, 0, 0, 0, 0, 0, 0, 0);
+}
+
+static INLINE hbd_vec64 hbd_mul64(hbd_vec a, int c) {
+  const __m256i cc = _mm256_set1_epi32(c);
+  hbd_vec64 r;
+  r.even = _mm256_mul_epi32(a, cc);
+  r.odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), cc);
+  return r;
+}
+
+static INLINE hbd_vec64 hbd_add64(hbd_vec64 a, hbd_vec64 b) {
+  hbd_vec64 r;
+  r.even = _mm256_add_epi64(a.even, b.even);
+  r.odd = _mm256_add_epi64(a.odd, b.odd);
+  return r;
+}
+
+static INLINE hbd_vec64 hbd_sub64(hbd_vec64 a, hbd_vec64 b) {
+  hbd_vec64 r;
+  r.even = _mm256_sub_epi64(a.even, b.even);
+  r.odd = _mm256_sub_epi64(a.odd, b.odd);
+  return r;
+}
+
+static INLINE hbd_vec hbd_round64(hbd_vec64 a) {
+  const __m256i rounding = _mm256_set1_epi64x(DCT_CONST_ROUNDING);
+  const __m256i even =
+      _mm256_srli_epi64(_mm256_add_epi64(a.even, rounding), DCT_CONST_BITS);
+  const __m256i odd = _mm256_slli_epi64(_mm256_add_epi64(a.odd, rounding),
+                                        32 - DCT_CONST_BITS);
+  return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+static INLINE hbd_vec hbd_reverse(hbd_vec a) {
+  return _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1,
+                                                          0));
+}
+
+static INLINE void hbd_transpose(const hbd_vec *in, hbd_vec *out) {
+  const __m256i t0 = _mm256_unpacklo_epi32(in[0], in[1]);
+  const __m256i t1 = _mm256_unpackhi_epi32(in[0], in[1]);
+  const __m256i t2 = _mm256_unpacklo_epi32(in[2], in[3]);
+  const __m256i t3 = _mm256_unpackhi_epi32(in[2], in[3]);
+  const __m256i t4 = _mm256_unpacklo_epi32(in[4], in[5]);
+  const __m256i t5 = _mm256_unpackhi_epi32(in[4], in[5]);
+  const __m256i t6 = _mm256_unpacklo_epi32(in[6], in[7]);
+  const __m256i t7 = _mm256_unpackhi_epi32(in[6], in[7]);
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  out[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  out[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  out[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  out[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  out[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  out[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  out[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  out[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+static INLINE hbd_vec hbd_load_row(const int16_t *src) {
+  return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+static INLINE void hbd_store_row(tran_low_t *dst, hbd_vec a) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  _mm256_storeu_si256((__m256i *)dst, a);
+#else
+  // packs works within 128-bit lanes: gather qwords 0 and 2.
+  a = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, a), 0x08);
+  _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(a));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+#include "av1/common/x86/hybrid_txfm32_common.h"
+
+#endif  // AV1_COMMON_X86_HYBRID_TXFM32_AVX2_H_
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_COMMON_X86_HYBRID_TXFM32_COMMON_H_
+#define AV1_COMMON_X86_HYBRID_TXFM32_COMMON_H_
+
+// Helpers shared by the hybrid transforms that work on vectors of 32-bit
+// lanes, built on the primitives of hybrid_txfm32_{sse2,sse4,avx2}.h, which
+// include this file after defining:
+//   HBD_LANES      number of 32-bit lanes in a vector
+//   hbd_vec        the vector type
+//   hbd_vec64      a pair of vectors holding the 64-bit products of the even
+//                  and the odd lanes
+// and the static INLINE functions:
+//   hbd_vec hbd_add(hbd_vec a, hbd_vec b)       a + b
+//   hbd_vec hbd_sub(hbd_vec a, hbd_vec b)       a - b
+//   hbd_vec hbd_sll(hbd_vec a, int n)           a << n
+//   hbd_vec hbd_sra(hbd_vec a, int n)           a >> n, arithmetic
+//   hbd_vec hbd_set1(int v)                     v in every lane
+//   hbd_vec hbd_set_lane0(int v)                v in lane 0, 0 elsewhere
+//   hbd_vec64 hbd_mul64(hbd_vec a, int c)       a * c, widened
+//   hbd_vec64 hbd_add64(hbd_vec64 a, hbd_vec64 b)
+//   hbd_vec64 hbd_sub64(hbd_vec64 a, hbd_vec64 b)
+//   hbd_vec hbd_round64(hbd_vec64 a)            dct_const_round_shift(a)
+//   hbd_vec hbd_reverse(hbd_vec a)              lanes in reverse order
+//   void hbd_transpose(const hbd_vec *in, hbd_vec *out)
+//                  transposes a HBD_LANES x HBD_LANES block
+//   hbd_vec hbd_load_row(const int16_t *src)    HBD_LANES values, widened
+//   void hbd_store_row(tran_low_t *dst, hbd_vec a)
+
+#include "./aom_config.h"
+#include "aom_dsp/txfm_common.h"
+#include "av1/common/enums.h"
+
+static INLINE hbd_vec hbd_neg(hbd_vec a) { return hbd_sub(hbd_sub(a, a), a); }
+
+static INLINE hbd_vec64 hbd_madd64(hbd_vec a, int c0, hbd_vec b, int c1) {
+  return hbd_add64(hbd_mul64(a, c0), hbd_mul64(b, c1));
+}
+
+// dct_const_round_shift(a * c)
+static INLINE hbd_vec hbd_mul_round(hbd_vec a, int c) {
+  return hbd_round64(hbd_mul64(a, c));
+}
+
+// dct_const_round_shift(a * c0 + b * c1)
+static INLINE hbd_vec hbd_madd_round(hbd_vec a, int c0, hbd_vec b, int c1) {
+  return hbd_round64(hbd_madd64(a, c0, b, c1));
+}
+
+static const TX_TYPE_1D hbd_vtx_tab[TX_TYPES] = {
+  DCT_1D,      ADST_1D, DCT_1D,      ADST_1D,
+#if CONFIG_EXT_TX
+  FLIPADST_1D, DCT_1D,  FLIPADST_1D, ADST_1D, FLIPADST_1D, IDTX_1D,
+  DCT_1D,      IDTX_1D, ADST_1D,     IDTX_1D, FLIPADST_1D, IDTX_1D,
+#endif  // CONFIG_EXT_TX
+};
+
+static const TX_TYPE_1D hbd_htx_tab[TX_TYPES] = {
+  DCT_1D,  DCT_1D,      ADST_1D,     ADST_1D,
+#if CONFIG_EXT_TX
+  DCT_1D,  FLIPADST_1D, FLIPADST_1D, FLIPADST_1D, ADST_1D, IDTX_1D,
+  IDTX_1D, DCT_1D,      IDTX_1D,     ADST_1D,     IDTX_1D, FLIPADST_1D,
+#endif  // CONFIG_EXT_TX
+};
+
+#endif  // AV1_COMMON_X86_HYBRID_TXFM32_COMMON_H_
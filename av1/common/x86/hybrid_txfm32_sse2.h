@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_COMMON_X86_HYBRID_TXFM32_SSE2_H_
+#define AV1_COMMON_X86_HYBRID_TXFM32_SSE2_H_
+
+#include <emmintrin.h>  // SSE2
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/txfm_common.h"
+
+// SSE2 has no signed 32x32->64 multiply or dword blend, so hbd_mul64() and
+// hbd_round64() are a few instructions longer than in hybrid_txfm32_sse4.h.
+#define HBD_LANES 4
+
+typedef __m128i hbd_vec;
+
+typedef struct {
+  __m128i even, odd;
+} hbd_vec64;
+
+static INLINE hbd_vec hbd_add(hbd_vec a, hbd_vec b) {
+  return _mm_add_epi32(a, b);
+}
+
+static INLINE hbd_vec hbd_sub(hbd_vec a, hbd_vec b) {
+  return _mm_sub_epi32(a, b);
+}
+
+static INLINE hbd_vec hbd_sll(hbd_vec a, int n) {
+  return _mm_sll_epi32(a, _mm_cvtsi32_si128(n));
+}
+
+static INLINE hbd_vec hbd_sra(hbd_vec a, int n) {
+  return _mm_sra_epi32(a, _mm_cvtsi32_si128(n));
+}
+
+static INLINE hbd_vec hbd_set1(int v) { return _mm_set1_epi32(v); }
+
+static INLINE hbd_vec hbd_set_lane0(int v) { return _mm_cvtsi32_si128(v); }
+
+static INLINE hbd_vec64 hbd_mul64(hbd_vec a, int c) {
+  // _mm_mul_epu32() treats both operands as unsigned, which adds
+  // ((a < 0 ? c : 0) + (c < 0 ? a : 0)) << 32 to the signed product.
+  const __m128i cc = _mm_set1_epi32(c);
+  const __m128i hi_mask = _mm_setr_epi32(0, -1, 0, -1);
+  __m128i fix = _mm_and_si128(_mm_srai_epi32(a, 31), cc);
+  hbd_vec64 r;
+  if (c < 0) fix = _mm_add_epi32(fix, a);
+  r.even = _mm_sub_epi64(_mm_mul_epu32(a, cc), _mm_slli_epi64(fix, 32));
+  r.odd = _mm_sub_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), cc),
+                        _mm_and_si128(fix, hi_mask));
+  return r;
+}
+
+static INLINE hbd_vec64 hbd_add64(hbd_vec64 a, hbd_vec64 b) {
+  hbd_vec64 r;
+  r.even = _mm_add_epi64(a.even, b.even);
+  r.odd = _mm_add_epi64(a.odd, b.odd);
+  return r;
+}
+
+static INLINE hbd_vec64 hbd_sub64(hbd_vec64 a, hbd_vec64 b) {
+  hbd_vec64 r;
+  r.even = _mm_sub_epi64(a.even, b.even);
+  r.odd = _mm_sub_epi64(a.odd, b.odd);
+  return r;
+}
+
+static INLINE hbd_vec hbd_round64(hbd_vec64 a) {
+  const __m128i rounding = _mm_set_epi32(0, DCT_CONST_ROUNDING, 0,
+                                         DCT_CONST_ROUNDING);
+  const __m128i lo_mask = _mm_setr_epi32(-1, 0, -1, 0);
+  const __m128i even =
+      _mm_srli_epi64(_mm_add_epi64(a.even, rounding), DCT_CONST_BITS);
+  const __m128i odd =
+      _mm_slli_epi64(_mm_add_epi64(a.odd, rounding), 32 - DCT_CONST_BITS);
+  return _mm_or_si128(_mm_and_si128(even, lo_mask),
+                      _mm_andnot_si128(lo_mask, odd));
+}
+
+static INLINE hbd_vec hbd_reverse(hbd_vec a) {
+  return _mm_shuffle_epi32(a, 0x1b);
+}
+
+static INLINE void hbd_transpose(const hbd_vec *in, hbd_vec *out) {
+  const __m128i u0 = _mm_unpacklo_epi32(in[0], in[1]);
+  const __m128i u1 = _mm_unpackhi_epi32(in[0], in[1]);
+  const __m128i u2 = _mm_unpacklo_epi32(in[2], in[3]);
+  const __m128i u3 = _mm_unpackhi_epi32(in[2], in[3]);
+  out[0] = _mm_unpacklo_epi64(u0, u2);
+  out[1] = _mm_unpackhi_epi64(u0, u2);
+  out[2] = _mm_unpacklo_epi64(u1, u3);
+  out[3] = _mm_unpackhi_epi64(u1, u3);
+}
+
+static INLINE hbd_vec hbd_load_row(const int16_t *src) {
+  const __m128i a = _mm_loadl_epi64((const __m128i *)src);
+  return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+}
+
+static INLINE void hbd_store_row(tran_low_t *dst, hbd_vec a) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  _mm_storeu_si128((__m128i *)dst, a);
+#else
+  _mm_storel_epi64((__m128i *)dst, _mm_packs_epi32(a, a));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+#include "av1/common/x86/hybrid_txfm32_common.h"
+
+#endif  // AV1_COMMON_X86_HYBRID_TXFM32_SSE2_H_
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_COMMON_X86_HYBRID_TXFM32_SSE4_H_
+#define AV1_COMMON_X86_HYBRID_TXFM32_SSE4_H_
+
+#include <smmintrin.h> /* SSE4.1 */
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/txfm_common.h"
+#include "av1/common/x86/highbd_txfm_utility_sse4.h"
+
+#define HBD_LANES 4
+
+typedef __m128i hbd_vec;
+
+typedef struct {
+  __m128i even, odd;
+} hbd_vec64;
+
+static INLINE hbd_vec hbd_add(hbd_vec a, hbd_vec b) {
+  return _mm_add_epi32(a, b);
+}
+
+static INLINE hbd_vec hbd_sub(hbd_vec a, hbd_vec b) {
+  return _mm_sub_epi32(a, b);
+}
+
+static INLINE hbd_vec hbd_sll(hbd_vec a, int n) {
+  return _mm_sll_epi32(a, _mm_cvtsi32_si128(n));
+}
+
+static INLINE hbd_vec hbd_sra(hbd_vec a, int n) {
+  return _mm_sra_epi32(a, _mm_cvtsi32_si128(n));
+}
+
+static INLINE hbd_vec hbd_set1(int v) { return _mm_set1_epi32(v); }
+
+static INLINE hbd_vec hbd_set_lane0(int v) { return _mm_cvtsi32_si128(v); }
+
+static INLINE hbd_vec64 hbd_mul64(hbd_vec a, int c) {
+  hbd_vec64 r;
+  mul_epi32_64(a, _mm_set1_epi32(c), &r.even, &r.odd);
+  return r;
+}
+
+static INLINE hbd_vec64 hbd_add64(hbd_vec64 a, hbd_vec64 b) {
+  hbd_vec64 r;
+  r.even = _mm_add_epi64(a.even, b.even);
+  r.odd = _mm_add_epi64(a.odd, b.odd);
+  return r;
+}
+
+static INLINE hbd_vec64 hbd_sub64(hbd_vec64 a, hbd_vec64 b) {
+  hbd_vec64 r;
+  r.even = _mm_sub_epi64(a.even, b.even);
+  r.odd = _mm_sub_epi64(a.odd, b.odd);
+  return r;
+}
+
+static INLINE hbd_vec hbd_round64(hbd_vec64 a) {
+  return round_shift_epi64_pair(a.even, a.odd,
+                                _mm_set1_epi64x(DCT_CONST_ROUNDING),
+                                DCT_CONST_BITS);
+}
+
+static INLINE hbd_vec hbd_reverse(hbd_vec a) {
+  return _mm_shuffle_epi32(a, 0x1b);
+}
+
+static INLINE void hbd_transpose(const hbd_vec *in, hbd_vec *out) {
+  TRANSPOSE_4X4(in[0], in[1], in[2], in[3], out[0], out[1], out[2], out[3]);
+}
+
+static INLINE hbd_vec hbd_load_row(const int16_t *src) {
+  return _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE void hbd_store_row(tran_low_t *dst, hbd_vec a) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  _mm_storeu_si128((__m128i *)dst, a);
+#else
+  _mm_storel_epi64((__m128i *)dst, _mm_packs_epi32(a, a));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+#include "av1/common/x86/hybrid_txfm32_common.h"
+
+#endif  // AV1_COMMON_X86_HYBRID_TXFM32_SSE4_H_
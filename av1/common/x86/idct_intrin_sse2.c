@@ -1681,3 +1681,610 @@ void av1_iht32x16_512_add_sse2(const tran_low_t *input, uint8_t *dest,
   }
   write_buffer_32x16_round6(dest, in0, in1, in2, in3, stride);
 }
+
+void av1_iht4x16_64_add_sse2(const tran_low_t *input, uint8_t *dest,
+                             int stride, int tx_type) {
+  __m128i in[16];
+  int i;
+
+  // Load rows, packed two per element of 'in'.
+  for (i = 0; i < 8; ++i) in[i] = load_input_data(input + i * 8);
+
+  // Row transform, done as four 4x4 blocks. The result is transposed back
+  // so that in[] holds pairs of rows again.
+  switch (tx_type) {
+    case DCT_DCT:
+    case ADST_DCT:
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+    case H_DCT:
+#endif
+      for (i = 0; i < 8; i += 2) {
+        aom_idct4_sse2(in + i);
+        array_transpose_4x4(in + i);
+      }
+      break;
+    case DCT_ADST:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case DCT_FLIPADST:
+    case FLIPADST_FLIPADST:
+    case ADST_FLIPADST:
+    case FLIPADST_ADST:
+    case H_ADST:
+    case H_FLIPADST:
+#endif
+      for (i = 0; i < 8; i += 2) {
+        aom_iadst4_sse2(in + i);
+        array_transpose_4x4(in + i);
+      }
+      break;
+#if CONFIG_EXT_TX
+    case V_FLIPADST:
+    case V_ADST:
+    case V_DCT:
+    case IDTX:
+      for (i = 0; i < 8; i += 2) iidtx4_sse2(in + i);
+      break;
+#endif
+    default: assert(0); break;
+  }
+
+  // Unpack to one row per element of 'in', in the low 4 lanes. Working
+  // downwards means no row is overwritten before it has been read.
+  for (i = 7; i >= 0; --i) {
+    in[2 * i + 1] = _mm_unpackhi_epi64(in[i], in[i]);
+    in[2 * i] = _mm_unpacklo_epi64(in[i], in[i]);
+  }
+
+  // Column transform
+  switch (tx_type) {
+    case DCT_DCT:
+    case DCT_ADST:
+#if CONFIG_EXT_TX
+    case DCT_FLIPADST:
+    case V_DCT:
+#endif
+      idct16_8col(in);
+      break;
+    case ADST_DCT:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case FLIPADST_ADST:
+    case ADST_FLIPADST:
+    case FLIPADST_FLIPADST:
+    case FLIPADST_DCT:
+    case V_ADST:
+    case V_FLIPADST:
+#endif
+      iadst16_8col(in);
+      break;
+#if CONFIG_EXT_TX
+    case H_DCT:
+    case H_ADST:
+    case H_FLIPADST:
+    case IDTX: iidtx16_8col(in); break;
+#endif
+    default: assert(0); break;
+  }
+
+  switch (tx_type) {
+    case DCT_DCT:
+    case ADST_DCT:
+    case DCT_ADST:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case H_DCT:
+    case H_ADST:
+    case V_ADST:
+    case V_DCT:
+    case IDTX:
+#endif
+      break;
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+    case FLIPADST_ADST:
+    case V_FLIPADST: FLIPUD_PTR(dest, stride, 16); break;
+    case DCT_FLIPADST:
+    case ADST_FLIPADST:
+    case H_FLIPADST:
+      for (i = 0; i < 16; ++i) in[i] = _mm_shufflelo_epi16(in[i], 0x1b);
+      break;
+    case FLIPADST_FLIPADST:
+      for (i = 0; i < 16; ++i) in[i] = _mm_shufflelo_epi16(in[i], 0x1b);
+      FLIPUD_PTR(dest, stride, 16);
+      break;
+#endif
+    default: assert(0); break;
+  }
+
+  // Repack two rows per element of 'in' for the 4x8 writer
+  for (i = 0; i < 8; ++i) in[i] = _mm_unpacklo_epi64(in[2 * i], in[2 * i + 1]);
+  write_buffer_4x8_round5(dest, in, stride);
+  write_buffer_4x8_round5(dest + 8 * stride, in + 4, stride);
+}
+
+void av1_iht16x4_64_add_sse2(const tran_low_t *input, uint8_t *dest,
+                             int stride, int tx_type) {
+  __m128i in[16];
+  int i;
+
+  // Transpose 16x4 input into in[], one column per element. Columns 0-7 are
+  // in the low 4 lanes of in[0..7], columns 8-15 in the high 4 lanes.
+  for (i = 0; i < 4; ++i) {
+    in[i] = load_input_data(input + i * 16);
+    in[i + 4] = load_input_data(input + i * 16 + 8);
+  }
+  array_transpose_8x8(in, in);
+  for (i = 0; i < 8; ++i) in[i + 8] = _mm_unpackhi_epi64(in[i], in[i]);
+
+  // Row transform
+  switch (tx_type) {
+    case DCT_DCT:
+    case ADST_DCT:
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+    case H_DCT:
+#endif
+      idct16_8col(in);
+      break;
+    case DCT_ADST:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case DCT_FLIPADST:
+    case FLIPADST_FLIPADST:
+    case ADST_FLIPADST:
+    case FLIPADST_ADST:
+    case H_ADST:
+    case H_FLIPADST:
+#endif
+      iadst16_8col(in);
+      break;
+#if CONFIG_EXT_TX
+    case V_FLIPADST:
+    case V_ADST:
+    case V_DCT:
+    case IDTX: iidtx16_8col(in); break;
+#endif
+    default: assert(0); break;
+  }
+
+  // Repack data, two columns per element of 'in', so that each pair of
+  // elements is a 4x4 block.
+  for (i = 0; i < 8; ++i) in[i] = _mm_unpacklo_epi64(in[2 * i], in[2 * i + 1]);
+
+  // Column transform
+  switch (tx_type) {
+    case DCT_DCT:
+    case DCT_ADST:
+#if CONFIG_EXT_TX
+    case DCT_FLIPADST:
+    case V_DCT:
+#endif
+      for (i = 0; i < 8; i += 2) aom_idct4_sse2(in + i);
+      break;
+    case ADST_DCT:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case FLIPADST_ADST:
+    case ADST_FLIPADST:
+    case FLIPADST_FLIPADST:
+    case FLIPADST_DCT:
+    case V_ADST:
+    case V_FLIPADST:
+#endif
+      for (i = 0; i < 8; i += 2) aom_iadst4_sse2(in + i);
+      break;
+#if CONFIG_EXT_TX
+    case H_DCT:
+    case H_ADST:
+    case H_FLIPADST:
+    case IDTX:
+      for (i = 0; i < 8; i += 2) {
+        iidtx4_sse2(in + i);
+        array_transpose_4x4(in + i);
+      }
+      break;
+#endif
+    default: assert(0); break;
+  }
+
+  // Repack data into rows: in[8..11] are columns 0-7 and in[12..15] are
+  // columns 8-15 of rows 0-3.
+  for (i = 0; i < 2; ++i) {
+    in[8 + 4 * i] = _mm_unpacklo_epi64(in[4 * i], in[4 * i + 2]);
+    in[9 + 4 * i] = _mm_unpackhi_epi64(in[4 * i], in[4 * i + 2]);
+    in[10 + 4 * i] = _mm_unpacklo_epi64(in[4 * i + 1], in[4 * i + 3]);
+    in[11 + 4 * i] = _mm_unpackhi_epi64(in[4 * i + 1], in[4 * i + 3]);
+  }
+
+  switch (tx_type) {
+    case DCT_DCT:
+    case ADST_DCT:
+    case DCT_ADST:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case H_DCT:
+    case H_ADST:
+    case V_ADST:
+    case V_DCT:
+    case IDTX:
+#endif
+      write_buffer_8x4_round5(dest, in + 8, stride);
+      write_buffer_8x4_round5(dest + 8, in + 12, stride);
+      break;
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+    case FLIPADST_ADST:
+    case V_FLIPADST:
+      write_buffer_8x4_round5(dest + stride * 3, in + 8, -stride);
+      write_buffer_8x4_round5(dest + stride * 3 + 8, in + 12, -stride);
+      break;
+    case DCT_FLIPADST:
+    case ADST_FLIPADST:
+    case H_FLIPADST:
+      for (i = 8; i < 16; ++i) in[i] = mm_reverse_epi16(in[i]);
+      write_buffer_8x4_round5(dest, in + 12, stride);
+      write_buffer_8x4_round5(dest + 8, in + 8, stride);
+      break;
+    case FLIPADST_FLIPADST:
+      for (i = 8; i < 16; ++i) in[i] = mm_reverse_epi16(in[i]);
+      write_buffer_8x4_round5(dest + stride * 3, in + 12, -stride);
+      write_buffer_8x4_round5(dest + stride * 3 + 8, in + 8, -stride);
+      break;
+#endif
+    default: assert(0); break;
+  }
+}
+
+// The 8-column 32-element transforms below take an 8x32 block as its top and
+// bottom halves, like idct32_8col(), and do not transpose their input.
+static INLINE void ihalfright32_8col(__m128i *in0, __m128i *in1) {
+  __m128i tmp[16];
+  int i;
+
+  for (i = 0; i < 16; ++i) {
+    tmp[i] = in0[i];
+    in0[i] = _mm_slli_epi16(in1[i], 2);
+  }
+  scale_sqrt2_8x16(tmp);
+  idct16_8col(tmp);
+  for (i = 0; i < 16; ++i) in1[i] = tmp[i];
+}
+
+#if CONFIG_EXT_TX
+static INLINE void iidtx32_8col(__m128i *in0, __m128i *in1) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    in0[i] = _mm_slli_epi16(in0[i], 2);
+    in1[i] = _mm_slli_epi16(in1[i], 2);
+  }
+}
+#endif  // CONFIG_EXT_TX
+
+void av1_iht8x32_256_add_sse2(const tran_low_t *input, uint8_t *dest,
+                              int stride, int tx_type) {
+  __m128i in[32];
+  int i;
+
+  for (i = 0; i < 32; ++i) in[i] = load_input_data(input + i * 8);
+
+  // Row transform
+  switch (tx_type) {
+    case DCT_DCT:
+    case ADST_DCT:
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+    case H_DCT:
+#endif
+      for (i = 0; i < 32; i += 8) {
+        aom_idct8_sse2(in + i);
+        array_transpose_8x8(in + i, in + i);
+      }
+      break;
+    case DCT_ADST:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case DCT_FLIPADST:
+    case FLIPADST_FLIPADST:
+    case ADST_FLIPADST:
+    case FLIPADST_ADST:
+    case H_ADST:
+    case H_FLIPADST:
+#endif
+      for (i = 0; i < 32; i += 8) {
+        aom_iadst8_sse2(in + i);
+        array_transpose_8x8(in + i, in + i);
+      }
+      break;
+#if CONFIG_EXT_TX
+    case V_FLIPADST:
+    case V_ADST:
+    case V_DCT:
+    case IDTX:
+      for (i = 0; i < 32; i += 8) iidtx8_sse2(in + i);
+      break;
+#endif
+    default: assert(0); break;
+  }
+
+  // Column transform
+  switch (tx_type) {
+    case DCT_DCT:
+    case DCT_ADST:
+#if CONFIG_EXT_TX
+    case DCT_FLIPADST:
+    case V_DCT:
+#endif
+      idct32_8col(in, in + 16);
+      break;
+    case ADST_DCT:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case FLIPADST_ADST:
+    case ADST_FLIPADST:
+    case FLIPADST_FLIPADST:
+    case FLIPADST_DCT:
+    case V_ADST:
+    case V_FLIPADST:
+#endif
+      ihalfright32_8col(in, in + 16);
+      break;
+#if CONFIG_EXT_TX
+    case H_DCT:
+    case H_ADST:
+    case H_FLIPADST:
+    case IDTX: iidtx32_8col(in, in + 16); break;
+#endif
+    default: assert(0); break;
+  }
+
+  switch (tx_type) {
+    case DCT_DCT:
+    case ADST_DCT:
+    case DCT_ADST:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case H_DCT:
+    case H_ADST:
+    case V_ADST:
+    case V_DCT:
+    case IDTX:
+#endif
+      break;
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+    case FLIPADST_ADST:
+    case V_FLIPADST: FLIPUD_PTR(dest, stride, 32); break;
+    case DCT_FLIPADST:
+    case ADST_FLIPADST:
+    case H_FLIPADST:
+      for (i = 0; i < 32; i += 8) flip_buffer_lr_8x8(in + i);
+      break;
+    case FLIPADST_FLIPADST:
+      for (i = 0; i < 32; i += 8) flip_buffer_lr_8x8(in + i);
+      FLIPUD_PTR(dest, stride, 32);
+      break;
+#endif
+    default: assert(0); break;
+  }
+  write_buffer_8x16(dest, in, stride);
+  write_buffer_8x16(dest + 16 * stride, in + 16, stride);
+}
+
+void av1_iht32x8_256_add_sse2(const tran_low_t *input, uint8_t *dest,
+                              int stride, int tx_type) {
+  __m128i in[32];
+  int i, j;
+
+  // Transpose 32x8 input into in[], one column per element
+  for (j = 0; j < 32; j += 8) {
+    for (i = 0; i < 8; ++i) in[j + i] = load_input_data(input + i * 32 + j);
+    array_transpose_8x8(in + j, in + j);
+  }
+
+  // Row transform
+  switch (tx_type) {
+    case DCT_DCT:
+    case ADST_DCT:
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+    case H_DCT:
+#endif
+      idct32_8col(in, in + 16);
+      break;
+    case DCT_ADST:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case DCT_FLIPADST:
+    case FLIPADST_FLIPADST:
+    case ADST_FLIPADST:
+    case FLIPADST_ADST:
+    case H_ADST:
+    case H_FLIPADST:
+#endif
+      ihalfright32_8col(in, in + 16);
+      break;
+#if CONFIG_EXT_TX
+    case V_FLIPADST:
+    case V_ADST:
+    case V_DCT:
+    case IDTX: iidtx32_8col(in, in + 16); break;
+#endif
+    default: assert(0); break;
+  }
+
+  // Column transform
+  switch (tx_type) {
+    case DCT_DCT:
+    case DCT_ADST:
+#if CONFIG_EXT_TX
+    case DCT_FLIPADST:
+    case V_DCT:
+#endif
+      for (j = 0; j < 32; j += 8) aom_idct8_sse2(in + j);
+      break;
+    case ADST_DCT:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case FLIPADST_ADST:
+    case ADST_FLIPADST:
+    case FLIPADST_FLIPADST:
+    case FLIPADST_DCT:
+    case V_ADST:
+    case V_FLIPADST:
+#endif
+      for (j = 0; j < 32; j += 8) aom_iadst8_sse2(in + j);
+      break;
+#if CONFIG_EXT_TX
+    case H_DCT:
+    case H_ADST:
+    case H_FLIPADST:
+    case IDTX:
+      for (j = 0; j < 32; j += 8) {
+        array_transpose_8x8(in + j, in + j);
+        iidtx8_sse2(in + j);
+      }
+      break;
+#endif
+    default: assert(0); break;
+  }
+
+  switch (tx_type) {
+    case DCT_DCT:
+    case ADST_DCT:
+    case DCT_ADST:
+    case ADST_ADST:
+#if CONFIG_EXT_TX
+    case H_DCT:
+    case H_ADST:
+    case V_ADST:
+    case V_DCT:
+    case IDTX:
+#endif
+      for (j = 0; j < 32; j += 8)
+        write_buffer_8x8_round6(dest + j, in + j, stride);
+      break;
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+    case FLIPADST_ADST:
+    case V_FLIPADST:
+      for (j = 0; j < 32; j += 8)
+        write_buffer_8x8_round6(dest + stride * 7 + j, in + j, -stride);
+      break;
+    case DCT_FLIPADST:
+    case ADST_FLIPADST:
+    case H_FLIPADST:
+      for (j = 0; j < 32; j += 8) {
+        flip_buffer_lr_8x8(in + j);
+        write_buffer_8x8_round6(dest + 24 - j, in + j, stride);
+      }
+      break;
+    case FLIPADST_FLIPADST:
+      for (j = 0; j < 32; j += 8) {
+        flip_buffer_lr_8x8(in + j);
+        write_buffer_8x8_round6(dest + stride * 7 + 24 - j, in + j, -stride);
+      }
+      break;
+#endif
+    default: assert(0); break;
+  }
+}
+
+#if CONFIG_EXT_TX
+void av1_iht32x32_1024_add_sse2(const tran_low_t *input, uint8_t *dest,
+                                int stride, int tx_type) {
+  void (*row_txfm)(__m128i *in0, __m128i *in1);
+  void (*col_txfm)(__m128i *in0, __m128i *in1);
+  __m128i in[32], out[4][32];
+  int lr_flip = 0;
+  int i, j, k;
+
+  switch (tx_type) {
+    case DCT_DCT:
+      row_txfm = idct32_8col;
+      col_txfm = idct32_8col;
+      break;
+    case ADST_DCT:
+    case FLIPADST_DCT:
+      row_txfm = idct32_8col;
+      col_txfm = ihalfright32_8col;
+      break;
+    case DCT_ADST:
+    case DCT_FLIPADST:
+      row_txfm = ihalfright32_8col;
+      col_txfm = idct32_8col;
+      break;
+    case ADST_ADST:
+    case FLIPADST_FLIPADST:
+    case ADST_FLIPADST:
+    case FLIPADST_ADST:
+      row_txfm = ihalfright32_8col;
+      col_txfm = ihalfright32_8col;
+      break;
+    case IDTX:
+      row_txfm = iidtx32_8col;
+      col_txfm = iidtx32_8col;
+      break;
+    case V_DCT:
+      row_txfm = iidtx32_8col;
+      col_txfm = idct32_8col;
+      break;
+    case H_DCT:
+      row_txfm = idct32_8col;
+      col_txfm = iidtx32_8col;
+      break;
+    case V_ADST:
+    case V_FLIPADST:
+      row_txfm = iidtx32_8col;
+      col_txfm = ihalfright32_8col;
+      break;
+    case H_ADST:
+    case H_FLIPADST:
+      row_txfm = ihalfright32_8col;
+      col_txfm = iidtx32_8col;
+      break;
+    default: assert(0); return;
+  }
+
+  // Row transform, 8 rows at a time. Each 8x8 block is transposed on the way
+  // in, so in[] holds one column per element, and back out into out[], which
+  // holds 8 columns of the whole block per entry.
+  for (i = 0; i < 32; i += 8) {
+    for (j = 0; j < 32; j += 8) {
+      for (k = 0; k < 8; ++k)
+        in[j + k] = load_input_data(input + (i + k) * 32 + j);
+      array_transpose_8x8(in + j, in + j);
+    }
+    row_txfm(in, in + 16);
+    for (j = 0; j < 4; ++j) array_transpose_8x8(in + 8 * j, out[j] + i);
+  }
+
+  // Column transform
+  for (j = 0; j < 4; ++j) col_txfm(out[j], out[j] + 16);
+
+  switch (tx_type) {
+    case FLIPADST_DCT:
+    case FLIPADST_ADST:
+    case V_FLIPADST: FLIPUD_PTR(dest, stride, 32); break;
+    case DCT_FLIPADST:
+    case ADST_FLIPADST:
+    case H_FLIPADST: lr_flip = 1; break;
+    case FLIPADST_FLIPADST:
+      lr_flip = 1;
+      FLIPUD_PTR(dest, stride, 32);
+      break;
+    default: break;
+  }
+
+  for (j = 0; j < 4; ++j) {
+    // A left-right flip also reverses the order of the 8-column strips
+    uint8_t *const d = dest + 8 * (lr_flip ? 3 - j : j);
+    if (lr_flip) {
+      for (i = 0; i < 32; i += 8) flip_buffer_lr_8x8(out[j] + i);
+    }
+    write_buffer_8x16(d, out[j], stride);
+    write_buffer_8x16(d + 16 * stride, out[j] + 16, stride);
+  }
+}
+#endif  // CONFIG_EXT_TX
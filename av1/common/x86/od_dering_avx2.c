@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "./av1_rtcd.h"
+#include "av1/common/od_dering.h"
+
+/* Loads 8 pixels from lo into the low lane and 8 pixels from hi into the high
+   lane. */
+static INLINE __m256i loadu_2x128(const int16_t *lo, const int16_t *hi) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)lo)),
+      _mm_loadu_si128((const __m128i *)hi), 1);
+}
+
+/* Loads the 4 first pixels of the 4 rows of a 4x4 block in the filter
+   buffer. */
+static INLINE __m256i load_4x4(const int16_t *in) {
+  const __m128i r01 = _mm_unpacklo_epi64(
+      _mm_loadl_epi64((const __m128i *)&in[0 * OD_FILT_BSTRIDE]),
+      _mm_loadl_epi64((const __m128i *)&in[1 * OD_FILT_BSTRIDE]));
+  const __m128i r23 = _mm_unpacklo_epi64(
+      _mm_loadl_epi64((const __m128i *)&in[2 * OD_FILT_BSTRIDE]),
+      _mm_loadl_epi64((const __m128i *)&in[3 * OD_FILT_BSTRIDE]));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(r01), r23, 1);
+}
+
+static INLINE void store_4x4(int16_t *y, int ystride, __m256i res) {
+  const __m128i r01 = _mm256_castsi256_si128(res);
+  const __m128i r23 = _mm256_extracti128_si256(res, 1);
+  _mm_storel_epi64((__m128i *)&y[0 * ystride], r01);
+  _mm_storel_epi64((__m128i *)&y[1 * ystride], _mm_unpackhi_epi64(r01, r01));
+  _mm_storel_epi64((__m128i *)&y[2 * ystride], r23);
+  _mm_storel_epi64((__m128i *)&y[3 * ystride], _mm_unpackhi_epi64(r23, r23));
+}
+
+/* p if abs(p) < threshold, 0 otherwise. */
+static INLINE __m256i od_constrain_epi16(__m256i p, __m256i threshold) {
+  return _mm256_and_si256(p,
+                          _mm256_cmpgt_epi16(threshold, _mm256_abs_epi16(p)));
+}
+
+/* Horizontal sum of 16x16-bit values. */
+static INLINE int32_t hsum_epi16(__m256i a) {
+  __m128i s;
+  a = _mm256_madd_epi16(a, _mm256_set1_epi16(1));
+  s = _mm_add_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+  s = _mm_hadd_epi32(s, s);
+  s = _mm_hadd_epi32(s, s);
+  return _mm_cvtsi128_si32(s);
+}
+
+/* The direction search below is the SSE4.1 one with two blocks side by side:
+   every instruction operates on 128-bit lanes, so the low lane works on the
+   first block and the high lane on the second. */
+
+static INLINE __m256i broadcast_epi32x4(int a, int b, int c, int d) {
+  return _mm256_broadcastsi128_si256(_mm_set_epi32(a, b, c, d));
+}
+
+static INLINE __m256i fold_mul_and_sum(__m256i partiala, __m256i partialb,
+                                       __m256i const1, __m256i const2) {
+  __m256i tmp;
+  /* Reverse partial B. */
+  partialb = _mm256_shuffle_epi8(
+      partialb, _mm256_broadcastsi128_si256(_mm_set_epi8(
+                    15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12)));
+  /* Interleave the x and y values of identical indices and pair x8 with 0. */
+  tmp = partiala;
+  partiala = _mm256_unpacklo_epi16(partiala, partialb);
+  partialb = _mm256_unpackhi_epi16(tmp, partialb);
+  /* Square and add the corresponding x and y values. */
+  partiala = _mm256_madd_epi16(partiala, partiala);
+  partialb = _mm256_madd_epi16(partialb, partialb);
+  /* Multiply by constant. */
+  partiala = _mm256_mullo_epi32(partiala, const1);
+  partialb = _mm256_mullo_epi32(partialb, const2);
+  /* Sum all results. */
+  return _mm256_add_epi32(partiala, partialb);
+}
+
+static INLINE __m256i hsum4(__m256i x0, __m256i x1, __m256i x2, __m256i x3) {
+  __m256i t0, t1, t2, t3;
+  t0 = _mm256_unpacklo_epi32(x0, x1);
+  t1 = _mm256_unpacklo_epi32(x2, x3);
+  t2 = _mm256_unpackhi_epi32(x0, x1);
+  t3 = _mm256_unpackhi_epi32(x2, x3);
+  x0 = _mm256_unpacklo_epi64(t0, t1);
+  x1 = _mm256_unpackhi_epi64(t0, t1);
+  x2 = _mm256_unpacklo_epi64(t2, t3);
+  x3 = _mm256_unpackhi_epi64(t2, t3);
+  return _mm256_add_epi32(_mm256_add_epi32(x0, x1), _mm256_add_epi32(x2, x3));
+}
+
+/* Computes the cost for directions 4, 5, 6 and 7 of both blocks. Calling it
+   again on the rotated lines gives directions 0 to 3. */
+static INLINE __m256i compute_directions(const __m256i lines[8]) {
+  __m256i partial4a, partial4b, partial5a, partial5b, partial7a, partial7b;
+  __m256i partial6;
+  __m256i tmp;
+  /* Partial sums for lines 0 and 1. */
+  partial4a = _mm256_slli_si256(lines[0], 14);
+  partial4b = _mm256_srli_si256(lines[0], 2);
+  partial4a = _mm256_add_epi16(partial4a, _mm256_slli_si256(lines[1], 12));
+  partial4b = _mm256_add_epi16(partial4b, _mm256_srli_si256(lines[1], 4));
+  tmp = _mm256_add_epi16(lines[0], lines[1]);
+  partial5a = _mm256_slli_si256(tmp, 10);
+  partial5b = _mm256_srli_si256(tmp, 6);
+  partial7a = _mm256_slli_si256(tmp, 4);
+  partial7b = _mm256_srli_si256(tmp, 12);
+  partial6 = tmp;
+
+  /* Partial sums for lines 2 and 3. */
+  partial4a = _mm256_add_epi16(partial4a, _mm256_slli_si256(lines[2], 10));
+  partial4b = _mm256_add_epi16(partial4b, _mm256_srli_si256(lines[2], 6));
+  partial4a = _mm256_add_epi16(partial4a, _mm256_slli_si256(lines[3], 8));
+  partial4b = _mm256_add_epi16(partial4b, _mm256_srli_si256(lines[3], 8));
+  tmp = _mm256_add_epi16(lines[2], lines[3]);
+  partial5a = _mm256_add_epi16(partial5a, _mm256_slli_si256(tmp, 8));
+  partial5b = _mm256_add_epi16(partial5b, _mm256_srli_si256(tmp, 8));
+  partial7a = _mm256_add_epi16(partial7a, _mm256_slli_si256(tmp, 6));
+  partial7b = _mm256_add_epi16(partial7b, _mm256_srli_si256(tmp, 10));
+  partial6 = _mm256_add_epi16(partial6, tmp);
+
+  /* Partial sums for lines 4 and 5. */
+  partial4a = _mm256_add_epi16(partial4a, _mm256_slli_si256(lines[4], 6));
+  partial4b = _mm256_add_epi16(partial4b, _mm256_srli_si256(lines[4], 10));
+  partial4a = _mm256_add_epi16(partial4a, _mm256_slli_si256(lines[5], 4));
+  partial4b = _mm256_add_epi16(partial4b, _mm256_srli_si256(lines[5], 12));
+  tmp = _mm256_add_epi16(lines[4], lines[5]);
+  partial5a = _mm256_add_epi16(partial5a, _mm256_slli_si256(tmp, 6));
+  partial5b = _mm256_add_epi16(partial5b, _mm256_srli_si256(tmp, 10));
+  partial7a = _mm256_add_epi16(partial7a, _mm256_slli_si256(tmp, 8));
+  partial7b = _mm256_add_epi16(partial7b, _mm256_srli_si256(tmp, 8));
+  partial6 = _mm256_add_epi16(partial6, tmp);
+
+  /* Partial sums for lines 6 and 7. */
+  partial4a = _mm256_add_epi16(partial4a, _mm256_slli_si256(lines[6], 2));
+  partial4b = _mm256_add_epi16(partial4b, _mm256_srli_si256(lines[6], 14));
+  partial4a = _mm256_add_epi16(partial4a, lines[7]);
+  tmp = _mm256_add_epi16(lines[6], lines[7]);
+  partial5a = _mm256_add_epi16(partial5a, _mm256_slli_si256(tmp, 4));
+  partial5b = _mm256_add_epi16(partial5b, _mm256_srli_si256(tmp, 12));
+  partial7a = _mm256_add_epi16(partial7a, _mm256_slli_si256(tmp, 10));
+  partial7b = _mm256_add_epi16(partial7b, _mm256_srli_si256(tmp, 6));
+  partial6 = _mm256_add_epi16(partial6, tmp);
+
+  /* Compute costs in terms of partial sums. */
+  partial4a = fold_mul_and_sum(partial4a, partial4b,
+                               broadcast_epi32x4(210, 280, 420, 840),
+                               broadcast_epi32x4(105, 120, 140, 168));
+  partial7a = fold_mul_and_sum(partial7a, partial7b,
+                               broadcast_epi32x4(210, 420, 0, 0),
+                               broadcast_epi32x4(105, 105, 105, 140));
+  partial5a = fold_mul_and_sum(partial5a, partial5b,
+                               broadcast_epi32x4(210, 420, 0, 0),
+                               broadcast_epi32x4(105, 105, 105, 140));
+  partial6 = _mm256_madd_epi16(partial6, partial6);
+  partial6 = _mm256_mullo_epi32(partial6, _mm256_set1_epi32(105));
+
+  return hsum4(partial4a, partial5a, partial6, partial7a);
+}
+
+/* Transpose and reverse the order of the lines of both blocks -- equivalent
+   to a 90-degree counter-clockwise rotation of the pixels. */
+static INLINE void array_reverse_transpose_8x8(const __m256i *in,
+                                               __m256i *res) {
+  const __m256i tr0_0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i tr0_1 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i tr0_2 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i tr0_3 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i tr0_4 = _mm256_unpacklo_epi16(in[4], in[5]);
+  const __m256i tr0_5 = _mm256_unpacklo_epi16(in[6], in[7]);
+  const __m256i tr0_6 = _mm256_unpackhi_epi16(in[4], in[5]);
+  const __m256i tr0_7 = _mm256_unpackhi_epi16(in[6], in[7]);
+
+  const __m256i tr1_0 = _mm256_unpacklo_epi32(tr0_0, tr0_1);
+  const __m256i tr1_1 = _mm256_unpacklo_epi32(tr0_4, tr0_5);
+  const __m256i tr1_2 = _mm256_unpackhi_epi32(tr0_0, tr0_1);
+  const __m256i tr1_3 = _mm256_unpackhi_epi32(tr0_4, tr0_5);
+  const __m256i tr1_4 = _mm256_unpacklo_epi32(tr0_2, tr0_3);
+  const __m256i tr1_5 = _mm256_unpacklo_epi32(tr0_6, tr0_7);
+  const __m256i tr1_6 = _mm256_unpackhi_epi32(tr0_2, tr0_3);
+  const __m256i tr1_7 = _mm256_unpackhi_epi32(tr0_6, tr0_7);
+
+  res[7] = _mm256_unpacklo_epi64(tr1_0, tr1_1);
+  res[6] = _mm256_unpackhi_epi64(tr1_0, tr1_1);
+  res[5] = _mm256_unpacklo_epi64(tr1_2, tr1_3);
+  res[4] = _mm256_unpackhi_epi64(tr1_2, tr1_3);
+  res[3] = _mm256_unpacklo_epi64(tr1_4, tr1_5);
+  res[2] = _mm256_unpackhi_epi64(tr1_4, tr1_5);
+  res[1] = _mm256_unpacklo_epi64(tr1_6, tr1_7);
+  res[0] = _mm256_unpackhi_epi64(tr1_6, tr1_7);
+}
+
+static INLINE int pick_direction(const int32_t cost[8], int32_t *var) {
+  int i;
+  int32_t best_cost = 0;
+  int best_dir = 0;
+  for (i = 0; i < 8; i++) {
+    if (cost[i] > best_cost) {
+      best_cost = cost[i];
+      best_dir = i;
+    }
+  }
+  /* Difference between the optimal variance and the variance along the
+     orthogonal direction. Again, the sum(x^2) terms cancel out. */
+  *var = best_cost - cost[(best_dir + 4) & 7];
+  /* We'd normally divide by 840, but dividing by 1024 is close enough
+     for what we're going to do with this. */
+  *var >>= 10;
+  return best_dir;
+}
+
+/* Direction search for the blocks at img0 and img1. */
+static INLINE void od_dir_find8x2(const od_dering_in *img0,
+                                  const od_dering_in *img1, int stride,
+                                  int *dir, int32_t *var, int coeff_shift) {
+  int i;
+  DECLARE_ALIGNED(32, int32_t, cost03[8]);
+  DECLARE_ALIGNED(32, int32_t, cost47[8]);
+  int32_t cost[8];
+  __m256i lines[8];
+  for (i = 0; i < 8; i++) {
+    lines[i] = loadu_2x128(&img0[i * stride], &img1[i * stride]);
+    lines[i] = _mm256_sub_epi16(_mm256_srai_epi16(lines[i], coeff_shift),
+                                _mm256_set1_epi16(128));
+  }
+
+  /* Compute "mostly vertical" directions. */
+  _mm256_store_si256((__m256i *)cost47, compute_directions(lines));
+
+  array_reverse_transpose_8x8(lines, lines);
+
+  /* Compute "mostly horizontal" directions. */
+  _mm256_store_si256((__m256i *)cost03, compute_directions(lines));
+
+  for (i = 0; i < 2; i++) {
+    memcpy(cost, cost03 + 4 * i, 4 * sizeof(*cost));
+    memcpy(cost + 4, cost47 + 4 * i, 4 * sizeof(*cost));
+    dir[i] = pick_direction(cost, &var[i]);
+  }
+}
+
+void od_dir_find8_list_avx2(const od_dering_in *in, const dering_list *dlist,
+                            int dering_count, int *dirs, int32_t *vars,
+                            int coeff_shift) {
+  int bi;
+  for (bi = 0; bi + 1 < dering_count; bi += 2) {
+    od_dir_find8x2(
+        &in[8 * dlist[bi].by * OD_FILT_BSTRIDE + 8 * dlist[bi].bx],
+        &in[8 * dlist[bi + 1].by * OD_FILT_BSTRIDE + 8 * dlist[bi + 1].bx],
+        OD_FILT_BSTRIDE, &dirs[bi], &vars[bi], coeff_shift);
+  }
+  if (bi < dering_count) {
+    /* Odd block count: search the last block in both lanes. */
+    const od_dering_in *const img =
+        &in[8 * dlist[bi].by * OD_FILT_BSTRIDE + 8 * dlist[bi].bx];
+    int dir[2];
+    int32_t var[2];
+    od_dir_find8x2(img, img, OD_FILT_BSTRIDE, dir, var, coeff_shift);
+    dirs[bi] = dir[0];
+    vars[bi] = var[0];
+  }
+}
+
+/* The filters below process two rows of an 8x8 block, or a whole 4x4 block,
+   per 256-bit register. */
+
+int od_filter_dering_direction_8x8_avx2(int16_t *y, int ystride,
+                                        const int16_t *in, int threshold,
+                                        int dir) {
+  int i;
+  const int off1 = OD_DIRECTION_OFFSETS_TABLE[dir][0];
+  const int off2 = OD_DIRECTION_OFFSETS_TABLE[dir][1];
+  const int off3 = OD_DIRECTION_OFFSETS_TABLE[dir][2];
+  const __m256i thresh = _mm256_set1_epi16(threshold);
+  __m256i total_abs = _mm256_setzero_si256();
+  for (i = 0; i < 8; i += 2) {
+    const int16_t *const r0 = &in[i * OD_FILT_BSTRIDE];
+    const int16_t *const r1 = r0 + OD_FILT_BSTRIDE;
+    const __m256i row = loadu_2x128(r0, r1);
+    __m256i s1, s2, s3, sum, res;
+    /* if (abs(p) < thresh) sum += taps[k] * p, with taps 3, 2, 1. */
+    s1 = _mm256_add_epi16(
+        od_constrain_epi16(
+            _mm256_sub_epi16(loadu_2x128(r0 + off1, r1 + off1), row), thresh),
+        od_constrain_epi16(
+            _mm256_sub_epi16(loadu_2x128(r0 - off1, r1 - off1), row), thresh));
+    s2 = _mm256_add_epi16(
+        od_constrain_epi16(
+            _mm256_sub_epi16(loadu_2x128(r0 + off2, r1 + off2), row), thresh),
+        od_constrain_epi16(
+            _mm256_sub_epi16(loadu_2x128(r0 - off2, r1 - off2), row), thresh));
+    s3 = _mm256_add_epi16(
+        od_constrain_epi16(
+            _mm256_sub_epi16(loadu_2x128(r0 + off3, r1 + off3), row), thresh),
+        od_constrain_epi16(
+            _mm256_sub_epi16(loadu_2x128(r0 - off3, r1 - off3), row), thresh));
+    sum = _mm256_add_epi16(_mm256_add_epi16(s1, _mm256_slli_epi16(s1, 1)),
+                           _mm256_add_epi16(_mm256_slli_epi16(s2, 1), s3));
+    /* res = row + ((sum + 8) >> 4) */
+    res = _mm256_srai_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(8)), 4);
+    total_abs = _mm256_add_epi16(total_abs, _mm256_abs_epi16(res));
+    res = _mm256_add_epi16(row, res);
+    _mm_storeu_si128((__m128i *)&y[i * ystride], _mm256_castsi256_si128(res));
+    _mm_storeu_si128((__m128i *)&y[(i + 1) * ystride],
+                     _mm256_extracti128_si256(res, 1));
+  }
+  return (hsum_epi16(total_abs) + 8) >> 4;
+}
+
+int od_filter_dering_direction_4x4_avx2(int16_t *y, int ystride,
+                                        const int16_t *in, int threshold,
+                                        int dir) {
+  const int off1 = OD_DIRECTION_OFFSETS_TABLE[dir][0];
+  const int off2 = OD_DIRECTION_OFFSETS_TABLE[dir][1];
+  const __m256i thresh = _mm256_set1_epi16(threshold);
+  const __m256i row = load_4x4(in);
+  __m256i s1, s2, sum, res, total_abs;
+  /* if (abs(p) < thresh) sum += taps[k] * p, with taps 4, 1. */
+  s1 = _mm256_add_epi16(
+      od_constrain_epi16(_mm256_sub_epi16(load_4x4(in + off1), row), thresh),
+      od_constrain_epi16(_mm256_sub_epi16(load_4x4(in - off1), row), thresh));
+  s2 = _mm256_add_epi16(
+      od_constrain_epi16(_mm256_sub_epi16(load_4x4(in + off2), row), thresh),
+      od_constrain_epi16(_mm256_sub_epi16(load_4x4(in - off2), row), thresh));
+  sum = _mm256_add_epi16(_mm256_slli_epi16(s1, 2), s2);
+  /* res = row + ((sum + 8) >> 4) */
+  res = _mm256_srai_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(8)), 4);
+  total_abs = _mm256_abs_epi16(res);
+  store_4x4(y, ystride, _mm256_add_epi16(row, res));
+  return (hsum_epi16(total_abs) + 2) >> 2;
+}
+
+void od_filter_dering_orthogonal_8x8_avx2(int16_t *y, int ystride,
+                                          const int16_t *in, int threshold,
+                                          int dir) {
+  int i;
+  const int offset = dir > 0 && dir < 4 ? OD_FILT_BSTRIDE : 1;
+  const __m256i thresh = _mm256_set1_epi16(threshold);
+  for (i = 0; i < 8; i += 2) {
+    const int16_t *const r0 = &in[i * OD_FILT_BSTRIDE];
+    const int16_t *const r1 = r0 + OD_FILT_BSTRIDE;
+    const __m256i row = loadu_2x128(r0, r1);
+    __m256i sum, res;
+    /* if (abs(p) < threshold) sum += p, for p at +-offset and +-2 offset. */
+    sum = _mm256_add_epi16(
+        od_constrain_epi16(
+            _mm256_sub_epi16(loadu_2x128(r0 + offset, r1 + offset), row),
+            thresh),
+        od_constrain_epi16(
+            _mm256_sub_epi16(loadu_2x128(r0 - offset, r1 - offset), row),
+            thresh));
+    sum = _mm256_add_epi16(
+        sum, od_constrain_epi16(
+                 _mm256_sub_epi16(
+                     loadu_2x128(r0 + 2 * offset, r1 + 2 * offset), row),
+                 thresh));
+    sum = _mm256_add_epi16(
+        sum, od_constrain_epi16(
+                 _mm256_sub_epi16(
+                     loadu_2x128(r0 - 2 * offset, r1 - 2 * offset), row),
+                 thresh));
+    /* row + ((3 * sum + 8) >> 4) */
+    res = _mm256_add_epi16(sum, _mm256_slli_epi16(sum, 1));
+    res = _mm256_srai_epi16(_mm256_add_epi16(res, _mm256_set1_epi16(8)), 4);
+    res = _mm256_add_epi16(row, res);
+    _mm_storeu_si128((__m128i *)&y[i * ystride], _mm256_castsi256_si128(res));
+    _mm_storeu_si128((__m128i *)&y[(i + 1) * ystride],
+                     _mm256_extracti128_si256(res, 1));
+  }
+}
+
+void od_filter_dering_orthogonal_4x4_avx2(int16_t *y, int ystride,
+                                          const int16_t *in, int threshold,
+                                          int dir) {
+  const int offset = dir > 0 && dir < 4 ? OD_FILT_BSTRIDE : 1;
+  const __m256i thresh = _mm256_set1_epi16(threshold);
+  const __m256i row = load_4x4(in);
+  __m256i sum, res;
+  /* if (abs(p) < threshold) sum += p, for p at +-offset. */
+  sum = _mm256_add_epi16(
+      od_constrain_epi16(_mm256_sub_epi16(load_4x4(in + offset), row), thresh),
+      od_constrain_epi16(_mm256_sub_epi16(load_4x4(in - offset), row), thresh));
+  /* row + ((5 * sum + 8) >> 4) */
+  res = _mm256_add_epi16(sum, _mm256_slli_epi16(sum, 2));
+  res = _mm256_srai_epi16(_mm256_add_epi16(res, _mm256_set1_epi16(8)), 4);
+  store_4x4(y, ystride, _mm256_add_epi16(row, res));
+}
+
+void od_filter_dering_direction_list_avx2(int16_t *y, const int16_t *in,
+                                          const dering_list *dlist,
+                                          int dering_count, int bsize,
+                                          const int *thresholds,
+                                          const int *dirs,
+                                          int *filter2_thresh) {
+  int bi;
+  if (bsize == 3) {
+    for (bi = 0; bi < dering_count; bi++) {
+      filter2_thresh[bi] = od_filter_dering_direction_8x8_avx2(
+          &y[bi << 6], 8,
+          &in[(dlist[bi].by * OD_FILT_BSTRIDE << 3) + (dlist[bi].bx << 3)],
+          thresholds[bi], dirs[bi]);
+    }
+  } else {
+    for (bi = 0; bi < dering_count; bi++) {
+      filter2_thresh[bi] = od_filter_dering_direction_4x4_avx2(
+          &y[bi << 4], 4,
+          &in[(dlist[bi].by * OD_FILT_BSTRIDE << 2) + (dlist[bi].bx << 2)],
+          thresholds[bi], dirs[bi]);
+    }
+  }
+}
+
+void od_filter_dering_orthogonal_list_avx2(int16_t *y, const int16_t *in,
+                                           const dering_list *dlist,
+                                           int dering_count, int bsize,
+                                           const int *thresholds,
+                                           const int *dirs) {
+  int bi;
+  if (bsize == 3) {
+    for (bi = 0; bi < dering_count; bi++) {
+      if (thresholds[bi] == 0) continue;
+      od_filter_dering_orthogonal_8x8_avx2(
+          &y[bi << 6], 8,
+          &in[(dlist[bi].by * OD_FILT_BSTRIDE << 3) + (dlist[bi].bx << 3)],
+          thresholds[bi], dirs[bi]);
+    }
+  } else {
+    for (bi = 0; bi < dering_count; bi++) {
+      if (thresholds[bi] == 0) continue;
+      od_filter_dering_orthogonal_4x4_avx2(
+          &y[bi << 4], 4,
+          &in[(dlist[bi].by * OD_FILT_BSTRIDE << 2) + (dlist[bi].bx << 2)],
+          thresholds[bi], dirs[bi]);
+    }
+  }
+}
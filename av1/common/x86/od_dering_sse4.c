@@ -497,3 +497,51 @@ void od_filter_dering_orthogonal_8x8_sse4_1(int16_t *y, int ystride,
     _mm_storeu_si128((__m128i *)&y[i * ystride], res);
   }
 }
+
+void od_dir_find8_list_sse4_1(const od_dering_in *in, const dering_list *dlist,
+                              int dering_count, int *dirs, int32_t *vars,
+                              int coeff_shift) {
+  int bi;
+  for (bi = 0; bi < dering_count; bi++) {
+    dirs[bi] = od_dir_find8_sse4_1(
+        &in[8 * dlist[bi].by * OD_FILT_BSTRIDE + 8 * dlist[bi].bx],
+        OD_FILT_BSTRIDE, &vars[bi], coeff_shift);
+  }
+}
+
+void od_filter_dering_direction_list_sse4_1(
+    int16_t *y, const int16_t *in, const dering_list *dlist, int dering_count,
+    int bsize, const int *thresholds, const int *dirs, int *filter2_thresh) {
+  int bi;
+  for (bi = 0; bi < dering_count; bi++) {
+    int16_t *const yb = &y[bi << 2 * bsize];
+    const int16_t *const inb = &in[(dlist[bi].by * OD_FILT_BSTRIDE << bsize) +
+                                   (dlist[bi].bx << bsize)];
+    filter2_thresh[bi] =
+        bsize == 3
+            ? od_filter_dering_direction_8x8_sse4_1(yb, 1 << bsize, inb,
+                                                    thresholds[bi], dirs[bi])
+            : od_filter_dering_direction_4x4_sse4_1(yb, 1 << bsize, inb,
+                                                    thresholds[bi], dirs[bi]);
+  }
+}
+
+void od_filter_dering_orthogonal_list_sse4_1(int16_t *y, const int16_t *in,
+                                             const dering_list *dlist,
+                                             int dering_count, int bsize,
+                                             const int *thresholds,
+                                             const int *dirs) {
+  int bi;
+  for (bi = 0; bi < dering_count; bi++) {
+    int16_t *const yb = &y[bi << 2 * bsize];
+    const int16_t *const inb = &in[(dlist[bi].by * OD_FILT_BSTRIDE << bsize) +
+                                   (dlist[bi].bx << bsize)];
+    if (thresholds[bi] == 0) continue;
+    if (bsize == 3)
+      od_filter_dering_orthogonal_8x8_sse4_1(yb, 1 << bsize, inb,
+                                             thresholds[bi], dirs[bi]);
+    else
+      od_filter_dering_orthogonal_4x4_sse4_1(yb, 1 << bsize, inb,
+                                             thresholds[bi], dirs[bi]);
+  }
+}
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>  // avx2
+#include <string.h>
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+#include "av1/common/restoration.h"
+
+// Widest block the box sums are vectorised for. Restoration tiles are at most
+// 1.5 times the tile size wide; anything wider uses the C version.
+#define BOX_SUM_MAX_WIDTH (RESTORATION_TILESIZE_BIG * 3 / 2)
+#define BOX_SUM_MAX_R 3
+
+static INLINE __m256i load_box_row(const int32_t *src, int sqr) {
+  const __m256i x = _mm256_loadu_si256((const __m256i *)src);
+  return sqr ? _mm256_mullo_epi32(x, x) : x;
+}
+
+// Vertical sums over the rows [i - r, i + r] that are inside the block, from
+// src into dst. Each column keeps the rows of its window, so the sums can be
+// written in place.
+static void box_sum_vert(const int32_t *src, int width, int height,
+                         int src_stride, int r, int sqr, int32_t *dst,
+                         int dst_stride) {
+  const int n = 2 * r + 1;
+  int i, j, k;
+
+  for (j = 0; j + 8 <= width; j += 8) {
+    __m256i win[2 * BOX_SUM_MAX_R + 1];
+    __m256i sum = _mm256_setzero_si256();
+    // Row x of the window is held in win[x % n].
+    for (i = 0; i <= r; ++i) {
+      win[i] = load_box_row(src + i * src_stride + j, sqr);
+      sum = _mm256_add_epi32(sum, win[i]);
+    }
+    for (i = 0, k = r + 1; i < height; ++i) {
+      _mm256_storeu_si256((__m256i *)(dst + i * dst_stride + j), sum);
+      if (i >= r) sum = _mm256_sub_epi32(sum, win[k]);
+      if (i + r + 1 < height) {
+        win[k] = load_box_row(src + (i + r + 1) * src_stride + j, sqr);
+        sum = _mm256_add_epi32(sum, win[k]);
+      }
+      if (++k == n) k = 0;
+    }
+  }
+  for (; j < width; ++j) {
+    int32_t win[2 * BOX_SUM_MAX_R + 1];
+    int32_t sum = 0;
+    for (i = 0; i <= r; ++i) {
+      const int32_t x = src[i * src_stride + j];
+      win[i] = sqr ? x * x : x;
+      sum += win[i];
+    }
+    for (i = 0, k = r + 1; i < height; ++i) {
+      dst[i * dst_stride + j] = sum;
+      if (i >= r) sum -= win[k];
+      if (i + r + 1 < height) {
+        const int32_t x = src[(i + r + 1) * src_stride + j];
+        win[k] = sqr ? x * x : x;
+        sum += win[k];
+      }
+      if (++k == n) k = 0;
+    }
+  }
+}
+
+// Horizontal sums over the columns [j - r, j + r] that are inside the block,
+// in place. Each row is copied with zeros on both sides first.
+static void box_sum_horz(int32_t *dst, int width, int height, int dst_stride,
+                         int r) {
+  DECLARE_ALIGNED(32, int32_t, buf[BOX_SUM_MAX_WIDTH + 2 * BOX_SUM_MAX_R]);
+  int i, j, k;
+
+  memset(buf, 0, sizeof(*buf) * r);
+  for (i = 0; i < height; ++i) {
+    int32_t *const row = dst + i * dst_stride;
+    memcpy(buf + r, row, sizeof(*buf) * width);
+    memset(buf + r + width, 0, sizeof(*buf) * r);
+    for (j = 0; j + 8 <= width; j += 8) {
+      __m256i sum = _mm256_loadu_si256((const __m256i *)(buf + j));
+      for (k = 1; k < 2 * r + 1; ++k)
+        sum = _mm256_add_epi32(sum,
+                               _mm256_loadu_si256((const __m256i *)(buf + j + k)));
+      _mm256_storeu_si256((__m256i *)(row + j), sum);
+    }
+    for (; j < width; ++j) {
+      int32_t sum = 0;
+      for (k = 0; k < 2 * r + 1; ++k) sum += buf[j + k];
+      row[j] = sum;
+    }
+  }
+}
+
+void av1_box_sum_avx2(int32_t *src, int width, int height, int src_stride,
+                      int r, int sqr, int32_t *dst, int dst_stride) {
+  // The C version only sums over the box inside the block when the block is
+  // at least as large as the box.
+  if (r > BOX_SUM_MAX_R || width > BOX_SUM_MAX_WIDTH || width < 2 * r + 1 ||
+      height < 2 * r + 1) {
+    av1_box_sum_c(src, width, height, src_stride, r, sqr, dst, dst_stride);
+    return;
+  }
+  box_sum_vert(src, width, height, src_stride, r, sqr, dst, dst_stride);
+  box_sum_horz(dst, width, height, dst_stride, r);
+}
+
+#if APPROXIMATE_SGR
+// Converts four unsigned 32-bit integers to double.
+static INLINE __m256d cvtepu32_pd(__m128i x) {
+  return _mm256_add_pd(
+      _mm256_cvtepi32_pd(_mm_xor_si128(x, _mm_set1_epi32((int)0x80000000))),
+      _mm256_set1_pd(2147483648.0));
+}
+
+static INLINE __m128i div4_epu32(__m128i x, __m128i y) {
+  const __m256d q =
+      _mm256_floor_pd(_mm256_div_pd(cvtepu32_pd(x), cvtepu32_pd(y)));
+  return _mm_xor_si128(
+      _mm256_cvtpd_epi32(_mm256_sub_pd(q, _mm256_set1_pd(2147483648.0))),
+      _mm_set1_epi32((int)0x80000000));
+}
+
+// Unsigned 32-bit division. The quotient of two 32-bit integers is exact in
+// double precision to within less than the distance to the next integer, so
+// rounding it down gives the integer quotient.
+static INLINE __m256i div_epu32(__m256i x, __m256i y) {
+  const __m128i lo =
+      div4_epu32(_mm256_castsi256_si128(x), _mm256_castsi256_si128(y));
+  const __m128i hi = div4_epu32(_mm256_extracti128_si256(x, 1),
+                                _mm256_extracti128_si256(y, 1));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+// Signed 32-bit division, rounding towards zero.
+static INLINE __m256i div_epi32(__m256i x, __m256i y) {
+  const __m128i lo = _mm256_cvttpd_epi32(
+      _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(x)),
+                    _mm256_cvtepi32_pd(_mm256_castsi256_si128(y))));
+  const __m128i hi = _mm256_cvttpd_epi32(
+      _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1)),
+                    _mm256_cvtepi32_pd(_mm256_extracti128_si256(y, 1))));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+// Turns the box sums of the pixels (B) and of their squares (A) into the
+// coefficients of the filter. This follows av1_selfguided_restoration_c(),
+// including the wrap-around of its 32-bit arithmetic.
+static void calc_ab(int32_t *A, int32_t *B, const int8_t *num, int count,
+                    int eps) {
+  const __m256i sgr = _mm256_set1_epi32(SGRPROJ_SGR);
+  const __m256i eps_v = _mm256_set1_epi32(eps);
+  int k;
+
+  for (k = 0; k + 8 <= count; k += 8) {
+    const __m256i a = _mm256_loadu_si256((const __m256i *)(A + k));
+    const __m256i b = _mm256_loadu_si256((const __m256i *)(B + k));
+    const __m256i n =
+        _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(num + k)));
+    const __m256i p =
+        _mm256_sub_epi32(_mm256_mullo_epi32(a, n), _mm256_mullo_epi32(b, b));
+    const __m256i q = _mm256_add_epi32(
+        p, _mm256_mullo_epi32(_mm256_mullo_epi32(n, n), eps_v));
+    const __m256i x = _mm256_add_epi32(_mm256_slli_epi32(p, SGRPROJ_SGR_BITS),
+                                       _mm256_srli_epi32(q, 1));
+    const __m256i a_out = div_epu32(x, q);
+    const __m256i y =
+        _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(sgr, a_out), b),
+                         _mm256_srli_epi32(n, 1));
+    _mm256_storeu_si256((__m256i *)(A + k), a_out);
+    _mm256_storeu_si256((__m256i *)(B + k), div_epi32(y, n));
+  }
+  for (; k < count; ++k) {
+    const int n = num[k];
+    const uint32_t p = (uint32_t)((uint64_t)A[k] * n - (uint64_t)B[k] * B[k]);
+    const uint32_t q = (uint32_t)(p + n * n * eps);
+    A[k] = (int32_t)(((uint64_t)p << SGRPROJ_SGR_BITS) + (q >> 1)) / q;
+    B[k] = ((SGRPROJ_SGR - A[k]) * B[k] + (n >> 1)) / n;
+  }
+}
+
+// Sum of the coefficient at c and its neighbours, weighted 4 for the
+// horizontal and vertical ones and 3 for the diagonal ones.
+static INLINE __m256i cross_sum(const int32_t *c, int stride) {
+  const __m256i fours = _mm256_add_epi32(
+      _mm256_add_epi32(
+          _mm256_loadu_si256((const __m256i *)c),
+          _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(c - 1)),
+                           _mm256_loadu_si256((const __m256i *)(c + 1)))),
+      _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(c - stride)),
+                       _mm256_loadu_si256((const __m256i *)(c + stride))));
+  const __m256i threes = _mm256_add_epi32(
+      _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(c - 1 - stride)),
+                       _mm256_loadu_si256((const __m256i *)(c - 1 + stride))),
+      _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(c + 1 - stride)),
+                       _mm256_loadu_si256((const __m256i *)(c + 1 + stride))));
+  return _mm256_add_epi32(
+      _mm256_slli_epi32(fours, 2),
+      _mm256_add_epi32(_mm256_slli_epi32(threes, 1), threes));
+}
+
+static void filter_inside(int32_t *dgd, int width, int height, int stride,
+                          const int32_t *A, const int32_t *B) {
+  const int nb = 5;
+  const __m256i rounding_v = _mm256_set1_epi32((1 << nb) / 2);
+  const __m256i rounding_sgr = _mm256_set1_epi32(1 << (SGRPROJ_SGR_BITS - 1));
+  int i, j;
+
+  for (i = 1; i < height - 1; ++i) {
+    for (j = 1; j + 8 <= width - 1; j += 8) {
+      const int k = i * width + j;
+      const int l = i * stride + j;
+      const __m256i a = cross_sum(A + k, width);
+      const __m256i b = cross_sum(B + k, width);
+      const __m256i d = _mm256_loadu_si256((const __m256i *)(dgd + l));
+      const __m256i v = _mm256_srai_epi32(
+          _mm256_add_epi32(
+              _mm256_slli_epi32(
+                  _mm256_add_epi32(_mm256_mullo_epi32(a, d), b),
+                  SGRPROJ_RST_BITS),
+              rounding_v),
+          nb);
+      _mm256_storeu_si256((__m256i *)(dgd + l),
+                          _mm256_srai_epi32(_mm256_add_epi32(v, rounding_sgr),
+                                            SGRPROJ_SGR_BITS));
+    }
+    for (; j < width - 1; ++j) {
+      const int k = i * width + j;
+      const int l = i * stride + j;
+      const int32_t a =
+          (A[k] + A[k - 1] + A[k + 1] + A[k - width] + A[k + width]) * 4 +
+          (A[k - 1 - width] + A[k - 1 + width] + A[k + 1 - width] +
+           A[k + 1 + width]) *
+              3;
+      const int32_t b =
+          (B[k] + B[k - 1] + B[k + 1] + B[k - width] + B[k + width]) * 4 +
+          (B[k - 1 - width] + B[k - 1 + width] + B[k + 1 - width] +
+           B[k + 1 + width]) *
+              3;
+      const int32_t v =
+          (((a * dgd[l] + b) << SGRPROJ_RST_BITS) + (1 << nb) / 2) >> nb;
+      dgd[l] = ROUND_POWER_OF_TWO(v, SGRPROJ_SGR_BITS);
+    }
+  }
+}
+#endif  // APPROXIMATE_SGR
+
+void av1_selfguided_restoration_avx2(int32_t *dgd, int width, int height,
+                                     int stride, int bit_depth, int r, int eps,
+                                     int32_t *tmpbuf) {
+#if APPROXIMATE_SGR
+  int32_t *A = tmpbuf;
+  int32_t *B = A + RESTORATION_TILEPELS_MAX;
+  int8_t num[RESTORATION_TILEPELS_MAX];
+  eps <<= 2 * (bit_depth - 8);
+
+  // Don't filter tiles with dimensions < 5 on any axis
+  if ((width < 5) || (height < 5)) return;
+
+  av1_box_sum_avx2(dgd, width, height, stride, r, 0, B, width);
+  av1_box_sum_avx2(dgd, width, height, stride, r, 1, A, width);
+  av1_box_num(width, height, r, num, width);
+  calc_ab(A, B, num, width * height, eps);
+  av1_selfguided_filter_edges(dgd, width, height, stride, A, B);
+  filter_inside(dgd, width, height, stride, A, B);
+#else
+  av1_selfguided_restoration_c(dgd, width, height, stride, bit_depth, r, eps,
+                               tmpbuf);
+#endif  // APPROXIMATE_SGR
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>
+#include <string.h>
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+#include "av1/common/restoration.h"
+
+// Widest block the box sums are vectorised for. Restoration tiles are at most
+// 1.5 times the tile size wide; anything wider uses the C version.
+#define BOX_SUM_MAX_WIDTH (RESTORATION_TILESIZE_BIG * 3 / 2)
+#define BOX_SUM_MAX_R 3
+
+static INLINE __m128i load_box_row(const int32_t *src, int sqr) {
+  const __m128i x = _mm_loadu_si128((const __m128i *)src);
+  return sqr ? _mm_mullo_epi32(x, x) : x;
+}
+
+// Vertical sums over the rows [i - r, i + r] that are inside the block, from
+// src into dst. Each column keeps the rows of its window, so the sums can be
+// written in place.
+static void box_sum_vert(const int32_t *src, int width, int height,
+                         int src_stride, int r, int sqr, int32_t *dst,
+                         int dst_stride) {
+  const int n = 2 * r + 1;
+  int i, j, k;
+
+  for (j = 0; j + 4 <= width; j += 4) {
+    __m128i win[2 * BOX_SUM_MAX_R + 1];
+    __m128i sum = _mm_setzero_si128();
+    // Row x of the window is held in win[x % n].
+    for (i = 0; i <= r; ++i) {
+      win[i] = load_box_row(src + i * src_stride + j, sqr);
+      sum = _mm_add_epi32(sum, win[i]);
+    }
+    for (i = 0, k = r + 1; i < height; ++i) {
+      _mm_storeu_si128((__m128i *)(dst + i * dst_stride + j), sum);
+      if (i >= r) sum = _mm_sub_epi32(sum, win[k]);
+      if (i + r + 1 < height) {
+        win[k] = load_box_row(src + (i + r + 1) * src_stride + j, sqr);
+        sum = _mm_add_epi32(sum, win[k]);
+      }
+      if (++k == n) k = 0;
+    }
+  }
+  for (; j < width; ++j) {
+    int32_t win[2 * BOX_SUM_MAX_R + 1];
+    int32_t sum = 0;
+    for (i = 0; i <= r; ++i) {
+      const int32_t x = src[i * src_stride + j];
+      win[i] = sqr ? x * x : x;
+      sum += win[i];
+    }
+    for (i = 0, k = r + 1; i < height; ++i) {
+      dst[i * dst_stride + j] = sum;
+      if (i >= r) sum -= win[k];
+      if (i + r + 1 < height) {
+        const int32_t x = src[(i + r + 1) * src_stride + j];
+        win[k] = sqr ? x * x : x;
+        sum += win[k];
+      }
+      if (++k == n) k = 0;
+    }
+  }
+}
+
+// Horizontal sums over the columns [j - r, j + r] that are inside the block,
+// in place. Each row is copied with zeros on both sides first.
+static void box_sum_horz(int32_t *dst, int width, int height, int dst_stride,
+                         int r) {
+  DECLARE_ALIGNED(16, int32_t,
+                  buf[BOX_SUM_MAX_WIDTH + 2 * BOX_SUM_MAX_R + 4]);
+  int i, j, k;
+
+  memset(buf, 0, sizeof(*buf) * r);
+  for (i = 0; i < height; ++i) {
+    int32_t *const row = dst + i * dst_stride;
+    memcpy(buf + r, row, sizeof(*buf) * width);
+    memset(buf + r + width, 0, sizeof(*buf) * r);
+    for (j = 0; j + 4 <= width; j += 4) {
+      __m128i sum = _mm_loadu_si128((const __m128i *)(buf + j));
+      for (k = 1; k < 2 * r + 1; ++k)
+        sum = _mm_add_epi32(sum, _mm_loadu_si128((const __m128i *)(buf + j + k)));
+      _mm_storeu_si128((__m128i *)(row + j), sum);
+    }
+    for (; j < width; ++j) {
+      int32_t sum = 0;
+      for (k = 0; k < 2 * r + 1; ++k) sum += buf[j + k];
+      row[j] = sum;
+    }
+  }
+}
+
+void av1_box_sum_sse4_1(int32_t *src, int width, int height, int src_stride,
+                        int r, int sqr, int32_t *dst, int dst_stride) {
+  // The C version only sums over the box inside the block when the block is
+  // at least as large as the box.
+  if (r > BOX_SUM_MAX_R || width > BOX_SUM_MAX_WIDTH || width < 2 * r + 1 ||
+      height < 2 * r + 1) {
+    av1_box_sum_c(src, width, height, src_stride, r, sqr, dst, dst_stride);
+    return;
+  }
+  box_sum_vert(src, width, height, src_stride, r, sqr, dst, dst_stride);
+  box_sum_horz(dst, width, height, dst_stride, r);
+}
+
+#if APPROXIMATE_SGR
+// Converts the two low unsigned 32-bit lanes of x to double.
+static INLINE __m128d cvtepu32_pd(__m128i x) {
+  return _mm_add_pd(
+      _mm_cvtepi32_pd(_mm_xor_si128(x, _mm_set1_epi32((int)0x80000000))),
+      _mm_set1_pd(2147483648.0));
+}
+
+// Unsigned 32-bit division. The quotient of two 32-bit integers is exact in
+// double precision to within less than the distance to the next integer, so
+// rounding it down gives the integer quotient.
+static INLINE __m128i div_epu32(__m128i x, __m128i y) {
+  const __m128d lo = _mm_floor_pd(_mm_div_pd(cvtepu32_pd(x), cvtepu32_pd(y)));
+  const __m128d hi = _mm_floor_pd(_mm_div_pd(cvtepu32_pd(_mm_srli_si128(x, 8)),
+                                             cvtepu32_pd(_mm_srli_si128(y, 8))));
+  const __m128d bias = _mm_set1_pd(2147483648.0);
+  const __m128i q = _mm_unpacklo_epi64(_mm_cvtpd_epi32(_mm_sub_pd(lo, bias)),
+                                       _mm_cvtpd_epi32(_mm_sub_pd(hi, bias)));
+  return _mm_xor_si128(q, _mm_set1_epi32((int)0x80000000));
+}
+
+// Signed 32-bit division, rounding towards zero.
+static INLINE __m128i div_epi32(__m128i x, __m128i y) {
+  const __m128d lo = _mm_div_pd(_mm_cvtepi32_pd(x), _mm_cvtepi32_pd(y));
+  const __m128d hi = _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(x, 8)),
+                                _mm_cvtepi32_pd(_mm_srli_si128(y, 8)));
+  return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+}
+
+// Turns the box sums of the pixels (B) and of their squares (A) into the
+// coefficients of the filter. This follows av1_selfguided_restoration_c(),
+// including the wrap-around of its 32-bit arithmetic.
+static void calc_ab(int32_t *A, int32_t *B, const int8_t *num, int count,
+                    int eps) {
+  const __m128i sgr = _mm_set1_epi32(SGRPROJ_SGR);
+  const __m128i eps_v = _mm_set1_epi32(eps);
+  int k;
+
+  for (k = 0; k + 4 <= count; k += 4) {
+    const __m128i a = _mm_loadu_si128((const __m128i *)(A + k));
+    const __m128i b = _mm_loadu_si128((const __m128i *)(B + k));
+    const __m128i n = _mm_cvtepi8_epi32(_mm_cvtsi32_si128(*(int *)(num + k)));
+    const __m128i p =
+        _mm_sub_epi32(_mm_mullo_epi32(a, n), _mm_mullo_epi32(b, b));
+    const __m128i q =
+        _mm_add_epi32(p, _mm_mullo_epi32(_mm_mullo_epi32(n, n), eps_v));
+    const __m128i x =
+        _mm_add_epi32(_mm_slli_epi32(p, SGRPROJ_SGR_BITS), _mm_srli_epi32(q, 1));
+    const __m128i a_out = div_epu32(x, q);
+    const __m128i y = _mm_add_epi32(
+        _mm_mullo_epi32(_mm_sub_epi32(sgr, a_out), b), _mm_srli_epi32(n, 1));
+    _mm_storeu_si128((__m128i *)(A + k), a_out);
+    _mm_storeu_si128((__m128i *)(B + k), div_epi32(y, n));
+  }
+  for (; k < count; ++k) {
+    const int n = num[k];
+    const uint32_t p = (uint32_t)((uint64_t)A[k] * n - (uint64_t)B[k] * B[k]);
+    const uint32_t q = (uint32_t)(p + n * n * eps);
+    A[k] = (int32_t)(((uint64_t)p << SGRPROJ_SGR_BITS) + (q >> 1)) / q;
+    B[k] = ((SGRPROJ_SGR - A[k]) * B[k] + (n >> 1)) / n;
+  }
+}
+
+// Sum of the coefficient at c and its neighbours, weighted 4 for the
+// horizontal and vertical ones and 3 for the diagonal ones.
+static INLINE __m128i cross_sum(const int32_t *c, int stride) {
+  const __m128i fours = _mm_add_epi32(
+      _mm_add_epi32(_mm_loadu_si128((const __m128i *)c),
+                    _mm_add_epi32(_mm_loadu_si128((const __m128i *)(c - 1)),
+                                  _mm_loadu_si128((const __m128i *)(c + 1)))),
+      _mm_add_epi32(_mm_loadu_si128((const __m128i *)(c - stride)),
+                    _mm_loadu_si128((const __m128i *)(c + stride))));
+  const __m128i threes = _mm_add_epi32(
+      _mm_add_epi32(_mm_loadu_si128((const __m128i *)(c - 1 - stride)),
+                    _mm_loadu_si128((const __m128i *)(c - 1 + stride))),
+      _mm_add_epi32(_mm_loadu_si128((const __m128i *)(c + 1 - stride)),
+                    _mm_loadu_si128((const __m128i *)(c + 1 + stride))));
+  return _mm_add_epi32(_mm_slli_epi32(fours, 2),
+                       _mm_add_epi32(_mm_slli_epi32(threes, 1), threes));
+}
+
+static void filter_inside(int32_t *dgd, int width, int height, int stride,
+                          const int32_t *A, const int32_t *B) {
+  const int nb = 5;
+  const __m128i rounding_v = _mm_set1_epi32((1 << nb) / 2);
+  const __m128i rounding_sgr = _mm_set1_epi32(1 << (SGRPROJ_SGR_BITS - 1));
+  int i, j;
+
+  for (i = 1; i < height - 1; ++i) {
+    for (j = 1; j + 4 <= width - 1; j += 4) {
+      const int k = i * width + j;
+      const int l = i * stride + j;
+      const __m128i a = cross_sum(A + k, width);
+      const __m128i b = cross_sum(B + k, width);
+      const __m128i d = _mm_loadu_si128((const __m128i *)(dgd + l));
+      const __m128i v = _mm_srai_epi32(
+          _mm_add_epi32(
+              _mm_slli_epi32(_mm_add_epi32(_mm_mullo_epi32(a, d), b),
+                             SGRPROJ_RST_BITS),
+              rounding_v),
+          nb);
+      _mm_storeu_si128(
+          (__m128i *)(dgd + l),
+          _mm_srai_epi32(_mm_add_epi32(v, rounding_sgr), SGRPROJ_SGR_BITS));
+    }
+    for (; j < width - 1; ++j) {
+      const int k = i * width + j;
+      const int l = i * stride + j;
+      const int32_t a =
+          (A[k] + A[k - 1] + A[k + 1] + A[k - width] + A[k + width]) * 4 +
+          (A[k - 1 - width] + A[k - 1 + width] + A[k + 1 - width] +
+           A[k + 1 + width]) *
+              3;
+      const int32_t b =
+          (B[k] + B[k - 1] + B[k + 1] + B[k - width] + B[k + width]) * 4 +
+          (B[k - 1 - width] + B[k - 1 + width] + B[k + 1 - width] +
+           B[k + 1 + width]) *
+              3;
+      const int32_t v =
+          (((a * dgd[l] + b) << SGRPROJ_RST_BITS) + (1 << nb) / 2) >> nb;
+      dgd[l] = ROUND_POWER_OF_TWO(v, SGRPROJ_SGR_BITS);
+    }
+  }
+}
+#endif  // APPROXIMATE_SGR
+
+void av1_selfguided_restoration_sse4_1(int32_t *dgd, int width, int height,
+                                       int stride, int bit_depth, int r,
+                                       int eps, int32_t *tmpbuf) {
+#if APPROXIMATE_SGR
+  int32_t *A = tmpbuf;
+  int32_t *B = A + RESTORATION_TILEPELS_MAX;
+  int8_t num[RESTORATION_TILEPELS_MAX];
+  eps <<= 2 * (bit_depth - 8);
+
+  // Don't filter tiles with dimensions < 5 on any axis
+  if ((width < 5) || (height < 5)) return;
+
+  av1_box_sum_sse4_1(dgd, width, height, stride, r, 0, B, width);
+  av1_box_sum_sse4_1(dgd, width, height, stride, r, 1, A, width);
+  av1_box_num(width, height, r, num, width);
+  calc_ab(A, B, num, width * height, eps);
+  av1_selfguided_filter_edges(dgd, width, height, stride, A, B);
+  filter_inside(dgd, width, height, stride, A, B);
+#else
+  av1_selfguided_restoration_c(dgd, width, height, stride, bit_depth, r, eps,
+                               tmpbuf);
+#endif  // APPROXIMATE_SGR
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "./av1_rtcd.h"
+#include "av1/common/warped_motion.h"
+#include "av1/common/x86/warp_plane_common.h"
+
+static INLINE __m256i pair_m128i(__m128i lo, __m128i hi) {
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+// Returns the filters with the (offset and rounded) positions sx0 and sx1 in
+// the first and second 128-bit lanes.
+static INLINE __m256i warp_filter2(int sx0, int sx1) {
+  return pair_m128i(warp_filter_row(sx0 >> WARPEDDIFF_PREC_BITS),
+                    warp_filter_row(sx1 >> WARPEDDIFF_PREC_BITS));
+}
+
+// Transposes the eight filters starting at positions sx0 and sx1 (spaced by
+// alpha) into the coefficient order used by the 8-tap filters below:
+// coeff[t] holds taps t and t + 1 for pixels 0, 2, 4, 6 (even t) or
+// 1, 3, 5, 7 (odd t) of each block.
+static INLINE void warp_coeffs2(int sx0, int sx1, int alpha, __m256i *coeff) {
+  const __m256i tmp_0 = warp_filter2(sx0 + 0 * alpha, sx1 + 0 * alpha);
+  const __m256i tmp_1 = warp_filter2(sx0 + 1 * alpha, sx1 + 1 * alpha);
+  const __m256i tmp_2 = warp_filter2(sx0 + 2 * alpha, sx1 + 2 * alpha);
+  const __m256i tmp_3 = warp_filter2(sx0 + 3 * alpha, sx1 + 3 * alpha);
+  const __m256i tmp_4 = warp_filter2(sx0 + 4 * alpha, sx1 + 4 * alpha);
+  const __m256i tmp_5 = warp_filter2(sx0 + 5 * alpha, sx1 + 5 * alpha);
+  const __m256i tmp_6 = warp_filter2(sx0 + 6 * alpha, sx1 + 6 * alpha);
+  const __m256i tmp_7 = warp_filter2(sx0 + 7 * alpha, sx1 + 7 * alpha);
+
+  // coeffs 0 1 0 1 2 3 2 3 for pixels 0, 2
+  const __m256i tmp_8 = _mm256_unpacklo_epi32(tmp_0, tmp_2);
+  // coeffs 0 1 0 1 2 3 2 3 for pixels 4, 6
+  const __m256i tmp_10 = _mm256_unpacklo_epi32(tmp_4, tmp_6);
+  // coeffs 4 5 4 5 6 7 6 7 for pixels 0, 2
+  const __m256i tmp_12 = _mm256_unpackhi_epi32(tmp_0, tmp_2);
+  // coeffs 4 5 4 5 6 7 6 7 for pixels 4, 6
+  const __m256i tmp_14 = _mm256_unpackhi_epi32(tmp_4, tmp_6);
+
+  const __m256i tmp_9 = _mm256_unpacklo_epi32(tmp_1, tmp_3);
+  const __m256i tmp_11 = _mm256_unpacklo_epi32(tmp_5, tmp_7);
+  const __m256i tmp_13 = _mm256_unpackhi_epi32(tmp_1, tmp_3);
+  const __m256i tmp_15 = _mm256_unpackhi_epi32(tmp_5, tmp_7);
+
+  coeff[0] = _mm256_unpacklo_epi64(tmp_8, tmp_10);
+  coeff[2] = _mm256_unpackhi_epi64(tmp_8, tmp_10);
+  coeff[4] = _mm256_unpacklo_epi64(tmp_12, tmp_14);
+  coeff[6] = _mm256_unpackhi_epi64(tmp_12, tmp_14);
+  coeff[1] = _mm256_unpacklo_epi64(tmp_9, tmp_11);
+  coeff[3] = _mm256_unpackhi_epi64(tmp_9, tmp_11);
+  coeff[5] = _mm256_unpacklo_epi64(tmp_13, tmp_15);
+  coeff[7] = _mm256_unpackhi_epi64(tmp_13, tmp_15);
+}
+
+// Loads the source pixels of a row for the horizontal filter of a block. If
+// every sample would come from the leftmost or rightmost column, all of the
+// pixels are set to that column. Since each filter sums to
+// 1 << WARPEDPIXEL_FILTER_BITS, this matches the shortcut in
+// av1_warp_affine_c().
+static INLINE __m128i warp_load_row(const uint8_t *row, int ix4, int width) {
+  if (ix4 <= -7)
+    return _mm_set1_epi8((char)row[0]);
+  else if (ix4 >= width + 6)
+    return _mm_set1_epi8((char)row[width - 1]);
+  return _mm_loadu_si128((const __m128i *)(row + ix4 - 7));
+}
+
+/* AVX2 version of the rotzoom/affine warp filter. Pairs of horizontally
+   adjacent 8x8 blocks are filtered together, one block per 128-bit lane,
+   with the same steps as av1_warp_affine_sse2(). */
+void av1_warp_affine_avx2(int32_t *mat, uint8_t *ref, int width, int height,
+                          int stride, uint8_t *pred, int p_col, int p_row,
+                          int p_width, int p_height, int p_stride,
+                          int subsampling_x, int subsampling_y, int ref_frm,
+                          int32_t alpha, int32_t beta, int32_t gamma,
+                          int32_t delta) {
+  __m256i tmp[15];
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i round_const =
+      _mm256_set1_epi32((1 << (2 * WARPEDPIXEL_FILTER_BITS)) >> 1);
+  // Rounding and offset of the filter positions
+  const int offset = (1 << (WARPEDDIFF_PREC_BITS - 1)) +
+                     (WARPEDPIXEL_PREC_SHIFTS << WARPEDDIFF_PREC_BITS);
+  int i, j, k;
+
+  /* Note: As in av1_warp_affine_sse2(), the left/right frame borders need to
+     be extended by at least 13 pixels each.
+  */
+
+  for (i = 0; i < p_height; i += 8) {
+    // If only one block is left in this row, it is filtered twice and
+    // stored once.
+    for (j = 0; j < p_width; j += 16) {
+      const int two_blocks = p_width - j > 8;
+      const WarpBlockPos pos0 = warp_block_pos(
+          mat, p_col + j + 4, p_row + i + 4, subsampling_x, subsampling_y);
+      const WarpBlockPos pos1 =
+          two_blocks ? warp_block_pos(mat, p_col + j + 12, p_row + i + 4,
+                                      subsampling_x, subsampling_y)
+                     : pos0;
+
+      // Horizontal filter
+      for (k = -7; k < AOMMIN(8, p_height - i); ++k) {
+        const int iy0 = clamp(pos0.iy4 + k, 0, height - 1);
+        const int iy1 = clamp(pos1.iy4 + k, 0, height - 1);
+        const int sx0 = pos0.sx4 + alpha * (-4) + beta * k + offset;
+        const int sx1 = pos1.sx4 + alpha * (-4) + beta * k + offset;
+        const __m256i src =
+            pair_m128i(warp_load_row(ref + iy0 * stride, pos0.ix4, width),
+                       warp_load_row(ref + iy1 * stride, pos1.ix4, width));
+        __m256i coeff[8];
+
+        warp_coeffs2(sx0, sx1, alpha, coeff);
+
+        {
+          // Calculate filtered results
+          const __m256i src_0 = _mm256_unpacklo_epi8(src, zero);
+          const __m256i res_0 = _mm256_madd_epi16(src_0, coeff[0]);
+          const __m256i src_2 =
+              _mm256_unpacklo_epi8(_mm256_srli_si256(src, 2), zero);
+          const __m256i res_2 = _mm256_madd_epi16(src_2, coeff[2]);
+          const __m256i src_4 =
+              _mm256_unpacklo_epi8(_mm256_srli_si256(src, 4), zero);
+          const __m256i res_4 = _mm256_madd_epi16(src_4, coeff[4]);
+          const __m256i src_6 =
+              _mm256_unpacklo_epi8(_mm256_srli_si256(src, 6), zero);
+          const __m256i res_6 = _mm256_madd_epi16(src_6, coeff[6]);
+          const __m256i res_even = _mm256_add_epi32(
+              _mm256_add_epi32(res_0, res_4), _mm256_add_epi32(res_2, res_6));
+
+          const __m256i src_1 =
+              _mm256_unpacklo_epi8(_mm256_srli_si256(src, 1), zero);
+          const __m256i res_1 = _mm256_madd_epi16(src_1, coeff[1]);
+          const __m256i src_3 =
+              _mm256_unpacklo_epi8(_mm256_srli_si256(src, 3), zero);
+          const __m256i res_3 = _mm256_madd_epi16(src_3, coeff[3]);
+          const __m256i src_5 =
+              _mm256_unpacklo_epi8(_mm256_srli_si256(src, 5), zero);
+          const __m256i res_5 = _mm256_madd_epi16(src_5, coeff[5]);
+          const __m256i src_7 =
+              _mm256_unpacklo_epi8(_mm256_srli_si256(src, 7), zero);
+          const __m256i res_7 = _mm256_madd_epi16(src_7, coeff[7]);
+          const __m256i res_odd = _mm256_add_epi32(
+              _mm256_add_epi32(res_1, res_5), _mm256_add_epi32(res_3, res_7));
+
+          // Columns in the order 0, 2, 4, 6, 1, 3, 5, 7, as in the SSE2
+          // version.
+          tmp[k + 7] = _mm256_packs_epi32(res_even, res_odd);
+        }
+      }
+
+      // Vertical filter
+      for (k = -4; k < AOMMIN(4, p_height - i - 4); ++k) {
+        const int sy0 = pos0.sy4 + gamma * (-4) + delta * k + offset;
+        const int sy1 = pos1.sy4 + gamma * (-4) + delta * k + offset;
+        const __m256i *src = tmp + (k + 4);
+        __m256i coeff[8];
+
+        // Pairs of consecutive rows in the column order 0 0 2 2 4 4 6 6 and
+        // 1 1 3 3 5 5 7 7
+        const __m256i src_0 = _mm256_unpacklo_epi16(src[0], src[1]);
+        const __m256i src_2 = _mm256_unpacklo_epi16(src[2], src[3]);
+        const __m256i src_4 = _mm256_unpacklo_epi16(src[4], src[5]);
+        const __m256i src_6 = _mm256_unpacklo_epi16(src[6], src[7]);
+        const __m256i src_1 = _mm256_unpackhi_epi16(src[0], src[1]);
+        const __m256i src_3 = _mm256_unpackhi_epi16(src[2], src[3]);
+        const __m256i src_5 = _mm256_unpackhi_epi16(src[4], src[5]);
+        const __m256i src_7 = _mm256_unpackhi_epi16(src[6], src[7]);
+
+        warp_coeffs2(sy0, sy1, gamma, coeff);
+
+        {
+          const __m256i res_even = _mm256_add_epi32(
+              _mm256_add_epi32(_mm256_madd_epi16(src_0, coeff[0]),
+                               _mm256_madd_epi16(src_2, coeff[2])),
+              _mm256_add_epi32(_mm256_madd_epi16(src_4, coeff[4]),
+                               _mm256_madd_epi16(src_6, coeff[6])));
+          const __m256i res_odd = _mm256_add_epi32(
+              _mm256_add_epi32(_mm256_madd_epi16(src_1, coeff[1]),
+                               _mm256_madd_epi16(src_3, coeff[3])),
+              _mm256_add_epi32(_mm256_madd_epi16(src_5, coeff[5]),
+                               _mm256_madd_epi16(src_7, coeff[7])));
+
+          // Rearrange pixels back into the order 0 ... 7
+          const __m256i res_lo = _mm256_unpacklo_epi32(res_even, res_odd);
+          const __m256i res_hi = _mm256_unpackhi_epi32(res_even, res_odd);
+
+          // Round and pack into 8 bits
+          const __m256i res_lo_round =
+              _mm256_srai_epi32(_mm256_add_epi32(res_lo, round_const),
+                                2 * WARPEDPIXEL_FILTER_BITS);
+          const __m256i res_hi_round =
+              _mm256_srai_epi32(_mm256_add_epi32(res_hi, round_const),
+                                2 * WARPEDPIXEL_FILTER_BITS);
+          const __m256i res_16bit =
+              _mm256_packs_epi32(res_lo_round, res_hi_round);
+          const __m256i res_8bit = _mm256_packus_epi16(res_16bit, res_16bit);
+          __m128i res[2];
+          int b;
+
+          res[0] = _mm256_castsi256_si128(res_8bit);
+          res[1] = _mm256_extracti128_si256(res_8bit, 1);
+
+          // Store, blending with 'pred' if needed
+          for (b = 0; b <= two_blocks; ++b) {
+            __m128i *p = (__m128i *)&pred[(i + k + 4) * p_stride + j + 8 * b];
+            if (ref_frm) {
+              const __m128i orig = _mm_loadl_epi64(p);
+              _mm_storel_epi64(p, _mm_avg_epu8(res[b], orig));
+            } else {
+              _mm_storel_epi64(p, res[b]);
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_COMMON_X86_WARP_PLANE_COMMON_H_
+#define AV1_COMMON_X86_WARP_PLANE_COMMON_H_
+
+#include <emmintrin.h>
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "av1/common/warped_motion.h"
+
+// Returns row 'index' of warped_filter.
+static INLINE __m128i warp_filter_row(int index) {
+  return _mm_loadu_si128((const __m128i *)warped_filter[index]);
+}
+
+// Integer and fractional position of the center of the 8x8 block at
+// (p_col + j, p_row + i) in the reference frame, as in av1_warp_affine_c().
+typedef struct {
+  int32_t ix4, sx4, iy4, sy4;
+} WarpBlockPos;
+
+static INLINE WarpBlockPos warp_block_pos(const int32_t *mat, int dst_x,
+                                          int dst_y, int subsampling_x,
+                                          int subsampling_y) {
+  WarpBlockPos pos;
+  int32_t x4, y4;
+  if (subsampling_x)
+    x4 = ROUND_POWER_OF_TWO_SIGNED(
+        mat[2] * 2 * dst_x + mat[3] * 2 * dst_y + mat[0] +
+            (mat[2] + mat[3] - (1 << WARPEDMODEL_PREC_BITS)) / 2,
+        1);
+  else
+    x4 = mat[2] * dst_x + mat[3] * dst_y + mat[0];
+
+  if (subsampling_y)
+    y4 = ROUND_POWER_OF_TWO_SIGNED(
+        mat[4] * 2 * dst_x + mat[5] * 2 * dst_y + mat[1] +
+            (mat[4] + mat[5] - (1 << WARPEDMODEL_PREC_BITS)) / 2,
+        1);
+  else
+    y4 = mat[4] * dst_x + mat[5] * dst_y + mat[1];
+
+  pos.ix4 = x4 >> WARPEDMODEL_PREC_BITS;
+  pos.sx4 = x4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
+  pos.iy4 = y4 >> WARPEDMODEL_PREC_BITS;
+  pos.sy4 = y4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
+  return pos;
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+// The high bitdepth filters round the filter position symmetrically around
+// zero, see av1_highbd_warp_affine_c().
+static INLINE __m128i highbd_warp_filter(int32_t pos) {
+  const int index = ROUND_POWER_OF_TWO_SIGNED(pos, WARPEDDIFF_PREC_BITS);
+  return warp_filter_row(index + WARPEDPIXEL_PREC_SHIFTS);
+}
+
+// Loads the 16 pixels row[x .. x + 15], replicating the first and last
+// columns of the frame for the pixels outside of it.
+static INLINE void highbd_warp_load_row(const uint16_t *row, int x, int width,
+                                        __m128i *lo, __m128i *hi) {
+  if (x >= 0 && x + 15 <= width - 1) {
+    *lo = _mm_loadu_si128((const __m128i *)(row + x));
+    *hi = _mm_loadu_si128((const __m128i *)(row + x + 8));
+  } else {
+    DECLARE_ALIGNED(16, uint16_t, buf[16]);
+    int i;
+    for (i = 0; i < 16; ++i) buf[i] = row[clamp(x + i, 0, width - 1)];
+    *lo = _mm_load_si128((const __m128i *)buf);
+    *hi = _mm_load_si128((const __m128i *)(buf + 8));
+  }
+}
+
+// Returns in out[m] the coefficients of tap m of the vertical filters for the
+// eight columns of a block row, starting at position sy for column 0.
+static INLINE void highbd_warp_vert_coeffs(int32_t sy, int32_t gamma,
+                                           __m128i *out) {
+  const __m128i f0 = highbd_warp_filter(sy + 0 * gamma);
+  const __m128i f1 = highbd_warp_filter(sy + 1 * gamma);
+  const __m128i f2 = highbd_warp_filter(sy + 2 * gamma);
+  const __m128i f3 = highbd_warp_filter(sy + 3 * gamma);
+  const __m128i f4 = highbd_warp_filter(sy + 4 * gamma);
+  const __m128i f5 = highbd_warp_filter(sy + 5 * gamma);
+  const __m128i f6 = highbd_warp_filter(sy + 6 * gamma);
+  const __m128i f7 = highbd_warp_filter(sy + 7 * gamma);
+  const __m128i a0 = _mm_unpacklo_epi16(f0, f1);
+  const __m128i a1 = _mm_unpacklo_epi16(f2, f3);
+  const __m128i a2 = _mm_unpacklo_epi16(f4, f5);
+  const __m128i a3 = _mm_unpacklo_epi16(f6, f7);
+  const __m128i a4 = _mm_unpackhi_epi16(f0, f1);
+  const __m128i a5 = _mm_unpackhi_epi16(f2, f3);
+  const __m128i a6 = _mm_unpackhi_epi16(f4, f5);
+  const __m128i a7 = _mm_unpackhi_epi16(f6, f7);
+  const __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+  const __m128i b1 = _mm_unpacklo_epi32(a2, a3);
+  const __m128i b2 = _mm_unpackhi_epi32(a0, a1);
+  const __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+  const __m128i b4 = _mm_unpacklo_epi32(a4, a5);
+  const __m128i b5 = _mm_unpacklo_epi32(a6, a7);
+  const __m128i b6 = _mm_unpackhi_epi32(a4, a5);
+  const __m128i b7 = _mm_unpackhi_epi32(a6, a7);
+  out[0] = _mm_unpacklo_epi64(b0, b1);
+  out[1] = _mm_unpackhi_epi64(b0, b1);
+  out[2] = _mm_unpacklo_epi64(b2, b3);
+  out[3] = _mm_unpackhi_epi64(b2, b3);
+  out[4] = _mm_unpacklo_epi64(b4, b5);
+  out[5] = _mm_unpackhi_epi64(b4, b5);
+  out[6] = _mm_unpacklo_epi64(b6, b7);
+  out[7] = _mm_unpackhi_epi64(b6, b7);
+}
+
+// Stores the first w (at most 8) pixels of res to p, averaging with the
+// pixels already there if ref_frm is set.
+static INLINE void highbd_warp_store(uint16_t *p, __m128i res, int w,
+                                     int ref_frm) {
+  if (w == 8) {
+    if (ref_frm) res = _mm_avg_epu16(res, _mm_loadu_si128((__m128i *)p));
+    _mm_storeu_si128((__m128i *)p, res);
+  } else {
+    DECLARE_ALIGNED(16, uint16_t, buf[8]);
+    int i;
+    _mm_store_si128((__m128i *)buf, res);
+    for (i = 0; i < w; ++i)
+      p[i] = ref_frm ? ROUND_POWER_OF_TWO(p[i] + buf[i], 1) : buf[i];
+  }
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+#endif  // AV1_COMMON_X86_WARP_PLANE_COMMON_H_
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>  // avx2
+#include <string.h>
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/mem.h"
+#include "av1/common/restoration.h"
+
+// The Wiener filters are symmetric, so the taps are applied to the sums of
+// the mirrored pixels: (f0, f1) to (p0 + p6, p1 + p5) and (f2, f3) to
+// (p2 + p4, p3), two taps per _mm256_madd_epi16.
+static INLINE void wiener_coeffs(const int16_t *filter, __m256i *c01,
+                                 __m256i *c23) {
+  *c01 = _mm256_set1_epi32((int)((uint16_t)filter[0] |
+                                 ((uint32_t)(uint16_t)filter[1] << 16)));
+  *c23 = _mm256_set1_epi32((int)((uint16_t)filter[2] |
+                                 ((uint32_t)(uint16_t)filter[3] << 16)));
+}
+
+// Filters 16 pixels given the 7 vectors of taps p[0..6], adds the centre
+// pixel back and clamps the result to [0, max_val]. The unpacks and the pack
+// both work within 128-bit lanes, so the pixels come out in order.
+static INLINE __m256i wiener_filter_16(const __m256i *p, __m256i c01,
+                                       __m256i c23, __m256i max_val) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i round = _mm256_set1_epi32(1 << (WIENER_FILT_PREC_BITS - 1));
+  const __m256i s06 = _mm256_add_epi16(p[0], p[6]);
+  const __m256i s15 = _mm256_add_epi16(p[1], p[5]);
+  const __m256i s24 = _mm256_add_epi16(p[2], p[4]);
+  __m256i lo = _mm256_add_epi32(
+      _mm256_madd_epi16(_mm256_unpacklo_epi16(s06, s15), c01),
+      _mm256_madd_epi16(_mm256_unpacklo_epi16(s24, p[3]), c23));
+  __m256i hi = _mm256_add_epi32(
+      _mm256_madd_epi16(_mm256_unpackhi_epi16(s06, s15), c01),
+      _mm256_madd_epi16(_mm256_unpackhi_epi16(s24, p[3]), c23));
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, round), WIENER_FILT_PREC_BITS);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, round), WIENER_FILT_PREC_BITS);
+  lo = _mm256_add_epi32(lo, _mm256_unpacklo_epi16(p[3], zero));
+  hi = _mm256_add_epi32(hi, _mm256_unpackhi_epi16(p[3], zero));
+  return _mm256_min_epu16(_mm256_packus_epi32(lo, hi), max_val);
+}
+
+static void wiener_filter_horiz(const uint8_t *src, ptrdiff_t src_stride,
+                                uint16_t *dst, int w, int h,
+                                const int16_t *filter) {
+  const __m256i max_val = _mm256_set1_epi16(255);
+  __m256i c01, c23, p[WIENER_WIN];
+  int i, j, k;
+
+  wiener_coeffs(filter, &c01, &c23);
+  for (i = 0; i < h; ++i) {
+    const uint8_t *const src_p = src + i * src_stride - WIENER_HALFWIN;
+    uint16_t *const dst_p = dst + i * w;
+    for (j = 0; j + 16 <= w; j += 16) {
+      for (k = 0; k < WIENER_WIN; ++k)
+        p[k] = _mm256_cvtepu8_epi16(
+            _mm_loadu_si128((const __m128i *)(src_p + j + k)));
+      _mm256_storeu_si256((__m256i *)(dst_p + j),
+                          wiener_filter_16(p, c01, c23, max_val));
+    }
+    for (; j < w; ++j) {
+      int sum = 0;
+      for (k = 0; k < WIENER_WIN; ++k) sum += src_p[j + k] * filter[k];
+      dst_p[j] = clip_pixel(ROUND_POWER_OF_TWO(sum, WIENER_FILT_PREC_BITS) +
+                            src_p[j + WIENER_HALFWIN]);
+    }
+  }
+}
+
+static void wiener_filter_vert(const uint16_t *src, uint8_t *dst,
+                               ptrdiff_t dst_stride, int w, int h,
+                               const int16_t *filter) {
+  const __m256i max_val = _mm256_set1_epi16(255);
+  __m256i c01, c23, p[WIENER_WIN];
+  int i, j, k;
+
+  wiener_coeffs(filter, &c01, &c23);
+  for (i = 0; i < h; ++i) {
+    const uint16_t *const src_p = src + i * w;
+    uint8_t *const dst_p = dst + i * dst_stride;
+    for (j = 0; j + 16 <= w; j += 16) {
+      __m256i res;
+      for (k = 0; k < WIENER_WIN; ++k)
+        p[k] = _mm256_loadu_si256((const __m256i *)(src_p + k * w + j));
+      res = wiener_filter_16(p, c01, c23, max_val);
+      // Each lane packs to its own 8 bytes; gather them into the low lane.
+      res = _mm256_permute4x64_epi64(_mm256_packus_epi16(res, res), 0x08);
+      _mm_storeu_si128((__m128i *)(dst_p + j), _mm256_castsi256_si128(res));
+    }
+    for (; j < w; ++j) {
+      int sum = 0;
+      for (k = 0; k < WIENER_WIN; ++k) sum += src_p[k * w + j] * filter[k];
+      dst_p[j] = clip_pixel(ROUND_POWER_OF_TWO(sum, WIENER_FILT_PREC_BITS) +
+                            src_p[WIENER_HALFWIN * w + j]);
+    }
+  }
+}
+
+void av1_wiener_convolve_add_src_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                                      uint8_t *dst, ptrdiff_t dst_stride,
+                                      const int16_t *filter_x,
+                                      const int16_t *filter_y, int w, int h) {
+  DECLARE_ALIGNED(32, uint16_t, temp[(WIENER_STRIPE_HEIGHT + WIENER_WIN - 1) *
+                                     WIENER_STRIPE_WIDTH]);
+  int i, j;
+  for (j = 0; j < w; j += WIENER_STRIPE_WIDTH) {
+    const int sw = AOMMIN(WIENER_STRIPE_WIDTH, w - j);
+    wiener_filter_horiz(src - WIENER_HALFWIN * src_stride + j, src_stride,
+                        temp, sw, WIENER_WIN - 1, filter_x);
+    for (i = 0; i < h; i += WIENER_STRIPE_HEIGHT) {
+      const int sh = AOMMIN(WIENER_STRIPE_HEIGHT, h - i);
+      wiener_filter_horiz(src + (i + WIENER_HALFWIN) * src_stride + j,
+                          src_stride, temp + (WIENER_WIN - 1) * sw, sw, sh,
+                          filter_x);
+      wiener_filter_vert(temp, dst + i * dst_stride + j, dst_stride, sw, sh,
+                         filter_y);
+      memmove(temp, temp + sh * sw, (WIENER_WIN - 1) * sw * sizeof(*temp));
+    }
+  }
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+// The taps of a 12-bit image still fit in 16 bits after the mirrored pixels
+// are summed, so the high bitdepth passes share wiener_filter_16().
+static void highbd_wiener_filter_rows(const uint16_t *src,
+                                      ptrdiff_t src_stride, uint16_t *dst,
+                                      ptrdiff_t dst_stride, int w, int h,
+                                      ptrdiff_t tap_stride,
+                                      const int16_t *filter, int bd) {
+  const __m256i max_val = _mm256_set1_epi16((1 << bd) - 1);
+  __m256i c01, c23, p[WIENER_WIN];
+  int i, j, k;
+
+  wiener_coeffs(filter, &c01, &c23);
+  for (i = 0; i < h; ++i) {
+    const uint16_t *const src_p =
+        src + i * src_stride - WIENER_HALFWIN * tap_stride;
+    uint16_t *const dst_p = dst + i * dst_stride;
+    for (j = 0; j + 16 <= w; j += 16) {
+      for (k = 0; k < WIENER_WIN; ++k)
+        p[k] =
+            _mm256_loadu_si256((const __m256i *)(src_p + k * tap_stride + j));
+      _mm256_storeu_si256((__m256i *)(dst_p + j),
+                          wiener_filter_16(p, c01, c23, max_val));
+    }
+    for (; j < w; ++j) {
+      int sum = 0;
+      for (k = 0; k < WIENER_WIN; ++k)
+        sum += src_p[k * tap_stride + j] * filter[k];
+      dst_p[j] = clip_pixel_highbd(
+          ROUND_POWER_OF_TWO(sum, WIENER_FILT_PREC_BITS) +
+              src_p[WIENER_HALFWIN * tap_stride + j],
+          bd);
+    }
+  }
+}
+
+void av1_highbd_wiener_convolve_add_src_avx2(
+    const uint16_t *src, ptrdiff_t src_stride, uint16_t *dst,
+    ptrdiff_t dst_stride, const int16_t *filter_x, const int16_t *filter_y,
+    int w, int h, int bd) {
+  DECLARE_ALIGNED(32, uint16_t, temp[(WIENER_STRIPE_HEIGHT + WIENER_WIN - 1) *
+                                     WIENER_STRIPE_WIDTH]);
+  int i, j;
+  for (j = 0; j < w; j += WIENER_STRIPE_WIDTH) {
+    const int sw = AOMMIN(WIENER_STRIPE_WIDTH, w - j);
+    highbd_wiener_filter_rows(src - WIENER_HALFWIN * src_stride + j,
+                              src_stride, temp, sw, sw, WIENER_WIN - 1, 1,
+                              filter_x, bd);
+    for (i = 0; i < h; i += WIENER_STRIPE_HEIGHT) {
+      const int sh = AOMMIN(WIENER_STRIPE_HEIGHT, h - i);
+      highbd_wiener_filter_rows(src + (i + WIENER_HALFWIN) * src_stride + j,
+                                src_stride, temp + (WIENER_WIN - 1) * sw, sw,
+                                sw, sh, 1, filter_x, bd);
+      highbd_wiener_filter_rows(temp + WIENER_HALFWIN * sw, sw,
+                                dst + i * dst_stride + j, dst_stride, sw, sh,
+                                sw, filter_y, bd);
+      memmove(temp, temp + sh * sw, (WIENER_WIN - 1) * sw * sizeof(*temp));
+    }
+  }
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
@@ -1485,19 +1485,9 @@ static void decode_mbmi_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
   xd->corrupted |= aom_reader_has_error(r);
 }
 
-static void decode_token_and_recon_block(AV1Decoder *const pbi,
-                                         MACROBLOCKD *const xd, int mi_row,
-                                         int mi_col, aom_reader *r,
-                                         BLOCK_SIZE bsize) {
-  AV1_COMMON *const cm = &pbi->common;
-  const int bw = mi_size_wide[bsize];
-  const int bh = mi_size_high[bsize];
-  const int x_mis = AOMMIN(bw, cm->mi_cols - mi_col);
-  const int y_mis = AOMMIN(bh, cm->mi_rows - mi_row);
-  MB_MODE_INFO *mbmi;
-
-  mbmi = set_offsets(cm, xd, bsize, mi_row, mi_col, bw, bh, x_mis, y_mis);
-
+static void setup_block_tokens(AV1_COMMON *const cm, MACROBLOCKD *const xd,
+                               const MB_MODE_INFO *const mbmi,
+                               BLOCK_SIZE bsize) {
 #if CONFIG_DELTA_Q
   if (cm->delta_q_present_flag) {
     int i;
@@ -1516,6 +1506,8 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
           av1_ac_quant(xd->current_qindex, cm->uv_ac_delta_q, cm->bit_depth);
     }
   }
+#else
+  (void)cm;
 #endif
 
 #if CONFIG_CB4X4
@@ -1523,6 +1515,79 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
 #else
   if (mbmi->skip) reset_skip_context(xd, AOMMAX(BLOCK_8X8, bsize));
 #endif
+}
+
+static void predict_inter_block(AV1_COMMON *const cm, MACROBLOCKD *const xd,
+                                MB_MODE_INFO *const mbmi, int mi_row,
+                                int mi_col, BLOCK_SIZE bsize) {
+  int ref;
+
+  for (ref = 0; ref < 1 + has_second_ref(mbmi); ++ref) {
+    const MV_REFERENCE_FRAME frame = mbmi->ref_frame[ref];
+    RefBuffer *ref_buf = &cm->frame_refs[frame - LAST_FRAME];
+
+    xd->block_refs[ref] = ref_buf;
+    if ((!av1_is_valid_scale(&ref_buf->sf)))
+      aom_internal_error(xd->error_info, AOM_CODEC_UNSUP_BITSTREAM,
+                         "Reference frame has invalid dimensions");
+    av1_setup_pre_planes(xd, ref, ref_buf->buf, mi_row, mi_col, &ref_buf->sf);
+  }
+#if CONFIG_WARPED_MOTION
+  if (mbmi->motion_mode == WARPED_CAUSAL) {
+    int i;
+
+    for (i = 0; i < 3; ++i) {
+      const struct macroblockd_plane *pd = &xd->plane[i];
+
+      av1_warp_plane(&mbmi->wm_params[0],
+#if CONFIG_AOM_HIGHBITDEPTH
+                     xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH, xd->bd,
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                     pd->pre[0].buf0, pd->pre[0].width, pd->pre[0].height,
+                     pd->pre[0].stride, pd->dst.buf,
+                     ((mi_col * MI_SIZE) >> pd->subsampling_x),
+                     ((mi_row * MI_SIZE) >> pd->subsampling_y),
+                     xd->n8_w * (MI_SIZE >> pd->subsampling_x),
+                     xd->n8_h * (MI_SIZE >> pd->subsampling_y),
+                     pd->dst.stride, pd->subsampling_x, pd->subsampling_y, 16,
+                     16, 0);
+    }
+  } else {
+#endif  // CONFIG_WARPED_MOTION
+#if CONFIG_CB4X4
+    av1_build_inter_predictors_sb(xd, mi_row, mi_col, NULL, bsize);
+#else
+  av1_build_inter_predictors_sb(xd, mi_row, mi_col, NULL,
+                                AOMMAX(bsize, BLOCK_8X8));
+#endif
+#if CONFIG_WARPED_MOTION
+  }
+#endif  // CONFIG_WARPED_MOTION
+#if CONFIG_MOTION_VAR
+  if (mbmi->motion_mode == OBMC_CAUSAL) {
+#if CONFIG_NCOBMC
+    av1_build_ncobmc_inter_predictors_sb(cm, xd, mi_row, mi_col);
+#else
+    av1_build_obmc_inter_predictors_sb(cm, xd, mi_row, mi_col);
+#endif
+  }
+#endif  // CONFIG_MOTION_VAR
+}
+
+static void decode_token_and_recon_block(AV1Decoder *const pbi,
+                                         MACROBLOCKD *const xd, int mi_row,
+                                         int mi_col, aom_reader *r,
+                                         BLOCK_SIZE bsize) {
+  AV1_COMMON *const cm = &pbi->common;
+  const int bw = mi_size_wide[bsize];
+  const int bh = mi_size_high[bsize];
+  const int x_mis = AOMMIN(bw, cm->mi_cols - mi_col);
+  const int y_mis = AOMMIN(bh, cm->mi_rows - mi_row);
+  MB_MODE_INFO *mbmi;
+
+  mbmi = set_offsets(cm, xd, bsize, mi_row, mi_col, bw, bh, x_mis, y_mis);
+
+  setup_block_tokens(cm, xd, mbmi, bsize);
 
 #if CONFIG_COEF_INTERLEAVE
   {
@@ -1674,61 +1739,7 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
                                               tx_size);
     }
   } else {
-    int ref;
-
-    for (ref = 0; ref < 1 + has_second_ref(mbmi); ++ref) {
-      const MV_REFERENCE_FRAME frame = mbmi->ref_frame[ref];
-      RefBuffer *ref_buf = &cm->frame_refs[frame - LAST_FRAME];
-
-      xd->block_refs[ref] = ref_buf;
-      if ((!av1_is_valid_scale(&ref_buf->sf)))
-        aom_internal_error(xd->error_info, AOM_CODEC_UNSUP_BITSTREAM,
-                           "Reference frame has invalid dimensions");
-      av1_setup_pre_planes(xd, ref, ref_buf->buf, mi_row, mi_col, &ref_buf->sf);
-    }
-#if CONFIG_WARPED_MOTION
-    if (mbmi->motion_mode == WARPED_CAUSAL) {
-      int i;
-#if CONFIG_AOM_HIGHBITDEPTH
-      int use_hbd = xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH;
-#endif  // CONFIG_AOM_HIGHBITDEPTH
-
-      for (i = 0; i < 3; ++i) {
-        const struct macroblockd_plane *pd = &xd->plane[i];
-
-        av1_warp_plane(&mbmi->wm_params[0],
-#if CONFIG_AOM_HIGHBITDEPTH
-                       xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH, xd->bd,
-#endif  // CONFIG_AOM_HIGHBITDEPTH
-                       pd->pre[0].buf0, pd->pre[0].width, pd->pre[0].height,
-                       pd->pre[0].stride, pd->dst.buf,
-                       ((mi_col * MI_SIZE) >> pd->subsampling_x),
-                       ((mi_row * MI_SIZE) >> pd->subsampling_y),
-                       xd->n8_w * (MI_SIZE >> pd->subsampling_x),
-                       xd->n8_h * (MI_SIZE >> pd->subsampling_y),
-                       pd->dst.stride, pd->subsampling_x, pd->subsampling_y, 16,
-                       16, 0);
-      }
-    } else {
-#endif  // CONFIG_WARPED_MOTION
-#if CONFIG_CB4X4
-      av1_build_inter_predictors_sb(xd, mi_row, mi_col, NULL, bsize);
-#else
-    av1_build_inter_predictors_sb(xd, mi_row, mi_col, NULL,
-                                  AOMMAX(bsize, BLOCK_8X8));
-#endif
-#if CONFIG_WARPED_MOTION
-    }
-#endif  // CONFIG_WARPED_MOTION
-#if CONFIG_MOTION_VAR
-    if (mbmi->motion_mode == OBMC_CAUSAL) {
-#if CONFIG_NCOBMC
-      av1_build_ncobmc_inter_predictors_sb(cm, xd, mi_row, mi_col);
-#else
-      av1_build_obmc_inter_predictors_sb(cm, xd, mi_row, mi_col);
-#endif
-    }
-#endif  // CONFIG_MOTION_VAR
+    predict_inter_block(cm, xd, mbmi, mi_row, mi_col, bsize);
 
     // Reconstruction
     if (!mbmi->skip) {
@@ -1772,6 +1783,284 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
   xd->corrupted |= aom_reader_has_error(r);
 }
 
+#if AV1_DEC_ROW_MT
+// Row-based multi-threading: the parser reads the coefficients of a
+// transform block into the superblock side channel, and the reconstruction
+// workers later consume them in the same order.
+static void parse_txb(AV1_COMMON *cm, MACROBLOCKD *const xd, aom_reader *r,
+                      MB_MODE_INFO *const mbmi, int plane, int row, int col,
+                      TX_SIZE tx_size, AV1DecSbCursor *const cursor) {
+  struct macroblockd_plane *const pd = &xd->plane[plane];
+  const PLANE_TYPE plane_type = (plane == 0) ? PLANE_TYPE_Y : PLANE_TYPE_UV;
+  const int block_idx = (row << 1) + col;
+  const TX_TYPE tx_type = get_tx_type(plane_type, xd, block_idx, tx_size);
+  const SCAN_ORDER *scan_order =
+      get_scan(cm, tx_size, tx_type, is_inter_block(mbmi));
+  int16_t max_scan_line = 0;
+  int eob;
+
+  pd->dqcoeff = cursor->dqcoeff;
+  eob = av1_decode_block_tokens(xd, plane, scan_order, col, row, tx_size,
+                                tx_type, &max_scan_line, r, mbmi->segment_id);
+#if CONFIG_ADAPT_SCAN
+  if (xd->counts)
+    av1_update_scan_count_facade(cm, xd->counts, tx_size, tx_type, pd->dqcoeff,
+                                 eob);
+#endif
+  cursor->txb->eob = eob;
+  cursor->txb->max_scan_line = max_scan_line;
+  ++cursor->txb;
+  cursor->dqcoeff += tx_size_2d[tx_size];
+}
+
+static void recon_txb(MACROBLOCKD *const xd, int plane, int row, int col,
+                      TX_SIZE tx_size, AV1DecSbCursor *const cursor) {
+  struct macroblockd_plane *const pd = &xd->plane[plane];
+  const AV1DecTxbInfo *const txb = cursor->txb++;
+
+  pd->dqcoeff = cursor->dqcoeff;
+  cursor->dqcoeff += tx_size_2d[tx_size];
+  if (txb->eob) {
+    const PLANE_TYPE plane_type = (plane == 0) ? PLANE_TYPE_Y : PLANE_TYPE_UV;
+    const int block_idx = (row << 1) + col;
+    const TX_TYPE tx_type = get_tx_type(plane_type, xd, block_idx, tx_size);
+    uint8_t *const dst =
+        &pd->dst.buf[(row * pd->dst.stride + col) << tx_size_wide_log2[0]];
+    inverse_transform_block(xd, plane, tx_type, tx_size, dst, pd->dst.stride,
+                            txb->max_scan_line, txb->eob);
+  }
+}
+
+#if CONFIG_VAR_TX
+static void visit_var_tx(AV1_COMMON *cm, MACROBLOCKD *const xd, aom_reader *r,
+                         MB_MODE_INFO *const mbmi, int plane,
+                         BLOCK_SIZE plane_bsize, int blk_row, int blk_col,
+                         TX_SIZE tx_size, AV1DecSbCursor *const cursor) {
+  const struct macroblockd_plane *const pd = &xd->plane[plane];
+  const BLOCK_SIZE bsize = txsize_to_bsize[tx_size];
+  const int tx_row = blk_row >> (1 - pd->subsampling_y);
+  const int tx_col = blk_col >> (1 - pd->subsampling_x);
+  const TX_SIZE plane_tx_size =
+      plane ? uv_txsize_lookup[bsize][mbmi->inter_tx_size[tx_row][tx_col]][0][0]
+            : mbmi->inter_tx_size[tx_row][tx_col];
+  const int max_blocks_high = max_block_high(xd, plane_bsize, plane);
+  const int max_blocks_wide = max_block_wide(xd, plane_bsize, plane);
+
+  if (blk_row >= max_blocks_high || blk_col >= max_blocks_wide) return;
+
+  if (tx_size == plane_tx_size) {
+    // A NULL reader selects reconstruction.
+    if (r)
+      parse_txb(cm, xd, r, mbmi, plane, blk_row, blk_col, plane_tx_size,
+                cursor);
+    else
+      recon_txb(xd, plane, blk_row, blk_col, plane_tx_size, cursor);
+  } else {
+    const TX_SIZE sub_txs = sub_tx_size_map[tx_size];
+    const int bsl = tx_size_wide_unit[sub_txs];
+    int i;
+
+    assert(bsl > 0);
+
+    for (i = 0; i < 4; ++i) {
+      const int offsetr = blk_row + (i >> 1) * bsl;
+      const int offsetc = blk_col + (i & 0x01) * bsl;
+
+      if (offsetr >= max_blocks_high || offsetc >= max_blocks_wide) continue;
+
+      visit_var_tx(cm, xd, r, mbmi, plane, plane_bsize, offsetr, offsetc,
+                   sub_txs, cursor);
+    }
+  }
+}
+#endif  // CONFIG_VAR_TX
+
+// Walks the transform blocks of a block in bitstream order. With a reader the
+// coefficients are parsed into the cursor, otherwise the block is predicted
+// and reconstructed from it.
+static void visit_block_txbs(AV1_COMMON *cm, MACROBLOCKD *const xd,
+                             aom_reader *r, MB_MODE_INFO *const mbmi,
+                             BLOCK_SIZE bsize, AV1DecSbCursor *const cursor) {
+  int plane;
+
+  if (!is_inter_block(mbmi)) {
+    for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      struct macroblockd_plane *const pd = &xd->plane[plane];
+      const TX_SIZE tx_size = plane ? get_uv_tx_size(mbmi, pd) : mbmi->tx_size;
+      const int stepr = tx_size_high_unit[tx_size];
+      const int stepc = tx_size_wide_unit[tx_size];
+#if CONFIG_CB4X4
+      const BLOCK_SIZE plane_bsize = get_plane_block_size(bsize, pd);
+#else
+      const BLOCK_SIZE plane_bsize =
+          get_plane_block_size(AOMMAX(BLOCK_8X8, bsize), pd);
+#endif
+      const int max_blocks_wide = max_block_wide(xd, plane_bsize, plane);
+      const int max_blocks_high = max_block_high(xd, plane_bsize, plane);
+      int row, col;
+
+      for (row = 0; row < max_blocks_high; row += stepr) {
+        for (col = 0; col < max_blocks_wide; col += stepc) {
+          if (r) {
+            if (!mbmi->skip)
+              parse_txb(cm, xd, r, mbmi, plane, row, col, tx_size, cursor);
+          } else {
+            PREDICTION_MODE mode = (plane == 0) ? mbmi->mode : mbmi->uv_mode;
+            uint8_t *const dst =
+                &pd->dst
+                     .buf[(row * pd->dst.stride + col) << tx_size_wide_log2[0]];
+#if !CONFIG_CB4X4
+            if (mbmi->sb_type < BLOCK_8X8 && plane == 0)
+              mode = xd->mi[0]->bmi[(row << 1) + col].as_mode;
+#endif
+            av1_predict_intra_block(xd, pd->width, pd->height,
+                                    txsize_to_bsize[tx_size], mode, dst,
+                                    pd->dst.stride, dst, pd->dst.stride, col,
+                                    row, plane);
+            if (!mbmi->skip) recon_txb(xd, plane, row, col, tx_size, cursor);
+          }
+        }
+      }
+    }
+  } else if (!mbmi->skip) {
+    for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      const struct macroblockd_plane *const pd = &xd->plane[plane];
+#if CONFIG_CB4X4
+      const BLOCK_SIZE plane_bsize = get_plane_block_size(bsize, pd);
+#else
+      const BLOCK_SIZE plane_bsize =
+          get_plane_block_size(AOMMAX(BLOCK_8X8, bsize), pd);
+#endif
+      const int max_blocks_wide = max_block_wide(xd, plane_bsize, plane);
+      const int max_blocks_high = max_block_high(xd, plane_bsize, plane);
+      int row, col;
+#if CONFIG_VAR_TX
+      const TX_SIZE max_tx_size = max_txsize_rect_lookup[plane_bsize];
+      const int bh_var_tx = tx_size_high_unit[max_tx_size];
+      const int bw_var_tx = tx_size_wide_unit[max_tx_size];
+      for (row = 0; row < max_blocks_high; row += bh_var_tx)
+        for (col = 0; col < max_blocks_wide; col += bw_var_tx)
+          visit_var_tx(cm, xd, r, mbmi, plane, plane_bsize, row, col,
+                       max_tx_size, cursor);
+#else
+      const TX_SIZE tx_size = plane ? get_uv_tx_size(mbmi, pd) : mbmi->tx_size;
+      const int stepr = tx_size_high_unit[tx_size];
+      const int stepc = tx_size_wide_unit[tx_size];
+      for (row = 0; row < max_blocks_high; row += stepr) {
+        for (col = 0; col < max_blocks_wide; col += stepc) {
+          if (r)
+            parse_txb(cm, xd, r, mbmi, plane, row, col, tx_size, cursor);
+          else
+            recon_txb(xd, plane, row, col, tx_size, cursor);
+        }
+      }
+#endif  // CONFIG_VAR_TX
+    }
+  }
+}
+
+#if CONFIG_PALETTE
+static void set_color_index_maps(MACROBLOCKD *const xd,
+                                 const AV1DecSbCursor *const cursor) {
+  xd->plane[0].color_index_map = cursor->color_index_map[0];
+  xd->plane[1].color_index_map = cursor->color_index_map[1];
+}
+
+static void advance_color_index_maps(const MB_MODE_INFO *const mbmi,
+                                     AV1DecSbCursor *const cursor) {
+  const int n_pels = mi_size_wide[mbmi->sb_type] * mi_size_high[mbmi->sb_type] *
+                     MI_SIZE * MI_SIZE;
+  if (mbmi->palette_mode_info.palette_size[0])
+    cursor->color_index_map[0] += n_pels;
+  if (mbmi->palette_mode_info.palette_size[1])
+    cursor->color_index_map[1] += n_pels;
+}
+#endif  // CONFIG_PALETTE
+
+static void parse_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
+                        int mi_row, int mi_col, aom_reader *r,
+#if CONFIG_EXT_PARTITION_TYPES
+                        PARTITION_TYPE partition,
+#endif  // CONFIG_EXT_PARTITION_TYPES
+                        BLOCK_SIZE bsize) {
+  AV1_COMMON *const cm = &pbi->common;
+  AV1DecRowMTData *const row_mt = &pbi->row_mt_data;
+  AV1DecSbData *const sb = row_mt->parse_sb;
+  AV1DecSbCursor *const cursor = &row_mt->parse_cursor;
+  AV1DecBlockInfo *const block = &sb->blocks[sb->num_blocks++];
+  MB_MODE_INFO *mbmi;
+
+#if CONFIG_PALETTE
+  set_color_index_maps(xd, cursor);
+#endif  // CONFIG_PALETTE
+  decode_mbmi_block(pbi, xd, mi_row, mi_col, r,
+#if CONFIG_EXT_PARTITION_TYPES
+                    partition,
+#endif
+                    bsize);
+  mbmi = &xd->mi[0]->mbmi;
+  block->mi_row = mi_row;
+  block->mi_col = mi_col;
+  block->bsize = bsize;
+
+  setup_block_tokens(cm, xd, mbmi, bsize);
+#if CONFIG_PALETTE
+  if (!is_inter_block(mbmi)) {
+    int plane;
+    for (plane = 0; plane <= 1; ++plane) {
+      if (mbmi->palette_mode_info.palette_size[plane])
+        av1_decode_palette_tokens(xd, plane, r);
+    }
+  }
+#endif  // CONFIG_PALETTE
+  visit_block_txbs(cm, xd, r, mbmi, bsize, cursor);
+#if CONFIG_PALETTE
+  advance_color_index_maps(mbmi, cursor);
+#endif  // CONFIG_PALETTE
+
+  xd->corrupted |= aom_reader_has_error(r);
+}
+
+static void recon_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
+                        const AV1DecBlockInfo *const block,
+                        AV1DecSbCursor *const cursor) {
+  AV1_COMMON *const cm = &pbi->common;
+  const int mi_row = block->mi_row;
+  const int mi_col = block->mi_col;
+  const BLOCK_SIZE bsize = block->bsize;
+  const int bw = mi_size_wide[bsize];
+  const int bh = mi_size_high[bsize];
+  MB_MODE_INFO *mbmi;
+
+  // The parser has already populated the mode info grid; only the block
+  // geometry needs to be set up here.
+  xd->mi = cm->mi_grid_visible + mi_row * cm->mi_stride + mi_col;
+  mbmi = &xd->mi[0]->mbmi;
+  set_plane_n4(xd, bw, bh);
+#if CONFIG_VAR_TX
+  xd->max_tx_size = max_txsize_lookup[bsize];
+#endif
+#if CONFIG_DEPENDENT_HORZTILES
+  set_mi_row_col(xd, &xd->tile, mi_row, bh, mi_col, bw, cm->mi_rows,
+                 cm->mi_cols, cm->dependent_horz_tiles);
+#else
+  set_mi_row_col(xd, &xd->tile, mi_row, bh, mi_col, bw, cm->mi_rows,
+                 cm->mi_cols);
+#endif
+  av1_setup_dst_planes(xd->plane, get_frame_new_buffer(cm), mi_row, mi_col);
+
+#if CONFIG_PALETTE
+  set_color_index_maps(xd, cursor);
+#endif  // CONFIG_PALETTE
+  if (is_inter_block(mbmi))
+    predict_inter_block(cm, xd, mbmi, mi_row, mi_col, bsize);
+  visit_block_txbs(cm, xd, NULL, mbmi, bsize, cursor);
+#if CONFIG_PALETTE
+  advance_color_index_maps(mbmi, cursor);
+#endif  // CONFIG_PALETTE
+}
+#endif  // AV1_DEC_ROW_MT
+
 #if CONFIG_NCOBMC && CONFIG_MOTION_VAR
 static void detoken_and_recon_sb(AV1Decoder *const pbi, MACROBLOCKD *const xd,
                                  int mi_row, int mi_col, aom_reader *r,
@@ -1862,6 +2151,16 @@ static void decode_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
                          PARTITION_TYPE partition,
 #endif  // CONFIG_EXT_PARTITION_TYPES
                          BLOCK_SIZE bsize) {
+#if AV1_DEC_ROW_MT
+  if (pbi->row_mt_data.parse_sb) {
+    parse_block(pbi, xd, mi_row, mi_col, r,
+#if CONFIG_EXT_PARTITION_TYPES
+                partition,
+#endif
+                bsize);
+    return;
+  }
+#endif  // AV1_DEC_ROW_MT
   decode_mbmi_block(pbi, xd,
 #if CONFIG_SUPERTX
                     supertx_enabled,
@@ -2705,15 +3004,6 @@ static void setup_clpf(AV1Decoder *pbi, struct aom_read_bit_buffer *rb) {
     }
   }
 }
-
-static int clpf_bit(UNUSED int k, UNUSED int l,
-                    UNUSED const YV12_BUFFER_CONFIG *rec,
-                    UNUSED const YV12_BUFFER_CONFIG *org,
-                    UNUSED const AV1_COMMON *cm, UNUSED int block_size,
-                    UNUSED int w, UNUSED int h, UNUSED unsigned int strength,
-                    UNUSED unsigned int fb_size_log2, int8_t *bit) {
-  return *bit;
-}
 #endif
 
 #if CONFIG_DERING
@@ -3435,24 +3725,20 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
   cm->do_subframe_update = n_tiles == 1;
 #endif  // CONFIG_ENTROPY
 
-  if (cm->lf.filter_level && !cm->skip_loop_filter &&
-      pbi->lf_worker.data1 == NULL) {
-    CHECK_MEM_ERROR(cm, pbi->lf_worker.data1,
-                    aom_memalign(32, sizeof(LFWorkerData)));
-    pbi->lf_worker.hook = (AVxWorkerHook)av1_loop_filter_worker;
+  if (pbi->lf_worker.data1 == NULL) {
+    pbi->lf_worker.data1 = &pbi->post_filter;
+    pbi->lf_worker.hook = (AVxWorkerHook)av1_post_filter_run;
     if (pbi->max_threads > 1 && !winterface->reset(&pbi->lf_worker)) {
       aom_internal_error(&cm->error, AOM_CODEC_ERROR,
                          "Loop filter thread creation failed");
     }
   }
 
-  if (cm->lf.filter_level && !cm->skip_loop_filter) {
-    LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
-    // Be sure to sync as we might be resuming after a failed frame decode.
-    winterface->sync(&pbi->lf_worker);
-    av1_loop_filter_data_reset(lf_data, get_frame_new_buffer(cm), cm,
-                               pbi->mb.plane);
-  }
+  // Be sure to sync as we might be resuming after a failed frame decode.
+  winterface->sync(&pbi->lf_worker);
+  av1_post_filter_init(&pbi->post_filter, get_frame_new_buffer(cm), cm,
+                       pbi->mb.plane, tile_cols_end - tile_cols_start,
+                       pbi->max_threads);
 
   assert(tile_rows <= MAX_TILE_ROWS);
   assert(tile_cols <= MAX_TILE_COLS);
@@ -3586,72 +3872,32 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
           }
         }
 #endif  // CONFIG_ENTROPY
+
+        // Post-filter the rows above once every tile column has
+        // reconstructed this superblock row.
+        if (av1_post_filter_sb_row_done(&pbi->post_filter,
+                                        mi_row >> cm->mib_size_log2)) {
+          winterface->sync(&pbi->lf_worker);
+          if (pbi->max_threads > 1) {
+            winterface->launch(&pbi->lf_worker);
+          } else {
+            winterface->execute(&pbi->lf_worker);
+          }
+        }
       }
     }
 
     assert(mi_row > 0);
 
-// when Parallel deblocking is enabled, deblocking should not
-// be interleaved with decoding. Instead, deblocking should be done
-// after the entire frame is decoded.
-#if !CONFIG_VAR_TX && !CONFIG_PARALLEL_DEBLOCKING
-    // Loopfilter one tile row.
-    if (cm->lf.filter_level && !cm->skip_loop_filter) {
-      LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
-      const int lf_start = AOMMAX(0, tile_info.mi_row_start - cm->mib_size);
-      const int lf_end = tile_info.mi_row_end - cm->mib_size;
-
-      // Delay the loopfilter if the first tile row is only
-      // a single superblock high.
-      if (lf_end <= 0) continue;
-
-      // Decoding has completed. Finish up the loop filter in this thread.
-      if (tile_info.mi_row_end >= cm->mi_rows) continue;
-
-      winterface->sync(&pbi->lf_worker);
-      lf_data->start = lf_start;
-      lf_data->stop = lf_end;
-      if (pbi->max_threads > 1) {
-        winterface->launch(&pbi->lf_worker);
-      } else {
-        winterface->execute(&pbi->lf_worker);
-      }
-    }
-#endif  // !CONFIG_VAR_TX && !CONFIG_PARALLEL_DEBLOCKING
-
-    // After loopfiltering, the last 7 row pixels in each superblock row may
-    // still be changed by the longest loopfilter of the next superblock row.
+    // Only the rows the post-filter pipeline has finished can be used as a
+    // reference; the filters of the rows below may still change the others.
     if (cm->frame_parallel_decode)
-      av1_frameworker_broadcast(pbi->cur_buf, mi_row << cm->mib_size_log2);
+      av1_frameworker_broadcast(pbi->cur_buf,
+                                av1_post_filter_rows_done(&pbi->post_filter));
   }
 
-#if CONFIG_VAR_TX
-  // Loopfilter the whole frame.
-  av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
-                        cm->lf.filter_level, 0, 0);
-#else
-#if CONFIG_PARALLEL_DEBLOCKING
-  // Loopfilter all rows in the frame in the frame.
-  if (cm->lf.filter_level && !cm->skip_loop_filter) {
-    LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
-    winterface->sync(&pbi->lf_worker);
-    lf_data->start = 0;
-    lf_data->stop = cm->mi_rows;
-    winterface->execute(&pbi->lf_worker);
-  }
-#else
-  // Loopfilter remaining rows in the frame.
-  if (cm->lf.filter_level && !cm->skip_loop_filter) {
-    LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
-    winterface->sync(&pbi->lf_worker);
-    lf_data->start = lf_data->stop;
-    lf_data->stop = cm->mi_rows;
-    winterface->execute(&pbi->lf_worker);
-  }
-#endif  // CONFIG_PARALLEL_DEBLOCKING
-#endif  // CONFIG_VAR_TX
-  if (cm->frame_parallel_decode)
-    av1_frameworker_broadcast(pbi->cur_buf, INT_MAX);
+  // The remaining rows are post-filtered by av1_post_filter_finish().
+  winterface->sync(&pbi->lf_worker);
 
 #if CONFIG_EXT_TILE
   if (n_tiles == 1) {
@@ -3706,6 +3952,7 @@ static int tile_worker_hook(TileWorkerData *const tile_data,
 
     for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
          mi_col += cm->mib_size) {
+      av1_update_boundary_info(cm, tile, mi_row, mi_col);
       decode_partition(pbi, &tile_data->xd,
 #if CONFIG_SUPERTX
                        0,
@@ -3717,6 +3964,9 @@ static int tile_worker_hook(TileWorkerData *const tile_data,
                            &tile_data->bit_reader, cm->sb_size);
 #endif
     }
+    if (av1_post_filter_sb_row_done(&pbi->post_filter,
+                                    mi_row >> cm->mib_size_log2))
+      av1_post_filter_run(&pbi->post_filter, NULL);
   }
   return !tile_data->xd.corrupted;
 }
@@ -3728,6 +3978,39 @@ static int compare_tile_buffers(const void *a, const void *b) {
   return (int)(buf2->size - buf1->size);
 }
 
+// Creates one worker per decoder thread. The last worker has no thread of its
+// own and is run on the calling thread.
+static void create_tile_workers(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  // TODO(jzern): See if we can remove the restriction of passing in max
+  // threads to the decoder.
+  const int num_threads = pbi->max_threads;
+  int i;
+
+  assert(pbi->num_tile_workers == 0);
+  CHECK_MEM_ERROR(cm, pbi->tile_workers,
+                  aom_malloc(num_threads * sizeof(*pbi->tile_workers)));
+  // Ensure tile data offsets will be properly aligned. This may fail on
+  // platforms without DECLARE_ALIGNED().
+  assert((sizeof(*pbi->tile_worker_data) % 16) == 0);
+  CHECK_MEM_ERROR(
+      cm, pbi->tile_worker_data,
+      aom_memalign(32, num_threads * sizeof(*pbi->tile_worker_data)));
+  CHECK_MEM_ERROR(cm, pbi->tile_worker_info,
+                  aom_malloc(num_threads * sizeof(*pbi->tile_worker_info)));
+  for (i = 0; i < num_threads; ++i) {
+    AVxWorker *const worker = &pbi->tile_workers[i];
+    ++pbi->num_tile_workers;
+
+    winterface->init(worker);
+    if (i < num_threads - 1 && !winterface->reset(worker)) {
+      aom_internal_error(&cm->error, AOM_CODEC_ERROR,
+                         "Tile decoder thread creation failed");
+    }
+  }
+}
+
 static const uint8_t *decode_tiles_mt(AV1Decoder *pbi, const uint8_t *data,
                                       const uint8_t *data_end) {
   AV1_COMMON *const cm = &pbi->common;
@@ -3763,31 +4046,7 @@ static const uint8_t *decode_tiles_mt(AV1Decoder *pbi, const uint8_t *data,
 
   assert(tile_cols * tile_rows > 1);
 
-  // TODO(jzern): See if we can remove the restriction of passing in max
-  // threads to the decoder.
-  if (pbi->num_tile_workers == 0) {
-    const int num_threads = pbi->max_threads & ~1;
-    CHECK_MEM_ERROR(cm, pbi->tile_workers,
-                    aom_malloc(num_threads * sizeof(*pbi->tile_workers)));
-    // Ensure tile data offsets will be properly aligned. This may fail on
-    // platforms without DECLARE_ALIGNED().
-    assert((sizeof(*pbi->tile_worker_data) % 16) == 0);
-    CHECK_MEM_ERROR(
-        cm, pbi->tile_worker_data,
-        aom_memalign(32, num_threads * sizeof(*pbi->tile_worker_data)));
-    CHECK_MEM_ERROR(cm, pbi->tile_worker_info,
-                    aom_malloc(num_threads * sizeof(*pbi->tile_worker_info)));
-    for (i = 0; i < num_threads; ++i) {
-      AVxWorker *const worker = &pbi->tile_workers[i];
-      ++pbi->num_tile_workers;
-
-      winterface->init(worker);
-      if (i < num_threads - 1 && !winterface->reset(worker)) {
-        aom_internal_error(&cm->error, AOM_CODEC_ERROR,
-                           "Tile decoder thread creation failed");
-      }
-    }
-  }
+  if (pbi->num_tile_workers == 0) create_tile_workers(pbi);
 
   // Reset tile decoding hook
   for (i = 0; i < num_workers; ++i) {
@@ -3809,6 +4068,11 @@ static const uint8_t *decode_tiles_mt(AV1Decoder *pbi, const uint8_t *data,
   // Load tile data into tile_buffers
   get_tile_buffers(pbi, data, data_end, tile_buffers);
 
+  // The tile workers post-filter the frame as its rows are reconstructed.
+  av1_post_filter_init(&pbi->post_filter, get_frame_new_buffer(cm), cm,
+                       pbi->mb.plane, tile_cols_end - tile_cols_start,
+                       pbi->max_threads);
+
   for (tile_row = tile_rows_start; tile_row < tile_rows_end; ++tile_row) {
     // Sort the buffers in this tile row based on size in descending order.
     qsort(&tile_buffers[tile_row][tile_cols_start],
@@ -3921,6 +4185,302 @@ static const uint8_t *decode_tiles_mt(AV1Decoder *pbi, const uint8_t *data,
 #endif  // CONFIG_EXT_TILE
 }
 
+#if AV1_DEC_ROW_MT
+static int get_next_sb_row(AV1DecRowMTData *const row_mt) {
+  int sb_row = -1;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(row_mt->job_mutex);
+#endif
+  if (row_mt->next_sb_row < row_mt->sb_rows) sb_row = row_mt->next_sb_row++;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(row_mt->job_mutex);
+#endif
+  return sb_row;
+}
+
+static void recon_sb_row(TileWorkerData *const tile_data, int sb_row) {
+  AV1Decoder *const pbi = tile_data->pbi;
+  AV1_COMMON *const cm = &pbi->common;
+  AV1DecRowMTData *const row_mt = &pbi->row_mt_data;
+  const int sb_cols = row_mt->sb_cols;
+  const int mi_row = sb_row << cm->mib_size_log2;
+  AV1DecSbData *const sb_data =
+      row_mt->sb_data + (sb_row % row_mt->ring_rows) * sb_cols;
+  int sb_col;
+
+  av1_tile_init(&tile_data->xd.tile, cm,
+                AOMMIN(mi_row / cm->tile_height, cm->tile_rows - 1), 0);
+
+  for (sb_col = 0; sb_col < sb_cols; ++sb_col) {
+    const AV1DecSbData *const sb = &sb_data[sb_col];
+
+    av1_row_mt_sync_wait(&row_mt->parse_sync, sb_row, sb_col);
+    av1_row_mt_sync_read(&row_mt->recon_sync, sb_row, sb_col);
+
+    if (!row_mt->corrupted) {
+      AV1DecSbCursor cursor = sb->start;
+      int i;
+      for (i = 0; i < sb->num_blocks; ++i)
+        recon_block(pbi, &tile_data->xd, &sb->blocks[i], &cursor);
+    }
+
+    av1_row_mt_sync_write(&row_mt->recon_sync, sb_row, sb_col, sb_cols);
+  }
+}
+
+static int row_mt_worker_hook(TileWorkerData *const tile_data, void *unused) {
+  AV1DecRowMTData *const row_mt = &tile_data->pbi->row_mt_data;
+  volatile int sb_row = -1;
+  (void)unused;
+
+  if (setjmp(tile_data->error_info.jmp)) {
+    tile_data->xd.corrupted = 1;
+    row_mt->corrupted = 1;
+    // Release everything waiting on the row that failed. The remaining rows
+    // are still drained so that the parser never blocks on them.
+    if (sb_row >= 0)
+      av1_row_mt_sync_write(&row_mt->recon_sync, sb_row, row_mt->sb_cols - 1,
+                            row_mt->sb_cols);
+  }
+
+  tile_data->error_info.setjmp = 1;
+  tile_data->xd.error_info = &tile_data->error_info;
+
+  while ((sb_row = get_next_sb_row(row_mt)) >= 0) {
+    recon_sb_row(tile_data, sb_row);
+    if (!row_mt->corrupted &&
+        av1_post_filter_sb_row_done(&tile_data->pbi->post_filter, sb_row))
+      av1_post_filter_run(&tile_data->pbi->post_filter, NULL);
+  }
+
+  tile_data->error_info.setjmp = 0;
+  return !tile_data->xd.corrupted;
+}
+
+// Decodes a frame with a single tile column. The main thread parses the tile
+// superblock by superblock while the tile workers reconstruct superblock rows
+// behind it in a wavefront, each row staying sync_range superblocks behind the
+// row above so that the above-right neighbours are available.
+static const uint8_t *decode_tiles_row_mt(AV1Decoder *pbi, const uint8_t *data,
+                                          const uint8_t *data_end) {
+  AV1_COMMON *const cm = &pbi->common;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  AV1DecRowMTData *const row_mt = &pbi->row_mt_data;
+  const int tile_rows = cm->tile_rows;
+  TileBufferDec(*const tile_buffers)[MAX_TILE_COLS] = pbi->tile_buffers;
+  int num_workers;
+  int ring_rows, sb_cols;
+  int tile_row;
+  int i;
+
+  assert(cm->tile_cols == 1);
+  assert(tile_rows <= MAX_TILE_ROWS);
+
+#if CONFIG_ENTROPY
+  cm->do_subframe_update = tile_rows == 1;
+#endif  // CONFIG_ENTROPY
+
+  if (pbi->num_tile_workers == 0) create_tile_workers(pbi);
+  num_workers = pbi->num_tile_workers;
+
+  // Rows in flight: one being parsed plus one per reconstruction worker.
+  av1_dec_row_mt_alloc(pbi, num_workers + 2);
+  ring_rows = row_mt->ring_rows;
+  sb_cols = row_mt->sb_cols;
+  if (row_mt->corrupted) {
+    // A failed frame may have left coefficients behind.
+    memset(row_mt->dqcoeff, 0, row_mt->dqcoeff_size);
+    row_mt->corrupted = 0;
+  }
+  row_mt->next_sb_row = 0;
+  av1_row_mt_sync_reset(&row_mt->parse_sync);
+  av1_row_mt_sync_reset(&row_mt->recon_sync);
+
+  get_tile_buffers(pbi, data, data_end, tile_buffers);
+
+  av1_post_filter_init(&pbi->post_filter, get_frame_new_buffer(cm), cm,
+                       pbi->mb.plane, 1, pbi->max_threads);
+
+  if (pbi->tile_data == NULL || tile_rows != pbi->allocated_tiles) {
+    aom_free(pbi->tile_data);
+    CHECK_MEM_ERROR(cm, pbi->tile_data,
+                    aom_memalign(32, tile_rows * (sizeof(*pbi->tile_data))));
+    pbi->allocated_tiles = tile_rows;
+  }
+#if CONFIG_ACCOUNTING
+  if (pbi->acct_enabled) {
+    aom_accounting_reset(&pbi->accounting);
+  }
+#endif
+  // Load all tile information into tile_data before any worker is running, as
+  // errors raised here do not release the workers.
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    const TileBufferDec *const buf = &tile_buffers[tile_row][0];
+    TileData *const td = pbi->tile_data + tile_row;
+
+    td->cm = cm;
+    td->xd = pbi->mb;
+    td->xd.corrupted = 0;
+    td->xd.counts = cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD
+                        ? &cm->counts
+                        : NULL;
+    td->xd.error_info = &row_mt->parse_error;
+    av1_zero(td->dqcoeff);
+    av1_tile_init(&td->xd.tile, td->cm, tile_row, 0);
+    setup_bool_decoder(buf->data, data_end, buf->size, &cm->error,
+                       &td->bit_reader,
+#if CONFIG_ANS && ANS_MAX_SYMBOLS
+                       1 << cm->ans_window_size_log2,
+#endif  // CONFIG_ANS && ANS_MAX_SYMBOLS
+                       pbi->decrypt_cb, pbi->decrypt_state);
+#if CONFIG_ACCOUNTING
+    if (pbi->acct_enabled) {
+      td->bit_reader.accounting = &pbi->accounting;
+    } else {
+      td->bit_reader.accounting = NULL;
+    }
+#endif
+    av1_init_macroblockd(cm, &td->xd, td->dqcoeff);
+#if CONFIG_EC_ADAPT
+    // Initialise the tile context from the frame context
+    td->tctx = *cm->fc;
+    td->xd.tile_ctx = &td->tctx;
+#endif
+  }
+
+  // Launch the reconstruction workers. The last one runs on this thread once
+  // parsing is done.
+  for (i = 0; i < num_workers; ++i) {
+    AVxWorker *const worker = &pbi->tile_workers[i];
+    TileWorkerData *const twd = &pbi->tile_worker_data[i];
+
+    winterface->sync(worker);
+    worker->hook = (AVxWorkerHook)row_mt_worker_hook;
+    worker->data1 = twd;
+    worker->data2 = NULL;
+
+    twd->pbi = pbi;
+    twd->xd = pbi->mb;
+    twd->xd.corrupted = 0;
+    twd->xd.counts = NULL;
+    av1_init_macroblockd(cm, &twd->xd, twd->dqcoeff);
+
+    worker->had_error = 0;
+    if (i < num_workers - 1) winterface->launch(worker);
+  }
+
+  if (setjmp(row_mt->parse_error.jmp)) {
+    pbi->mb.corrupted = 1;
+  } else {
+    row_mt->parse_error.setjmp = 1;
+
+    for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+      TileData *const td = pbi->tile_data + tile_row;
+      int mi_row;
+      TileInfo tile_info;
+
+      av1_tile_init(&tile_info, cm, tile_row, 0);
+#if CONFIG_ACCOUNTING
+      if (pbi->acct_enabled) {
+        td->bit_reader.accounting->last_tell_frac =
+            aom_reader_tell_frac(&td->bit_reader);
+      }
+#endif
+
+#if CONFIG_DEPENDENT_HORZTILES
+      if (!cm->dependent_horz_tiles || tile_row == 0) {
+        av1_zero_above_context(cm, tile_info.mi_col_start,
+                               tile_info.mi_col_end);
+      }
+#else
+      av1_zero_above_context(cm, tile_info.mi_col_start, tile_info.mi_col_end);
+#endif
+
+      for (mi_row = tile_info.mi_row_start; mi_row < tile_info.mi_row_end;
+           mi_row += cm->mib_size) {
+        const int sb_row = mi_row >> cm->mib_size_log2;
+        AV1DecSbData *const sb_data =
+            row_mt->sb_data + (sb_row % ring_rows) * sb_cols;
+        int mi_col;
+
+        // Wait for the side channel of this ring slot to be consumed.
+        if (sb_row >= ring_rows)
+          av1_row_mt_sync_wait(&row_mt->recon_sync, sb_row - ring_rows,
+                               sb_cols - 1);
+
+        av1_zero_left_context(&td->xd);
+
+        for (mi_col = tile_info.mi_col_start; mi_col < tile_info.mi_col_end;
+             mi_col += cm->mib_size) {
+          const int sb_col = mi_col >> cm->mib_size_log2;
+          AV1DecSbData *const sb = &sb_data[sb_col];
+
+          sb->num_blocks = 0;
+          row_mt->parse_sb = sb;
+          row_mt->parse_cursor = sb->start;
+          av1_update_boundary_info(cm, &tile_info, mi_row, mi_col);
+          decode_partition(pbi, &td->xd, mi_row, mi_col, &td->bit_reader,
+                           cm->sb_size, b_width_log2_lookup[cm->sb_size]);
+          row_mt->parse_sb = NULL;
+
+          av1_row_mt_sync_write(&row_mt->parse_sync, sb_row, sb_col, sb_cols);
+        }
+        if (td->xd.corrupted)
+          aom_internal_error(&row_mt->parse_error, AOM_CODEC_CORRUPT_FRAME,
+                             "Failed to decode tile data");
+#if CONFIG_ENTROPY
+        if (cm->do_subframe_update &&
+            cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD) {
+          const int mi_rows_per_update =
+              MI_SIZE * AOMMAX(cm->mi_rows / MI_SIZE / COEF_PROBS_BUFS, 1);
+          if ((mi_row + MI_SIZE) % mi_rows_per_update == 0 &&
+              mi_row + MI_SIZE < cm->mi_rows &&
+              cm->coef_probs_update_idx < COEF_PROBS_BUFS - 1) {
+            av1_partial_adapt_probs(cm, mi_row, mi_col);
+            ++cm->coef_probs_update_idx;
+          }
+        }
+#endif  // CONFIG_ENTROPY
+      }
+    }
+  }
+  row_mt->parse_error.setjmp = 0;
+  row_mt->parse_sb = NULL;
+
+  if (pbi->mb.corrupted) {
+    // Unblock the workers waiting on rows that will never be parsed.
+    const int sb_rows = row_mt->sb_rows;
+    row_mt->corrupted = 1;
+    for (i = 0; i < sb_rows; ++i)
+      av1_row_mt_sync_write(&row_mt->parse_sync, i, sb_cols - 1, sb_cols);
+  }
+
+  winterface->execute(&pbi->tile_workers[num_workers - 1]);
+  for (i = 0; i < num_workers; ++i)
+    pbi->mb.corrupted |= !winterface->sync(&pbi->tile_workers[i]);
+
+  if (pbi->mb.corrupted)
+    aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
+                       "Failed to decode tile data");
+
+#if CONFIG_EXT_TILE
+  if (tile_rows > 1) {
+    // Return the end of the last tile buffer
+    return tile_buffers[tile_rows - 1][0].raw_data_end;
+  }
+#endif  // CONFIG_EXT_TILE
+#if CONFIG_ANS
+  return data_end;
+#else
+  {
+    // Get last tile data.
+    TileData *const td = pbi->tile_data + tile_rows - 1;
+    return aom_reader_find_end(&td->bit_reader);
+  }
+#endif  // CONFIG_ANS
+}
+#endif  // AV1_DEC_ROW_MT
+
 static void error_handler(void *data) {
   AV1_COMMON *const cm = (AV1_COMMON *)data;
   aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME, "Truncated packet");
@@ -4910,54 +5470,32 @@ void av1_decode_frame(AV1Decoder *pbi, const uint8_t *data,
       && cm->tile_cols > 1) {
     // Multi-threaded tile decoder
     *p_data_end = decode_tiles_mt(pbi, data + first_partition_size, data_end);
-    if (!xd->corrupted) {
-      if (!cm->skip_loop_filter) {
-        // If multiple threads are used to decode tiles, then we use those
-        // threads to do parallel loopfiltering.
-        av1_loop_filter_frame_mt(new_fb, cm, pbi->mb.plane, cm->lf.filter_level,
-                                 0, 0, pbi->tile_workers, pbi->num_tile_workers,
-                                 &pbi->lf_row_sync);
-      }
-    } else {
+    if (xd->corrupted) {
       aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
                          "Decode failed. Frame data is corrupted.");
     }
+#if AV1_DEC_ROW_MT
+  } else if (pbi->row_mt && pbi->max_threads > 1
+#if CONFIG_EXT_TILE
+             && pbi->dec_tile_row < 0 && pbi->dec_tile_col < 0
+#endif  // CONFIG_EXT_TILE
+             && cm->tile_cols == 1) {
+    // Multi-threaded superblock row decoder
+    *p_data_end =
+        decode_tiles_row_mt(pbi, data + first_partition_size, data_end);
+#endif  // AV1_DEC_ROW_MT
   } else {
     *p_data_end = decode_tiles(pbi, data + first_partition_size, data_end);
   }
-#if CONFIG_LOOP_RESTORATION
-  if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-      cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-      cm->rst_info[2].frame_restoration_type != RESTORE_NONE) {
-    av1_loop_restoration_frame(new_fb, cm, cm->rst_info, 7, 0, NULL);
-  }
-#endif  // CONFIG_LOOP_RESTORATION
-
-#if CONFIG_DERING
-  if (cm->dering_level && !cm->skip_loop_filter) {
-    av1_dering_frame(&pbi->cur_buf->buf, cm, &pbi->mb, cm->dering_level);
-  }
-#endif  // CONFIG_DERING
+  // Loopfilter, loop restoration, deringing and CLPF have been running on the
+  // decoded rows; filter what remains at the bottom of the frame, with the
+  // help of the idle tile threads.
+  av1_post_filter_finish(&pbi->post_filter, pbi->tile_workers,
+                         AOMMAX(0, pbi->num_tile_workers - 1));
+  if (cm->frame_parallel_decode)
+    av1_frameworker_broadcast(pbi->cur_buf, INT_MAX);
 
 #if CONFIG_CLPF
-  if (!cm->skip_loop_filter) {
-    const YV12_BUFFER_CONFIG *const frame = &pbi->cur_buf->buf;
-    if (cm->clpf_strength_y) {
-      av1_clpf_frame(frame, NULL, cm, cm->clpf_size != CLPF_NOSIZE,
-                     cm->clpf_strength_y + (cm->clpf_strength_y == 3),
-                     4 + cm->clpf_size, AOM_PLANE_Y, clpf_bit);
-    }
-    if (cm->clpf_strength_u) {
-      av1_clpf_frame(frame, NULL, cm, 0,  // No block signals for chroma
-                     cm->clpf_strength_u + (cm->clpf_strength_u == 3), 4,
-                     AOM_PLANE_U, NULL);
-    }
-    if (cm->clpf_strength_v) {
-      av1_clpf_frame(frame, NULL, cm, 0,  // No block signals for chroma
-                     cm->clpf_strength_v + (cm->clpf_strength_v == 3), 4,
-                     AOM_PLANE_V, NULL);
-    }
-  }
   if (cm->clpf_blocks) aom_free(cm->clpf_blocks);
 #endif
 
@@ -156,7 +156,6 @@ void av1_decoder_remove(AV1Decoder *pbi) {
   if (!pbi) return;
 
   aom_get_worker_interface()->end(&pbi->lf_worker);
-  aom_free(pbi->lf_worker.data1);
   aom_free(pbi->tile_data);
   for (i = 0; i < pbi->num_tile_workers; ++i) {
     AVxWorker *const worker = &pbi->tile_workers[i];
@@ -166,9 +165,10 @@ void av1_decoder_remove(AV1Decoder *pbi) {
   aom_free(pbi->tile_worker_info);
   aom_free(pbi->tile_workers);
 
-  if (pbi->num_tile_workers > 0) {
-    av1_loop_filter_dealloc(&pbi->lf_row_sync);
-  }
+  av1_post_filter_dealloc(&pbi->post_filter);
+#if AV1_DEC_ROW_MT
+  av1_dec_row_mt_dealloc(pbi);
+#endif  // AV1_DEC_ROW_MT
 
 #if CONFIG_ACCOUNTING
   aom_accounting_clear(&pbi->accounting);
@@ -177,6 +177,107 @@ void av1_decoder_remove(AV1Decoder *pbi) {
   aom_free(pbi);
 }
 
+#if AV1_DEC_ROW_MT
+void av1_dec_row_mt_alloc(AV1Decoder *pbi, int ring_rows) {
+  AV1_COMMON *const cm = &pbi->common;
+  AV1DecRowMTData *const row_mt = &pbi->row_mt_data;
+  const int sb_rows = mi_rows_aligned_to_sb(cm) >> cm->mib_size_log2;
+  const int sb_cols = mi_cols_aligned_to_sb(cm) >> cm->mib_size_log2;
+  const int sb_px = cm->mib_size * MI_SIZE;
+  const int ss_x = cm->subsampling_x;
+  const int ss_y = cm->subsampling_y;
+  const int uv_px = (sb_px >> ss_x) * (sb_px >> ss_y);
+  // Upper bounds on what one superblock can carry.
+  const int max_blocks = (sb_px >> 2) * (sb_px >> 2);
+  const int max_txb = (sb_px * sb_px + 2 * uv_px) >> 4;
+  const int max_coeffs = sb_px * sb_px + 2 * uv_px;
+  int i;
+
+  ring_rows = AOMMIN(ring_rows, sb_rows);
+
+  if (row_mt->sb_rows != sb_rows || row_mt->alloc_ring_rows < ring_rows ||
+      row_mt->alloc_sb_cols != sb_cols || row_mt->alloc_sb_size != sb_px ||
+      row_mt->alloc_ss_x != ss_x || row_mt->alloc_ss_y != ss_y) {
+    const int num_sb = ring_rows * sb_cols;
+
+    av1_dec_row_mt_dealloc(pbi);
+
+    av1_row_mt_sync_mem_alloc(&row_mt->parse_sync, cm, sb_rows);
+    av1_row_mt_sync_mem_alloc(&row_mt->recon_sync, cm, sb_rows);
+#if CONFIG_MULTITHREAD
+    CHECK_MEM_ERROR(cm, row_mt->job_mutex,
+                    aom_malloc(sizeof(*row_mt->job_mutex)));
+    if (row_mt->job_mutex) pthread_mutex_init(row_mt->job_mutex, NULL);
+#endif
+
+    CHECK_MEM_ERROR(cm, row_mt->sb_data,
+                    aom_calloc(num_sb, sizeof(*row_mt->sb_data)));
+    CHECK_MEM_ERROR(
+        cm, row_mt->blocks,
+        aom_malloc(num_sb * max_blocks * sizeof(*row_mt->blocks)));
+    CHECK_MEM_ERROR(cm, row_mt->txb,
+                    aom_malloc(num_sb * max_txb * sizeof(*row_mt->txb)));
+    // Coefficients must start out zero; the inverse transform clears what it
+    // consumes, the same way it does for the single-threaded dqcoeff buffer.
+    row_mt->dqcoeff_size = num_sb * max_coeffs * sizeof(*row_mt->dqcoeff);
+    CHECK_MEM_ERROR(cm, row_mt->dqcoeff,
+                    aom_memalign(32, row_mt->dqcoeff_size));
+    memset(row_mt->dqcoeff, 0, row_mt->dqcoeff_size);
+#if CONFIG_PALETTE
+    for (i = 0; i < 2; ++i) {
+      CHECK_MEM_ERROR(cm, row_mt->color_index_map[i],
+                      aom_memalign(16, num_sb * sb_px * sb_px));
+    }
+#endif  // CONFIG_PALETTE
+
+    for (i = 0; i < num_sb; ++i) {
+      AV1DecSbData *const sb = &row_mt->sb_data[i];
+      sb->blocks = row_mt->blocks + i * max_blocks;
+      sb->start.txb = row_mt->txb + i * max_txb;
+      sb->start.dqcoeff = row_mt->dqcoeff + i * max_coeffs;
+#if CONFIG_PALETTE
+      sb->start.color_index_map[0] =
+          row_mt->color_index_map[0] + i * sb_px * sb_px;
+      sb->start.color_index_map[1] =
+          row_mt->color_index_map[1] + i * sb_px * sb_px;
+#endif  // CONFIG_PALETTE
+    }
+
+    row_mt->sb_rows = sb_rows;
+    row_mt->alloc_ring_rows = ring_rows;
+    row_mt->alloc_sb_cols = sb_cols;
+    row_mt->alloc_sb_size = sb_px;
+    row_mt->alloc_ss_x = ss_x;
+    row_mt->alloc_ss_y = ss_y;
+  }
+
+  row_mt->ring_rows = row_mt->alloc_ring_rows;
+  row_mt->sb_cols = sb_cols;
+}
+
+void av1_dec_row_mt_dealloc(AV1Decoder *pbi) {
+  AV1DecRowMTData *const row_mt = &pbi->row_mt_data;
+
+  av1_row_mt_sync_mem_dealloc(&row_mt->parse_sync);
+  av1_row_mt_sync_mem_dealloc(&row_mt->recon_sync);
+#if CONFIG_MULTITHREAD
+  if (row_mt->job_mutex != NULL) {
+    pthread_mutex_destroy(row_mt->job_mutex);
+    aom_free(row_mt->job_mutex);
+  }
+#endif
+  aom_free(row_mt->sb_data);
+  aom_free(row_mt->blocks);
+  aom_free(row_mt->txb);
+  aom_free(row_mt->dqcoeff);
+#if CONFIG_PALETTE
+  aom_free(row_mt->color_index_map[0]);
+  aom_free(row_mt->color_index_map[1]);
+#endif  // CONFIG_PALETTE
+  av1_zero(*row_mt);
+}
+#endif  // AV1_DEC_ROW_MT
+
 static int equal_dimensions(const YV12_BUFFER_CONFIG *a,
                             const YV12_BUFFER_CONFIG *b) {
   return a->y_height == b->y_height && a->y_width == b->y_width &&
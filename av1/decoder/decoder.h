@@ -75,6 +75,76 @@ typedef struct TileWorkerData {
   struct aom_internal_error_info error_info;
 } TileWorkerData;
 
+// Row-based multi-threaded decoding splits a tile into a serial parse pass
+// and superblock-row parallel reconstruction. Intra prediction, palette and
+// coefficient side channels do not fit through the mode info, so the parser
+// records them per superblock for the reconstruction workers to consume.
+#define AV1_DEC_ROW_MT                                      \
+  (CONFIG_MULTITHREAD && !CONFIG_PVQ && !CONFIG_SUPERTX &&  \
+   !CONFIG_COEF_INTERLEAVE && !(CONFIG_MOTION_VAR && CONFIG_NCOBMC))
+
+#if AV1_DEC_ROW_MT
+typedef struct AV1DecBlockInfo {
+  int mi_row;
+  int mi_col;
+  BLOCK_SIZE bsize;
+} AV1DecBlockInfo;
+
+typedef struct AV1DecTxbInfo {
+  int16_t eob;
+  int16_t max_scan_line;
+} AV1DecTxbInfo;
+
+// Position in the side channel of one superblock. The parser and the
+// reconstruction walk the transform blocks in the same order.
+typedef struct AV1DecSbCursor {
+  AV1DecTxbInfo *txb;
+  tran_low_t *dqcoeff;
+#if CONFIG_PALETTE
+  uint8_t *color_index_map[2];
+#endif  // CONFIG_PALETTE
+} AV1DecSbCursor;
+
+typedef struct AV1DecSbData {
+  AV1DecBlockInfo *blocks;
+  int num_blocks;
+  AV1DecSbCursor start;
+} AV1DecSbData;
+
+typedef struct AV1DecRowMTData {
+  // Published by the parser as superblocks are parsed.
+  AV1RowMTSync parse_sync;
+  // Published by the reconstruction workers as superblocks are written.
+  AV1RowMTSync recon_sync;
+  // Side channel storage for ring_rows superblock rows.
+  AV1DecSbData *sb_data;
+  AV1DecBlockInfo *blocks;
+  AV1DecTxbInfo *txb;
+  tran_low_t *dqcoeff;
+  size_t dqcoeff_size;
+#if CONFIG_PALETTE
+  uint8_t *color_index_map[2];
+#endif  // CONFIG_PALETTE
+  int ring_rows;
+  int sb_cols;
+  int alloc_ring_rows;
+  int alloc_sb_cols;
+  int alloc_sb_size;
+  int alloc_ss_x, alloc_ss_y;
+  // Superblock currently being parsed. NULL while reconstructing in place.
+  AV1DecSbData *parse_sb;
+  AV1DecSbCursor parse_cursor;
+  // Next superblock row to hand out to a reconstruction worker.
+  int next_sb_row;
+  int sb_rows;
+  int corrupted;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *job_mutex;
+#endif
+  struct aom_internal_error_info parse_error;
+} AV1DecRowMTData;
+#endif  // AV1_DEC_ROW_MT
+
 typedef struct TileBufferDec {
   const uint8_t *data;
   size_t size;
@@ -108,7 +178,14 @@ typedef struct AV1Decoder {
 
   TileBufferDec tile_buffers[MAX_TILE_ROWS][MAX_TILE_COLS];
 
-  AV1LfSync lf_row_sync;
+  // In-loop filters run behind the reconstruction of the frame.
+  AV1PostFilterSync post_filter;
+
+  // Decode superblock rows of a single tile column in parallel.
+  int row_mt;
+#if AV1_DEC_ROW_MT
+  AV1DecRowMTData row_mt_data;
+#endif  // AV1_DEC_ROW_MT
 
   aom_decrypt_cb decrypt_cb;
   void *decrypt_state;
@@ -175,6 +252,14 @@ struct AV1Decoder *av1_decoder_create(BufferPool *const pool);
 
 void av1_decoder_remove(struct AV1Decoder *pbi);
 
+#if AV1_DEC_ROW_MT
+// (Re)allocates the row-based multi-threading side channel for the current
+// frame size, keeping up to ring_rows superblock rows in flight.
+void av1_dec_row_mt_alloc(struct AV1Decoder *pbi, int ring_rows);
+
+void av1_dec_row_mt_dealloc(struct AV1Decoder *pbi);
+#endif  // AV1_DEC_ROW_MT
+
 static INLINE void decrease_ref_count(int idx, RefCntBuffer *const frame_bufs,
                                       BufferPool *const pool) {
   if (idx >= 0) {
@@ -20,6 +20,9 @@
 #if CONFIG_REF_MV
 #include "av1/common/mvref_common.h"
 #endif
+#if CONFIG_PALETTE
+#include "av1/encoder/palette.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -80,6 +83,11 @@ typedef struct {
 typedef struct {
   uint8_t best_palette_color_map[MAX_SB_SQUARE];
   float kmeans_data_buf[2 * MAX_SB_SQUARE];
+  // Color histograms of the block being searched, per plane, shared by the
+  // searches for every palette size. 'color_hist_src' is the source each one
+  // was computed from, or NULL if it needs to be computed.
+  PALETTE_COLOR_HIST color_hist[MAX_MB_PLANE];
+  const uint8_t *color_hist_src[MAX_MB_PLANE];
 } PALETTE_BUFFER;
 #endif  // CONFIG_PALETTE
 
@@ -106,6 +114,9 @@ struct macroblock {
   int mb_energy;
   int *m_search_count_ptr;
   int *ex_search_count_ptr;
+#if CONFIG_GLOBAL_MOTION
+  int *global_motion_used_ptr;
+#endif  // CONFIG_GLOBAL_MOTION
 
 #if CONFIG_VAR_TX
   unsigned int txb_split_count;
@@ -65,6 +65,156 @@ SIMD_INLINE void read_two_lines(const uint8_t *rec, const uint8_t *org,
   clip_sides(c, d, e, f, x0, right);
 }
 
+#ifdef CLPF_USE_V256
+SIMD_INLINE void clip_sides_v256(v256 *c, v256 *d, v256 *e, v256 *f, int left,
+                                 int right) {
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  c_shuff[]) = { 0x0504030201000000LL, 0x0d0c0b0a09080808LL,
+                                 0x0504030201000000LL, 0x0d0c0b0a09080808LL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  d_shuff[]) = { 0x0605040302010000LL, 0x0e0d0c0b0a090808LL,
+                                 0x0605040302010000LL, 0x0e0d0c0b0a090808LL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  e_shuff[]) = { 0x0707060504030201LL, 0x0f0f0e0d0c0b0a09LL,
+                                 0x0707060504030201LL, 0x0f0f0e0d0c0b0a09LL };
+  DECLARE_ALIGNED(32, static const uint64_t,
+                  f_shuff[]) = { 0x0707070605040302LL, 0x0f0f0f0e0d0c0b0aLL,
+                                 0x0707070605040302LL, 0x0f0f0f0e0d0c0b0aLL };
+
+  if (!left) {  // Left clipping
+    *c = v256_pshuffle_8(*c, v256_load_aligned(c_shuff));
+    *d = v256_pshuffle_8(*d, v256_load_aligned(d_shuff));
+  }
+  if (!right) {  // Right clipping
+    *e = v256_pshuffle_8(*e, v256_load_aligned(e_shuff));
+    *f = v256_pshuffle_8(*f, v256_load_aligned(f_shuff));
+  }
+}
+
+// Read four lines of 8 pixels.  The top and bottom lines of the frame are
+// repeated rather than read outside it.
+SIMD_INLINE void read_four_lines(const uint8_t *rec, const uint8_t *org,
+                                 int rstride, int ostride, int x0, int y0,
+                                 int height, int right, int y, v256 *o,
+                                 v256 *r, v256 *a, v256 *b, v256 *c, v256 *d,
+                                 v256 *e, v256 *f, v256 *g, v256 *h) {
+  const uint8_t *const p = rec + y * rstride;
+  const v64 l0 = v64_load_aligned(rec + AOMMAX(-y0, y - 2) * rstride);
+  const v64 l1 = v64_load_aligned(rec + AOMMAX(-y0, y - 1) * rstride);
+  const v64 l2 = v64_load_aligned(p);
+  const v64 l3 = v64_load_aligned(p + rstride);
+  const v64 l4 = v64_load_aligned(p + 2 * rstride);
+  const v64 l5 = v64_load_aligned(p + 3 * rstride);
+  const v64 l6 =
+      v64_load_aligned(rec + AOMMIN(height - 1 - y0, y + 4) * rstride);
+  const v64 l7 =
+      v64_load_aligned(rec + AOMMIN(height - 1 - y0, y + 5) * rstride);
+  const int cl = 2 * !!x0, dl = !!x0, el = !!right, fl = 2 * !!right;
+
+  org += y * ostride;
+  *o = v256_from_v64(v64_load_aligned(org), v64_load_aligned(org + ostride),
+                     v64_load_aligned(org + 2 * ostride),
+                     v64_load_aligned(org + 3 * ostride));
+  *r = v256_from_v64(l2, l3, l4, l5);
+  *a = v256_from_v64(l0, l1, l2, l3);
+  *b = v256_from_v64(l1, l2, l3, l4);
+  *g = v256_from_v64(l3, l4, l5, l6);
+  *h = v256_from_v64(l4, l5, l6, l7);
+  *c = v256_from_v64(v64_load_unaligned(p - cl),
+                     v64_load_unaligned(p - cl + rstride),
+                     v64_load_unaligned(p - cl + 2 * rstride),
+                     v64_load_unaligned(p - cl + 3 * rstride));
+  *d = v256_from_v64(v64_load_unaligned(p - dl),
+                     v64_load_unaligned(p - dl + rstride),
+                     v64_load_unaligned(p - dl + 2 * rstride),
+                     v64_load_unaligned(p - dl + 3 * rstride));
+  *e = v256_from_v64(v64_load_unaligned(p + el),
+                     v64_load_unaligned(p + el + rstride),
+                     v64_load_unaligned(p + el + 2 * rstride),
+                     v64_load_unaligned(p + el + 3 * rstride));
+  *f = v256_from_v64(v64_load_unaligned(p + fl),
+                     v64_load_unaligned(p + fl + rstride),
+                     v64_load_unaligned(p + fl + 2 * rstride),
+                     v64_load_unaligned(p + fl + 3 * rstride));
+  clip_sides_v256(c, d, e, f, x0, right);
+}
+
+SIMD_INLINE void calc_delta_multi_v256(v256 r, v256 o, v256 a, v256 b, v256 c,
+                                       v256 d, v256 e, v256 f, v256 g, v256 h,
+                                       ssd256_internal *ssd1,
+                                       ssd256_internal *ssd2,
+                                       ssd256_internal *ssd3) {
+  *ssd1 = v256_ssd_u8(*ssd1, o, calc_delta256(r, a, b, c, d, e, f, g, h, 1));
+  *ssd2 = v256_ssd_u8(*ssd2, o, calc_delta256(r, a, b, c, d, e, f, g, h, 2));
+  *ssd3 = v256_ssd_u8(*ssd3, o, calc_delta256(r, a, b, c, d, e, f, g, h, 4));
+}
+
+// Four lines at a time, so an 8x8 block takes two passes.
+void SIMD_FUNC(aom_clpf_detect)(const uint8_t *rec, const uint8_t *org,
+                                int rstride, int ostride, int x0, int y0,
+                                int width, int height, int *sum0, int *sum1,
+                                unsigned int strength, int size,
+                                unsigned int bd) {
+  const int right = width - 8 - x0;
+  ssd256_internal ssd0 = v256_ssd_u8_init();
+  ssd256_internal ssd1 = v256_ssd_u8_init();
+  int y;
+
+  if (size != 8) {  // Fallback to plain C
+    aom_clpf_detect_c(rec, org, rstride, ostride, x0, y0, width, height, sum0,
+                      sum1, strength, size, bd);
+    return;
+  }
+
+  rec += x0 + y0 * rstride;
+  org += x0 + y0 * ostride;
+
+  for (y = 0; y < 8; y += 4) {
+    v256 a, b, c, d, e, f, g, h, o, r;
+    read_four_lines(rec, org, rstride, ostride, x0, y0, height, right, y, &o,
+                    &r, &a, &b, &c, &d, &e, &f, &g, &h);
+    ssd0 = v256_ssd_u8(ssd0, o, r);
+    ssd1 = v256_ssd_u8(ssd1, o,
+                       calc_delta256(r, a, b, c, d, e, f, g, h, strength));
+  }
+  *sum0 += v256_ssd_u8_sum(ssd0);
+  *sum1 += v256_ssd_u8_sum(ssd1);
+}
+
+// Test multiple filter strengths at once.
+void SIMD_FUNC(aom_clpf_detect_multi)(const uint8_t *rec, const uint8_t *org,
+                                      int rstride, int ostride, int x0, int y0,
+                                      int width, int height, int *sum, int size,
+                                      unsigned int bd) {
+  const int right = width - 8 - x0;
+  ssd256_internal ssd0 = v256_ssd_u8_init();
+  ssd256_internal ssd1 = v256_ssd_u8_init();
+  ssd256_internal ssd2 = v256_ssd_u8_init();
+  ssd256_internal ssd3 = v256_ssd_u8_init();
+  int y;
+
+  if (size != 8) {  // Fallback to plain C
+    aom_clpf_detect_multi_c(rec, org, rstride, ostride, x0, y0, width, height,
+                            sum, size, bd);
+    return;
+  }
+
+  rec += x0 + y0 * rstride;
+  org += x0 + y0 * ostride;
+
+  for (y = 0; y < 8; y += 4) {
+    v256 a, b, c, d, e, f, g, h, o, r;
+    read_four_lines(rec, org, rstride, ostride, x0, y0, height, right, y, &o,
+                    &r, &a, &b, &c, &d, &e, &f, &g, &h);
+    ssd0 = v256_ssd_u8(ssd0, o, r);
+    calc_delta_multi_v256(r, o, a, b, c, d, e, f, g, h, &ssd1, &ssd2, &ssd3);
+  }
+  sum[0] += v256_ssd_u8_sum(ssd0);
+  sum[1] += v256_ssd_u8_sum(ssd1);
+  sum[2] += v256_ssd_u8_sum(ssd2);
+  sum[3] += v256_ssd_u8_sum(ssd3);
+}
+#else
 void SIMD_FUNC(aom_clpf_detect)(const uint8_t *rec, const uint8_t *org,
                                 int rstride, int ostride, int x0, int y0,
                                 int width, int height, int *sum0, int *sum1,
@@ -144,6 +294,7 @@ void SIMD_FUNC(aom_clpf_detect_multi)(const uint8_t *rec, const uint8_t *org,
   sum[2] += v128_ssd_u8_sum(ssd2);
   sum[3] += v128_ssd_u8_sum(ssd3);
 }
+#endif  // CLPF_USE_V256
 
 #if CONFIG_AOM_HIGHBITDEPTH
 SIMD_INLINE void read_two_lines_hbd(const uint16_t *rec, const uint16_t *org,
@@ -186,6 +337,120 @@ SIMD_INLINE void read_two_lines_hbd(const uint16_t *rec, const uint16_t *org,
   clip_sides(c, d, e, f, x0, right);
 }
 
+#ifdef CLPF_USE_V256
+// Two lines of 8 pixels shifted down to 8 bit, still in 16 bit lanes.
+SIMD_INLINE v256 load_two_lines_hbd(const uint16_t *p0, const uint16_t *p1,
+                                    int shift) {
+  return v256_shr_u16(
+      v256_from_v128(v128_load_unaligned(p0), v128_load_unaligned(p1)), shift);
+}
+
+SIMD_INLINE v256 load_four_lines_hbd(const uint16_t *p, int stride,
+                                     int shift) {
+  return v256_unziplo_8(load_two_lines_hbd(p, p + stride, shift),
+                        load_two_lines_hbd(p + 2 * stride, p + 3 * stride,
+                                           shift));
+}
+
+SIMD_INLINE void read_four_lines_hbd(const uint16_t *rec, const uint16_t *org,
+                                     int rstride, int ostride, int x0, int y0,
+                                     int height, int right, int y, v256 *o,
+                                     v256 *r, v256 *a, v256 *b, v256 *c,
+                                     v256 *d, v256 *e, v256 *f, v256 *g,
+                                     v256 *h, int shift) {
+  const uint16_t *const p = rec + y * rstride;
+  const uint16_t *const l0 = rec + AOMMAX(-y0, y - 2) * rstride;
+  const uint16_t *const l1 = rec + AOMMAX(-y0, y - 1) * rstride;
+  const uint16_t *const l6 = rec + AOMMIN(height - 1 - y0, y + 4) * rstride;
+  const uint16_t *const l7 = rec + AOMMIN(height - 1 - y0, y + 5) * rstride;
+  // Line pairs starting at even (p*) and odd (q*) offsets from y - 2
+  const v256 p0 = load_two_lines_hbd(l0, l1, shift);
+  const v256 p1 = load_two_lines_hbd(p, p + rstride, shift);
+  const v256 p2 = load_two_lines_hbd(p + 2 * rstride, p + 3 * rstride, shift);
+  const v256 p3 = load_two_lines_hbd(l6, l7, shift);
+  const v256 q0 = load_two_lines_hbd(l1, p, shift);
+  const v256 q1 = load_two_lines_hbd(p + rstride, p + 2 * rstride, shift);
+  const v256 q2 = load_two_lines_hbd(p + 3 * rstride, l6, shift);
+
+  *o = load_four_lines_hbd(org + y * ostride, ostride, shift);
+  *r = v256_unziplo_8(p1, p2);
+  *a = v256_unziplo_8(p0, p1);
+  *b = v256_unziplo_8(q0, q1);
+  *g = v256_unziplo_8(q1, q2);
+  *h = v256_unziplo_8(p2, p3);
+  *c = load_four_lines_hbd(p - 2 * !!x0, rstride, shift);
+  *d = load_four_lines_hbd(p - !!x0, rstride, shift);
+  *e = load_four_lines_hbd(p + !!right, rstride, shift);
+  *f = load_four_lines_hbd(p + 2 * !!right, rstride, shift);
+  clip_sides_v256(c, d, e, f, x0, right);
+}
+
+void SIMD_FUNC(aom_clpf_detect_hbd)(const uint16_t *rec, const uint16_t *org,
+                                    int rstride, int ostride, int x0, int y0,
+                                    int width, int height, int *sum0, int *sum1,
+                                    unsigned int strength, int size,
+                                    unsigned int bitdepth) {
+  const int shift = bitdepth - 8;
+  const int right = width - 8 - x0;
+  ssd256_internal ssd0 = v256_ssd_u8_init();
+  ssd256_internal ssd1 = v256_ssd_u8_init();
+  int y;
+
+  if (size != 8) {  // Fallback to plain C
+    aom_clpf_detect_hbd_c(rec, org, rstride, ostride, x0, y0, width, height,
+                          sum0, sum1, strength, size, bitdepth);
+    return;
+  }
+
+  rec += x0 + y0 * rstride;
+  org += x0 + y0 * ostride;
+
+  for (y = 0; y < 8; y += 4) {
+    v256 a, b, c, d, e, f, g, h, o, r;
+    read_four_lines_hbd(rec, org, rstride, ostride, x0, y0, height, right, y,
+                        &o, &r, &a, &b, &c, &d, &e, &f, &g, &h, shift);
+    ssd0 = v256_ssd_u8(ssd0, o, r);
+    ssd1 = v256_ssd_u8(
+        ssd1, o, calc_delta256(r, a, b, c, d, e, f, g, h, strength >> shift));
+  }
+  *sum0 += v256_ssd_u8_sum(ssd0);
+  *sum1 += v256_ssd_u8_sum(ssd1);
+}
+
+void SIMD_FUNC(aom_clpf_detect_multi_hbd)(const uint16_t *rec,
+                                          const uint16_t *org, int rstride,
+                                          int ostride, int x0, int y0,
+                                          int width, int height, int *sum,
+                                          int size, unsigned int bitdepth) {
+  const int right = width - 8 - x0;
+  ssd256_internal ssd0 = v256_ssd_u8_init();
+  ssd256_internal ssd1 = v256_ssd_u8_init();
+  ssd256_internal ssd2 = v256_ssd_u8_init();
+  ssd256_internal ssd3 = v256_ssd_u8_init();
+  int y;
+
+  if (size != 8) {  // Fallback to plain C
+    aom_clpf_detect_multi_hbd_c(rec, org, rstride, ostride, x0, y0, width,
+                                height, sum, size, bitdepth);
+    return;
+  }
+
+  rec += x0 + y0 * rstride;
+  org += x0 + y0 * ostride;
+
+  for (y = 0; y < 8; y += 4) {
+    v256 a, b, c, d, e, f, g, h, o, r;
+    read_four_lines_hbd(rec, org, rstride, ostride, x0, y0, height, right, y,
+                        &o, &r, &a, &b, &c, &d, &e, &f, &g, &h, bitdepth - 8);
+    ssd0 = v256_ssd_u8(ssd0, o, r);
+    calc_delta_multi_v256(r, o, a, b, c, d, e, f, g, h, &ssd1, &ssd2, &ssd3);
+  }
+  sum[0] += v256_ssd_u8_sum(ssd0);
+  sum[1] += v256_ssd_u8_sum(ssd1);
+  sum[2] += v256_ssd_u8_sum(ssd2);
+  sum[3] += v256_ssd_u8_sum(ssd3);
+}
+#else
 void SIMD_FUNC(aom_clpf_detect_hbd)(const uint16_t *rec, const uint16_t *org,
                                     int rstride, int ostride, int x0, int y0,
                                     int width, int height, int *sum0, int *sum1,
@@ -257,4 +522,5 @@ void SIMD_FUNC(aom_clpf_detect_multi_hbd)(const uint16_t *rec,
   sum[2] += v128_ssd_u8_sum(ssd2);
   sum[3] += v128_ssd_u8_sum(ssd3);
 }
+#endif  // CLPF_USE_V256
 #endif
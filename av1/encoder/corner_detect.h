@@ -16,7 +16,15 @@
 #include <stdlib.h>
 #include <memory.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 int fast_corner_detect(unsigned char *buf, int width, int height, int stride,
                        int *points, int max_points);
 
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
 #endif  // AV1_ENCODER_CORNER_DETECT_H_
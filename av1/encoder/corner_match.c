@@ -14,11 +14,9 @@
 #include <memory.h>
 #include <math.h>
 
+#include "./av1_rtcd.h"
 #include "av1/encoder/corner_match.h"
 
-#define MATCH_SZ 13
-#define MATCH_SZ_BY2 ((MATCH_SZ - 1) / 2)
-#define MATCH_SZ_SQ (MATCH_SZ * MATCH_SZ)
 #define SEARCH_SZ 9
 #define SEARCH_SZ_BY2 ((SEARCH_SZ - 1) / 2)
 
@@ -41,9 +39,11 @@ static double compute_variance(unsigned char *im, int stride, int x, int y,
   return var;
 }
 
-static double compute_cross_correlation(unsigned char *im1, int stride1, int x1,
-                                        int y1, unsigned char *im2, int stride2,
-                                        int x2, int y2) {
+// The sums are of integers, so they are exact and the SIMD versions, which
+// accumulate them in integers, return the same value.
+double av1_compute_cross_correlation_c(unsigned char *im1, int stride1, int x1,
+                                       int y1, unsigned char *im2, int stride2,
+                                       int x2, int y2) {
   double sum1 = 0;
   double sum2 = 0;
   double cross = 0;
@@ -101,7 +101,7 @@ static void improve_correspondence(unsigned char *frm, unsigned char *ref,
         subimage_norm =
             compute_variance(ref, ref_stride, (int)correspondences[i].rx + x,
                              (int)correspondences[i].ry + y, NULL);
-        match_ncc = compute_cross_correlation(
+        match_ncc = av1_compute_cross_correlation(
                         frm, frm_stride, (int)correspondences[i].x,
                         (int)correspondences[i].y, ref, ref_stride,
                         (int)correspondences[i].rx + x,
@@ -139,7 +139,7 @@ static void improve_correspondence(unsigned char *frm, unsigned char *ref,
             compute_variance(frm, frm_stride, (int)correspondences[i].x + x,
                              (int)correspondences[i].y + y, NULL);
         match_ncc =
-            compute_cross_correlation(
+            av1_compute_cross_correlation(
                 frm, frm_stride, (int)correspondences[i].x + x,
                 (int)correspondences[i].y + y, ref, ref_stride,
                 (int)correspondences[i].rx, (int)correspondences[i].ry) /
@@ -164,6 +164,18 @@ int determine_correspondence(unsigned char *frm, int *frm_corners,
   int i, j;
   Correspondence *correspondences = (Correspondence *)correspondence_pts;
   int num_correspondences = 0;
+  // The variance of the patch around each eligible reference corner, which
+  // is compared to every frame corner.
+  double *const ref_corner_norms =
+      (double *)malloc(num_ref_corners * sizeof(*ref_corner_norms));
+  if (num_ref_corners > 0 && !ref_corner_norms) return 0;
+  for (j = 0; j < num_ref_corners; ++j) {
+    if (is_eligible_point(ref_corners[2 * j], ref_corners[2 * j + 1], width,
+                          height))
+      ref_corner_norms[j] =
+          compute_variance(ref, ref_stride, ref_corners[2 * j],
+                           ref_corners[2 * j + 1], NULL);
+  }
   for (i = 0; i < num_frm_corners; ++i) {
     double best_match_ncc = 0.0;
     double template_norm;
@@ -175,7 +187,6 @@ int determine_correspondence(unsigned char *frm, int *frm_corners,
                                      frm_corners[2 * i + 1], NULL);
     for (j = 0; j < num_ref_corners; ++j) {
       double match_ncc;
-      double subimage_norm;
       if (!is_eligible_point(ref_corners[2 * j], ref_corners[2 * j + 1], width,
                              height))
         continue;
@@ -183,13 +194,11 @@ int determine_correspondence(unsigned char *frm, int *frm_corners,
                                 ref_corners[2 * j], ref_corners[2 * j + 1],
                                 width, height))
         continue;
-      subimage_norm = compute_variance(ref, ref_stride, ref_corners[2 * j],
-                                       ref_corners[2 * j + 1], NULL);
-      match_ncc = compute_cross_correlation(frm, frm_stride, frm_corners[2 * i],
-                                            frm_corners[2 * i + 1], ref,
-                                            ref_stride, ref_corners[2 * j],
-                                            ref_corners[2 * j + 1]) /
-                  sqrt(template_norm * subimage_norm);
+      match_ncc = av1_compute_cross_correlation(
+                      frm, frm_stride, frm_corners[2 * i],
+                      frm_corners[2 * i + 1], ref, ref_stride,
+                      ref_corners[2 * j], ref_corners[2 * j + 1]) /
+                  sqrt(template_norm * ref_corner_norms[j]);
       if (match_ncc > best_match_ncc) {
         best_match_ncc = match_ncc;
         best_match_j = j;
@@ -205,6 +214,7 @@ int determine_correspondence(unsigned char *frm, int *frm_corners,
       num_correspondences++;
     }
   }
+  free(ref_corner_norms);
   improve_correspondence(frm, ref, width, height, frm_stride, ref_stride,
                          correspondences, num_correspondences);
   return num_correspondences;
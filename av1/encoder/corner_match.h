@@ -15,6 +15,14 @@
 #include <stdlib.h>
 #include <memory.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MATCH_SZ 13
+#define MATCH_SZ_BY2 ((MATCH_SZ - 1) / 2)
+#define MATCH_SZ_SQ (MATCH_SZ * MATCH_SZ)
+
 typedef struct {
   double x, y;
   double rx, ry;
@@ -26,4 +34,8 @@ int determine_correspondence(unsigned char *frm, int *frm_corners,
                              int height, int frm_stride, int ref_stride,
                              double *correspondence_pts);
 
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
 #endif  // AV1_ENCODER_CORNER_MATCH_H_
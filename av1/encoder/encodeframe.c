@@ -1019,7 +1019,8 @@ static void update_filter_type_count(FRAME_COUNTS *counts,
 #endif
 #if CONFIG_GLOBAL_MOTION
 static void update_global_motion_used(PREDICTION_MODE mode, BLOCK_SIZE bsize,
-                                      const MB_MODE_INFO *mbmi, AV1_COMP *cpi) {
+                                      const MB_MODE_INFO *mbmi,
+                                      ThreadData *td) {
   if (mode == ZEROMV
 #if CONFIG_EXT_INTER
       || mode == ZERO_ZEROMV
@@ -1031,8 +1032,9 @@ static void update_global_motion_used(PREDICTION_MODE mode, BLOCK_SIZE bsize,
                              : 1;
     int ref;
     for (ref = 0; ref < 1 + has_second_ref(mbmi); ++ref) {
-      ++cpi->global_motion_used[mbmi->ref_frame[ref]][0];
-      cpi->global_motion_used[mbmi->ref_frame[ref]][1] += num_4x4s;
+      ++td->rd_counts.global_motion_used[mbmi->ref_frame[ref]][0];
+      td->rd_counts.global_motion_used[mbmi->ref_frame[ref]][1] += num_4x4s;
+      ++td->row_data->global_motion_used[mbmi->ref_frame[ref]];
     }
   }
 }
@@ -1190,9 +1192,7 @@ static void update_state(const AV1_COMP *const cpi, ThreadData *td,
       av1_update_mv_count(td);
 #if CONFIG_GLOBAL_MOTION
       if (bsize >= BLOCK_8X8) {
-        // TODO(sarahparker): global motion stats need to be handled per-tile
-        // to be compatible with tile-based threading.
-        update_global_motion_used(mbmi->mode, bsize, mbmi, (AV1_COMP *)cpi);
+        update_global_motion_used(mbmi->mode, bsize, mbmi, td);
       } else {
         const int num_4x4_w = num_4x4_blocks_wide_lookup[bsize];
         const int num_4x4_h = num_4x4_blocks_high_lookup[bsize];
@@ -1200,8 +1200,7 @@ static void update_state(const AV1_COMP *const cpi, ThreadData *td,
         for (idy = 0; idy < 2; idy += num_4x4_h) {
           for (idx = 0; idx < 2; idx += num_4x4_w) {
             const int j = idy * 2 + idx;
-            update_global_motion_used(mi->bmi[j].as_mode, bsize, mbmi,
-                                      (AV1_COMP *)cpi);
+            update_global_motion_used(mi->bmi[j].as_mode, bsize, mbmi, td);
           }
         }
       }
@@ -1371,9 +1370,7 @@ static void update_state_supertx(const AV1_COMP *const cpi, ThreadData *td,
 #if CONFIG_GLOBAL_MOTION
     if (is_inter_block(mbmi)) {
       if (bsize >= BLOCK_8X8) {
-        // TODO(sarahparker): global motion stats need to be handled per-tile
-        // to be compatible with tile-based threading.
-        update_global_motion_used(mbmi->mode, bsize, mbmi, (AV1_COMP *)cpi);
+        update_global_motion_used(mbmi->mode, bsize, mbmi, td);
       } else {
         const int num_4x4_w = num_4x4_blocks_wide_lookup[bsize];
         const int num_4x4_h = num_4x4_blocks_high_lookup[bsize];
@@ -1381,8 +1378,7 @@ static void update_state_supertx(const AV1_COMP *const cpi, ThreadData *td,
         for (idy = 0; idy < 2; idy += num_4x4_h) {
           for (idx = 0; idx < 2; idx += num_4x4_w) {
             const int j = idy * 2 + idx;
-            update_global_motion_used(mi->bmi[j].as_mode, bsize, mbmi,
-                                      (AV1_COMP *)cpi);
+            update_global_motion_used(mi->bmi[j].as_mode, bsize, mbmi, td);
           }
         }
       }
@@ -1850,10 +1846,26 @@ static void rd_pick_sb_modes(const AV1_COMP *const cpi, TileDataEnc *tile_data,
 
 #if CONFIG_PALETTE
   for (i = 0; i < 2; ++i) pd[i].color_index_map = ctx->color_index_map[i];
+  // The source may have changed since the color histograms were computed.
+  if (cm->allow_screen_content_tools) {
+    for (i = 0; i < MAX_MB_PLANE; ++i)
+      x->palette_buffer->color_hist_src[i] = NULL;
+  }
 #endif  // CONFIG_PALETTE
 
   ctx->skippable = 0;
   ctx->pred_pixel_ready = 0;
+  // The context keeps the mode of the last search that found one. With
+  // row-based multi-threading, clear the filter the partition search passes
+  // on to the sub-blocks, so that it never comes from a superblock the thread
+  // encoded in another row.
+  if (tile_data->row_mt_sync) {
+#if CONFIG_DUAL_FILTER
+    for (i = 0; i < 4; ++i) ctx->mic.mbmi.interp_filter[i] = SWITCHABLE;
+#else
+    ctx->mic.mbmi.interp_filter = SWITCHABLE;
+#endif
+  }
 
   // Set to zero to make sure we do not use the previous encoded frame stats
   mbmi->skip = 0;
@@ -4529,6 +4541,12 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
   MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   SPEED_FEATURES *const sf = &cpi->sf;
+  AV1RowMTSync *const row_mt_sync = tile_data->row_mt_sync;
+  const int tile_sb_row =
+      (mi_row - tile_info->mi_row_start) >> cm->mib_size_log2;
+  const int sb_cols_in_tile =
+      (tile_info->mi_col_end - tile_info->mi_col_start + cm->mib_size - 1) >>
+      cm->mib_size_log2;
   int mi_col;
 #if CONFIG_EXT_PARTITION
   const int leaf_nodes = 256;
@@ -4549,6 +4567,8 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
   for (mi_col = tile_info->mi_col_start; mi_col < tile_info->mi_col_end;
        mi_col += cm->mib_size) {
     const struct segmentation *const seg = &cm->seg;
+    const int tile_sb_col =
+        (mi_col - tile_info->mi_col_start) >> cm->mib_size_log2;
     int dummy_rate;
     int64_t dummy_dist;
     RD_COST dummy_rdc;
@@ -4562,6 +4582,11 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
     MODE_INFO **mi = cm->mi_grid_visible + idx_str;
     PC_TREE *const pc_root = td->pc_root[cm->mib_size_log2 - MIN_MIB_SIZE_LOG2];
 
+    // Wait for the above and above-right superblocks when the rows of the tile
+    // are encoded in parallel.
+    if (row_mt_sync)
+      av1_row_mt_sync_read(row_mt_sync, tile_sb_row, tile_sb_col);
+
     av1_update_boundary_info(cm, tile_info, mi_row, mi_col);
 
     if (sf->adaptive_pred_interp_filter) {
@@ -4656,6 +4681,10 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
 #endif  // CONFIG_SUPERTX
                         INT64_MAX, pc_root);
     }
+
+    if (row_mt_sync)
+      av1_row_mt_sync_write(row_mt_sync, tile_sb_row, tile_sb_col,
+                            sb_cols_in_tile);
   }
 #if CONFIG_ENTROPY
   if (cm->do_subframe_update &&
@@ -4810,6 +4839,7 @@ void av1_init_tile_data(AV1_COMP *cpi) {
       TileInfo *const tile_info =
           &cpi->tile_data[tile_row * tile_cols + tile_col].tile_info;
       av1_tile_init(tile_info, cm, tile_row, tile_col);
+      cpi->tile_data[tile_row * tile_cols + tile_col].row_mt_sync = NULL;
 
       cpi->tile_tok[tile_row][tile_col] = pre_tok + tile_tok;
       pre_tok = cpi->tile_tok[tile_row][tile_col];
@@ -4821,6 +4851,16 @@ void av1_init_tile_data(AV1_COMP *cpi) {
   }
 }
 
+void av1_alloc_row_data(AV1_COMP *cpi, ThreadData *td) {
+  AV1_COMMON *const cm = &cpi->common;
+  if (td->row_data == NULL)
+    CHECK_MEM_ERROR(cm, td->row_data, aom_memalign(32, sizeof(*td->row_data)));
+#if CONFIG_GLOBAL_MOTION
+  // Outside of row-based multi-threading, the count is kept over the frame.
+  av1_zero(td->row_data->global_motion_used);
+#endif  // CONFIG_GLOBAL_MOTION
+}
+
 void av1_encode_tile(AV1_COMP *cpi, ThreadData *td, int tile_row,
                      int tile_col) {
   AV1_COMMON *const cm = &cpi->common;
@@ -4845,6 +4885,9 @@ void av1_encode_tile(AV1_COMP *cpi, ThreadData *td, int tile_row,
   this_tile->ex_search_count = 0;  // Exhaustive mesh search hits.
   td->mb.m_search_count_ptr = &this_tile->m_search_count;
   td->mb.ex_search_count_ptr = &this_tile->ex_search_count;
+#if CONFIG_GLOBAL_MOTION
+  td->mb.global_motion_used_ptr = td->row_data->global_motion_used;
+#endif  // CONFIG_GLOBAL_MOTION
 
 #if CONFIG_PVQ
   td->mb.pvq_q = &this_tile->pvq_q;
@@ -4945,17 +4988,90 @@ void av1_encode_tile(AV1_COMP *cpi, ThreadData *td, int tile_row,
 #endif
 }
 
+void av1_encode_sb_row(AV1_COMP *cpi, ThreadData *td, int tile_row,
+                       int tile_col, int mi_row) {
+  AV1_COMMON *const cm = &cpi->common;
+  TileDataEnc *const this_tile =
+      &cpi->tile_data[tile_row * cm->tile_cols + tile_col];
+  const TileInfo *const tile_info = &this_tile->tile_info;
+  AV1EncRowMTData *const row_mt_data = &cpi->row_mt_data;
+  const int sb_row = (mi_row - tile_info->mi_row_start) >> cm->mib_size_log2;
+  const int tile_mb_cols =
+      (tile_info->mi_col_end - tile_info->mi_col_start + 1) >> 1;
+  TOKENEXTRA *const tok_start =
+      cpi->tile_tok[tile_row][tile_col] +
+      get_token_alloc((mi_row - tile_info->mi_row_start) >> 1, tile_mb_cols);
+  TOKENEXTRA *tok = tok_start;
+  TileDataEnc *const row_data = td->row_data;
+
+  // Every superblock row starts from the mode search state the tile had at
+  // the start of the frame, so the result does not depend on which thread
+  // encodes the row or on what that thread encoded before.
+  row_data->tile_info = *tile_info;
+  memcpy(row_data->thresh_freq_fact, this_tile->thresh_freq_fact,
+         sizeof(this_tile->thresh_freq_fact));
+  memcpy(row_data->mode_map, this_tile->mode_map, sizeof(this_tile->mode_map));
+  row_data->m_search_count = 0;   // Count of motion search hits.
+  row_data->ex_search_count = 0;  // Exhaustive mesh search hits.
+  row_data->row_mt_sync = this_tile->row_mt_sync;
+  td->mb.m_search_count_ptr = &row_data->m_search_count;
+  td->mb.ex_search_count_ptr = &row_data->ex_search_count;
+#if CONFIG_GLOBAL_MOTION
+  // The rate of the global motion parameters is spread over the blocks of the
+  // row, rather than over those other threads have finished.
+  av1_zero(row_data->global_motion_used);
+  td->mb.global_motion_used_ptr = row_data->global_motion_used;
+#endif  // CONFIG_GLOBAL_MOTION
+#if CONFIG_EC_ADAPT
+  td->mb.e_mbd.tile_ctx = &this_tile->tctx;
+#endif  // CONFIG_EC_ADAPT
+
+  encode_rd_sb_row(cpi, td, row_data, mi_row, &tok);
+
+  row_mt_data->tok_count[tile_col * row_mt_data->alloc_sb_rows + sb_row] =
+      (unsigned int)(tok - tok_start);
+
+  // The last row can only finish after every row above it has, so no other
+  // row still reads the starting state of the tile.
+  if (mi_row + cm->mib_size >= tile_info->mi_row_end) {
+    memcpy(this_tile->thresh_freq_fact, row_data->thresh_freq_fact,
+           sizeof(this_tile->thresh_freq_fact));
+    memcpy(this_tile->mode_map, row_data->mode_map,
+           sizeof(this_tile->mode_map));
+  }
+}
+
 static void encode_tiles(AV1_COMP *cpi) {
   AV1_COMMON *const cm = &cpi->common;
   int tile_col, tile_row;
 
   av1_init_tile_data(cpi);
+  av1_alloc_row_data(cpi, &cpi->td);
 
   for (tile_row = 0; tile_row < cm->tile_rows; ++tile_row)
     for (tile_col = 0; tile_col < cm->tile_cols; ++tile_col)
       av1_encode_tile(cpi, &cpi->td, tile_row, tile_col);
 }
 
+// Row-based multi-threading needs every superblock row to be independent of
+// the rows before it, apart from the above context. PVQ codes blocks through
+// a per tile queue, and delta q and sub-frame probability updates carry state
+// from one row to the next, so those fall back to the other paths.
+static int use_row_mt(const AV1_COMP *cpi) {
+  const AV1_COMMON *const cm = &cpi->common;
+  if (CONFIG_PVQ || !cpi->oxcf.row_mt) return 0;
+#if CONFIG_DELTA_Q
+  if (cm->delta_q_present_flag) return 0;
+#endif  // CONFIG_DELTA_Q
+#if CONFIG_ENTROPY
+  if (cm->do_subframe_update &&
+      cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD)
+    return 0;
+#endif  // CONFIG_ENTROPY
+  (void)cm;
+  return 1;
+}
+
 #if CONFIG_FP_MB_STATS
 static int input_fpmb_stats(FIRSTPASS_MB_STATS *firstpass_mb_stats,
                             AV1_COMMON *cm, uint8_t **this_frame_mb_stats) {
@@ -4970,6 +5086,102 @@ static int input_fpmb_stats(FIRSTPASS_MB_STATS *firstpass_mb_stats,
 }
 #endif
 
+#if CONFIG_GLOBAL_MOTION
+void av1_global_motion_search_ref(AV1_COMP *cpi, int frame) {
+  AV1_COMMON *const cm = &cpi->common;
+#if CONFIG_AOM_HIGHBITDEPTH
+  const MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  YV12_BUFFER_CONFIG *const ref_buf = get_ref_frame_buffer(cpi, frame);
+  WarpedMotionParams *const gm = &cm->global_motion[frame];
+  GlobalMotionFrame ref;
+  double params[8] = { 0, 0, 1, 0, 0, 1, 0, 0 };
+  TransformationType model;
+
+  // The corners of a scaled reference are not in the coordinates of the
+  // source, nor need its pyramid reach the level of the source's.
+  if (ref_buf->y_width != cpi->Source->y_width ||
+      ref_buf->y_height != cpi->Source->y_height)
+    return;
+
+  aom_clear_system_state();
+  if (!compute_global_motion_frame(&ref, ref_buf,
+#if CONFIG_AOM_HIGHBITDEPTH
+                                   cm->bit_depth,
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                                   cpi->gm_data.src.level))
+    return;
+  for (model = ROTZOOM; model < GLOBAL_TRANS_TYPES; ++model) {
+    if (compute_global_motion_feature_based(model, &cpi->gm_data.src, &ref,
+                                            params)) {
+      convert_model_to_params(params, gm);
+      if (gm->wmtype != IDENTITY) {
+        // The model is refined on the full resolution frames.
+        const double erroradvantage = refine_integerized_param(
+            gm, gm->wmtype,
+#if CONFIG_AOM_HIGHBITDEPTH
+            xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH, xd->bd,
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+            ref_buf->y_buffer, ref_buf->y_width, ref_buf->y_height,
+            ref_buf->y_stride, cpi->Source->y_buffer, cpi->Source->y_width,
+            cpi->Source->y_height, cpi->Source->y_stride, 3);
+        if (erroradvantage > gm_advantage_thresh[gm->wmtype]) {
+          set_default_gmparams(gm);
+        }
+      }
+    }
+    if (gm->wmtype != IDENTITY) break;
+  }
+  free_global_motion_frame(&ref);
+  aom_clear_system_state();
+}
+
+static void global_motion_search(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  GlobalMotionData *const gm_data = &cpi->gm_data;
+  YV12_BUFFER_CONFIG *ref_bufs[TOTAL_REFS_PER_FRAME] = { NULL };
+  int frame, i;
+
+  // The source corners are found before the reference frames are searched,
+  // as are the 8-bit copies cached in the frame buffers.
+  aom_clear_system_state();
+  if (!compute_global_motion_frame(&gm_data->src, cpi->Source,
+#if CONFIG_AOM_HIGHBITDEPTH
+                                   cm->bit_depth,
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                                   cpi->sf.gm_pyramid_level))
+    return;
+
+  // Reference frames sharing a frame buffer are only searched once.
+  gm_data->num_frames = 0;
+  for (frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame) {
+    ref_bufs[frame] = get_ref_frame_buffer(cpi, frame);
+    if (!ref_bufs[frame]) continue;
+    for (i = LAST_FRAME; i < frame; ++i)
+      if (ref_bufs[i] == ref_bufs[frame]) break;
+    if (i == frame) gm_data->frames[gm_data->num_frames++] = frame;
+  }
+
+  if (cpi->oxcf.max_threads > 1 && gm_data->num_frames > 1) {
+    av1_global_motion_search_mt(cpi);
+  } else {
+    for (i = 0; i < gm_data->num_frames; ++i)
+      av1_global_motion_search_ref(cpi, gm_data->frames[i]);
+  }
+
+  for (frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame) {
+    if (!ref_bufs[frame]) continue;
+    for (i = LAST_FRAME; i < frame; ++i) {
+      if (ref_bufs[i] == ref_bufs[frame]) {
+        cm->global_motion[frame] = cm->global_motion[i];
+        break;
+      }
+    }
+  }
+  free_global_motion_frame(&gm_data->src);
+}
+#endif  // CONFIG_GLOBAL_MOTION
+
 static void encode_frame_internal(AV1_COMP *cpi) {
   ThreadData *const td = &cpi->td;
   MACROBLOCK *const x = &td->mb;
@@ -4992,46 +5204,10 @@ static void encode_frame_internal(AV1_COMP *cpi) {
   av1_zero(rdc->comp_pred_diff);
 
 #if CONFIG_GLOBAL_MOTION
-  av1_zero(cpi->global_motion_used);
+  av1_zero(rdc->global_motion_used);
   if (cpi->common.frame_type == INTER_FRAME && cpi->Source &&
       !cpi->global_motion_search_done) {
-    YV12_BUFFER_CONFIG *ref_buf;
-    int frame;
-    double erroradvantage = 0;
-    double params[8] = { 0, 0, 1, 0, 0, 1, 0, 0 };
-    for (frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame) {
-      ref_buf = get_ref_frame_buffer(cpi, frame);
-      if (ref_buf) {
-        TransformationType model;
-        aom_clear_system_state();
-        for (model = ROTZOOM; model < GLOBAL_TRANS_TYPES; ++model) {
-          if (compute_global_motion_feature_based(model, cpi->Source, ref_buf,
-#if CONFIG_AOM_HIGHBITDEPTH
-                                                  cpi->common.bit_depth,
-#endif  // CONFIG_AOM_HIGHBITDEPTH
-                                                  params)) {
-            convert_model_to_params(params, &cm->global_motion[frame]);
-            if (cm->global_motion[frame].wmtype != IDENTITY) {
-              erroradvantage = refine_integerized_param(
-                  &cm->global_motion[frame], cm->global_motion[frame].wmtype,
-#if CONFIG_AOM_HIGHBITDEPTH
-                  xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH, xd->bd,
-#endif  // CONFIG_AOM_HIGHBITDEPTH
-                  ref_buf->y_buffer, ref_buf->y_width, ref_buf->y_height,
-                  ref_buf->y_stride, cpi->Source->y_buffer,
-                  cpi->Source->y_width, cpi->Source->y_height,
-                  cpi->Source->y_stride, 3);
-              if (erroradvantage >
-                  gm_advantage_thresh[cm->global_motion[frame].wmtype]) {
-                set_default_gmparams(&cm->global_motion[frame]);
-              }
-            }
-          }
-          if (cm->global_motion[frame].wmtype != IDENTITY) break;
-        }
-        aom_clear_system_state();
-      }
-    }
+    global_motion_search(cpi);
     cpi->global_motion_search_done = 1;
   }
 #endif  // CONFIG_GLOBAL_MOTION
@@ -5122,7 +5298,10 @@ static void encode_frame_internal(AV1_COMP *cpi) {
     // TODO(geza.lore): The multi-threaded encoder is not safe with more than
     // 1 tile rows, as it uses the single above_context et al arrays from
     // cpi->common
-    if (AOMMIN(cpi->oxcf.max_threads, cm->tile_cols) > 1 && cm->tile_rows == 1)
+    if (use_row_mt(cpi))
+      av1_encode_tiles_row_mt(cpi);
+    else if (AOMMIN(cpi->oxcf.max_threads, cm->tile_cols) > 1 &&
+             cm->tile_rows == 1)
       av1_encode_tiles_mt(cpi);
     else
       encode_tiles(cpi);
@@ -12,6 +12,7 @@
 #ifndef AV1_ENCODER_ENCODEFRAME_H_
 #define AV1_ENCODER_ENCODEFRAME_H_
 
+#include "./aom_config.h"
 #include "aom/aom_integer.h"
 
 #ifdef __cplusplus
@@ -22,6 +23,7 @@ struct macroblock;
 struct yv12_buffer_config;
 struct AV1_COMP;
 struct ThreadData;
+struct TileDataEnc;
 
 // Constants used in SOURCE_VAR_BASED_PARTITION
 #define VAR_HIST_MAX_BG_VAR 1000
@@ -37,11 +39,26 @@ void av1_setup_src_planes(struct macroblock *x,
 void av1_encode_frame(struct AV1_COMP *cpi);
 
 void av1_init_tile_data(struct AV1_COMP *cpi);
+// Allocates td->row_data, which av1_encode_tile() and av1_encode_sb_row()
+// need, and resets the counts it keeps over the frame. Must be called from
+// the main thread before each frame.
+void av1_alloc_row_data(struct AV1_COMP *cpi, struct ThreadData *td);
 void av1_encode_tile(struct AV1_COMP *cpi, struct ThreadData *td, int tile_row,
                      int tile_col);
+// Encodes the superblock row at mi_row of a tile for row-based
+// multi-threading.
+void av1_encode_sb_row(struct AV1_COMP *cpi, struct ThreadData *td,
+                       int tile_row, int tile_col, int mi_row);
 
 void av1_set_variance_partition_thresholds(struct AV1_COMP *cpi, int q);
 
+#if CONFIG_GLOBAL_MOTION
+// Searches the global motion model of one reference frame, from the corners
+// of the source frame in cpi->gm_data. Only cm->global_motion[frame] is
+// written, so the reference frames can be searched in parallel.
+void av1_global_motion_search_ref(struct AV1_COMP *cpi, int frame);
+#endif  // CONFIG_GLOBAL_MOTION
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
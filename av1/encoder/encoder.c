@@ -472,6 +472,8 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
 
   av1_free_pc_tree(&cpi->td);
   av1_free_var_tree(&cpi->td);
+  aom_free(cpi->td.row_data);
+  cpi->td.row_data = NULL;
 
 #if CONFIG_PALETTE
   if (cpi->common.allow_screen_content_tools)
@@ -2586,9 +2588,9 @@ void av1_remove_compressor(AV1_COMP *cpi) {
 
     // Deallocate allocated thread data.
     if (t < cpi->num_workers - 1) {
+      aom_free(thread_data->td->row_data);
 #if CONFIG_PALETTE
-      if (cpi->common.allow_screen_content_tools)
-        aom_free(thread_data->td->mb.palette_buffer);
+      aom_free(thread_data->td->mb.palette_buffer);
 #endif  // CONFIG_PALETTE
       aom_free(thread_data->td->counts);
       av1_free_pc_tree(thread_data->td);
@@ -2600,6 +2602,9 @@ void av1_remove_compressor(AV1_COMP *cpi) {
   aom_free(cpi->workers);
 
   if (cpi->num_workers > 1) av1_loop_filter_dealloc(&cpi->lf_row_sync);
+  av1_post_filter_dealloc(&cpi->post_filter_sync);
+  av1_row_mt_mem_dealloc(cpi);
+  av1_row_mt_sync_mem_dealloc(&cpi->first_pass_sync);
 
   dealloc_compressor_data(cpi);
 
@@ -2608,6 +2613,9 @@ void av1_remove_compressor(AV1_COMP *cpi) {
     aom_free(cpi->mbgraph_stats[i].mb_stats);
   }
 
+  aom_free(cpi->twopass.row_stats);
+  cpi->twopass.row_stats = NULL;
+
 #if CONFIG_FP_MB_STATS
   if (cpi->use_fp_mb_stats) {
     aom_free(cpi->twopass.frame_mb_stats_buf);
@@ -2982,13 +2990,13 @@ static int recode_loop_test_global_motion(AV1_COMP *cpi) {
   AV1_COMMON *const cm = &cpi->common;
   for (i = LAST_FRAME; i <= ALTREF_FRAME; ++i) {
     if (cm->global_motion[i].wmtype != IDENTITY &&
-        cpi->global_motion_used[i][1] <
+        cpi->td.rd_counts.global_motion_used[i][1] <
             min_blocks[cm->global_motion[i].wmtype]) {
       set_default_gmparams(&cm->global_motion[i]);
 #if CONFIG_REF_MV
       recode = 1;
 #else
-      recode |= (cpi->global_motion_used[i][1] > 0);
+      recode |= (cpi->td.rd_counts.global_motion_used[i][1] > 0);
 #endif
     }
   }
@@ -3426,6 +3434,22 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
 #endif  // DUMP_REF_FRAME_IMAGES
 }
 
+#if CONFIG_CLPF
+static void clpf_frame(AV1_COMP *cpi, const YV12_BUFFER_CONFIG *org,
+                       int enable_fb_flag, unsigned int strength,
+                       unsigned int fb_size_log2, int plane,
+                       ClpfDecisionFunc decision) {
+  AV1_COMMON *const cm = &cpi->common;
+  if (cpi->num_workers > 1)
+    av1_clpf_frame_mt(cm->frame_to_show, org, cm, enable_fb_flag, strength,
+                      fb_size_log2, plane, decision, cpi->workers,
+                      cpi->num_workers, &cpi->post_filter_sync);
+  else
+    av1_clpf_frame(cm->frame_to_show, org, cm, enable_fb_flag, strength,
+                   fb_size_log2, plane, decision);
+}
+#endif  // CONFIG_CLPF
+
 static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
   MACROBLOCKD *xd = &cpi->td.mb.e_mbd;
   struct loopfilter *lf = &cm->lf;
@@ -3466,7 +3490,12 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
   } else {
     cm->dering_level =
         av1_dering_search(cm->frame_to_show, cpi->Source, cm, xd);
-    av1_dering_frame(cm->frame_to_show, cm, xd, cm->dering_level);
+    if (cpi->num_workers > 1)
+      av1_dering_frame_mt(cm->frame_to_show, cm, xd->plane, cm->dering_level,
+                          cpi->workers, cpi->num_workers,
+                          &cpi->post_filter_sync);
+    else
+      av1_dering_frame(cm->frame_to_show, cm, xd, cm->dering_level);
   }
 #endif  // CONFIG_DERING
 
@@ -3504,17 +3533,16 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
       cm->clpf_strength_y = strength_y - (strength_y == 4);
       cm->clpf_size =
           fb_size_log2 ? fb_size_log2 - MAX_FB_SIZE_LOG2 + 3 : CLPF_NOSIZE;
-      av1_clpf_frame(frame, cpi->Source, cm, cm->clpf_size != CLPF_NOSIZE,
-                     strength_y, 4 + cm->clpf_size, AOM_PLANE_Y,
-                     av1_clpf_decision);
+      clpf_frame(cpi, cpi->Source, cm->clpf_size != CLPF_NOSIZE, strength_y,
+                 4 + cm->clpf_size, AOM_PLANE_Y, av1_clpf_decision);
     }
     if (strength_u) {
       cm->clpf_strength_u = strength_u - (strength_u == 4);
-      av1_clpf_frame(frame, NULL, cm, 0, strength_u, 4, AOM_PLANE_U, NULL);
+      clpf_frame(cpi, NULL, 0, strength_u, 4, AOM_PLANE_U, NULL);
     }
     if (strength_v) {
       cm->clpf_strength_v = strength_v - (strength_v == 4);
-      av1_clpf_frame(frame, NULL, cm, 0, strength_v, 4, AOM_PLANE_V, NULL);
+      clpf_frame(cpi, NULL, 0, strength_v, 4, AOM_PLANE_V, NULL);
     }
   }
 #endif
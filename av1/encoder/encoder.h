@@ -30,6 +30,9 @@
 #include "av1/encoder/context_tree.h"
 #include "av1/encoder/encodemb.h"
 #include "av1/encoder/firstpass.h"
+#if CONFIG_GLOBAL_MOTION
+#include "av1/encoder/global_motion.h"
+#endif  // CONFIG_GLOBAL_MOTION
 #include "av1/encoder/lookahead.h"
 #include "av1/encoder/mbgraph.h"
 #include "av1/encoder/mcomp.h"
@@ -250,6 +253,8 @@ typedef struct AV1EncoderConfig {
 #endif  // CONFIG_LOOPFILTERING_ACROSS_TILES
 
   int max_threads;
+  // Encode superblock rows within a tile in parallel.
+  unsigned int row_mt;
 
   aom_fixed_buf_t two_pass_stats_in;
   struct aom_codec_pkt_list *output_pkt_list;
@@ -287,17 +292,72 @@ typedef struct TileDataEnc {
   int mode_map[BLOCK_SIZES][MAX_MODES];
   int m_search_count;
   int ex_search_count;
+#if CONFIG_GLOBAL_MOTION
+  // Blocks that use the global motion of each reference, over which the rate
+  // of the global motion parameters is spread: those of the superblock row
+  // with row-based multi-threading, and those of the frame otherwise.
+  int global_motion_used[TOTAL_REFS_PER_FRAME];
+#endif  // CONFIG_GLOBAL_MOTION
 #if CONFIG_PVQ
   PVQ_QUEUE pvq_q;
 #endif
 #if CONFIG_EC_ADAPT
   FRAME_CONTEXT tctx;
 #endif
+  // Wavefront of the tile when its superblock rows are encoded in parallel.
+  AV1RowMTSync *row_mt_sync;
 } TileDataEnc;
 
+// Superblock row jobs of the tile row being encoded with row-based
+// multi-threading. Job j encodes superblock row j / tile_cols of tile column
+// j % tile_cols, so a row is always handed out after the row above it.
+typedef struct AV1EncRowMTData {
+  // One wavefront per tile column.
+  AV1RowMTSync *sync;
+  // Tokens of each superblock row, indexed by tile_col * alloc_sb_rows +
+  // sb_row. Rows write to disjoint parts of the tile token buffer and are
+  // packed together once the tile row is done.
+  unsigned int *tok_count;
+  int alloc_sb_rows;
+  int alloc_tile_cols;
+  int alloc_width;
+  int tile_row;
+  int next_job;
+  int num_jobs;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *job_mutex;
+#endif
+} AV1EncRowMTData;
+
+// Alt-ref filter parameters shared by the macroblock rows, which are
+// filtered independently and possibly in parallel.
+typedef struct ARNRFilterData {
+  YV12_BUFFER_CONFIG *frames[MAX_LAG_BUFFERS];
+  int frame_count;
+  int alt_ref_index;
+  int strength;
+  struct scale_factors sf;
+} ARNRFilterData;
+
+#if CONFIG_GLOBAL_MOTION
+// Global motion search state shared by the reference frames, which are
+// searched independently and possibly in parallel.
+typedef struct GlobalMotionData {
+  // Corners of the source frame, found once for all the reference frames.
+  GlobalMotionFrame src;
+  // Reference frames to search. Each has its own frame buffer.
+  int frames[TOTAL_REFS_PER_FRAME];
+  int num_frames;
+} GlobalMotionData;
+#endif  // CONFIG_GLOBAL_MOTION
+
 typedef struct RD_COUNTS {
   av1_coeff_count coef_counts[TX_SIZES][PLANE_TYPES];
   int64_t comp_pred_diff[REFERENCE_MODES];
+#if CONFIG_GLOBAL_MOTION
+  // Number of blocks and of 4x4s that use the global motion of each reference.
+  int global_motion_used[TOTAL_REFS_PER_FRAME][2];
+#endif  // CONFIG_GLOBAL_MOTION
 } RD_COUNTS;
 
 typedef struct ThreadData {
@@ -311,6 +371,9 @@ typedef struct ThreadData {
 
   VAR_TREE *var_tree;
   VAR_TREE *var_root[MAX_MIB_SIZE_LOG2 - MIN_MIB_SIZE_LOG2 + 1];
+
+  // Mode search state of the superblock row being encoded.
+  TileDataEnc *row_data;
 } ThreadData;
 
 struct EncWorkerData;
@@ -636,6 +699,12 @@ typedef struct AV1_COMP {
   AVxWorker *workers;
   struct EncWorkerData *tile_thr_data;
   AV1LfSync lf_row_sync;
+  // Row synchronization of the multi-threaded deringing and CLPF.
+  AV1PostFilterSync post_filter_sync;
+  AV1EncRowMTData row_mt_data;
+  ARNRFilterData arnr_filter_data;
+  // Wavefront of the macroblock rows of the first pass.
+  AV1RowMTSync first_pass_sync;
 #if CONFIG_ENTROPY
   SUBFRAME_STATS subframe_stats;
   // TODO(yaowu): minimize the size of count buffers
@@ -653,10 +722,8 @@ typedef struct AV1_COMP {
   int arf_map[MAX_EXT_ARFS + 1];
 #endif  // CONFIG_EXT_REFS
 #if CONFIG_GLOBAL_MOTION
-  // Stores number of prediction blocks using global motion and the
-  // number of 4x4 blocks using it per reference frame.
-  int global_motion_used[TOTAL_REFS_PER_FRAME][2];
   int global_motion_search_done;
+  GlobalMotionData gm_data;
 #endif
 #if CONFIG_REFERENCE_BUFFER
   SequenceHeader seq_params;
@@ -9,9 +9,14 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <assert.h>
+#include <string.h>
+
 #include "av1/encoder/encodeframe.h"
 #include "av1/encoder/encoder.h"
 #include "av1/encoder/ethread.h"
+#include "av1/encoder/firstpass.h"
+#include "av1/encoder/temporal_filter.h"
 #include "aom_dsp/aom_dsp_common.h"
 
 static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
@@ -28,6 +33,18 @@ static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
             for (n = 0; n < ENTROPY_TOKENS; n++)
               td->rd_counts.coef_counts[i][j][k][l][m][n] +=
                   td_t->rd_counts.coef_counts[i][j][k][l][m][n];
+
+#if CONFIG_GLOBAL_MOTION
+  for (i = 0; i < TOTAL_REFS_PER_FRAME; i++)
+    for (j = 0; j < 2; j++)
+      td->rd_counts.global_motion_used[i][j] +=
+          td_t->rd_counts.global_motion_used[i][j];
+#endif  // CONFIG_GLOBAL_MOTION
+}
+
+// The tiles are shared by as many workers as there are tile columns.
+static int get_num_tile_workers(const AV1_COMP *cpi) {
+  return AOMMIN(cpi->num_workers, cpi->common.tile_cols);
 }
 
 static int enc_worker_hook(EncWorkerData *const thread_data, void *unused) {
@@ -35,12 +52,12 @@ static int enc_worker_hook(EncWorkerData *const thread_data, void *unused) {
   const AV1_COMMON *const cm = &cpi->common;
   const int tile_cols = cm->tile_cols;
   const int tile_rows = cm->tile_rows;
+  const int num_workers = get_num_tile_workers(cpi);
   int t;
 
   (void)unused;
 
-  for (t = thread_data->start; t < tile_rows * tile_cols;
-       t += cpi->num_workers) {
+  for (t = thread_data->start; t < tile_rows * tile_cols; t += num_workers) {
     int tile_row = t / tile_cols;
     int tile_col = t % tile_cols;
 
@@ -50,34 +67,43 @@ static int enc_worker_hook(EncWorkerData *const thread_data, void *unused) {
   return 0;
 }
 
-void av1_encode_tiles_mt(AV1_COMP *cpi) {
+// Creates the workers on the first multi-threaded frame, and adds workers
+// when a later call asks for more of them. The last worker runs on the main
+// thread and uses the thread data in cpi.
+static void create_enc_workers(AV1_COMP *cpi, int num_workers) {
   AV1_COMMON *const cm = &cpi->common;
-  const int tile_cols = cm->tile_cols;
   const AVxWorkerInterface *const winterface = aom_get_worker_interface();
-  const int num_workers = AOMMIN(cpi->oxcf.max_threads, tile_cols);
+  const int old_num_workers = cpi->num_workers;
   int i;
 
-  av1_init_tile_data(cpi);
+  if (num_workers <= old_num_workers) return;
+
+  // The threads keep a pointer to their AVxWorker, so they are stopped while
+  // the arrays grow and started again below.
+  for (i = 0; i < old_num_workers; i++) winterface->end(&cpi->workers[i]);
 
-  // Only run once to create threads and allocate thread data.
-  if (cpi->num_workers == 0) {
-    CHECK_MEM_ERROR(cm, cpi->workers,
-                    aom_malloc(num_workers * sizeof(*cpi->workers)));
+  CHECK_MEM_ERROR(
+      cm, cpi->workers,
+      aom_realloc(cpi->workers, num_workers * sizeof(*cpi->workers)));
 
-    CHECK_MEM_ERROR(cm, cpi->tile_thr_data,
-                    aom_calloc(num_workers, sizeof(*cpi->tile_thr_data)));
+  CHECK_MEM_ERROR(cm, cpi->tile_thr_data,
+                  aom_realloc(cpi->tile_thr_data,
+                              num_workers * sizeof(*cpi->tile_thr_data)));
+  memset(cpi->tile_thr_data + old_num_workers, 0,
+         (num_workers - old_num_workers) * sizeof(*cpi->tile_thr_data));
 
-    for (i = 0; i < num_workers; i++) {
-      AVxWorker *const worker = &cpi->workers[i];
-      EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
+  for (i = 0; i < num_workers; i++) {
+    AVxWorker *const worker = &cpi->workers[i];
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
 
-      ++cpi->num_workers;
-      winterface->init(worker);
+    if (i >= old_num_workers) ++cpi->num_workers;
+    winterface->init(worker);
 
-      thread_data->cpi = cpi;
+    thread_data->cpi = cpi;
 
-      if (i < num_workers - 1) {
-        // Allocate thread data.
+    if (i < num_workers - 1) {
+      // Allocate thread data, unless the worker already had its own.
+      if (thread_data->td == NULL || thread_data->td == &cpi->td) {
         CHECK_MEM_ERROR(cm, thread_data->td,
                         aom_memalign(32, sizeof(*thread_data->td)));
         av1_zero(*thread_data->td);
@@ -94,32 +120,52 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
         // Allocate frame counters in thread data.
         CHECK_MEM_ERROR(cm, thread_data->td->counts,
                         aom_calloc(1, sizeof(*thread_data->td->counts)));
-
-        // Create threads
-        if (!winterface->reset(worker))
-          aom_internal_error(&cm->error, AOM_CODEC_ERROR,
-                             "Tile encoder thread creation failed");
-      } else {
-        // Main thread acts as a worker and uses the thread data in cpi.
-        thread_data->td = &cpi->td;
       }
 
-      winterface->sync(worker);
+      // Create threads
+      if (!winterface->reset(worker))
+        aom_internal_error(&cm->error, AOM_CODEC_ERROR,
+                           "Tile encoder thread creation failed");
+    } else {
+      // Main thread acts as a worker and uses the thread data in cpi.
+      thread_data->td = &cpi->td;
     }
+
+    winterface->sync(worker);
   }
+}
 
-  for (i = 0; i < num_workers; i++) {
+// Copies the block state of the main thread into a worker's thread data. The
+// buffers the worker allocated for itself are kept.
+static void copy_mb_to_worker(AV1_COMP *cpi, ThreadData *td) {
+#if CONFIG_PALETTE
+  PALETTE_BUFFER *const palette_buffer = td->mb.palette_buffer;
+#endif  // CONFIG_PALETTE
+
+  td->mb = cpi->td.mb;
+#if CONFIG_PALETTE
+  td->mb.palette_buffer = palette_buffer;
+#endif  // CONFIG_PALETTE
+}
+
+// The workers that take part are the last num_workers of the pool, so that
+// the last of them, which runs on the main thread, is always one of them.
+static void prepare_enc_workers(AV1_COMP *cpi, AVxWorkerHook hook,
+                                int num_workers) {
+  int i;
+
+  for (i = cpi->num_workers - num_workers; i < cpi->num_workers; i++) {
     AVxWorker *const worker = &cpi->workers[i];
     EncWorkerData *thread_data;
 
-    worker->hook = (AVxWorkerHook)enc_worker_hook;
+    worker->hook = hook;
     worker->data1 = &cpi->tile_thr_data[i];
     worker->data2 = NULL;
     thread_data = (EncWorkerData *)worker->data1;
 
     // Before encoding a frame, copy the thread data from cpi.
     if (thread_data->td != &cpi->td) {
-      thread_data->td->mb = cpi->td.mb;
+      copy_mb_to_worker(cpi, thread_data->td);
       thread_data->td->rd_counts = cpi->td.rd_counts;
     }
     if (thread_data->td->counts != &cpi->common.counts) {
@@ -129,21 +175,29 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
 
 #if CONFIG_PALETTE
     // Allocate buffers used by palette coding mode.
-    if (cpi->common.allow_screen_content_tools && i < num_workers - 1) {
+    if (cpi->common.allow_screen_content_tools && i < cpi->num_workers - 1 &&
+        thread_data->td->mb.palette_buffer == NULL) {
+      AV1_COMMON *const cm = &cpi->common;
       MACROBLOCK *x = &thread_data->td->mb;
       CHECK_MEM_ERROR(cm, x->palette_buffer,
                       aom_memalign(16, sizeof(*x->palette_buffer)));
     }
 #endif  // CONFIG_PALETTE
   }
+}
+
+static void launch_enc_workers(AV1_COMP *cpi, int num_workers) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  const int first = cpi->num_workers - num_workers;
+  int i;
 
   // Encode a frame
-  for (i = 0; i < num_workers; i++) {
+  for (i = first; i < cpi->num_workers; i++) {
     AVxWorker *const worker = &cpi->workers[i];
     EncWorkerData *const thread_data = (EncWorkerData *)worker->data1;
 
     // Set the starting tile for each thread.
-    thread_data->start = i;
+    thread_data->start = i - first;
 
     if (i == cpi->num_workers - 1)
       winterface->execute(worker);
@@ -152,12 +206,17 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
   }
 
   // Encoding ends.
-  for (i = 0; i < num_workers; i++) {
+  for (i = first; i < cpi->num_workers; i++) {
     AVxWorker *const worker = &cpi->workers[i];
     winterface->sync(worker);
   }
+}
 
-  for (i = 0; i < num_workers; i++) {
+static void accumulate_enc_workers(AV1_COMP *cpi, int num_workers) {
+  AV1_COMMON *const cm = &cpi->common;
+  int i;
+
+  for (i = cpi->num_workers - num_workers; i < cpi->num_workers; i++) {
     AVxWorker *const worker = &cpi->workers[i];
     EncWorkerData *const thread_data = (EncWorkerData *)worker->data1;
 
@@ -168,3 +227,315 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
     }
   }
 }
+
+void av1_encode_tiles_mt(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  const int tile_cols = cm->tile_cols;
+  int num_workers, i;
+
+  av1_init_tile_data(cpi);
+
+  // The pool may have more workers than tile columns, when other stages of
+  // the encoder have grown it.
+  create_enc_workers(cpi, AOMMIN(cpi->oxcf.max_threads, tile_cols));
+  num_workers = get_num_tile_workers(cpi);
+  for (i = cpi->num_workers - num_workers; i < cpi->num_workers; i++)
+    av1_alloc_row_data(cpi, cpi->tile_thr_data[i].td);
+  prepare_enc_workers(cpi, (AVxWorkerHook)enc_worker_hook, num_workers);
+  launch_enc_workers(cpi, num_workers);
+  accumulate_enc_workers(cpi, num_workers);
+}
+
+static int get_next_job(AV1EncRowMTData *const row_mt_data) {
+  int job = -1;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(row_mt_data->job_mutex);
+#endif
+  if (row_mt_data->next_job < row_mt_data->num_jobs)
+    job = row_mt_data->next_job++;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(row_mt_data->job_mutex);
+#endif
+  return job;
+}
+
+static int enc_row_mt_worker_hook(EncWorkerData *const thread_data,
+                                  void *unused) {
+  AV1_COMP *const cpi = thread_data->cpi;
+  const AV1_COMMON *const cm = &cpi->common;
+  AV1EncRowMTData *const row_mt_data = &cpi->row_mt_data;
+  const int tile_row = row_mt_data->tile_row;
+  const int tile_cols = cm->tile_cols;
+  int job;
+
+  (void)unused;
+
+  while ((job = get_next_job(row_mt_data)) >= 0) {
+    const int tile_col = job % tile_cols;
+    const TileInfo *const tile_info =
+        &cpi->tile_data[tile_row * tile_cols + tile_col].tile_info;
+    const int mi_row =
+        tile_info->mi_row_start + (job / tile_cols) * cm->mib_size;
+
+    av1_encode_sb_row(cpi, thread_data->td, tile_row, tile_col, mi_row);
+  }
+
+  return 0;
+}
+
+static void row_mt_mem_alloc(AV1_COMP *cpi, int max_sb_rows) {
+  AV1_COMMON *const cm = &cpi->common;
+  AV1EncRowMTData *const row_mt_data = &cpi->row_mt_data;
+  int i;
+
+  if (row_mt_data->alloc_tile_cols == cm->tile_cols &&
+      row_mt_data->alloc_sb_rows == max_sb_rows &&
+      row_mt_data->alloc_width == cm->width)
+    return;
+
+  av1_row_mt_mem_dealloc(cpi);
+
+  CHECK_MEM_ERROR(
+      cm, row_mt_data->sync,
+      aom_calloc(cm->tile_cols, sizeof(*row_mt_data->sync)));
+  row_mt_data->alloc_tile_cols = cm->tile_cols;
+  for (i = 0; i < cm->tile_cols; ++i)
+    av1_row_mt_sync_mem_alloc(&row_mt_data->sync[i], cm, max_sb_rows);
+
+  CHECK_MEM_ERROR(cm, row_mt_data->tok_count,
+                  aom_calloc(cm->tile_cols * max_sb_rows,
+                             sizeof(*row_mt_data->tok_count)));
+  row_mt_data->alloc_sb_rows = max_sb_rows;
+  row_mt_data->alloc_width = cm->width;
+
+#if CONFIG_MULTITHREAD
+  CHECK_MEM_ERROR(cm, row_mt_data->job_mutex,
+                  aom_malloc(sizeof(*row_mt_data->job_mutex)));
+  if (row_mt_data->job_mutex) pthread_mutex_init(row_mt_data->job_mutex, NULL);
+#endif
+}
+
+void av1_row_mt_mem_dealloc(AV1_COMP *cpi) {
+  AV1EncRowMTData *const row_mt_data = &cpi->row_mt_data;
+  int i;
+
+  if (row_mt_data->sync != NULL) {
+    for (i = 0; i < row_mt_data->alloc_tile_cols; ++i)
+      av1_row_mt_sync_mem_dealloc(&row_mt_data->sync[i]);
+    aom_free(row_mt_data->sync);
+  }
+  aom_free(row_mt_data->tok_count);
+#if CONFIG_MULTITHREAD
+  if (row_mt_data->job_mutex != NULL) {
+    pthread_mutex_destroy(row_mt_data->job_mutex);
+    aom_free(row_mt_data->job_mutex);
+  }
+#endif
+  av1_zero(*row_mt_data);
+}
+
+void av1_encode_tiles_row_mt(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  AV1EncRowMTData *const row_mt_data = &cpi->row_mt_data;
+  const int tile_cols = cm->tile_cols;
+  const int tile_rows = cm->tile_rows;
+  int tile_row, tile_col, i;
+  int max_sb_rows = 0;
+
+  av1_init_tile_data(cpi);
+
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    const TileInfo *const tile_info =
+        &cpi->tile_data[tile_row * tile_cols].tile_info;
+    const int sb_rows =
+        (tile_info->mi_row_end - tile_info->mi_row_start + cm->mib_size - 1) >>
+        cm->mib_size_log2;
+    max_sb_rows = AOMMAX(max_sb_rows, sb_rows);
+  }
+  row_mt_mem_alloc(cpi, max_sb_rows);
+
+  create_enc_workers(cpi, AOMMAX(cpi->oxcf.max_threads, 1));
+  for (i = 0; i < cpi->num_workers; i++)
+    av1_alloc_row_data(cpi, cpi->tile_thr_data[i].td);
+  prepare_enc_workers(cpi, (AVxWorkerHook)enc_row_mt_worker_hook,
+                      cpi->num_workers);
+
+  // Tile rows share the above context arrays, so they are encoded one after
+  // the other, with the superblock rows of all tile columns in parallel.
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    const TileInfo *const first_tile =
+        &cpi->tile_data[tile_row * tile_cols].tile_info;
+    const int sb_rows = (first_tile->mi_row_end - first_tile->mi_row_start +
+                         cm->mib_size - 1) >>
+                        cm->mib_size_log2;
+
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      TileDataEnc *const this_tile =
+          &cpi->tile_data[tile_row * tile_cols + tile_col];
+      const TileInfo *const tile_info = &this_tile->tile_info;
+#if CONFIG_DEPENDENT_HORZTILES
+      if ((!cm->dependent_horz_tiles) || (tile_row == 0)) {
+        av1_zero_above_context(cm, tile_info->mi_col_start,
+                               tile_info->mi_col_end);
+      }
+#else
+      av1_zero_above_context(cm, tile_info->mi_col_start,
+                             tile_info->mi_col_end);
+#endif
+#if CONFIG_EC_ADAPT
+      this_tile->tctx = *cm->fc;
+#endif
+      av1_row_mt_sync_reset(&row_mt_data->sync[tile_col]);
+      this_tile->row_mt_sync = &row_mt_data->sync[tile_col];
+    }
+
+    row_mt_data->tile_row = tile_row;
+    row_mt_data->next_job = 0;
+    row_mt_data->num_jobs = sb_rows * tile_cols;
+    launch_enc_workers(cpi, cpi->num_workers);
+
+    // Pack the tokens of the superblock rows of each tile together.
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      const TileInfo *const tile_info =
+          &cpi->tile_data[tile_row * tile_cols + tile_col].tile_info;
+      const int tile_mb_cols =
+          (tile_info->mi_col_end - tile_info->mi_col_start + 1) >> 1;
+      TOKENEXTRA *const tile_tok = cpi->tile_tok[tile_row][tile_col];
+      TOKENEXTRA *tok = tile_tok;
+      int sb_row;
+
+      for (sb_row = 0; sb_row < sb_rows; ++sb_row) {
+        const unsigned int count =
+            row_mt_data->tok_count[tile_col * row_mt_data->alloc_sb_rows +
+                                   sb_row];
+        const TOKENEXTRA *const row_tok =
+            tile_tok + get_token_alloc((sb_row * cm->mib_size) >> 1,
+                                       tile_mb_cols);
+        if (tok != row_tok) memmove(tok, row_tok, count * sizeof(*tok));
+        tok += count;
+      }
+      cpi->tok_count[tile_row][tile_col] = (unsigned int)(tok - tile_tok);
+      assert(cpi->tok_count[tile_row][tile_col] <=
+             allocated_tokens(*tile_info));
+    }
+  }
+
+  accumulate_enc_workers(cpi, cpi->num_workers);
+}
+
+static int temporal_filter_worker_hook(EncWorkerData *const thread_data,
+                                       void *unused) {
+  AV1_COMP *const cpi = thread_data->cpi;
+  const ARNRFilterData *const arnr_filter_data = &cpi->arnr_filter_data;
+  const YV12_BUFFER_CONFIG *const f =
+      arnr_filter_data->frames[arnr_filter_data->alt_ref_index];
+  const int mb_rows = (f->y_crop_height + 15) >> 4;
+  int mb_row;
+
+  (void)unused;
+
+  for (mb_row = thread_data->start; mb_row < mb_rows;
+       mb_row += cpi->num_workers)
+    av1_temporal_filter_iterate_row_c(cpi, thread_data->td, mb_row);
+
+  return 0;
+}
+
+void av1_temporal_filter_row_mt(AV1_COMP *cpi) {
+  int i;
+
+  create_enc_workers(cpi, AOMMAX(cpi->oxcf.max_threads, 1));
+
+  for (i = 0; i < cpi->num_workers; i++) {
+    AVxWorker *const worker = &cpi->workers[i];
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
+
+    worker->hook = (AVxWorkerHook)temporal_filter_worker_hook;
+    worker->data1 = thread_data;
+    worker->data2 = NULL;
+
+    // Only the motion search state is needed, so the rest of the thread data
+    // is left alone.
+    if (thread_data->td != &cpi->td) copy_mb_to_worker(cpi, thread_data->td);
+  }
+
+  launch_enc_workers(cpi, cpi->num_workers);
+}
+
+static int first_pass_worker_hook(EncWorkerData *const thread_data,
+                                  void *unused) {
+  AV1_COMP *const cpi = thread_data->cpi;
+  const int mb_rows = cpi->common.mb_rows;
+  int mb_row;
+
+  (void)unused;
+
+  for (mb_row = thread_data->start; mb_row < mb_rows;
+       mb_row += cpi->num_workers)
+    av1_first_pass_row(cpi, thread_data->td, &cpi->first_pass_sync, mb_row);
+
+  return 0;
+}
+
+void av1_first_pass_row_mt(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  AV1RowMTSync *const sync = &cpi->first_pass_sync;
+  int i;
+
+  if (sync->rows != cm->mb_rows) {
+    av1_row_mt_sync_mem_dealloc(sync);
+    av1_row_mt_sync_mem_alloc(sync, cm, cm->mb_rows);
+  }
+  av1_row_mt_sync_reset(sync);
+
+  create_enc_workers(cpi, AOMMAX(cpi->oxcf.max_threads, 1));
+
+  for (i = 0; i < cpi->num_workers; i++) {
+    AVxWorker *const worker = &cpi->workers[i];
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
+
+    worker->hook = (AVxWorkerHook)first_pass_worker_hook;
+    worker->data1 = thread_data;
+    worker->data2 = NULL;
+
+    // The rows only need the block state, which is set up in cpi->td.mb.
+    if (thread_data->td != &cpi->td) copy_mb_to_worker(cpi, thread_data->td);
+  }
+
+  launch_enc_workers(cpi, cpi->num_workers);
+}
+
+#if CONFIG_GLOBAL_MOTION
+static int global_motion_worker_hook(EncWorkerData *const thread_data,
+                                     void *unused) {
+  AV1_COMP *const cpi = thread_data->cpi;
+  const GlobalMotionData *const gm_data = &cpi->gm_data;
+  int i;
+
+  (void)unused;
+
+  for (i = thread_data->start; i < gm_data->num_frames;
+       i += cpi->num_workers)
+    av1_global_motion_search_ref(cpi, gm_data->frames[i]);
+
+  return 0;
+}
+
+void av1_global_motion_search_mt(AV1_COMP *cpi) {
+  int i;
+
+  create_enc_workers(cpi, AOMMAX(cpi->oxcf.max_threads, 1));
+
+  // The search only reads the frames and cpi, so the thread data is left
+  // alone.
+  for (i = 0; i < cpi->num_workers; i++) {
+    AVxWorker *const worker = &cpi->workers[i];
+
+    worker->hook = (AVxWorkerHook)global_motion_worker_hook;
+    worker->data1 = &cpi->tile_thr_data[i];
+    worker->data2 = NULL;
+  }
+
+  launch_enc_workers(cpi, cpi->num_workers);
+}
+#endif  // CONFIG_GLOBAL_MOTION
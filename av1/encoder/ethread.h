@@ -12,6 +12,8 @@
 #ifndef AV1_ENCODER_ETHREAD_H_
 #define AV1_ENCODER_ETHREAD_H_
 
+#include "./aom_config.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -27,6 +29,27 @@ typedef struct EncWorkerData {
 
 void av1_encode_tiles_mt(struct AV1_COMP *cpi);
 
+// Encodes the superblock rows of each tile in parallel, following the rows
+// above them in a wavefront.
+void av1_encode_tiles_row_mt(struct AV1_COMP *cpi);
+
+void av1_row_mt_mem_dealloc(struct AV1_COMP *cpi);
+
+// Filters the macroblock rows of the alt-ref frame in parallel, with each
+// worker taking every num_workers-th row.
+void av1_temporal_filter_row_mt(struct AV1_COMP *cpi);
+
+// Analyses the macroblock rows of the first pass frame in parallel, in a
+// wavefront, with each worker taking every num_workers-th row.
+void av1_first_pass_row_mt(struct AV1_COMP *cpi);
+
+#if CONFIG_GLOBAL_MOTION
+// Searches the global motion models of the reference frames in
+// cpi->gm_data in parallel, with each worker taking every num_workers-th
+// reference frame.
+void av1_global_motion_search_mt(struct AV1_COMP *cpi);
+#endif  // CONFIG_GLOBAL_MOTION
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
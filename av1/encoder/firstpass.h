@@ -79,6 +79,34 @@ typedef struct {
   double count;
 } FIRSTPASS_STATS;
 
+// Macroblock sums of one row of the first pass frame. Rows may be analysed
+// in parallel, so each has its own sums, which are merged in row order. This
+// keeps the frame stats independent of the number of threads.
+typedef struct {
+  int64_t intra_error;
+  int64_t coded_error;
+  int64_t sr_coded_error;
+  int64_t sum_mvrs;
+  int64_t sum_mvcs;
+  int sum_mvr;
+  int sum_mvc;
+  int sum_mvr_abs;
+  int sum_mvc_abs;
+  int mvcount;
+  int intercount;
+  int second_ref_count;
+  int intra_skip_count;
+  int image_data_start_row;
+  int sum_in_vectors;
+  // Changes of motion vector after the first non-zero one of the row.
+  int new_mv_count;
+  MV first_mv;
+  MV last_mv;
+  double intra_factor;
+  double brightness_factor;
+  double neutral_count;
+} FIRSTPASS_ROW_STATS;
+
 typedef enum {
   KF_UPDATE = 0,
   LF_UPDATE = 1,
@@ -132,6 +160,10 @@ typedef struct {
   double modified_error_left;
   double mb_av_energy;
 
+  // Sums of each macroblock row of the frame in the first pass.
+  FIRSTPASS_ROW_STATS *row_stats;
+  int row_stats_rows;
+
 #if CONFIG_FP_MB_STATS
   uint8_t *frame_mb_stats_buf;
   uint8_t *this_frame_mb_stats;
@@ -164,10 +196,17 @@ typedef struct {
 } TWO_PASS;
 
 struct AV1_COMP;
+struct AV1RowMTSyncData;
+struct ThreadData;
 
 void av1_init_first_pass(struct AV1_COMP *cpi);
 void av1_rc_get_first_pass_params(struct AV1_COMP *cpi);
 void av1_first_pass(struct AV1_COMP *cpi, const struct lookahead_entry *source);
+// Analyses macroblock row mb_row of the first pass frame into
+// cpi->twopass.row_stats[mb_row]. row_mt_sync is NULL unless the rows are
+// analysed in parallel, in which case the row follows the one above it.
+void av1_first_pass_row(struct AV1_COMP *cpi, struct ThreadData *td,
+                        struct AV1RowMTSyncData *row_mt_sync, int mb_row);
 void av1_end_first_pass(struct AV1_COMP *cpi);
 
 void av1_init_second_pass(struct AV1_COMP *cpi);
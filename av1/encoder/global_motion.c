@@ -15,6 +15,7 @@
 #include <math.h>
 #include <assert.h>
 
+#include "aom_dsp/aom_dsp_common.h"
 #include "av1/common/warped_motion.h"
 
 #include "av1/encoder/segmentation.h"
@@ -27,6 +28,10 @@
 
 #define MIN_TRANS_THRESH (1 * GM_TRANS_DECODE_FACTOR)
 
+// Frames are not halved in size for the corner search below this width or
+// height.
+#define MIN_PYRAMID_FRAME_SIZE 128
+
 // Border over which to compute the global motion
 #define ERRORADV_BORDER 0
 
@@ -241,6 +246,7 @@ unsigned char *downconvert_frame(YV12_BUFFER_CONFIG *frm, int bit_depth) {
   uint16_t *orig_buf = CONVERT_TO_SHORTPTR(frm->y_buffer);
   uint8_t *buf = malloc(frm->y_height * frm->y_stride * sizeof(*buf));
 
+  if (!buf) return NULL;
   for (i = 0; i < frm->y_height; ++i)
     for (j = 0; j < frm->y_width; ++j)
       buf[i * frm->y_stride + j] =
@@ -248,54 +254,143 @@ unsigned char *downconvert_frame(YV12_BUFFER_CONFIG *frm, int bit_depth) {
 
   return buf;
 }
-#endif
 
-int compute_global_motion_feature_based(TransformationType type,
-                                        YV12_BUFFER_CONFIG *frm,
-                                        YV12_BUFFER_CONFIG *ref,
+// Halves the size of the frame's luma straight from 16 bits, so that the
+// full resolution 8-bit copy is not needed.
+static void highbd_downscale_by_two(const uint16_t *src, int src_stride,
+                                    int width, int height, int bit_depth,
+                                    unsigned char *dst, int dst_stride) {
+  const int shift = bit_depth - 8 + 2;
+  const int round = 1 << (shift - 1);
+  int i, j;
+  for (i = 0; i < height; ++i)
+    for (j = 0; j < width; ++j) {
+      const uint16_t *const p = src + 2 * i * src_stride + 2 * j;
+      dst[i * dst_stride + j] =
+          (p[0] + p[1] + p[src_stride] + p[src_stride + 1] + round) >> shift;
+    }
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+// Halves the size of an image, averaging each 2x2 block. 'width' and
+// 'height' are those of the destination.
+static void downscale_by_two(const unsigned char *src, int src_stride,
+                             int width, int height, unsigned char *dst,
+                             int dst_stride) {
+  int i, j;
+  for (i = 0; i < height; ++i)
+    for (j = 0; j < width; ++j) {
+      const unsigned char *const p = src + 2 * i * src_stride + 2 * j;
+      dst[i * dst_stride + j] =
+          (p[0] + p[1] + p[src_stride] + p[src_stride + 1] + 2) >> 2;
+    }
+}
+
+int compute_global_motion_frame(GlobalMotionFrame *gmf,
+                                YV12_BUFFER_CONFIG *frm,
 #if CONFIG_AOM_HIGHBITDEPTH
-                                        int bit_depth,
-#endif
-                                        double *params) {
-  int num_frm_corners, num_ref_corners;
-  int num_correspondences;
-  double *correspondences;
-  int num_inliers;
-  int frm_corners[2 * MAX_CORNERS], ref_corners[2 * MAX_CORNERS];
-  int *inlier_map = NULL;
-  unsigned char *frm_buffer = frm->y_buffer;
-  unsigned char *ref_buffer = ref->y_buffer;
+                                int bit_depth,
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                                int level) {
+  unsigned char *buf = frm->y_buffer;
+  int stride = frm->y_stride;
+  int width = frm->y_width;
+  int height = frm->y_height;
+  int l;
+
+  memset(gmf, 0, sizeof(*gmf));
+  while (level > 0 && AOMMIN(width, height) >> level < MIN_PYRAMID_FRAME_SIZE)
+    --level;
+  gmf->level = level;
+
+  gmf->corners = (int *)malloc(2 * MAX_CORNERS * sizeof(*gmf->corners));
+  if (!gmf->corners) return 0;
 
+  if (level > 0) {
+    // The first halving reads the frame, and the next ones are done in
+    // place in its buffer.
+    const int first_width = width >> 1;
+    const int first_height = height >> 1;
+    unsigned char *const dst =
+        (unsigned char *)malloc(first_width * first_height * sizeof(*dst));
+    if (!dst) {
+      free_global_motion_frame(gmf);
+      return 0;
+    }
 #if CONFIG_AOM_HIGHBITDEPTH
-  if (frm->flags & YV12_FLAG_HIGHBITDEPTH) {
+    if (frm->flags & YV12_FLAG_HIGHBITDEPTH)
+      highbd_downscale_by_two(CONVERT_TO_SHORTPTR(frm->y_buffer), stride,
+                              first_width, first_height, bit_depth, dst,
+                              first_width);
+    else
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+      downscale_by_two(buf, stride, first_width, first_height, dst,
+                       first_width);
+    buf = dst;
+    stride = first_width;
+    width = first_width;
+    height = first_height;
+    for (l = 1; l < level; ++l) {
+      width >>= 1;
+      height >>= 1;
+      downscale_by_two(buf, stride, width, height, buf, stride);
+    }
+    gmf->buf_allocated = 1;
+#if CONFIG_AOM_HIGHBITDEPTH
+  } else if (frm->flags & YV12_FLAG_HIGHBITDEPTH) {
     // The frame buffer is 16-bit, so we need to convert to 8 bits for the
     // following code. We cache the result until the frame is released.
-    if (frm->y_buffer_8bit)
-      frm_buffer = frm->y_buffer_8bit;
-    else
-      frm_buffer = frm->y_buffer_8bit = downconvert_frame(frm, bit_depth);
-  }
-  if (ref->flags & YV12_FLAG_HIGHBITDEPTH) {
-    if (ref->y_buffer_8bit)
-      ref_buffer = ref->y_buffer_8bit;
-    else
-      ref_buffer = ref->y_buffer_8bit = downconvert_frame(ref, bit_depth);
+    if (!frm->y_buffer_8bit)
+      frm->y_buffer_8bit = downconvert_frame(frm, bit_depth);
+    buf = frm->y_buffer_8bit;
+    if (!buf) {
+      free_global_motion_frame(gmf);
+      return 0;
+    }
+#endif  // CONFIG_AOM_HIGHBITDEPTH
   }
-#endif
+  gmf->buf = buf;
+  gmf->width = width;
+  gmf->height = height;
+  gmf->stride = stride;
 
   // compute interest points in images using FAST features
-  num_frm_corners = fast_corner_detect(frm_buffer, frm->y_width, frm->y_height,
-                                       frm->y_stride, frm_corners, MAX_CORNERS);
-  num_ref_corners = fast_corner_detect(ref_buffer, ref->y_width, ref->y_height,
-                                       ref->y_stride, ref_corners, MAX_CORNERS);
+  gmf->num_corners = fast_corner_detect(buf, width, height, stride,
+                                        gmf->corners, MAX_CORNERS);
+  return 1;
+}
+
+void free_global_motion_frame(GlobalMotionFrame *gmf) {
+  if (gmf->buf_allocated) free(gmf->buf);
+  free(gmf->corners);
+  memset(gmf, 0, sizeof(*gmf));
+}
+
+int compute_global_motion_feature_based(TransformationType type,
+                                        const GlobalMotionFrame *frm,
+                                        const GlobalMotionFrame *ref,
+                                        double *params) {
+  const int scale = 1 << frm->level;
+  // Centre of the full resolution pixels averaged into a pixel of the level.
+  const double offset = (scale - 1) / 2.0;
+  int num_correspondences;
+  double *correspondences;
+  int num_inliers;
+  int *inlier_map = NULL;
+  int i;
+
+  assert(frm->level == ref->level);
 
   // find correspondences between the two images
   correspondences =
-      (double *)malloc(num_frm_corners * 4 * sizeof(*correspondences));
+      (double *)malloc(frm->num_corners * 4 * sizeof(*correspondences));
+  if (!correspondences) return 0;
   num_correspondences = determine_correspondence(
-      frm_buffer, (int *)frm_corners, num_frm_corners, ref_buffer,
-      (int *)ref_corners, num_ref_corners, frm->y_width, frm->y_height,
-      frm->y_stride, ref->y_stride, correspondences);
+      frm->buf, frm->corners, frm->num_corners, ref->buf, ref->corners,
+      ref->num_corners, frm->width, frm->height, frm->stride, ref->stride,
+      correspondences);
+  for (i = 0; i < 4 * num_correspondences; ++i)
+    correspondences[i] = correspondences[i] * scale + offset;
 
   inlier_map = (int *)malloc(num_correspondences * sizeof(*inlier_map));
   num_inliers = compute_global_motion_params(
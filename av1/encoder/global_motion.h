@@ -12,13 +12,16 @@
 #ifndef AV1_ENCODER_GLOBAL_MOTION_H_
 #define AV1_ENCODER_GLOBAL_MOTION_H_
 
+#include "./aom_config.h"
 #include "aom/aom_integer.h"
+#include "aom_scale/yv12config.h"
+#include "av1/common/mv.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-const double gm_advantage_thresh[TRANS_TYPES] = {
+static const double gm_advantage_thresh[TRANS_TYPES] = {
   1.00,  // Identity (not used)
   0.85,  // Translation
   0.75,  // Rot zoom
@@ -46,6 +49,35 @@ double refine_integerized_param(WarpedMotionParams *wm,
                                 int r_stride, uint8_t *dst, int d_width,
                                 int d_height, int d_stride, int n_refinements);
 
+// The luma of a frame as used by the feature based global motion search:
+// converted to 8 bits, halved in size 'level' times, and the FAST corners
+// found in it.
+typedef struct GlobalMotionFrame {
+  unsigned char *buf;
+  // Set when 'buf' was allocated for this level, rather than being the
+  // frame's own buffer or its cached 8-bit copy.
+  int buf_allocated;
+  int width;
+  int height;
+  int stride;
+  int level;
+  int *corners;
+  int num_corners;
+} GlobalMotionFrame;
+
+// Sets up 'gmf' for the given frame. The level is lowered while the frame
+// would become too small to find corners in. Returns 0 if out of memory.
+// At level 0, high bit depth frames keep their 8-bit copy in y_buffer_8bit,
+// so a frame must not be set up by two threads at once.
+int compute_global_motion_frame(GlobalMotionFrame *gmf,
+                                YV12_BUFFER_CONFIG *frm,
+#if CONFIG_AOM_HIGHBITDEPTH
+                                int bit_depth,
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                                int level);
+
+void free_global_motion_frame(GlobalMotionFrame *gmf);
+
 /*
   Computes global motion parameters between two frames. The array
   "params" should be length 9, where the first 2 slots are translation
@@ -56,13 +88,12 @@ double refine_integerized_param(WarpedMotionParams *wm,
   A | B
   C | D
   would produce params = [trans row, trans col, B, A, C, D]
+  The corners are matched at the level of the two frames, which must be the
+  same, and the parameters are for the full resolution frames.
 */
 int compute_global_motion_feature_based(TransformationType type,
-                                        YV12_BUFFER_CONFIG *frm,
-                                        YV12_BUFFER_CONFIG *ref,
-#if CONFIG_AOM_HIGHBITDEPTH
-                                        int bit_depth,
-#endif
+                                        const GlobalMotionFrame *frm,
+                                        const GlobalMotionFrame *ref,
                                         double *params);
 #ifdef __cplusplus
 }  // extern "C"
@@ -11,6 +11,8 @@
 
 #include <math.h>
 #include <stdlib.h>
+
+#include "./av1_rtcd.h"
 #include "av1/encoder/palette.h"
 
 static float calc_dist(const float *p1, const float *p2, int dim) {
@@ -23,8 +25,10 @@ static float calc_dist(const float *p1, const float *p2, int dim) {
   return dist;
 }
 
-void av1_calc_indices(const float *data, const float *centroids,
-                      uint8_t *indices, int n, int k, int dim) {
+// Given 'n' 'data' points and 'k' 'centroids' each of dimension 'dim',
+// calculate the centroid 'indices' for the data points.
+void av1_calc_indices_c(const float *data, const float *centroids,
+                        uint8_t *indices, int n, int k, int dim) {
   int i, j;
   for (i = 0; i < n; ++i) {
     float min_dist = calc_dist(data + i * dim, centroids, dim);
@@ -110,6 +114,10 @@ void av1_k_means(const float *data, float *centroids, uint8_t *indices, int n,
     memcpy(pre_indices, indices, sizeof(pre_indices[0]) * n);
 
     calc_centroids(data, centroids, indices, n, k, dim);
+    // Unchanged centroids give unchanged indices, so stop before computing
+    // them again.
+    if (!memcmp(centroids, pre_centroids, sizeof(pre_centroids[0]) * k * dim))
+      break;
     av1_calc_indices(data, centroids, indices, n, k, dim);
     this_dist = calc_total_dist(data, centroids, indices, n, k, dim);
 
@@ -118,9 +126,89 @@ void av1_k_means(const float *data, float *centroids, uint8_t *indices, int n,
       memcpy(indices, pre_indices, sizeof(pre_indices[0]) * n);
       break;
     }
-    if (!memcmp(centroids, pre_centroids, sizeof(pre_centroids[0]) * k * dim))
+  }
+}
+
+// Assigns each color of 'hist' to its nearest centroid, and returns the total
+// squared distance over all the pixels.
+static int64_t calc_hist_indices(const PALETTE_COLOR_HIST *hist,
+                                 const int *centroids, uint8_t *indices,
+                                 int k) {
+  int64_t dist = 0;
+  int i, j;
+
+  for (i = 0; i < hist->num_colors; ++i) {
+    const int val = hist->colors[i];
+    int min_dist = (val - centroids[0]) * (val - centroids[0]);
+    indices[i] = 0;
+    for (j = 1; j < k; ++j) {
+      const int this_dist = (val - centroids[j]) * (val - centroids[j]);
+      if (this_dist < min_dist) {
+        min_dist = this_dist;
+        indices[i] = j;
+      }
+    }
+    dist += (int64_t)min_dist * hist->counts[i];
+  }
+  return dist;
+}
+
+static void calc_hist_centroids(const PALETTE_COLOR_HIST *hist, int *centroids,
+                                const uint8_t *indices, int k) {
+  int64_t sum[PALETTE_MAX_SIZE];
+  int count[PALETTE_MAX_SIZE];
+  unsigned int rand_state = hist->colors[0];
+  int i;
+
+  memset(sum, 0, sizeof(sum[0]) * k);
+  memset(count, 0, sizeof(count[0]) * k);
+
+  for (i = 0; i < hist->num_colors; ++i) {
+    assert(indices[i] < k);
+    sum[indices[i]] += (int64_t)hist->colors[i] * hist->counts[i];
+    count[indices[i]] += hist->counts[i];
+  }
+
+  for (i = 0; i < k; ++i) {
+    if (count[i] == 0) {
+      centroids[i] = hist->colors[lcg_rand16(&rand_state) % hist->num_colors];
+    } else {
+      // Round to nearest integers.
+      centroids[i] = (int)((2 * sum[i] + count[i]) / (2 * count[i]));
+    }
+  }
+}
+
+void av1_k_means_hist(const PALETTE_COLOR_HIST *hist, float *centroids, int k,
+                      int max_itr) {
+  int i;
+  int64_t this_dist;
+  int cur_centroids[PALETTE_MAX_SIZE];
+  int pre_centroids[PALETTE_MAX_SIZE];
+  uint8_t indices[PALETTE_MAX_HIST_COLORS];
+
+  assert(hist->num_colors > 0 && hist->num_colors <= PALETTE_MAX_HIST_COLORS);
+  assert(k <= PALETTE_MAX_SIZE);
+
+  for (i = 0; i < k; ++i) cur_centroids[i] = (int)roundf(centroids[i]);
+  this_dist = calc_hist_indices(hist, cur_centroids, indices, k);
+
+  for (i = 0; i < max_itr; ++i) {
+    const int64_t pre_dist = this_dist;
+    memcpy(pre_centroids, cur_centroids, sizeof(pre_centroids[0]) * k);
+
+    calc_hist_centroids(hist, cur_centroids, indices, k);
+    if (!memcmp(cur_centroids, pre_centroids, sizeof(pre_centroids[0]) * k))
       break;
+    this_dist = calc_hist_indices(hist, cur_centroids, indices, k);
+
+    if (this_dist > pre_dist) {
+      memcpy(cur_centroids, pre_centroids, sizeof(pre_centroids[0]) * k);
+      break;
+    }
   }
+
+  for (i = 0; i < k; ++i) centroids[i] = (float)cur_centroids[i];
 }
 
 static int float_comparer(const void *a, const void *b) {
@@ -164,7 +252,57 @@ int av1_count_colors(const uint8_t *src, int stride, int rows, int cols) {
   return n;
 }
 
+int av1_calc_color_hist(const uint8_t *src, int stride, int rows, int cols,
+                        PALETTE_COLOR_HIST *hist) {
+  int n = 0, r, c, i, val_count[256];
+  memset(val_count, 0, sizeof(val_count));
+
+  for (r = 0; r < rows; ++r) {
+    for (c = 0; c < cols; ++c) ++val_count[src[r * stride + c]];
+  }
+
+  for (i = 0; i < 256; ++i) {
+    if (val_count[i]) {
+      if (n < PALETTE_MAX_HIST_COLORS) {
+        hist->colors[n] = i;
+        hist->counts[n] = val_count[i];
+      }
+      ++n;
+    }
+  }
+
+  hist->num_colors = n;
+  return n;
+}
+
 #if CONFIG_AOM_HIGHBITDEPTH
+int av1_calc_color_hist_highbd(const uint8_t *src8, int stride, int rows,
+                               int cols, int bit_depth,
+                               PALETTE_COLOR_HIST *hist) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  int n = 0, r, c, i;
+  int val_count[1 << 12];
+
+  assert(bit_depth <= 12);
+  memset(val_count, 0, (1 << 12) * sizeof(val_count[0]));
+  for (r = 0; r < rows; ++r) {
+    for (c = 0; c < cols; ++c) ++val_count[src[r * stride + c]];
+  }
+
+  for (i = 0; i < (1 << bit_depth); ++i) {
+    if (val_count[i]) {
+      if (n < PALETTE_MAX_HIST_COLORS) {
+        hist->colors[n] = i;
+        hist->counts[n] = val_count[i];
+      }
+      ++n;
+    }
+  }
+
+  hist->num_colors = n;
+  return n;
+}
+
 int av1_count_colors_highbd(const uint8_t *src8, int stride, int rows, int cols,
                             int bit_depth) {
   int n = 0, r, c, i;
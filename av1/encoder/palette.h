@@ -18,10 +18,19 @@
 extern "C" {
 #endif
 
-// Given 'n' 'data' points and 'k' 'centroids' each of dimension 'dim',
-// calculate the centroid 'indices' for the data points.
-void av1_calc_indices(const float *data, const float *centroids,
-                      uint8_t *indices, int n, int k, int dim);
+// Blocks with more colors than this are not palette candidates, so their
+// color histograms are not kept.
+#define PALETTE_MAX_HIST_COLORS 64
+
+// The distinct colors of a block in increasing order, and the number of
+// pixels of each color.
+typedef struct {
+  // Number of distinct colors. 'colors' and 'counts' are only filled in when
+  // this is at most PALETTE_MAX_HIST_COLORS.
+  int num_colors;
+  uint16_t colors[PALETTE_MAX_HIST_COLORS];
+  int counts[PALETTE_MAX_HIST_COLORS];
+} PALETTE_COLOR_HIST;
 
 // Given 'n' 'data' points and an initial guess of 'k' 'centroids' each of
 // dimension 'dim', runs up to 'max_itr' iterations of k-means algorithm to get
@@ -36,6 +45,12 @@ void av1_k_means(const float *data, float *centroids, uint8_t *indices, int n,
 // method.
 int av1_remove_duplicates(float *centroids, int num_centroids);
 
+// Same as av1_k_means() with 'dim' 1, but clusters the colors of 'hist'
+// weighted by their counts rather than every pixel, and only outputs the
+// 'centroids'.
+void av1_k_means_hist(const PALETTE_COLOR_HIST *hist, float *centroids, int k,
+                      int max_itr);
+
 // Returns the number of colors in 'src'.
 int av1_count_colors(const uint8_t *src, int stride, int rows, int cols);
 #if CONFIG_AOM_HIGHBITDEPTH
@@ -44,6 +59,16 @@ int av1_count_colors_highbd(const uint8_t *src8, int stride, int rows, int cols,
                             int bit_depth);
 #endif  // CONFIG_AOM_HIGHBITDEPTH
 
+// Same as av1_count_colors(), and also fills in the color histogram 'hist'.
+int av1_calc_color_hist(const uint8_t *src, int stride, int rows, int cols,
+                        PALETTE_COLOR_HIST *hist);
+#if CONFIG_AOM_HIGHBITDEPTH
+// Same as av1_calc_color_hist(), but for high-bitdepth mode.
+int av1_calc_color_hist_highbd(const uint8_t *src8, int stride, int rows,
+                               int cols, int bit_depth,
+                               PALETTE_COLOR_HIST *hist);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
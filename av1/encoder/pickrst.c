@@ -15,6 +15,7 @@
 #include <math.h>
 
 #include "./aom_scale_rtcd.h"
+#include "./av1_rtcd.h"
 
 #include "aom_dsp/psnr.h"
 #include "aom_dsp/aom_dsp_common.h"
@@ -30,8 +31,9 @@
 #include "av1/encoder/picklpf.h"
 #include "av1/encoder/pickrst.h"
 
+// tile_sse holds the SSE of each luma tile of the unrestored frame.
 typedef double (*search_restore_type)(const YV12_BUFFER_CONFIG *src,
-                                      AV1_COMP *cpi, int filter_level,
+                                      AV1_COMP *cpi, const int64_t *tile_sse,
                                       int partial_frame, RestorationInfo *info,
                                       RestorationType *rest_level,
                                       double *best_tile_cost,
@@ -138,8 +140,17 @@ static int64_t try_restoration_tile(const YV12_BUFFER_CONFIG *src,
                                &nhtiles, &nvtiles);
   (void)ntiles;
 
-  av1_loop_restoration_frame(cm->frame_to_show, cm, rsi, components_pattern,
-                             partial_frame, dst_frame);
+  if (partial_frame) {
+    av1_loop_restoration_frame(cm->frame_to_show, cm, rsi, components_pattern,
+                               partial_frame, dst_frame);
+  } else {
+    // Only the tile is measured, so only the tile is restored. The filters
+    // read the frame around the tile but never write outside it.
+    assert(subtile_bits == 0);
+    av1_loop_restoration_tile(cm->frame_to_show, cm, rsi,
+                              get_msb(components_pattern), tile_idx,
+                              cm->rst_internal.tmpbuf, dst_frame);
+  }
   av1_get_rest_tile_limits(tile_idx, subtile_idx, subtile_bits, nhtiles,
                            nvtiles, tile_width, tile_height, width, height, 0,
                            0, &h_start, &h_end, &v_start, &v_end);
@@ -161,11 +172,15 @@ static int64_t try_restoration_frame(const YV12_BUFFER_CONFIG *src,
   return filt_err;
 }
 
+// Returns the error of the projection on every step-th row and column. The
+// sum stops once it exceeds bound, as the caller only needs to know that the
+// candidate lost.
 static int64_t get_pixel_proj_error(uint8_t *src8, int width, int height,
                                     int src_stride, uint8_t *dat8,
                                     int dat_stride, int bit_depth,
                                     int32_t *flt1, int flt1_stride,
-                                    int32_t *flt2, int flt2_stride, int *xqd) {
+                                    int32_t *flt2, int flt2_stride, int *xqd,
+                                    int step, int64_t bound) {
   int i, j;
   int64_t err = 0;
   int xq[2];
@@ -173,8 +188,8 @@ static int64_t get_pixel_proj_error(uint8_t *src8, int width, int height,
   if (bit_depth == 8) {
     const uint8_t *src = src8;
     const uint8_t *dat = dat8;
-    for (i = 0; i < height; ++i) {
-      for (j = 0; j < width; ++j) {
+    for (i = 0; i < height && err <= bound; i += step) {
+      for (j = 0; j < width; j += step) {
         const int32_t u =
             (int32_t)(dat[i * dat_stride + j] << SGRPROJ_RST_BITS);
         const int32_t f1 = (int32_t)flt1[i * flt1_stride + j] - u;
@@ -189,8 +204,8 @@ static int64_t get_pixel_proj_error(uint8_t *src8, int width, int height,
   } else {
     const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
     const uint16_t *dat = CONVERT_TO_SHORTPTR(dat8);
-    for (i = 0; i < height; ++i) {
-      for (j = 0; j < width; ++j) {
+    for (i = 0; i < height && err <= bound; i += step) {
+      for (j = 0; j < width; j += step) {
         const int32_t u =
             (int32_t)(dat[i * dat_stride + j] << SGRPROJ_RST_BITS);
         const int32_t f1 = (int32_t)flt1[i * flt1_stride + j] - u;
@@ -209,21 +224,22 @@ static int64_t get_pixel_proj_error(uint8_t *src8, int width, int height,
 static void get_proj_subspace(uint8_t *src8, int width, int height,
                               int src_stride, uint8_t *dat8, int dat_stride,
                               int bit_depth, int32_t *flt1, int flt1_stride,
-                              int32_t *flt2, int flt2_stride, int *xq) {
+                              int32_t *flt2, int flt2_stride, int step,
+                              int *xq) {
   int i, j;
   double H[2][2] = { { 0, 0 }, { 0, 0 } };
   double C[2] = { 0, 0 };
   double Det;
   double x[2];
-  const int size = width * height;
+  const int size = ((width + step - 1) / step) * ((height + step - 1) / step);
 
   xq[0] = -(1 << SGRPROJ_PRJ_BITS) / 4;
   xq[1] = (1 << SGRPROJ_PRJ_BITS) - xq[0];
   if (bit_depth == 8) {
     const uint8_t *src = src8;
     const uint8_t *dat = dat8;
-    for (i = 0; i < height; ++i) {
-      for (j = 0; j < width; ++j) {
+    for (i = 0; i < height; i += step) {
+      for (j = 0; j < width; j += step) {
         const double u = (double)(dat[i * dat_stride + j] << SGRPROJ_RST_BITS);
         const double s =
             (double)(src[i * src_stride + j] << SGRPROJ_RST_BITS) - u;
@@ -239,8 +255,8 @@ static void get_proj_subspace(uint8_t *src8, int width, int height,
   } else {
     const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
     const uint16_t *dat = CONVERT_TO_SHORTPTR(dat8);
-    for (i = 0; i < height; ++i) {
-      for (j = 0; j < width; ++j) {
+    for (i = 0; i < height; i += step) {
+      for (j = 0; j < width; j += step) {
         const double u = (double)(dat[i * dat_stride + j] << SGRPROJ_RST_BITS);
         const double s =
             (double)(src[i * src_stride + j] << SGRPROJ_RST_BITS) - u;
@@ -275,19 +291,28 @@ void encode_xq(int *xq, int *xqd) {
   xqd[1] = clamp(xqd[1], SGRPROJ_PRJ_MIN1, SGRPROJ_PRJ_MAX1);
 }
 
+// In the fast mode the parameters are fitted and compared on every other row
+// and column. The parameter sets with the same radii are ordered by
+// increasing eps, and once the error grows along such a run the rest of the
+// run is skipped.
 static void search_selfguided_restoration(uint8_t *dat8, int width, int height,
                                           int dat_stride, uint8_t *src8,
                                           int src_stride, int bit_depth,
-                                          int *eps, int *xqd, int32_t *rstbuf) {
+                                          int fast, int *eps, int *xqd,
+                                          int32_t *rstbuf) {
   int32_t *flt1 = rstbuf;
   int32_t *flt2 = flt1 + RESTORATION_TILEPELS_MAX;
   int32_t *tmpbuf2 = flt2 + RESTORATION_TILEPELS_MAX;
+  const int step = fast ? 2 : 1;
   int i, j, ep, bestep = 0;
-  int64_t err, besterr = -1;
+  int64_t err, prev_err = INT64_MAX, besterr = INT64_MAX;
+  int prev_exact = 0;
   int exqd[2], bestxqd[2] = { 0, 0 };
+  int skip_r1 = -1, skip_r2 = -1;
 
   for (ep = 0; ep < SGRPROJ_PARAMS; ep++) {
     int exq[2];
+    if (sgr_params[ep].r1 == skip_r1 && sgr_params[ep].r2 == skip_r2) continue;
     if (bit_depth > 8) {
       uint16_t *dat = CONVERT_TO_SHORTPTR(dat8);
       for (i = 0; i < height; ++i) {
@@ -312,12 +337,24 @@ static void search_selfguided_restoration(uint8_t *dat8, int width, int height,
     av1_selfguided_restoration(flt2, width, height, width, bit_depth,
                                sgr_params[ep].r2, sgr_params[ep].e2, tmpbuf2);
     get_proj_subspace(src8, width, height, src_stride, dat8, dat_stride,
-                      bit_depth, flt1, width, flt2, width, exq);
+                      bit_depth, flt1, width, flt2, width, step, exq);
     encode_xq(exq, exqd);
-    err =
-        get_pixel_proj_error(src8, width, height, src_stride, dat8, dat_stride,
-                             bit_depth, flt1, width, flt2, width, exqd);
-    if (besterr == -1 || err < besterr) {
+    // The sum stops once it exceeds besterr, so a larger error is only a
+    // lower bound of the full sum.
+    err = get_pixel_proj_error(src8, width, height, src_stride, dat8,
+                               dat_stride, bit_depth, flt1, width, flt2, width,
+                               exqd, step, besterr);
+    // A lower bound above the full error of the previous set shows the error
+    // grows, but nothing can be told from two lower bounds.
+    if (fast && ep > 0 && sgr_params[ep].r1 == sgr_params[ep - 1].r1 &&
+        sgr_params[ep].r2 == sgr_params[ep - 1].r2 && prev_exact &&
+        err > prev_err) {
+      skip_r1 = sgr_params[ep].r1;
+      skip_r2 = sgr_params[ep].r2;
+    }
+    prev_exact = err <= besterr;
+    prev_err = err;
+    if (ep == 0 || err < besterr) {
       bestep = ep;
       besterr = err;
       bestxqd[0] = exqd[0];
@@ -330,7 +367,7 @@ static void search_selfguided_restoration(uint8_t *dat8, int width, int height,
 }
 
 static double search_sgrproj(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
-                             int filter_level, int partial_frame,
+                             const int64_t *tile_sse, int partial_frame,
                              RestorationInfo *info, RestorationType *type,
                              double *best_tile_cost,
                              YV12_BUFFER_CONFIG *dst_frame) {
@@ -346,12 +383,6 @@ static double search_sgrproj(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   // Allocate for the src buffer at high precision
   const int ntiles = av1_get_rest_ntiles(cm->width, cm->height, &tile_width,
                                          &tile_height, &nhtiles, &nvtiles);
-  //  Make a copy of the unfiltered / processed recon buffer
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_uf);
-  av1_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filter_level,
-                        1, partial_frame);
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_db);
-
   rsi->frame_restoration_type = RESTORE_SGRPROJ;
 
   for (tile_idx = 0; tile_idx < ntiles; ++tile_idx) {
@@ -362,8 +393,7 @@ static double search_sgrproj(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
     av1_get_rest_tile_limits(tile_idx, 0, 0, nhtiles, nvtiles, tile_width,
                              tile_height, cm->width, cm->height, 0, 0, &h_start,
                              &h_end, &v_start, &v_end);
-    err = sse_restoration_tile(src, cm->frame_to_show, cm, h_start,
-                               h_end - h_start, v_start, v_end - v_start, 1);
+    err = tile_sse[tile_idx];
     // #bits when a tile is not restored
     bits = av1_cost_bit(RESTORE_NONE_SGRPROJ_PROB, 0);
     cost_norestore = RDCOST_DBL(x->rdmult, x->rddiv, (bits >> 4), err);
@@ -377,8 +407,8 @@ static double search_sgrproj(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
 #else
         8,
 #endif  // CONFIG_AOM_HIGHBITDEPTH
-        &rsi->sgrproj_info[tile_idx].ep, rsi->sgrproj_info[tile_idx].xqd,
-        cm->rst_internal.tmpbuf);
+        cpi->sf.fast_restoration_search, &rsi->sgrproj_info[tile_idx].ep,
+        rsi->sgrproj_info[tile_idx].xqd, cm->rst_internal.tmpbuf);
     rsi->restoration_type[tile_idx] = RESTORE_SGRPROJ;
     err = try_restoration_tile(src, cpi, rsi, 1, partial_frame, tile_idx, 0, 0,
                                dst_frame);
@@ -414,16 +444,18 @@ static double search_sgrproj(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   err = try_restoration_frame(src, cpi, rsi, 1, partial_frame, dst_frame);
   cost_sgrproj = RDCOST_DBL(x->rdmult, x->rddiv, (bits >> 4), err);
 
-  aom_yv12_copy_y(&cpi->last_frame_uf, cm->frame_to_show);
   return cost_sgrproj;
 }
 
+// Returns the SSE on every step-th row and column, stopping once it exceeds
+// bound.
 static int64_t compute_sse(uint8_t *dgd, int width, int height, int dgd_stride,
-                           uint8_t *src, int src_stride) {
+                           uint8_t *src, int src_stride, int step,
+                           int64_t bound) {
   int64_t sse = 0;
   int i, j;
-  for (i = 0; i < height; ++i) {
-    for (j = 0; j < width; ++j) {
+  for (i = 0; i < height && sse <= bound; i += step) {
+    for (j = 0; j < width; j += step) {
       const int diff =
           (int)dgd[i * dgd_stride + j] - (int)src[i * src_stride + j];
       sse += diff * diff;
@@ -434,12 +466,12 @@ static int64_t compute_sse(uint8_t *dgd, int width, int height, int dgd_stride,
 
 #if CONFIG_AOM_HIGHBITDEPTH
 static int64_t compute_sse_highbd(uint16_t *dgd, int width, int height,
-                                  int dgd_stride, uint16_t *src,
-                                  int src_stride) {
+                                  int dgd_stride, uint16_t *src, int src_stride,
+                                  int step, int64_t bound) {
   int64_t sse = 0;
   int i, j;
-  for (i = 0; i < height; ++i) {
-    for (j = 0; j < width; ++j) {
+  for (i = 0; i < height && sse <= bound; i += step) {
+    for (j = 0; j < width; j += step) {
       const int diff =
           (int)dgd[i * dgd_stride + j] - (int)src[i * src_stride + j];
       sse += diff * diff;
@@ -452,8 +484,10 @@ static int64_t compute_sse_highbd(uint16_t *dgd, int width, int height,
 static void search_domaintxfmrf_restoration(uint8_t *dgd8, int width,
                                             int height, int dgd_stride,
                                             uint8_t *src8, int src_stride,
-                                            int bit_depth, int *sigma_r,
-                                            uint8_t *fltbuf, int32_t *tmpbuf) {
+                                            int bit_depth, int fast,
+                                            int *sigma_r, uint8_t *fltbuf,
+                                            int32_t *tmpbuf) {
+  const int step = fast ? 2 : 1;
   const int first_p_step = 8;
   const int second_p_range = first_p_step >> 1;
   const int second_p_step = 2;
@@ -469,7 +503,8 @@ static void search_domaintxfmrf_restoration(uint8_t *dgd8, int width,
     for (p = first_p_step / 2; p < DOMAINTXFMRF_PARAMS; p += first_p_step) {
       av1_domaintxfmrf_restoration(dgd, width, height, dgd_stride, p, flt,
                                    width, tmpbuf);
-      sse = compute_sse(flt, width, height, width, src, src_stride);
+      sse = compute_sse(flt, width, height, width, src, src_stride, step,
+                        best_sse);
       if (sse < best_sse || best_p == -1) {
         best_p = p;
         best_sse = sse;
@@ -482,7 +517,8 @@ static void search_domaintxfmrf_restoration(uint8_t *dgd8, int width,
       if (p < 0 || p == best_p || p >= DOMAINTXFMRF_PARAMS) continue;
       av1_domaintxfmrf_restoration(dgd, width, height, dgd_stride, p, flt,
                                    width, tmpbuf);
-      sse = compute_sse(flt, width, height, width, src, src_stride);
+      sse = compute_sse(flt, width, height, width, src, src_stride, step,
+                        best_sse);
       if (sse < best_sse) {
         best_p = p;
         best_sse = sse;
@@ -495,7 +531,8 @@ static void search_domaintxfmrf_restoration(uint8_t *dgd8, int width,
       if (p < 0 || p == best_p || p >= DOMAINTXFMRF_PARAMS) continue;
       av1_domaintxfmrf_restoration(dgd, width, height, dgd_stride, p, flt,
                                    width, tmpbuf);
-      sse = compute_sse(flt, width, height, width, src, src_stride);
+      sse = compute_sse(flt, width, height, width, src, src_stride, step,
+                        best_sse);
       if (sse < best_sse) {
         best_p = p;
         best_sse = sse;
@@ -510,7 +547,8 @@ static void search_domaintxfmrf_restoration(uint8_t *dgd8, int width,
     for (p = first_p_step / 2; p < DOMAINTXFMRF_PARAMS; p += first_p_step) {
       av1_domaintxfmrf_restoration_highbd(dgd, width, height, dgd_stride, p,
                                           bit_depth, flt, width, tmpbuf);
-      sse = compute_sse_highbd(flt, width, height, width, src, src_stride);
+      sse = compute_sse_highbd(flt, width, height, width, src, src_stride,
+                               step, best_sse);
       if (sse < best_sse || best_p == -1) {
         best_p = p;
         best_sse = sse;
@@ -523,7 +561,8 @@ static void search_domaintxfmrf_restoration(uint8_t *dgd8, int width,
       if (p < 0 || p == best_p || p >= DOMAINTXFMRF_PARAMS) continue;
       av1_domaintxfmrf_restoration_highbd(dgd, width, height, dgd_stride, p,
                                           bit_depth, flt, width, tmpbuf);
-      sse = compute_sse_highbd(flt, width, height, width, src, src_stride);
+      sse = compute_sse_highbd(flt, width, height, width, src, src_stride,
+                               step, best_sse);
       if (sse < best_sse) {
         best_p = p;
         best_sse = sse;
@@ -536,7 +575,8 @@ static void search_domaintxfmrf_restoration(uint8_t *dgd8, int width,
       if (p < 0 || p == best_p || p >= DOMAINTXFMRF_PARAMS) continue;
       av1_domaintxfmrf_restoration_highbd(dgd, width, height, dgd_stride, p,
                                           bit_depth, flt, width, tmpbuf);
-      sse = compute_sse_highbd(flt, width, height, width, src, src_stride);
+      sse = compute_sse_highbd(flt, width, height, width, src, src_stride,
+                               step, best_sse);
       if (sse < best_sse) {
         best_p = p;
         best_sse = sse;
@@ -550,7 +590,7 @@ static void search_domaintxfmrf_restoration(uint8_t *dgd8, int width,
 }
 
 static double search_domaintxfmrf(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
-                                  int filter_level, int partial_frame,
+                                  const int64_t *tile_sse, int partial_frame,
                                   RestorationInfo *info, RestorationType *type,
                                   double *best_tile_cost,
                                   YV12_BUFFER_CONFIG *dst_frame) {
@@ -566,12 +606,6 @@ static double search_domaintxfmrf(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   int h_start, h_end, v_start, v_end;
   const int ntiles = av1_get_rest_ntiles(cm->width, cm->height, &tile_width,
                                          &tile_height, &nhtiles, &nvtiles);
-  //  Make a copy of the unfiltered / processed recon buffer
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_uf);
-  av1_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filter_level,
-                        1, partial_frame);
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_db);
-
   rsi->frame_restoration_type = RESTORE_DOMAINTXFMRF;
 
   for (tile_idx = 0; tile_idx < ntiles; ++tile_idx) {
@@ -582,8 +616,7 @@ static double search_domaintxfmrf(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
     av1_get_rest_tile_limits(tile_idx, 0, 0, nhtiles, nvtiles, tile_width,
                              tile_height, cm->width, cm->height, 0, 0, &h_start,
                              &h_end, &v_start, &v_end);
-    err = sse_restoration_tile(src, cm->frame_to_show, cm, h_start,
-                               h_end - h_start, v_start, v_end - v_start, 1);
+    err = tile_sse[tile_idx];
     // #bits when a tile is not restored
     bits = av1_cost_bit(RESTORE_NONE_DOMAINTXFMRF_PROB, 0);
     cost_norestore = RDCOST_DBL(x->rdmult, x->rddiv, (bits >> 4), err);
@@ -598,6 +631,7 @@ static double search_domaintxfmrf(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
 #else
         8,
 #endif  // CONFIG_AOM_HIGHBITDEPTH
+        cpi->sf.fast_restoration_search,
         &rsi->domaintxfmrf_info[tile_idx].sigma_r, cpi->extra_rstbuf,
         cm->rst_internal.tmpbuf);
 
@@ -637,112 +671,189 @@ static double search_domaintxfmrf(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   err = try_restoration_frame(src, cpi, rsi, 1, partial_frame, dst_frame);
   cost_domaintxfmrf = RDCOST_DBL(x->rdmult, x->rddiv, (bits >> 4), err);
 
-  aom_yv12_copy_y(&cpi->last_frame_uf, cm->frame_to_show);
   return cost_domaintxfmrf;
 }
 
-static double find_average(uint8_t *src, int h_start, int h_end, int v_start,
-                           int v_end, int stride) {
-  uint64_t sum = 0;
-  double avg = 0;
+int64_t av1_wiener_corr_c(const uint8_t *a, int a_stride, const uint8_t *b,
+                          int b_stride, int width, int height) {
+  int64_t sum = 0;
   int i, j;
-  for (i = v_start; i < v_end; i++)
-    for (j = h_start; j < h_end; j++) sum += src[i * stride + j];
-  avg = (double)sum / ((v_end - v_start) * (h_end - h_start));
-  return avg;
+  for (i = 0; i < height; ++i)
+    for (j = 0; j < width; ++j) sum += a[i * a_stride + j] * b[i * b_stride + j];
+  return sum;
 }
 
-static void compute_stats(uint8_t *dgd, uint8_t *src, int h_start, int h_end,
-                          int v_start, int v_end, int dgd_stride,
-                          int src_stride, double *M, double *H) {
-  int i, j, k, l;
-  double Y[WIENER_WIN2];
-  const double avg =
-      find_average(dgd, h_start, h_end, v_start, v_end, dgd_stride);
-
-  memset(M, 0, sizeof(*M) * WIENER_WIN2);
-  memset(H, 0, sizeof(*H) * WIENER_WIN2 * WIENER_WIN2);
-  for (i = v_start; i < v_end; i++) {
-    for (j = h_start; j < h_end; j++) {
-      const double X = (double)src[i * src_stride + j] - avg;
-      int idx = 0;
-      for (k = -WIENER_HALFWIN; k <= WIENER_HALFWIN; k++) {
-        for (l = -WIENER_HALFWIN; l <= WIENER_HALFWIN; l++) {
-          Y[idx] = (double)dgd[(i + l) * dgd_stride + (j + k)] - avg;
-          idx++;
-        }
-      }
-      for (k = 0; k < WIENER_WIN2; ++k) {
-        M[k] += Y[k] * X;
-        H[k * WIENER_WIN2 + k] += Y[k] * Y[k];
-        for (l = k + 1; l < WIENER_WIN2; ++l) {
-          // H is a symmetric matrix, so we only need to fill out the upper
-          // triangle here. We can copy it down to the lower triangle outside
-          // the (i, j) loops.
-          H[k * WIENER_WIN2 + l] += Y[k] * Y[l];
-        }
+#if CONFIG_AOM_HIGHBITDEPTH
+int64_t av1_highbd_wiener_corr_c(const uint8_t *a8, int a_stride,
+                                 const uint8_t *b8, int b_stride, int width,
+                                 int height) {
+  const uint16_t *const a = CONVERT_TO_SHORTPTR(a8);
+  const uint16_t *const b = CONVERT_TO_SHORTPTR(b8);
+  int64_t sum = 0;
+  int i, j;
+  for (i = 0; i < height; ++i)
+    for (j = 0; j < width; ++j)
+      sum += (int64_t)a[i * a_stride + j] * b[i * b_stride + j];
+  return sum;
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+typedef int64_t (*wiener_corr_fn)(const uint8_t *a, int a_stride,
+                                  const uint8_t *b, int b_stride, int width,
+                                  int height);
+
+static int64_t block_sum(const uint8_t *p, int stride, int w, int h,
+                         int highbd) {
+  int64_t sum = 0;
+  int i, j;
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (highbd) {
+    const uint16_t *const p16 = CONVERT_TO_SHORTPTR(p);
+    for (i = 0; i < h; ++i)
+      for (j = 0; j < w; ++j) sum += p16[i * stride + j];
+    return sum;
+  }
+#else
+  (void)highbd;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  for (i = 0; i < h; ++i)
+    for (j = 0; j < w; ++j) sum += p[i * stride + j];
+  return sum;
+}
+
+// Sums of the w x h tile at dgd shifted by each tap offset of the Wiener
+// window, at sums[k * WIENER_WIN + l] for column k and row l of the window.
+static void window_sums(const uint8_t *dgd, int stride, int w, int h,
+                        int highbd, int64_t *sums) {
+  int64_t row[WIENER_WIN];
+  int i, k, l;
+  memset(sums, 0, sizeof(*sums) * WIENER_WIN2);
+  for (i = -WIENER_HALFWIN; i < h + WIENER_HALFWIN; ++i) {
+    const uint8_t *const p = dgd + i * stride - WIENER_HALFWIN;
+    row[0] = block_sum(p, stride, w, 1, highbd);
+    for (k = 1; k < WIENER_WIN; ++k)
+      row[k] = row[k - 1] + block_sum(p + w + k - 1, stride, 1, 1, highbd) -
+               block_sum(p + k - 1, stride, 1, 1, highbd);
+    for (l = 0; l < WIENER_WIN; ++l) {
+      if (i < l - WIENER_HALFWIN || i >= l - WIENER_HALFWIN + h) continue;
+      for (k = 0; k < WIENER_WIN; ++k) sums[k * WIENER_WIN + l] += row[k];
+    }
+  }
+}
+
+// Sets out[r * nk + c] to the correlation of the w x h blocks at
+// a + r * a_stride + c and b + r * b_stride + c, for r < nl and c < nk. Only
+// the first pair of blocks is correlated in full; the others are derived from
+// a neighbour by adding the incoming and removing the outgoing column or row.
+static void sliding_corr(wiener_corr_fn corr, const uint8_t *a, int a_stride,
+                         const uint8_t *b, int b_stride, int w, int h, int nl,
+                         int nk, int64_t *out) {
+  int r, c;
+  out[0] = corr(a, a_stride, b, b_stride, w, h);
+  for (c = 1; c < nk; ++c)
+    out[c] = out[c - 1] +
+             corr(a + w + c - 1, a_stride, b + w + c - 1, b_stride, 1, h) -
+             corr(a + c - 1, a_stride, b + c - 1, b_stride, 1, h);
+  for (r = 1; r < nl; ++r) {
+    const uint8_t *const a_in = a + (h + r - 1) * a_stride;
+    const uint8_t *const b_in = b + (h + r - 1) * b_stride;
+    const uint8_t *const a_out = a + (r - 1) * a_stride;
+    const uint8_t *const b_out = b + (r - 1) * b_stride;
+    int64_t row_in = corr(a_in, a_stride, b_in, b_stride, w, 1);
+    int64_t row_out = corr(a_out, a_stride, b_out, b_stride, w, 1);
+    for (c = 0; c < nk; ++c) {
+      if (c > 0) {
+        row_in += corr(a_in + w + c - 1, a_stride, b_in + w + c - 1, b_stride,
+                       1, 1) -
+                  corr(a_in + c - 1, a_stride, b_in + c - 1, b_stride, 1, 1);
+        row_out += corr(a_out + w + c - 1, a_stride, b_out + w + c - 1,
+                        b_stride, 1, 1) -
+                   corr(a_out + c - 1, a_stride, b_out + c - 1, b_stride, 1, 1);
       }
+      out[r * nk + c] = out[(r - 1) * nk + c] + row_in - row_out;
     }
   }
-  for (k = 0; k < WIENER_WIN2; ++k) {
-    for (l = k + 1; l < WIENER_WIN2; ++l) {
-      H[l * WIENER_WIN2 + k] = H[k * WIENER_WIN2 + l];
+}
+
+// Computes the statistics of a tile for the Wiener filter search: M is the
+// cross-correlation of the source with each tap of the window on the degraded
+// frame, and H the autocorrelation of the taps, both about the mean of the
+// degraded tile.
+//
+// The raw second order moments are summed exactly in 64-bit integers by
+// av1_wiener_corr(). An entry of H only depends on the displacement between
+// its two taps, and the entries for one of the 85 distinct displacements are
+// derived from each other by sliding_corr(), so H costs 85 rather than 1225
+// multiply-adds per pixel. The mean is removed in double precision at the end,
+// so M and H match a direct floating-point accumulation up to rounding, with
+// relative differences of the order of 1e-13.
+static void compute_stats_int(const uint8_t *dgd, const uint8_t *src,
+                              int h_start, int h_end, int v_start, int v_end,
+                              int dgd_stride, int src_stride, int highbd,
+                              wiener_corr_fn corr, double *M, double *H) {
+  const int w = h_end - h_start;
+  const int h = v_end - v_start;
+  const uint8_t *const dgd_tile = dgd + v_start * dgd_stride + h_start;
+  const uint8_t *const src_tile = src + v_start * src_stride + h_start;
+  const double n = (double)w * h;
+  int64_t sums[WIENER_WIN2];
+  int64_t corrs[WIENER_WIN2];
+  double avg, src_sum, n_avg2;
+  int dl, dk, k, l;
+
+  window_sums(dgd_tile, dgd_stride, w, h, highbd, sums);
+  avg = sums[WIENER_WIN2 >> 1] / n;
+  n_avg2 = n * avg * avg;
+  src_sum = (double)block_sum(src_tile, src_stride, w, h, highbd);
+
+  for (k = 0; k < WIENER_WIN; ++k) {
+    for (l = 0; l < WIENER_WIN; ++l) {
+      const int p = k * WIENER_WIN + l;
+      const int64_t m = corr(src_tile, src_stride,
+                             dgd_tile + (l - WIENER_HALFWIN) * dgd_stride + k -
+                                 WIENER_HALFWIN,
+                             dgd_stride, w, h);
+      M[p] = m - avg * (sums[p] + src_sum) + n_avg2;
+    }
+  }
+
+  // Tap p at row l, column k of the window and tap q at row l + dl, column
+  // k + dk; H is symmetric, so dl >= 0 and dk >= 0 when dl == 0.
+  for (dl = 0; dl < WIENER_WIN; ++dl) {
+    for (dk = dl ? 1 - WIENER_WIN : 0; dk < WIENER_WIN; ++dk) {
+      const int k0 = AOMMAX(0, -dk);
+      const int nl = WIENER_WIN - dl;
+      const int nk = WIENER_WIN - (dk < 0 ? -dk : dk);
+      const uint8_t *const a =
+          dgd_tile - WIENER_HALFWIN * dgd_stride + k0 - WIENER_HALFWIN;
+      sliding_corr(corr, a, dgd_stride, a + dl * dgd_stride + dk, dgd_stride,
+                   w, h, nl, nk, corrs);
+      for (l = 0; l < nl; ++l) {
+        for (k = 0; k < nk; ++k) {
+          const int p = (k0 + k) * WIENER_WIN + l;
+          const int q = (k0 + k + dk) * WIENER_WIN + l + dl;
+          H[p * WIENER_WIN2 + q] = H[q * WIENER_WIN2 + p] =
+              corrs[l * nk + k] - avg * (sums[p] + sums[q]) + n_avg2;
+        }
+      }
     }
   }
 }
 
-#if CONFIG_AOM_HIGHBITDEPTH
-static double find_average_highbd(uint16_t *src, int h_start, int h_end,
-                                  int v_start, int v_end, int stride) {
-  uint64_t sum = 0;
-  double avg = 0;
-  int i, j;
-  for (i = v_start; i < v_end; i++)
-    for (j = h_start; j < h_end; j++) sum += src[i * stride + j];
-  avg = (double)sum / ((v_end - v_start) * (h_end - h_start));
-  return avg;
+static void compute_stats(uint8_t *dgd, uint8_t *src, int h_start, int h_end,
+                          int v_start, int v_end, int dgd_stride,
+                          int src_stride, double *M, double *H) {
+  compute_stats_int(dgd, src, h_start, h_end, v_start, v_end, dgd_stride,
+                    src_stride, 0, av1_wiener_corr, M, H);
 }
 
+#if CONFIG_AOM_HIGHBITDEPTH
 static void compute_stats_highbd(uint8_t *dgd8, uint8_t *src8, int h_start,
                                  int h_end, int v_start, int v_end,
                                  int dgd_stride, int src_stride, double *M,
                                  double *H) {
-  int i, j, k, l;
-  double Y[WIENER_WIN2];
-  uint16_t *src = CONVERT_TO_SHORTPTR(src8);
-  uint16_t *dgd = CONVERT_TO_SHORTPTR(dgd8);
-  const double avg =
-      find_average_highbd(dgd, h_start, h_end, v_start, v_end, dgd_stride);
-
-  memset(M, 0, sizeof(*M) * WIENER_WIN2);
-  memset(H, 0, sizeof(*H) * WIENER_WIN2 * WIENER_WIN2);
-  for (i = v_start; i < v_end; i++) {
-    for (j = h_start; j < h_end; j++) {
-      const double X = (double)src[i * src_stride + j] - avg;
-      int idx = 0;
-      for (k = -WIENER_HALFWIN; k <= WIENER_HALFWIN; k++) {
-        for (l = -WIENER_HALFWIN; l <= WIENER_HALFWIN; l++) {
-          Y[idx] = (double)dgd[(i + l) * dgd_stride + (j + k)] - avg;
-          idx++;
-        }
-      }
-      for (k = 0; k < WIENER_WIN2; ++k) {
-        M[k] += Y[k] * X;
-        H[k * WIENER_WIN2 + k] += Y[k] * Y[k];
-        for (l = k + 1; l < WIENER_WIN2; ++l) {
-          // H is a symmetric matrix, so we only need to fill out the upper
-          // triangle here. We can copy it down to the lower triangle outside
-          // the (i, j) loops.
-          H[k * WIENER_WIN2 + l] += Y[k] * Y[l];
-        }
-      }
-    }
-  }
-  for (k = 0; k < WIENER_WIN2; ++k) {
-    for (l = k + 1; l < WIENER_WIN2; ++l) {
-      H[l * WIENER_WIN2 + k] = H[k * WIENER_WIN2 + l];
-    }
-  }
+  compute_stats_int(dgd8, src8, h_start, h_end, v_start, v_end, dgd_stride,
+                    src_stride, 1, av1_highbd_wiener_corr, M, H);
 }
 #endif  // CONFIG_AOM_HIGHBITDEPTH
 
@@ -955,7 +1066,7 @@ static void quantize_sym_filter(double *f, InterpKernel fi) {
 }
 
 static double search_wiener_uv(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
-                               int filter_level, int partial_frame, int plane,
+                               int partial_frame, int plane,
                                RestorationInfo *info, RestorationType *type,
                                YV12_BUFFER_CONFIG *dst_frame) {
   WienerInfo *wiener_info = info->wiener_info;
@@ -981,22 +1092,15 @@ static double search_wiener_uv(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   assert(width == dgd->uv_crop_width);
   assert(height == dgd->uv_crop_height);
 
-  //  Make a copy of the unfiltered / processed recon buffer
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_uf);
-  aom_yv12_copy_u(cm->frame_to_show, &cpi->last_frame_uf);
-  aom_yv12_copy_v(cm->frame_to_show, &cpi->last_frame_uf);
-  av1_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filter_level,
-                        0, partial_frame);
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_db);
-  aom_yv12_copy_u(cm->frame_to_show, &cpi->last_frame_db);
-  aom_yv12_copy_v(cm->frame_to_show, &cpi->last_frame_db);
-
   rsi[plane].frame_restoration_type = RESTORE_NONE;
   err = sse_restoration_frame(cm, src, cm->frame_to_show, (1 << plane));
   bits = 0;
   cost_norestore_frame = RDCOST_DBL(x->rdmult, x->rddiv, (bits >> 4), err);
 
   rsi[plane].frame_restoration_type = RESTORE_WIENER;
+  // The trial restorations of single tiles read the border of the plane.
+  av1_loop_restoration_extend_rows(cm->frame_to_show, cm, rsi, plane, 0,
+                                   height);
 
   for (tile_idx = 0; tile_idx < ntiles; ++tile_idx) {
     rsi[plane].restoration_type[tile_idx] = RESTORE_NONE;
@@ -1075,7 +1179,6 @@ static double search_wiener_uv(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
     }
     rsi[plane].restoration_type[tile_idx] = RESTORE_NONE;
   }
-  aom_yv12_copy_frame(&cpi->last_frame_db, cm->frame_to_show);
   // Cost for Wiener filtering
   bits = 0;
   for (tile_idx = 0; tile_idx < ntiles; ++tile_idx) {
@@ -1098,15 +1201,12 @@ static double search_wiener_uv(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
     info->frame_restoration_type = RESTORE_NONE;
   }
 
-  aom_yv12_copy_y(&cpi->last_frame_uf, cm->frame_to_show);
-  aom_yv12_copy_u(&cpi->last_frame_uf, cm->frame_to_show);
-  aom_yv12_copy_v(&cpi->last_frame_uf, cm->frame_to_show);
   return info->frame_restoration_type == RESTORE_WIENER ? cost_wiener_frame
                                                         : cost_norestore_frame;
 }
 
 static double search_wiener(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
-                            int filter_level, int partial_frame,
+                            const int64_t *tile_sse, int partial_frame,
                             RestorationInfo *info, RestorationType *type,
                             double *best_tile_cost,
                             YV12_BUFFER_CONFIG *dst_frame) {
@@ -1135,12 +1235,6 @@ static double search_wiener(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   assert(width == src->y_crop_width);
   assert(height == src->y_crop_height);
 
-  //  Make a copy of the unfiltered / processed recon buffer
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_uf);
-  av1_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filter_level,
-                        1, partial_frame);
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_db);
-
   rsi->frame_restoration_type = RESTORE_WIENER;
 
   for (tile_idx = 0; tile_idx < ntiles; ++tile_idx) {
@@ -1161,8 +1255,7 @@ static double search_wiener(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
     av1_get_rest_tile_limits(tile_idx, 0, 0, nhtiles, nvtiles, tile_width,
                              tile_height, width, height, 0, 0, &h_start, &h_end,
                              &v_start, &v_end);
-    err = sse_restoration_tile(src, cm->frame_to_show, cm, h_start,
-                               h_end - h_start, v_start, v_end - v_start, 1);
+    err = tile_sse[tile_idx];
     // #bits when a tile is not restored
     bits = av1_cost_bit(RESTORE_NONE_WIENER_PROB, 0);
     cost_norestore = RDCOST_DBL(x->rdmult, x->rddiv, (bits >> 4), err);
@@ -1234,54 +1327,43 @@ static double search_wiener(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   err = try_restoration_frame(src, cpi, rsi, 1, partial_frame, dst_frame);
   cost_wiener = RDCOST_DBL(x->rdmult, x->rddiv, (bits >> 4), err);
 
-  aom_yv12_copy_y(&cpi->last_frame_uf, cm->frame_to_show);
   return cost_wiener;
 }
 
 static double search_norestore(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
-                               int filter_level, int partial_frame,
+                               const int64_t *tile_sse, int partial_frame,
                                RestorationInfo *info, RestorationType *type,
                                double *best_tile_cost,
                                YV12_BUFFER_CONFIG *dst_frame) {
-  double err, cost_norestore;
+  int64_t err = 0;
+  double cost_norestore;
   int bits;
   MACROBLOCK *x = &cpi->td.mb;
   AV1_COMMON *const cm = &cpi->common;
-  int tile_idx, tile_width, tile_height, nhtiles, nvtiles;
-  int h_start, h_end, v_start, v_end;
-  const int ntiles = av1_get_rest_ntiles(cm->width, cm->height, &tile_width,
-                                         &tile_height, &nhtiles, &nvtiles);
+  int tile_idx;
+  const int ntiles =
+      av1_get_rest_ntiles(cm->width, cm->height, NULL, NULL, NULL, NULL);
+  (void)src;
+  (void)partial_frame;
   (void)info;
   (void)dst_frame;
 
-  //  Make a copy of the unfiltered / processed recon buffer
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_uf);
-  av1_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filter_level,
-                        1, partial_frame);
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_db);
-
   for (tile_idx = 0; tile_idx < ntiles; ++tile_idx) {
-    av1_get_rest_tile_limits(tile_idx, 0, 0, nhtiles, nvtiles, tile_width,
-                             tile_height, cm->width, cm->height, 0, 0, &h_start,
-                             &h_end, &v_start, &v_end);
-    err = sse_restoration_tile(src, cm->frame_to_show, cm, h_start,
-                               h_end - h_start, v_start, v_end - v_start, 1);
-    best_tile_cost[tile_idx] =
-        RDCOST_DBL(x->rdmult, x->rddiv,
-                   (cpi->switchable_restore_cost[RESTORE_NONE] >> 4), err);
+    best_tile_cost[tile_idx] = RDCOST_DBL(
+        x->rdmult, x->rddiv, (cpi->switchable_restore_cost[RESTORE_NONE] >> 4),
+        tile_sse[tile_idx]);
     type[tile_idx] = RESTORE_NONE;
+    // The tiles cover the frame.
+    err += tile_sse[tile_idx];
   }
   // RD cost associated with no restoration
-  err = sse_restoration_tile(src, cm->frame_to_show, cm, 0, cm->width, 0,
-                             cm->height, 1);
   bits = frame_level_restore_bits[RESTORE_NONE] << AV1_PROB_COST_SHIFT;
   cost_norestore = RDCOST_DBL(x->rdmult, x->rddiv, (bits >> 4), err);
-  aom_yv12_copy_y(&cpi->last_frame_uf, cm->frame_to_show);
   return cost_norestore;
 }
 
 static double search_switchable_restoration(
-    AV1_COMP *cpi, int filter_level, int partial_frame, RestorationInfo *rsi,
+    AV1_COMP *cpi, RestorationInfo *rsi,
     double *tile_cost[RESTORE_SWITCHABLE_TYPES]) {
   AV1_COMMON *const cm = &cpi->common;
   MACROBLOCK *x = &cpi->td.mb;
@@ -1290,12 +1372,6 @@ static double search_switchable_restoration(
   const int ntiles =
       av1_get_rest_ntiles(cm->width, cm->height, NULL, NULL, NULL, NULL);
 
-  //  Make a copy of the unfiltered / processed recon buffer
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_uf);
-  av1_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filter_level,
-                        1, partial_frame);
-  aom_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_db);
-
   rsi->frame_restoration_type = RESTORE_SWITCHABLE;
   bits = frame_level_restore_bits[rsi->frame_restoration_type]
          << AV1_PROB_COST_SHIFT;
@@ -1311,7 +1387,6 @@ static double search_switchable_restoration(
     }
     cost_switchable += best_cost;
   }
-  aom_yv12_copy_y(&cpi->last_frame_uf, cm->frame_to_show);
   return cost_switchable;
 }
 
@@ -1325,17 +1400,22 @@ void av1_pick_filter_restoration(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   double cost_restore[RESTORE_TYPES];
   double *tile_cost[RESTORE_SWITCHABLE_TYPES];
   RestorationType *restore_types[RESTORE_SWITCHABLE_TYPES];
+  int64_t *tile_sse;
   double best_cost_restore;
   RestorationType r, best_restore;
+  const int partial_frame = method == LPF_PICK_FROM_SUBIMAGE;
+  int tile_idx, tile_width, tile_height, nhtiles, nvtiles;
+  int h_start, h_end, v_start, v_end;
 
-  const int ntiles =
-      av1_get_rest_ntiles(cm->width, cm->height, NULL, NULL, NULL, NULL);
+  const int ntiles = av1_get_rest_ntiles(cm->width, cm->height, &tile_width,
+                                         &tile_height, &nhtiles, &nvtiles);
 
   for (r = 0; r < RESTORE_SWITCHABLE_TYPES; r++) {
     tile_cost[r] = (double *)aom_malloc(sizeof(*tile_cost[0]) * ntiles);
     restore_types[r] =
         (RestorationType *)aom_malloc(sizeof(*restore_types[0]) * ntiles);
   }
+  tile_sse = (int64_t *)aom_malloc(sizeof(*tile_sse) * ntiles);
 
   lf->sharpness_level = cm->frame_type == KEY_FRAME ? 0 : cpi->oxcf.sharpness;
 
@@ -1372,19 +1452,32 @@ void av1_pick_filter_restoration(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
     if (cm->frame_type == KEY_FRAME) filt_guess -= 4;
     lf->filter_level = clamp(filt_guess, min_filter_level, max_filter_level);
   } else {
-    lf->filter_level =
-        av1_search_filter_level(src, cpi, method == LPF_PICK_FROM_SUBIMAGE,
-                                &cost_restore[RESTORE_NONE]);
+    lf->filter_level = av1_search_filter_level(src, cpi, partial_frame,
+                                               &cost_restore[RESTORE_NONE]);
   }
+
+  // All the restoration types are searched on the same deblocked frame, and
+  // share the SSE of its tiles.
+  aom_yv12_copy_frame(cm->frame_to_show, &cpi->last_frame_uf);
+  av1_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd,
+                        lf->filter_level, 0, partial_frame);
+  aom_yv12_copy_frame(cm->frame_to_show, &cpi->last_frame_db);
+  for (tile_idx = 0; tile_idx < ntiles; ++tile_idx) {
+    av1_get_rest_tile_limits(tile_idx, 0, 0, nhtiles, nvtiles, tile_width,
+                             tile_height, cm->width, cm->height, 0, 0, &h_start,
+                             &h_end, &v_start, &v_end);
+    tile_sse[tile_idx] =
+        sse_restoration_tile(src, cm->frame_to_show, cm, h_start,
+                             h_end - h_start, v_start, v_end - v_start, 1);
+  }
+
   for (r = 0; r < RESTORE_SWITCHABLE_TYPES; ++r) {
     cost_restore[r] = search_restore_fun[r](
-        src, cpi, lf->filter_level, method == LPF_PICK_FROM_SUBIMAGE,
-        &cm->rst_info[0], restore_types[r], tile_cost[r],
-        &cpi->trial_frame_rst);
+        src, cpi, tile_sse, partial_frame, &cm->rst_info[0], restore_types[r],
+        tile_cost[r], &cpi->trial_frame_rst);
   }
-  cost_restore[RESTORE_SWITCHABLE] = search_switchable_restoration(
-      cpi, lf->filter_level, method == LPF_PICK_FROM_SUBIMAGE, &cm->rst_info[0],
-      tile_cost);
+  cost_restore[RESTORE_SWITCHABLE] =
+      search_switchable_restoration(cpi, &cm->rst_info[0], tile_cost);
 
   best_cost_restore = DBL_MAX;
   best_restore = 0;
@@ -1401,14 +1494,15 @@ void av1_pick_filter_restoration(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
   }
 
   // Color components
-  search_wiener_uv(src, cpi, lf->filter_level, method == LPF_PICK_FROM_SUBIMAGE,
-                   AOM_PLANE_U, &cm->rst_info[AOM_PLANE_U],
+  search_wiener_uv(src, cpi, partial_frame, AOM_PLANE_U,
+                   &cm->rst_info[AOM_PLANE_U],
                    cm->rst_info[AOM_PLANE_U].restoration_type,
                    &cpi->trial_frame_rst);
-  search_wiener_uv(src, cpi, lf->filter_level, method == LPF_PICK_FROM_SUBIMAGE,
-                   AOM_PLANE_V, &cm->rst_info[AOM_PLANE_V],
+  search_wiener_uv(src, cpi, partial_frame, AOM_PLANE_V,
+                   &cm->rst_info[AOM_PLANE_V],
                    cm->rst_info[AOM_PLANE_V].restoration_type,
                    &cpi->trial_frame_rst);
+  aom_yv12_copy_frame(&cpi->last_frame_uf, cm->frame_to_show);
   /*
   printf("Frame %d/%d restore types: %d %d %d\n",
          cm->current_video_frame, cm->show_frame,
@@ -1428,4 +1522,5 @@ void av1_pick_filter_restoration(const YV12_BUFFER_CONFIG *src, AV1_COMP *cpi,
     aom_free(tile_cost[r]);
     aom_free(restore_types[r]);
   }
+  aom_free(tile_sse);
 }
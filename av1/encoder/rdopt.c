@@ -2311,6 +2311,31 @@ static void extend_palette_color_map(uint8_t *const color_map, int orig_width,
   }
 }
 
+// Returns the color histogram of the 'rows' x 'cols' source block of 'plane',
+// computing it only if it is not cached for the block being searched.
+static const PALETTE_COLOR_HIST *get_color_hist(const AV1_COMP *const cpi,
+                                                MACROBLOCK *x, int plane,
+                                                int rows, int cols) {
+  PALETTE_BUFFER *const palette_buffer = x->palette_buffer;
+  PALETTE_COLOR_HIST *const hist = &palette_buffer->color_hist[plane];
+  const uint8_t *const src = x->plane[plane].src.buf;
+  const int src_stride = x->plane[plane].src.stride;
+
+  if (palette_buffer->color_hist_src[plane] == src) return hist;
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (cpi->common.use_highbitdepth)
+    av1_calc_color_hist_highbd(src, src_stride, rows, cols,
+                               cpi->common.bit_depth, hist);
+  else
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+    av1_calc_color_hist(src, src_stride, rows, cols, hist);
+#if !CONFIG_AOM_HIGHBITDEPTH
+  (void)cpi;
+#endif  // !CONFIG_AOM_HIGHBITDEPTH
+  palette_buffer->color_hist_src[plane] = src;
+  return hist;
+}
+
 static int rd_pick_palette_intra_sby(const AV1_COMP *const cpi, MACROBLOCK *x,
                                      BLOCK_SIZE bsize, int palette_ctx,
                                      int dc_mode_cost, MB_MODE_INFO *best_mbmi,
@@ -2326,65 +2351,40 @@ static int rd_pick_palette_intra_sby(const AV1_COMP *const cpi, MACROBLOCK *x,
   const int src_stride = x->plane[0].src.stride;
   const uint8_t *const src = x->plane[0].src.buf;
   uint8_t *const color_map = xd->plane[0].color_index_map;
+  const PALETTE_COLOR_HIST *hist;
   int block_width, block_height, rows, cols;
   av1_get_block_dimensions(bsize, 0, xd, &block_width, &block_height, &rows,
                            &cols);
 
   assert(cpi->common.allow_screen_content_tools);
 
-#if CONFIG_AOM_HIGHBITDEPTH
-  if (cpi->common.use_highbitdepth)
-    colors = av1_count_colors_highbd(src, src_stride, rows, cols,
-                                     cpi->common.bit_depth);
-  else
-#endif  // CONFIG_AOM_HIGHBITDEPTH
-    colors = av1_count_colors(src, src_stride, rows, cols);
+  hist = get_color_hist(cpi, x, 0, rows, cols);
+  colors = hist->num_colors;
 #if CONFIG_FILTER_INTRA
   mbmi->filter_intra_mode_info.use_filter_intra_mode[0] = 0;
 #endif  // CONFIG_FILTER_INTRA
 
-  if (colors > 1 && colors <= 64) {
+  if (colors > 1 && colors <= PALETTE_MAX_HIST_COLORS) {
     int r, c, i, j, k, palette_mode_cost;
     const int max_itr = 50;
     uint8_t color_order[PALETTE_MAX_SIZE];
     float *const data = x->palette_buffer->kmeans_data_buf;
     float centroids[PALETTE_MAX_SIZE];
-    float lb, ub, val;
+    const float lb = hist->colors[0];
+    const float ub = hist->colors[colors - 1];
     RD_STATS tokenonly_rd_stats;
     int64_t this_rd, this_model_rd;
     PALETTE_MODE_INFO *const pmi = &mbmi->palette_mode_info;
 #if CONFIG_AOM_HIGHBITDEPTH
-    uint16_t *src16 = CONVERT_TO_SHORTPTR(src);
-    if (cpi->common.use_highbitdepth)
-      lb = ub = src16[0];
-    else
-#endif  // CONFIG_AOM_HIGHBITDEPTH
-      lb = ub = src[0];
-
-#if CONFIG_AOM_HIGHBITDEPTH
+    const uint16_t *src16 = CONVERT_TO_SHORTPTR(src);
     if (cpi->common.use_highbitdepth) {
-      for (r = 0; r < rows; ++r) {
-        for (c = 0; c < cols; ++c) {
-          val = src16[r * src_stride + c];
-          data[r * cols + c] = val;
-          if (val < lb)
-            lb = val;
-          else if (val > ub)
-            ub = val;
-        }
-      }
+      for (r = 0; r < rows; ++r)
+        for (c = 0; c < cols; ++c)
+          data[r * cols + c] = src16[r * src_stride + c];
     } else {
 #endif  // CONFIG_AOM_HIGHBITDEPTH
-      for (r = 0; r < rows; ++r) {
-        for (c = 0; c < cols; ++c) {
-          val = src[r * src_stride + c];
-          data[r * cols + c] = val;
-          if (val < lb)
-            lb = val;
-          else if (val > ub)
-            ub = val;
-        }
-      }
+      for (r = 0; r < rows; ++r)
+        for (c = 0; c < cols; ++c) data[r * cols + c] = src[r * src_stride + c];
 #if CONFIG_AOM_HIGHBITDEPTH
     }
 #endif  // CONFIG_AOM_HIGHBITDEPTH
@@ -2400,7 +2400,9 @@ static int rd_pick_palette_intra_sby(const AV1_COMP *const cpi, MACROBLOCK *x,
          --n) {
       for (i = 0; i < n; ++i)
         centroids[i] = lb + (2 * i + 1) * (ub - lb) / n / 2;
-      av1_k_means(data, centroids, color_map, rows * cols, n, 1, max_itr);
+      // The histogram gives the same clusters as the pixels for a fraction
+      // of the work; the indices are computed from the pixels below.
+      av1_k_means_hist(hist, centroids, n, max_itr);
       k = av1_remove_duplicates(centroids, n);
 
 #if CONFIG_AOM_HIGHBITDEPTH
@@ -4391,6 +4393,7 @@ static void rd_pick_palette_intra_sbuv(const AV1_COMP *const cpi, MACROBLOCK *x,
   int this_rate;
   int64_t this_rd;
   int colors_u, colors_v, colors;
+  const PALETTE_COLOR_HIST *hist_u, *hist_v;
   const int src_stride = x->plane[1].src.stride;
   const uint8_t *const src_u = x->plane[1].src.buf;
   const uint8_t *const src_v = x->plane[2].src.buf;
@@ -4406,73 +4409,40 @@ static void rd_pick_palette_intra_sbuv(const AV1_COMP *const cpi, MACROBLOCK *x,
   mbmi->filter_intra_mode_info.use_filter_intra_mode[1] = 0;
 #endif  // CONFIG_FILTER_INTRA
 
-#if CONFIG_AOM_HIGHBITDEPTH
-  if (cpi->common.use_highbitdepth) {
-    colors_u = av1_count_colors_highbd(src_u, src_stride, rows, cols,
-                                       cpi->common.bit_depth);
-    colors_v = av1_count_colors_highbd(src_v, src_stride, rows, cols,
-                                       cpi->common.bit_depth);
-  } else {
-#endif  // CONFIG_AOM_HIGHBITDEPTH
-    colors_u = av1_count_colors(src_u, src_stride, rows, cols);
-    colors_v = av1_count_colors(src_v, src_stride, rows, cols);
-#if CONFIG_AOM_HIGHBITDEPTH
-  }
-#endif  // CONFIG_AOM_HIGHBITDEPTH
+  hist_u = get_color_hist(cpi, x, 1, rows, cols);
+  hist_v = get_color_hist(cpi, x, 2, rows, cols);
+  colors_u = hist_u->num_colors;
+  colors_v = hist_v->num_colors;
 
   colors = colors_u > colors_v ? colors_u : colors_v;
-  if (colors > 1 && colors <= 64) {
+  if (colors > 1 && colors <= PALETTE_MAX_HIST_COLORS) {
     int r, c, n, i, j;
     const int max_itr = 50;
     uint8_t color_order[PALETTE_MAX_SIZE];
-    float lb_u, ub_u, val_u;
-    float lb_v, ub_v, val_v;
+    const float lb_u = hist_u->colors[0];
+    const float ub_u = hist_u->colors[colors_u - 1];
+    const float lb_v = hist_v->colors[0];
+    const float ub_v = hist_v->colors[colors_v - 1];
     float *const data = x->palette_buffer->kmeans_data_buf;
     float centroids[2 * PALETTE_MAX_SIZE];
 
 #if CONFIG_AOM_HIGHBITDEPTH
-    uint16_t *src_u16 = CONVERT_TO_SHORTPTR(src_u);
-    uint16_t *src_v16 = CONVERT_TO_SHORTPTR(src_v);
-    if (cpi->common.use_highbitdepth) {
-      lb_u = src_u16[0];
-      ub_u = src_u16[0];
-      lb_v = src_v16[0];
-      ub_v = src_v16[0];
-    } else {
+    const uint16_t *src_u16 = CONVERT_TO_SHORTPTR(src_u);
+    const uint16_t *src_v16 = CONVERT_TO_SHORTPTR(src_v);
 #endif  // CONFIG_AOM_HIGHBITDEPTH
-      lb_u = src_u[0];
-      ub_u = src_u[0];
-      lb_v = src_v[0];
-      ub_v = src_v[0];
-#if CONFIG_AOM_HIGHBITDEPTH
-    }
-#endif  // CONFIG_AOM_HIGHBITDEPTH
-
     for (r = 0; r < rows; ++r) {
       for (c = 0; c < cols; ++c) {
 #if CONFIG_AOM_HIGHBITDEPTH
         if (cpi->common.use_highbitdepth) {
-          val_u = src_u16[r * src_stride + c];
-          val_v = src_v16[r * src_stride + c];
-          data[(r * cols + c) * 2] = val_u;
-          data[(r * cols + c) * 2 + 1] = val_v;
+          data[(r * cols + c) * 2] = src_u16[r * src_stride + c];
+          data[(r * cols + c) * 2 + 1] = src_v16[r * src_stride + c];
         } else {
 #endif  // CONFIG_AOM_HIGHBITDEPTH
-          val_u = src_u[r * src_stride + c];
-          val_v = src_v[r * src_stride + c];
-          data[(r * cols + c) * 2] = val_u;
-          data[(r * cols + c) * 2 + 1] = val_v;
+          data[(r * cols + c) * 2] = src_u[r * src_stride + c];
+          data[(r * cols + c) * 2 + 1] = src_v[r * src_stride + c];
 #if CONFIG_AOM_HIGHBITDEPTH
         }
 #endif  // CONFIG_AOM_HIGHBITDEPTH
-        if (val_u < lb_u)
-          lb_u = val_u;
-        else if (val_u > ub_u)
-          ub_u = val_u;
-        if (val_v < lb_v)
-          lb_v = val_v;
-        else if (val_v > ub_v)
-          ub_v = val_v;
       }
     }
 
@@ -4911,7 +4881,8 @@ static int get_interinter_compound_type_bits(BLOCK_SIZE bsize,
 #endif  // CONFIG_EXT_INTER
 
 #if CONFIG_GLOBAL_MOTION
-static int GLOBAL_MOTION_RATE(const AV1_COMP *const cpi, int ref) {
+static int GLOBAL_MOTION_RATE(const AV1_COMP *const cpi,
+                              const MACROBLOCK *const x, int ref) {
   static const int gm_amortization_blks[TRANS_TYPES] = { 4, 6, 8, 10, 12 };
   static const int gm_params_cost[TRANS_TYPES] = {
     GM_IDENTITY_BITS, GM_TRANSLATION_BITS, GM_ROTZOOM_BITS,
@@ -4919,7 +4890,7 @@ static int GLOBAL_MOTION_RATE(const AV1_COMP *const cpi, int ref) {
   };
   const WarpedMotionParams *gm = &cpi->common.global_motion[(ref)];
   assert(gm->wmtype < GLOBAL_TRANS_TYPES);
-  if (cpi->global_motion_used[ref][0] >= gm_amortization_blks[gm->wmtype]) {
+  if (x->global_motion_used_ptr[ref] >= gm_amortization_blks[gm->wmtype]) {
     return 0;
   } else {
     const int cost = (gm_params_cost[gm->wmtype] << AV1_PROB_COST_SHIFT) +
@@ -4998,7 +4969,7 @@ static int set_and_cost_bmi_mvs(const AV1_COMP *const cpi, MACROBLOCK *x,
                 &cpi->common.global_motion[mbmi->ref_frame[ref]],
                 cpi->common.allow_high_precision_mv)
                 .as_int;
-        thismvcost += GLOBAL_MOTION_RATE(cpi, mbmi->ref_frame[ref]);
+        thismvcost += GLOBAL_MOTION_RATE(cpi, x, mbmi->ref_frame[ref]);
 #else
         this_mv[ref].as_int = 0;
 #endif  // CONFIG_GLOBAL_MOTION
@@ -5059,8 +5030,8 @@ static int set_and_cost_bmi_mvs(const AV1_COMP *const cpi, MACROBLOCK *x,
           gm_get_motion_vector(&cpi->common.global_motion[mbmi->ref_frame[1]],
                                cpi->common.allow_high_precision_mv)
               .as_int;
-      thismvcost += GLOBAL_MOTION_RATE(cpi, mbmi->ref_frame[0]) +
-                    GLOBAL_MOTION_RATE(cpi, mbmi->ref_frame[1]);
+      thismvcost += GLOBAL_MOTION_RATE(cpi, x, mbmi->ref_frame[0]) +
+                    GLOBAL_MOTION_RATE(cpi, x, mbmi->ref_frame[1]);
 #else
       this_mv[0].as_int = 0;
       this_mv[1].as_int = 0;
@@ -8903,9 +8874,9 @@ static int64_t handle_inter_mode(
         || this_mode == ZERO_ZEROMV
 #endif  // CONFIG_EXT_INTER
         ) {
-      rd_stats->rate += GLOBAL_MOTION_RATE(cpi, mbmi->ref_frame[0]);
+      rd_stats->rate += GLOBAL_MOTION_RATE(cpi, x, mbmi->ref_frame[0]);
       if (is_comp_pred)
-        rd_stats->rate += GLOBAL_MOTION_RATE(cpi, mbmi->ref_frame[1]);
+        rd_stats->rate += GLOBAL_MOTION_RATE(cpi, x, mbmi->ref_frame[1]);
       if (is_nontrans_global_motion(xd)) {
         rd_stats->rate -= rs;
 #if CONFIG_DUAL_FILTER
@@ -136,6 +136,9 @@ static void set_good_speed_feature(AV1_COMP *cpi, AV1_COMMON *cm,
   if (speed >= 1) {
     sf->tx_type_search.fast_intra_tx_type_search = 1;
     sf->tx_type_search.fast_inter_tx_type_search = 1;
+#if CONFIG_GLOBAL_MOTION
+    sf->gm_pyramid_level = 1;
+#endif  // CONFIG_GLOBAL_MOTION
   }
 
   if (speed >= 2) {
@@ -176,6 +179,9 @@ static void set_good_speed_feature(AV1_COMP *cpi, AV1_COMMON *cm,
     sf->disable_wedge_search_var_thresh = 100;
     sf->fast_wedge_sign_estimate = 1;
 #endif  // CONFIG_EXT_INTER
+#if CONFIG_LOOP_RESTORATION
+    sf->fast_restoration_search = 1;
+#endif  // CONFIG_LOOP_RESTORATION
   }
 
   if (speed >= 3) {
@@ -294,6 +300,12 @@ static void set_rt_speed_feature(AV1_COMP *cpi, SPEED_FEATURES *sf, int speed,
   sf->disable_wedge_search_var_thresh = 100;
   sf->fast_wedge_sign_estimate = 1;
 #endif  // CONFIG_EXT_INTER
+#if CONFIG_LOOP_RESTORATION
+  sf->fast_restoration_search = 1;
+#endif  // CONFIG_LOOP_RESTORATION
+#if CONFIG_GLOBAL_MOTION
+  sf->gm_pyramid_level = 1;
+#endif  // CONFIG_GLOBAL_MOTION
 
   // Use transform domain distortion computation
   // Note var-tx expt always uses pixel domain distortion.
@@ -532,6 +544,12 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   sf->disable_wedge_search_var_thresh = 0;
   sf->fast_wedge_sign_estimate = 0;
 #endif  // CONFIG_EXT_INTER
+#if CONFIG_LOOP_RESTORATION
+  sf->fast_restoration_search = 0;
+#endif  // CONFIG_LOOP_RESTORATION
+#if CONFIG_GLOBAL_MOTION
+  sf->gm_pyramid_level = 0;
+#endif  // CONFIG_GLOBAL_MOTION
 
   for (i = 0; i < TX_SIZES; i++) {
     sf->intra_y_mode_mask[i] = INTRA_ALL;
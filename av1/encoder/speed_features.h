@@ -472,6 +472,20 @@ typedef struct SPEED_FEATURES {
   // Whether to compute distortion in the image domain (slower but
   // more accurate), or in the transform domain (faster but less acurate).
   int use_transform_domain_distortion;
+
+#if CONFIG_LOOP_RESTORATION
+  // Evaluate the self-guided and domain transform parameters on a subsampled
+  // pixel grid, and stop scanning a family of parameter sets once the error
+  // starts to grow.
+  int fast_restoration_search;
+#endif  // CONFIG_LOOP_RESTORATION
+
+#if CONFIG_GLOBAL_MOTION
+  // Number of times the frames are halved in size before the global motion
+  // corners are found and matched. The models are still refined on the full
+  // resolution frames.
+  int gm_pyramid_level;
+#endif  // CONFIG_GLOBAL_MOTION
 } SPEED_FEATURES;
 
 struct AV1_COMP;
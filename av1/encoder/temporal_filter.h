@@ -18,6 +18,11 @@ extern "C" {
 
 void av1_temporal_filter(AV1_COMP *cpi, int distance);
 
+// Filters macroblock row 'mb_row' of the alt-ref frame described by
+// cpi->arnr_filter_data, using the macroblock of 'td' for the motion search.
+void av1_temporal_filter_iterate_row_c(AV1_COMP *cpi, ThreadData *td,
+                                       int mb_row);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
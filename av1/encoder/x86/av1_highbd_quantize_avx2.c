@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+
+// Low 32 bits of (a * m) >> shift, with the product kept in 64 bits.
+static INLINE __m256i mul_shift(__m256i a, __m256i m, const __m128i shift) {
+  const __m256i even = _mm256_srl_epi64(_mm256_mul_epi32(a, m), shift);
+  const __m256i odd = _mm256_srl_epi64(
+      _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(m, 32)),
+      shift);
+  return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+}
+
+// Quantizes eight coefficients and returns the updated eob vector, which holds
+// iscan + 1 of the last nonzero coefficient in each lane.
+static INLINE __m256i quantize_coeff(const tran_low_t *coeff_ptr,
+                                     const int16_t *iscan, const __m256i *param,
+                                     const __m128i shift, const __m128i scale,
+                                     tran_low_t *qcoeff_ptr,
+                                     tran_low_t *dqcoeff_ptr, __m256i eob) {
+  const __m256i coeff = _mm256_loadu_si256((const __m256i *)coeff_ptr);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i sign = _mm256_or_si256(_mm256_cmpgt_epi32(zero, coeff),
+                                       _mm256_set1_epi32(1));
+  const __m256i tmp = _mm256_add_epi32(_mm256_abs_epi32(coeff), param[0]);
+  const __m256i q = mul_shift(tmp, param[1], shift);
+  const __m256i dq = mul_shift(q, param[2], scale);
+  const __m256i nz =
+      _mm256_xor_si256(_mm256_cmpeq_epi32(q, zero), _mm256_set1_epi32(-1));
+  const __m256i iscan_plus1 = _mm256_sub_epi32(
+      _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)iscan)), nz);
+
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, _mm256_sign_epi32(q, sign));
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, _mm256_sign_epi32(dq, sign));
+  return _mm256_max_epi32(eob, _mm256_and_si256(iscan_plus1, nz));
+}
+
+void av1_highbd_quantize_fp_avx2(
+    const tran_low_t *coeff_ptr, intptr_t count, int skip_block,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan, int log_scale) {
+  const __m128i shift = _mm_cvtsi32_si128(16 - log_scale);
+  const __m128i scale = _mm_cvtsi32_si128(log_scale);
+  __m256i param[3], eob = _mm256_setzero_si256();
+  intptr_t i;
+  (void)zbin_ptr;
+  (void)quant_shift_ptr;
+  (void)scan;
+
+  if (skip_block) {
+    memset(qcoeff_ptr, 0, count * sizeof(qcoeff_ptr[0]));
+    memset(dqcoeff_ptr, 0, count * sizeof(dqcoeff_ptr[0]));
+    *eob_ptr = 0;
+    return;
+  }
+
+  // DC and first 7 AC
+  param[0] = _mm256_setr_epi32(round_ptr[0], round_ptr[1], round_ptr[1],
+                               round_ptr[1], round_ptr[1], round_ptr[1],
+                               round_ptr[1], round_ptr[1]);
+  param[1] = _mm256_setr_epi32(quant_ptr[0], quant_ptr[1], quant_ptr[1],
+                               quant_ptr[1], quant_ptr[1], quant_ptr[1],
+                               quant_ptr[1], quant_ptr[1]);
+  param[2] = _mm256_setr_epi32(dequant_ptr[0], dequant_ptr[1], dequant_ptr[1],
+                               dequant_ptr[1], dequant_ptr[1], dequant_ptr[1],
+                               dequant_ptr[1], dequant_ptr[1]);
+  eob = quantize_coeff(coeff_ptr, iscan, param, shift, scale, qcoeff_ptr,
+                       dqcoeff_ptr, eob);
+
+  // The rest of AC
+  param[0] = _mm256_set1_epi32(round_ptr[1]);
+  param[1] = _mm256_set1_epi32(quant_ptr[1]);
+  param[2] = _mm256_set1_epi32(dequant_ptr[1]);
+  for (i = 8; i < count; i += 8) {
+    eob = quantize_coeff(coeff_ptr + i, iscan + i, param, shift, scale,
+                         qcoeff_ptr + i, dqcoeff_ptr + i, eob);
+  }
+
+  eob = _mm256_max_epi32(eob, _mm256_permute2x128_si256(eob, eob, 0x01));
+  eob = _mm256_max_epi32(eob, _mm256_shuffle_epi32(eob, 0x4e));
+  eob = _mm256_max_epi32(eob, _mm256_shuffle_epi32(eob, 0xb1));
+  *eob_ptr = (uint16_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(eob));
+}
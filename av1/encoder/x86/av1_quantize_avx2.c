@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+#include <string.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+
+#if CONFIG_TX64X64
+static INLINE __m256i load_tran_low(const tran_low_t *ptr) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  return _mm256_loadu_si256((const __m256i *)ptr);
+#else
+  return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)ptr));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+static INLINE void store_tran_low(__m256i v, tran_low_t *ptr) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  _mm256_storeu_si256((__m256i *)ptr, v);
+#else
+  // Truncate to 16 bits like the C code does, rather than saturate
+  v = _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16);
+  v = _mm256_permute4x64_epi64(_mm256_packs_epi32(v, v), 0x08);
+  _mm_storeu_si128((__m128i *)ptr, _mm256_castsi256_si128(v));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+// The coefficients are processed in raster order, eight at a time, and the
+// eob is taken from iscan. Only the first vector holds the DC coefficient.
+void av1_quantize_fp_64x64_avx2(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max16 = _mm256_set1_epi32(INT16_MAX);
+  __m256i round = _mm256_setr_epi32(
+      ROUND_POWER_OF_TWO(round_ptr[0], 1), ROUND_POWER_OF_TWO(round_ptr[1], 1),
+      ROUND_POWER_OF_TWO(round_ptr[1], 1), ROUND_POWER_OF_TWO(round_ptr[1], 1),
+      ROUND_POWER_OF_TWO(round_ptr[1], 1), ROUND_POWER_OF_TWO(round_ptr[1], 1),
+      ROUND_POWER_OF_TWO(round_ptr[1], 1), ROUND_POWER_OF_TWO(round_ptr[1], 1));
+  __m256i quant = _mm256_setr_epi32(quant_ptr[0], quant_ptr[1], quant_ptr[1],
+                                    quant_ptr[1], quant_ptr[1], quant_ptr[1],
+                                    quant_ptr[1], quant_ptr[1]);
+  __m256i dequant = _mm256_setr_epi32(
+      dequant_ptr[0], dequant_ptr[1], dequant_ptr[1], dequant_ptr[1],
+      dequant_ptr[1], dequant_ptr[1], dequant_ptr[1], dequant_ptr[1]);
+  __m256i eob = zero;
+  intptr_t i;
+  (void)zbin_ptr;
+  (void)quant_shift_ptr;
+  (void)scan;
+
+  assert(!(n_coeffs & 7));
+
+  if (skip_block) {
+    memset(qcoeff_ptr, 0, n_coeffs * sizeof(*qcoeff_ptr));
+    memset(dqcoeff_ptr, 0, n_coeffs * sizeof(*dqcoeff_ptr));
+    *eob_ptr = 0;
+    return;
+  }
+
+  for (i = 0; i < n_coeffs; i += 8) {
+    const __m256i coeff = load_tran_low(coeff_ptr + i);
+    const __m256i sign = _mm256_srai_epi32(coeff, 31);
+    const __m256i abs_coeff = _mm256_abs_epi32(coeff);
+    // abs_coeff >= (dequant >> 3)
+    const __m256i mask = _mm256_xor_si256(
+        _mm256_cmpgt_epi32(_mm256_srai_epi32(dequant, 3), abs_coeff),
+        _mm256_set1_epi32(-1));
+    const __m256i tmp = _mm256_min_epi32(_mm256_add_epi32(abs_coeff, round),
+                                         max16);
+    __m256i q, dq, nz;
+
+    q = _mm256_srai_epi32(_mm256_mullo_epi32(tmp, quant), 15);
+    q = _mm256_and_si256(q, mask);
+    dq = _mm256_srli_epi32(_mm256_mullo_epi32(q, dequant), 2);
+
+    store_tran_low(_mm256_sub_epi32(_mm256_xor_si256(q, sign), sign),
+                   qcoeff_ptr + i);
+    store_tran_low(_mm256_sub_epi32(_mm256_xor_si256(dq, sign), sign),
+                   dqcoeff_ptr + i);
+
+    nz = _mm256_xor_si256(_mm256_cmpeq_epi32(q, zero), _mm256_set1_epi32(-1));
+    eob = _mm256_max_epi32(
+        eob, _mm256_and_si256(
+                 _mm256_sub_epi32(_mm256_cvtepi16_epi32(_mm_loadu_si128(
+                                      (const __m128i *)(iscan + i))),
+                                  nz),
+                 nz));
+
+    if (i == 0) {
+      round = _mm256_permutevar8x32_epi32(round, _mm256_set1_epi32(1));
+      quant = _mm256_permutevar8x32_epi32(quant, _mm256_set1_epi32(1));
+      dequant = _mm256_permutevar8x32_epi32(dequant, _mm256_set1_epi32(1));
+    }
+  }
+
+  eob = _mm256_max_epi32(eob, _mm256_permute2x128_si256(eob, eob, 0x01));
+  eob = _mm256_max_epi32(eob, _mm256_shuffle_epi32(eob, 0x4e));
+  eob = _mm256_max_epi32(eob, _mm256_shuffle_epi32(eob, 0xb1));
+  *eob_ptr = (uint16_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(eob));
+}
+#endif  // CONFIG_TX64X64
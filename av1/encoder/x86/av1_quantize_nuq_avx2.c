@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/bitops.h"
+#include "aom_ports/mem.h"
+#include "av1/common/entropy.h"
+#include "av1/common/quant_common.h"
+
+// Per-band constants, one 32-bit entry per band, looked up with
+// _mm256_permutevar8x32_epi32().
+typedef struct {
+  __m256i bins[NUQ_KNOTS];
+  __m256i dqv[NUQ_KNOTS];  // dequant_val[1..NUQ_KNOTS]
+} nuq_band_tab;
+
+static INLINE void init_band_tab(const cuml_bins_type_nuq *cuml_bins_ptr,
+                                 const dequant_val_type_nuq *dequant_val,
+                                 int logsizeby16, nuq_band_tab *tab) {
+  DECLARE_ALIGNED(32, int32_t, bins[NUQ_KNOTS][8]);
+  DECLARE_ALIGNED(32, int32_t, dqv[NUQ_KNOTS][8]);
+  int b, k;
+  for (b = 0; b < 8; ++b) {
+    const int band = AOMMIN(b, COEF_BANDS - 1);
+    for (k = 0; k < NUQ_KNOTS; ++k) {
+      bins[k][b] = ROUND_POWER_OF_TWO(cuml_bins_ptr[band][k], logsizeby16);
+      dqv[k][b] = dequant_val[band][k + 1];
+    }
+  }
+  for (k = 0; k < NUQ_KNOTS; ++k) {
+    tab->bins[k] = _mm256_load_si256((const __m256i *)bins[k]);
+    tab->dqv[k] = _mm256_load_si256((const __m256i *)dqv[k]);
+  }
+}
+
+// Low 32 bits of ((a + b) * m) >> shift, with the product kept in 64 bits.
+static INLINE __m256i mul_sum_shift(__m256i a, __m256i b, __m256i m,
+                                    int shift) {
+  const __m128i cnt = _mm_cvtsi32_si128(shift);
+  const __m256i m_odd = _mm256_srli_epi64(m, 32);
+  __m256i even =
+      _mm256_add_epi64(_mm256_mul_epi32(a, m), _mm256_mul_epi32(b, m));
+  __m256i odd =
+      _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), m_odd),
+                       _mm256_mul_epi32(_mm256_srli_epi64(b, 32), m_odd));
+  even = _mm256_srl_epi64(even, cnt);
+  odd = _mm256_slli_epi64(_mm256_srl_epi64(odd, cnt), 32);
+  return _mm256_blend_epi16(even, odd, 0xcc);
+}
+
+static INLINE __m256i load_coeffs(const tran_low_t *coeff_ptr,
+                                  const int16_t *scan, __m256i rc) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  (void)scan;
+  return _mm256_i32gather_epi32((const int *)coeff_ptr, rc, 4);
+#else
+  (void)rc;
+  return _mm256_setr_epi32(coeff_ptr[scan[0]], coeff_ptr[scan[1]],
+                           coeff_ptr[scan[2]], coeff_ptr[scan[3]],
+                           coeff_ptr[scan[4]], coeff_ptr[scan[5]],
+                           coeff_ptr[scan[6]], coeff_ptr[scan[7]]);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+// Quantizes the coefficients in scan order, eight at a time; only the
+// nonzero results are scattered back. quant_shift_ptr is NULL for the fp
+// variants. With clamp16 the magnitudes are clamped to int16 range first, as
+// in the low bitdepth C versions.
+static INLINE void quantize_nuq_kernel(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *quant_ptr, const int16_t *quant_shift_ptr,
+    const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr,
+    const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const uint8_t *band, int logsizeby16, int clamp16) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i two = _mm256_set1_epi32(2);
+  const __m256i knots = _mm256_set1_epi32(NUQ_KNOTS);
+  const __m256i quant_dc = _mm256_set1_epi32(quant_ptr[0]);
+  const __m256i quant_ac = _mm256_set1_epi32(quant_ptr[1]);
+  const __m256i dequant_dc = _mm256_set1_epi32(dequant_ptr[0]);
+  const __m256i dequant_ac = _mm256_set1_epi32(dequant_ptr[1]);
+  __m256i shift_dc = zero, shift_ac = zero;
+  DECLARE_ALIGNED(32, int32_t, qc[8]);
+  DECLARE_ALIGNED(32, int32_t, dqc[8]);
+  nuq_band_tab tab;
+  int eob = -1;
+  intptr_t i;
+
+  memset(qcoeff_ptr, 0, n_coeffs * sizeof(*qcoeff_ptr));
+  memset(dqcoeff_ptr, 0, n_coeffs * sizeof(*dqcoeff_ptr));
+  if (skip_block) {
+    *eob_ptr = 0;
+    return;
+  }
+
+  init_band_tab(cuml_bins_ptr, dequant_val, logsizeby16, &tab);
+  if (quant_shift_ptr) {
+    shift_dc = _mm256_set1_epi32(quant_shift_ptr[0]);
+    shift_ac = _mm256_set1_epi32(quant_shift_ptr[1]);
+  }
+
+  for (i = 0; i < n_coeffs; i += 8) {
+    const __m256i rc =
+        _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)&scan[i]));
+    const __m256i coeff = load_coeffs(coeff_ptr, &scan[i], rc);
+    const __m256i is_dc = _mm256_cmpeq_epi32(rc, zero);
+    const __m256i quant = _mm256_blendv_epi8(quant_ac, quant_dc, is_dc);
+    const __m256i dequant = _mm256_blendv_epi8(dequant_ac, dequant_dc, is_dc);
+    const __m256i bands =
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&band[i]));
+    const __m256i bin0 = _mm256_permutevar8x32_epi32(tab.bins[0], bands);
+    const __m256i bin1 = _mm256_permutevar8x32_epi32(tab.bins[1], bands);
+    const __m256i bin2 = _mm256_permutevar8x32_epi32(tab.bins[2], bands);
+    const __m256i sign = _mm256_srai_epi32(coeff, 31);
+    __m256i tmp = _mm256_abs_epi32(coeff);
+    __m256i q, dq, nz_mask;
+    int nz, j;
+
+    if (clamp16) {
+      tmp = _mm256_max_epi32(
+          _mm256_min_epi32(tmp, _mm256_set1_epi32(INT16_MAX)),
+          _mm256_set1_epi32(INT16_MIN));
+    }
+
+    // Past the last knot the step is uniform
+    tmp = _mm256_sub_epi32(tmp, bin2);
+    if (quant_shift_ptr) {
+      const __m256i quant_shift =
+          _mm256_blendv_epi8(shift_ac, shift_dc, is_dc);
+      const __m256i t = mul_sum_shift(tmp, zero, quant, 16);
+      q = mul_sum_shift(t, tmp, quant_shift, 16 - logsizeby16);
+    } else {
+      q = mul_sum_shift(tmp, zero, quant, 16 - logsizeby16);
+    }
+    q = _mm256_add_epi32(q, knots);
+    tmp = _mm256_add_epi32(tmp, bin2);
+    q = _mm256_blendv_epi8(q, two, _mm256_cmpgt_epi32(bin2, tmp));
+    q = _mm256_blendv_epi8(q, one, _mm256_cmpgt_epi32(bin1, tmp));
+    q = _mm256_blendv_epi8(q, zero, _mm256_cmpgt_epi32(bin0, tmp));
+
+    nz_mask = _mm256_cmpeq_epi32(q, zero);
+    nz = _mm256_movemask_ps(_mm256_castsi256_ps(nz_mask)) ^ 0xff;
+    if (!nz) continue;
+
+    dq = _mm256_add_epi32(
+        _mm256_permutevar8x32_epi32(tab.dqv[2], bands),
+        _mm256_mullo_epi32(_mm256_sub_epi32(q, knots), dequant));
+    dq = _mm256_blendv_epi8(dq, _mm256_permutevar8x32_epi32(tab.dqv[1], bands),
+                            _mm256_cmpeq_epi32(q, two));
+    dq = _mm256_blendv_epi8(dq, _mm256_permutevar8x32_epi32(tab.dqv[0], bands),
+                            _mm256_cmpeq_epi32(q, one));
+#if !CONFIG_AOM_HIGHBITDEPTH
+    // av1_dequant_abscoeff_nuq() returns a 16-bit tran_low_t
+    dq = _mm256_srai_epi32(_mm256_slli_epi32(dq, 16), 16);
+#endif  // !CONFIG_AOM_HIGHBITDEPTH
+    if (logsizeby16) {
+      dq = _mm256_srai_epi32(
+          _mm256_add_epi32(dq, _mm256_set1_epi32(1 << (logsizeby16 - 1))),
+          logsizeby16);
+    }
+    q = _mm256_sub_epi32(_mm256_xor_si256(q, sign), sign);
+#if !CONFIG_AOM_HIGHBITDEPTH
+    q = _mm256_srai_epi32(_mm256_slli_epi32(q, 16), 16);
+#endif  // !CONFIG_AOM_HIGHBITDEPTH
+    dq = _mm256_sub_epi32(_mm256_xor_si256(dq, _mm256_srai_epi32(q, 31)),
+                          _mm256_srai_epi32(q, 31));
+    _mm256_store_si256((__m256i *)qc, q);
+    _mm256_store_si256((__m256i *)dqc, dq);
+
+    for (j = 0; j < 8; ++j) {
+      if (nz & (1 << j)) {
+        qcoeff_ptr[scan[i + j]] = qc[j];
+        dqcoeff_ptr[scan[i + j]] = dqc[j];
+      }
+    }
+    eob = (int)i + get_msb(nz);
+  }
+  *eob_ptr = eob + 1;
+}
+
+void quantize_nuq_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                       int skip_block, const int16_t *quant_ptr,
+                       const int16_t *quant_shift_ptr,
+                       const int16_t *dequant_ptr,
+                       const cuml_bins_type_nuq *cuml_bins_ptr,
+                       const dequant_val_type_nuq *dequant_val,
+                       tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                       uint16_t *eob_ptr, const int16_t *scan,
+                       const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 0, 1);
+}
+
+void quantize_fp_nuq_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                          int skip_block, const int16_t *quant_ptr,
+                          const int16_t *dequant_ptr,
+                          const cuml_bins_type_nuq *cuml_bins_ptr,
+                          const dequant_val_type_nuq *dequant_val,
+                          tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                          uint16_t *eob_ptr, const int16_t *scan,
+                          const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 0, 1);
+}
+
+void quantize_32x32_nuq_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                             int skip_block, const int16_t *quant_ptr,
+                             const int16_t *quant_shift_ptr,
+                             const int16_t *dequant_ptr,
+                             const cuml_bins_type_nuq *cuml_bins_ptr,
+                             const dequant_val_type_nuq *dequant_val,
+                             tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                             uint16_t *eob_ptr, const int16_t *scan,
+                             const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 1, 1);
+}
+
+void quantize_32x32_fp_nuq_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                                int skip_block, const int16_t *quant_ptr,
+                                const int16_t *dequant_ptr,
+                                const cuml_bins_type_nuq *cuml_bins_ptr,
+                                const dequant_val_type_nuq *dequant_val,
+                                tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                                uint16_t *eob_ptr, const int16_t *scan,
+                                const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 1, 1);
+}
+#if CONFIG_TX64X64
+void quantize_64x64_nuq_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                             int skip_block, const int16_t *quant_ptr,
+                             const int16_t *quant_shift_ptr,
+                             const int16_t *dequant_ptr,
+                             const cuml_bins_type_nuq *cuml_bins_ptr,
+                             const dequant_val_type_nuq *dequant_val,
+                             tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                             uint16_t *eob_ptr, const int16_t *scan,
+                             const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 2, 1);
+}
+
+void quantize_64x64_fp_nuq_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                                int skip_block, const int16_t *quant_ptr,
+                                const int16_t *dequant_ptr,
+                                const cuml_bins_type_nuq *cuml_bins_ptr,
+                                const dequant_val_type_nuq *dequant_val,
+                                tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                                uint16_t *eob_ptr, const int16_t *scan,
+                                const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 2, 1);
+}
+#endif  // CONFIG_TX64X64
+
+#if CONFIG_AOM_HIGHBITDEPTH
+void highbd_quantize_nuq_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                              int skip_block, const int16_t *quant_ptr,
+                              const int16_t *quant_shift_ptr,
+                              const int16_t *dequant_ptr,
+                              const cuml_bins_type_nuq *cuml_bins_ptr,
+                              const dequant_val_type_nuq *dequant_val,
+                              tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                              uint16_t *eob_ptr, const int16_t *scan,
+                              const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 0, 0);
+}
+
+void highbd_quantize_fp_nuq_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                                 int skip_block, const int16_t *quant_ptr,
+                                 const int16_t *dequant_ptr,
+                                 const cuml_bins_type_nuq *cuml_bins_ptr,
+                                 const dequant_val_type_nuq *dequant_val,
+                                 tran_low_t *qcoeff_ptr,
+                                 tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr,
+                                 const int16_t *scan, const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 0, 0);
+}
+
+void highbd_quantize_32x32_nuq_avx2(const tran_low_t *coeff_ptr,
+                                    intptr_t n_coeffs, int skip_block,
+                                    const int16_t *quant_ptr,
+                                    const int16_t *quant_shift_ptr,
+                                    const int16_t *dequant_ptr,
+                                    const cuml_bins_type_nuq *cuml_bins_ptr,
+                                    const dequant_val_type_nuq *dequant_val,
+                                    tran_low_t *qcoeff_ptr,
+                                    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr,
+                                    const int16_t *scan, const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 1, 0);
+}
+
+void highbd_quantize_32x32_fp_nuq_avx2(const tran_low_t *coeff_ptr,
+                                       intptr_t n_coeffs, int skip_block,
+                                       const int16_t *quant_ptr,
+                                       const int16_t *dequant_ptr,
+                                       const cuml_bins_type_nuq *cuml_bins_ptr,
+                                       const dequant_val_type_nuq *dequant_val,
+                                       tran_low_t *qcoeff_ptr,
+                                       tran_low_t *dqcoeff_ptr,
+                                       uint16_t *eob_ptr, const int16_t *scan,
+                                       const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 1, 0);
+}
+#if CONFIG_TX64X64
+void highbd_quantize_64x64_nuq_avx2(const tran_low_t *coeff_ptr,
+                                    intptr_t n_coeffs, int skip_block,
+                                    const int16_t *quant_ptr,
+                                    const int16_t *quant_shift_ptr,
+                                    const int16_t *dequant_ptr,
+                                    const cuml_bins_type_nuq *cuml_bins_ptr,
+                                    const dequant_val_type_nuq *dequant_val,
+                                    tran_low_t *qcoeff_ptr,
+                                    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr,
+                                    const int16_t *scan, const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 2, 0);
+}
+
+void highbd_quantize_64x64_fp_nuq_avx2(const tran_low_t *coeff_ptr,
+                                       intptr_t n_coeffs, int skip_block,
+                                       const int16_t *quant_ptr,
+                                       const int16_t *dequant_ptr,
+                                       const cuml_bins_type_nuq *cuml_bins_ptr,
+                                       const dequant_val_type_nuq *dequant_val,
+                                       tran_low_t *qcoeff_ptr,
+                                       tran_low_t *dqcoeff_ptr,
+                                       uint16_t *eob_ptr, const int16_t *scan,
+                                       const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 2, 0);
+}
+#endif  // CONFIG_TX64X64
+#endif  // CONFIG_AOM_HIGHBITDEPTH
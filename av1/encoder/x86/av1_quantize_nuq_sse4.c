@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>
+#include <string.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/bitops.h"
+#include "aom_ports/mem.h"
+#include "av1/common/entropy.h"
+#include "av1/common/quant_common.h"
+
+// Per-band constants, one 32-bit entry per band split over two registers so
+// that they can be looked up with _mm_shuffle_epi8().
+typedef struct {
+  __m128i bins[NUQ_KNOTS][2];
+  __m128i dqv[NUQ_KNOTS][2];  // dequant_val[1..NUQ_KNOTS]
+} nuq_band_tab;
+
+static INLINE void init_band_tab(const cuml_bins_type_nuq *cuml_bins_ptr,
+                                 const dequant_val_type_nuq *dequant_val,
+                                 int logsizeby16, nuq_band_tab *tab) {
+  DECLARE_ALIGNED(16, int32_t, bins[NUQ_KNOTS][8]);
+  DECLARE_ALIGNED(16, int32_t, dqv[NUQ_KNOTS][8]);
+  int b, k;
+  for (b = 0; b < 8; ++b) {
+    const int band = AOMMIN(b, COEF_BANDS - 1);
+    for (k = 0; k < NUQ_KNOTS; ++k) {
+      bins[k][b] = ROUND_POWER_OF_TWO(cuml_bins_ptr[band][k], logsizeby16);
+      dqv[k][b] = dequant_val[band][k + 1];
+    }
+  }
+  for (k = 0; k < NUQ_KNOTS; ++k) {
+    tab->bins[k][0] = _mm_load_si128((const __m128i *)bins[k]);
+    tab->bins[k][1] = _mm_load_si128((const __m128i *)(bins[k] + 4));
+    tab->dqv[k][0] = _mm_load_si128((const __m128i *)dqv[k]);
+    tab->dqv[k][1] = _mm_load_si128((const __m128i *)(dqv[k] + 4));
+  }
+}
+
+static INLINE __m128i lookup_band(const __m128i *tab, __m128i idx,
+                                  __m128i hi) {
+  return _mm_blendv_epi8(_mm_shuffle_epi8(tab[0], idx),
+                         _mm_shuffle_epi8(tab[1], idx), hi);
+}
+
+// Low 32 bits of ((a + b) * m) >> shift, with the product kept in 64 bits.
+static INLINE __m128i mul_sum_shift(__m128i a, __m128i b, __m128i m,
+                                    int shift) {
+  const __m128i cnt = _mm_cvtsi32_si128(shift);
+  const __m128i m_odd = _mm_srli_epi64(m, 32);
+  __m128i even = _mm_add_epi64(_mm_mul_epi32(a, m), _mm_mul_epi32(b, m));
+  __m128i odd = _mm_add_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32), m_odd),
+                              _mm_mul_epi32(_mm_srli_epi64(b, 32), m_odd));
+  even = _mm_srl_epi64(even, cnt);
+  odd = _mm_slli_epi64(_mm_srl_epi64(odd, cnt), 32);
+  return _mm_blend_epi16(even, odd, 0xcc);
+}
+
+// Quantizes the coefficients in scan order, four at a time; only the nonzero
+// results are scattered back. quant_shift_ptr is NULL for the fp variants.
+// With clamp16 the magnitudes are clamped to int16 range first, as in the low
+// bitdepth C versions.
+static INLINE void quantize_nuq_kernel(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *quant_ptr, const int16_t *quant_shift_ptr,
+    const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr,
+    const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const uint8_t *band, int logsizeby16, int clamp16) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i two = _mm_set1_epi32(2);
+  const __m128i knots = _mm_set1_epi32(NUQ_KNOTS);
+  const __m128i band_rep =
+      _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+  const __m128i byte_idx = _mm_set1_epi32(0x03020100);
+  const __m128i fifteen = _mm_set1_epi8(15);
+  const __m128i quant_dc = _mm_set1_epi32(quant_ptr[0]);
+  const __m128i quant_ac = _mm_set1_epi32(quant_ptr[1]);
+  const __m128i dequant_dc = _mm_set1_epi32(dequant_ptr[0]);
+  const __m128i dequant_ac = _mm_set1_epi32(dequant_ptr[1]);
+  __m128i shift_dc = zero, shift_ac = zero;
+  DECLARE_ALIGNED(16, int32_t, qc[4]);
+  DECLARE_ALIGNED(16, int32_t, dqc[4]);
+  nuq_band_tab tab;
+  int eob = -1;
+  intptr_t i;
+
+  memset(qcoeff_ptr, 0, n_coeffs * sizeof(*qcoeff_ptr));
+  memset(dqcoeff_ptr, 0, n_coeffs * sizeof(*dqcoeff_ptr));
+  if (skip_block) {
+    *eob_ptr = 0;
+    return;
+  }
+
+  init_band_tab(cuml_bins_ptr, dequant_val, logsizeby16, &tab);
+  if (quant_shift_ptr) {
+    shift_dc = _mm_set1_epi32(quant_shift_ptr[0]);
+    shift_ac = _mm_set1_epi32(quant_shift_ptr[1]);
+  }
+
+  for (i = 0; i < n_coeffs; i += 4) {
+    const __m128i rc =
+        _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)&scan[i]));
+    const __m128i coeff =
+        _mm_setr_epi32(coeff_ptr[scan[i]], coeff_ptr[scan[i + 1]],
+                       coeff_ptr[scan[i + 2]], coeff_ptr[scan[i + 3]]);
+    const __m128i is_dc = _mm_cmpeq_epi32(rc, zero);
+    const __m128i quant = _mm_blendv_epi8(quant_ac, quant_dc, is_dc);
+    const __m128i dequant = _mm_blendv_epi8(dequant_ac, dequant_dc, is_dc);
+    const __m128i bands = _mm_shuffle_epi8(
+        _mm_cvtsi32_si128(*(const int *)&band[i]), band_rep);
+    const __m128i idx = _mm_add_epi8(_mm_slli_epi16(bands, 2), byte_idx);
+    const __m128i hi = _mm_cmpgt_epi8(idx, fifteen);
+    const __m128i bin0 = lookup_band(tab.bins[0], idx, hi);
+    const __m128i bin1 = lookup_band(tab.bins[1], idx, hi);
+    const __m128i bin2 = lookup_band(tab.bins[2], idx, hi);
+    const __m128i sign = _mm_srai_epi32(coeff, 31);
+    __m128i tmp = _mm_abs_epi32(coeff);
+    __m128i q, dq, nz_mask;
+    int nz, j;
+
+    if (clamp16) {
+      tmp = _mm_max_epi32(_mm_min_epi32(tmp, _mm_set1_epi32(INT16_MAX)),
+                          _mm_set1_epi32(INT16_MIN));
+    }
+
+    // Past the last knot the step is uniform
+    tmp = _mm_sub_epi32(tmp, bin2);
+    if (quant_shift_ptr) {
+      const __m128i quant_shift = _mm_blendv_epi8(shift_ac, shift_dc, is_dc);
+      const __m128i t = mul_sum_shift(tmp, zero, quant, 16);
+      q = mul_sum_shift(t, tmp, quant_shift, 16 - logsizeby16);
+    } else {
+      q = mul_sum_shift(tmp, zero, quant, 16 - logsizeby16);
+    }
+    q = _mm_add_epi32(q, knots);
+    tmp = _mm_add_epi32(tmp, bin2);
+    q = _mm_blendv_epi8(q, two, _mm_cmpgt_epi32(bin2, tmp));
+    q = _mm_blendv_epi8(q, one, _mm_cmpgt_epi32(bin1, tmp));
+    q = _mm_blendv_epi8(q, zero, _mm_cmpgt_epi32(bin0, tmp));
+
+    nz_mask = _mm_cmpeq_epi32(q, zero);
+    nz = _mm_movemask_ps(_mm_castsi128_ps(nz_mask)) ^ 0xf;
+    if (!nz) continue;
+
+    dq = _mm_add_epi32(lookup_band(tab.dqv[2], idx, hi),
+                       _mm_mullo_epi32(_mm_sub_epi32(q, knots), dequant));
+    dq = _mm_blendv_epi8(dq, lookup_band(tab.dqv[1], idx, hi),
+                         _mm_cmpeq_epi32(q, two));
+    dq = _mm_blendv_epi8(dq, lookup_band(tab.dqv[0], idx, hi),
+                         _mm_cmpeq_epi32(q, one));
+#if !CONFIG_AOM_HIGHBITDEPTH
+    // av1_dequant_abscoeff_nuq() returns a 16-bit tran_low_t
+    dq = _mm_srai_epi32(_mm_slli_epi32(dq, 16), 16);
+#endif  // !CONFIG_AOM_HIGHBITDEPTH
+    if (logsizeby16) {
+      dq = _mm_srai_epi32(
+          _mm_add_epi32(dq, _mm_set1_epi32(1 << (logsizeby16 - 1))),
+          logsizeby16);
+    }
+    q = _mm_sub_epi32(_mm_xor_si128(q, sign), sign);
+#if !CONFIG_AOM_HIGHBITDEPTH
+    q = _mm_srai_epi32(_mm_slli_epi32(q, 16), 16);
+#endif  // !CONFIG_AOM_HIGHBITDEPTH
+    dq = _mm_sub_epi32(_mm_xor_si128(dq, _mm_srai_epi32(q, 31)),
+                       _mm_srai_epi32(q, 31));
+    _mm_store_si128((__m128i *)qc, q);
+    _mm_store_si128((__m128i *)dqc, dq);
+
+    for (j = 0; j < 4; ++j) {
+      if (nz & (1 << j)) {
+        qcoeff_ptr[scan[i + j]] = qc[j];
+        dqcoeff_ptr[scan[i + j]] = dqc[j];
+      }
+    }
+    eob = (int)i + get_msb(nz);
+  }
+  *eob_ptr = eob + 1;
+}
+
+void quantize_nuq_sse4_1(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                         int skip_block, const int16_t *quant_ptr,
+                         const int16_t *quant_shift_ptr,
+                         const int16_t *dequant_ptr,
+                         const cuml_bins_type_nuq *cuml_bins_ptr,
+                         const dequant_val_type_nuq *dequant_val,
+                         tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                         uint16_t *eob_ptr, const int16_t *scan,
+                         const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 0, 1);
+}
+
+void quantize_fp_nuq_sse4_1(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                            int skip_block, const int16_t *quant_ptr,
+                            const int16_t *dequant_ptr,
+                            const cuml_bins_type_nuq *cuml_bins_ptr,
+                            const dequant_val_type_nuq *dequant_val,
+                            tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                            uint16_t *eob_ptr, const int16_t *scan,
+                            const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 0, 1);
+}
+
+void quantize_32x32_nuq_sse4_1(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *quant_ptr,
+                               const int16_t *quant_shift_ptr,
+                               const int16_t *dequant_ptr,
+                               const cuml_bins_type_nuq *cuml_bins_ptr,
+                               const dequant_val_type_nuq *dequant_val,
+                               tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                               uint16_t *eob_ptr, const int16_t *scan,
+                               const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 1, 1);
+}
+
+void quantize_32x32_fp_nuq_sse4_1(const tran_low_t *coeff_ptr,
+                                  intptr_t n_coeffs, int skip_block,
+                                  const int16_t *quant_ptr,
+                                  const int16_t *dequant_ptr,
+                                  const cuml_bins_type_nuq *cuml_bins_ptr,
+                                  const dequant_val_type_nuq *dequant_val,
+                                  tran_low_t *qcoeff_ptr,
+                                  tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr,
+                                  const int16_t *scan, const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 1, 1);
+}
+
+#if CONFIG_TX64X64
+void quantize_64x64_nuq_sse4_1(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *quant_ptr,
+                               const int16_t *quant_shift_ptr,
+                               const int16_t *dequant_ptr,
+                               const cuml_bins_type_nuq *cuml_bins_ptr,
+                               const dequant_val_type_nuq *dequant_val,
+                               tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                               uint16_t *eob_ptr, const int16_t *scan,
+                               const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 2, 1);
+}
+
+void quantize_64x64_fp_nuq_sse4_1(const tran_low_t *coeff_ptr,
+                                  intptr_t n_coeffs, int skip_block,
+                                  const int16_t *quant_ptr,
+                                  const int16_t *dequant_ptr,
+                                  const cuml_bins_type_nuq *cuml_bins_ptr,
+                                  const dequant_val_type_nuq *dequant_val,
+                                  tran_low_t *qcoeff_ptr,
+                                  tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr,
+                                  const int16_t *scan, const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 2, 1);
+}
+#endif  // CONFIG_TX64X64
+
+#if CONFIG_AOM_HIGHBITDEPTH
+void highbd_quantize_nuq_sse4_1(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                                int skip_block, const int16_t *quant_ptr,
+                                const int16_t *quant_shift_ptr,
+                                const int16_t *dequant_ptr,
+                                const cuml_bins_type_nuq *cuml_bins_ptr,
+                                const dequant_val_type_nuq *dequant_val,
+                                tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                                uint16_t *eob_ptr, const int16_t *scan,
+                                const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 0, 0);
+}
+
+void highbd_quantize_fp_nuq_sse4_1(const tran_low_t *coeff_ptr,
+                                   intptr_t n_coeffs, int skip_block,
+                                   const int16_t *quant_ptr,
+                                   const int16_t *dequant_ptr,
+                                   const cuml_bins_type_nuq *cuml_bins_ptr,
+                                   const dequant_val_type_nuq *dequant_val,
+                                   tran_low_t *qcoeff_ptr,
+                                   tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr,
+                                   const int16_t *scan, const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 0, 0);
+}
+
+void highbd_quantize_32x32_nuq_sse4_1(const tran_low_t *coeff_ptr,
+                                      intptr_t n_coeffs, int skip_block,
+                                      const int16_t *quant_ptr,
+                                      const int16_t *quant_shift_ptr,
+                                      const int16_t *dequant_ptr,
+                                      const cuml_bins_type_nuq *cuml_bins_ptr,
+                                      const dequant_val_type_nuq *dequant_val,
+                                      tran_low_t *qcoeff_ptr,
+                                      tran_low_t *dqcoeff_ptr,
+                                      uint16_t *eob_ptr, const int16_t *scan,
+                                      const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 1, 0);
+}
+
+void highbd_quantize_32x32_fp_nuq_sse4_1(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *quant_ptr, const int16_t *dequant_ptr,
+    const cuml_bins_type_nuq *cuml_bins_ptr,
+    const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 1, 0);
+}
+
+#if CONFIG_TX64X64
+void highbd_quantize_64x64_nuq_sse4_1(const tran_low_t *coeff_ptr,
+                                      intptr_t n_coeffs, int skip_block,
+                                      const int16_t *quant_ptr,
+                                      const int16_t *quant_shift_ptr,
+                                      const int16_t *dequant_ptr,
+                                      const cuml_bins_type_nuq *cuml_bins_ptr,
+                                      const dequant_val_type_nuq *dequant_val,
+                                      tran_low_t *qcoeff_ptr,
+                                      tran_low_t *dqcoeff_ptr,
+                                      uint16_t *eob_ptr, const int16_t *scan,
+                                      const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr,
+                      quant_shift_ptr, dequant_ptr, cuml_bins_ptr, dequant_val,
+                      qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band, 2, 0);
+}
+
+void highbd_quantize_64x64_fp_nuq_sse4_1(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *quant_ptr, const int16_t *dequant_ptr,
+    const cuml_bins_type_nuq *cuml_bins_ptr,
+    const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const uint8_t *band) {
+  quantize_nuq_kernel(coeff_ptr, n_coeffs, skip_block, quant_ptr, NULL,
+                      dequant_ptr, cuml_bins_ptr, dequant_val, qcoeff_ptr,
+                      dqcoeff_ptr, eob_ptr, scan, band, 2, 0);
+}
+#endif  // CONFIG_TX64X64
+#endif  // CONFIG_AOM_HIGHBITDEPTH
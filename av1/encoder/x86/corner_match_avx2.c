@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+#include "av1/encoder/corner_match.h"
+
+// Loads the MATCH_SZ pixels of a patch row, followed by zeros. The second
+// load overlaps the first, so that no pixel outside the patch is read.
+static INLINE __m128i load_patch_row(const unsigned char *p) {
+  const __m128i lo = _mm_loadl_epi64((const __m128i *)p);
+  const __m128i hi = _mm_loadl_epi64((const __m128i *)(p + MATCH_SZ - 8));
+  return _mm_unpacklo_epi64(lo, _mm_srli_si128(hi, 16 - MATCH_SZ));
+}
+
+// The rows of both patches share one register for the sums, and the products
+// of a row take a single madd on 16-bit pixels. The sums fit in 32 bits, as
+// the products add up to at most MATCH_SZ_SQ * 255^2.
+double av1_compute_cross_correlation_avx2(unsigned char *im1, int stride1,
+                                          int x1, int y1, unsigned char *im2,
+                                          int stride2, int x2, int y2) {
+  const unsigned char *p1 =
+      im1 + (y1 - MATCH_SZ_BY2) * stride1 + x1 - MATCH_SZ_BY2;
+  const unsigned char *p2 =
+      im2 + (y2 - MATCH_SZ_BY2) * stride2 + x2 - MATCH_SZ_BY2;
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sums = zero, cross = zero;
+  __m128i s, c;
+  int i;
+
+  for (i = 0; i < MATCH_SZ; ++i, p1 += stride1, p2 += stride2) {
+    const __m128i v1 = load_patch_row(p1);
+    const __m128i v2 = load_patch_row(p2);
+    const __m256i v12 =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(v1), v2, 1);
+    sums = _mm256_add_epi32(sums, _mm256_sad_epu8(v12, zero));
+    cross = _mm256_add_epi32(
+        cross,
+        _mm256_madd_epi16(_mm256_cvtepu8_epi16(v1), _mm256_cvtepu8_epi16(v2)));
+  }
+
+  // The sums of absolute values are in the low halves of the 64-bit lanes:
+  // lanes 0 and 2 for the first patch, 4 and 6 for the second one.
+  s = _mm_add_epi32(_mm256_castsi256_si128(sums),
+                    _mm_srli_si128(_mm256_castsi256_si128(sums), 8));
+  s = _mm_unpacklo_epi32(
+      s, _mm_add_epi32(_mm256_extracti128_si256(sums, 1),
+                       _mm_srli_si128(_mm256_extracti128_si256(sums, 1), 8)));
+  c = _mm_add_epi32(_mm256_castsi256_si128(cross),
+                    _mm256_extracti128_si256(cross, 1));
+  c = _mm_add_epi32(c, _mm_srli_si128(c, 8));
+  c = _mm_add_epi32(c, _mm_srli_si128(c, 4));
+  {
+    const int s1 = _mm_cvtsi128_si32(s);
+    const int s2 = _mm_extract_epi32(s, 1);
+    return ((double)_mm_cvtsi128_si32(c) * MATCH_SZ_SQ - (double)s1 * s2) /
+           (MATCH_SZ_SQ * MATCH_SZ_SQ);
+  }
+}
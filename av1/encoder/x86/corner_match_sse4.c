@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>  // sse4.1
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+#include "av1/encoder/corner_match.h"
+
+// Loads the MATCH_SZ pixels of a patch row, followed by zeros. The second
+// load overlaps the first, so that no pixel outside the patch is read.
+static INLINE __m128i load_patch_row(const unsigned char *p) {
+  const __m128i lo = _mm_loadl_epi64((const __m128i *)p);
+  const __m128i hi = _mm_loadl_epi64((const __m128i *)(p + MATCH_SZ - 8));
+  return _mm_unpacklo_epi64(lo, _mm_srli_si128(hi, 16 - MATCH_SZ));
+}
+
+static INLINE int hsum_epi32(__m128i v) {
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+  return _mm_cvtsi128_si32(v);
+}
+
+// The sums of the patches and of their products fit in 32 bits: the products
+// add up to at most MATCH_SZ_SQ * 255^2.
+double av1_compute_cross_correlation_sse4_1(unsigned char *im1, int stride1,
+                                            int x1, int y1,
+                                            unsigned char *im2, int stride2,
+                                            int x2, int y2) {
+  const unsigned char *p1 =
+      im1 + (y1 - MATCH_SZ_BY2) * stride1 + x1 - MATCH_SZ_BY2;
+  const unsigned char *p2 =
+      im2 + (y2 - MATCH_SZ_BY2) * stride2 + x2 - MATCH_SZ_BY2;
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sum1 = zero, sum2 = zero, cross = zero;
+  int i;
+
+  for (i = 0; i < MATCH_SZ; ++i, p1 += stride1, p2 += stride2) {
+    const __m128i v1 = load_patch_row(p1);
+    const __m128i v2 = load_patch_row(p2);
+    sum1 = _mm_add_epi32(sum1, _mm_sad_epu8(v1, zero));
+    sum2 = _mm_add_epi32(sum2, _mm_sad_epu8(v2, zero));
+    cross = _mm_add_epi32(
+        cross, _mm_madd_epi16(_mm_cvtepu8_epi16(v1), _mm_cvtepu8_epi16(v2)));
+    cross = _mm_add_epi32(cross, _mm_madd_epi16(_mm_unpackhi_epi8(v1, zero),
+                                                _mm_unpackhi_epi8(v2, zero)));
+  }
+
+  {
+    // The sums of absolute values are in the low halves of the 64-bit lanes.
+    const int s1 = _mm_cvtsi128_si32(sum1) + _mm_extract_epi32(sum1, 2);
+    const int s2 = _mm_cvtsi128_si32(sum2) + _mm_extract_epi32(sum2, 2);
+    const int c = hsum_epi32(cross);
+    return ((double)c * MATCH_SZ_SQ - (double)s1 * s2) /
+           (MATCH_SZ_SQ * MATCH_SZ_SQ);
+  }
+}
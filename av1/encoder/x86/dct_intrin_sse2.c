@@ -19,6 +19,8 @@
 #include "aom_dsp/x86/synonyms.h"
 #include "aom_dsp/x86/txfm_common_sse2.h"
 #include "aom_ports/mem.h"
+#include "av1/common/x86/hybrid_txfm32_sse2.h"
+#include "av1/encoder/x86/hybrid_fwd_txfm32_impl.h"
 
 static INLINE void load_buffer_4x4(const int16_t *input, __m128i *in,
                                    int stride, int flipud, int fliplr) {
@@ -3947,3 +3949,277 @@ void av1_fht32x16_sse2(const int16_t *input, tran_low_t *output, int stride,
   }
   write_buffer_32x16(output, in0, in1, in2, in3);
 }
+
+// Load the 16 rows into lanes 0..3 of in, then transpose each 4x4 block so
+// that in[4 * i + j] holds column j of rows 4 * i .. 4 * i + 3.
+static INLINE void load_buffer_4x16(const int16_t *input, __m128i *in,
+                                    int stride, int flipud, int fliplr) {
+  const int shift = 2;
+  int i;
+  if (flipud) {
+    input += 15 * stride;
+    stride = -stride;
+  }
+  for (i = 0; i < 16; ++i) {
+    in[i] = _mm_loadl_epi64((const __m128i *)(input + i * stride));
+    if (fliplr) in[i] = _mm_shufflelo_epi16(in[i], 0x1b);
+    in[i] = _mm_slli_epi16(in[i], shift);
+  }
+  prepare_4x8_row_first(in);
+  prepare_4x8_row_first(in + 8);
+}
+
+static INLINE void write_buffer_4x16(tran_low_t *output, __m128i *res) {
+  const int shift = 1;
+  int i;
+  for (i = 0; i < 8; ++i) {
+    __m128i out = _mm_unpacklo_epi64(res[2 * i], res[2 * i + 1]);
+    const __m128i sign = _mm_srai_epi16(out, 15);
+    out = _mm_srai_epi16(_mm_sub_epi16(out, sign), shift);
+    store_output(&out, output + i * 8);
+  }
+}
+
+void av1_fht4x16_sse2(const int16_t *input, tran_low_t *output, int stride,
+                      int tx_type) {
+  __m128i in[16];
+  int i;
+
+  switch (tx_type) {
+    case DCT_DCT:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fdct4_sse2(in + i);
+      fdct16_8col(in);
+      break;
+    case ADST_DCT:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fdct4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case DCT_ADST:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fdct16_8col(in);
+      break;
+    case ADST_ADST:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+      load_buffer_4x16(input, in, stride, 1, 0);
+      for (i = 0; i < 16; i += 4) fdct4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case DCT_FLIPADST:
+      load_buffer_4x16(input, in, stride, 0, 1);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fdct16_8col(in);
+      break;
+    case FLIPADST_FLIPADST:
+      load_buffer_4x16(input, in, stride, 1, 1);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case ADST_FLIPADST:
+      load_buffer_4x16(input, in, stride, 0, 1);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case FLIPADST_ADST:
+      load_buffer_4x16(input, in, stride, 1, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case IDTX:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fidtx4_sse2(in + i);
+      fidtx16_8col(in);
+      break;
+    case V_DCT:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fidtx4_sse2(in + i);
+      fdct16_8col(in);
+      break;
+    case H_DCT:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fdct4_sse2(in + i);
+      fidtx16_8col(in);
+      break;
+    case V_ADST:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fidtx4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case H_ADST:
+      load_buffer_4x16(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fidtx16_8col(in);
+      break;
+    case V_FLIPADST:
+      load_buffer_4x16(input, in, stride, 1, 0);
+      for (i = 0; i < 16; i += 4) fidtx4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case H_FLIPADST:
+      load_buffer_4x16(input, in, stride, 0, 1);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fidtx16_8col(in);
+      break;
+#endif
+    default: assert(0); break;
+  }
+  write_buffer_4x16(output, in);
+}
+
+// Load the input as four 4x4 blocks, one per group of 4 columns: in[4 * i + j]
+// holds row j of columns 4 * i .. 4 * i + 3 in lanes 0..3.
+static INLINE void load_buffer_16x4(const int16_t *input, __m128i *in,
+                                    int stride, int flipud, int fliplr) {
+  const int shift = 2;
+  int i;
+  if (flipud) {
+    input += 3 * stride;
+    stride = -stride;
+  }
+  for (i = 0; i < 4; ++i) {
+    __m128i l = _mm_loadu_si128((const __m128i *)(input + i * stride));
+    __m128i r = _mm_loadu_si128((const __m128i *)(input + i * stride + 8));
+    if (fliplr) {
+      const __m128i t = mm_reverse_epi16(l);
+      l = mm_reverse_epi16(r);
+      r = t;
+    }
+    l = _mm_slli_epi16(l, shift);
+    r = _mm_slli_epi16(r, shift);
+    in[i] = l;
+    in[4 + i] = _mm_shuffle_epi32(l, 0xe);
+    in[8 + i] = r;
+    in[12 + i] = _mm_shuffle_epi32(r, 0xe);
+  }
+}
+
+// res[k] holds column k of the output in lanes 0..3.
+static INLINE void write_buffer_16x4(tran_low_t *output, __m128i *res) {
+  const int shift = 1;
+  int i;
+  array_transpose_8x8(res, res);
+  array_transpose_8x8(res + 8, res + 8);
+  for (i = 0; i < 4; ++i) {
+    __m128i l = res[i];
+    __m128i r = res[8 + i];
+    l = _mm_srai_epi16(_mm_sub_epi16(l, _mm_srai_epi16(l, 15)), shift);
+    r = _mm_srai_epi16(_mm_sub_epi16(r, _mm_srai_epi16(r, 15)), shift);
+    store_output(&l, output + i * 16);
+    store_output(&r, output + i * 16 + 8);
+  }
+}
+
+void av1_fht16x4_sse2(const int16_t *input, tran_low_t *output, int stride,
+                      int tx_type) {
+  __m128i in[16];
+  int i;
+
+  switch (tx_type) {
+    case DCT_DCT:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fdct4_sse2(in + i);
+      fdct16_8col(in);
+      break;
+    case ADST_DCT:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fdct16_8col(in);
+      break;
+    case DCT_ADST:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fdct4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case ADST_ADST:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+      load_buffer_16x4(input, in, stride, 1, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fdct16_8col(in);
+      break;
+    case DCT_FLIPADST:
+      load_buffer_16x4(input, in, stride, 0, 1);
+      for (i = 0; i < 16; i += 4) fdct4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case FLIPADST_FLIPADST:
+      load_buffer_16x4(input, in, stride, 1, 1);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case ADST_FLIPADST:
+      load_buffer_16x4(input, in, stride, 0, 1);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case FLIPADST_ADST:
+      load_buffer_16x4(input, in, stride, 1, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case IDTX:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fidtx4_sse2(in + i);
+      fidtx16_8col(in);
+      break;
+    case V_DCT:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fdct4_sse2(in + i);
+      fidtx16_8col(in);
+      break;
+    case H_DCT:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fidtx4_sse2(in + i);
+      fdct16_8col(in);
+      break;
+    case V_ADST:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fidtx16_8col(in);
+      break;
+    case H_ADST:
+      load_buffer_16x4(input, in, stride, 0, 0);
+      for (i = 0; i < 16; i += 4) fidtx4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+    case V_FLIPADST:
+      load_buffer_16x4(input, in, stride, 1, 0);
+      for (i = 0; i < 16; i += 4) fadst4_sse2(in + i);
+      fidtx16_8col(in);
+      break;
+    case H_FLIPADST:
+      load_buffer_16x4(input, in, stride, 0, 1);
+      for (i = 0; i < 16; i += 4) fidtx4_sse2(in + i);
+      fadst16_8col(in);
+      break;
+#endif
+    default: assert(0); break;
+  }
+  write_buffer_16x4(output, in);
+}
+
+// The 8x32 and 32x8 transforms have no intermediate rounding between the two
+// passes, so their intermediates need more than 16 bits; they use the 32-bit
+// lane kernels of hybrid_fwd_txfm32_impl.h instead.
+void av1_fht8x32_sse2(const int16_t *input, tran_low_t *output, int stride,
+                      int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 8, 32, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_SIGNED_2);
+}
+
+void av1_fht32x8_sse2(const int16_t *input, tran_low_t *output, int stride,
+                      int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 32, 8, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_SIGNED_2);
+}
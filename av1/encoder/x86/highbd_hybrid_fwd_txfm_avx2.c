@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "./aom_dsp_rtcd.h"
+#include "./av1_rtcd.h"
+#include "av1/common/x86/hybrid_txfm32_avx2.h"
+#include "av1/encoder/x86/hybrid_fwd_txfm32_impl.h"
+
+void av1_highbd_fht8x8_avx2(const int16_t *input, tran_low_t *output,
+                            int stride, int tx_type) {
+  if (tx_type == DCT_DCT) {
+    aom_highbd_fdct8x8(input, output, stride);
+    return;
+  }
+  hybrid_fht(input, output, stride, tx_type, 8, 8, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_HALF);
+}
+
+void av1_highbd_fht8x16_avx2(const int16_t *input, tran_low_t *output,
+                             int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 8, 16, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_SIGNED_2, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht16x8_avx2(const int16_t *input, tran_low_t *output,
+                             int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 16, 8, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_SIGNED_2, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht8x32_avx2(const int16_t *input, tran_low_t *output,
+                             int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 8, 32, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_SIGNED_2);
+}
+
+void av1_highbd_fht32x8_avx2(const int16_t *input, tran_low_t *output,
+                             int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 32, 8, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_SIGNED_2);
+}
+
+void av1_highbd_fht16x16_avx2(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 16, 16, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_QUARTER_S, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht16x32_avx2(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 16, 32, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_SIGNED_4, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht32x16_avx2(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 32, 16, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_SIGNED_4, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht32x32_avx2(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 32, 32, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_SIGNED_4, HBD_FWD_ROUND_NONE);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "./aom_dsp_rtcd.h"
+#include "./av1_rtcd.h"
+#include "av1/common/x86/hybrid_txfm32_sse4.h"
+#include "av1/encoder/x86/hybrid_fwd_txfm32_impl.h"
+
+void av1_highbd_fht4x4_sse4_1(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  if (tx_type == DCT_DCT) {
+    aom_highbd_fdct4x4(input, output, stride);
+    return;
+  }
+  hybrid_fht(input, output, stride, tx_type, 4, 4, HBD_FWD_SCALE_16_DC,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_QUARTER);
+}
+
+void av1_highbd_fht4x8_sse4_1(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 4, 8, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_HALF);
+}
+
+void av1_highbd_fht8x4_sse4_1(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 8, 4, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_HALF);
+}
+
+void av1_highbd_fht4x16_sse4_1(const int16_t *input, tran_low_t *output,
+                               int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 4, 16, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_HALF);
+}
+
+void av1_highbd_fht16x4_sse4_1(const int16_t *input, tran_low_t *output,
+                               int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 16, 4, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_HALF);
+}
+
+void av1_highbd_fht8x8_sse4_1(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  if (tx_type == DCT_DCT) {
+    aom_highbd_fdct8x8(input, output, stride);
+    return;
+  }
+  hybrid_fht(input, output, stride, tx_type, 8, 8, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_HALF);
+}
+
+void av1_highbd_fht8x16_sse4_1(const int16_t *input, tran_low_t *output,
+                               int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 8, 16, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_SIGNED_2, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht16x8_sse4_1(const int16_t *input, tran_low_t *output,
+                               int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 16, 8, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_SIGNED_2, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht8x32_sse4_1(const int16_t *input, tran_low_t *output,
+                               int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 8, 32, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_SIGNED_2);
+}
+
+void av1_highbd_fht32x8_sse4_1(const int16_t *input, tran_low_t *output,
+                               int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 32, 8, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_SIGNED_2);
+}
+
+void av1_highbd_fht16x16_sse4_1(const int16_t *input, tran_low_t *output,
+                                int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 16, 16, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_QUARTER_S, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht16x32_sse4_1(const int16_t *input, tran_low_t *output,
+                                int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 16, 32, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_SIGNED_4, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht32x16_sse4_1(const int16_t *input, tran_low_t *output,
+                                int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 32, 16, HBD_FWD_SCALE_4_SQRT2,
+             HBD_FWD_ROUND_SIGNED_4, HBD_FWD_ROUND_NONE);
+}
+
+void av1_highbd_fht32x32_sse4_1(const int16_t *input, tran_low_t *output,
+                                int stride, int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 32, 32, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_SIGNED_4, HBD_FWD_ROUND_NONE);
+}
+
+// One lifting pass of av1_fwht4x4_c() on four columns; the outputs are
+// returned in the order they are stored.
+static INLINE void fwht4_sse4_1(hbd_vec *x) {
+  const hbd_vec a = hbd_add(x[0], x[1]);
+  const hbd_vec d = hbd_sub(x[3], x[2]);
+  const hbd_vec e = hbd_sra(hbd_sub(a, d), 1);
+  const hbd_vec b = hbd_sub(e, x[1]);
+  const hbd_vec c = hbd_sub(e, x[2]);
+  x[0] = hbd_sub(a, c);
+  x[1] = c;
+  x[2] = hbd_add(d, b);
+  x[3] = b;
+}
+
+void av1_highbd_fwht4x4_sse4_1(const int16_t *input, tran_low_t *output,
+                               int stride) {
+  hbd_vec in[4], out[4];
+  int i;
+
+  for (i = 0; i < 4; ++i) in[i] = hbd_load_row(input + i * stride);
+  fwht4_sse4_1(in);
+  hbd_transpose(in, out);
+  fwht4_sse4_1(out);
+  hbd_transpose(out, in);
+  for (i = 0; i < 4; ++i)
+    hbd_store_row(output + i * 4, hbd_sll(in[i], UNIT_QUANT_SHIFT));
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>
+#include <string.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/mem.h"
+#include "av1/encoder/x86/temporal_filter_x86.h"
+
+// High 32 bits of the unsigned products.
+static INLINE __m128i mulhi_epu32(__m128i a, __m128i b) {
+  const __m128i even = _mm_srli_epi64(_mm_mul_epu32(a, b), 32);
+  const __m128i odd =
+      _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_blend_epi16(even, odd, 0xcc);
+}
+
+// Loads four pixels as 32-bit values.
+static INLINE __m128i load_pixels(const uint16_t *p) {
+  return _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)p));
+}
+
+void av1_highbd_temporal_filter_apply_sse4_1(
+    uint8_t *frame1_8, unsigned int stride, uint8_t *frame2_8,
+    unsigned int block_width, unsigned int block_height, int strength,
+    int filter_weight, unsigned int *accumulator, uint16_t *count) {
+  const uint16_t *const frame1 = CONVERT_TO_SHORTPTR(frame1_8);
+  const uint16_t *const frame2 = CONVERT_TO_SHORTPTR(frame2_8);
+  DECLARE_ALIGNED(16, uint32_t, diff_sq[TF_DIFF_SQ_SIZE]);
+  DECLARE_ALIGNED(16, uint32_t, mult[2][TF_MAX_BLOCK_SIZE]);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m128i rounding =
+      _mm_set1_epi32(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m128i sixteen = _mm_set1_epi32(16);
+  const __m128i weight = _mm_set1_epi32(filter_weight);
+  unsigned int i, j;
+
+  if (!temporal_filter_simd_size(block_width, block_height, 4)) {
+    av1_highbd_temporal_filter_apply_c(frame1_8, stride, frame2_8, block_width,
+                                       block_height, strength, filter_weight,
+                                       accumulator, count);
+    return;
+  }
+
+  temporal_filter_init_mult(mult, block_width);
+
+  // Squared differences, with a border of zeros.
+  memset(diff_sq, 0, sizeof(diff_sq));
+  for (i = 0; i < block_height; i++) {
+    uint32_t *const dst = diff_sq + (i + 1) * TF_DIFF_SQ_STRIDE + 1;
+    for (j = 0; j < block_width; j += 4) {
+      const __m128i diff =
+          _mm_sub_epi32(load_pixels(frame1 + i * stride + j),
+                        load_pixels(frame2 + i * block_width + j));
+      _mm_storeu_si128((__m128i *)(dst + j), _mm_mullo_epi32(diff, diff));
+    }
+  }
+
+  // Horizontal sums of three, in place and including the border rows. Each
+  // store only overwrites values that have already been read.
+  for (i = 0; i < block_height + 2; i++) {
+    uint32_t *const row = diff_sq + i * TF_DIFF_SQ_STRIDE;
+    for (j = 0; j < block_width; j += 4) {
+      const __m128i sum = _mm_add_epi32(
+          _mm_add_epi32(_mm_loadu_si128((const __m128i *)(row + j)),
+                        _mm_loadu_si128((const __m128i *)(row + j + 1))),
+          _mm_loadu_si128((const __m128i *)(row + j + 2)));
+      _mm_storeu_si128((__m128i *)(row + j), sum);
+    }
+  }
+
+  for (i = 0; i < block_height; i++) {
+    const uint32_t *const row = diff_sq + i * TF_DIFF_SQ_STRIDE;
+    const uint32_t *const row_mult =
+        mult[i == 0 || i == block_height - 1 ? 0 : 1];
+    for (j = 0; j < block_width; j += 4) {
+      const int k = i * block_width + j;
+      const __m128i sum = _mm_add_epi32(
+          _mm_add_epi32(
+              _mm_loadu_si128((const __m128i *)(row + j)),
+              _mm_loadu_si128((const __m128i *)(row + TF_DIFF_SQ_STRIDE + j))),
+          _mm_loadu_si128((const __m128i *)(row + 2 * TF_DIFF_SQ_STRIDE + j)));
+      __m128i modifier, acc, cnt;
+
+      // sum * 3 / index
+      modifier =
+          mulhi_epu32(sum, _mm_load_si128((const __m128i *)(row_mult + j)));
+      modifier = _mm_srl_epi32(_mm_add_epi32(modifier, rounding), shift);
+      modifier = _mm_min_epu32(modifier, sixteen);
+      modifier = _mm_mullo_epi32(_mm_sub_epi32(sixteen, modifier), weight);
+
+      cnt = _mm_add_epi16(_mm_loadl_epi64((const __m128i *)(count + k)),
+                          _mm_packus_epi32(modifier, modifier));
+      _mm_storel_epi64((__m128i *)(count + k), cnt);
+
+      acc = _mm_add_epi32(_mm_loadu_si128((const __m128i *)(accumulator + k)),
+                          _mm_mullo_epi32(modifier, load_pixels(frame2 + k)));
+      _mm_storeu_si128((__m128i *)(accumulator + k), acc);
+    }
+  }
+}
@@ -0,0 +1,541 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+// Hybrid forward transforms (av1_fht* and av1_highbd_fht*), written once over
+// an abstract vector of 32-bit lanes and included by each ISA-specific file
+// after one of the av1/common/x86/hybrid_txfm32_*.h headers. The 1-D kernels
+// follow fdct*, fadst* and the fidtx*/fhalfright32 helpers in
+// av1/encoder/dct.c step for step: every product is formed and rounded in 64
+// bits and every tran_low_t sum wraps in 32 bits, so the output is bit-exact
+// with av1_highbd_fht*_c() for all inputs.
+
+#include <assert.h>
+
+#include "./aom_config.h"
+#include "aom_dsp/txfm_common.h"
+#include "aom_ports/bitops.h"
+#include "av1/common/enums.h"
+
+static void hbd_fdct4(hbd_vec *x) {
+  const hbd_vec s0 = hbd_add(x[0], x[3]);
+  const hbd_vec s1 = hbd_add(x[1], x[2]);
+  const hbd_vec s2 = hbd_sub(x[1], x[2]);
+  const hbd_vec s3 = hbd_sub(x[0], x[3]);
+  x[0] = hbd_madd_round(s0, (int)cospi_16_64, s1, (int)cospi_16_64);
+  x[1] = hbd_madd_round(s2, (int)cospi_24_64, s3, (int)cospi_8_64);
+  x[2] = hbd_madd_round(s0, (int)cospi_16_64, s1, -(int)cospi_16_64);
+  x[3] = hbd_madd_round(s3, (int)cospi_24_64, s2, -(int)cospi_8_64);
+}
+
+static void hbd_fdct8(hbd_vec *x) {
+  hbd_vec e[4], o4, o5, o6, o7, t5, t6, u4, u5, u6, u7;
+  int i;
+
+  // odd half
+  o4 = hbd_sub(x[3], x[4]);
+  o5 = hbd_sub(x[2], x[5]);
+  o6 = hbd_sub(x[1], x[6]);
+  o7 = hbd_sub(x[0], x[7]);
+  t5 = hbd_madd_round(o5, -(int)cospi_16_64, o6, (int)cospi_16_64);
+  t6 = hbd_madd_round(o6, (int)cospi_16_64, o5, (int)cospi_16_64);
+  u4 = hbd_add(o4, t5);
+  u5 = hbd_sub(o4, t5);
+  u6 = hbd_sub(o7, t6);
+  u7 = hbd_add(o7, t6);
+
+  // even half
+  for (i = 0; i < 4; ++i) e[i] = hbd_add(x[i], x[7 - i]);
+  hbd_fdct4(e);
+  for (i = 0; i < 4; ++i) x[2 * i] = e[i];
+
+  x[1] = hbd_madd_round(u4, (int)cospi_28_64, u7, (int)cospi_4_64);
+  x[3] = hbd_madd_round(u6, (int)cospi_12_64, u5, -(int)cospi_20_64);
+  x[5] = hbd_madd_round(u5, (int)cospi_12_64, u6, (int)cospi_20_64);
+  x[7] = hbd_madd_round(u7, (int)cospi_28_64, u4, -(int)cospi_4_64);
+}
+
+static void hbd_fdct16(hbd_vec *x) {
+  // Odd outputs 1, 3, ..., 15 come from z[k] in this order.
+  static const int odd_idx[8] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+  hbd_vec e[8], o[8], s[8], z[8];
+  int i;
+
+  // o[k] is step 8 + k of the C version.
+  for (i = 0; i < 8; ++i) o[i] = hbd_sub(x[7 - i], x[8 + i]);
+
+  // even half
+  for (i = 0; i < 8; ++i) e[i] = hbd_add(x[i], x[15 - i]);
+  hbd_fdct8(e);
+  for (i = 0; i < 8; ++i) x[2 * i] = e[i];
+
+  // stage 2
+  s[2] = hbd_madd_round(o[2], -(int)cospi_16_64, o[5], (int)cospi_16_64);
+  s[3] = hbd_madd_round(o[3], -(int)cospi_16_64, o[4], (int)cospi_16_64);
+  s[4] = hbd_madd_round(o[4], (int)cospi_16_64, o[3], (int)cospi_16_64);
+  s[5] = hbd_madd_round(o[5], (int)cospi_16_64, o[2], (int)cospi_16_64);
+
+  // stage 3
+  z[0] = hbd_add(o[0], s[3]);
+  z[1] = hbd_add(o[1], s[2]);
+  z[2] = hbd_sub(o[1], s[2]);
+  z[3] = hbd_sub(o[0], s[3]);
+  z[4] = hbd_sub(o[7], s[4]);
+  z[5] = hbd_sub(o[6], s[5]);
+  z[6] = hbd_add(o[6], s[5]);
+  z[7] = hbd_add(o[7], s[4]);
+
+  // stage 4
+  s[1] = hbd_madd_round(z[1], -(int)cospi_8_64, z[6], (int)cospi_24_64);
+  s[2] = hbd_madd_round(z[2], -(int)cospi_24_64, z[5], -(int)cospi_8_64);
+  s[5] = hbd_madd_round(z[5], (int)cospi_24_64, z[2], -(int)cospi_8_64);
+  s[6] = hbd_madd_round(z[6], (int)cospi_8_64, z[1], (int)cospi_24_64);
+
+  // stage 5
+  o[0] = hbd_add(z[0], s[1]);
+  o[1] = hbd_sub(z[0], s[1]);
+  o[2] = hbd_sub(z[3], s[2]);
+  o[3] = hbd_add(z[3], s[2]);
+  o[4] = hbd_add(z[4], s[5]);
+  o[5] = hbd_sub(z[4], s[5]);
+  o[6] = hbd_sub(z[7], s[6]);
+  o[7] = hbd_add(z[7], s[6]);
+
+  // stage 6
+  z[0] = hbd_madd_round(o[0], (int)cospi_30_64, o[7], (int)cospi_2_64);
+  z[1] = hbd_madd_round(o[1], (int)cospi_14_64, o[6], (int)cospi_18_64);
+  z[2] = hbd_madd_round(o[2], (int)cospi_22_64, o[5], (int)cospi_10_64);
+  z[3] = hbd_madd_round(o[3], (int)cospi_6_64, o[4], (int)cospi_26_64);
+  z[4] = hbd_madd_round(o[4], (int)cospi_6_64, o[3], -(int)cospi_26_64);
+  z[5] = hbd_madd_round(o[5], (int)cospi_22_64, o[2], -(int)cospi_10_64);
+  z[6] = hbd_madd_round(o[6], (int)cospi_14_64, o[1], -(int)cospi_18_64);
+  z[7] = hbd_madd_round(o[7], (int)cospi_30_64, o[0], -(int)cospi_2_64);
+
+  for (i = 0; i < 8; ++i) x[2 * i + 1] = z[odd_idx[i]];
+}
+
+static void hbd_fdct32(hbd_vec *x) {
+  // Odd outputs 1, 3, ..., 31 come from a[k] in this order.
+  static const int odd_idx[16] = { 0, 8,  4, 12, 2, 10, 6, 14,
+                                   1, 9,  5, 13, 3, 11, 7, 15 };
+  hbd_vec e[16], a[16], b[16];
+  int i;
+
+  // a[k] is step 16 + k of the C version.
+  for (i = 0; i < 16; ++i) a[i] = hbd_sub(x[15 - i], x[16 + i]);
+
+  // even half
+  for (i = 0; i < 16; ++i) e[i] = hbd_add(x[i], x[31 - i]);
+  hbd_fdct16(e);
+  for (i = 0; i < 16; ++i) x[2 * i] = e[i];
+
+  // stage 2
+  for (i = 4; i < 8; ++i) {
+    b[i] = hbd_madd_round(a[i], -(int)cospi_16_64, a[15 - i],
+                          (int)cospi_16_64);
+    b[15 - i] = hbd_madd_round(a[15 - i], (int)cospi_16_64, a[i],
+                               (int)cospi_16_64);
+  }
+  for (i = 4; i < 12; ++i) a[i] = b[i];
+
+  // stage 3
+  for (i = 0; i < 4; ++i) {
+    b[i] = hbd_add(a[i], a[7 - i]);
+    b[7 - i] = hbd_sub(a[i], a[7 - i]);
+    b[8 + i] = hbd_sub(a[15 - i], a[8 + i]);
+    b[15 - i] = hbd_add(a[15 - i], a[8 + i]);
+  }
+
+  // stage 4
+  for (i = 0; i < 16; ++i) a[i] = b[i];
+  a[2] = hbd_madd_round(b[2], -(int)cospi_8_64, b[13], (int)cospi_24_64);
+  a[3] = hbd_madd_round(b[3], -(int)cospi_8_64, b[12], (int)cospi_24_64);
+  a[4] = hbd_madd_round(b[4], -(int)cospi_24_64, b[11], -(int)cospi_8_64);
+  a[5] = hbd_madd_round(b[5], -(int)cospi_24_64, b[10], -(int)cospi_8_64);
+  a[10] = hbd_madd_round(b[10], (int)cospi_24_64, b[5], -(int)cospi_8_64);
+  a[11] = hbd_madd_round(b[11], (int)cospi_24_64, b[4], -(int)cospi_8_64);
+  a[12] = hbd_madd_round(b[12], (int)cospi_8_64, b[3], (int)cospi_24_64);
+  a[13] = hbd_madd_round(b[13], (int)cospi_8_64, b[2], (int)cospi_24_64);
+
+  // stage 5
+  for (i = 0; i < 16; i += 8) {
+    b[i + 0] = hbd_add(a[i + 0], a[i + 3]);
+    b[i + 1] = hbd_add(a[i + 1], a[i + 2]);
+    b[i + 2] = hbd_sub(a[i + 1], a[i + 2]);
+    b[i + 3] = hbd_sub(a[i + 0], a[i + 3]);
+    b[i + 4] = hbd_sub(a[i + 7], a[i + 4]);
+    b[i + 5] = hbd_sub(a[i + 6], a[i + 5]);
+    b[i + 6] = hbd_add(a[i + 6], a[i + 5]);
+    b[i + 7] = hbd_add(a[i + 7], a[i + 4]);
+  }
+
+  // stage 6
+  for (i = 0; i < 16; ++i) a[i] = b[i];
+  a[1] = hbd_madd_round(b[1], -(int)cospi_4_64, b[14], (int)cospi_28_64);
+  a[2] = hbd_madd_round(b[2], -(int)cospi_28_64, b[13], -(int)cospi_4_64);
+  a[5] = hbd_madd_round(b[5], -(int)cospi_20_64, b[10], (int)cospi_12_64);
+  a[6] = hbd_madd_round(b[6], -(int)cospi_12_64, b[9], -(int)cospi_20_64);
+  a[9] = hbd_madd_round(b[9], (int)cospi_12_64, b[6], -(int)cospi_20_64);
+  a[10] = hbd_madd_round(b[10], (int)cospi_20_64, b[5], (int)cospi_12_64);
+  a[13] = hbd_madd_round(b[13], (int)cospi_28_64, b[2], -(int)cospi_4_64);
+  a[14] = hbd_madd_round(b[14], (int)cospi_4_64, b[1], (int)cospi_28_64);
+
+  // stage 7
+  for (i = 0; i < 16; i += 4) {
+    b[i + 0] = hbd_add(a[i + 0], a[i + 1]);
+    b[i + 1] = hbd_sub(a[i + 0], a[i + 1]);
+    b[i + 2] = hbd_sub(a[i + 3], a[i + 2]);
+    b[i + 3] = hbd_add(a[i + 3], a[i + 2]);
+  }
+
+  // stage 8
+  a[0] = hbd_madd_round(b[0], (int)cospi_31_64, b[15], (int)cospi_1_64);
+  a[1] = hbd_madd_round(b[1], (int)cospi_15_64, b[14], (int)cospi_17_64);
+  a[2] = hbd_madd_round(b[2], (int)cospi_23_64, b[13], (int)cospi_9_64);
+  a[3] = hbd_madd_round(b[3], (int)cospi_7_64, b[12], (int)cospi_25_64);
+  a[4] = hbd_madd_round(b[4], (int)cospi_27_64, b[11], (int)cospi_5_64);
+  a[5] = hbd_madd_round(b[5], (int)cospi_11_64, b[10], (int)cospi_21_64);
+  a[6] = hbd_madd_round(b[6], (int)cospi_19_64, b[9], (int)cospi_13_64);
+  a[7] = hbd_madd_round(b[7], (int)cospi_3_64, b[8], (int)cospi_29_64);
+  a[8] = hbd_madd_round(b[8], (int)cospi_3_64, b[7], -(int)cospi_29_64);
+  a[9] = hbd_madd_round(b[9], (int)cospi_19_64, b[6], -(int)cospi_13_64);
+  a[10] = hbd_madd_round(b[10], (int)cospi_11_64, b[5], -(int)cospi_21_64);
+  a[11] = hbd_madd_round(b[11], (int)cospi_27_64, b[4], -(int)cospi_5_64);
+  a[12] = hbd_madd_round(b[12], (int)cospi_7_64, b[3], -(int)cospi_25_64);
+  a[13] = hbd_madd_round(b[13], (int)cospi_23_64, b[2], -(int)cospi_9_64);
+  a[14] = hbd_madd_round(b[14], (int)cospi_15_64, b[1], -(int)cospi_17_64);
+  a[15] = hbd_madd_round(b[15], (int)cospi_31_64, b[0], -(int)cospi_1_64);
+
+  for (i = 0; i < 16; ++i) x[2 * i + 1] = a[odd_idx[i]];
+}
+
+static void hbd_fadst4(hbd_vec *x) {
+  const hbd_vec64 s0 =
+      hbd_add64(hbd_madd64(x[0], (int)sinpi_1_9, x[1], (int)sinpi_2_9),
+                hbd_mul64(x[3], (int)sinpi_4_9));
+  const hbd_vec64 s1 =
+      hbd_add64(hbd_madd64(x[0], (int)sinpi_3_9, x[1], (int)sinpi_3_9),
+                hbd_mul64(x[3], -(int)sinpi_3_9));
+  const hbd_vec64 s2 =
+      hbd_add64(hbd_madd64(x[0], (int)sinpi_4_9, x[1], -(int)sinpi_1_9),
+                hbd_mul64(x[3], (int)sinpi_2_9));
+  const hbd_vec64 s3 = hbd_mul64(x[2], (int)sinpi_3_9);
+  x[0] = hbd_round64(hbd_add64(s0, s3));
+  x[1] = hbd_round64(s1);
+  x[2] = hbd_round64(hbd_sub64(s2, s3));
+  x[3] = hbd_round64(hbd_add64(hbd_sub64(s2, s0), s3));
+}
+
+static void hbd_fadst8(hbd_vec *x) {
+  hbd_vec64 s[8], t[4];
+  hbd_vec y[8], t2, t3, t6, t7;
+  int i;
+
+  // stage 1
+  s[0] = hbd_madd64(x[7], (int)cospi_2_64, x[0], (int)cospi_30_64);
+  s[1] = hbd_madd64(x[7], (int)cospi_30_64, x[0], -(int)cospi_2_64);
+  s[2] = hbd_madd64(x[5], (int)cospi_10_64, x[2], (int)cospi_22_64);
+  s[3] = hbd_madd64(x[5], (int)cospi_22_64, x[2], -(int)cospi_10_64);
+  s[4] = hbd_madd64(x[3], (int)cospi_18_64, x[4], (int)cospi_14_64);
+  s[5] = hbd_madd64(x[3], (int)cospi_14_64, x[4], -(int)cospi_18_64);
+  s[6] = hbd_madd64(x[1], (int)cospi_26_64, x[6], (int)cospi_6_64);
+  s[7] = hbd_madd64(x[1], (int)cospi_6_64, x[6], -(int)cospi_26_64);
+  for (i = 0; i < 4; ++i) {
+    y[4 + i] = hbd_round64(hbd_sub64(s[i], s[4 + i]));
+    s[i] = hbd_add64(s[i], s[4 + i]);
+  }
+
+  // stage 2
+  t[0] = hbd_madd64(y[4], (int)cospi_8_64, y[5], (int)cospi_24_64);
+  t[1] = hbd_madd64(y[4], (int)cospi_24_64, y[5], -(int)cospi_8_64);
+  t[2] = hbd_madd64(y[6], -(int)cospi_24_64, y[7], (int)cospi_8_64);
+  t[3] = hbd_madd64(y[6], (int)cospi_8_64, y[7], (int)cospi_24_64);
+  y[0] = hbd_round64(hbd_add64(s[0], s[2]));
+  y[1] = hbd_round64(hbd_add64(s[1], s[3]));
+  y[2] = hbd_round64(hbd_sub64(s[0], s[2]));
+  y[3] = hbd_round64(hbd_sub64(s[1], s[3]));
+  y[4] = hbd_round64(hbd_add64(t[0], t[2]));
+  y[5] = hbd_round64(hbd_add64(t[1], t[3]));
+  y[6] = hbd_round64(hbd_sub64(t[0], t[2]));
+  y[7] = hbd_round64(hbd_sub64(t[1], t[3]));
+
+  // stage 3
+  t2 = hbd_madd_round(y[2], (int)cospi_16_64, y[3], (int)cospi_16_64);
+  t3 = hbd_madd_round(y[2], (int)cospi_16_64, y[3], -(int)cospi_16_64);
+  t6 = hbd_madd_round(y[6], (int)cospi_16_64, y[7], (int)cospi_16_64);
+  t7 = hbd_madd_round(y[6], (int)cospi_16_64, y[7], -(int)cospi_16_64);
+
+  x[0] = y[0];
+  x[1] = hbd_neg(y[4]);
+  x[2] = t6;
+  x[3] = hbd_neg(t2);
+  x[4] = t3;
+  x[5] = hbd_neg(t7);
+  x[6] = y[5];
+  x[7] = hbd_neg(y[1]);
+}
+
+static void hbd_fadst16(hbd_vec *x) {
+  hbd_vec64 s[16], t[8];
+  hbd_vec y[16], z[16];
+  int i;
+
+  // stage 1
+  s[0] = hbd_madd64(x[15], (int)cospi_1_64, x[0], (int)cospi_31_64);
+  s[1] = hbd_madd64(x[15], (int)cospi_31_64, x[0], -(int)cospi_1_64);
+  s[2] = hbd_madd64(x[13], (int)cospi_5_64, x[2], (int)cospi_27_64);
+  s[3] = hbd_madd64(x[13], (int)cospi_27_64, x[2], -(int)cospi_5_64);
+  s[4] = hbd_madd64(x[11], (int)cospi_9_64, x[4], (int)cospi_23_64);
+  s[5] = hbd_madd64(x[11], (int)cospi_23_64, x[4], -(int)cospi_9_64);
+  s[6] = hbd_madd64(x[9], (int)cospi_13_64, x[6], (int)cospi_19_64);
+  s[7] = hbd_madd64(x[9], (int)cospi_19_64, x[6], -(int)cospi_13_64);
+  s[8] = hbd_madd64(x[7], (int)cospi_17_64, x[8], (int)cospi_15_64);
+  s[9] = hbd_madd64(x[7], (int)cospi_15_64, x[8], -(int)cospi_17_64);
+  s[10] = hbd_madd64(x[5], (int)cospi_21_64, x[10], (int)cospi_11_64);
+  s[11] = hbd_madd64(x[5], (int)cospi_11_64, x[10], -(int)cospi_21_64);
+  s[12] = hbd_madd64(x[3], (int)cospi_25_64, x[12], (int)cospi_7_64);
+  s[13] = hbd_madd64(x[3], (int)cospi_7_64, x[12], -(int)cospi_25_64);
+  s[14] = hbd_madd64(x[1], (int)cospi_29_64, x[14], (int)cospi_3_64);
+  s[15] = hbd_madd64(x[1], (int)cospi_3_64, x[14], -(int)cospi_29_64);
+  for (i = 0; i < 8; ++i) {
+    y[8 + i] = hbd_round64(hbd_sub64(s[i], s[8 + i]));
+    s[i] = hbd_add64(s[i], s[8 + i]);
+  }
+
+  // stage 2
+  s[8] = hbd_madd64(y[8], (int)cospi_4_64, y[9], (int)cospi_28_64);
+  s[9] = hbd_madd64(y[8], (int)cospi_28_64, y[9], -(int)cospi_4_64);
+  s[10] = hbd_madd64(y[10], (int)cospi_20_64, y[11], (int)cospi_12_64);
+  s[11] = hbd_madd64(y[10], (int)cospi_12_64, y[11], -(int)cospi_20_64);
+  s[12] = hbd_madd64(y[12], -(int)cospi_28_64, y[13], (int)cospi_4_64);
+  s[13] = hbd_madd64(y[12], (int)cospi_4_64, y[13], (int)cospi_28_64);
+  s[14] = hbd_madd64(y[14], -(int)cospi_12_64, y[15], (int)cospi_20_64);
+  s[15] = hbd_madd64(y[14], (int)cospi_20_64, y[15], (int)cospi_12_64);
+  for (i = 0; i < 4; ++i) {
+    y[4 + i] = hbd_round64(hbd_sub64(s[i], s[4 + i]));
+    s[i] = hbd_add64(s[i], s[4 + i]);
+    y[12 + i] = hbd_round64(hbd_sub64(s[8 + i], s[12 + i]));
+    s[8 + i] = hbd_add64(s[8 + i], s[12 + i]);
+  }
+
+  // stage 3
+  for (i = 4; i < 16; i += 8) {
+    t[0] = hbd_madd64(y[i], (int)cospi_8_64, y[i + 1], (int)cospi_24_64);
+    t[1] = hbd_madd64(y[i], (int)cospi_24_64, y[i + 1], -(int)cospi_8_64);
+    t[2] = hbd_madd64(y[i + 2], -(int)cospi_24_64, y[i + 3], (int)cospi_8_64);
+    t[3] = hbd_madd64(y[i + 2], (int)cospi_8_64, y[i + 3], (int)cospi_24_64);
+    z[i + 0] = hbd_round64(hbd_add64(t[0], t[2]));
+    z[i + 1] = hbd_round64(hbd_add64(t[1], t[3]));
+    z[i + 2] = hbd_round64(hbd_sub64(t[0], t[2]));
+    z[i + 3] = hbd_round64(hbd_sub64(t[1], t[3]));
+  }
+  for (i = 0; i < 16; i += 8) {
+    z[i + 0] = hbd_round64(hbd_add64(s[i + 0], s[i + 2]));
+    z[i + 1] = hbd_round64(hbd_add64(s[i + 1], s[i + 3]));
+    z[i + 2] = hbd_round64(hbd_sub64(s[i + 0], s[i + 2]));
+    z[i + 3] = hbd_round64(hbd_sub64(s[i + 1], s[i + 3]));
+  }
+
+  // stage 4
+  x[0] = z[0];
+  x[1] = hbd_neg(z[8]);
+  x[2] = z[12];
+  x[3] = hbd_neg(z[4]);
+  x[4] = hbd_madd_round(z[6], (int)cospi_16_64, z[7], (int)cospi_16_64);
+  x[5] = hbd_madd_round(z[14], -(int)cospi_16_64, z[15], -(int)cospi_16_64);
+  x[6] = hbd_madd_round(z[10], (int)cospi_16_64, z[11], (int)cospi_16_64);
+  x[7] = hbd_madd_round(z[2], -(int)cospi_16_64, z[3], -(int)cospi_16_64);
+  x[8] = hbd_madd_round(z[2], (int)cospi_16_64, z[3], -(int)cospi_16_64);
+  x[9] = hbd_madd_round(z[10], -(int)cospi_16_64, z[11], (int)cospi_16_64);
+  x[10] = hbd_madd_round(z[14], (int)cospi_16_64, z[15], -(int)cospi_16_64);
+  x[11] = hbd_madd_round(z[6], -(int)cospi_16_64, z[7], (int)cospi_16_64);
+  x[12] = z[5];
+  x[13] = hbd_neg(z[13]);
+  x[14] = z[9];
+  x[15] = hbd_neg(z[1]);
+}
+
+static void hbd_fhalfright32(hbd_vec *x) {
+  hbd_vec half[16];
+  int i;
+  for (i = 0; i < 16; ++i) {
+    half[i] = hbd_mul_round(x[16 + i], (int)Sqrt2);
+    x[16 + i] = hbd_sll(x[i], 2);
+  }
+  hbd_fdct16(half);
+  for (i = 0; i < 16; ++i) x[i] = half[i];
+}
+
+static void hbd_fidtx4(hbd_vec *x) {
+  int i;
+  for (i = 0; i < 4; ++i) x[i] = hbd_mul_round(x[i], (int)Sqrt2);
+}
+
+static void hbd_fidtx8(hbd_vec *x) {
+  int i;
+  for (i = 0; i < 8; ++i) x[i] = hbd_add(x[i], x[i]);
+}
+
+static void hbd_fidtx16(hbd_vec *x) {
+  int i;
+  for (i = 0; i < 16; ++i) x[i] = hbd_mul_round(x[i], 2 * (int)Sqrt2);
+}
+
+static void hbd_fidtx32(hbd_vec *x) {
+  int i;
+  for (i = 0; i < 32; ++i) x[i] = hbd_sll(x[i], 2);
+}
+
+typedef void (*hbd_fwd_txfm1d)(hbd_vec *x);
+
+// Indexed by [log2(size) - 2][TX_TYPE_1D]. The 32-point ADST is the half
+// right transform, as in av1_fht32x32_c().
+static const hbd_fwd_txfm1d hbd_fwd_txfm1d_tab[4][TX_TYPES_1D] = {
+  { hbd_fdct4, hbd_fadst4, hbd_fadst4, hbd_fidtx4 },
+  { hbd_fdct8, hbd_fadst8, hbd_fadst8, hbd_fidtx8 },
+  { hbd_fdct16, hbd_fadst16, hbd_fadst16, hbd_fidtx16 },
+  { hbd_fdct32, hbd_fhalfright32, hbd_fhalfright32, hbd_fidtx32 },
+};
+
+// Input scaling applied before the first 1-D transform.
+enum {
+  HBD_FWD_SCALE_4,        // x * 4
+  HBD_FWD_SCALE_4_SQRT2,  // fdct_round_shift(x * 4 * Sqrt2)
+  HBD_FWD_SCALE_16_DC,    // x * 16, plus 1 on a nonzero top left input
+};
+
+// Rounding applied after each 1-D pass.
+enum {
+  HBD_FWD_ROUND_NONE,
+  HBD_FWD_ROUND_HALF,       // (x + (x < 0)) >> 1
+  HBD_FWD_ROUND_QUARTER,    // (x + 1) >> 2
+  HBD_FWD_ROUND_QUARTER_S,  // (x + 1 + (x < 0)) >> 2
+  HBD_FWD_ROUND_SIGNED_2,   // ROUND_POWER_OF_TWO_SIGNED(x, 2)
+  HBD_FWD_ROUND_SIGNED_4,   // ROUND_POWER_OF_TWO_SIGNED(x, 4)
+};
+
+static INLINE void hbd_fwd_round(hbd_vec *x, int n, int mode) {
+  int i;
+  if (mode == HBD_FWD_ROUND_NONE) return;
+  for (i = 0; i < n; ++i) {
+    const hbd_vec sign = hbd_sra(x[i], 31);
+    switch (mode) {
+      case HBD_FWD_ROUND_HALF: x[i] = hbd_sra(hbd_sub(x[i], sign), 1); break;
+      case HBD_FWD_ROUND_QUARTER:
+        x[i] = hbd_sra(hbd_add(x[i], hbd_set1(1)), 2);
+        break;
+      case HBD_FWD_ROUND_QUARTER_S:
+        x[i] = hbd_sra(hbd_sub(hbd_add(x[i], hbd_set1(1)), sign), 2);
+        break;
+      case HBD_FWD_ROUND_SIGNED_2:
+        x[i] = hbd_sra(hbd_add(hbd_add(x[i], hbd_set1(1 << 1)), sign), 2);
+        break;
+      case HBD_FWD_ROUND_SIGNED_4:
+        x[i] = hbd_sra(hbd_add(hbd_add(x[i], hbd_set1(1 << 3)), sign), 4);
+        break;
+      default: assert(0); return;
+    }
+  }
+}
+
+// Forward transform of a txw x txh block of residuals. The 1-D passes run in
+// the same order as the C version (rows first for the tall shapes, columns
+// first otherwise), with mid_round applied after the first pass and
+// final_round after the second.
+static INLINE void hybrid_fht(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type, int txw, int txh,
+                              int scale, int mid_round, int final_round) {
+  const TX_TYPE_1D vtx = hbd_vtx_tab[tx_type];
+  const TX_TYPE_1D htx = hbd_htx_tab[tx_type];
+  const hbd_fwd_txfm1d row_txfm = hbd_fwd_txfm1d_tab[get_msb(txw) - 2][htx];
+  const hbd_fwd_txfm1d col_txfm = hbd_fwd_txfm1d_tab[get_msb(txh) - 2][vtx];
+  const int col_groups = txw / HBD_LANES;
+  const int row_groups = txh / HBD_LANES;
+  // Column group c holds txh vectors at col[c * txh], one per row; row group
+  // g holds txw vectors at row[g * txw], one per column.
+  hbd_vec col[32 * 32 / HBD_LANES];
+  hbd_vec row[32 * 32 / HBD_LANES];
+  int r, c, g;
+
+  // The flips of maybe_flip_input(), applied while loading.
+  if (vtx == FLIPADST_1D) {
+    input += (txh - 1) * stride;
+    stride = -stride;
+  }
+  for (c = 0; c < col_groups; ++c) {
+    hbd_vec *const v = col + c * txh;
+    if (htx == FLIPADST_1D) {
+      const int16_t *const src = input + (col_groups - 1 - c) * HBD_LANES;
+      for (r = 0; r < txh; ++r)
+        v[r] = hbd_reverse(hbd_load_row(src + r * stride));
+    } else {
+      const int16_t *const src = input + c * HBD_LANES;
+      for (r = 0; r < txh; ++r) v[r] = hbd_load_row(src + r * stride);
+    }
+    for (r = 0; r < txh; ++r) {
+      switch (scale) {
+        case HBD_FWD_SCALE_4_SQRT2:
+          v[r] = hbd_mul_round(v[r], 4 * (int)Sqrt2);
+          break;
+        case HBD_FWD_SCALE_16_DC: v[r] = hbd_sll(v[r], 4); break;
+        default: v[r] = hbd_sll(v[r], 2); break;
+      }
+    }
+  }
+  if (scale == HBD_FWD_SCALE_16_DC &&
+      input[htx == FLIPADST_1D ? txw - 1 : 0]) {
+    col[0] = hbd_add(col[0], hbd_set_lane0(1));
+  }
+
+  if (txh > txw) {
+    for (c = 0; c < col_groups; ++c) {
+      for (g = 0; g < row_groups; ++g) {
+        hbd_transpose(col + c * txh + g * HBD_LANES,
+                      row + g * txw + c * HBD_LANES);
+      }
+    }
+    for (g = 0; g < row_groups; ++g) {
+      row_txfm(row + g * txw);
+      hbd_fwd_round(row + g * txw, txw, mid_round);
+    }
+    for (c = 0; c < col_groups; ++c) {
+      for (g = 0; g < row_groups; ++g) {
+        hbd_transpose(row + g * txw + c * HBD_LANES,
+                      col + c * txh + g * HBD_LANES);
+      }
+      col_txfm(col + c * txh);
+      hbd_fwd_round(col + c * txh, txh, final_round);
+    }
+  } else {
+    for (c = 0; c < col_groups; ++c) {
+      col_txfm(col + c * txh);
+      hbd_fwd_round(col + c * txh, txh, mid_round);
+      for (g = 0; g < row_groups; ++g) {
+        hbd_transpose(col + c * txh + g * HBD_LANES,
+                      row + g * txw + c * HBD_LANES);
+      }
+    }
+    for (g = 0; g < row_groups; ++g) {
+      row_txfm(row + g * txw);
+      hbd_fwd_round(row + g * txw, txw, final_round);
+    }
+    for (c = 0; c < col_groups; ++c) {
+      for (g = 0; g < row_groups; ++g) {
+        hbd_transpose(row + g * txw + c * HBD_LANES,
+                      col + c * txh + g * HBD_LANES);
+      }
+    }
+  }
+
+  for (c = 0; c < col_groups; ++c) {
+    for (r = 0; r < txh; ++r)
+      hbd_store_row(output + r * txw + c * HBD_LANES, col[c * txh + r]);
+  }
+}
@@ -17,6 +17,10 @@
 #include "aom_dsp/x86/fwd_txfm_avx2.h"
 #include "aom_dsp/txfm_common.h"
 #include "aom_dsp/x86/txfm_common_avx2.h"
+#include "av1/common/av1_fwd_txfm2d_cfg.h"
+#include "av1/common/x86/av1_txfm1d_avx2.h"
+#include "av1/common/x86/hybrid_txfm32_avx2.h"
+#include "av1/encoder/x86/hybrid_fwd_txfm32_impl.h"
 
 static int32_t get_16x16_sum(const int16_t *input, int stride) {
   __m256i r0, r1, r2, r3, u0, u1;
@@ -1663,3 +1667,84 @@ void av1_fht32x32_avx2(const int16_t *input, tran_low_t *output, int stride,
   write_buffer_32x32(in0, in1, output);
   _mm256_zeroupper();
 }
+
+// See av1_fht8x32_sse2(): these sizes need 32-bit intermediates.
+void av1_fht8x32_avx2(const int16_t *input, tran_low_t *output, int stride,
+                      int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 8, 32, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_SIGNED_2);
+}
+
+void av1_fht32x8_avx2(const int16_t *input, tran_low_t *output, int stride,
+                      int tx_type) {
+  hybrid_fht(input, output, stride, tx_type, 32, 8, HBD_FWD_SCALE_4,
+             HBD_FWD_ROUND_NONE, HBD_FWD_ROUND_SIGNED_2);
+}
+
+#if CONFIG_TX64X64
+// tran_low_t is 16 bits without CONFIG_AOM_HIGHBITDEPTH, and the C code
+// truncates the output of each 1D transform to it.
+static INLINE __m256i wrap_tran_low_avx2(__m256i x) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  return x;
+#else
+  return _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+// Uses the same 1D transforms as av1_fwd_txfm2d_64x64_avx2(), with the
+// rounding of av1_fht64x64_c() in between. Only DCT_DCT has a SIMD path.
+void av1_fht64x64_avx2(const int16_t *input, tran_low_t *output, int stride,
+                       int tx_type) {
+  DECLARE_ALIGNED(32, int32_t, txfm_buf[2][4096]);
+  __m256i *buf = (__m256i *)txfm_buf[0];
+  __m256i *tmp = (__m256i *)txfm_buf[1];
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i zero = _mm256_setzero_si256();
+  int i;
+
+  if (tx_type != DCT_DCT) {
+    av1_fht64x64_c(input, output, stride, tx_type);
+    return;
+  }
+
+  for (i = 0; i < 512; ++i) {
+    buf[i] = _mm256_cvtepi16_epi32(
+        _mm_loadu_si128((const __m128i *)(input + (i >> 3) * stride +
+                                          (i & 7) * 8)));
+  }
+
+  // Columns: out = (x + 1 + (x > 0)) >> 2
+  av1_fdct64_new_avx2(buf, tmp, fwd_cos_bit_col_dct_dct_64,
+                      fwd_stage_range_col_dct_dct_64);
+  for (i = 0; i < 512; ++i) {
+    const __m256i x = wrap_tran_low_avx2(tmp[i]);
+    tmp[i] = _mm256_srai_epi32(
+        _mm256_sub_epi32(_mm256_add_epi32(x, one), _mm256_cmpgt_epi32(x, zero)),
+        2);
+  }
+
+  // Rows: out = (x + 1 + (x < 0)) >> 2
+  transpose_32_avx2(64, tmp, buf);
+  av1_fdct64_new_avx2(buf, tmp, fwd_cos_bit_row_dct_dct_64,
+                      fwd_stage_range_row_dct_dct_64);
+  for (i = 0; i < 512; ++i) {
+    const __m256i x = wrap_tran_low_avx2(tmp[i]);
+    tmp[i] = _mm256_srai_epi32(
+        _mm256_sub_epi32(_mm256_add_epi32(x, one), _mm256_cmpgt_epi32(zero, x)),
+        2);
+  }
+  transpose_32_avx2(64, tmp, buf);
+
+  for (i = 0; i < 512; ++i) {
+#if CONFIG_AOM_HIGHBITDEPTH
+    _mm256_storeu_si256((__m256i *)(output + i * 8), buf[i]);
+#else
+    const __m256i x = _mm256_packs_epi32(buf[i], buf[i]);
+    _mm_storeu_si128((__m128i *)(output + i * 8),
+                     _mm256_castsi256_si128(_mm256_permute4x64_epi64(x, 0x08)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  }
+  _mm256_zeroupper();
+}
+#endif  // CONFIG_TX64X64
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./av1_rtcd.h"
+#include "av1/common/entropymode.h"
+
+// Packs the eight 32-bit indices to bytes and stores them.
+static INLINE void store_indices(__m256i index, uint8_t *indices) {
+  const __m256i v = _mm256_packus_epi16(_mm256_packs_epi32(index, index),
+                                        _mm256_setzero_si256());
+  _mm_storel_epi64((__m128i *)indices,
+                   _mm_unpacklo_epi32(_mm256_castsi256_si128(v),
+                                      _mm256_extracti128_si256(v, 1)));
+}
+
+// Returns the index of the nearest of the 'k' centroids for each of eight
+// points. The distances are computed in the same order as calc_dist() does,
+// and ties go to the lowest index like in av1_calc_indices_c().
+static INLINE __m256i nearest_1d(__m256 x, const float *centroids, int k) {
+  __m256 d = _mm256_sub_ps(x, _mm256_set1_ps(centroids[0]));
+  __m256 min_dist = _mm256_mul_ps(d, d);
+  __m256i index = _mm256_setzero_si256();
+  int j;
+
+  for (j = 1; j < k; ++j) {
+    __m256 this_dist, mask;
+    d = _mm256_sub_ps(x, _mm256_set1_ps(centroids[j]));
+    this_dist = _mm256_mul_ps(d, d);
+    mask = _mm256_cmp_ps(this_dist, min_dist, _CMP_LT_OQ);
+    min_dist = _mm256_min_ps(this_dist, min_dist);
+    index = _mm256_blendv_epi8(index, _mm256_set1_epi32(j),
+                               _mm256_castps_si256(mask));
+  }
+  return index;
+}
+
+static INLINE __m256i nearest_2d(__m256 x, __m256 y, const float *centroids,
+                                 int k) {
+  __m256 dx = _mm256_sub_ps(x, _mm256_set1_ps(centroids[0]));
+  __m256 dy = _mm256_sub_ps(y, _mm256_set1_ps(centroids[1]));
+  __m256 min_dist =
+      _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+  __m256i index = _mm256_setzero_si256();
+  int j;
+
+  for (j = 1; j < k; ++j) {
+    __m256 this_dist, mask;
+    dx = _mm256_sub_ps(x, _mm256_set1_ps(centroids[2 * j]));
+    dy = _mm256_sub_ps(y, _mm256_set1_ps(centroids[2 * j + 1]));
+    this_dist = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    mask = _mm256_cmp_ps(this_dist, min_dist, _CMP_LT_OQ);
+    min_dist = _mm256_min_ps(this_dist, min_dist);
+    index = _mm256_blendv_epi8(index, _mm256_set1_epi32(j),
+                               _mm256_castps_si256(mask));
+  }
+  return index;
+}
+
+void av1_calc_indices_avx2(const float *data, const float *centroids,
+                           uint8_t *indices, int n, int k, int dim) {
+  const int n8 = n & ~7;
+  int i;
+
+  assert(k <= PALETTE_MAX_SIZE);
+
+  if (dim == 1) {
+    for (i = 0; i < n8; i += 8) {
+      store_indices(nearest_1d(_mm256_loadu_ps(data + i), centroids, k),
+                    indices + i);
+    }
+  } else if (dim == 2) {
+    for (i = 0; i < n8; i += 8) {
+      // Deinterleave the pairs into points 0, 1, 4, 5, 2, 3, 6, 7, then
+      // restore the order.
+      const __m256 a = _mm256_loadu_ps(data + 2 * i);
+      const __m256 b = _mm256_loadu_ps(data + 2 * i + 8);
+      const __m256 x = _mm256_castpd_ps(_mm256_permute4x64_pd(
+          _mm256_castps_pd(_mm256_shuffle_ps(a, b, 0x88)), 0xd8));
+      const __m256 y = _mm256_castpd_ps(_mm256_permute4x64_pd(
+          _mm256_castps_pd(_mm256_shuffle_ps(a, b, 0xdd)), 0xd8));
+      store_indices(nearest_2d(x, y, centroids, k), indices + i);
+    }
+  } else {
+    av1_calc_indices_c(data, centroids, indices, n, k, dim);
+    return;
+  }
+
+  if (n8 < n) {
+    av1_calc_indices_c(data + n8 * dim, centroids, indices + n8, n - n8, k,
+                       dim);
+  }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>  // avx2
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+
+static INLINE __m256i add_epi32_to_epi64(__m256i sum64, __m256i sum32) {
+  sum64 = _mm256_add_epi64(sum64,
+                           _mm256_cvtepi32_epi64(_mm256_castsi256_si128(sum32)));
+  return _mm256_add_epi64(
+      sum64, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(sum32, 1)));
+}
+
+static INLINE int64_t hsum_epi64(__m256i sum64) {
+  int64_t res[2];
+  _mm_storeu_si128((__m128i *)res,
+                   _mm_add_epi64(_mm256_castsi256_si128(sum64),
+                                 _mm256_extracti128_si256(sum64, 1)));
+  return res[0] + res[1];
+}
+
+// The products of 8-bit pixels are accumulated in 32 bits for a whole row:
+// each madd adds less than 2^17 to a lane.
+int64_t av1_wiener_corr_avx2(const uint8_t *a, int a_stride, const uint8_t *b,
+                             int b_stride, int width, int height) {
+  __m256i sum64 = _mm256_setzero_si256();
+  int64_t sum = 0;
+  int i, j;
+  for (i = 0; i < height; ++i) {
+    const uint8_t *const a_p = a + i * a_stride;
+    const uint8_t *const b_p = b + i * b_stride;
+    __m256i sum32 = _mm256_setzero_si256();
+    for (j = 0; j + 16 <= width; j += 16) {
+      const __m256i va = _mm256_cvtepu8_epi16(
+          _mm_loadu_si128((const __m128i *)(a_p + j)));
+      const __m256i vb = _mm256_cvtepu8_epi16(
+          _mm_loadu_si128((const __m128i *)(b_p + j)));
+      sum32 = _mm256_add_epi32(sum32, _mm256_madd_epi16(va, vb));
+    }
+    for (; j < width; ++j) sum += a_p[j] * b_p[j];
+    sum64 = add_epi32_to_epi64(sum64, sum32);
+  }
+  return sum + hsum_epi64(sum64);
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+// A madd of 12-bit pixels adds up to 2 * 4095^2 to a lane, so the 32-bit
+// sums are widened every 64 madds.
+int64_t av1_highbd_wiener_corr_avx2(const uint8_t *a8, int a_stride,
+                                    const uint8_t *b8, int b_stride, int width,
+                                    int height) {
+  const uint16_t *const a = CONVERT_TO_SHORTPTR(a8);
+  const uint16_t *const b = CONVERT_TO_SHORTPTR(b8);
+  __m256i sum64 = _mm256_setzero_si256();
+  int64_t sum = 0;
+  int i, j;
+  for (i = 0; i < height; ++i) {
+    const uint16_t *const a_p = a + i * a_stride;
+    const uint16_t *const b_p = b + i * b_stride;
+    __m256i sum32 = _mm256_setzero_si256();
+    int n = 0;
+    for (j = 0; j + 16 <= width; j += 16) {
+      const __m256i va = _mm256_loadu_si256((const __m256i *)(a_p + j));
+      const __m256i vb = _mm256_loadu_si256((const __m256i *)(b_p + j));
+      sum32 = _mm256_add_epi32(sum32, _mm256_madd_epi16(va, vb));
+      if (++n == 64) {
+        sum64 = add_epi32_to_epi64(sum64, sum32);
+        sum32 = _mm256_setzero_si256();
+        n = 0;
+      }
+    }
+    for (; j < width; ++j) sum += (int64_t)a_p[j] * b_p[j];
+    sum64 = add_epi32_to_epi64(sum64, sum32);
+  }
+  return sum + hsum_epi64(sum64);
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>  // sse4.1
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+
+static INLINE __m128i add_epi32_to_epi64(__m128i sum64, __m128i sum32) {
+  sum64 = _mm_add_epi64(sum64, _mm_cvtepi32_epi64(sum32));
+  return _mm_add_epi64(sum64, _mm_cvtepi32_epi64(_mm_srli_si128(sum32, 8)));
+}
+
+static INLINE int64_t hsum_epi64(__m128i sum64) {
+  int64_t res[2];
+  _mm_storeu_si128((__m128i *)res, sum64);
+  return res[0] + res[1];
+}
+
+// The products of 8-bit pixels are accumulated in 32 bits for a whole row:
+// each madd adds less than 2^17 to a lane.
+int64_t av1_wiener_corr_sse4_1(const uint8_t *a, int a_stride,
+                               const uint8_t *b, int b_stride, int width,
+                               int height) {
+  __m128i sum64 = _mm_setzero_si128();
+  int64_t sum = 0;
+  int i, j;
+  for (i = 0; i < height; ++i) {
+    const uint8_t *const a_p = a + i * a_stride;
+    const uint8_t *const b_p = b + i * b_stride;
+    __m128i sum32 = _mm_setzero_si128();
+    for (j = 0; j + 8 <= width; j += 8) {
+      const __m128i va =
+          _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(a_p + j)));
+      const __m128i vb =
+          _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(b_p + j)));
+      sum32 = _mm_add_epi32(sum32, _mm_madd_epi16(va, vb));
+    }
+    for (; j < width; ++j) sum += a_p[j] * b_p[j];
+    sum64 = add_epi32_to_epi64(sum64, sum32);
+  }
+  return sum + hsum_epi64(sum64);
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+// A madd of 12-bit pixels adds up to 2 * 4095^2 to a lane, so the 32-bit
+// sums are widened every 64 madds.
+int64_t av1_highbd_wiener_corr_sse4_1(const uint8_t *a8, int a_stride,
+                                      const uint8_t *b8, int b_stride,
+                                      int width, int height) {
+  const uint16_t *const a = CONVERT_TO_SHORTPTR(a8);
+  const uint16_t *const b = CONVERT_TO_SHORTPTR(b8);
+  __m128i sum64 = _mm_setzero_si128();
+  int64_t sum = 0;
+  int i, j;
+  for (i = 0; i < height; ++i) {
+    const uint16_t *const a_p = a + i * a_stride;
+    const uint16_t *const b_p = b + i * b_stride;
+    __m128i sum32 = _mm_setzero_si128();
+    int n = 0;
+    for (j = 0; j + 8 <= width; j += 8) {
+      const __m128i va = _mm_loadu_si128((const __m128i *)(a_p + j));
+      const __m128i vb = _mm_loadu_si128((const __m128i *)(b_p + j));
+      sum32 = _mm_add_epi32(sum32, _mm_madd_epi16(va, vb));
+      if (++n == 64) {
+        sum64 = add_epi32_to_epi64(sum64, sum32);
+        sum32 = _mm_setzero_si128();
+        n = 0;
+      }
+    }
+    for (; j < width; ++j) sum += (int64_t)a_p[j] * b_p[j];
+    sum64 = add_epi32_to_epi64(sum64, sum32);
+  }
+  return sum + hsum_epi64(sum64);
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
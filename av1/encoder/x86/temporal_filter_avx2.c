@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/mem.h"
+#include "av1/encoder/x86/temporal_filter_x86.h"
+
+// High 32 bits of the unsigned products.
+static INLINE __m256i mulhi_epu32(__m256i a, __m256i b) {
+  const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+  const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32),
+                                       _mm256_srli_epi64(b, 32));
+  return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+// Loads eight pixels as 32-bit values.
+static INLINE __m256i load_pixels(const uint8_t *p, int highbd) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (highbd)
+    return _mm256_cvtepu16_epi32(
+        _mm_loadu_si128((const __m128i *)CONVERT_TO_SHORTPTR(p)));
+#else
+  (void)highbd;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)p));
+}
+
+static INLINE const uint8_t *offset_pixels(const uint8_t *p, int offset,
+                                           int highbd) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (highbd) return CONVERT_TO_BYTEPTR(CONVERT_TO_SHORTPTR(p) + offset);
+#else
+  (void)highbd;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  return p + offset;
+}
+
+static INLINE void temporal_filter_apply_avx2(
+    const uint8_t *frame1, unsigned int stride, const uint8_t *frame2,
+    unsigned int block_width, unsigned int block_height, int strength,
+    int filter_weight, unsigned int *accumulator, uint16_t *count,
+    int highbd) {
+  DECLARE_ALIGNED(32, uint32_t, diff_sq[TF_DIFF_SQ_SIZE]);
+  DECLARE_ALIGNED(32, uint32_t, mult[2][TF_MAX_BLOCK_SIZE]);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m256i rounding =
+      _mm256_set1_epi32(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m256i sixteen = _mm256_set1_epi32(16);
+  const __m256i weight = _mm256_set1_epi32(filter_weight);
+  unsigned int i, j;
+
+  temporal_filter_init_mult(mult, block_width);
+
+  // Squared differences, with a border of zeros.
+  memset(diff_sq, 0, sizeof(diff_sq));
+  for (i = 0; i < block_height; i++) {
+    uint32_t *const dst = diff_sq + (i + 1) * TF_DIFF_SQ_STRIDE + 1;
+    for (j = 0; j < block_width; j += 8) {
+      const __m256i diff = _mm256_sub_epi32(
+          load_pixels(offset_pixels(frame1, i * stride + j, highbd), highbd),
+          load_pixels(offset_pixels(frame2, i * block_width + j, highbd),
+                      highbd));
+      _mm256_storeu_si256((__m256i *)(dst + j),
+                          _mm256_mullo_epi32(diff, diff));
+    }
+  }
+
+  // Horizontal sums of three, in place and including the border rows. Each
+  // store only overwrites values that have already been read.
+  for (i = 0; i < block_height + 2; i++) {
+    uint32_t *const row = diff_sq + i * TF_DIFF_SQ_STRIDE;
+    for (j = 0; j < block_width; j += 8) {
+      const __m256i sum = _mm256_add_epi32(
+          _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(row + j)),
+                           _mm256_loadu_si256((const __m256i *)(row + j + 1))),
+          _mm256_loadu_si256((const __m256i *)(row + j + 2)));
+      _mm256_storeu_si256((__m256i *)(row + j), sum);
+    }
+  }
+
+  for (i = 0; i < block_height; i++) {
+    const uint32_t *const row = diff_sq + i * TF_DIFF_SQ_STRIDE;
+    const uint32_t *const row_mult =
+        mult[i == 0 || i == block_height - 1 ? 0 : 1];
+    for (j = 0; j < block_width; j += 8) {
+      const int k = i * block_width + j;
+      const __m256i sum = _mm256_add_epi32(
+          _mm256_add_epi32(
+              _mm256_loadu_si256((const __m256i *)(row + j)),
+              _mm256_loadu_si256(
+                  (const __m256i *)(row + TF_DIFF_SQ_STRIDE + j))),
+          _mm256_loadu_si256(
+              (const __m256i *)(row + 2 * TF_DIFF_SQ_STRIDE + j)));
+      const __m256i pixel =
+          load_pixels(offset_pixels(frame2, k, highbd), highbd);
+      __m256i modifier, acc;
+      __m128i cnt;
+
+      // sum * 3 / index
+      modifier = mulhi_epu32(
+          sum, _mm256_load_si256((const __m256i *)(row_mult + j)));
+      modifier =
+          _mm256_srl_epi32(_mm256_add_epi32(modifier, rounding), shift);
+      modifier = _mm256_min_epu32(modifier, sixteen);
+      modifier =
+          _mm256_mullo_epi32(_mm256_sub_epi32(sixteen, modifier), weight);
+
+      cnt = _mm_add_epi16(
+          _mm_loadu_si128((const __m128i *)(count + k)),
+          _mm_packus_epi32(_mm256_castsi256_si128(modifier),
+                           _mm256_extracti128_si256(modifier, 1)));
+      _mm_storeu_si128((__m128i *)(count + k), cnt);
+
+      acc = _mm256_add_epi32(
+          _mm256_loadu_si256((const __m256i *)(accumulator + k)),
+          _mm256_mullo_epi32(modifier, pixel));
+      _mm256_storeu_si256((__m256i *)(accumulator + k), acc);
+    }
+  }
+}
+
+void av1_temporal_filter_apply_avx2(uint8_t *frame1, unsigned int stride,
+                                    uint8_t *frame2, unsigned int block_width,
+                                    unsigned int block_height, int strength,
+                                    int filter_weight,
+                                    unsigned int *accumulator,
+                                    uint16_t *count) {
+  if (!temporal_filter_simd_size(block_width, block_height, 8)) {
+    av1_temporal_filter_apply_c(frame1, stride, frame2, block_width,
+                                block_height, strength, filter_weight,
+                                accumulator, count);
+    return;
+  }
+  temporal_filter_apply_avx2(frame1, stride, frame2, block_width, block_height,
+                             strength, filter_weight, accumulator, count, 0);
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+void av1_highbd_temporal_filter_apply_avx2(
+    uint8_t *frame1, unsigned int stride, uint8_t *frame2,
+    unsigned int block_width, unsigned int block_height, int strength,
+    int filter_weight, unsigned int *accumulator, uint16_t *count) {
+  if (!temporal_filter_simd_size(block_width, block_height, 8)) {
+    av1_highbd_temporal_filter_apply_c(frame1, stride, frame2, block_width,
+                                       block_height, strength, filter_weight,
+                                       accumulator, count);
+    return;
+  }
+  temporal_filter_apply_avx2(frame1, stride, frame2, block_width, block_height,
+                             strength, filter_weight, accumulator, count, 1);
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
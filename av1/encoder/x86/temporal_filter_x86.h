@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_X86_TEMPORAL_FILTER_X86_H_
+#define AV1_ENCODER_X86_TEMPORAL_FILTER_X86_H_
+
+#include "./aom_config.h"
+#include "aom/aom_integer.h"
+#include "aom_ports/mem.h"
+
+// The filter is applied to 16x16 luma and at most 16x16 chroma blocks.
+#define TF_MAX_BLOCK_SIZE 16
+// The squared differences are kept with a border of one zero on each side.
+#define TF_DIFF_SQ_STRIDE 24
+#define TF_DIFF_SQ_SIZE ((TF_MAX_BLOCK_SIZE + 2) * TF_DIFF_SQ_STRIDE)
+
+// Returns whether the SIMD versions, which process 'lanes' pixels at a time,
+// handle this block size. The others are left to the C version.
+static INLINE int temporal_filter_simd_size(unsigned int block_width,
+                                            unsigned int block_height,
+                                            unsigned int lanes) {
+  return block_width % lanes == 0 && block_width <= TF_MAX_BLOCK_SIZE &&
+         block_height >= 2 && block_height <= TF_MAX_BLOCK_SIZE;
+}
+
+// The C version computes the modifier as sum * 3 / index, where index is the
+// number of pixels of the 3x3 neighbourhood inside the block: 4 in the
+// corners, 6 along the edges and 9 elsewhere. This is the same as the high 32
+// bits of sum * mult for these multipliers, as sum is below 2^31.
+// mult[0] is for the first and last rows, and mult[1] for the others.
+static INLINE void temporal_filter_init_mult(
+    uint32_t mult[2][TF_MAX_BLOCK_SIZE], unsigned int block_width) {
+  const uint32_t mult_4 = 0xc0000000;  // 3 / 4
+  const uint32_t mult_6 = 0x80000000;  // 3 / 6
+  const uint32_t mult_9 = 0x55555556;  // 3 / 9, rounded up
+  unsigned int j;
+
+  for (j = 0; j < block_width; j++) {
+    const int edge_col = j == 0 || j == block_width - 1;
+    mult[0][j] = edge_col ? mult_4 : mult_6;
+    mult[1][j] = edge_col ? mult_6 : mult_9;
+  }
+}
+
+#endif  // AV1_ENCODER_X86_TEMPORAL_FILTER_X86_H_
@@ -13,7 +13,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "aom_ports/aom_timer.h"
 #include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
 #include "test/util.h"
 #include "test/av1_txfm_test.h"
 #include "av1/common/av1_txfm.h"
@@ -175,5 +178,108 @@ const AV1FwdTxfm2dParam av1_fwd_txfm2d_param_c[] = {
 INSTANTIATE_TEST_CASE_P(C, AV1FwdTxfm2d,
                         ::testing::ValuesIn(av1_fwd_txfm2d_param_c));
 
+#if CONFIG_TX64X64
+// SIMD versions checked against their C counterparts.
+// ref_func, test_func, tx_type, txfm1d_size
+typedef std::tr1::tuple<Fwd_Txfm2d_Func, Fwd_Txfm2d_Func, TX_TYPE, int>
+    AV1FwdTxfm2dSimdParam;
+
+class AV1FwdTxfm2dSimd
+    : public ::testing::TestWithParam<AV1FwdTxfm2dSimdParam> {
+ public:
+  virtual void SetUp() {
+    ref_txfm_ = GET_PARAM(0);
+    txfm_ = GET_PARAM(1);
+    tx_type_ = GET_PARAM(2);
+    txfm1d_size_ = GET_PARAM(3);
+    txfm2d_size_ = txfm1d_size_ * txfm1d_size_;
+    input_ = reinterpret_cast<int16_t *>(
+        aom_memalign(16, sizeof(input_[0]) * txfm2d_size_));
+    output_ = reinterpret_cast<int32_t *>(
+        aom_memalign(16, sizeof(output_[0]) * txfm2d_size_));
+    ref_output_ = reinterpret_cast<int32_t *>(
+        aom_memalign(16, sizeof(ref_output_[0]) * txfm2d_size_));
+  }
+
+  virtual void TearDown() {
+    aom_free(input_);
+    aom_free(output_);
+    aom_free(ref_output_);
+    libaom_test::ClearSystemState();
+  }
+
+  void RunBitexactCheck() {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    for (int ci = 0; ci < 200; ci++) {
+      const int bit_depth = 8 + 2 * (ci % 3);
+      const int mask = (1 << bit_depth) - 1;
+      for (int ni = 0; ni < txfm2d_size_; ++ni)
+        input_[ni] = (rnd.Rand16() & mask) - (rnd.Rand16() & mask);
+
+      ref_txfm_(input_, ref_output_, txfm1d_size_, tx_type_, bit_depth);
+      ASM_REGISTER_STATE_CHECK(
+          txfm_(input_, output_, txfm1d_size_, tx_type_, bit_depth));
+      for (int ni = 0; ni < txfm2d_size_; ++ni)
+        ASSERT_EQ(ref_output_[ni], output_[ni])
+            << "Not bit-exact at index " << ni << " in block " << ci;
+    }
+  }
+
+  void RunSpeedTest() {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    const int num_loops = 2000;
+    aom_usec_timer ref_timer, timer;
+
+    for (int ni = 0; ni < txfm2d_size_; ++ni)
+      input_[ni] = (rnd.Rand16() & 1023) - (rnd.Rand16() & 1023);
+
+    aom_usec_timer_start(&ref_timer);
+    for (int i = 0; i < num_loops; ++i)
+      ref_txfm_(input_, ref_output_, txfm1d_size_, tx_type_, 10);
+    aom_usec_timer_mark(&ref_timer);
+    const int ref_time = static_cast<int>(aom_usec_timer_elapsed(&ref_timer));
+
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < num_loops; ++i)
+      txfm_(input_, output_, txfm1d_size_, tx_type_, 10);
+    aom_usec_timer_mark(&timer);
+    const int simd_time = static_cast<int>(aom_usec_timer_elapsed(&timer));
+
+    printf("%dx%d: c_time=%d \t simd_time=%d \t gain=%f\n", txfm1d_size_,
+           txfm1d_size_, ref_time, simd_time,
+           static_cast<double>(ref_time) / AOMMAX(simd_time, 1));
+  }
+
+ private:
+  Fwd_Txfm2d_Func ref_txfm_;
+  Fwd_Txfm2d_Func txfm_;
+  TX_TYPE tx_type_;
+  int txfm1d_size_;
+  int txfm2d_size_;
+  int16_t *input_;
+  int32_t *output_;
+  int32_t *ref_output_;
+};
+
+TEST_P(AV1FwdTxfm2dSimd, BitexactCheck) { RunBitexactCheck(); }
+TEST_P(AV1FwdTxfm2dSimd, DISABLED_Speed) { RunSpeedTest(); }
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, AV1FwdTxfm2dSimd,
+    ::testing::Values(AV1FwdTxfm2dSimdParam(&av1_fwd_txfm2d_64x64_c,
+                                            &av1_fwd_txfm2d_64x64_sse4_1,
+                                            DCT_DCT, 64)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1FwdTxfm2dSimd,
+    ::testing::Values(AV1FwdTxfm2dSimdParam(&av1_fwd_txfm2d_64x64_c,
+                                            &av1_fwd_txfm2d_64x64_avx2,
+                                            DCT_DCT, 64)));
+#endif  // HAVE_AVX2
+#endif  // CONFIG_TX64X64
+
 #endif  // CONFIG_AOM_HIGHBITDEPTH
 }  // namespace
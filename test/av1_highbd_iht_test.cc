@@ -18,6 +18,7 @@
 #include "test/util.h"
 #include "av1/common/enums.h"
 #include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/aom_timer.h"
 #include "aom_ports/mem.h"
 
 namespace {
@@ -88,6 +89,8 @@ class AV1HighbdInvHTNxN : public ::testing::TestWithParam<IHbdHtParam> {
       return 16;
     } else if (1024 == num_coeffs_) {
       return 32;
+    } else if (4096 == num_coeffs_) {
+      return 64;
     } else {
       return 0;
     }
@@ -232,5 +235,364 @@ const IHbdHtParam kArrayIhtParam32x32[] = {
 INSTANTIATE_TEST_CASE_P(AVX2, AV1HighbdInvHTNxN,
                         ::testing::ValuesIn(kArrayIhtParam32x32));
 
+#if CONFIG_TX64X64
+#define PARAM_LIST_64X64                                   \
+  &av1_fwd_txfm2d_64x64_c, &av1_inv_txfm2d_add_64x64_avx2, \
+      &av1_inv_txfm2d_add_64x64_c, 4096
+
+const IHbdHtParam kArrayIhtParam64x64[] = {
+  // 64x64
+  make_tuple(PARAM_LIST_64X64, DCT_DCT, 10),
+  make_tuple(PARAM_LIST_64X64, DCT_DCT, 12),
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2_64X64, AV1HighbdInvHTNxN,
+                        ::testing::ValuesIn(kArrayIhtParam64x64));
+#endif  // CONFIG_TX64X64
+
+#endif  // HAVE_AVX2 && CONFIG_AOM_HIGHBITDEPTH
+
+// Hybrid inverse transforms av1_highbd_iht*_add, checked against their C
+// versions for every tx_type.
+typedef void (*HbdFhtFunc)(const int16_t *input, tran_low_t *output,
+                           int stride, int tx_type);
+
+typedef void (*HbdIhtFunc)(const tran_low_t *input, uint8_t *dest, int stride,
+                           int tx_type, int bd);
+
+// Test parameter argument list:
+//   <forward transform function,
+//    inverse transform reference function,
+//    optimized inverse transform function,
+//    width,
+//    height,
+//    bit_depth>
+typedef tuple<HbdFhtFunc, HbdIhtFunc, HbdIhtFunc, int, int, int> HbdIhtParam;
+
+class AV1HighbdInvHtTest : public ::testing::TestWithParam<HbdIhtParam> {
+ public:
+  virtual ~AV1HighbdInvHtTest() {}
+
+  virtual void SetUp() {
+    fht_ = GET_PARAM(0);
+    iht_ref_ = GET_PARAM(1);
+    iht_ = GET_PARAM(2);
+    width_ = GET_PARAM(3);
+    height_ = GET_PARAM(4);
+    bit_depth_ = GET_PARAM(5);
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  // Not the width of any transform, to catch stride errors
+  static const int kStride = 48;
+
+  void FillCoeffs(ACMRandom *rnd, int block, int16_t *input,
+                  tran_low_t *coeffs, int tx_type) const;
+
+  HbdFhtFunc fht_;
+  HbdIhtFunc iht_ref_;
+  HbdIhtFunc iht_;
+  int width_;
+  int height_;
+  int bit_depth_;
+};
+
+void AV1HighbdInvHtTest::FillCoeffs(ACMRandom *rnd, int block, int16_t *input,
+                                    tran_low_t *coeffs, int tx_type) const {
+  const int num_coeffs = width_ * height_;
+  const int mask = (1 << bit_depth_) - 1;
+  if (block % 4 == 3) {
+    // Arbitrary coefficients, well past what the forward transform produces
+    const int range = 1 << (bit_depth_ + 6);
+    for (int j = 0; j < num_coeffs; ++j)
+      coeffs[j] = (int)(rnd->Rand31() % (2 * range + 1)) - range;
+    return;
+  }
+  // Residuals at full range, with the first blocks at the extremes
+  for (int j = 0; j < num_coeffs; ++j) {
+    if (block == 0)
+      input[j] = mask;
+    else if (block == 1)
+      input[j] = -mask;
+    else
+      input[j] = (rnd->Rand16() & mask) - (rnd->Rand16() & mask);
+  }
+  fht_(input, coeffs, width_, tx_type);
+  // Coarsely quantize some blocks, as a decoder would see them
+  if (block % 4 == 2) {
+    for (int j = 0; j < num_coeffs; ++j) coeffs[j] = coeffs[j] / 64 * 64;
+  }
+}
+
+TEST_P(AV1HighbdInvHtTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int count_test_block = 200;
+  const int mask = (1 << bit_depth_) - 1;
+  DECLARE_ALIGNED(16, int16_t, input[32 * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, coeffs[32 * 32]);
+  DECLARE_ALIGNED(16, uint16_t, dst_ref[kStride * 32]);
+  DECLARE_ALIGNED(16, uint16_t, dst[kStride * 32]);
+
+  for (int tx_type = 0; tx_type < TX_TYPES; ++tx_type) {
+    for (int i = 0; i < count_test_block; ++i) {
+      FillCoeffs(&rnd, i, input, coeffs, tx_type);
+      for (int j = 0; j < kStride * height_; ++j)
+        dst_ref[j] = dst[j] = rnd.Rand16() & mask;
+
+      iht_ref_(coeffs, CONVERT_TO_BYTEPTR(dst_ref), kStride, tx_type,
+               bit_depth_);
+      ASM_REGISTER_STATE_CHECK(
+          iht_(coeffs, CONVERT_TO_BYTEPTR(dst), kStride, tx_type, bit_depth_));
+
+      for (int r = 0; r < height_; ++r) {
+        for (int c = 0; c < width_; ++c) {
+          ASSERT_EQ(dst_ref[r * kStride + c], dst[r * kStride + c])
+              << width_ << "x" << height_ << " tx_type " << tx_type
+              << " block " << i << " at " << r << "," << c;
+        }
+      }
+    }
+  }
+}
+
+TEST_P(AV1HighbdInvHtTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int num_iterations = (1 << 20) / (width_ * height_);
+  const int mask = (1 << bit_depth_) - 1;
+  DECLARE_ALIGNED(16, int16_t, input[32 * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, coeffs[32 * 32]);
+  DECLARE_ALIGNED(16, uint16_t, dst[kStride * 32]);
+
+  for (int j = 0; j < kStride * height_; ++j) dst[j] = rnd.Rand16() & mask;
+
+  for (int tx_type = 0; tx_type < TX_TYPES; ++tx_type) {
+    FillCoeffs(&rnd, 2, input, coeffs, tx_type);
+
+    aom_usec_timer ref_timer;
+    aom_usec_timer_start(&ref_timer);
+    for (int i = 0; i < num_iterations; ++i)
+      iht_ref_(coeffs, CONVERT_TO_BYTEPTR(dst), kStride, tx_type, bit_depth_);
+    aom_usec_timer_mark(&ref_timer);
+    const int ref_elapsed_time = (int)aom_usec_timer_elapsed(&ref_timer);
+
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < num_iterations; ++i)
+      iht_(coeffs, CONVERT_TO_BYTEPTR(dst), kStride, tx_type, bit_depth_);
+    aom_usec_timer_mark(&timer);
+    const int elapsed_time = (int)aom_usec_timer_elapsed(&timer);
+
+    printf("[          ] %dx%d tx_type %2d: C time = %d us, SIMD time = %d us"
+           "\n",
+           width_, height_, tx_type, ref_elapsed_time, elapsed_time);
+  }
+}
+
+#if HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH
+#define HBD_IHT_PARAMS_SSE4_1(w, h, n)                                  \
+  make_tuple(&av1_highbd_fht##w##x##h##_c,                              \
+             &av1_highbd_iht##w##x##h##_##n##_add_c,                    \
+             &av1_highbd_iht##w##x##h##_##n##_add_sse4_1, w, h, 10),    \
+      make_tuple(&av1_highbd_fht##w##x##h##_c,                          \
+                 &av1_highbd_iht##w##x##h##_##n##_add_c,                \
+                 &av1_highbd_iht##w##x##h##_##n##_add_sse4_1, w, h, 12)
+
+const HbdIhtParam kHbdIhtParamsSse4_1[] = {
+  HBD_IHT_PARAMS_SSE4_1(4, 4, 16),    HBD_IHT_PARAMS_SSE4_1(4, 8, 32),
+  HBD_IHT_PARAMS_SSE4_1(8, 4, 32),    HBD_IHT_PARAMS_SSE4_1(4, 16, 64),
+  HBD_IHT_PARAMS_SSE4_1(16, 4, 64),   HBD_IHT_PARAMS_SSE4_1(8, 8, 64),
+  HBD_IHT_PARAMS_SSE4_1(8, 16, 128),  HBD_IHT_PARAMS_SSE4_1(16, 8, 128),
+  HBD_IHT_PARAMS_SSE4_1(8, 32, 256),  HBD_IHT_PARAMS_SSE4_1(32, 8, 256),
+  HBD_IHT_PARAMS_SSE4_1(16, 16, 256), HBD_IHT_PARAMS_SSE4_1(16, 32, 512),
+  HBD_IHT_PARAMS_SSE4_1(32, 16, 512),
+#if CONFIG_EXT_TX
+  HBD_IHT_PARAMS_SSE4_1(32, 32, 1024),
+#endif  // CONFIG_EXT_TX
+};
+
+INSTANTIATE_TEST_CASE_P(SSE4_1, AV1HighbdInvHtTest,
+                        ::testing::ValuesIn(kHbdIhtParamsSse4_1));
+#endif  // HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH
+
+#if HAVE_AVX2 && CONFIG_AOM_HIGHBITDEPTH
+#define HBD_IHT_PARAMS_AVX2(w, h, n)                                  \
+  make_tuple(&av1_highbd_fht##w##x##h##_c,                            \
+             &av1_highbd_iht##w##x##h##_##n##_add_c,                  \
+             &av1_highbd_iht##w##x##h##_##n##_add_avx2, w, h, 10),    \
+      make_tuple(&av1_highbd_fht##w##x##h##_c,                        \
+                 &av1_highbd_iht##w##x##h##_##n##_add_c,              \
+                 &av1_highbd_iht##w##x##h##_##n##_add_avx2, w, h, 12)
+
+const HbdIhtParam kHbdIhtParamsAvx2[] = {
+  HBD_IHT_PARAMS_AVX2(8, 8, 64),    HBD_IHT_PARAMS_AVX2(8, 16, 128),
+  HBD_IHT_PARAMS_AVX2(16, 8, 128),  HBD_IHT_PARAMS_AVX2(8, 32, 256),
+  HBD_IHT_PARAMS_AVX2(32, 8, 256),  HBD_IHT_PARAMS_AVX2(16, 16, 256),
+  HBD_IHT_PARAMS_AVX2(16, 32, 512), HBD_IHT_PARAMS_AVX2(32, 16, 512),
+#if CONFIG_EXT_TX
+  HBD_IHT_PARAMS_AVX2(32, 32, 1024),
+#endif  // CONFIG_EXT_TX
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2, AV1HighbdInvHtTest,
+                        ::testing::ValuesIn(kHbdIhtParamsAvx2));
+#endif  // HAVE_AVX2 && CONFIG_AOM_HIGHBITDEPTH
+
+// Hybrid forward transforms av1_highbd_fht*, checked against their C versions
+// for every tx_type.
+// Test parameter argument list:
+//   <forward transform reference function,
+//    optimized forward transform function,
+//    width,
+//    height,
+//    bit_depth>
+typedef tuple<HbdFhtFunc, HbdFhtFunc, int, int, int> HbdFhtParam;
+
+class AV1HighbdFwdHtTest : public ::testing::TestWithParam<HbdFhtParam> {
+ public:
+  virtual ~AV1HighbdFwdHtTest() {}
+
+  virtual void SetUp() {
+    fht_ref_ = GET_PARAM(0);
+    fht_ = GET_PARAM(1);
+    width_ = GET_PARAM(2);
+    height_ = GET_PARAM(3);
+    bit_depth_ = GET_PARAM(4);
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  static const int kStride = 48;
+
+  HbdFhtFunc fht_ref_;
+  HbdFhtFunc fht_;
+  int width_;
+  int height_;
+  int bit_depth_;
+};
+
+TEST_P(AV1HighbdFwdHtTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int count_test_block = 200;
+  const int mask = (1 << bit_depth_) - 1;
+  const int num_coeffs = width_ * height_;
+  DECLARE_ALIGNED(16, int16_t, input[kStride * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, coeffs_ref[32 * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, coeffs[32 * 32]);
+
+  for (int tx_type = 0; tx_type < TX_TYPES; ++tx_type) {
+    for (int i = 0; i < count_test_block; ++i) {
+      // Residuals at full range, with the first blocks at the extremes
+      for (int j = 0; j < kStride * height_; ++j) {
+        if (i == 0)
+          input[j] = mask;
+        else if (i == 1)
+          input[j] = -mask;
+        else if (i == 2)
+          input[j] = (j & 1) ? mask : -mask;
+        else
+          input[j] = (rnd.Rand16() & mask) - (rnd.Rand16() & mask);
+      }
+
+      fht_ref_(input, coeffs_ref, kStride, tx_type);
+      ASM_REGISTER_STATE_CHECK(fht_(input, coeffs, kStride, tx_type));
+
+      for (int j = 0; j < num_coeffs; ++j) {
+        ASSERT_EQ(coeffs_ref[j], coeffs[j])
+            << width_ << "x" << height_ << " tx_type " << tx_type << " block "
+            << i << " at " << j;
+      }
+    }
+  }
+}
+
+TEST_P(AV1HighbdFwdHtTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int num_iterations = (1 << 20) / (width_ * height_);
+  const int mask = (1 << bit_depth_) - 1;
+  DECLARE_ALIGNED(16, int16_t, input[kStride * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, coeffs[32 * 32]);
+
+  for (int j = 0; j < kStride * height_; ++j)
+    input[j] = (rnd.Rand16() & mask) - (rnd.Rand16() & mask);
+
+  for (int tx_type = 0; tx_type < TX_TYPES; ++tx_type) {
+    aom_usec_timer ref_timer;
+    aom_usec_timer_start(&ref_timer);
+    for (int i = 0; i < num_iterations; ++i)
+      fht_ref_(input, coeffs, kStride, tx_type);
+    aom_usec_timer_mark(&ref_timer);
+    const int ref_elapsed_time = (int)aom_usec_timer_elapsed(&ref_timer);
+
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < num_iterations; ++i)
+      fht_(input, coeffs, kStride, tx_type);
+    aom_usec_timer_mark(&timer);
+    const int elapsed_time = (int)aom_usec_timer_elapsed(&timer);
+
+    printf("[          ] %dx%d tx_type %2d: C time = %d us, SIMD time = %d us"
+           "\n",
+           width_, height_, tx_type, ref_elapsed_time, elapsed_time);
+  }
+}
+
+#if HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH
+#define HBD_FHT_PARAMS(w, h, opt)                                     \
+  make_tuple(&av1_highbd_fht##w##x##h##_c,                            \
+             &av1_highbd_fht##w##x##h##_##opt, w, h, 10),             \
+      make_tuple(&av1_highbd_fht##w##x##h##_c,                        \
+                 &av1_highbd_fht##w##x##h##_##opt, w, h, 12)
+
+const HbdFhtParam kHbdFhtParamsSse4_1[] = {
+  HBD_FHT_PARAMS(4, 4, sse4_1),   HBD_FHT_PARAMS(4, 8, sse4_1),
+  HBD_FHT_PARAMS(8, 4, sse4_1),   HBD_FHT_PARAMS(4, 16, sse4_1),
+  HBD_FHT_PARAMS(16, 4, sse4_1),  HBD_FHT_PARAMS(8, 8, sse4_1),
+  HBD_FHT_PARAMS(8, 16, sse4_1),  HBD_FHT_PARAMS(16, 8, sse4_1),
+  HBD_FHT_PARAMS(8, 32, sse4_1),  HBD_FHT_PARAMS(32, 8, sse4_1),
+  HBD_FHT_PARAMS(16, 16, sse4_1), HBD_FHT_PARAMS(16, 32, sse4_1),
+  HBD_FHT_PARAMS(32, 16, sse4_1), HBD_FHT_PARAMS(32, 32, sse4_1),
+};
+
+INSTANTIATE_TEST_CASE_P(SSE4_1, AV1HighbdFwdHtTest,
+                        ::testing::ValuesIn(kHbdFhtParamsSse4_1));
+
+TEST(AV1HighbdFwhtTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, input[4 * 8]);
+  DECLARE_ALIGNED(16, tran_low_t, coeffs_ref[4 * 4]);
+  DECLARE_ALIGNED(16, tran_low_t, coeffs[4 * 4]);
+
+  for (int bd = 10; bd <= 12; bd += 2) {
+    const int mask = (1 << bd) - 1;
+    for (int i = 0; i < 10000; ++i) {
+      for (int j = 0; j < 4 * 8; ++j) {
+        if (i < 2)
+          input[j] = i ? -mask : mask;
+        else
+          input[j] = (rnd.Rand16() & mask) - (rnd.Rand16() & mask);
+      }
+      av1_highbd_fwht4x4_c(input, coeffs_ref, 8);
+      ASM_REGISTER_STATE_CHECK(av1_highbd_fwht4x4_sse4_1(input, coeffs, 8));
+      for (int j = 0; j < 4 * 4; ++j)
+        ASSERT_EQ(coeffs_ref[j], coeffs[j]) << "block " << i << " at " << j;
+    }
+  }
+}
+#endif  // HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH
+
+#if HAVE_AVX2 && CONFIG_AOM_HIGHBITDEPTH
+const HbdFhtParam kHbdFhtParamsAvx2[] = {
+  HBD_FHT_PARAMS(8, 8, avx2),   HBD_FHT_PARAMS(8, 16, avx2),
+  HBD_FHT_PARAMS(16, 8, avx2),  HBD_FHT_PARAMS(8, 32, avx2),
+  HBD_FHT_PARAMS(32, 8, avx2),  HBD_FHT_PARAMS(16, 16, avx2),
+  HBD_FHT_PARAMS(16, 32, avx2), HBD_FHT_PARAMS(32, 16, avx2),
+  HBD_FHT_PARAMS(32, 32, avx2),
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2, AV1HighbdFwdHtTest,
+                        ::testing::ValuesIn(kHbdFhtParamsAvx2));
 #endif  // HAVE_AVX2 && CONFIG_AOM_HIGHBITDEPTH
 }  // namespace
@@ -278,5 +278,104 @@ INSTANTIATE_TEST_CASE_P(
                                  &aom_idct8x8_1_add_c, TX_8X8, 1),
                       make_tuple(&aom_fdct4x4_c, &aom_idct4x4_16_add_c,
                                  &aom_idct4x4_1_add_c, TX_4X4, 1)));
+
+// Hybrid inverse transforms, checked against their C versions for every
+// tx_type, on coefficients from the C forward transform.
+typedef void (*FhtFunc)(const int16_t *in, tran_low_t *out, int stride,
+                        int tx_type);
+typedef void (*IhtFunc)(const tran_low_t *in, uint8_t *out, int stride,
+                        int tx_type);
+typedef std::tr1::tuple<FhtFunc, IhtFunc, IhtFunc, int, int> IhtParam;
+
+class AV1InvHtTest : public ::testing::TestWithParam<IhtParam> {
+ public:
+  virtual ~AV1InvHtTest() {}
+  virtual void SetUp() {
+    fht_ = GET_PARAM(0);
+    iht_ref_ = GET_PARAM(1);
+    iht_ = GET_PARAM(2);
+    width_ = GET_PARAM(3);
+    height_ = GET_PARAM(4);
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  FhtFunc fht_;
+  IhtFunc iht_ref_;
+  IhtFunc iht_;
+  int width_;
+  int height_;
+};
+
+TEST_P(AV1InvHtTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  // Not the width of any transform, to catch stride errors
+  const int kStride = 48;
+  const int count_test_block = 200;
+  const int num_coeffs = width_ * height_;
+  DECLARE_ALIGNED(16, int16_t, input[32 * 32]);
+  DECLARE_ALIGNED(16, tran_low_t, coeffs[32 * 32]);
+  DECLARE_ALIGNED(16, uint8_t, dst_ref[kStride * 32]);
+  DECLARE_ALIGNED(16, uint8_t, dst[kStride * 32]);
+
+  for (int tx_type = 0; tx_type < TX_TYPES; ++tx_type) {
+    for (int i = 0; i < count_test_block; ++i) {
+      // Residuals in [-255, 255], with the first blocks at the extremes
+      for (int j = 0; j < num_coeffs; ++j) {
+        if (i == 0)
+          input[j] = 255;
+        else if (i == 1)
+          input[j] = -255;
+        else
+          input[j] = rnd.Rand8() - rnd.Rand8();
+      }
+      fht_(input, coeffs, width_, tx_type);
+      // Coarsely quantize every other block, as a decoder would see it
+      if (i & 1) {
+        for (int j = 0; j < num_coeffs; ++j) coeffs[j] = coeffs[j] / 64 * 64;
+      }
+      for (int j = 0; j < kStride * height_; ++j)
+        dst_ref[j] = dst[j] = rnd.Rand8();
+
+      iht_ref_(coeffs, dst_ref, kStride, tx_type);
+      ASM_REGISTER_STATE_CHECK(iht_(coeffs, dst, kStride, tx_type));
+
+      for (int r = 0; r < height_; ++r) {
+        for (int c = 0; c < width_; ++c) {
+          ASSERT_EQ(dst_ref[r * kStride + c], dst[r * kStride + c])
+              << width_ << "x" << height_ << " tx_type " << tx_type
+              << " block " << i << " at " << r << "," << c;
+        }
+      }
+    }
+  }
+}
+
+#if HAVE_SSE2
+const IhtParam kIhtParamsSse2[] = {
+  make_tuple(&av1_fht4x16_c, &av1_iht4x16_64_add_c, &av1_iht4x16_64_add_sse2,
+             4, 16),
+  make_tuple(&av1_fht16x4_c, &av1_iht16x4_64_add_c, &av1_iht16x4_64_add_sse2,
+             16, 4),
+  make_tuple(&av1_fht8x32_c, &av1_iht8x32_256_add_c, &av1_iht8x32_256_add_sse2,
+             8, 32),
+  make_tuple(&av1_fht32x8_c, &av1_iht32x8_256_add_c, &av1_iht32x8_256_add_sse2,
+             32, 8),
+#if CONFIG_EXT_TX
+  make_tuple(&av1_fht32x32_c, &av1_iht32x32_1024_add_c,
+             &av1_iht32x32_1024_add_sse2, 32, 32),
+#endif  // CONFIG_EXT_TX
+};
+INSTANTIATE_TEST_CASE_P(SSE2, AV1InvHtTest,
+                        ::testing::ValuesIn(kIhtParamsSse2));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2 && CONFIG_EXT_TX
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1InvHtTest,
+    ::testing::Values(make_tuple(&av1_fht32x32_c, &av1_iht32x32_1024_add_c,
+                                 &av1_iht32x32_1024_add_avx2, 32, 32)));
+#endif  // HAVE_AVX2 && CONFIG_EXT_TX
 #endif  // CONFIG_AV1_ENCODER
 }  // namespace
@@ -17,6 +17,11 @@
 #include "test/acm_random.h"
 #include "test/clear_system_state.h"
 #include "test/register_state_check.h"
+#include "test/util.h"
+#include "aom_ports/aom_timer.h"
+#include "av1/common/common_data.h"
+#include "av1/common/entropy.h"
+#include "av1/common/quant_common.h"
 #include "av1/common/scan.h"
 
 namespace {
@@ -40,7 +45,11 @@ struct QuantizeFuncParams {
 using libaom_test::ACMRandom;
 
 const int numTests = 1000;
+#if CONFIG_TX64X64
+const int maxSize = 4096;
+#else
 const int maxSize = 1024;
+#endif  // CONFIG_TX64X64
 const int roundFactorRange = 127;
 const int dequantRange = 32768;
 const int coeffRange = (1 << 20) - 1;
@@ -66,7 +75,7 @@ class AV1QuantizeTest : public ::testing::TestWithParam<QuantizeFuncParams> {
     int skip_block = 0;
     int count = params_.coeffCount;
     const TX_SIZE txSize = getTxSize(count);
-    int log_scale = (txSize == TX_32X32);
+    int log_scale = getLogScale(txSize);
     QuantizeFpFunc quanFunc = params_.qFunc;
     QuantizeFpFunc quanFuncRef = params_.qFuncRef;
 
@@ -134,7 +143,7 @@ class AV1QuantizeTest : public ::testing::TestWithParam<QuantizeFuncParams> {
     int skip_block = 0;
     int count = params_.coeffCount;
     const TX_SIZE txSize = getTxSize(count);
-    int log_scale = (txSize == TX_32X32);
+    int log_scale = getLogScale(txSize);
     QuantizeFpFunc quanFunc = params_.qFunc;
     QuantizeFpFunc quanFuncRef = params_.qFuncRef;
     const SCAN_ORDER scanOrder = av1_default_scan_orders[txSize];
@@ -171,6 +180,56 @@ class AV1QuantizeTest : public ::testing::TestWithParam<QuantizeFuncParams> {
     }
   }
 
+  void RunSpeedTest() {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    DECLARE_ALIGNED(16, tran_low_t, coeff_ptr[maxSize]);
+    DECLARE_ALIGNED(16, int16_t, zbin_ptr[2]);
+    DECLARE_ALIGNED(16, int16_t, round_ptr[2]);
+    DECLARE_ALIGNED(16, int16_t, quant_ptr[2]);
+    DECLARE_ALIGNED(16, int16_t, quant_shift_ptr[2]);
+    DECLARE_ALIGNED(16, tran_low_t, qcoeff_ptr[maxSize]);
+    DECLARE_ALIGNED(16, tran_low_t, dqcoeff_ptr[maxSize]);
+    DECLARE_ALIGNED(16, int16_t, dequant_ptr[2]);
+    uint16_t eob;
+    const int count = params_.coeffCount;
+    const TX_SIZE txSize = getTxSize(count);
+    const int log_scale = getLogScale(txSize);
+    const int num_iterations = (1 << 22) / count;
+    const SCAN_ORDER scanOrder = av1_default_scan_orders[txSize];
+
+    for (int j = 0; j < count; j++) coeff_ptr[j] = rnd(coeffRange);
+    for (int j = 0; j < 2; j++) {
+      zbin_ptr[j] = rnd.Rand16();
+      quant_shift_ptr[j] = rnd.Rand16();
+      dequant_ptr[j] = 1 + abs(rnd(dequantRange - 1));
+      quant_ptr[j] = (1 << 16) / dequant_ptr[j];
+      round_ptr[j] = (abs(rnd(roundFactorRange)) * dequant_ptr[j]) >> 7;
+    }
+
+    aom_usec_timer ref_timer;
+    aom_usec_timer_start(&ref_timer);
+    for (int i = 0; i < num_iterations; ++i) {
+      params_.qFuncRef(coeff_ptr, count, 0, zbin_ptr, round_ptr, quant_ptr,
+                       quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                       &eob, scanOrder.scan, scanOrder.iscan, log_scale);
+    }
+    aom_usec_timer_mark(&ref_timer);
+    const int ref_elapsed_time = (int)aom_usec_timer_elapsed(&ref_timer);
+
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < num_iterations; ++i) {
+      params_.qFunc(coeff_ptr, count, 0, zbin_ptr, round_ptr, quant_ptr,
+                    quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                    &eob, scanOrder.scan, scanOrder.iscan, log_scale);
+    }
+    aom_usec_timer_mark(&timer);
+    const int elapsed_time = (int)aom_usec_timer_elapsed(&timer);
+
+    printf("[          ] %d coeffs: C time = %d us, SIMD time = %d us\n",
+           count, ref_elapsed_time, elapsed_time);
+  }
+
   virtual void SetUp() { params_ = GetParam(); }
 
   virtual void TearDown() { libaom_test::ClearSystemState(); }
@@ -184,17 +243,31 @@ class AV1QuantizeTest : public ::testing::TestWithParam<QuantizeFuncParams> {
       case 64: return TX_8X8;
       case 256: return TX_16X16;
       case 1024: return TX_32X32;
+#if CONFIG_TX64X64
+      case 4096: return TX_64X64;
+#endif  // CONFIG_TX64X64
       default: return TX_4X4;
     }
   }
 
+  int getLogScale(TX_SIZE txSize) {
+    switch (txSize) {
+      case TX_32X32: return 1;
+#if CONFIG_TX64X64
+      case TX_64X64: return 2;
+#endif  // CONFIG_TX64X64
+      default: return 0;
+    }
+  }
+
   QuantizeFuncParams params_;
 };
 
 TEST_P(AV1QuantizeTest, BitExactCheck) { RunQuantizeTest(); }
 TEST_P(AV1QuantizeTest, EobVerify) { RunEobTest(); }
+TEST_P(AV1QuantizeTest, DISABLED_Speed) { RunSpeedTest(); }
 
-#if HAVE_SSE4_1
+#if HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH
 #if !CONFIG_AOM_QM
 INSTANTIATE_TEST_CASE_P(
     SSE4_1, AV1QuantizeTest,
@@ -207,5 +280,319 @@ INSTANTIATE_TEST_CASE_P(
                       QuantizeFuncParams(&av1_highbd_quantize_fp_sse4_1,
                                          &av1_highbd_quantize_fp_c, 1024)));
 #endif  // !CONFIG_AOM_QM
+#endif  // HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH
+
+#if HAVE_AVX2 && CONFIG_AOM_HIGHBITDEPTH
+#if !CONFIG_AOM_QM
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1QuantizeTest,
+    ::testing::Values(QuantizeFuncParams(&av1_highbd_quantize_fp_avx2,
+                                         &av1_highbd_quantize_fp_c, 16),
+                      QuantizeFuncParams(&av1_highbd_quantize_fp_avx2,
+                                         &av1_highbd_quantize_fp_c, 64),
+                      QuantizeFuncParams(&av1_highbd_quantize_fp_avx2,
+                                         &av1_highbd_quantize_fp_c, 256),
+                      QuantizeFuncParams(&av1_highbd_quantize_fp_avx2,
+                                         &av1_highbd_quantize_fp_c, 1024)
+#if CONFIG_TX64X64
+                          ,
+                      QuantizeFuncParams(&av1_highbd_quantize_fp_avx2,
+                                         &av1_highbd_quantize_fp_c, 4096)
+#endif  // CONFIG_TX64X64
+                          ));
+#endif  // !CONFIG_AOM_QM
+#endif  // HAVE_AVX2 && CONFIG_AOM_HIGHBITDEPTH
+
+#if HAVE_AVX2 && CONFIG_TX64X64 && !CONFIG_AOM_QM
+typedef void (*QuantizeFp64x64Func)(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan);
+
+// av1_quantize_fp_64x64() has the log_scale of 2 built in.
+template <QuantizeFp64x64Func fn>
+void quantize_fp_64x64_wrapper(
+    const tran_low_t *coeff_ptr, intptr_t count, int skip_block,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan, const int log_scale) {
+  (void)log_scale;
+  fn(coeff_ptr, count, skip_block, zbin_ptr, round_ptr, quant_ptr,
+     quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, scan,
+     iscan);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2_TX64, AV1QuantizeTest,
+    ::testing::Values(QuantizeFuncParams(
+        &quantize_fp_64x64_wrapper<av1_quantize_fp_64x64_avx2>,
+        &quantize_fp_64x64_wrapper<av1_quantize_fp_64x64_c>, 4096)));
+#endif  // HAVE_AVX2 && CONFIG_TX64X64 && !CONFIG_AOM_QM
+
+#if CONFIG_NEW_QUANT
+typedef void (*QuantizeNuqFunc)(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *quant_ptr, const int16_t *quant_shift_ptr,
+    const int16_t *dequant_ptr, const cuml_bins_type_nuq *cuml_bins_ptr,
+    const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const uint8_t *band);
+
+typedef void (*QuantizeFpNuqFunc)(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *quant_ptr, const int16_t *dequant_ptr,
+    const cuml_bins_type_nuq *cuml_bins_ptr,
+    const dequant_val_type_nuq *dequant_val, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const uint8_t *band);
+
+// Adapts the fp variants, which have no quant_shift, to QuantizeNuqFunc.
+template <QuantizeFpNuqFunc fn>
+void fp_nuq_wrapper(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                    int skip_block, const int16_t *quant_ptr,
+                    const int16_t *quant_shift_ptr, const int16_t *dequant_ptr,
+                    const cuml_bins_type_nuq *cuml_bins_ptr,
+                    const dequant_val_type_nuq *dequant_val,
+                    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                    uint16_t *eob_ptr, const int16_t *scan,
+                    const uint8_t *band) {
+  (void)quant_shift_ptr;
+  fn(coeff_ptr, n_coeffs, skip_block, quant_ptr, dequant_ptr, cuml_bins_ptr,
+     dequant_val, qcoeff_ptr, dqcoeff_ptr, eob_ptr, scan, band);
+}
+
+// <function to test, reference function, tx_size, bit_depth, is_fp>
+typedef std::tr1::tuple<QuantizeNuqFunc, QuantizeNuqFunc, TX_SIZE,
+                        aom_bit_depth_t, int>
+    QuantizeNuqParam;
+
+class AV1QuantizeNuqTest : public ::testing::TestWithParam<QuantizeNuqParam> {
+ public:
+  virtual ~AV1QuantizeNuqTest() {}
+
+  virtual void SetUp() {
+    quantize_ = GET_PARAM(0);
+    quantize_ref_ = GET_PARAM(1);
+    tx_size_ = GET_PARAM(2);
+    bit_depth_ = GET_PARAM(3);
+    is_fp_ = GET_PARAM(4);
+    count_ = tx_size_2d[tx_size_];
+    scan_ = av1_default_scan_orders[tx_size_].scan;
+    band_ = get_band_translate(tx_size_);
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  // Sets up the quantizer tables the way av1_init_quantizer() does.
+  void SetQuantizer(int qindex, int q_profile) {
+    for (int i = 0; i < 2; ++i) {
+      const int d = i ? av1_ac_quant(qindex, 0, bit_depth_)
+                      : av1_dc_quant(qindex, 0, bit_depth_);
+      dequant_[i] = d;
+      if (is_fp_) {
+        quant_[i] = (1 << 16) / d;
+        quant_shift_[i] = 0;
+      } else {
+        int l = 0;
+        for (unsigned int t = d; t > 1; t >>= 1) ++l;
+        quant_[i] = (int16_t)(1 + (1 << (16 + l)) / d - (1 << 16));
+        quant_shift_[i] = 1 << (16 - l);
+      }
+    }
+    for (int b = 0; b < COEF_BANDS; ++b)
+      av1_get_dequant_val_nuq(dequant_[b != 0], b, dequant_val_[b],
+                              cuml_bins_[b], q_profile);
+  }
+
+  // Mixes zeros, values around the knots and large values.
+  void FillCoeffs(ACMRandom *rnd) {
+    const int max_coeff = bit_depth_ == AOM_BITS_8 ? INT16_MAX : kMaxHbdCoeff;
+    for (int j = 0; j < count_; ++j) {
+      int v;
+      switch (rnd->Rand8() & 3) {
+        case 0: v = 0; break;
+        case 1: v = rnd->Rand31() % (4 * dequant_[1] + 1); break;
+        default: v = rnd->Rand31() % (max_coeff + 1); break;
+      }
+      coeff_[j] = (rnd->Rand8() & 1) ? -v : v;
+    }
+  }
+
+  void RunQuantize(QuantizeNuqFunc fn, tran_low_t *qcoeff,
+                   tran_low_t *dqcoeff, uint16_t *eob) {
+    fn(coeff_, count_, 0, quant_, quant_shift_, dequant_, cuml_bins_,
+       dequant_val_, qcoeff, dqcoeff, eob, scan_, band_);
+  }
+
+  void RunBitExactCheck() {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    for (int i = 0; i < kNumTests; ++i) {
+      uint16_t ref_eob = 0, eob = 0;
+      SetQuantizer(rnd(QINDEX_RANGE), rnd(QUANT_PROFILES));
+      FillCoeffs(&rnd);
+      if (i == 0) {
+        for (int j = 0; j < count_; ++j) coeff_[j] = 0;
+      } else if (i & 1) {
+        // Sparse blocks, so that the eob lands anywhere in the scan.
+        for (int j = 0; j < count_; ++j)
+          if (rnd(8)) coeff_[j] = 0;
+      }
+
+      RunQuantize(quantize_ref_, ref_qcoeff_, ref_dqcoeff_, &ref_eob);
+      ASM_REGISTER_STATE_CHECK(RunQuantize(quantize_, qcoeff_, dqcoeff_, &eob));
+
+      for (int j = 0; j < count_; ++j) {
+        ASSERT_EQ(ref_qcoeff_[j], qcoeff_[j]) << "qcoeff error: i = " << i
+                                              << " j = " << j;
+        ASSERT_EQ(ref_dqcoeff_[j], dqcoeff_[j]) << "dqcoeff error: i = " << i
+                                                << " j = " << j;
+      }
+      ASSERT_EQ(ref_eob, eob) << "eob error: i = " << i;
+    }
+  }
+
+  void RunSpeedTest() {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    const int num_iterations = (1 << 22) / count_;
+    uint16_t eob;
+    SetQuantizer(rnd(QINDEX_RANGE), 0);
+    FillCoeffs(&rnd);
+
+    aom_usec_timer ref_timer;
+    aom_usec_timer_start(&ref_timer);
+    for (int i = 0; i < num_iterations; ++i)
+      RunQuantize(quantize_ref_, ref_qcoeff_, ref_dqcoeff_, &eob);
+    aom_usec_timer_mark(&ref_timer);
+    const int ref_elapsed_time = (int)aom_usec_timer_elapsed(&ref_timer);
+
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < num_iterations; ++i)
+      RunQuantize(quantize_, qcoeff_, dqcoeff_, &eob);
+    aom_usec_timer_mark(&timer);
+    const int elapsed_time = (int)aom_usec_timer_elapsed(&timer);
+
+    printf("[          ] %d coeffs: C time = %d us, SIMD time = %d us\n",
+           count_, ref_elapsed_time, elapsed_time);
+  }
+
+  static const int kNumTests = 2000;
+  static const int kMaxHbdCoeff = (1 << 20) - 1;
+
+  QuantizeNuqFunc quantize_;
+  QuantizeNuqFunc quantize_ref_;
+  TX_SIZE tx_size_;
+  aom_bit_depth_t bit_depth_;
+  int is_fp_;
+  int count_;
+  const int16_t *scan_;
+  const uint8_t *band_;
+
+  int16_t quant_[2];
+  int16_t quant_shift_[2];
+  int16_t dequant_[2];
+  cuml_bins_type_nuq cuml_bins_[COEF_BANDS];
+  dequant_val_type_nuq dequant_val_[COEF_BANDS];
+  DECLARE_ALIGNED(16, tran_low_t, coeff_[MAX_TX_SQUARE]);
+  DECLARE_ALIGNED(16, tran_low_t, qcoeff_[MAX_TX_SQUARE]);
+  DECLARE_ALIGNED(16, tran_low_t, dqcoeff_[MAX_TX_SQUARE]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_qcoeff_[MAX_TX_SQUARE]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_dqcoeff_[MAX_TX_SQUARE]);
+};
+
+TEST_P(AV1QuantizeNuqTest, BitExactCheck) { RunBitExactCheck(); }
+TEST_P(AV1QuantizeNuqTest, DISABLED_Speed) { RunSpeedTest(); }
+
+using std::tr1::make_tuple;
+
+#define NUQ_PARAMS(opt, tx_size, bd)                                           \
+  make_tuple(&quantize_nuq_##opt, &quantize_nuq_c, tx_size, bd, 0),            \
+      make_tuple(&fp_nuq_wrapper<quantize_fp_nuq_##opt>,                       \
+                 &fp_nuq_wrapper<quantize_fp_nuq_c>, tx_size, bd, 1)
+#define NUQ_BIGTX_PARAMS(opt, pre, size, tx_size, bd)                          \
+  make_tuple(&pre##quantize_##size##_nuq_##opt, &pre##quantize_##size##_nuq_c, \
+             tx_size, bd, 0),                                                  \
+      make_tuple(&fp_nuq_wrapper<pre##quantize_##size##_fp_nuq_##opt>,         \
+                 &fp_nuq_wrapper<pre##quantize_##size##_fp_nuq_c>, tx_size,    \
+                 bd, 1)
+#define HBD_NUQ_PARAMS(opt, tx_size, bd)                                       \
+  make_tuple(&highbd_quantize_nuq_##opt, &highbd_quantize_nuq_c, tx_size,      \
+             bd, 0),                                                           \
+      make_tuple(&fp_nuq_wrapper<highbd_quantize_fp_nuq_##opt>,                \
+                 &fp_nuq_wrapper<highbd_quantize_fp_nuq_c>, tx_size, bd, 1)
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, AV1QuantizeNuqTest,
+    ::testing::Values(NUQ_PARAMS(sse4_1, TX_4X4, AOM_BITS_8),
+                      NUQ_PARAMS(sse4_1, TX_8X8, AOM_BITS_8),
+                      NUQ_PARAMS(sse4_1, TX_16X16, AOM_BITS_8),
+                      NUQ_BIGTX_PARAMS(sse4_1, , 32x32, TX_32X32,
+                                       AOM_BITS_8)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1_HBD, AV1QuantizeNuqTest,
+    ::testing::Values(HBD_NUQ_PARAMS(sse4_1, TX_4X4, AOM_BITS_10),
+                      HBD_NUQ_PARAMS(sse4_1, TX_8X8, AOM_BITS_10),
+                      HBD_NUQ_PARAMS(sse4_1, TX_16X16, AOM_BITS_12),
+                      NUQ_BIGTX_PARAMS(sse4_1, highbd_, 32x32, TX_32X32,
+                                       AOM_BITS_10),
+                      NUQ_BIGTX_PARAMS(sse4_1, highbd_, 32x32, TX_32X32,
+                                       AOM_BITS_12)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+#if CONFIG_TX64X64
+INSTANTIATE_TEST_CASE_P(SSE4_1_TX64, AV1QuantizeNuqTest,
+                        ::testing::Values(NUQ_BIGTX_PARAMS(sse4_1, , 64x64,
+                                                           TX_64X64,
+                                                           AOM_BITS_8)));
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(SSE4_1_TX64_HBD, AV1QuantizeNuqTest,
+                        ::testing::Values(NUQ_BIGTX_PARAMS(sse4_1, highbd_,
+                                                           64x64, TX_64X64,
+                                                           AOM_BITS_10)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // CONFIG_TX64X64
 #endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1QuantizeNuqTest,
+    ::testing::Values(NUQ_PARAMS(avx2, TX_4X4, AOM_BITS_8),
+                      NUQ_PARAMS(avx2, TX_8X8, AOM_BITS_8),
+                      NUQ_PARAMS(avx2, TX_16X16, AOM_BITS_8),
+                      NUQ_BIGTX_PARAMS(avx2, , 32x32, TX_32X32,
+                                       AOM_BITS_8)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    AVX2_HBD, AV1QuantizeNuqTest,
+    ::testing::Values(HBD_NUQ_PARAMS(avx2, TX_4X4, AOM_BITS_10),
+                      HBD_NUQ_PARAMS(avx2, TX_8X8, AOM_BITS_10),
+                      HBD_NUQ_PARAMS(avx2, TX_16X16, AOM_BITS_12),
+                      NUQ_BIGTX_PARAMS(avx2, highbd_, 32x32, TX_32X32,
+                                       AOM_BITS_10),
+                      NUQ_BIGTX_PARAMS(avx2, highbd_, 32x32, TX_32X32,
+                                       AOM_BITS_12)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+#if CONFIG_TX64X64
+INSTANTIATE_TEST_CASE_P(AVX2_TX64, AV1QuantizeNuqTest,
+                        ::testing::Values(NUQ_BIGTX_PARAMS(avx2, , 64x64,
+                                                           TX_64X64,
+                                                           AOM_BITS_8)));
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(AVX2_TX64_HBD, AV1QuantizeNuqTest,
+                        ::testing::Values(NUQ_BIGTX_PARAMS(avx2, highbd_,
+                                                           64x64, TX_64X64,
+                                                           AOM_BITS_10)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // CONFIG_TX64X64
+#endif  // HAVE_AVX2
+#endif  // CONFIG_NEW_QUANT
 }  // namespace
@@ -260,6 +260,16 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(&aom_clpf_block_sse4_1, &aom_clpf_block_c, 4, 4)));
 #endif
 
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, ClpfBlockTest,
+    ::testing::Values(make_tuple(&aom_clpf_block_avx2, &aom_clpf_block_c, 8, 8),
+                      make_tuple(&aom_clpf_block_avx2, &aom_clpf_block_c, 8, 4),
+                      make_tuple(&aom_clpf_block_avx2, &aom_clpf_block_c, 4, 8),
+                      make_tuple(&aom_clpf_block_avx2, &aom_clpf_block_c, 4,
+                                 4)));
+#endif
+
 #if HAVE_NEON
 INSTANTIATE_TEST_CASE_P(
     NEON, ClpfBlockTest,
@@ -301,6 +311,16 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(&aom_clpf_block_hbd_sse4_1, &aom_clpf_block_hbd_c, 4, 4)));
 #endif
 
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, ClpfBlockHbdTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_block_hbd_avx2, &aom_clpf_block_hbd_c, 8, 8),
+        make_tuple(&aom_clpf_block_hbd_avx2, &aom_clpf_block_hbd_c, 8, 4),
+        make_tuple(&aom_clpf_block_hbd_avx2, &aom_clpf_block_hbd_c, 4, 8),
+        make_tuple(&aom_clpf_block_hbd_avx2, &aom_clpf_block_hbd_c, 4, 4)));
+#endif
+
 #if HAVE_NEON
 INSTANTIATE_TEST_CASE_P(
     NEON, ClpfBlockHbdTest,
@@ -331,6 +351,12 @@ INSTANTIATE_TEST_CASE_P(SSSE4_1, ClpfSpeedTest,
                                                      &aom_clpf_block_c, 8, 8)));
 #endif
 
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, ClpfSpeedTest,
+                        ::testing::Values(make_tuple(&aom_clpf_block_avx2,
+                                                     &aom_clpf_block_c, 8, 8)));
+#endif
+
 #if HAVE_NEON
 INSTANTIATE_TEST_CASE_P(NEON, ClpfSpeedTest,
                         ::testing::Values(make_tuple(&aom_clpf_block_neon,
@@ -359,6 +385,13 @@ INSTANTIATE_TEST_CASE_P(SSSE4_1, ClpfHbdSpeedTest,
                                                      8)));
 #endif
 
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, ClpfHbdSpeedTest,
+                        ::testing::Values(make_tuple(&aom_clpf_block_hbd_avx2,
+                                                     &aom_clpf_block_hbd_c, 8,
+                                                     8)));
+#endif
+
 #if HAVE_NEON
 INSTANTIATE_TEST_CASE_P(NEON, ClpfHbdSpeedTest,
                         ::testing::Values(make_tuple(&aom_clpf_block_hbd_neon,
@@ -368,4 +401,409 @@ INSTANTIATE_TEST_CASE_P(NEON, ClpfHbdSpeedTest,
 #endif  // CONFIG_AOM_HIGHBITDEPTH
 #endif  // defined(_WIN64) || !defined(_MSC_VER)
 
+
+#if CONFIG_AV1_ENCODER
+typedef void (*clpf_detect_t)(const uint8_t *rec, const uint8_t *org,
+                              int rstride, int ostride, int x0, int y0,
+                              int width, int height, int *sum0, int *sum1,
+                              unsigned int strength, int size,
+                              unsigned int bitdepth);
+typedef void (*clpf_detect_multi_t)(const uint8_t *rec, const uint8_t *org,
+                                    int rstride, int ostride, int x0, int y0,
+                                    int width, int height, int *sum, int size,
+                                    unsigned int bitdepth);
+
+typedef std::tr1::tuple<clpf_detect_t, clpf_detect_t, int>
+    clpf_detect_param_t;
+typedef std::tr1::tuple<clpf_detect_multi_t, clpf_detect_multi_t, int>
+    clpf_detect_multi_param_t;
+
+class ClpfDetectTest : public ::testing::TestWithParam<clpf_detect_param_t> {
+ public:
+  virtual ~ClpfDetectTest() {}
+  virtual void SetUp() {
+    detect = GET_PARAM(0);
+    ref_detect = GET_PARAM(1);
+    size = GET_PARAM(2);
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  int size;
+  clpf_detect_t detect;
+  clpf_detect_t ref_detect;
+};
+
+class ClpfDetectMultiTest
+    : public ::testing::TestWithParam<clpf_detect_multi_param_t> {
+ public:
+  virtual ~ClpfDetectMultiTest() {}
+  virtual void SetUp() {
+    detect = GET_PARAM(0);
+    ref_detect = GET_PARAM(1);
+    size = GET_PARAM(2);
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  int size;
+  clpf_detect_multi_t detect;
+  clpf_detect_multi_t ref_detect;
+};
+
+#if CONFIG_AOM_HIGHBITDEPTH
+typedef void (*clpf_detect_hbd_t)(const uint16_t *rec, const uint16_t *org,
+                                  int rstride, int ostride, int x0, int y0,
+                                  int width, int height, int *sum0, int *sum1,
+                                  unsigned int strength, int size,
+                                  unsigned int bitdepth);
+typedef void (*clpf_detect_multi_hbd_t)(const uint16_t *rec,
+                                        const uint16_t *org, int rstride,
+                                        int ostride, int x0, int y0, int width,
+                                        int height, int *sum, int size,
+                                        unsigned int bitdepth);
+
+typedef std::tr1::tuple<clpf_detect_hbd_t, clpf_detect_hbd_t, int>
+    clpf_detect_hbd_param_t;
+typedef std::tr1::tuple<clpf_detect_multi_hbd_t, clpf_detect_multi_hbd_t, int>
+    clpf_detect_multi_hbd_param_t;
+
+class ClpfDetectHbdTest
+    : public ::testing::TestWithParam<clpf_detect_hbd_param_t> {
+ public:
+  virtual ~ClpfDetectHbdTest() {}
+  virtual void SetUp() {
+    detect = GET_PARAM(0);
+    ref_detect = GET_PARAM(1);
+    size = GET_PARAM(2);
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  int size;
+  clpf_detect_hbd_t detect;
+  clpf_detect_hbd_t ref_detect;
+};
+
+class ClpfDetectMultiHbdTest
+    : public ::testing::TestWithParam<clpf_detect_multi_hbd_param_t> {
+ public:
+  virtual ~ClpfDetectMultiHbdTest() {}
+  virtual void SetUp() {
+    detect = GET_PARAM(0);
+    ref_detect = GET_PARAM(1);
+    size = GET_PARAM(2);
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  int size;
+  clpf_detect_multi_hbd_t detect;
+  clpf_detect_multi_hbd_t ref_detect;
+};
+#endif
+
+// Fill a reconstructed and an original frame with up to <bits> bits of noise
+// around <level>.
+template <typename pixel>
+void fill_detect_frames(ACMRandom *rnd, pixel *rec, pixel *org, int n,
+                        int depth, int level, int bits) {
+  for (int i = 0; i < n; i++) {
+    rec[i] = clamp((rnd->Rand16() & ((1 << bits) - 1)) + level, 0,
+                   (1 << depth) - 1);
+    org[i] = clamp((rnd->Rand16() & ((1 << bits) - 1)) + level, 0,
+                   (1 << depth) - 1);
+  }
+}
+
+template <typename pixel>
+void test_clpf_detect(int size, int depth,
+                      void (*detect)(const pixel *rec, const pixel *org,
+                                     int rstride, int ostride, int x0, int y0,
+                                     int width, int height, int *sum0,
+                                     int *sum1, unsigned int strength,
+                                     int size, unsigned int bitdepth),
+                      void (*ref_detect)(const pixel *rec, const pixel *org,
+                                         int rstride, int ostride, int x0,
+                                         int y0, int width, int height,
+                                         int *sum0, int *sum1,
+                                         unsigned int strength, int size,
+                                         unsigned int bitdepth)) {
+  const int w = 24;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, pixel, rec[w * w]);
+  DECLARE_ALIGNED(16, pixel, org[w * w]);
+
+  int error = 0, strength = 0, xpos = 0, ypos = 0;
+  int sum0 = 0, sum1 = 0, ref_sum0 = 0, ref_sum1 = 0;
+
+  // Test every combination of noise, noise level, block position (along all
+  // edges and also fully inside) and strength, as in test_clpf().
+  for (int level = 0; level < (1 << depth) && !error; level++) {
+    for (int bits = 1; bits <= depth && !error; bits++) {
+      fill_detect_frames(&rnd, rec, org, w * w, depth, level, bits);
+      for (ypos = 0; ypos < w && !error; ypos += size * !error) {
+        for (xpos = 0; xpos < w && !error; xpos += size * !error) {
+          for (strength = depth - 8; strength < depth - 5 && !error;
+               strength += !error) {
+            sum0 = sum1 = ref_sum0 = ref_sum1 = 0;
+            ref_detect(rec, org, w, w, xpos, ypos, w, w, &ref_sum0, &ref_sum1,
+                       1 << strength, size, depth);
+            ASM_REGISTER_STATE_CHECK(detect(rec, org, w, w, xpos, ypos, w, w,
+                                            &sum0, &sum1, 1 << strength, size,
+                                            depth));
+            error = ref_sum0 != sum0 || ref_sum1 != sum1;
+          }
+        }
+      }
+    }
+  }
+
+  EXPECT_EQ(0, error) << "Error: ClpfDetectTest, SIMD and C mismatch."
+                      << std::endl
+                      << "sum0: " << ref_sum0 << " != " << sum0 << std::endl
+                      << "sum1: " << ref_sum1 << " != " << sum1 << std::endl
+                      << "strength: " << (1 << strength) << std::endl
+                      << "xpos: " << xpos << std::endl
+                      << "ypos: " << ypos << std::endl
+                      << "size: " << size << std::endl;
+}
+
+template <typename pixel>
+void test_clpf_detect_multi(
+    int size, int depth,
+    void (*detect)(const pixel *rec, const pixel *org, int rstride,
+                   int ostride, int x0, int y0, int width, int height,
+                   int *sum, int size, unsigned int bitdepth),
+    void (*ref_detect)(const pixel *rec, const pixel *org, int rstride,
+                       int ostride, int x0, int y0, int width, int height,
+                       int *sum, int size, unsigned int bitdepth)) {
+  const int w = 24;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, pixel, rec[w * w]);
+  DECLARE_ALIGNED(16, pixel, org[w * w]);
+
+  int error = 0, pos = 0, xpos = 0, ypos = 0;
+  int sum[4], ref_sum[4];
+
+  for (int level = 0; level < (1 << depth) && !error; level++) {
+    for (int bits = 1; bits <= depth && !error; bits++) {
+      fill_detect_frames(&rnd, rec, org, w * w, depth, level, bits);
+      for (ypos = 0; ypos < w && !error; ypos += size * !error) {
+        for (xpos = 0; xpos < w && !error; xpos += size * !error) {
+          memset(sum, 0, sizeof(sum));
+          memset(ref_sum, 0, sizeof(ref_sum));
+          ref_detect(rec, org, w, w, xpos, ypos, w, w, ref_sum, size, depth);
+          ASM_REGISTER_STATE_CHECK(
+              detect(rec, org, w, w, xpos, ypos, w, w, sum, size, depth));
+          for (pos = 0; pos < 4 && !error; pos++)
+            error = ref_sum[pos] != sum[pos];
+        }
+      }
+    }
+  }
+
+  pos--;
+  EXPECT_EQ(0, error) << "Error: ClpfDetectMultiTest, SIMD and C mismatch."
+                      << std::endl
+                      << "sum[" << pos << "]: " << ref_sum[pos]
+                      << " != " << sum[pos] << std::endl
+                      << "xpos: " << xpos << std::endl
+                      << "ypos: " << ypos << std::endl
+                      << "size: " << size << std::endl;
+}
+
+TEST_P(ClpfDetectTest, TestSIMDNoMismatch) {
+  test_clpf_detect(size, 8, detect, ref_detect);
+}
+
+TEST_P(ClpfDetectMultiTest, TestSIMDNoMismatch) {
+  test_clpf_detect_multi(size, 8, detect, ref_detect);
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+TEST_P(ClpfDetectHbdTest, TestSIMDNoMismatch) {
+  test_clpf_detect(size, 12, detect, ref_detect);
+}
+
+TEST_P(ClpfDetectMultiHbdTest, TestSIMDNoMismatch) {
+  test_clpf_detect_multi(size, 12, detect, ref_detect);
+}
+#endif
+
+#if defined(_WIN64) || !defined(_MSC_VER) || defined(__clang__)
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, ClpfDetectTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_sse2, &aom_clpf_detect_c, 8),
+        make_tuple(&aom_clpf_detect_sse2, &aom_clpf_detect_c, 4)));
+#endif
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_CASE_P(
+    SSSE3, ClpfDetectTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_ssse3, &aom_clpf_detect_c, 8),
+        make_tuple(&aom_clpf_detect_ssse3, &aom_clpf_detect_c, 4)));
+#endif
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, ClpfDetectTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_sse4_1, &aom_clpf_detect_c, 8),
+        make_tuple(&aom_clpf_detect_sse4_1, &aom_clpf_detect_c, 4)));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, ClpfDetectTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_avx2, &aom_clpf_detect_c, 8),
+        make_tuple(&aom_clpf_detect_avx2, &aom_clpf_detect_c, 4)));
+#endif
+
+#if HAVE_NEON
+INSTANTIATE_TEST_CASE_P(
+    NEON, ClpfDetectTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_neon, &aom_clpf_detect_c, 8),
+        make_tuple(&aom_clpf_detect_neon, &aom_clpf_detect_c, 4)));
+#endif
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, ClpfDetectMultiTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_multi_sse2, &aom_clpf_detect_multi_c, 8),
+        make_tuple(&aom_clpf_detect_multi_sse2, &aom_clpf_detect_multi_c, 4)));
+#endif
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_CASE_P(
+    SSSE3, ClpfDetectMultiTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_multi_ssse3, &aom_clpf_detect_multi_c, 8),
+        make_tuple(&aom_clpf_detect_multi_ssse3, &aom_clpf_detect_multi_c, 4)));
+#endif
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, ClpfDetectMultiTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_multi_sse4_1, &aom_clpf_detect_multi_c, 8),
+        make_tuple(&aom_clpf_detect_multi_sse4_1, &aom_clpf_detect_multi_c,
+                   4)));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, ClpfDetectMultiTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_multi_avx2, &aom_clpf_detect_multi_c, 8),
+        make_tuple(&aom_clpf_detect_multi_avx2, &aom_clpf_detect_multi_c, 4)));
+#endif
+
+#if HAVE_NEON
+INSTANTIATE_TEST_CASE_P(
+    NEON, ClpfDetectMultiTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_multi_neon, &aom_clpf_detect_multi_c, 8),
+        make_tuple(&aom_clpf_detect_multi_neon, &aom_clpf_detect_multi_c, 4)));
+#endif
+
+#if CONFIG_AOM_HIGHBITDEPTH
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, ClpfDetectHbdTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_hbd_sse2, &aom_clpf_detect_hbd_c, 8),
+        make_tuple(&aom_clpf_detect_hbd_sse2, &aom_clpf_detect_hbd_c, 4)));
+#endif
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_CASE_P(
+    SSSE3, ClpfDetectHbdTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_hbd_ssse3, &aom_clpf_detect_hbd_c, 8),
+        make_tuple(&aom_clpf_detect_hbd_ssse3, &aom_clpf_detect_hbd_c, 4)));
+#endif
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, ClpfDetectHbdTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_hbd_sse4_1, &aom_clpf_detect_hbd_c, 8),
+        make_tuple(&aom_clpf_detect_hbd_sse4_1, &aom_clpf_detect_hbd_c, 4)));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, ClpfDetectHbdTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_hbd_avx2, &aom_clpf_detect_hbd_c, 8),
+        make_tuple(&aom_clpf_detect_hbd_avx2, &aom_clpf_detect_hbd_c, 4)));
+#endif
+
+#if HAVE_NEON
+INSTANTIATE_TEST_CASE_P(
+    NEON, ClpfDetectHbdTest,
+    ::testing::Values(
+        make_tuple(&aom_clpf_detect_hbd_neon, &aom_clpf_detect_hbd_c, 8),
+        make_tuple(&aom_clpf_detect_hbd_neon, &aom_clpf_detect_hbd_c, 4)));
+#endif
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, ClpfDetectMultiHbdTest,
+    ::testing::Values(make_tuple(&aom_clpf_detect_multi_hbd_sse2,
+                                 &aom_clpf_detect_multi_hbd_c, 8),
+                      make_tuple(&aom_clpf_detect_multi_hbd_sse2,
+                                 &aom_clpf_detect_multi_hbd_c, 4)));
+#endif
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_CASE_P(
+    SSSE3, ClpfDetectMultiHbdTest,
+    ::testing::Values(make_tuple(&aom_clpf_detect_multi_hbd_ssse3,
+                                 &aom_clpf_detect_multi_hbd_c, 8),
+                      make_tuple(&aom_clpf_detect_multi_hbd_ssse3,
+                                 &aom_clpf_detect_multi_hbd_c, 4)));
+#endif
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, ClpfDetectMultiHbdTest,
+    ::testing::Values(make_tuple(&aom_clpf_detect_multi_hbd_sse4_1,
+                                 &aom_clpf_detect_multi_hbd_c, 8),
+                      make_tuple(&aom_clpf_detect_multi_hbd_sse4_1,
+                                 &aom_clpf_detect_multi_hbd_c, 4)));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, ClpfDetectMultiHbdTest,
+    ::testing::Values(make_tuple(&aom_clpf_detect_multi_hbd_avx2,
+                                 &aom_clpf_detect_multi_hbd_c, 8),
+                      make_tuple(&aom_clpf_detect_multi_hbd_avx2,
+                                 &aom_clpf_detect_multi_hbd_c, 4)));
+#endif
+
+#if HAVE_NEON
+INSTANTIATE_TEST_CASE_P(
+    NEON, ClpfDetectMultiHbdTest,
+    ::testing::Values(make_tuple(&aom_clpf_detect_multi_hbd_neon,
+                                 &aom_clpf_detect_multi_hbd_c, 8),
+                      make_tuple(&aom_clpf_detect_multi_hbd_neon,
+                                 &aom_clpf_detect_multi_hbd_c, 4)));
+#endif
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // defined(_WIN64) || !defined(_MSC_VER)
+#endif  // CONFIG_AV1_ENCODER
+
 }  // namespace
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/aom_timer.h"
+#include "av1/encoder/corner_detect.h"
+#include "av1/encoder/corner_match.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+
+using libaom_test::ACMRandom;
+
+namespace {
+typedef double (*ComputeCrossCorrFunc)(unsigned char *im1, int stride1, int x1,
+                                       int y1, unsigned char *im2, int stride2,
+                                       int x2, int y2);
+
+const int kWidth = 64;
+const int kHeight = 64;
+const int kStride = kWidth + 8;
+
+class CornerMatchTest : public ::testing::TestWithParam<ComputeCrossCorrFunc> {
+ public:
+  virtual ~CornerMatchTest() {}
+  virtual void SetUp() { compute_cross_correlation_ = GetParam(); }
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  void FillRandom(ACMRandom *rnd, int extreme) {
+    for (int i = 0; i < kStride * kHeight; ++i) {
+      input1_[i] = extreme ? (rnd->Rand8() & 1) * 255 : rnd->Rand8();
+      input2_[i] = extreme ? (rnd->Rand8() & 1) * 255 : rnd->Rand8();
+    }
+  }
+
+  // A patch centre at which the whole patch is inside the image.
+  int RandCentre(ACMRandom *rnd, int size) {
+    return MATCH_SZ_BY2 + rnd->PseudoUniform(size - 2 * MATCH_SZ_BY2);
+  }
+
+  ComputeCrossCorrFunc compute_cross_correlation_;
+  unsigned char input1_[kStride * kHeight];
+  unsigned char input2_[kStride * kHeight];
+};
+
+TEST_P(CornerMatchTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int iter = 0; iter < 100; ++iter) {
+    FillRandom(&rnd, iter < 10);
+    for (int j = 0; j < 100; ++j) {
+      const int x1 = RandCentre(&rnd, kWidth);
+      const int y1 = RandCentre(&rnd, kHeight);
+      const int x2 = RandCentre(&rnd, kWidth);
+      const int y2 = RandCentre(&rnd, kHeight);
+      const double ref = av1_compute_cross_correlation_c(
+          input1_, kStride, x1, y1, input2_, kStride, x2, y2);
+      double res;
+      ASM_REGISTER_STATE_CHECK(res = compute_cross_correlation_(
+                                   input1_, kStride, x1, y1, input2_, kStride,
+                                   x2, y2));
+      ASSERT_EQ(ref, res) << "(" << x1 << ", " << y1 << ") and (" << x2
+                          << ", " << y2 << ")";
+    }
+  }
+}
+
+TEST_P(CornerMatchTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kNumLoops = 1000000;
+  const int x = kWidth / 2, y = kHeight / 2;
+  double ref = 0, res = 0;
+  aom_usec_timer ref_timer, test_timer;
+
+  FillRandom(&rnd, 0);
+
+  aom_usec_timer_start(&ref_timer);
+  for (int i = 0; i < kNumLoops; ++i) {
+    ref += av1_compute_cross_correlation_c(input1_, kStride, x, y, input2_,
+                                           kStride, x + (i & 7), y);
+  }
+  aom_usec_timer_mark(&ref_timer);
+  const int ref_elapsed_time =
+      static_cast<int>(aom_usec_timer_elapsed(&ref_timer));
+
+  aom_usec_timer_start(&test_timer);
+  for (int i = 0; i < kNumLoops; ++i) {
+    res += compute_cross_correlation_(input1_, kStride, x, y, input2_, kStride,
+                                      x + (i & 7), y);
+  }
+  aom_usec_timer_mark(&test_timer);
+  const int elapsed_time =
+      static_cast<int>(aom_usec_timer_elapsed(&test_timer));
+
+  EXPECT_EQ(ref, res);
+  printf("c_time=%d \t simd_time=%d \t gain=%d\n", ref_elapsed_time,
+         elapsed_time, ref_elapsed_time / AOMMAX(elapsed_time, 1));
+}
+
+// Matches the corners of a synthetic frame made of random rectangles against
+// a shifted copy with some noise, with the functions selected by rtcd, and
+// reports the correspondences found per second.
+TEST(CornerMatchSpeedTest, DISABLED_Correspondences) {
+  const int kFrameWidth = 640;
+  const int kFrameHeight = 480;
+  const int kMaxCorners = 4096;
+  const int kNumLoops = 10;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  unsigned char *const frm = new unsigned char[kFrameWidth * kFrameHeight];
+  unsigned char *const ref = new unsigned char[kFrameWidth * kFrameHeight];
+  int *const frm_corners = new int[2 * kMaxCorners];
+  int *const ref_corners = new int[2 * kMaxCorners];
+  double *const correspondences = new double[4 * kMaxCorners];
+  int num_correspondences = 0;
+  aom_usec_timer timer;
+
+  memset(ref, 128, kFrameWidth * kFrameHeight);
+  for (int n = 0; n < 400; ++n) {
+    const int x0 = rnd.PseudoUniform(kFrameWidth - 8);
+    const int y0 = rnd.PseudoUniform(kFrameHeight - 8);
+    const int w = 8 + rnd.PseudoUniform(AOMMIN(40, kFrameWidth - x0 - 8) + 1);
+    const int h = 8 + rnd.PseudoUniform(AOMMIN(40, kFrameHeight - y0 - 8) + 1);
+    const int value = rnd.Rand8();
+    for (int i = y0; i < y0 + h; ++i)
+      memset(ref + i * kFrameWidth + x0, value, w);
+  }
+  // The frame is the reference moved by (3, 2), with noise of up to +-2.
+  for (int i = 0; i < kFrameHeight; ++i) {
+    for (int j = 0; j < kFrameWidth; ++j) {
+      const int src_i = AOMMIN(i + 2, kFrameHeight - 1);
+      const int src_j = AOMMIN(j + 3, kFrameWidth - 1);
+      const int noise = rnd.PseudoUniform(5) - 2;
+      frm[i * kFrameWidth + j] = static_cast<unsigned char>(
+          clamp(ref[src_i * kFrameWidth + src_j] + noise, 0, 255));
+    }
+  }
+
+  const int num_frm_corners = fast_corner_detect(
+      frm, kFrameWidth, kFrameHeight, kFrameWidth, frm_corners, kMaxCorners);
+  const int num_ref_corners = fast_corner_detect(
+      ref, kFrameWidth, kFrameHeight, kFrameWidth, ref_corners, kMaxCorners);
+
+  aom_usec_timer_start(&timer);
+  for (int i = 0; i < kNumLoops; ++i) {
+    num_correspondences = determine_correspondence(
+        frm, frm_corners, num_frm_corners, ref, ref_corners, num_ref_corners,
+        kFrameWidth, kFrameHeight, kFrameWidth, kFrameWidth, correspondences);
+  }
+  aom_usec_timer_mark(&timer);
+  const int elapsed_time = static_cast<int>(aom_usec_timer_elapsed(&timer));
+
+  EXPECT_GT(num_correspondences, 0);
+  printf("corners=%d/%d \t correspondences=%d \t time=%d \t per_second=%.0f\n",
+         num_frm_corners, num_ref_corners, num_correspondences, elapsed_time,
+         1e6 * kNumLoops * num_correspondences / AOMMAX(elapsed_time, 1));
+
+  delete[] frm;
+  delete[] ref;
+  delete[] frm_corners;
+  delete[] ref_corners;
+  delete[] correspondences;
+}
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, CornerMatchTest,
+    ::testing::Values(&av1_compute_cross_correlation_sse4_1));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, CornerMatchTest,
+                        ::testing::Values(&av1_compute_cross_correlation_avx2));
+#endif  // HAVE_AVX2
+
+}  // namespace
@@ -94,11 +94,11 @@ TEST_P(DecodePerfTest, PerfTest) {
 
 class AV1NewEncodeDecodePerfTest
     : public ::libaom_test::EncoderTest,
-      public ::libaom_test::CodecTestWithParam<libaom_test::TestMode> {
+      public ::libaom_test::CodecTestWith2Params<libaom_test::TestMode, int> {
  protected:
   AV1NewEncodeDecodePerfTest()
-      : EncoderTest(GET_PARAM(0)), encoding_mode_(GET_PARAM(1)), speed_(0),
-        outfile_(0), out_frames_(0) {}
+      : EncoderTest(GET_PARAM(0)), threads_(GET_PARAM(2)),
+        encoding_mode_(GET_PARAM(1)), speed_(0), outfile_(0), out_frames_(0) {}
 
   virtual ~AV1NewEncodeDecodePerfTest() {}
 
@@ -161,6 +161,9 @@ class AV1NewEncodeDecodePerfTest
 
   void set_speed(unsigned int speed) { speed_ = speed; }
 
+  // Number of threads the encoded stream is decoded with.
+  const int threads_;
+
  private:
   libaom_test::TestMode encoding_mode_;
   uint32_t speed_;
@@ -204,7 +207,7 @@ TEST_P(AV1NewEncodeDecodePerfTest, PerfTest) {
 
   ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
 
-  const uint32_t threads = 4;
+  const uint32_t threads = threads_;
 
   libaom_test::IVFVideoSource decode_video(kNewEncodeOutputFile);
   decode_video.Init();
@@ -239,5 +242,6 @@ TEST_P(AV1NewEncodeDecodePerfTest, PerfTest) {
 }
 
 AV1_INSTANTIATE_TEST_CASE(AV1NewEncodeDecodePerfTest,
-                          ::testing::Values(::libaom_test::kTwoPassGood));
+                          ::testing::Values(::libaom_test::kTwoPassGood),
+                          ::testing::Values(1, 2, 4));
 }  // namespace
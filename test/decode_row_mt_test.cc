@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+*/
+
+#include <string>
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+#include "test/md5_helper.h"
+
+namespace {
+// Encodes a single tile column stream and checks that decoding it with
+// superblock rows spread over several threads gives the same output as the
+// single-threaded decoder.
+class DecodeRowMTTest
+    : public ::libaom_test::EncoderTest,
+      public ::libaom_test::CodecTestWith2Params<int, int> {
+ protected:
+  DecodeRowMTTest()
+      : EncoderTest(GET_PARAM(0)), md5_single_(), md5_row_mt_(),
+        n_tile_rows_(GET_PARAM(1)), n_threads_(GET_PARAM(2)) {
+    init_flags_ = AOM_CODEC_USE_PSNR;
+    aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
+    cfg.w = 704;
+    cfg.h = 576;
+    cfg.threads = 1;
+    single_dec_ = codec_->CreateDecoder(cfg, 0);
+    cfg.threads = n_threads_;
+    row_mt_dec_ = codec_->CreateDecoder(cfg, 0);
+    row_mt_dec_->Control(AV1D_SET_ROW_MT, 1);
+
+#if CONFIG_AV1 && CONFIG_EXT_TILE
+    if (single_dec_->IsAV1() && row_mt_dec_->IsAV1()) {
+      single_dec_->Control(AV1_SET_DECODE_TILE_ROW, -1);
+      single_dec_->Control(AV1_SET_DECODE_TILE_COL, -1);
+      row_mt_dec_->Control(AV1_SET_DECODE_TILE_ROW, -1);
+      row_mt_dec_->Control(AV1_SET_DECODE_TILE_COL, -1);
+    }
+#endif
+  }
+
+  virtual ~DecodeRowMTTest() {
+    delete single_dec_;
+    delete row_mt_dec_;
+  }
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(libaom_test::kTwoPassGood);
+  }
+
+  virtual void PreEncodeFrameHook(libaom_test::VideoSource *video,
+                                  libaom_test::Encoder *encoder) {
+    if (video->frame() == 1) {
+      encoder->Control(AV1E_SET_TILE_COLUMNS, 0);
+      encoder->Control(AV1E_SET_TILE_ROWS, n_tile_rows_);
+      encoder->Control(AOME_SET_CPUUSED, 3);
+    }
+  }
+
+  void UpdateMD5(::libaom_test::Decoder *dec, const aom_codec_cx_pkt_t *pkt,
+                 ::libaom_test::MD5 *md5) {
+    const aom_codec_err_t res = dec->DecodeFrame(
+        reinterpret_cast<uint8_t *>(pkt->data.frame.buf), pkt->data.frame.sz);
+    if (res != AOM_CODEC_OK) {
+      abort_ = true;
+      ASSERT_EQ(AOM_CODEC_OK, res);
+    }
+    const aom_image_t *img = dec->GetDxData().Next();
+    md5->Add(img);
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    UpdateMD5(single_dec_, pkt, &md5_single_);
+    UpdateMD5(row_mt_dec_, pkt, &md5_row_mt_);
+  }
+
+  void DoTest() {
+    const aom_rational timebase = { 33333333, 1000000000 };
+    cfg_.g_timebase = timebase;
+    cfg_.rc_target_bitrate = 500;
+    cfg_.g_lag_in_frames = 12;
+    cfg_.rc_end_usage = AOM_VBR;
+
+    libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", 704, 576,
+                                       timebase.den, timebase.num, 0, 5);
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+    ASSERT_STREQ(md5_single_.Get(), md5_row_mt_.Get());
+  }
+
+  ::libaom_test::MD5 md5_single_, md5_row_mt_;
+  ::libaom_test::Decoder *single_dec_, *row_mt_dec_;
+
+ private:
+  int n_tile_rows_;
+  int n_threads_;
+};
+
+TEST_P(DecodeRowMTTest, MD5Match) { DoTest(); }
+
+#if CONFIG_EXT_TILE
+AV1_INSTANTIATE_TEST_CASE(DecodeRowMTTest, ::testing::Values(1, 32),
+                          ::testing::Values(2, 3, 8));
+#else
+AV1_INSTANTIATE_TEST_CASE(DecodeRowMTTest, ::testing::Values(0, 1),
+                          ::testing::Values(2, 3, 8));
+#endif  // CONFIG_EXT_TILE
+}  // namespace
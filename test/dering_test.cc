@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/function_equivalence_test.h"
+#include "test/register_state_check.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "av1/common/od_dering.h"
+
+using libaom_test::FunctionEquivalenceTest;
+
+namespace {
+
+const int kIterations = 200;
+const int kMaxBlocks = OD_DERING_NBLOCKS * OD_DERING_NBLOCKS;
+
+// Common setup: a filter input buffer with its borders, and a random list of
+// blocks within a superblock.
+template <typename F>
+class DeringListTest : public FunctionEquivalenceTest<F> {
+ protected:
+  // Small ranges are taken from the high bits, the low bits of the generator
+  // have a short period.
+  int Rand(int n) { return this->rng_.Rand16() % n; }
+
+  // Fills the superblock with random pixels of the given bit depth. With
+  // borders set, some of the pixels are replaced with OD_DERING_VERY_LARGE
+  // like the frame edges in av1_dering_sb_row().
+  void FillInput(int bd, bool borders) {
+    const int max_val = (1 << bd) - 1;
+    for (int i = 0; i < OD_DERING_INBUF_SIZE; ++i) {
+      if (borders && Rand(8) == 0)
+        inbuf_[i] = OD_DERING_VERY_LARGE;
+      else if (Rand(4) == 0)
+        inbuf_[i] = Rand(2) ? max_val : 0;
+      else
+        inbuf_[i] = Rand(max_val + 1);
+    }
+  }
+
+  int RandomList() {
+    int count = 0;
+    const int skip = Rand(4);
+    for (int by = 0; by < OD_DERING_NBLOCKS; ++by) {
+      for (int bx = 0; bx < OD_DERING_NBLOCKS; ++bx) {
+        if (skip && Rand(4) < skip) continue;
+        dlist_[count].by = by;
+        dlist_[count].bx = bx;
+        count++;
+      }
+    }
+    return count;
+  }
+
+  int16_t *Input() {
+    return inbuf_ + OD_FILT_VBORDER * OD_FILT_BSTRIDE + OD_FILT_HBORDER;
+  }
+
+  int16_t inbuf_[OD_DERING_INBUF_SIZE];
+  dering_list dlist_[kMaxBlocks];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Direction search
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (*DirFindListFunc)(const od_dering_in *in,
+                                const struct dering_list *dlist,
+                                int dering_count, int *dirs, int32_t *vars,
+                                int coeff_shift);
+typedef libaom_test::FuncParam<DirFindListFunc> DirFindListFuncs;
+
+class DirFindListTest : public DeringListTest<DirFindListFunc> {};
+
+TEST_P(DirFindListTest, RandomValues) {
+  const int bd = params_.bit_depth;
+  for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+    int dirs_ref[kMaxBlocks], dirs_tst[kMaxBlocks];
+    int32_t vars_ref[kMaxBlocks], vars_tst[kMaxBlocks];
+    FillInput(bd, false);
+    const int count = RandomList();
+
+    params_.ref_func(Input(), dlist_, count, dirs_ref, vars_ref, bd - 8);
+    ASM_REGISTER_STATE_CHECK(
+        params_.tst_func(Input(), dlist_, count, dirs_tst, vars_tst, bd - 8));
+
+    for (int bi = 0; bi < count; ++bi) {
+      ASSERT_EQ(dirs_ref[bi], dirs_tst[bi]) << "block " << bi;
+      ASSERT_EQ(vars_ref[bi], vars_tst[bi]) << "block " << bi;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Directional and orthogonal filters
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (*DirectionListFunc)(int16_t *y, const int16_t *in,
+                                  const struct dering_list *dlist,
+                                  int dering_count, int bsize,
+                                  const int *thresholds, const int *dirs,
+                                  int *filter2_thresh);
+typedef libaom_test::FuncParam<DirectionListFunc> DirectionListFuncs;
+
+typedef void (*OrthogonalListFunc)(int16_t *y, const int16_t *in,
+                                   const struct dering_list *dlist,
+                                   int dering_count, int bsize,
+                                   const int *thresholds, const int *dirs);
+typedef libaom_test::FuncParam<OrthogonalListFunc> OrthogonalListFuncs;
+
+template <typename F>
+class DeringFilterListTest : public DeringListTest<F> {
+ protected:
+  void RandomParams(int bd) {
+    for (int bi = 0; bi < kMaxBlocks; ++bi) {
+      // Up to 3 times the largest frame level, as od_adjust_thresh() can.
+      thresholds_[bi] = this->Rand(4) ? this->Rand(48 << (bd - 8)) : 0;
+      dirs_[bi] = this->Rand(8);
+    }
+  }
+
+  int thresholds_[kMaxBlocks];
+  int dirs_[kMaxBlocks];
+  int16_t y_ref_[kMaxBlocks * 64];
+  int16_t y_tst_[kMaxBlocks * 64];
+};
+
+class DirectionListTest : public DeringFilterListTest<DirectionListFunc> {};
+
+TEST_P(DirectionListTest, RandomValues) {
+  const int bd = params_.bit_depth;
+  for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+    const int bsize = 2 + Rand(2);
+    int filter2_ref[kMaxBlocks], filter2_tst[kMaxBlocks];
+    FillInput(bd, true);
+    RandomParams(bd);
+    const int count = RandomList();
+    memset(y_ref_, 0, sizeof(y_ref_));
+    memset(y_tst_, 0, sizeof(y_tst_));
+
+    params_.ref_func(y_ref_, Input(), dlist_, count, bsize, thresholds_, dirs_,
+                     filter2_ref);
+    ASM_REGISTER_STATE_CHECK(params_.tst_func(y_tst_, Input(), dlist_, count,
+                                              bsize, thresholds_, dirs_,
+                                              filter2_tst));
+
+    for (int bi = 0; bi < count; ++bi)
+      ASSERT_EQ(filter2_ref[bi], filter2_tst[bi]) << "block " << bi;
+    for (int i = 0; i < kMaxBlocks * 64; ++i)
+      ASSERT_EQ(y_ref_[i], y_tst_[i]) << "bsize " << bsize << " at " << i;
+  }
+}
+
+class OrthogonalListTest : public DeringFilterListTest<OrthogonalListFunc> {};
+
+TEST_P(OrthogonalListTest, RandomValues) {
+  const int bd = params_.bit_depth;
+  for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+    const int bsize = 2 + Rand(2);
+    FillInput(bd, true);
+    RandomParams(bd);
+    const int count = RandomList();
+    // Blocks with a zero threshold must be left untouched.
+    for (int i = 0; i < kMaxBlocks * 64; ++i)
+      y_ref_[i] = y_tst_[i] = rng_.Rand8();
+
+    params_.ref_func(y_ref_, Input(), dlist_, count, bsize, thresholds_,
+                     dirs_);
+    ASM_REGISTER_STATE_CHECK(params_.tst_func(y_tst_, Input(), dlist_, count,
+                                              bsize, thresholds_, dirs_));
+
+    for (int i = 0; i < kMaxBlocks * 64; ++i)
+      ASSERT_EQ(y_ref_[i], y_tst_[i]) << "bsize " << bsize << " at " << i;
+  }
+}
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, DirFindListTest,
+    ::testing::Values(
+        DirFindListFuncs(od_dir_find8_list_c, od_dir_find8_list_sse4_1, 8),
+        DirFindListFuncs(od_dir_find8_list_c, od_dir_find8_list_sse4_1, 10),
+        DirFindListFuncs(od_dir_find8_list_c, od_dir_find8_list_sse4_1, 12)));
+
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, DirectionListTest,
+    ::testing::Values(
+        DirectionListFuncs(od_filter_dering_direction_list_c,
+                           od_filter_dering_direction_list_sse4_1, 8),
+        DirectionListFuncs(od_filter_dering_direction_list_c,
+                           od_filter_dering_direction_list_sse4_1, 10),
+        DirectionListFuncs(od_filter_dering_direction_list_c,
+                           od_filter_dering_direction_list_sse4_1, 12)));
+
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, OrthogonalListTest,
+    ::testing::Values(
+        OrthogonalListFuncs(od_filter_dering_orthogonal_list_c,
+                            od_filter_dering_orthogonal_list_sse4_1, 8),
+        OrthogonalListFuncs(od_filter_dering_orthogonal_list_c,
+                            od_filter_dering_orthogonal_list_sse4_1, 10),
+        OrthogonalListFuncs(od_filter_dering_orthogonal_list_c,
+                            od_filter_dering_orthogonal_list_sse4_1, 12)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, DirFindListTest,
+    ::testing::Values(
+        DirFindListFuncs(od_dir_find8_list_c, od_dir_find8_list_avx2, 8),
+        DirFindListFuncs(od_dir_find8_list_c, od_dir_find8_list_avx2, 10),
+        DirFindListFuncs(od_dir_find8_list_c, od_dir_find8_list_avx2, 12)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, DirectionListTest,
+    ::testing::Values(
+        DirectionListFuncs(od_filter_dering_direction_list_c,
+                           od_filter_dering_direction_list_avx2, 8),
+        DirectionListFuncs(od_filter_dering_direction_list_c,
+                           od_filter_dering_direction_list_avx2, 10),
+        DirectionListFuncs(od_filter_dering_direction_list_c,
+                           od_filter_dering_direction_list_avx2, 12)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, OrthogonalListTest,
+    ::testing::Values(
+        OrthogonalListFuncs(od_filter_dering_orthogonal_list_c,
+                            od_filter_dering_orthogonal_list_avx2, 8),
+        OrthogonalListFuncs(od_filter_dering_orthogonal_list_c,
+                            od_filter_dering_orthogonal_list_avx2, 10),
+        OrthogonalListFuncs(od_filter_dering_orthogonal_list_c,
+                            od_filter_dering_orthogonal_list_avx2, 12)));
+#endif  // HAVE_AVX2
+}  // namespace
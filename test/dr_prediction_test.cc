@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "aom_ports/aom_timer.h"
+#include "av1/common/blockd.h"
+#include "av1/common/enums.h"
+
+namespace {
+
+using std::tr1::tuple;
+using std::tr1::make_tuple;
+using libaom_test::ACMRandom;
+
+typedef void (*DrPred)(uint8_t *dst, ptrdiff_t stride, int bs,
+                       const uint8_t *above, const uint8_t *left, int dx,
+                       int dy);
+
+// Note:
+//  Test parameter list:
+//  ((Reference predictor, optimized predictor, zone), block size, bit depth)
+//
+typedef tuple<DrPred, DrPred, int> DrPredFuncZone;
+typedef tuple<DrPredFuncZone, int, int> DrPredParams;
+
+#if CONFIG_AOM_HIGHBITDEPTH
+typedef void (*HbdDrPred)(uint16_t *dst, ptrdiff_t stride, int bs,
+                          const uint16_t *above, const uint16_t *left, int dx,
+                          int dy, int bd);
+
+typedef tuple<HbdDrPred, HbdDrPred, int> HbdDrPredFuncZone;
+typedef tuple<HbdDrPredFuncZone, int, int> HbdDrPredParams;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+void CallPredictor(DrPred pred, uint8_t *dst, ptrdiff_t stride, int bs,
+                   const uint8_t *above, const uint8_t *left, int dx, int dy,
+                   int bd) {
+  (void)bd;
+  pred(dst, stride, bs, above, left, dx, dy);
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+void CallPredictor(HbdDrPred pred, uint16_t *dst, ptrdiff_t stride, int bs,
+                   const uint16_t *above, const uint16_t *left, int dx, int dy,
+                   int bd) {
+  pred(dst, stride, bs, above, left, dx, dy, bd);
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+// Computes dx and dy for an angle the same way as av1/common/reconintra.c.
+void GetDxDy(int angle, int *dx, int *dy) {
+  *dx = 1;
+  *dy = 1;
+  if (angle < 90) {
+    *dx = dr_intra_derivative[angle];
+  } else if (angle < 180) {
+    *dx = dr_intra_derivative[180 - angle];
+    *dy = dr_intra_derivative[angle - 90];
+  } else {
+    *dy = dr_intra_derivative[270 - angle];
+  }
+}
+
+template <typename Pixel, typename FuncType>
+class DrPredTest : public ::testing::TestWithParam<
+                       tuple<tuple<FuncType, FuncType, int>, int, int> > {
+ public:
+  virtual ~DrPredTest() {}
+
+  virtual void SetUp() {
+    const tuple<FuncType, FuncType, int> funcs =
+        std::tr1::get<0>(this->GetParam());
+    ref_fn_ = std::tr1::get<0>(funcs);
+    tst_fn_ = std::tr1::get<1>(funcs);
+    // Zone z covers the angles (z - 1) * 90 < angle < z * 90.
+    start_angle_ = (std::tr1::get<2>(funcs) - 1) * 90 + 1;
+    bs_ = std::tr1::get<1>(this->GetParam());
+    bd_ = std::tr1::get<2>(this->GetParam());
+    above_ = above_data_ + 16;
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  void FillEdges(ACMRandom *rnd, bool saturate) {
+    const int mask = (1 << bd_) - 1;
+    for (int i = 0; i < kEdgeSize; ++i) {
+      above_data_[i] = saturate ? mask : rnd->Rand16() & mask;
+      left_[i] = saturate ? mask : rnd->Rand16() & mask;
+    }
+  }
+
+  void RunBitExactCheck() {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    for (int i = 0; i < kNumTests; ++i) {
+      FillEdges(&rnd, i == 0);
+      for (int angle = start_angle_; angle < start_angle_ + 89; ++angle) {
+        int dx, dy;
+        GetDxDy(angle, &dx, &dy);
+        for (int j = 0; j < kStride * kMaxBs; ++j) ref_dst_[j] = dst_[j] = 0;
+        CallPredictor(ref_fn_, ref_dst_, kStride, bs_, above_, left_, dx, dy,
+                      bd_);
+        ASM_REGISTER_STATE_CHECK(CallPredictor(tst_fn_, dst_, kStride, bs_,
+                                               above_, left_, dx, dy, bd_));
+        for (int r = 0; r < bs_; ++r) {
+          for (int c = 0; c < kStride; ++c) {
+            ASSERT_EQ(ref_dst_[r * kStride + c], dst_[r * kStride + c])
+                << "test " << i << " angle " << angle << " at (" << r << ", "
+                << c << ")";
+          }
+        }
+      }
+    }
+  }
+
+  void RunSpeedTest() {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    const int num_iterations = (1 << 22) / (bs_ * bs_);
+    FillEdges(&rnd, false);
+
+    for (int angle = start_angle_; angle < start_angle_ + 89; angle += 11) {
+      int dx, dy;
+      GetDxDy(angle, &dx, &dy);
+
+      aom_usec_timer ref_timer;
+      aom_usec_timer_start(&ref_timer);
+      for (int i = 0; i < num_iterations; ++i)
+        CallPredictor(ref_fn_, ref_dst_, kStride, bs_, above_, left_, dx, dy,
+                      bd_);
+      aom_usec_timer_mark(&ref_timer);
+      const int ref_elapsed_time = (int)aom_usec_timer_elapsed(&ref_timer);
+
+      aom_usec_timer timer;
+      aom_usec_timer_start(&timer);
+      for (int i = 0; i < num_iterations; ++i)
+        CallPredictor(tst_fn_, dst_, kStride, bs_, above_, left_, dx, dy, bd_);
+      aom_usec_timer_mark(&timer);
+      const int elapsed_time = (int)aom_usec_timer_elapsed(&timer);
+
+      printf("[          ] %dx%d angle %3d: C time = %d us, SIMD time = %d us"
+             "\n",
+             bs_, bs_, angle, ref_elapsed_time, elapsed_time);
+    }
+  }
+
+  static const int kNumTests = 50;
+  static const int kMaxBs = MAX_TX_SIZE;
+  static const int kStride = 2 * MAX_TX_SIZE;
+  static const int kEdgeSize = 2 * MAX_TX_SIZE + 16;
+
+  FuncType ref_fn_;
+  FuncType tst_fn_;
+  int start_angle_;
+  int bs_;
+  int bd_;
+  Pixel *above_;
+  // above_[-16..-1] are valid so that above_[-1] can be read.
+  Pixel above_data_[16 + kEdgeSize];
+  Pixel left_[kEdgeSize];
+  Pixel dst_[kStride * kMaxBs];
+  Pixel ref_dst_[kStride * kMaxBs];
+};
+
+typedef DrPredTest<uint8_t, DrPred> AV1DrPredTest;
+
+TEST_P(AV1DrPredTest, BitExactCheck) { RunBitExactCheck(); }
+TEST_P(AV1DrPredTest, DISABLED_Speed) { RunSpeedTest(); }
+
+#if CONFIG_AOM_HIGHBITDEPTH
+typedef DrPredTest<uint16_t, HbdDrPred> AV1HbdDrPredTest;
+
+TEST_P(AV1HbdDrPredTest, BitExactCheck) { RunBitExactCheck(); }
+TEST_P(AV1HbdDrPredTest, DISABLED_Speed) { RunSpeedTest(); }
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+const int kBlockSizes[] = { 2,  4,  8, 16, 32,
+#if CONFIG_TX64X64
+                            64,
+#endif  // CONFIG_TX64X64
+};
+
+const int kHbdBitDepths[] = { 10, 12 };
+
+#if HAVE_SSE4_1
+const DrPredFuncZone kDrPredFuncsSse4_1[] = {
+  make_tuple(&av1_dr_prediction_z1_c, &av1_dr_prediction_z1_sse4_1, 1),
+  make_tuple(&av1_dr_prediction_z2_c, &av1_dr_prediction_z2_sse4_1, 2),
+  make_tuple(&av1_dr_prediction_z3_c, &av1_dr_prediction_z3_sse4_1, 3),
+};
+
+INSTANTIATE_TEST_CASE_P(SSE4_1, AV1DrPredTest,
+                        ::testing::Combine(
+                            ::testing::ValuesIn(kDrPredFuncsSse4_1),
+                            ::testing::ValuesIn(kBlockSizes),
+                            ::testing::Values(8)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+const HbdDrPredFuncZone kHbdDrPredFuncsSse4_1[] = {
+  make_tuple(&av1_highbd_dr_prediction_z1_c,
+             &av1_highbd_dr_prediction_z1_sse4_1, 1),
+  make_tuple(&av1_highbd_dr_prediction_z2_c,
+             &av1_highbd_dr_prediction_z2_sse4_1, 2),
+  make_tuple(&av1_highbd_dr_prediction_z3_c,
+             &av1_highbd_dr_prediction_z3_sse4_1, 3),
+};
+
+INSTANTIATE_TEST_CASE_P(SSE4_1, AV1HbdDrPredTest,
+                        ::testing::Combine(
+                            ::testing::ValuesIn(kHbdDrPredFuncsSse4_1),
+                            ::testing::ValuesIn(kBlockSizes),
+                            ::testing::ValuesIn(kHbdBitDepths)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+const DrPredFuncZone kDrPredFuncsAvx2[] = {
+  make_tuple(&av1_dr_prediction_z1_c, &av1_dr_prediction_z1_avx2, 1),
+  make_tuple(&av1_dr_prediction_z2_c, &av1_dr_prediction_z2_avx2, 2),
+  make_tuple(&av1_dr_prediction_z3_c, &av1_dr_prediction_z3_avx2, 3),
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2, AV1DrPredTest,
+                        ::testing::Combine(::testing::ValuesIn(kDrPredFuncsAvx2),
+                                           ::testing::ValuesIn(kBlockSizes),
+                                           ::testing::Values(8)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+const HbdDrPredFuncZone kHbdDrPredFuncsAvx2[] = {
+  make_tuple(&av1_highbd_dr_prediction_z1_c, &av1_highbd_dr_prediction_z1_avx2,
+             1),
+  make_tuple(&av1_highbd_dr_prediction_z2_c, &av1_highbd_dr_prediction_z2_avx2,
+             2),
+  make_tuple(&av1_highbd_dr_prediction_z3_c, &av1_highbd_dr_prediction_z3_avx2,
+             3),
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2, AV1HbdDrPredTest,
+                        ::testing::Combine(
+                            ::testing::ValuesIn(kHbdDrPredFuncsAvx2),
+                            ::testing::ValuesIn(kBlockSizes),
+                            ::testing::ValuesIn(kHbdBitDepths)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // HAVE_AVX2
+
+}  // namespace
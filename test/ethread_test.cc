@@ -25,7 +25,8 @@ class AVxEncoderThreadTest
  protected:
   AVxEncoderThreadTest()
       : EncoderTest(GET_PARAM(0)), encoder_initialized_(false),
-        encoding_mode_(GET_PARAM(1)), set_cpu_used_(GET_PARAM(2)) {
+        encoding_mode_(GET_PARAM(1)), set_cpu_used_(GET_PARAM(2)),
+        tile_cols_log2_(2), row_mt_(0), tune_content_(AOM_CONTENT_DEFAULT) {
     init_flags_ = AOM_CODEC_USE_PSNR;
     aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
     cfg.w = 1280;
@@ -79,14 +80,15 @@ class AVxEncoderThreadTest
         encoder->Control(AV1E_SET_TILE_ROWS, 0);
       }
 #else
-      // Encode 4 tile columns.
-      encoder->Control(AV1E_SET_TILE_COLUMNS, 2);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, tile_cols_log2_);
       encoder->Control(AV1E_SET_TILE_ROWS, 0);
 #endif  // CONFIG_AV1 && CONFIG_EXT_TILE
+      encoder->Control(AV1E_SET_ROW_MT, row_mt_);
 #if CONFIG_LOOPFILTERING_ACROSS_TILES
       encoder->Control(AV1E_SET_TILE_LOOPFILTER, 0);
 #endif  // CONFIG_LOOPFILTERING_ACROSS_TILES
       encoder->Control(AOME_SET_CPUUSED, set_cpu_used_);
+      encoder->Control(AV1E_SET_TUNE_CONTENT, tune_content_);
       if (encoding_mode_ != ::libaom_test::kRealTime) {
         encoder->Control(AOME_SET_ENABLEAUTOALTREF, 1);
         encoder->Control(AOME_SET_ARNR_MAXFRAMES, 7);
@@ -163,6 +165,9 @@ class AVxEncoderThreadTest
   bool encoder_initialized_;
   ::libaom_test::TestMode encoding_mode_;
   int set_cpu_used_;
+  int tile_cols_log2_;
+  int row_mt_;
+  int tune_content_;
   ::libaom_test::Decoder *decoder_;
   std::vector<size_t> size_enc_;
   std::vector<std::string> md5_enc_;
@@ -175,6 +180,29 @@ class AVxEncoderThreadTestLarge : public AVxEncoderThreadTest {};
 
 TEST_P(AVxEncoderThreadTestLarge, EncoderResultTest) { DoTest(); }
 
+class AVxEncoderThreadRowMTTest : public AVxEncoderThreadTest {
+ protected:
+  // Encode a single tile column, to run its superblock rows in parallel.
+  AVxEncoderThreadRowMTTest() {
+    tile_cols_log2_ = 0;
+    row_mt_ = 1;
+  }
+};
+
+TEST_P(AVxEncoderThreadRowMTTest, EncoderResultTest) { DoTest(); }
+
+class AVxEncoderThreadScreenContentTest : public AVxEncoderThreadTest {
+ protected:
+  // Encode screen content in a single tile column, so that the workers only
+  // filter the alt-ref and analyse the first pass, with palette enabled.
+  AVxEncoderThreadScreenContentTest() {
+    tile_cols_log2_ = 0;
+    tune_content_ = AOM_CONTENT_SCREEN;
+  }
+};
+
+TEST_P(AVxEncoderThreadScreenContentTest, EncoderResultTest) { DoTest(); }
+
 // For AV1, only test speed 0 to 3.
 AV1_INSTANTIATE_TEST_CASE(AVxEncoderThreadTest,
                           ::testing::Values(::libaom_test::kTwoPassGood,
@@ -185,4 +213,13 @@ AV1_INSTANTIATE_TEST_CASE(AVxEncoderThreadTestLarge,
                           ::testing::Values(::libaom_test::kTwoPassGood,
                                             ::libaom_test::kOnePassGood),
                           ::testing::Range(0, 2));
+
+AV1_INSTANTIATE_TEST_CASE(AVxEncoderThreadRowMTTest,
+                          ::testing::Values(::libaom_test::kTwoPassGood,
+                                            ::libaom_test::kOnePassGood),
+                          ::testing::Range(2, 4));
+
+AV1_INSTANTIATE_TEST_CASE(AVxEncoderThreadScreenContentTest,
+                          ::testing::Values(::libaom_test::kTwoPassGood),
+                          ::testing::Values(4));
 }  // namespace
@@ -31,23 +31,31 @@ const int count_test_block = 100000;
 
 typedef void (*IntraPred)(uint16_t *dst, ptrdiff_t stride,
                           const uint16_t *above, const uint16_t *left, int bps);
+typedef void (*LowbdIntraPred)(uint8_t *dst, ptrdiff_t stride,
+                               const uint8_t *above, const uint8_t *left);
 
-struct IntraPredFunc {
-  IntraPredFunc(IntraPred pred = NULL, IntraPred ref = NULL,
-                int block_size_value = 0, int bit_depth_value = 0)
+template <typename FuncType>
+struct IntraPredFuncParam {
+  IntraPredFuncParam(FuncType pred = NULL, FuncType ref = NULL,
+                     int block_size_value = 0, int bit_depth_value = 0)
       : pred_fn(pred), ref_fn(ref), block_size(block_size_value),
         bit_depth(bit_depth_value) {}
 
-  IntraPred pred_fn;
-  IntraPred ref_fn;
+  FuncType pred_fn;
+  FuncType ref_fn;
   int block_size;
   int bit_depth;
 };
 
-class AV1IntraPredTest : public ::testing::TestWithParam<IntraPredFunc> {
+typedef IntraPredFuncParam<IntraPred> IntraPredFunc;
+typedef IntraPredFuncParam<LowbdIntraPred> LowbdIntraPredFunc;
+
+template <typename Pixel, typename FuncType>
+class IntraPredTestBase
+    : public ::testing::TestWithParam<IntraPredFuncParam<FuncType> > {
  public:
-  void RunTest(uint16_t *left_col, uint16_t *above_data, uint16_t *dst,
-               uint16_t *ref_dst) {
+  void RunTest(Pixel *left_col, Pixel *above_data, Pixel *dst,
+               Pixel *ref_dst) {
     ACMRandom rnd(ACMRandom::DeterministicSeed());
     const int block_size = params_.block_size;
     above_row_ = above_data + 16;
@@ -79,17 +87,12 @@ class AV1IntraPredTest : public ::testing::TestWithParam<IntraPredFunc> {
 
  protected:
   virtual void SetUp() {
-    params_ = GetParam();
+    params_ = this->GetParam();
     stride_ = params_.block_size * 3;
     mask_ = (1 << params_.bit_depth) - 1;
   }
 
-  void Predict() {
-    const int bit_depth = params_.bit_depth;
-    params_.ref_fn(ref_dst_, stride_, above_row_, left_col_, bit_depth);
-    ASM_REGISTER_STATE_CHECK(
-        params_.pred_fn(dst_, stride_, above_row_, left_col_, bit_depth));
-  }
+  virtual void Predict() = 0;
 
   void CheckPrediction(int test_case_number, int *error_count) const {
     // For each pixel ensure that the calculated value is the same as reference.
@@ -105,22 +108,50 @@ class AV1IntraPredTest : public ::testing::TestWithParam<IntraPredFunc> {
     }
   }
 
-  uint16_t *above_row_;
-  uint16_t *left_col_;
-  uint16_t *dst_;
-  uint16_t *ref_dst_;
+  Pixel *above_row_;
+  Pixel *left_col_;
+  Pixel *dst_;
+  Pixel *ref_dst_;
   ptrdiff_t stride_;
   int mask_;
 
-  IntraPredFunc params_;
+  IntraPredFuncParam<FuncType> params_;
 };
 
+class AV1IntraPredTest : public IntraPredTestBase<uint16_t, IntraPred> {
+ protected:
+  virtual void Predict() {
+    const int bit_depth = params_.bit_depth;
+    params_.ref_fn(ref_dst_, stride_, above_row_, left_col_, bit_depth);
+    ASM_REGISTER_STATE_CHECK(
+        params_.pred_fn(dst_, stride_, above_row_, left_col_, bit_depth));
+  }
+};
+
+class AV1LowbdIntraPredTest
+    : public IntraPredTestBase<uint8_t, LowbdIntraPred> {
+ protected:
+  virtual void Predict() {
+    params_.ref_fn(ref_dst_, stride_, above_row_, left_col_);
+    ASM_REGISTER_STATE_CHECK(
+        params_.pred_fn(dst_, stride_, above_row_, left_col_));
+  }
+};
+
+// The buffers are sized for the largest (64x64) block.
 TEST_P(AV1IntraPredTest, IntraPredTests) {
-  // max block size is 32
-  DECLARE_ALIGNED(16, uint16_t, left_col[2 * 32]);
-  DECLARE_ALIGNED(16, uint16_t, above_data[2 * 32 + 32]);
-  DECLARE_ALIGNED(16, uint16_t, dst[3 * 32 * 32]);
-  DECLARE_ALIGNED(16, uint16_t, ref_dst[3 * 32 * 32]);
+  DECLARE_ALIGNED(16, uint16_t, left_col[2 * 64]);
+  DECLARE_ALIGNED(16, uint16_t, above_data[2 * 64 + 32]);
+  DECLARE_ALIGNED(16, uint16_t, dst[3 * 64 * 64]);
+  DECLARE_ALIGNED(16, uint16_t, ref_dst[3 * 64 * 64]);
+  RunTest(left_col, above_data, dst, ref_dst);
+}
+
+TEST_P(AV1LowbdIntraPredTest, IntraPredTests) {
+  DECLARE_ALIGNED(16, uint8_t, left_col[2 * 64]);
+  DECLARE_ALIGNED(16, uint8_t, above_data[2 * 64 + 32]);
+  DECLARE_ALIGNED(16, uint8_t, dst[3 * 64 * 64]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst[3 * 64 * 64]);
   RunTest(left_col, above_data, dst, ref_dst);
 }
 
@@ -228,4 +259,95 @@ INSTANTIATE_TEST_CASE_P(
 
 #endif  // CONFIG_AOM_HIGHBITDEPTH
 #endif  // HAVE_SSE2
+
+#if CONFIG_ALT_INTRA
+#define lowbd_alt_pred(type, size, opt)                               \
+  LowbdIntraPredFunc(&aom_##type##_predictor_##size##x##size##_##opt, \
+                     &aom_##type##_predictor_##size##x##size##_c, size, 8)
+#define highbd_alt_pred(type, size, opt, bd)                            \
+  IntraPredFunc(&aom_highbd_##type##_predictor_##size##x##size##_##opt, \
+                &aom_highbd_##type##_predictor_##size##x##size##_c, size, bd)
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_CASE_P(
+    SSSE3_TO_C, AV1LowbdIntraPredTest,
+    ::testing::Values(lowbd_alt_pred(paeth, 2, ssse3),
+                      lowbd_alt_pred(paeth, 4, ssse3),
+                      lowbd_alt_pred(paeth, 8, ssse3),
+                      lowbd_alt_pred(paeth, 16, ssse3),
+                      lowbd_alt_pred(paeth, 32, ssse3),
+                      lowbd_alt_pred(smooth, 2, ssse3),
+                      lowbd_alt_pred(smooth, 4, ssse3),
+                      lowbd_alt_pred(smooth, 8, ssse3),
+                      lowbd_alt_pred(smooth, 16, ssse3),
+                      lowbd_alt_pred(smooth, 32, ssse3)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+#define SSSE3_HIGHBD_ALT_PRED(bd)                                             \
+  highbd_alt_pred(paeth, 4, ssse3, bd), highbd_alt_pred(paeth, 8, ssse3, bd), \
+      highbd_alt_pred(paeth, 16, ssse3, bd),                                  \
+      highbd_alt_pred(paeth, 32, ssse3, bd),                                  \
+      highbd_alt_pred(smooth, 4, ssse3, bd),                                  \
+      highbd_alt_pred(smooth, 8, ssse3, bd),                                  \
+      highbd_alt_pred(smooth, 16, ssse3, bd),                                 \
+      highbd_alt_pred(smooth, 32, ssse3, bd)
+
+INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_8, AV1IntraPredTest,
+                        ::testing::Values(SSSE3_HIGHBD_ALT_PRED(8)));
+INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_10, AV1IntraPredTest,
+                        ::testing::Values(SSSE3_HIGHBD_ALT_PRED(10)));
+INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_12, AV1IntraPredTest,
+                        ::testing::Values(SSSE3_HIGHBD_ALT_PRED(12)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+#if CONFIG_TX64X64
+INSTANTIATE_TEST_CASE_P(
+    SSSE3_TO_C_TX64, AV1LowbdIntraPredTest,
+    ::testing::Values(lowbd_alt_pred(paeth, 64, ssse3),
+                      lowbd_alt_pred(smooth, 64, ssse3)));
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSSE3_TO_C_TX64_HBD, AV1IntraPredTest,
+    ::testing::Values(highbd_alt_pred(paeth, 64, ssse3, 10),
+                      highbd_alt_pred(smooth, 64, ssse3, 12)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // CONFIG_TX64X64
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2_TO_C, AV1LowbdIntraPredTest,
+    ::testing::Values(lowbd_alt_pred(paeth, 16, avx2),
+                      lowbd_alt_pred(paeth, 32, avx2),
+                      lowbd_alt_pred(smooth, 16, avx2),
+                      lowbd_alt_pred(smooth, 32, avx2)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+#define AVX2_HIGHBD_ALT_PRED(bd)                                              \
+  highbd_alt_pred(paeth, 16, avx2, bd), highbd_alt_pred(paeth, 32, avx2, bd), \
+      highbd_alt_pred(smooth, 16, avx2, bd),                                  \
+      highbd_alt_pred(smooth, 32, avx2, bd)
+
+INSTANTIATE_TEST_CASE_P(AVX2_TO_C_8, AV1IntraPredTest,
+                        ::testing::Values(AVX2_HIGHBD_ALT_PRED(8)));
+INSTANTIATE_TEST_CASE_P(AVX2_TO_C_10, AV1IntraPredTest,
+                        ::testing::Values(AVX2_HIGHBD_ALT_PRED(10)));
+INSTANTIATE_TEST_CASE_P(AVX2_TO_C_12, AV1IntraPredTest,
+                        ::testing::Values(AVX2_HIGHBD_ALT_PRED(12)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+#if CONFIG_TX64X64
+INSTANTIATE_TEST_CASE_P(
+    AVX2_TO_C_TX64, AV1LowbdIntraPredTest,
+    ::testing::Values(lowbd_alt_pred(paeth, 64, avx2),
+                      lowbd_alt_pred(smooth, 64, avx2)));
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    AVX2_TO_C_TX64_HBD, AV1IntraPredTest,
+    ::testing::Values(highbd_alt_pred(paeth, 64, avx2, 10),
+                      highbd_alt_pred(smooth, 64, avx2, 12)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // CONFIG_TX64X64
+#endif  // HAVE_AVX2
+#endif  // CONFIG_ALT_INTRA
 }  // namespace
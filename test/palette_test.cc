@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./av1_rtcd.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/aom_timer.h"
+#include "aom_ports/mem.h"
+#include "av1/common/entropymode.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+
+using libaom_test::ACMRandom;
+
+namespace {
+typedef void (*CalcIndicesFunc)(const float *data, const float *centroids,
+                                uint8_t *indices, int n, int k, int dim);
+using std::tr1::tuple;
+// Function under test and the dimension of the points.
+typedef tuple<CalcIndicesFunc, int> CalcIndicesParam;
+
+const int kMaxPoints = 64 * 64;
+const int kMaxDim = 3;
+
+class CalcIndicesTest : public ::testing::TestWithParam<CalcIndicesParam> {
+ public:
+  virtual ~CalcIndicesTest() {}
+  virtual void SetUp() {
+    calc_indices_ = GET_PARAM(0);
+    dim_ = GET_PARAM(1);
+  }
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  // Points and centroids are integers, as they are in the encoder, so ties
+  // between centroids are common.
+  void FillRandom(ACMRandom *rnd, int n, int k, int max_val) {
+    for (int i = 0; i < n * dim_; ++i) data_[i] = rnd->Rand16() % max_val;
+    for (int i = 0; i < k * dim_; ++i) centroids_[i] = rnd->Rand16() % max_val;
+  }
+
+  void CheckIndices(int n, int k) {
+    av1_calc_indices_c(data_, centroids_, ref_indices_, n, k, dim_);
+    ASM_REGISTER_STATE_CHECK(
+        calc_indices_(data_, centroids_, indices_, n, k, dim_));
+    for (int i = 0; i < n; ++i) {
+      ASSERT_EQ(ref_indices_[i], indices_[i]) << "n " << n << " k " << k
+                                              << " dim " << dim_ << " at " << i;
+    }
+  }
+
+  CalcIndicesFunc calc_indices_;
+  int dim_;
+  float data_[kMaxDim * kMaxPoints];
+  float centroids_[kMaxDim * PALETTE_MAX_SIZE];
+  uint8_t indices_[kMaxPoints];
+  uint8_t ref_indices_[kMaxPoints];
+};
+
+TEST_P(CalcIndicesTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kSizes[] = { 1, 7, 8, 9, 64, 67, 4 * 4 * 9 + 3, kMaxPoints };
+  for (int iter = 0; iter < 10; ++iter) {
+    for (int s = 0; s < static_cast<int>(sizeof(kSizes) / sizeof(kSizes[0]));
+         ++s) {
+      for (int k = 2; k <= PALETTE_MAX_SIZE; ++k) {
+        const int n = kSizes[s];
+        FillRandom(&rnd, n, k, iter & 1 ? 4096 : 16);
+        CheckIndices(n, k);
+      }
+    }
+  }
+}
+
+TEST_P(CalcIndicesTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kNumLoops = 2000;
+  const int n = kMaxPoints;
+  const int k = PALETTE_MAX_SIZE;
+  aom_usec_timer ref_timer, test_timer;
+
+  FillRandom(&rnd, n, k, 256);
+
+  aom_usec_timer_start(&ref_timer);
+  for (int i = 0; i < kNumLoops; ++i)
+    av1_calc_indices_c(data_, centroids_, ref_indices_, n, k, dim_);
+  aom_usec_timer_mark(&ref_timer);
+  const int ref_elapsed_time =
+      static_cast<int>(aom_usec_timer_elapsed(&ref_timer));
+
+  aom_usec_timer_start(&test_timer);
+  for (int i = 0; i < kNumLoops; ++i)
+    calc_indices_(data_, centroids_, indices_, n, k, dim_);
+  aom_usec_timer_mark(&test_timer);
+  const int elapsed_time =
+      static_cast<int>(aom_usec_timer_elapsed(&test_timer));
+
+  printf("dim %d: c_time=%d \t simd_time=%d \t gain=%d\n", dim_,
+         ref_elapsed_time, elapsed_time,
+         ref_elapsed_time / AOMMAX(elapsed_time, 1));
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_AVX2
+// Dimensions other than 1 and 2 check the fallback to C.
+INSTANTIATE_TEST_CASE_P(AVX2, CalcIndicesTest,
+                        ::testing::Values(make_tuple(&av1_calc_indices_avx2, 1),
+                                          make_tuple(&av1_calc_indices_avx2, 2),
+                                          make_tuple(&av1_calc_indices_avx2,
+                                                     3)));
+#endif  // HAVE_AVX2
+
+}  // namespace
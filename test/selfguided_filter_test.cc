@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/function_equivalence_test.h"
+#include "test/register_state_check.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_mem/aom_mem.h"
+#include "aom_ports/aom_timer.h"
+#include "av1/common/restoration.h"
+
+using libaom_test::FunctionEquivalenceTest;
+
+namespace {
+
+// Restoration tiles are at most 1.5 times the tile size on each side.
+const int kMaxWidth = RESTORATION_TILESIZE_BIG * 3 / 2;
+const int kMaxHeight = RESTORATION_TILESIZE_BIG * 3 / 2;
+const int kStride = kMaxWidth + 16;
+
+////////////////////////////////////////////////////////////////////////////////
+// av1_box_sum
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (*BoxSumFunc)(int32_t *src, int width, int height, int src_stride,
+                           int r, int sqr, int32_t *dst, int dst_stride);
+typedef libaom_test::FuncParam<BoxSumFunc> BoxSumFuncs;
+
+class BoxSumTest : public FunctionEquivalenceTest<BoxSumFunc> {
+ protected:
+  static const int kIterations = 1000;
+
+  virtual void SetUp() {
+    FunctionEquivalenceTest<BoxSumFunc>::SetUp();
+    src_ = static_cast<int32_t *>(
+        aom_memalign(32, sizeof(*src_) * kStride * kMaxHeight));
+    dst_ref_ = static_cast<int32_t *>(
+        aom_memalign(32, sizeof(*dst_ref_) * kStride * kMaxHeight));
+    dst_tst_ = static_cast<int32_t *>(
+        aom_memalign(32, sizeof(*dst_tst_) * kStride * kMaxHeight));
+    ASSERT_TRUE(src_ != NULL);
+    ASSERT_TRUE(dst_ref_ != NULL);
+    ASSERT_TRUE(dst_tst_ != NULL);
+  }
+
+  virtual void TearDown() {
+    aom_free(src_);
+    aom_free(dst_ref_);
+    aom_free(dst_tst_);
+    FunctionEquivalenceTest<BoxSumFunc>::TearDown();
+  }
+
+  void Common(int width, int height, int r, int sqr) {
+    const int dst_stride = width + rng_(16);
+    memset(dst_ref_, 0, sizeof(*dst_ref_) * kStride * kMaxHeight);
+    memset(dst_tst_, 0, sizeof(*dst_tst_) * kStride * kMaxHeight);
+
+    params_.ref_func(src_, width, height, kStride, r, sqr, dst_ref_,
+                     dst_stride);
+    ASM_REGISTER_STATE_CHECK(params_.tst_func(src_, width, height, kStride, r,
+                                              sqr, dst_tst_, dst_stride));
+
+    for (int i = 0; i < height; ++i) {
+      for (int j = 0; j < width; ++j) {
+        ASSERT_EQ(dst_ref_[i * dst_stride + j], dst_tst_[i * dst_stride + j])
+            << "width " << width << " height " << height << " r " << r
+            << " sqr " << sqr << " at (" << i << ", " << j << ")";
+      }
+    }
+  }
+
+  int32_t *src_;
+  int32_t *dst_ref_;
+  int32_t *dst_tst_;
+};
+
+TEST_P(BoxSumTest, RandomValues) {
+  const int max_val = (1 << params_.bit_depth) - 1;
+  for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+    // Include blocks smaller than 2 * r + 1, which take the C fallback.
+    const int width = rng_(2) ? rng_(kMaxWidth - 4) + 5 : rng_(12) + 5;
+    const int height = rng_(2) ? rng_(kMaxHeight - 4) + 5 : rng_(12) + 5;
+    for (int i = 0; i < kStride * kMaxHeight; ++i)
+      src_[i] = rng_(max_val + 1);
+    Common(width, height, rng_(3) + 1, rng_(2));
+  }
+}
+
+TEST_P(BoxSumTest, ExtremeValues) {
+  const int max_val = (1 << params_.bit_depth) - 1;
+  for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+    const int width = rng_(kMaxWidth - 4) + 5;
+    const int height = rng_(kMaxHeight - 4) + 5;
+    for (int i = 0; i < kStride * kMaxHeight; ++i)
+      src_[i] = rng_(2) ? max_val : 0;
+    Common(width, height, rng_(3) + 1, rng_(2));
+  }
+}
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, BoxSumTest,
+    ::testing::Values(BoxSumFuncs(av1_box_sum_c, av1_box_sum_sse4_1, 8)
+#if CONFIG_AOM_HIGHBITDEPTH
+                          ,
+                      BoxSumFuncs(av1_box_sum_c, av1_box_sum_sse4_1, 10),
+                      BoxSumFuncs(av1_box_sum_c, av1_box_sum_sse4_1, 12)
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                          ));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, BoxSumTest,
+    ::testing::Values(BoxSumFuncs(av1_box_sum_c, av1_box_sum_avx2, 8)
+#if CONFIG_AOM_HIGHBITDEPTH
+                          ,
+                      BoxSumFuncs(av1_box_sum_c, av1_box_sum_avx2, 10),
+                      BoxSumFuncs(av1_box_sum_c, av1_box_sum_avx2, 12)
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                          ));
+#endif  // HAVE_AVX2
+
+////////////////////////////////////////////////////////////////////////////////
+// av1_selfguided_restoration
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (*SelfguidedFunc)(int32_t *dgd, int width, int height, int stride,
+                               int bit_depth, int r, int eps,
+                               int32_t *tmpbuf);
+typedef libaom_test::FuncParam<SelfguidedFunc> SelfguidedFuncs;
+
+class SelfguidedFilterTest : public FunctionEquivalenceTest<SelfguidedFunc> {
+ protected:
+  static const int kIterations = 100;
+  static const int kSpeedIterations = 20;
+
+  virtual void SetUp() {
+    FunctionEquivalenceTest<SelfguidedFunc>::SetUp();
+    dgd_ref_ = static_cast<int32_t *>(
+        aom_memalign(32, sizeof(*dgd_ref_) * kStride * kMaxHeight));
+    dgd_tst_ = static_cast<int32_t *>(
+        aom_memalign(32, sizeof(*dgd_tst_) * kStride * kMaxHeight));
+    tmpbuf_ =
+        static_cast<int32_t *>(aom_memalign(32, RESTORATION_TMPBUF_SIZE));
+    ASSERT_TRUE(dgd_ref_ != NULL);
+    ASSERT_TRUE(dgd_tst_ != NULL);
+    ASSERT_TRUE(tmpbuf_ != NULL);
+  }
+
+  virtual void TearDown() {
+    aom_free(dgd_ref_);
+    aom_free(dgd_tst_);
+    aom_free(tmpbuf_);
+    FunctionEquivalenceTest<SelfguidedFunc>::TearDown();
+  }
+
+  void RandomInput() {
+    // The C filter asserts that the box variance stays below 25 * 25 << 22,
+    // which uniform 12-bit noise can exceed for r = 3, so cap the range there.
+    const int bits = AOMMIN(params_.bit_depth, 11);
+    for (int i = 0; i < kStride * kMaxHeight; ++i) {
+      dgd_ref_[i] = rng_(1 << bits);
+    }
+    memcpy(dgd_tst_, dgd_ref_, sizeof(*dgd_tst_) * kStride * kMaxHeight);
+  }
+
+  int32_t *dgd_ref_;
+  int32_t *dgd_tst_;
+  int32_t *tmpbuf_;
+};
+
+TEST_P(SelfguidedFilterTest, RandomValues) {
+  for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+    // Blocks must be at least 2 * r + 1 pixels on each side.
+    const int width = rng_(2) ? rng_(kMaxWidth - 7) + 8 : rng_(16) + 8;
+    const int height = rng_(2) ? rng_(kMaxHeight - 7) + 8 : rng_(16) + 8;
+    const sgr_params_type *const sgr = &sgr_params[rng_(SGRPROJ_PARAMS)];
+    const int second = rng_(2);
+    const int r = second ? sgr->r2 : sgr->r1;
+    const int eps = second ? sgr->e2 : sgr->e1;
+
+    RandomInput();
+    params_.ref_func(dgd_ref_, width, height, kStride, params_.bit_depth, r,
+                     eps, tmpbuf_);
+    ASM_REGISTER_STATE_CHECK(params_.tst_func(dgd_tst_, width, height, kStride,
+                                              params_.bit_depth, r, eps,
+                                              tmpbuf_));
+
+    for (int i = 0; i < height; ++i) {
+      for (int j = 0; j < width; ++j) {
+        ASSERT_EQ(dgd_ref_[i * kStride + j], dgd_tst_[i * kStride + j])
+            << "width " << width << " height " << height << " r " << r
+            << " eps " << eps << " at (" << i << ", " << j << ")";
+      }
+    }
+  }
+}
+
+TEST_P(SelfguidedFilterTest, DISABLED_Speed) {
+  const sgr_params_type *const sgr = &sgr_params[SGRPROJ_PARAMS - 1];
+  aom_usec_timer ref_timer;
+  aom_usec_timer timer;
+
+  RandomInput();
+  aom_usec_timer_start(&ref_timer);
+  for (int iter = 0; iter < kSpeedIterations; ++iter) {
+    params_.ref_func(dgd_ref_, kMaxWidth, kMaxHeight, kStride,
+                     params_.bit_depth, sgr->r1, sgr->e1, tmpbuf_);
+    params_.ref_func(dgd_ref_, kMaxWidth, kMaxHeight, kStride,
+                     params_.bit_depth, sgr->r2, sgr->e2, tmpbuf_);
+  }
+  aom_usec_timer_mark(&ref_timer);
+  const int ref_elapsed_time = (int)aom_usec_timer_elapsed(&ref_timer);
+
+  aom_usec_timer_start(&timer);
+  for (int iter = 0; iter < kSpeedIterations; ++iter) {
+    params_.tst_func(dgd_tst_, kMaxWidth, kMaxHeight, kStride,
+                     params_.bit_depth, sgr->r1, sgr->e1, tmpbuf_);
+    params_.tst_func(dgd_tst_, kMaxWidth, kMaxHeight, kStride,
+                     params_.bit_depth, sgr->r2, sgr->e2, tmpbuf_);
+  }
+  aom_usec_timer_mark(&timer);
+  const int elapsed_time = (int)aom_usec_timer_elapsed(&timer);
+
+  printf("[          ] C time = %d ms, SIMD time = %d ms\n",
+         ref_elapsed_time / 1000, elapsed_time / 1000);
+  EXPECT_GT(ref_elapsed_time, elapsed_time)
+      << "Error: SelfguidedFilterTest, SIMD slower than C." << std::endl
+      << "C time: " << ref_elapsed_time << " us" << std::endl
+      << "SIMD time: " << elapsed_time << " us" << std::endl;
+}
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, SelfguidedFilterTest,
+    ::testing::Values(SelfguidedFuncs(av1_selfguided_restoration_c,
+                                      av1_selfguided_restoration_sse4_1, 8)
+#if CONFIG_AOM_HIGHBITDEPTH
+                          ,
+                      SelfguidedFuncs(av1_selfguided_restoration_c,
+                                      av1_selfguided_restoration_sse4_1, 10),
+                      SelfguidedFuncs(av1_selfguided_restoration_c,
+                                      av1_selfguided_restoration_sse4_1, 12)
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                          ));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, SelfguidedFilterTest,
+    ::testing::Values(SelfguidedFuncs(av1_selfguided_restoration_c,
+                                      av1_selfguided_restoration_avx2, 8)
+#if CONFIG_AOM_HIGHBITDEPTH
+                          ,
+                      SelfguidedFuncs(av1_selfguided_restoration_c,
+                                      av1_selfguided_restoration_avx2, 10),
+                      SelfguidedFuncs(av1_selfguided_restoration_c,
+                                      av1_selfguided_restoration_avx2, 12)
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+                          ));
+#endif  // HAVE_AVX2
+}  // namespace
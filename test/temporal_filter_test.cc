@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/aom_timer.h"
+#include "aom_ports/mem.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+
+using libaom_test::ACMRandom;
+
+namespace {
+typedef void (*TemporalFilterFunc)(uint8_t *frame1, unsigned int stride,
+                                   uint8_t *frame2, unsigned int block_width,
+                                   unsigned int block_height, int strength,
+                                   int filter_weight,
+                                   unsigned int *accumulator, uint16_t *count);
+using std::tr1::tuple;
+// Function under test, reference function and bit depth.
+typedef tuple<TemporalFilterFunc, TemporalFilterFunc, int> TemporalFilterParam;
+
+const int kMaxBlockSize = 16;
+const int kStride = kMaxBlockSize + 5;
+
+class TemporalFilterTest
+    : public ::testing::TestWithParam<TemporalFilterParam> {
+ public:
+  virtual ~TemporalFilterTest() {}
+  virtual void SetUp() {
+    filter_ = GET_PARAM(0);
+    ref_filter_ = GET_PARAM(1);
+    bit_depth_ = GET_PARAM(2);
+    mask_ = (1 << bit_depth_) - 1;
+    // The high bit depth functions take 16-bit frames, even at 8 bits.
+    highbd_ = ref_filter_ != &av1_temporal_filter_apply_c;
+  }
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  uint8_t *Frame1() {
+#if CONFIG_AOM_HIGHBITDEPTH
+    if (highbd_) return CONVERT_TO_BYTEPTR(frame1_);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+    return frame1_8_;
+  }
+  uint8_t *Frame2() {
+#if CONFIG_AOM_HIGHBITDEPTH
+    if (highbd_) return CONVERT_TO_BYTEPTR(frame2_);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+    return frame2_8_;
+  }
+
+  void SetPixel(int frame, int i, int value) {
+    if (frame == 1) {
+      frame1_[i] = value;
+      frame1_8_[i] = value;
+    } else {
+      frame2_[i] = value;
+      frame2_8_[i] = value;
+    }
+  }
+
+  int RandPixel(ACMRandom *rnd, int extreme) {
+    return extreme ? (rnd->Rand8() & 1) * mask_ : rnd->Rand16() & mask_;
+  }
+
+  // Fills the frames with random pixels, or with the extreme values when
+  // 'extreme' is set, and starts the accumulator and count from random values.
+  void FillRandom(ACMRandom *rnd, int extreme) {
+    for (int i = 0; i < kStride * kMaxBlockSize; ++i) {
+      SetPixel(1, i, RandPixel(rnd, extreme));
+    }
+    for (int i = 0; i < kMaxBlockSize * kMaxBlockSize; ++i) {
+      SetPixel(2, i, RandPixel(rnd, extreme));
+      ref_accumulator_[i] = accumulator_[i] = rnd->Rand16();
+      ref_count_[i] = count_[i] = rnd->Rand8();
+    }
+  }
+
+  void CheckFilter(int width, int height, int strength, int filter_weight) {
+    ref_filter_(Frame1(), kStride, Frame2(), width, height, strength,
+                filter_weight, ref_accumulator_, ref_count_);
+    ASM_REGISTER_STATE_CHECK(filter_(Frame1(), kStride, Frame2(), width,
+                                     height, strength, filter_weight,
+                                     accumulator_, count_));
+    for (int i = 0; i < kMaxBlockSize * kMaxBlockSize; ++i) {
+      ASSERT_EQ(ref_accumulator_[i], accumulator_[i])
+          << width << "x" << height << " strength " << strength << " weight "
+          << filter_weight << " at " << i;
+      ASSERT_EQ(ref_count_[i], count_[i])
+          << width << "x" << height << " strength " << strength << " weight "
+          << filter_weight << " at " << i;
+    }
+  }
+
+  TemporalFilterFunc filter_;
+  TemporalFilterFunc ref_filter_;
+  int bit_depth_;
+  int highbd_;
+  int mask_;
+  uint16_t frame1_[kStride * kMaxBlockSize];
+  uint16_t frame2_[kMaxBlockSize * kMaxBlockSize];
+  uint8_t frame1_8_[kStride * kMaxBlockSize];
+  uint8_t frame2_8_[kMaxBlockSize * kMaxBlockSize];
+  unsigned int accumulator_[kMaxBlockSize * kMaxBlockSize];
+  unsigned int ref_accumulator_[kMaxBlockSize * kMaxBlockSize];
+  uint16_t count_[kMaxBlockSize * kMaxBlockSize];
+  uint16_t ref_count_[kMaxBlockSize * kMaxBlockSize];
+};
+
+TEST_P(TemporalFilterTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  // 12x12 and 4x1 are left to the C version by the SIMD ones.
+  const int kSizes[][2] = { { 16, 16 }, { 8, 8 },   { 16, 8 },
+                            { 8, 16 },  { 4, 4 },   { 8, 2 },
+                            { 12, 12 }, { 4, 1 } };
+  const int max_strength = 6 + 2 * (bit_depth_ - 8);
+  for (int iter = 0; iter < 20; ++iter) {
+    for (int s = 0; s < static_cast<int>(sizeof(kSizes) / sizeof(kSizes[0]));
+         ++s) {
+      for (int strength = 0; strength <= max_strength; ++strength) {
+        for (int filter_weight = 0; filter_weight <= 2; ++filter_weight) {
+          FillRandom(&rnd, iter == 0);
+          CheckFilter(kSizes[s][0], kSizes[s][1], strength, filter_weight);
+        }
+      }
+    }
+  }
+}
+
+TEST_P(TemporalFilterTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kNumLoops = 1000000;
+  aom_usec_timer ref_timer, test_timer;
+
+  FillRandom(&rnd, 0);
+
+  aom_usec_timer_start(&ref_timer);
+  for (int i = 0; i < kNumLoops; ++i) {
+    ref_filter_(Frame1(), kStride, Frame2(), kMaxBlockSize, kMaxBlockSize, 6,
+                2, ref_accumulator_, ref_count_);
+  }
+  aom_usec_timer_mark(&ref_timer);
+  const int ref_elapsed_time =
+      static_cast<int>(aom_usec_timer_elapsed(&ref_timer));
+
+  aom_usec_timer_start(&test_timer);
+  for (int i = 0; i < kNumLoops; ++i) {
+    filter_(Frame1(), kStride, Frame2(), kMaxBlockSize, kMaxBlockSize, 6, 2,
+            accumulator_, count_);
+  }
+  aom_usec_timer_mark(&test_timer);
+  const int elapsed_time =
+      static_cast<int>(aom_usec_timer_elapsed(&test_timer));
+
+  printf("bd %d: c_time=%d \t simd_time=%d \t gain=%d\n", bit_depth_,
+         ref_elapsed_time, elapsed_time,
+         ref_elapsed_time / AOMMAX(elapsed_time, 1));
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, TemporalFilterTest,
+    ::testing::Values(make_tuple(&av1_highbd_temporal_filter_apply_sse4_1,
+                                 &av1_highbd_temporal_filter_apply_c, 8),
+                      make_tuple(&av1_highbd_temporal_filter_apply_sse4_1,
+                                 &av1_highbd_temporal_filter_apply_c, 10),
+                      make_tuple(&av1_highbd_temporal_filter_apply_sse4_1,
+                                 &av1_highbd_temporal_filter_apply_c, 12)));
+#endif  // HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, TemporalFilterTest,
+                        ::testing::Values(make_tuple(
+                            &av1_temporal_filter_apply_avx2,
+                            &av1_temporal_filter_apply_c, 8)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    AVX2_HIGHBD, TemporalFilterTest,
+    ::testing::Values(make_tuple(&av1_highbd_temporal_filter_apply_avx2,
+                                 &av1_highbd_temporal_filter_apply_c, 8),
+                      make_tuple(&av1_highbd_temporal_filter_apply_avx2,
+                                 &av1_highbd_temporal_filter_apply_c, 10),
+                      make_tuple(&av1_highbd_temporal_filter_apply_avx2,
+                                 &av1_highbd_temporal_filter_apply_c, 12)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // HAVE_AVX2
+
+}  // namespace
@@ -101,6 +101,7 @@ LIBAOM_TEST_SRCS-yes                   += partial_idct_test.cc
 LIBAOM_TEST_SRCS-yes                   += superframe_test.cc
 LIBAOM_TEST_SRCS-yes                   += tile_independence_test.cc
 LIBAOM_TEST_SRCS-yes                   += ethread_test.cc
+LIBAOM_TEST_SRCS-yes                   += decode_row_mt_test.cc
 ifeq ($(CONFIG_EXT_TILE),yes)
 LIBAOM_TEST_SRCS-yes                   += av1_ext_tile_test.cc
 endif
@@ -121,6 +122,9 @@ LIBAOM_TEST_SRCS-$(CONFIG_ADAPT_SCAN)  += scan_test.cc
 LIBAOM_TEST_SRCS-yes                   += convolve_test.cc
 LIBAOM_TEST_SRCS-yes                   += lpf_8_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_CLPF)        += clpf_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_DERING)      += dering_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_LOOP_RESTORATION) += selfguided_filter_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_LOOP_RESTORATION) += wiener_convolve_test.cc
 LIBAOM_TEST_SRCS-yes                   += simd_cmp_impl.h
 LIBAOM_TEST_SRCS-$(HAVE_SSE2)          += simd_cmp_sse2.cc
 LIBAOM_TEST_SRCS-$(HAVE_SSSE3)         += simd_cmp_ssse3.cc
@@ -151,6 +155,11 @@ LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_dct_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht4x4_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht8x8_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht16x16_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht64x64_test.cc
+ifeq ($(CONFIG_PALETTE),yes)
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += palette_test.cc
+endif
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += temporal_filter_test.cc
 ifeq ($(CONFIG_EXT_TX),yes)
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht4x8_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht8x4_test.cc
@@ -158,6 +167,10 @@ LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht8x16_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht16x8_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht16x32_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht32x16_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht4x16_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht16x4_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht8x32_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += av1_fht32x8_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += fht32x32_test.cc
 endif
 
@@ -166,6 +179,10 @@ LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += subtract_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += blend_a64_mask_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += blend_a64_mask_1d_test.cc
 
+ifeq ($(CONFIG_LOOP_RESTORATION),yes)
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += wiener_corr_test.cc
+endif
+
 ifeq ($(CONFIG_EXT_INTER),yes)
 LIBAOM_TEST_SRCS-$(HAVE_SSSE3) += masked_variance_test.cc
 LIBAOM_TEST_SRCS-$(HAVE_SSSE3) += masked_sad_test.cc
@@ -176,13 +193,17 @@ ifeq ($(CONFIG_FILTER_INTRA),yes)
 LIBAOM_TEST_SRCS-$(HAVE_SSE4_1) += filterintra_predictors_test.cc
 endif
 
+ifeq ($(CONFIG_EXT_INTRA),yes)
+LIBAOM_TEST_SRCS-$(HAVE_SSE4_1) += dr_prediction_test.cc
+endif
+
 ifeq ($(CONFIG_MOTION_VAR),yes)
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += obmc_sad_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += obmc_variance_test.cc
 endif
 
-ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 LIBAOM_TEST_SRCS-$(HAVE_SSE4_1) += av1_quantize_test.cc
+ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 LIBAOM_TEST_SRCS-$(HAVE_SSE4_1) += av1_highbd_iht_test.cc
 endif # CONFIG_AOM_HIGHBITDEPTH
 endif # AV1
@@ -207,6 +228,9 @@ LIBAOM_TEST_SRCS-$(CONFIG_AV1) += av1_convolve_optimz_test.cc
 ifneq ($(findstring yes,$(CONFIG_GLOBAL_MOTION) $(CONFIG_WARPED_MOTION)),)
 LIBAOM_TEST_SRCS-$(HAVE_SSE2) += warp_filter_test.cc
 endif
+ifeq ($(CONFIG_GLOBAL_MOTION),yes)
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += corner_match_test.cc
+endif
 
 TEST_INTRA_PRED_SPEED_SRCS-yes := test_intra_pred_speed.cc
 TEST_INTRA_PRED_SPEED_SRCS-yes += ../md5_utils.h ../md5_utils.c
@@ -242,9 +242,18 @@ INTRA_PRED_TEST(SSE2, TestIntraPred4, aom_dc_predictor_4x4_sse2,
 #endif  // HAVE_SSE2
 
 #if HAVE_SSSE3
+#if CONFIG_ALT_INTRA
+#define tm_pred_func aom_paeth_predictor_4x4_ssse3
+#define smooth_pred_func aom_smooth_predictor_4x4_ssse3
+#else
+#define tm_pred_func NULL
+#define smooth_pred_func NULL
+#endif  // CONFIG_ALT_INTRA
 INTRA_PRED_TEST(SSSE3, TestIntraPred4, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
                 NULL, NULL, aom_d153_predictor_4x4_ssse3, NULL,
-                aom_d63_predictor_4x4_ssse3, NULL, NULL)
+                aom_d63_predictor_4x4_ssse3, tm_pred_func, smooth_pred_func)
+#undef tm_pred_func
+#undef smooth_pred_func
 #endif  // HAVE_SSSE3
 
 #if HAVE_DSPR2
@@ -323,10 +332,19 @@ INTRA_PRED_TEST(SSE2, TestIntraPred8, aom_dc_predictor_8x8_sse2,
 #endif  // HAVE_SSE2
 
 #if HAVE_SSSE3
+#if CONFIG_ALT_INTRA
+#define tm_pred_func aom_paeth_predictor_8x8_ssse3
+#define smooth_pred_func aom_smooth_predictor_8x8_ssse3
+#else
+#define tm_pred_func NULL
+#define smooth_pred_func NULL
+#endif  // CONFIG_ALT_INTRA
 INTRA_PRED_TEST(SSSE3, TestIntraPred8, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
                 NULL, NULL, aom_d153_predictor_8x8_ssse3,
-                aom_d207_predictor_8x8_ssse3, aom_d63_predictor_8x8_ssse3, NULL,
-                NULL)
+                aom_d207_predictor_8x8_ssse3, aom_d63_predictor_8x8_ssse3,
+                tm_pred_func, smooth_pred_func)
+#undef tm_pred_func
+#undef smooth_pred_func
 #endif  // HAVE_SSSE3
 
 #if HAVE_DSPR2
@@ -405,12 +423,27 @@ INTRA_PRED_TEST(SSE2, TestIntraPred16, aom_dc_predictor_16x16_sse2,
 #endif  // HAVE_SSE2
 
 #if HAVE_SSSE3
+#if CONFIG_ALT_INTRA
+#define tm_pred_func aom_paeth_predictor_16x16_ssse3
+#define smooth_pred_func aom_smooth_predictor_16x16_ssse3
+#else
+#define tm_pred_func NULL
+#define smooth_pred_func NULL
+#endif  // CONFIG_ALT_INTRA
 INTRA_PRED_TEST(SSSE3, TestIntraPred16, NULL, NULL, NULL, NULL, NULL, NULL,
                 aom_d45_predictor_16x16_ssse3, NULL, NULL,
                 aom_d153_predictor_16x16_ssse3, aom_d207_predictor_16x16_ssse3,
-                aom_d63_predictor_16x16_ssse3, NULL, NULL)
+                aom_d63_predictor_16x16_ssse3, tm_pred_func, smooth_pred_func)
+#undef tm_pred_func
+#undef smooth_pred_func
 #endif  // HAVE_SSSE3
 
+#if HAVE_AVX2 && CONFIG_ALT_INTRA
+INTRA_PRED_TEST(AVX2, TestIntraPred16, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL, NULL, NULL,
+                aom_paeth_predictor_16x16_avx2, aom_smooth_predictor_16x16_avx2)
+#endif  // HAVE_AVX2 && CONFIG_ALT_INTRA
+
 #if HAVE_DSPR2
 INTRA_PRED_TEST(DSPR2, TestIntraPred16, aom_dc_predictor_16x16_dspr2, NULL,
                 NULL, NULL, NULL, aom_h_predictor_16x16_dspr2, NULL, NULL, NULL,
@@ -482,12 +515,27 @@ INTRA_PRED_TEST(SSE2, TestIntraPred32, aom_dc_predictor_32x32_sse2,
 #endif  // HAVE_SSE2
 
 #if HAVE_SSSE3
+#if CONFIG_ALT_INTRA
+#define tm_pred_func aom_paeth_predictor_32x32_ssse3
+#define smooth_pred_func aom_smooth_predictor_32x32_ssse3
+#else
+#define tm_pred_func NULL
+#define smooth_pred_func NULL
+#endif  // CONFIG_ALT_INTRA
 INTRA_PRED_TEST(SSSE3, TestIntraPred32, NULL, NULL, NULL, NULL, NULL, NULL,
                 aom_d45_predictor_32x32_ssse3, NULL, NULL,
                 aom_d153_predictor_32x32_ssse3, aom_d207_predictor_32x32_ssse3,
-                aom_d63_predictor_32x32_ssse3, NULL, NULL)
+                aom_d63_predictor_32x32_ssse3, tm_pred_func, smooth_pred_func)
+#undef tm_pred_func
+#undef smooth_pred_func
 #endif  // HAVE_SSSE3
 
+#if HAVE_AVX2 && CONFIG_ALT_INTRA
+INTRA_PRED_TEST(AVX2, TestIntraPred32, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL, NULL, NULL,
+                aom_paeth_predictor_32x32_avx2, aom_smooth_predictor_32x32_avx2)
+#endif  // HAVE_AVX2 && CONFIG_ALT_INTRA
+
 #if HAVE_NEON
 #if CONFIG_ALT_INTRA
 #define tm_pred_func NULL
@@ -357,6 +357,8 @@ class TransformTestBase {
       row = 16;
     } else if (1024 == num_coeffs_) {
       row = 32;
+    } else if (4096 == num_coeffs_) {
+      row = 64;
     }
     return row;
   }
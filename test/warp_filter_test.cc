@@ -24,13 +24,39 @@ using std::tr1::tuple;
 using std::tr1::make_tuple;
 using libaom_test::ACMRandom;
 
-typedef tuple<int, int, int> WarpTestParam;
+typedef void (*warp_affine_func)(int32_t *mat, uint8_t *ref, int width,
+                                 int height, int stride, uint8_t *pred,
+                                 int p_col, int p_row, int p_width,
+                                 int p_height, int p_stride, int subsampling_x,
+                                 int subsampling_y, int ref_frm, int32_t alpha,
+                                 int32_t beta, int32_t gamma, int32_t delta);
+
+// Note:
+//  Test parameter list:
+//  (out_w, out_h, num_iters), warp_affine
+typedef tuple<int, int, int> WarpBlockSize;
+typedef tuple<WarpBlockSize, warp_affine_func> WarpTestParam;
+
+#if CONFIG_AOM_HIGHBITDEPTH
+typedef void (*highbd_warp_affine_func)(
+    int32_t *mat, uint16_t *ref, int width, int height, int stride,
+    uint16_t *pred, int p_col, int p_row, int p_width, int p_height,
+    int p_stride, int subsampling_x, int subsampling_y, int bd, int ref_frm,
+    int32_t alpha, int32_t beta, int32_t gamma, int32_t delta);
+
+// Note:
+//  Test parameter list:
+//  (out_w, out_h, num_iters), bd, highbd_warp_affine
+typedef tuple<WarpBlockSize, int, highbd_warp_affine_func>
+    HighbdWarpTestParam;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
 
 namespace {
 
-class AV1WarpFilterTest : public ::testing::TestWithParam<WarpTestParam> {
+template <typename Param>
+class WarpFilterTestBase : public ::testing::TestWithParam<Param> {
  public:
-  virtual ~AV1WarpFilterTest() {}
+  virtual ~WarpFilterTestBase() {}
   virtual void SetUp() { rnd_.Reset(ACMRandom::DeterministicSeed()); }
 
   virtual void TearDown() { libaom_test::ClearSystemState(); }
@@ -83,12 +109,19 @@ class AV1WarpFilterTest : public ::testing::TestWithParam<WarpTestParam> {
     }
   }
 
+  ACMRandom rnd_;
+};
+
+class AV1WarpFilterTest : public WarpFilterTestBase<WarpTestParam> {
+ protected:
   void RunCheckOutput() {
     const int w = 128, h = 128;
     const int border = 16;
     const int stride = w + 2 * border;
-    const int out_w = GET_PARAM(0), out_h = GET_PARAM(1);
-    const int num_iters = GET_PARAM(2);
+    const int out_w = std::tr1::get<0>(GET_PARAM(0));
+    const int out_h = std::tr1::get<1>(GET_PARAM(0));
+    const int num_iters = std::tr1::get<2>(GET_PARAM(0));
+    const warp_affine_func test_impl = GET_PARAM(1);
     int i, j;
 
     uint8_t *input_ = new uint8_t[h * stride];
@@ -107,11 +140,15 @@ class AV1WarpFilterTest : public ::testing::TestWithParam<WarpTestParam> {
 
     /* Try different sizes of prediction block */
     for (i = 0; i < num_iters; ++i) {
+      // Alternate between writing and averaging into the output
+      const int ref_frm = i & 1;
+      for (j = 0; j < out_w * out_h; ++j) output[j] = output2[j] = rnd_.Rand8();
       generate_model(mat, &alpha, &beta, &gamma, &delta);
       av1_warp_affine_c(mat, input, w, h, stride, output, 32, 32, out_w, out_h,
-                        out_w, 0, 0, 0, alpha, beta, gamma, delta);
-      av1_warp_affine_sse2(mat, input, w, h, stride, output2, 32, 32, out_w,
-                           out_h, out_w, 0, 0, 0, alpha, beta, gamma, delta);
+                        out_w, 0, 0, ref_frm, alpha, beta, gamma, delta);
+      ASM_REGISTER_STATE_CHECK(test_impl(mat, input, w, h, stride, output2, 32,
+                                         32, out_w, out_h, out_w, 0, 0,
+                                         ref_frm, alpha, beta, gamma, delta));
 
       for (j = 0; j < out_w * out_h; ++j)
         ASSERT_EQ(output[j], output2[j])
@@ -123,17 +160,107 @@ class AV1WarpFilterTest : public ::testing::TestWithParam<WarpTestParam> {
     delete[] output;
     delete[] output2;
   }
-
-  ACMRandom rnd_;
 };
 
 TEST_P(AV1WarpFilterTest, CheckOutput) { RunCheckOutput(); }
 
-const WarpTestParam params[] = {
-  make_tuple(4, 4, 50000),  make_tuple(8, 8, 50000),  make_tuple(64, 64, 1000),
-  make_tuple(4, 16, 20000), make_tuple(32, 8, 10000),
+#if CONFIG_AOM_HIGHBITDEPTH
+class AV1HighbdWarpFilterTest
+    : public WarpFilterTestBase<HighbdWarpTestParam> {
+ protected:
+  void RunCheckOutput() {
+    const int w = 128, h = 128;
+    const int border = 16;
+    const int stride = w + 2 * border;
+    const int out_w = std::tr1::get<0>(GET_PARAM(0));
+    const int out_h = std::tr1::get<1>(GET_PARAM(0));
+    const int num_iters = std::tr1::get<2>(GET_PARAM(0));
+    const int bd = GET_PARAM(1);
+    const highbd_warp_affine_func test_impl = GET_PARAM(2);
+    const int mask = (1 << bd) - 1;
+    int i, j;
+
+    uint16_t *input_ = new uint16_t[h * stride];
+    uint16_t *input = input_ + border;
+    uint16_t *output = new uint16_t[out_w * out_h];
+    uint16_t *output2 = new uint16_t[out_w * out_h];
+    int32_t mat[8], alpha, beta, gamma, delta;
+
+    // Generate an input block and extend its borders horizontally
+    for (i = 0; i < h; ++i)
+      for (j = 0; j < w; ++j) input[i * stride + j] = rnd_.Rand16() & mask;
+    for (i = 0; i < h; ++i) {
+      for (j = 0; j < border; ++j) {
+        input[i * stride - border + j] = input[i * stride];
+        input[i * stride + w + j] = input[i * stride + (w - 1)];
+      }
+    }
+
+    /* Try different sizes of prediction block */
+    for (i = 0; i < num_iters; ++i) {
+      // Alternate between writing and averaging into the output
+      const int ref_frm = i & 1;
+      for (j = 0; j < out_w * out_h; ++j)
+        output[j] = output2[j] = rnd_.Rand16() & mask;
+      generate_model(mat, &alpha, &beta, &gamma, &delta);
+      av1_highbd_warp_affine_c(mat, input, w, h, stride, output, 32, 32, out_w,
+                               out_h, out_w, 0, 0, bd, ref_frm, alpha, beta,
+                               gamma, delta);
+      ASM_REGISTER_STATE_CHECK(test_impl(mat, input, w, h, stride, output2, 32,
+                                         32, out_w, out_h, out_w, 0, 0, bd,
+                                         ref_frm, alpha, beta, gamma, delta));
+
+      for (j = 0; j < out_w * out_h; ++j)
+        ASSERT_EQ(output[j], output2[j])
+            << "Pixel mismatch at index " << j << " = (" << (j % out_w) << ", "
+            << (j / out_w) << ") on iteration " << i;
+    }
+
+    delete[] input_;
+    delete[] output;
+    delete[] output2;
+  }
 };
 
-INSTANTIATE_TEST_CASE_P(SSE2, AV1WarpFilterTest, ::testing::ValuesIn(params));
+TEST_P(AV1HighbdWarpFilterTest, CheckOutput) { RunCheckOutput(); }
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+const WarpBlockSize kBlockSizes[] = {
+  make_tuple(4, 4, 50000),  make_tuple(8, 8, 50000),
+  make_tuple(64, 64, 1000), make_tuple(4, 16, 20000),
+  make_tuple(32, 8, 10000), make_tuple(24, 16, 10000),
+};
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, AV1WarpFilterTest,
+    ::testing::Combine(::testing::ValuesIn(kBlockSizes),
+                       ::testing::Values(av1_warp_affine_sse2)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1WarpFilterTest,
+    ::testing::Combine(::testing::ValuesIn(kBlockSizes),
+                       ::testing::Values(av1_warp_affine_avx2)));
+#endif  // HAVE_AVX2
+
+#if CONFIG_AOM_HIGHBITDEPTH
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, AV1HighbdWarpFilterTest,
+    ::testing::Combine(::testing::ValuesIn(kBlockSizes),
+                       ::testing::Values(8, 10, 12),
+                       ::testing::Values(av1_highbd_warp_affine_sse4_1)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1HighbdWarpFilterTest,
+    ::testing::Combine(::testing::ValuesIn(kBlockSizes),
+                       ::testing::Values(8, 10, 12),
+                       ::testing::Values(av1_highbd_warp_affine_avx2)));
+#endif  // HAVE_AVX2
+#endif  // CONFIG_AOM_HIGHBITDEPTH
 
 }  // namespace
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/function_equivalence_test.h"
+#include "test/register_state_check.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_filter.h"
+#include "aom_ports/mem.h"
+#include "av1/common/restoration.h"
+
+using libaom_test::FunctionEquivalenceTest;
+
+namespace {
+
+// Blocks up to twice the stripe width, so that the column split is covered.
+const int kMaxWidth = 2 * WIENER_STRIPE_WIDTH;
+const int kMaxHeight = 3 * WIENER_STRIPE_HEIGHT;
+const int kBorder = 16;
+const int kStride = kMaxWidth + 2 * kBorder;
+const int kBufSize = kStride * (kMaxHeight + 2 * kBorder);
+const int kIterations = 100;
+
+// Random symmetric filter within the range of the coded taps.
+void RandomFilter(ACMRandom *rng, int16_t *filter) {
+  filter[0] = filter[WIENER_WIN - 1] =
+      WIENER_FILT_TAP0_MINV + (*rng)(1 << WIENER_FILT_TAP0_BITS);
+  filter[1] = filter[WIENER_WIN - 2] =
+      WIENER_FILT_TAP1_MINV + (*rng)(1 << WIENER_FILT_TAP1_BITS);
+  filter[2] = filter[WIENER_WIN - 3] =
+      WIENER_FILT_TAP2_MINV + (*rng)(1 << WIENER_FILT_TAP2_BITS);
+  filter[WIENER_HALFWIN] = -2 * (filter[0] + filter[1] + filter[2]);
+  filter[WIENER_WIN] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Low bitdepth
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (*WienerFunc)(const uint8_t *src, ptrdiff_t src_stride,
+                           uint8_t *dst, ptrdiff_t dst_stride,
+                           const int16_t *filter_x, const int16_t *filter_y,
+                           int w, int h);
+typedef libaom_test::FuncParam<WienerFunc> WienerFuncs;
+
+class WienerConvolveTest : public FunctionEquivalenceTest<WienerFunc> {
+ protected:
+  void Common(bool extreme) {
+    const int offset = kBorder * kStride + kBorder;
+    for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+      const int w = rng_(2) ? rng_(kMaxWidth) + 1 : rng_(32) + 1;
+      const int h = rng_(2) ? rng_(kMaxHeight) + 1 : rng_(32) + 1;
+      DECLARE_ALIGNED(16, int16_t, filter_x[SUBPEL_TAPS]);
+      DECLARE_ALIGNED(16, int16_t, filter_y[SUBPEL_TAPS]);
+
+      RandomFilter(&rng_, filter_x);
+      RandomFilter(&rng_, filter_y);
+      for (int i = 0; i < kBufSize; ++i)
+        src_[i] = extreme ? (rng_(2) ? 255 : 0) : rng_.Rand8();
+      memset(dst_ref_, 0, sizeof(dst_ref_));
+      memset(dst_tst_, 0, sizeof(dst_tst_));
+
+      params_.ref_func(src_ + offset, kStride, dst_ref_ + offset, kStride,
+                       filter_x, filter_y, w, h);
+      ASM_REGISTER_STATE_CHECK(params_.tst_func(src_ + offset, kStride,
+                                                dst_tst_ + offset, kStride,
+                                                filter_x, filter_y, w, h));
+
+      // Also checks that nothing outside the block was written.
+      for (int i = 0; i < kBufSize; ++i) {
+        ASSERT_EQ(dst_ref_[i], dst_tst_[i]) << "w " << w << " h " << h
+                                            << " at " << i;
+      }
+    }
+  }
+
+  uint8_t src_[kBufSize];
+  uint8_t dst_ref_[kBufSize];
+  uint8_t dst_tst_[kBufSize];
+};
+
+TEST_P(WienerConvolveTest, RandomValues) { Common(false); }
+
+TEST_P(WienerConvolveTest, ExtremeValues) { Common(true); }
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, WienerConvolveTest,
+                        ::testing::Values(WienerFuncs(
+                            av1_wiener_convolve_add_src_c,
+                            av1_wiener_convolve_add_src_sse2)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, WienerConvolveTest,
+                        ::testing::Values(WienerFuncs(
+                            av1_wiener_convolve_add_src_c,
+                            av1_wiener_convolve_add_src_avx2)));
+#endif  // HAVE_AVX2
+
+////////////////////////////////////////////////////////////////////////////////
+// High bitdepth
+////////////////////////////////////////////////////////////////////////////////
+
+#if CONFIG_AOM_HIGHBITDEPTH
+typedef void (*HBDWienerFunc)(const uint16_t *src, ptrdiff_t src_stride,
+                              uint16_t *dst, ptrdiff_t dst_stride,
+                              const int16_t *filter_x,
+                              const int16_t *filter_y, int w, int h, int bd);
+typedef libaom_test::FuncParam<HBDWienerFunc> HBDWienerFuncs;
+
+class HBDWienerConvolveTest : public FunctionEquivalenceTest<HBDWienerFunc> {
+ protected:
+  void Common(bool extreme) {
+    const int offset = kBorder * kStride + kBorder;
+    const int bd = params_.bit_depth;
+    const int max_val = (1 << bd) - 1;
+    for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+      const int w = rng_(2) ? rng_(kMaxWidth) + 1 : rng_(32) + 1;
+      const int h = rng_(2) ? rng_(kMaxHeight) + 1 : rng_(32) + 1;
+      DECLARE_ALIGNED(16, int16_t, filter_x[SUBPEL_TAPS]);
+      DECLARE_ALIGNED(16, int16_t, filter_y[SUBPEL_TAPS]);
+
+      RandomFilter(&rng_, filter_x);
+      RandomFilter(&rng_, filter_y);
+      for (int i = 0; i < kBufSize; ++i)
+        src_[i] = extreme ? (rng_(2) ? max_val : 0) : rng_(max_val + 1);
+      memset(dst_ref_, 0, sizeof(dst_ref_));
+      memset(dst_tst_, 0, sizeof(dst_tst_));
+
+      params_.ref_func(src_ + offset, kStride, dst_ref_ + offset, kStride,
+                       filter_x, filter_y, w, h, bd);
+      ASM_REGISTER_STATE_CHECK(params_.tst_func(src_ + offset, kStride,
+                                                dst_tst_ + offset, kStride,
+                                                filter_x, filter_y, w, h, bd));
+
+      for (int i = 0; i < kBufSize; ++i) {
+        ASSERT_EQ(dst_ref_[i], dst_tst_[i]) << "w " << w << " h " << h
+                                            << " at " << i;
+      }
+    }
+  }
+
+  uint16_t src_[kBufSize];
+  uint16_t dst_ref_[kBufSize];
+  uint16_t dst_tst_[kBufSize];
+};
+
+TEST_P(HBDWienerConvolveTest, RandomValues) { Common(false); }
+
+TEST_P(HBDWienerConvolveTest, ExtremeValues) { Common(true); }
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, HBDWienerConvolveTest,
+    ::testing::Values(
+        HBDWienerFuncs(av1_highbd_wiener_convolve_add_src_c,
+                       av1_highbd_wiener_convolve_add_src_sse4_1, 8),
+        HBDWienerFuncs(av1_highbd_wiener_convolve_add_src_c,
+                       av1_highbd_wiener_convolve_add_src_sse4_1, 10),
+        HBDWienerFuncs(av1_highbd_wiener_convolve_add_src_c,
+                       av1_highbd_wiener_convolve_add_src_sse4_1, 12)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, HBDWienerConvolveTest,
+    ::testing::Values(
+        HBDWienerFuncs(av1_highbd_wiener_convolve_add_src_c,
+                       av1_highbd_wiener_convolve_add_src_avx2, 8),
+        HBDWienerFuncs(av1_highbd_wiener_convolve_add_src_c,
+                       av1_highbd_wiener_convolve_add_src_avx2, 10),
+        HBDWienerFuncs(av1_highbd_wiener_convolve_add_src_c,
+                       av1_highbd_wiener_convolve_add_src_avx2, 12)));
+#endif  // HAVE_AVX2
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}  // namespace
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/function_equivalence_test.h"
+#include "test/register_state_check.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+
+using libaom_test::FunctionEquivalenceTest;
+
+namespace {
+
+// Rows longer than 1024 pixels make the high bitdepth kernels widen their
+// 32-bit sums part way through a row.
+const int kMaxWidth = 1152;
+const int kMaxHeight = 64;
+const int kStride = kMaxWidth + 16;
+const int kBufSize = kStride * (kMaxHeight + 16);
+const int kIterations = 200;
+
+typedef int64_t (*WienerCorrFunc)(const uint8_t *a, int a_stride,
+                                  const uint8_t *b, int b_stride, int width,
+                                  int height);
+typedef libaom_test::FuncParam<WienerCorrFunc> TestFuncs;
+
+class WienerCorrTest : public FunctionEquivalenceTest<WienerCorrFunc> {
+ protected:
+  // The blocks start at random offsets, with the strides the encoder uses
+  // for the source and the degraded frame.
+  template <typename Pixel>
+  void Common(bool extreme, Pixel *a, Pixel *b, uint8_t *a8, uint8_t *b8) {
+    const int max_val = (1 << params_.bit_depth) - 1;
+    for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+      const int w = rng_(2) ? rng_(kMaxWidth) + 1 : rng_(32) + 1;
+      const int h = rng_(2) ? rng_(kMaxHeight) + 1 : rng_(8) + 1;
+      const int a_off = rng_(8) * kStride + rng_(16);
+      const int b_off = rng_(8) * kStride + rng_(16);
+      for (int i = 0; i < kBufSize; ++i) {
+        a[i] = extreme ? max_val : rng_(max_val + 1);
+        b[i] = extreme ? max_val : rng_(max_val + 1);
+      }
+
+      const int64_t ref_res =
+          params_.ref_func(a8 + a_off, kStride, b8 + b_off, kStride, w, h);
+      int64_t tst_res;
+      ASM_REGISTER_STATE_CHECK(tst_res = params_.tst_func(
+                                   a8 + a_off, kStride, b8 + b_off, kStride,
+                                   w, h));
+      ASSERT_EQ(ref_res, tst_res) << "w " << w << " h " << h;
+    }
+  }
+};
+
+class LowbdWienerCorrTest : public WienerCorrTest {
+ protected:
+  void Run(bool extreme) { Common(extreme, a_, b_, a_, b_); }
+
+  uint8_t a_[kBufSize];
+  uint8_t b_[kBufSize];
+};
+
+TEST_P(LowbdWienerCorrTest, RandomValues) { Run(false); }
+
+TEST_P(LowbdWienerCorrTest, ExtremeValues) { Run(true); }
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(SSE4_1, LowbdWienerCorrTest,
+                        ::testing::Values(TestFuncs(av1_wiener_corr_c,
+                                                    av1_wiener_corr_sse4_1,
+                                                    8)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, LowbdWienerCorrTest,
+                        ::testing::Values(TestFuncs(av1_wiener_corr_c,
+                                                    av1_wiener_corr_avx2, 8)));
+#endif  // HAVE_AVX2
+
+#if CONFIG_AOM_HIGHBITDEPTH
+class HighbdWienerCorrTest : public WienerCorrTest {
+ protected:
+  void Run(bool extreme) {
+    Common(extreme, a_, b_, CONVERT_TO_BYTEPTR(a_), CONVERT_TO_BYTEPTR(b_));
+  }
+
+  uint16_t a_[kBufSize];
+  uint16_t b_[kBufSize];
+};
+
+TEST_P(HighbdWienerCorrTest, RandomValues) { Run(false); }
+
+TEST_P(HighbdWienerCorrTest, ExtremeValues) { Run(true); }
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, HighbdWienerCorrTest,
+    ::testing::Values(
+        TestFuncs(av1_highbd_wiener_corr_c, av1_highbd_wiener_corr_sse4_1, 10),
+        TestFuncs(av1_highbd_wiener_corr_c, av1_highbd_wiener_corr_sse4_1,
+                  12)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, HighbdWienerCorrTest,
+    ::testing::Values(
+        TestFuncs(av1_highbd_wiener_corr_c, av1_highbd_wiener_corr_avx2, 10),
+        TestFuncs(av1_highbd_wiener_corr_c, av1_highbd_wiener_corr_avx2, 12)));
+#endif  // HAVE_AVX2
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}  // namespace